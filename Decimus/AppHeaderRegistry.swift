@@ -33,23 +33,25 @@ enum AppHeaders {
 
 extension HeaderExtensions {
     func getHeader(_ appHeader: AppHeadersRegistry) throws -> AppHeaders? {
-        guard let dataArray = self[appHeader.nsKey], let data = dataArray.first else { return nil }
-        switch appHeader {
-        case .energyLevel:
-            guard let first = data.first else { throw "Invalid" }
-            return .energyLevel(first)
-        case .participantId:
-            guard let int = data.parseInteger() else { throw "Invalid" }
-            return .participantId(.init(UInt32(int)))
-        case .sequenceNumber:
-            guard let int = data.parseInteger() else { throw "Invalid" }
-            return .sequenceNumber(UInt64(int))
-        case .publishTimestamp:
-            guard let microseconds = data.parseInteger() else { throw "Invalid" }
-            return .publishTimestamp(Date(timeIntervalSince1970: TimeInterval(microseconds) / microsecondsPerSecond))
-        case .audioActivityIndicator:
-            guard let first = data.first else { throw "Invalid" }
-            return .audioActivityIndicator(first)
+        // All application headers are small values, parsed in place.
+        try self.withValue(appHeader.rawValue) { data in
+            switch appHeader {
+            case .energyLevel:
+                guard let first = data.first else { throw "Invalid" }
+                return .energyLevel(first)
+            case .participantId:
+                guard let int = data.parseInteger() else { throw "Invalid" }
+                return .participantId(.init(UInt32(int)))
+            case .sequenceNumber:
+                guard let int = data.parseInteger() else { throw "Invalid" }
+                return .sequenceNumber(UInt64(int))
+            case .publishTimestamp:
+                guard let microseconds = data.parseInteger() else { throw "Invalid" }
+                return .publishTimestamp(Date(timeIntervalSince1970: TimeInterval(microseconds) / microsecondsPerSecond))
+            case .audioActivityIndicator:
+                guard let first = data.first else { throw "Invalid" }
+                return .audioActivityIndicator(first)
+            }
         }
     }
 
@@ -66,12 +68,6 @@ extension HeaderExtensions {
         case .audioActivityIndicator(let value):
             Data([value])
         }
-        let nsKey = key.value.nsKey
-        if var existing = self[nsKey] {
-            existing.append(data)
-            self[nsKey] = existing
-        } else {
-            self[nsKey] = [data]
-        }
+        self.append(key.value.rawValue, data)
     }
 }
@@ -28,6 +28,11 @@ extension Ticks {
     var hostDate: Date {
         self.seconds.hostDate
     }
+
+    /// This time offset by an interval, which may be negative.
+    func addingTimeInterval(_ interval: TimeInterval) -> Ticks {
+        Ticks(SignedTicks(self) + interval.signedTicks)
+    }
 }
 
 extension TimeInterval {
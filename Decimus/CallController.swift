@@ -157,7 +157,7 @@ final class MoqCallController: QClientCallbacks, Sendable {
             self.client.unsubscribeNamespace(withHandler: libquicrHandler.handler)
         }
         for (_, publication) in state.publications {
-            guard let libquicrHandler = publication.sink as? QPublishTrackHandlerSink else {
+            guard let libquicrHandler = Self.libquicrSink(publication) else {
                 throw "Type mismatch"
             }
             self.client.unpublishTrack(withHandler: libquicrHandler.handler)
@@ -193,13 +193,55 @@ final class MoqCallController: QClientCallbacks, Sendable {
                         codecFactory: CodecFactory) throws -> [(FullTrackName, any PublicationInstance)] {
         let (connected, serverId) = self.state.withLock { ($0.connected, $0.serverId) }
         guard connected else { throw MoqCallControllerError.notConnected }
+        let created = try self.makePublications(details: details,
+                                                factory: factory,
+                                                codecFactory: codecFactory,
+                                                relayId: serverId!)
+        for (_, publication) in created {
+            let libquicrHandler = Self.libquicrSink(publication)!
+            self.client.publishTrack(withHandler: libquicrHandler.handler)
+        }
+        return created
+    }
+
+    /// Setup publications for many tracks at once, as when joining, publishing them all in one call.
+    /// - Parameter details: The details for each publication from the manifest.
+    /// - Parameter factory: Factory to create publication objects.
+    /// - Parameter codecFactory: Turns a quality profile into a codec configuration.
+    /// - Returns: For each publication, in order, its created ``(FullTrackName, PublicationInstance)`` tuples or the
+    /// error creating them.
+    /// - Throws: ``MoqCallControllerError/notConnected`` if not connected.
+    public func publish(_ details: [ManifestPublication],
+                        factory: PublicationFactory,
+                        codecFactory: CodecFactory) throws -> [Result<[(FullTrackName, any PublicationInstance)], Error>] {
+        let (connected, serverId) = self.state.withLock { ($0.connected, $0.serverId) }
+        guard connected else { throw MoqCallControllerError.notConnected }
+        // Publications set up capture and encoding, so are made one at a time.
+        let results = details.map { details in
+            Result {
+                try self.makePublications(details: details,
+                                          factory: factory,
+                                          codecFactory: codecFactory,
+                                          relayId: serverId!)
+            }
+        }
+        let handlers = results.flatMap { (try? $0.get()) ?? [] }.map { Self.libquicrSink($0.1)!.handler }
+        self.client.publishTracks(withHandlers: handlers)
+        return results
+    }
+
+    /// Create and track the publications for a manifest entry, without publishing them.
+    private func makePublications(details: ManifestPublication,
+                                  factory: PublicationFactory,
+                                  codecFactory: CodecFactory,
+                                  relayId: String) throws -> [(FullTrackName, any PublicationInstance)] {
         let created = try factory.create(publication: details,
                                          codecFactory: codecFactory,
                                          endpointId: self.endpointUri,
-                                         relayId: serverId!)
+                                         relayId: relayId)
         // Type check.
         for (_, publication) in created {
-            guard publication.sink is QPublishTrackHandlerSink else {
+            guard Self.libquicrSink(publication) != nil else {
                 throw "Type mismatch"
             }
         }
@@ -208,11 +250,6 @@ final class MoqCallController: QClientCallbacks, Sendable {
                 state.publications[namespace] = publication
             }
         }
-        for (_, publication) in created {
-            // swiftlint:disable:next force_cast
-            let libquicrHandler = publication.sink as! QPublishTrackHandlerSink
-            self.client.publishTrack(withHandler: libquicrHandler.handler)
-        }
         return created
     }
 
@@ -228,12 +265,18 @@ final class MoqCallController: QClientCallbacks, Sendable {
         guard let publication else {
             throw MoqCallControllerError.publicationNotFound
         }
-        guard let libquicrHandler = publication.sink as? QPublishTrackHandlerSink else {
+        guard let libquicrHandler = Self.libquicrSink(publication) else {
             throw "Type mismatch"
         }
         self.client.unpublishTrack(withHandler: libquicrHandler.handler)
     }
 
+    /// The libquicr sink a publication ultimately publishes to, looking through any pacing.
+    private static func libquicrSink(_ publication: any PublicationInstance) -> QPublishTrackHandlerSink? {
+        let sink = (publication.sink as? PacedSink)?.inner ?? publication.sink
+        return sink as? QPublishTrackHandlerSink
+    }
+
     public func fetch(_ fetch: Fetch) throws {
         try self.state.withLock { state in
             guard state.connected else { throw MoqCallControllerError.notConnected }
@@ -342,6 +385,87 @@ final class MoqCallController: QClientCallbacks, Sendable {
         return set
     }
 
+    /// Subscribe to many sets at once, as when joining.
+    ///
+    /// Sets and their handlers are constructed concurrently, which is where joining this way saves time over
+    /// ``subscribeToSet(details:factory:subscribeType:)`` for each, then every track is subscribed in one call.
+    /// The factory must be safe to call concurrently.
+    /// - Parameter details: The details of each subscription set.
+    /// - Parameter factory: Factory to create subscription handlers from.
+    /// - Returns: For each set, in order, the created ``SubscriptionSet`` or the error creating it.
+    /// - Throws: ``MoqCallControllerError/notConnected`` if not connected.
+    public func subscribeToSets(_ details: [ManifestSubscription],
+                                factory: SubscriptionFactory) throws -> [Result<SubscriptionSet, Error>] {
+        let (connected, serverId) = self.state.withLock { ($0.connected, $0.serverId) }
+        guard connected else { throw MoqCallControllerError.notConnected }
+        let relayId = serverId!
+        let created = Mutex<[Result<(SubscriptionSet, [Subscription]), Error>?]>(.init(repeating: nil,
+                                                                                      count: details.count))
+        DispatchQueue.concurrentPerform(iterations: details.count) { index in
+            let result = Result {
+                let set = try factory.create(subscription: details[index],
+                                             codecFactory: CodecFactoryImpl(),
+                                             endpointId: self.endpointUri,
+                                             relayId: relayId)
+                let handlers = try self.makeHandlers(set: set,
+                                                     details: details[index],
+                                                     factory: factory,
+                                                     relayId: relayId,
+                                                     publisherInitiated: nil)
+                return (set, handlers)
+            }
+            created.withLock { $0[index] = result }
+        }
+        let results = created.get().map { $0! }
+
+        // Track everything before any SUBSCRIBE_OK can arrive, then subscribe to it all.
+        var handlers: [Subscription] = []
+        self.state.withLock { state in
+            for (details, result) in zip(details, results) {
+                guard case .success(let (set, _)) = result else { continue }
+                state.subscriptions[details.sourceID] = set
+            }
+        }
+        for case .success(let (_, setHandlers)) in results {
+            handlers.append(contentsOf: setHandlers)
+        }
+        self.client.subscribeTracks(withHandlers: handlers)
+        return results.map { $0.map(\.0) }
+    }
+
+    /// Create a handler for each of a set's profiles and add it to the set, without subscribing.
+    private func makeHandlers(set: SubscriptionSet,
+                              details: ManifestSubscription,
+                              factory: SubscriptionFactory,
+                              relayId: String,
+                              publisherInitiated: PublisherInitiatedDetails?) throws -> [Subscription] {
+        var handlers: [Subscription] = []
+        for profile in details.profileSet.profiles {
+            let original = profile
+            let profile: Profile
+            if let overrideNamespace {
+                profile = original.transformNamespace(overrideNamespace: overrideNamespace,
+                                                      sourceId: set.sourceId,
+                                                      count: handlers.count)
+            } else {
+                profile = original
+            }
+
+            do {
+                handlers.append(try self.makeHandler(set: set,
+                                                     profile: profile,
+                                                     factory: factory,
+                                                     relayId: relayId,
+                                                     publisherInitiated: publisherInitiated))
+            } catch let error as PubSubFactoryError {
+                self.logger.warning("[\(set.sourceId)] (\(profile.namespace)) Couldn't create subscription: " +
+                                        "\(error.localizedDescription)",
+                                    alert: true)
+            }
+        }
+        return handlers
+    }
+
     struct PublisherInitiatedDetails {
         let trackAlias: UInt64
         let requestId: UInt64
@@ -360,18 +484,32 @@ final class MoqCallController: QClientCallbacks, Sendable {
                    publisherInitiated: PublisherInitiatedDetails?) throws -> Subscription {
         let (connected, serverId) = self.state.withLock { ($0.connected, $0.serverId) }
         guard connected else { throw MoqCallControllerError.notConnected }
+        let subscription = try self.makeHandler(set: set,
+                                                profile: profile,
+                                                factory: factory,
+                                                relayId: serverId!,
+                                                publisherInitiated: publisherInitiated)
+        self.client.subscribeTrack(withHandler: subscription)
+        return subscription
+    }
+
+    /// Create a handler for a profile and add it to a set, without subscribing.
+    private func makeHandler(set: SubscriptionSet,
+                             profile: Profile,
+                             factory: SubscriptionFactory,
+                             relayId: String,
+                             publisherInitiated: PublisherInitiatedDetails?) throws -> Subscription {
         let subscription = try factory.create(set: set,
                                               profile: profile,
                                               codecFactory: CodecFactoryImpl(),
                                               endpointId: self.endpointUri,
-                                              relayId: serverId!,
+                                              relayId: relayId,
                                               publisherInitiated: publisherInitiated != nil)
         if let publisherInitiated {
             subscription.setReceivedTrackAlias(publisherInitiated.trackAlias)
             subscription.setRequestId(publisherInitiated.requestId)
         }
         try set.addHandler(subscription)
-        self.client.subscribeTrack(withHandler: subscription)
         return subscription
     }
 
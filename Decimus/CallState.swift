@@ -3,33 +3,12 @@
 
 // swiftlint:disable file_length
 
-import CryptoKit
 import SFrame
 import SwiftUI
 import Synchronization
 import Network
 import MSF
 
-final class SFrameContext: Sendable {
-    let mutex: Mutex<MLS>
-
-    init(_ sframe: MLS) {
-        self.mutex = .init(sframe)
-    }
-}
-
-final class SendSFrameContext: Sendable {
-    let context: SFrameContext
-    let senderId: MLS.SenderID
-    let currentEpoch: MLS.EpochID
-
-    init(sframe: MLS, senderId: MLS.SenderID, currentEpoch: MLS.EpochID) {
-        self.context = .init(sframe)
-        self.senderId = senderId
-        self.currentEpoch = currentEpoch
-    }
-}
-
 struct SFrameConfig: Codable {
     let enable: Bool
     let secret: String
@@ -93,8 +72,7 @@ class CallState: ObservableObject, Equatable { // swiftlint:disable:this type_bo
     private(set) var subscriptionFactory: SubscriptionFactoryImpl?
     private let joinDate = Date.now
     let audioStartingGroup: UInt64?
-    private var sendContext: SendSFrameContext?
-    private var receiveContext: SFrameContext?
+    private var sframeKeyring: SFrameKeyring?
 
     @AppStorage(SubscriptionSettingsView.showLabelsKey)
     var showLabels: Bool = true
@@ -186,10 +164,13 @@ class CallState: ObservableObject, Equatable { // swiftlint:disable:this type_bo
 
     // Temp fields for NAB demo.
     private var catalogSubscription: CallbackSubscription?
-    private var currentCatalog: Catalog?
+    /// The NAB catalog so far, to which updates are applied off the main actor as they arrive.
+    nonisolated private let catalogIndex = Mutex(CatalogIndex<MSF.Track>())
     private var nabNamespaceHandlers: [NamespacePrefix: QSubscribeNamespaceHandler] = [:]
     private var nabSubscriptionsByNamespace: [NamespacePrefix: [(sourceId: SourceIDType, ftn: FullTrackName)]] = [:]
     private var nabPublications: [String: [FullTrackName]] = [:]
+    /// Catalog prefixes whose namespace subscription or publication failed, to try again on the next update.
+    private var nabRetries: Set<[String]> = []
 
     init(config: CallConfig, audioStartingGroup: UInt64?, onLeave: @escaping () -> Void) {
         self.config = config
@@ -263,30 +244,21 @@ class CallState: ObservableObject, Equatable { // swiftlint:disable:this type_bo
         if sframeSettings.enable {
             let epochId: MLS.EpochID = 0
             do {
-                guard let suite = registry[.aes_128_gcm_sha256_128] else {
-                    throw "Unsupported CipherSuite"
-                }
-                let cryptoProvider = SwiftCryptoProvider(suite: suite)
-                let sendContext = try MLS(provider: cryptoProvider, epochBits: 1)
-                let recvContext = try MLS(provider: cryptoProvider, epochBits: 1)
-
-                let secret = SymmetricKey(data: Data(sframeSettings.key.utf8))
-                try sendContext.addEpoch(epochId: epochId,
-                                         sframeEpochSecret: secret)
-                try recvContext.addEpoch(epochId: epochId,
-                                         sframeEpochSecret: secret)
-
                 let senderId = self.audioStartingGroup ?? UInt64(localParticipantId)
-                self.sendContext = .init(sframe: sendContext,
-                                         senderId: senderId,
-                                         currentEpoch: epochId)
-                self.receiveContext = .init(recvContext)
+                self.sframeKeyring = try .init(key: sframeSettings.key,
+                                               senderId: senderId,
+                                               currentEpoch: epochId)
             } catch {
                 self.logger.error("Failed to create SFrame context: \(error.localizedDescription)")
             }
         }
 
-        self.textSubscriptions = .init(sframeContext: self.receiveContext)
+        do {
+            self.textSubscriptions = .init(sframeContext: try self.sframeKeyring?.makeReceiveContext())
+        } catch {
+            self.logger.error("Failed to create SFrame context: \(error.localizedDescription)")
+            return false
+        }
 
         // Are we overriding publication namespaces?
         let overrideNamespace: [String]?
@@ -325,6 +297,13 @@ class CallState: ObservableObject, Equatable { // swiftlint:disable:this type_bo
         let subConfig = self.subscriptionConfig.value
         let publicationFactory: PublicationFactory?
         if self.role != .subscriber {
+            let egressScheduler: EgressScheduler?
+            if subConfig.egressBitrateKbps > 0 {
+                egressScheduler = .init(config: .init(uplinkBitrate: UInt64(subConfig.egressBitrateKbps) * 1000,
+                                                      staleVideoAge: subConfig.egressStaleVideoAge))
+            } else {
+                egressScheduler = nil
+            }
             publicationFactory = PublicationFactoryImpl(opusWindowSize: subConfig.opusWindowSize,
                                                         reliability: subConfig.mediaReliability,
                                                         engine: self.engine,
@@ -337,7 +316,8 @@ class CallState: ObservableObject, Equatable { // swiftlint:disable:this type_bo
                                                         verbose: self.verbose,
                                                         keyFrameOnUpdate: subConfig.keyFrameOnSubscribeUpdate,
                                                         startingGroup: self.audioStartingGroup,
-                                                        sframeContext: self.sendContext,
+                                                        sframeKeyring: self.sframeKeyring,
+                                                        egressScheduler: egressScheduler,
                                                         mediaInterop: self.mediaInterop,
                                                         appExtensionMode: self.appExtensionMode,
                                                         overrideNamespace: overrideNamespace,
@@ -365,7 +345,7 @@ class CallState: ObservableObject, Equatable { // swiftlint:disable:this type_bo
                                                           verbose: self.verbose,
                                                           startingGroup: startingGroupId,
                                                           manualActiveSpeaker: playtime.playtime && playtime.manualActiveSpeaker,
-                                                          sframeContext: self.receiveContext,
+                                                          sframeKeyring: self.sframeKeyring,
                                                           calculateLatency: self.showLabels,
                                                           mediaInterop: self.mediaInterop,
                                                           switchLatencyMeasurement: self.switchLatencyMeasurement)
@@ -407,12 +387,14 @@ class CallState: ObservableObject, Equatable { // swiftlint:disable:this type_bo
                 self.catalogSubscription = try await self.setupCatalogTrack(controller: controller) { [weak self] result in
                     guard let self else { return }
                     switch result {
-                    case .success(let catalog):
+                    case .success(let patch):
+                        var changes = CatalogIndex<MSF.Track>.Changes()
+                        self.catalogIndex.withLock { changes = $0.apply(patch) }
                         DispatchQueue.main.async {
-                            self.handleCatalogUpdate(catalog,
-                                                     controller: controller,
-                                                     publicationFactory: publicationFactory,
-                                                     codecFactory: CodecFactoryImpl())
+                            self.handleCatalogChanges(changes,
+                                                      controller: controller,
+                                                      publicationFactory: publicationFactory,
+                                                      codecFactory: CodecFactoryImpl())
                         }
                     case .failure(let error):
                         self.logger.error("Catalog parse failed: \(error.localizedDescription)")
@@ -482,27 +464,36 @@ class CallState: ObservableObject, Equatable { // swiftlint:disable:this type_bo
                 // Normal mode: publish and subscribe from manifest.
                 // Publish.
                 if let publicationFactory {
-                    for publication in manifest.publications {
-                        do {
-                            let created = try controller.publish(details: publication,
-                                                                 factory: publicationFactory,
-                                                                 codecFactory: CodecFactoryImpl())
-                            for pub in created where pub.1 is TextPublication {
-                                self.textPublication = (pub.1 as! TextPublication) // swiftlint:disable:this force_cast
+                    do {
+                        let results = try controller.publish(manifest.publications,
+                                                             factory: publicationFactory,
+                                                             codecFactory: CodecFactoryImpl())
+                        for (publication, result) in zip(manifest.publications, results) {
+                            do {
+                                for pub in try result.get() where pub.1 is TextPublication {
+                                    self.textPublication = (pub.1 as! TextPublication) // swiftlint:disable:this force_cast
+                                }
+                            } catch {
+                                self.logger.warning("[\(publication.sourceID)] Couldn't create publication: \(error.localizedDescription)")
                             }
-                        } catch {
-                            self.logger.warning("[\(publication.sourceID)] Couldn't create publication: \(error.localizedDescription)")
                         }
+                    } catch {
+                        self.logger.error("Couldn't publish: \(error.localizedDescription)")
                     }
                 }
 
-                // Subscribe.
+                // Subscribe, all at once.
                 if let subscriptionFactory {
-                    for subscription in manifest.subscriptions {
+                    let results: [Result<SubscriptionSet, Error>]
+                    do {
+                        results = try controller.subscribeToSets(manifest.subscriptions, factory: subscriptionFactory)
+                    } catch {
+                        self.logger.error("Couldn't subscribe: \(error.localizedDescription)")
+                        results = []
+                    }
+                    for (subscription, result) in zip(manifest.subscriptions, results) {
                         do {
-                            let set = try controller.subscribeToSet(details: subscription,
-                                                                    factory: subscriptionFactory,
-                                                                    subscribeType: .subscribe)
+                            let set = try result.get()
                             if subscription.mediaType == ManifestMediaTypes.text.rawValue {
                                 let handlers = set.getHandlers()
                                 precondition(handlers.count == 1,
@@ -531,6 +522,14 @@ class CallState: ObservableObject, Equatable { // swiftlint:disable:this type_bo
                     }
                     if let notifier = notifier {
                         let videoSubscriptions = manifest.subscriptions.filter { $0.mediaType == ManifestMediaTypes.video.rawValue }
+                        let preSubscription = self.subscriptionConfig.value.preSubscription
+                        let pool = preSubscription.count > 0 ?
+                            PreSubscriptionPool(controller: controller,
+                                                videoSubscriptions: videoSubscriptions,
+                                                factory: subscriptionFactory,
+                                                participantId: manifest.participantId,
+                                                predictor: subscriptionFactory.speakerPredictor,
+                                                config: preSubscription) : nil
                         do {
                             self.activeSpeaker = try .init(notifier: notifier,
                                                            controller: controller,
@@ -538,7 +537,8 @@ class CallState: ObservableObject, Equatable { // swiftlint:disable:this type_bo
                                                            factory: subscriptionFactory,
                                                            participantId: manifest.participantId,
                                                            activeSpeakerStats: self.activeSpeakerStats,
-                                                           pauseResume: self.subscriptionConfig.value.pauseResume)
+                                                           pauseResume: self.subscriptionConfig.value.pauseResume,
+                                                           pool: pool)
                         } catch {
                             self.logger.error("Failed to create active speaker controller: \(error.localizedDescription)")
                         }
@@ -624,31 +624,29 @@ class CallState: ObservableObject, Equatable { // swiftlint:disable:this type_bo
         }
     }
 
-    private func handleCatalogUpdate(_ catalog: Catalog,
-                                     controller: MoqCallController,
-                                     publicationFactory: PublicationFactory?,
-                                     codecFactory: CodecFactory) {
-        guard self.currentCatalog != catalog else { return }
-        self.currentCatalog = catalog
-        self.logger.debug("Received catalog update")
-
-        // Build new namespace set from catalog tracks.
-        var newNamespaces: [NamespacePrefix: MSF.Track] = [:]
-        for track in catalog.tracks {
-            guard let namespace = track.namespace else {
-                self.logger.error("Missing namespace for catalog track")
-                continue
+    /// Act on the namespace prefixes a catalog update added or removed.
+    private func handleCatalogChanges(_ changes: CatalogIndex<MSF.Track>.Changes,
+                                      controller: MoqCallController,
+                                      publicationFactory: PublicationFactory?,
+                                      codecFactory: CodecFactory) {
+        guard !changes.isEmpty || !self.nabRetries.isEmpty else { return }
+        self.logger.debug("Received catalog update: \(changes.added.count) prefixes added, \(changes.removed.count) removed")
+
+        // Try failed prefixes again, with their tracks as they are now.
+        var added = changes.added
+        let retries = self.nabRetries
+        self.nabRetries.removeAll()
+        self.catalogIndex.withLock { index in
+            for tuples in retries where added[tuples] == nil {
+                let tracks = index.tracks(prefix: tuples)
+                guard !tracks.isEmpty else { continue }
+                added[tuples] = tracks
             }
-            var tuples = namespace.tuples
-            _ = tuples.popLast()
-            newNamespaces[.init(tuples.map { Data($0.utf8) })] = track
         }
 
-        let newPrefixes = Set(newNamespaces.keys)
-        let oldNamespaces = Set(self.nabNamespaceHandlers.keys)
-
         // Remove stale namespace handlers and their subscriptions.
-        for prefix in oldNamespaces.subtracting(newPrefixes) {
+        for tuples in changes.removed {
+            let prefix = NamespacePrefix(tuples.map { Data($0.utf8) })
             if let handler = self.nabNamespaceHandlers.removeValue(forKey: prefix) {
                 do {
                     try controller.unsubscribeNamespace(handler)
@@ -671,8 +669,10 @@ class CallState: ObservableObject, Equatable { // swiftlint:disable:this type_bo
         }
 
         // Add new namespace handlers.
-        for prefix in newPrefixes.subtracting(oldNamespaces) {
-            let isVideo = newNamespaces[prefix]?.mediaType == ManifestMediaTypes.video.rawValue
+        for (tuples, tracks) in added {
+            let prefix = NamespacePrefix(tuples.map { Data($0.utf8) })
+            guard self.nabNamespaceHandlers[prefix] == nil else { continue }
+            let isVideo = tracks.first?.mediaType == ManifestMediaTypes.video.rawValue
             let filter: QTrackFilterObjC? = switch self.config.joinType {
             case .activeSpeaker where isVideo:
                 .init(propertyType: AppHeadersRegistry.audioActivityIndicator.rawValue,
@@ -690,18 +690,18 @@ class CallState: ObservableObject, Equatable { // swiftlint:disable:this type_bo
                 self.nabNamespaceHandlers[prefix] = handler
                 self.logger.info("[nab] Subscribed namespace: \(prefix) using filter: \(String(describing: filter))")
             } catch {
+                self.nabRetries.insert(tuples)
                 self.logger.error("[nab] Failed to subscribe namespace: \(error.localizedDescription)")
             }
         }
 
-        // Diff publications.
+        // Publications follow their namespace prefixes.
         if let publicationFactory {
-            let newPubs = catalog.toPublications(localParticipantId: "publisher_\(self.config.email)")
-            let newPubKeys = Set(newPubs.map { $0.sourceID })
-            let oldPubKeys = Set(self.nabPublications.keys)
+            let localParticipantId = "publisher_\(self.config.email)"
 
             // Remove stale publications.
-            for key in oldPubKeys.subtracting(newPubKeys) {
+            for tuples in changes.removed {
+                let key = (tuples + [localParticipantId]).joined()
                 if let ftns = self.nabPublications.removeValue(forKey: key) {
                     for ftn in ftns {
                         do {
@@ -715,15 +715,19 @@ class CallState: ObservableObject, Equatable { // swiftlint:disable:this type_bo
             }
 
             // Add new publications.
-            for publication in newPubs where !oldPubKeys.contains(publication.sourceID) {
-                do {
-                    let created = try controller.publish(details: publication,
-                                                         factory: publicationFactory,
-                                                         codecFactory: codecFactory)
-                    self.nabPublications[publication.sourceID] = created.map { $0.0 }
-                    self.logger.info("[nab] Published: \(publication.sourceID)")
-                } catch {
-                    self.logger.error("[nab] Failed to publish \(publication.sourceID): \(error.localizedDescription)")
+            for (tuples, tracks) in added {
+                let newPubs = tracks.toPublications(localParticipantId: localParticipantId)
+                for publication in newPubs where self.nabPublications[publication.sourceID] == nil {
+                    do {
+                        let created = try controller.publish(details: publication,
+                                                             factory: publicationFactory,
+                                                             codecFactory: codecFactory)
+                        self.nabPublications[publication.sourceID] = created.map { $0.0 }
+                        self.logger.info("[nab] Published: \(publication.sourceID)")
+                    } catch {
+                        self.nabRetries.insert(tuples)
+                        self.logger.error("[nab] Failed to publish \(publication.sourceID): \(error.localizedDescription)")
+                    }
                 }
             }
         }
@@ -822,10 +826,11 @@ class CallState: ObservableObject, Equatable { // swiftlint:disable:this type_bo
         } catch {
             self.logger.error("Error while leaving call: \(error)")
         }
-        self.currentCatalog = nil
+        self.catalogIndex.withLock { $0 = .init() }
         self.nabNamespaceHandlers.removeAll()
         self.nabSubscriptionsByNamespace.removeAll()
         self.nabPublications.removeAll()
+        self.nabRetries.removeAll()
 
         self.switchLatencyMeasurement = nil
         self.activityTransitionMeasurement = nil
@@ -1094,13 +1099,11 @@ extension CallState {
         let prefixTuples = Array(namespace.dropLast())
         let namespacePrefix = NamespacePrefix(prefixTuples.map { Data($0.utf8) })
 
-        // Match the catalog track by namespace prefix (sans participant).
-        guard let catalogTrack = self.currentCatalog?.tracks.first(where: { track in
-            guard let trackNs = track.namespace else { return false }
-            var trackTuples = trackNs.tuples
-            _ = trackTuples.popLast()
-            return trackTuples == prefixTuples
-        }) else {
+        // Match the catalog track by full name, or else by namespace prefix (sans participant).
+        let name = String(data: fullTrackName.name, encoding: .utf8) ?? ""
+        var catalogTrack: MSF.Track?
+        self.catalogIndex.withLock { catalogTrack = $0.track(namespace: namespace, name: name) }
+        guard let catalogTrack else {
             self.logger.warning("[nab] No catalog track matching namespace prefix: \(prefixTuples)")
             return nil
         }
@@ -1165,7 +1168,7 @@ extension CallState {
         }
     }
 
-    typealias CatalogUpdate = Result<Catalog, Error>
+    typealias CatalogUpdate = Result<CatalogPatch<MSF.Track>, Error>
     typealias CatalogCallback = @Sendable (CatalogUpdate) -> Void
     private func setupCatalogTrack(controller: MoqCallController,
                                    callback: @escaping CatalogCallback) async throws -> CallbackSubscription {
@@ -1186,8 +1189,8 @@ extension CallState {
                     deliveryTimeout: nil
                 ) { _, data, _, _ in
                     do {
-                        let catalog = try JSONDecoder().decode(MSF.Catalog.self, from: data)
-                        callback(.success(catalog))
+                        let patch = try JSONDecoder().decode(CatalogPatch<MSF.Track>.self, from: data)
+                        callback(.success(patch))
                         if let sub = pending.consume() {
                             continuation.resume(returning: sub)
                         }
@@ -1240,6 +1243,10 @@ extension CallState {
     }
 }
 
+private extension MetricField {
+    static let cpuUsage = MetricField("cpuUsage")
+}
+
 // Metrics.
 extension CallState {
     private final class _Measurement: MetricsMeasurement {
@@ -1248,7 +1255,7 @@ extension CallState {
         let tags: [String: String] = [:]
 
         func recordCpuUsage(cpuUsage: Double, timestamp: Date?) {
-            record(field: "cpuUsage", value: cpuUsage as AnyObject, timestamp: timestamp)
+            record(field: .cpuUsage, value: cpuUsage, timestamp: timestamp)
         }
     }
 }
@@ -84,6 +84,28 @@ struct TextCodecConfig: CodecConfig {
     let bitrate: UInt32 = 0
 }
 
+/// Implementations of video decode.
+enum VideoDecoderBackend: Codable, CaseIterable, Identifiable {
+    /// Hardware accelerated decode, see ``VTDecoder``.
+    case videoToolbox
+    /// No decode, for load testing the receive path, see ``PassthroughDecoder``.
+    case passthrough
+    var id: Self { self }
+
+    /// Make a decoder for a received video stream.
+    /// - Parameter config: The stream's codec configuration.
+    /// - Parameter decodeBufferSize: Max number of decoded frames to buffer.
+    /// - Returns: The decoder.
+    func makeDecoder(config: VideoCodecConfig, decodeBufferSize: Int) -> VideoDecoder {
+        switch self {
+        case .videoToolbox:
+            VTDecoder(config: config, decodeBufferSize: decodeBufferSize)
+        case .passthrough:
+            PassthroughDecoder(config: config, decodeBufferSize: decodeBufferSize)
+        }
+    }
+}
+
 protocol CodecFactory {
     func makeCodecConfig(from qualityProfile: String, bitrateType: BitrateType) -> CodecConfig
 }
@@ -37,6 +37,7 @@ class H264Utilities: VideoUtilities {
                 try depacketizeLength($0,
                                       format: &format,
                                       copy: copy,
+                                      owner: data,
                                       seiCallback: seiCallback)
             }
         }
@@ -45,6 +46,7 @@ class H264Utilities: VideoUtilities {
     private func depacketizeLength(_ data: UnsafeRawBufferPointer,
                                    format: inout CMFormatDescription?,
                                    copy: Bool,
+                                   owner: Any?,
                                    seiCallback: (Data) -> Void) throws -> [CMBlockBuffer]? {
         var results: [CMBlockBuffer] = []
         var offset = 0
@@ -89,126 +91,67 @@ class H264Utilities: VideoUtilities {
                 let length = Int(length) + MemoryLayout<UInt32>.size
                 results.append(try Self.buildBlockBuffer(UnsafeRawBufferPointer(start: ptr,
                                                                                 count: length),
-                                                         copy: copy))
+                                                         copy: copy,
+                                                         owner: owner))
             }
             offset += MemoryLayout<UInt32>.size + Int(length)
         }
         return results.count > 0 ? results : nil
     }
 
-    /// Turns an H264 bitstream into CMSampleBuffer per NALU.
-    /// - Parameter data The H264 data. This is used in place and will be modified,
-    /// so must outlive any use of the created samples.
-    /// - Parameter timeInfo The timing info for this frame.
+    /// Turns an H264 Annex B bitstream into a length prefixed block buffer per frame NALU.
+    /// - Parameter data The H264 data. Both 3 and 4 byte start codes are accepted.
     /// - Parameter format The current format of the stream if known.
     /// If SPS/PPS are found, it will be replaced by the found format.
-    /// - Parameter sei If an SEI if found, it will be passed to this callback (start code included).
+    /// - Parameter copy Unused: the start code has to be rewritten as a length, so NALUs are always copied.
+    /// - Parameter sei If an SEI if found, it will be passed to this callback
+    /// (4 byte start code included, emulation prevention removed).
     private func depacketizeAnnexB(_ data: Data,
                                    format: inout CMFormatDescription?,
                                    copy: Bool,
                                    seiCallback: (Data) -> Void) throws -> [CMBlockBuffer]? {
-        // Identify all NALUs by start code.
         assert(data.starts(with: Self.naluStartCode))
-        var ranges: [Range<Data.Index>] = []
-        var naluRanges: [Range<Data.Index>] = []
-        var startIndex = 0
-        var index = 0
-        var naluRangesIndex = 0
-        while let range = data.range(of: .init(Self.naluStartCode), in: startIndex..<data.count) {
-            ranges.append(range)
-            startIndex = range.upperBound
-            if index > 0 {
-                // Adjust previous NAL to run up to this one.
-                let lastRange = ranges[index - 1]
-
-                if naluRangesIndex > 0 {
-                    if range.lowerBound <= naluRanges[naluRangesIndex - 1].upperBound {
-                        index += 1
-                        continue
-                    }
-                }
-
-                let type = H264Types(rawValue: data[lastRange.upperBound] & 0x1F)
-
-                // RBSP types can have data that might include a "0001". So,
-                // use the payload size to get the whole sub buffer.
-                if type == .sei { // RBSP
-                    let payloadSize = data[lastRange.upperBound + 2]
-                    let upperBound = Int(payloadSize) + lastRange.lowerBound + Self.naluStartCode.count + 3
-                    naluRanges.append(.init(lastRange.lowerBound...upperBound))
-
-                } else {
-                    naluRanges.append(.init(lastRange.lowerBound...range.lowerBound - 1))
-                }
-                naluRangesIndex += 1
-            }
-            index += 1
-        }
-
-        // Adjust the last range to run to the end of data.
-        if let lastRange = ranges.last {
-            let range = Range<Data.Index>(lastRange.lowerBound...data.count-1)
-            naluRanges.append(range)
-        }
-
-        // Get NALU data objects (zero copy).
-        var nalus: [Data] = []
-        let nsData = data as NSData
-        for range in naluRanges {
-            nalus.append(Data(bytesNoCopy: .init(mutating: nsData.bytes.advanced(by: range.lowerBound)),
-                              count: range.count,
-                              deallocator: .none))
-        }
-
-        // Finally! We have all of the nalu ranges for this frame...
         var spsData: Data?
         var ppsData: Data?
-
-        // Create block buffers from NALUs.
         var results: [CMBlockBuffer] = []
-        for index in 0..<nalus.count {
-            // What type is this NALU?
-            var nalu = nalus[index]
-            assert(nalu.starts(with: Self.naluStartCode))
-            let type = H264Types(rawValue: nalu[Self.naluStartCode.count] & 0x1F)
-            let rangedData = nalu.subdata(in: Self.naluStartCode.count..<nalu.count)
-
-            if type == .sps {
-                spsData = rangedData
-            }
-
-            if type == .pps {
-                ppsData = rangedData
-            }
-
-            if type == .sei {
-                seiCallback(nalu)
-            }
-
-            if let sps = spsData,
-               let pps = ppsData {
-                format = try CMVideoFormatDescription(h264ParameterSets: [sps, pps],
-                                                      nalUnitHeaderLength: Self.naluStartCode.count)
-                spsData = nil
-                ppsData = nil
-            }
+        try data.withUnsafeBytes { bytes in
+            try AnnexB.withNalus(bytes, codec: .h264) { nalus in
+                for nalu in nalus {
+                    let type = H264Types(rawValue: nalu.type)
+                    switch type {
+                    case .sps:
+                        spsData = Data(AnnexB.payload(bytes, nalu))
+                    case .pps:
+                        ppsData = Data(AnnexB.payload(bytes, nalu))
+                    case .sei:
+                        seiCallback(AnnexB.sei(bytes, nalu, startCode: Self.naluStartCode))
+                    case .pFrame, .idr:
+                        results.append(try AnnexB.buildLengthPrefixedBlockBuffer(bytes, nalu))
+                    default:
+                        break
+                    }
 
-            if type == .pFrame || type == .idr {
-                var naluDataLength = UInt32(nalu.count - Self.naluStartCode.count).byteSwapped
-                nalu.replaceSubrange(0..<Self.naluStartCode.count,
-                                     with: &naluDataLength,
-                                     count: Self.naluStartCode.count)
-                try nalu.withUnsafeBytes {
-                    results.append(try Self.buildBlockBuffer($0,
-                                                             copy: copy))
+                    if let sps = spsData,
+                       let pps = ppsData {
+                        format = try CMVideoFormatDescription(h264ParameterSets: [sps, pps],
+                                                              nalUnitHeaderLength: Self.naluStartCode.count)
+                        spsData = nil
+                        ppsData = nil
+                    }
                 }
             }
         }
         return results.count > 0 ? results : nil
     }
 
+    /// Wrap NALU bytes in a block buffer.
+    /// - Parameter nalu: The length prefixed NALU.
+    /// - Parameter copy: True to copy the bytes into a new allocation.
+    /// - Parameter owner: When not copying, retained until the block buffer is released so that
+    /// the backing storage (e.g. a pooled received payload) outlives the decoder's use of it.
     static func buildBlockBuffer(_ nalu: UnsafeRawBufferPointer,
-                                 copy: Bool) throws -> CMBlockBuffer {
+                                 copy: Bool,
+                                 owner: Any? = nil) throws -> CMBlockBuffer {
         let blockBuffer: CMBlockBuffer
         if copy {
             let copied: UnsafeMutableRawBufferPointer = .allocate(byteCount: nalu.count,
@@ -219,7 +162,9 @@ class H264Utilities: VideoUtilities {
             })
         } else {
             blockBuffer = try CMBlockBuffer(buffer: .init(start: .init(mutating: nalu.baseAddress!),
-                                                          count: nalu.count)) { _, _ in }
+                                                          count: nalu.count)) { _, _ in
+                withExtendedLifetime(owner) {}
+            }
         }
         return blockBuffer
     }
@@ -38,19 +38,20 @@ class HEVCUtilities: VideoUtilities {
                 try depacketizeLength($0,
                                       format: &format,
                                       copy: copy,
+                                      owner: data,
                                       seiCallback: seiCallback)
             }
         }
     }
 
-    /// Turns an HEVC Annex B bitstream into CMSampleBuffer per NALU.
-    /// - Parameter data The HEVC data.
-    /// This is used in place and will be modified, so much outlive any use of the created samples.
-    /// - Parameter timeInfo The timing info for this frame.
+    /// Turns an HEVC Annex B bitstream into a length prefixed block buffer per frame NALU.
+    /// - Parameter data The HEVC data. Both 3 and 4 byte start codes are accepted.
     /// - Parameter format The current format of the stream if known.
-    /// If SPS/PPS are found, it will be replaced by the found format.
-    /// - Parameter sei If an SEI if found, it will be passed to this callback (start code included).
-    func depacketizeAnnexB(_ data: Data, // swiftlint:disable:this function_body_length
+    /// If VPS/SPS/PPS are found, it will be replaced by the found format.
+    /// - Parameter copy Unused: the start code has to be rewritten as a length, so NALUs are always copied.
+    /// - Parameter sei If an SEI if found, it will be passed to this callback
+    /// (4 byte start code included, emulation prevention removed).
+    func depacketizeAnnexB(_ data: Data,
                            format: inout CMFormatDescription?,
                            copy: Bool,
                            seiCallback: (Data) -> Void) throws -> [CMBlockBuffer]? {
@@ -58,109 +59,36 @@ class HEVCUtilities: VideoUtilities {
             throw PacketizationError.missingStartCode
         }
 
-        // Identify all NALUs by start code.
-        var ranges: [Range<Data.Index>] = []
-        var naluRanges: [Range<Data.Index>] = []
-        var startIndex = 0
-        var index = 0
-        var naluRangesIndex = 0
-        while let range = data.range(of: .init(Self.naluStartCode), in: startIndex..<data.count) {
-            ranges.append(range)
-            startIndex = range.upperBound
-            if index > 0 {
-                // Adjust previous NAL to run up to this one.
-                let lastRange = ranges[index - 1]
-                if naluRangesIndex > 0 {
-                    if range.lowerBound <= naluRanges[naluRangesIndex - 1].upperBound {
-                        index += 1
-                        continue
-                    }
-                }
-
-                let naluType = (data[lastRange.upperBound] >> 1) & 0x3f
-                let type = HEVCTypes(rawValue: naluType)
-
-                // RBSP types can have data that include a "0001". So,
-                // use the playload size to the whole sub buffer.
-                if type == .sei { // RBSP
-                    let payloadSize = data[lastRange.upperBound + 3]
-                    let upperBound = Int(payloadSize) + lastRange.lowerBound + Self.naluStartCode.count + 4
-                    naluRanges.append(.init(lastRange.lowerBound...upperBound))
-                } else {
-                    naluRanges.append(.init(lastRange.lowerBound...range.lowerBound - 1))
-                }
-                naluRangesIndex += 1
-            }
-            index += 1
-        }
-
-        // Adjust the last range to run to the end of data.
-        if let lastRange = ranges.last {
-            let range = Range<Data.Index>(lastRange.lowerBound...data.count-1)
-            naluRanges.append(range)
-        }
-
-        // Get NALU data objects (zero copy).
-        var nalus: [Data] = []
-        let nsData = data as NSData
-        for range in naluRanges {
-            nalus.append(Data(bytesNoCopy: .init(mutating: nsData.bytes.advanced(by: range.lowerBound)),
-                              count: range.count,
-                              deallocator: .none))
-        }
-
-        // Finally! We have all of the nalu ranges for this frame...
         var spsData: Data?
         var ppsData: Data?
         var vpsData: Data?
-
-        // Create sample buffers from NALUs.
         var results: [CMBlockBuffer] = []
-        for index in 0..<nalus.count {
-            // What type is this NALU?
-            var nalu = nalus[index]
-            let naluType = (nalu[Self.naluStartCode.count] >> 1) & 0x3f
-            let type = HEVCTypes(rawValue: naluType)
-            let rangedData = nalu.subdata(in: Self.naluStartCode.count..<nalu.count)
-
-            if type == .vps {
-                vpsData = rangedData
-            }
-
-            if type == .sps {
-                spsData = rangedData
-            }
-
-            if type == .pps {
-                ppsData = rangedData
-            }
-
-            if type == .sei {
-                seiCallback(nalu)
-            }
-
-            if let vps = vpsData,
-               let sps = spsData,
-               let pps = ppsData {
-                format = try CMVideoFormatDescription(hevcParameterSets: [vps, sps, pps],
-                                                      nalUnitHeaderLength: Self.naluStartCode.count)
-                vpsData = nil
-                spsData = nil
-                ppsData = nil
-            }
-
-            guard type != .vps,
-                  type != .sps,
-                  type != .pps,
-                  type != .sei else {
-                continue
-            }
+        try data.withUnsafeBytes { bytes in
+            try AnnexB.withNalus(bytes, codec: .hevc) { nalus in
+                for nalu in nalus {
+                    switch HEVCTypes(rawValue: nalu.type) {
+                    case .vps:
+                        vpsData = Data(AnnexB.payload(bytes, nalu))
+                    case .sps:
+                        spsData = Data(AnnexB.payload(bytes, nalu))
+                    case .pps:
+                        ppsData = Data(AnnexB.payload(bytes, nalu))
+                    case .sei:
+                        seiCallback(AnnexB.sei(bytes, nalu, startCode: Self.naluStartCode))
+                    default:
+                        results.append(try AnnexB.buildLengthPrefixedBlockBuffer(bytes, nalu))
+                    }
 
-            var naluDataLength = UInt32(nalu.count - Self.naluStartCode.count).byteSwapped
-            nalu.replaceSubrange(0..<Self.naluStartCode.count, with: &naluDataLength, count: Self.naluStartCode.count)
-            try nalu.withUnsafeBytes {
-                results.append(try H264Utilities.buildBlockBuffer($0,
-                                                                  copy: copy))
+                    if let vps = vpsData,
+                       let sps = spsData,
+                       let pps = ppsData {
+                        format = try CMVideoFormatDescription(hevcParameterSets: [vps, sps, pps],
+                                                              nalUnitHeaderLength: Self.naluStartCode.count)
+                        vpsData = nil
+                        spsData = nil
+                        ppsData = nil
+                    }
+                }
             }
         }
         return results.count > 0 ? results : nil
@@ -169,6 +97,7 @@ class HEVCUtilities: VideoUtilities {
     private func depacketizeLength(_ data: UnsafeRawBufferPointer,
                                    format: inout CMFormatDescription?,
                                    copy: Bool,
+                                   owner: Any?,
                                    seiCallback: (Data) -> Void) throws -> [CMBlockBuffer]? {
         var results: [CMBlockBuffer] = []
         var offset = 0
@@ -223,7 +152,8 @@ class HEVCUtilities: VideoUtilities {
                 let length = Int(length) + MemoryLayout<UInt32>.size
                 results.append(try H264Utilities.buildBlockBuffer(UnsafeRawBufferPointer(start: ptr,
                                                                                          count: length),
-                                                                  copy: copy))
+                                                                  copy: copy,
+                                                                  owner: owner))
             }
             offset += MemoryLayout<UInt32>.size + Int(length)
         }
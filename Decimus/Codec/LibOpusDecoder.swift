@@ -5,10 +5,19 @@ import Opus
 import AVFAudio
 
 /// Decodes audio using libopus.
+/// Decoded and concealed audio are written into buffers owned by the decoder, so nothing is allocated per
+/// packet. They are separate, as a jitter buffer may conceal a gap while holding a decoded packet.
+/// Must be called from a single thread.
 class LibOpusDecoder: AudioDecoder {
+    /// Longest opus packet, which is also the most audio concealed in one call.
+    static let maxDuration: TimeInterval = 0.12
+
     private let decoder: Opus.Decoder
+    private let decoded: AVAudioPCMBuffer
+    private let concealed: AVAudioPCMBuffer
     let decodedFormat: AVAudioFormat
     let encodedFormat: AVAudioFormat
+    var maxFrames: AVAudioFrameCount { self.decoded.frameCapacity }
 
     /// Create an opus decoder.
     /// - Parameter format: Format to decode into.
@@ -16,12 +25,27 @@ class LibOpusDecoder: AudioDecoder {
         self.decodedFormat = format
         self.encodedFormat = format
         decoder = try .init(format: format, application: .voip)
+        let capacity = AVAudioFrameCount(Self.maxDuration * format.sampleRate)
+        guard let decoded = AVAudioPCMBuffer(pcmFormat: format, frameCapacity: capacity),
+              let concealed = AVAudioPCMBuffer(pcmFormat: format, frameCapacity: capacity) else {
+            throw "Couldn't create decode buffers"
+        }
+        self.decoded = decoded
+        self.concealed = concealed
     }
 
     /// Write some encoded data to the decoder.
     /// - Parameter data: Pointer to some encoded opus data.
+    /// - Returns: The decoded audio, only valid until the next write.
     func write(data: Data) throws -> AVAudioPCMBuffer {
-        return try decoder.decode(data)
+        let frames = try self.frames(data: data)
+        guard frames <= self.maxFrames else {
+            throw "Opus packet of \(frames) frames exceeds \(self.maxFrames)"
+        }
+        try data.withUnsafeBytes {
+            try self.decoder.decode($0.bindMemory(to: UInt8.self), to: self.decoded, count: frames)
+        }
+        return self.decoded
     }
 
     /// Get number of audio frames in the encoded data.
@@ -29,12 +53,15 @@ class LibOpusDecoder: AudioDecoder {
         return try self.decoder.getNumberSamples(data)
     }
 
+    /// Conceal missing audio, however many packets it spans, in one call.
+    /// - Parameter frames: Frames to conceal, up to `maxFrames`.
+    /// - Returns: The concealed audio, only valid until the next PLC call.
     func plc(frames: AVAudioFrameCount) throws -> AVAudioPCMBuffer {
-        guard let plc: AVAudioPCMBuffer = .init(pcmFormat: decodedFormat, frameCapacity: frames) else {
-            throw "Couldn't create PLC holder"
+        guard frames <= self.maxFrames else {
+            throw "Can't conceal \(frames) frames at once, limit is \(self.maxFrames)"
         }
-        try decoder.decode(nil, to: plc, count: frames)
-        return plc
+        try decoder.decode(nil, to: self.concealed, count: frames)
+        return self.concealed
     }
 
     func reset() throws {
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import CoreMedia
+import CoreVideo
+import Synchronization
+
+/// Stands in for a decoder without decoding anything.
+///
+/// Every frame written comes out as a blank image of the stream's dimensions, carrying the frame's timing, so
+/// that the whole receive path after decode can be run and profiled at scale without decode hardware.
+final class PassthroughDecoder: VideoDecoder {
+    private struct Images {
+        let dimensions: CMVideoDimensions
+        let pool: CVPixelBufferPool
+        let format: CMVideoFormatDescription
+    }
+
+    private let logger = DecimusLogger(PassthroughDecoder.self)
+    let decoded: AsyncStream<CMSampleBuffer>
+    private let continuation: AsyncStream<CMSampleBuffer>.Continuation
+    private let config: VideoCodecConfig
+    private let images = Mutex<Images?>(nil)
+
+    init(config: VideoCodecConfig, decodeBufferSize: Int) {
+        self.config = config
+        (self.decoded, self.continuation) = AsyncStream.makeStream(bufferingPolicy: .bufferingNewest(decodeBufferSize))
+    }
+
+    deinit {
+        self.continuation.finish()
+    }
+
+    func write(_ sample: CMSampleBuffer) throws {
+        // Encoded formats carry the stream's real dimensions, which may differ from its profile's.
+        let dimensions = if let format = sample.formatDescription,
+                            format.mediaType == .video {
+            format.dimensions
+        } else {
+            CMVideoDimensions(width: self.config.width, height: self.config.height)
+        }
+        var image: CVPixelBuffer?
+        var format: CMVideoFormatDescription?
+        try self.images.withLock { images in
+            if images == nil || images!.dimensions != dimensions {
+                images = try Self.makeImages(dimensions)
+            }
+            image = try Self.makeImage(images!.pool)
+            format = images!.format
+        }
+        let output = try CMSampleBuffer(imageBuffer: image!,
+                                        formatDescription: format!,
+                                        sampleTiming: .init(duration: sample.duration,
+                                                            presentationTimeStamp: sample.presentationTimeStamp,
+                                                            decodeTimeStamp: .invalid))
+        output.discontinous = sample.discontinous
+        if case .dropped = self.continuation.yield(output) {
+            self.logger.warning("Decoder queue backpressure, dropped frame")
+        }
+    }
+
+    private static func makeImages(_ dimensions: CMVideoDimensions) throws -> Images {
+        let attributes: [String: Any] = [
+            kCVPixelBufferPixelFormatTypeKey as String: kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange,
+            kCVPixelBufferWidthKey as String: dimensions.width,
+            kCVPixelBufferHeightKey as String: dimensions.height
+        ]
+        var pool: CVPixelBufferPool?
+        let error = CVPixelBufferPoolCreate(nil, nil, attributes as CFDictionary, &pool)
+        guard error == kCVReturnSuccess, let pool else {
+            throw "Failed to create pixel buffer pool: \(error)"
+        }
+        // Images from a pool share its attributes, so also their format.
+        let format = try CMVideoFormatDescription(imageBuffer: try Self.makeImage(pool))
+        return .init(dimensions: dimensions, pool: pool, format: format)
+    }
+
+    private static func makeImage(_ pool: CVPixelBufferPool) throws -> CVPixelBuffer {
+        var image: CVPixelBuffer?
+        let error = CVPixelBufferPoolCreatePixelBuffer(nil, pool, &image)
+        guard error == kCVReturnSuccess, let image else {
+            throw "Failed to create pixel buffer: \(error)"
+        }
+        return image
+    }
+}
@@ -7,8 +7,17 @@ import Synchronization
 // FIXME: Consider CMReadySampleBuffer in 26.0 to avoid this.
 extension CMSampleBuffer: @retroactive @unchecked Sendable { }
 
+/// Decodes a received video stream.
+protocol VideoDecoder: Sendable {
+    /// Decoded images, in decode order.
+    var decoded: AsyncStream<CMSampleBuffer> { get }
+
+    /// Write a new frame to the decoder.
+    func write(_ sample: CMSampleBuffer) throws
+}
+
 /// Provides hardware accelerated decoding.
-final class VTDecoder: Sendable {
+final class VTDecoder: VideoDecoder {
     typealias DecodedFrameCallback = @Sendable (CMSampleBuffer) -> Void
     private let logger = DecimusLogger(VTDecoder.self)
 
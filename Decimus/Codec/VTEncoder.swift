@@ -12,6 +12,10 @@ protocol VideoEncoder: Sendable {
                                            _ sample: CMSampleBuffer,
                                            _ userData: UnsafeRawPointer?) -> Void
     func write(sample: CMSampleBuffer, timestamp: Date, forceKeyFrame: Bool) throws
+
+    /// Change the target bitrate of subsequent frames.
+    /// - Parameter bitrate: The target in bits per second.
+    func setBitrate(_ bitrate: UInt32) throws
 }
 
 typealias VideoEncoderFactory = @Sendable (_ callback: @escaping VideoEncoder.EncodedCallback,
@@ -57,7 +61,7 @@ final class VTEncoder: VideoEncoder {
         self.keyFrameInterval = keyFrameInterval
         self.callback = callback
         self.userData = userData
-        self.bufferAllocator = .init(1*1024*1024, hdrSize: 512)
+        self.bufferAllocator = .init(1*1024*1024, hdrSize: 512, slots: 4)
         let allocator: CFAllocator?
         #if targetEnvironment(macCatalyst) || os(macOS)
         allocator = self.bufferAllocator.allocator().takeUnretainedValue()
@@ -124,35 +128,7 @@ final class VTEncoder: VideoEncoder {
                                  value: kCFBooleanFalse)
         }
 
-        let bitrateKey: CFString
-        switch config.bitrateType {
-        case .constant:
-            bitrateKey = kVTCompressionPropertyKey_ConstantBitRate
-        case .average:
-            bitrateKey = kVTCompressionPropertyKey_AverageBitRate
-        }
-
-        try OSStatusError.checked("Set average bitrate: \(self.config.bitrate)") {
-            VTSessionSetProperty(compressionSession,
-                                 key: bitrateKey,
-                                 value: config.bitrate as CFNumber)
-        }
-
-        // Limit to 8 frames of bitrate over 8 frame times.
-        let bitrateInBytes = Double(self.config.bitrate) / 8.0
-        let eightFrameTimes: TimeInterval = (1.0 / Double(self.config.fps)) * 8.0
-        let dataRateLimits: NSArray = [
-
-            NSNumber(value: eightFrameTimes * bitrateInBytes),
-            NSNumber(value: eightFrameTimes)
-        ]
-        #if !os(tvOS)
-        try OSStatusError.checked("Set data limit") {
-            VTSessionSetProperty(compressionSession,
-                                 key: kVTCompressionPropertyKey_DataRateLimits,
-                                 value: dataRateLimits as CFArray)
-        }
-        #endif
+        try Self.setBitrate(config.bitrate, session: compressionSession, config: config)
 
         try OSStatusError.checked("Set expected frame rate: \(self.config.fps)") {
             VTSessionSetProperty(compressionSession,
@@ -237,6 +213,45 @@ final class VTEncoder: VideoEncoder {
         }
     }
 
+    func setBitrate(_ bitrate: UInt32) throws {
+        guard let encoder = self.encoder else { throw "Missing encoder" }
+        try Self.setBitrate(bitrate, session: encoder, config: self.config)
+    }
+
+    private static func setBitrate(_ bitrate: UInt32,
+                                   session: VTCompressionSession,
+                                   config: VideoCodecConfig) throws {
+        let bitrateKey: CFString
+        switch config.bitrateType {
+        case .constant:
+            bitrateKey = kVTCompressionPropertyKey_ConstantBitRate
+        case .average:
+            bitrateKey = kVTCompressionPropertyKey_AverageBitRate
+        }
+
+        try OSStatusError.checked("Set average bitrate: \(bitrate)") {
+            VTSessionSetProperty(session,
+                                 key: bitrateKey,
+                                 value: bitrate as CFNumber)
+        }
+
+        // Limit to 8 frames of bitrate over 8 frame times.
+        let bitrateInBytes = Double(bitrate) / 8.0
+        let eightFrameTimes: TimeInterval = (1.0 / Double(config.fps)) * 8.0
+        let dataRateLimits: NSArray = [
+
+            NSNumber(value: eightFrameTimes * bitrateInBytes),
+            NSNumber(value: eightFrameTimes)
+        ]
+        #if !os(tvOS)
+        try OSStatusError.checked("Set data limit") {
+            VTSessionSetProperty(session,
+                                 key: kVTCompressionPropertyKey_DataRateLimits,
+                                 value: dataRateLimits as CFArray)
+        }
+        #endif
+    }
+
     func encoded(frameRefCon: UnsafeMutableRawPointer?,
                  status: OSStatus,
                  flags: VTEncodeInfoFlags,
@@ -255,24 +270,36 @@ final class VTEncoder: VideoEncoder {
             return
         }
 
-        let buffer: CMBlockBuffer
+        let encoded: CMSampleBuffer
         #if !targetEnvironment(macCatalyst) || os(macOS)
+        let buffer: CMBlockBuffer
         let bufferSize = sample.dataBuffer!.dataLength
-        bufferAllocator.iosDeallocBuffer(nil) // SAH - just resets pointers
         guard let bufferPtr = bufferAllocator.iosAllocBuffer(bufferSize) else {
-            self.logger.error("Failed to allocate ios buffer")
+            let stats = bufferAllocator.stats()
+            self.logger.error("Failed to allocate ios buffer (\(stats.inUse)/\(stats.slots) in use)")
             return
         }
         let rangedBufferPtr = UnsafeMutableRawBufferPointer(start: bufferPtr, count: bufferSize)
         do {
-            buffer = try .init(buffer: rangedBufferPtr, deallocator: { _, _ in })
+            // The slot is returned to the allocator when the last reference to the block buffer goes away.
             try sample.dataBuffer!.copyDataBytes(to: rangedBufferPtr)
+            buffer = try .init(buffer: rangedBufferPtr, deallocator: { [bufferAllocator] buffer, _ in
+                bufferAllocator.iosDeallocBuffer(buffer.baseAddress)
+            })
         } catch {
+            // No block buffer owns the slot, so release it here.
+            bufferAllocator.iosDeallocBuffer(bufferPtr)
             self.logger.error("Failed to copy data buffer: \(error.localizedDescription)")
             return
         }
+        do {
+            encoded = try Self.sample(sample, backedBy: buffer)
+        } catch {
+            self.logger.error("Failed to rebuild encoded sample: \(error.localizedDescription)")
+            return
+        }
         #else
-        buffer  = sample.dataBuffer!
+        encoded = sample
         #endif
 
         // Rebuild absolute timestamp.
@@ -282,14 +309,31 @@ final class VTEncoder: VideoEncoder {
         }
         let retrievedTimestamp = Unmanaged<NSValue>.fromOpaque(frameRefCon).takeUnretainedValue().timeValue
         let absoluteTimestamp = Date.init(timeIntervalSince1970: retrievedTimestamp.seconds)
-        self.callback(absoluteTimestamp, sample, self.userData)
+        self.callback(absoluteTimestamp, encoded, self.userData)
+    }
+
+    /// The given encoded sample, with its data in the given buffer.
+    private static func sample(_ sample: CMSampleBuffer, backedBy buffer: CMBlockBuffer) throws -> CMSampleBuffer {
+        let rebuilt = try CMSampleBuffer(dataBuffer: buffer,
+                                         formatDescription: sample.formatDescription,
+                                         numSamples: sample.numSamples,
+                                         sampleTimings: sample.sampleTimingInfos(),
+                                         sampleSizes: sample.sampleSizes())
+        // Keyframe and dependency information lives in the per-sample attachments.
+        for (index, attachments) in sample.sampleAttachments.enumerated() where index < rebuilt.sampleAttachments.count {
+            for (key, value) in attachments {
+                rebuilt.sampleAttachments[index][key] = value
+            }
+        }
+        return rebuilt
     }
 
     private func prependTimestampSEI(fps: UInt8,
+                                     buffer: UnsafeMutableRawPointer,
                                      bufferAllocator: BufferAllocator) {
         let bytes = TimestampSei(fps: fps).getBytes(self.seiData,
                                                     startCode: self.emitStartCodes)
-        guard let timestampPtr = bufferAllocator.allocateBufferHeader(bytes.count) else {
+        guard let timestampPtr = bufferAllocator.allocateBufferHeader(bytes.count, buffer: buffer) else {
             self.logger.error("Couldn't allocate timestamp buffer")
             return
         }
@@ -300,11 +344,12 @@ final class VTEncoder: VideoEncoder {
 
     private func prependOrientationSEI(orientation: DecimusVideoRotation,
                                        verticalMirror: Bool,
+                                       buffer: UnsafeMutableRawPointer,
                                        bufferAllocator: BufferAllocator) throws {
         let bytes = OrientationSei(orientation: orientation,
                                    verticalMirror: verticalMirror).getBytes(self.seiData,
                                                                             startCode: self.emitStartCodes)
-        guard let orientationPtr = bufferAllocator.allocateBufferHeader(bytes.count) else {
+        guard let orientationPtr = bufferAllocator.allocateBufferHeader(bytes.count, buffer: buffer) else {
             throw "Failed to allocate orientation header"
         }
         let orientationBufferPtr = UnsafeMutableRawBufferPointer(start: orientationPtr, count: bytes.count)
@@ -9,3 +9,77 @@ protocol VideoUtilities {
                      copy: Bool,
                      seiCallback: (Data) -> Void) throws -> [CMBlockBuffer]?
 }
+
+/// Annex B bitstream helpers shared by H264 and HEVC.
+enum AnnexB {
+    /// Enough for a typical frame's NALUs without allocating.
+    private static let inlineSpans = 32
+
+    /// Find every NALU in an Annex B bitstream in a single pass.
+    /// - Parameter data: The bitstream.
+    /// - Parameter codec: How to decode NALU types.
+    /// - Parameter body: Called with the NALUs found, in order. Only valid for the duration of the call.
+    static func withNalus<Result>(_ data: UnsafeRawBufferPointer,
+                                  codec: QNalCodec,
+                                  _ body: (UnsafeBufferPointer<QNalSpan>) throws -> Result) rethrows -> Result {
+        guard let base = data.baseAddress else {
+            return try body(.init(start: nil, count: 0))
+        }
+        return try withUnsafeTemporaryAllocation(of: QNalSpan.self, capacity: Self.inlineSpans) { spans in
+            let found = QAnnexBScanner.scan(base,
+                                            length: data.count,
+                                            codec: codec,
+                                            spans: spans.baseAddress!,
+                                            capacity: spans.count)
+            guard found > spans.count else {
+                return try body(.init(rebasing: spans[..<found]))
+            }
+            let all = UnsafeMutableBufferPointer<QNalSpan>.allocate(capacity: found)
+            defer { all.deallocate() }
+            _ = QAnnexBScanner.scan(base, length: data.count, codec: codec, spans: all.baseAddress!, capacity: found)
+            return try body(.init(all))
+        }
+    }
+
+    /// The NALU's bytes, header included, start code excluded.
+    static func payload(_ data: UnsafeRawBufferPointer, _ nalu: QNalSpan) -> UnsafeRawBufferPointer {
+        .init(rebasing: data[nalu.offset..<nalu.offset + nalu.length])
+    }
+
+    /// Copy a NALU into a new block buffer, replacing its start code with a 4 byte big endian length.
+    static func buildLengthPrefixedBlockBuffer(_ data: UnsafeRawBufferPointer, _ nalu: QNalSpan) throws -> CMBlockBuffer {
+        let prefix = MemoryLayout<UInt32>.size
+        let buffer: UnsafeMutableRawBufferPointer = .allocate(byteCount: prefix + nalu.length,
+                                                              alignment: MemoryLayout<UInt32>.alignment)
+        buffer.storeBytes(of: UInt32(nalu.length).bigEndian, as: UInt32.self)
+        UnsafeMutableRawBufferPointer(rebasing: buffer[prefix...]).copyMemory(from: Self.payload(data, nalu))
+        do {
+            return try .init(buffer: buffer, deallocator: { buffer, _ in
+                buffer.deallocate()
+            })
+        } catch {
+            buffer.deallocate()
+            throw error
+        }
+    }
+
+    /// A copy of an SEI NALU with a 4 byte start code and emulation prevention removed,
+    /// as application SEI parsing expects.
+    static func sei(_ data: UnsafeRawBufferPointer, _ nalu: QNalSpan, startCode: [UInt8]) -> Data {
+        let payload = Self.payload(data, nalu)
+        var sei = Data(capacity: startCode.count + payload.count)
+        sei.append(contentsOf: startCode)
+        guard nalu.escaped else {
+            sei.append(contentsOf: payload)
+            return sei
+        }
+        sei.count = startCode.count + payload.count
+        let unescaped = sei.withUnsafeMutableBytes {
+            QAnnexBScanner.unescape(payload.baseAddress!,
+                                    length: payload.count,
+                                    destination: $0.baseAddress!.advanced(by: startCode.count))
+        }
+        sei.count = startCode.count + unescaped
+        return sei
+    }
+}
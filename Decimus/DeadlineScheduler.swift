@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Dispatch
+import Synchronization
+
+/// Runs many periodic jobs from one serial queue with a single timer, rather than each sleeping in its own task.
+///
+/// Each job says when it next wants to run. The timer is armed for the earliest of those, and every job due
+/// within `tolerance` of it runs in the same wakeup. Jobs always run on the scheduler's queue, so state
+/// only they touch needs no further synchronization.
+final class DeadlineScheduler: Sendable {
+    /// Run a job.
+    /// - Parameter now: When it is being run.
+    /// - Returns: Seconds until it should next run, or nil to stop running it.
+    typealias Job = @Sendable (Ticks) -> TimeInterval?
+    typealias Token = Int
+
+    /// The one clock that all media playout runs from, so that every participant's audio and video is
+    /// dequeued and rendered by the same thread.
+    static let playout = DeadlineScheduler(label: "Playout")
+
+    private struct Entry {
+        let job: Job
+        var deadline: Ticks
+    }
+
+    private let queue: DispatchQueue
+    private nonisolated(unsafe) let timer: DispatchSourceTimer
+    private let tolerance: TimeInterval
+    private let nextToken = Atomic<Token>(0)
+    private let wakeupCount = Atomic<UInt64>(0)
+    // Only accessed on `queue`.
+    private nonisolated(unsafe) var entries: [Token: Entry] = [:]
+    private nonisolated(unsafe) var deadlines = DeadlineHeap()
+    private nonisolated(unsafe) var armed: Ticks?
+
+    /// Number of times the timer has fired, which coalescing keeps below the sum of the jobs' rates.
+    var wakeups: UInt64 {
+        self.wakeupCount.load(ordering: .relaxed)
+    }
+
+    /// Create a scheduler.
+    /// - Parameter label: Name of its queue.
+    /// - Parameter tolerance: How early a job may run so that it shares another's wakeup.
+    init(label: String, tolerance: TimeInterval = 0.002) {
+        self.queue = .init(label: label, qos: .userInteractive)
+        self.timer = DispatchSource.makeTimerSource(queue: self.queue)
+        self.tolerance = tolerance
+        self.timer.setEventHandler { [weak self] in
+            self?.fire()
+        }
+        self.timer.activate()
+    }
+
+    deinit {
+        self.timer.cancel()
+    }
+
+    /// Start running a job, first as soon as possible.
+    /// - Parameter job: The job, which is held until it returns nil or is cancelled.
+    /// - Returns: Token to cancel it with.
+    @discardableResult
+    func schedule(_ job: @escaping Job) -> Token {
+        let token = self.nextToken.add(1, ordering: .relaxed).newValue
+        self.queue.async { [weak self] in
+            guard let self else { return }
+            let deadline = Ticks.now
+            self.entries[token] = .init(job: job, deadline: deadline)
+            self.deadlines.push(deadline, token: token)
+            self.rearm()
+        }
+        return token
+    }
+
+    /// Stop running a job. It will not be run again, though may be running now.
+    func cancel(_ token: Token) {
+        self.queue.async { [weak self] in
+            guard let self else { return }
+            // Its deadline is left in the heap, and skipped when reached.
+            self.entries.removeValue(forKey: token)
+            self.rearm()
+        }
+    }
+
+    /// Run a job by `deadline`, if it would otherwise run later. Has no effect on a job that has stopped.
+    func reschedule(_ token: Token, by deadline: Ticks) {
+        self.queue.async { [weak self] in
+            guard let self, let entry = self.entries[token], deadline < entry.deadline else { return }
+            // Its old deadline is left in the heap, and skipped when reached.
+            self.entries[token]?.deadline = deadline
+            self.deadlines.push(deadline, token: token)
+            self.rearm()
+        }
+    }
+
+    private func fire() {
+        self.armed = nil
+        self.wakeupCount.add(1, ordering: .relaxed)
+        let now = Ticks.now
+        let due = now + self.tolerance.ticks
+        var rescheduled: [(deadline: Ticks, token: Token)] = []
+        while let next = self.deadlines.first, next.deadline <= due {
+            self.deadlines.pop()
+            guard let entry = self.entries[next.token],
+                  entry.deadline == next.deadline else { continue }
+            if let wait = entry.job(now) {
+                let deadline = now + max(wait, 0).ticks
+                self.entries[next.token]?.deadline = deadline
+                rescheduled.append((deadline, next.token))
+            } else {
+                self.entries.removeValue(forKey: next.token)
+            }
+        }
+        // Only after all due have run, so that one wanting to run again immediately waits for the next wakeup.
+        for (deadline, token) in rescheduled {
+            self.deadlines.push(deadline, token: token)
+        }
+        self.rearm()
+    }
+
+    private func rearm() {
+        // Discard the deadlines of cancelled jobs.
+        while let next = self.deadlines.first, self.entries[next.token]?.deadline != next.deadline {
+            self.deadlines.pop()
+        }
+        guard let earliest = self.deadlines.first?.deadline else {
+            self.armed = nil
+            self.timer.schedule(deadline: .distantFuture)
+            return
+        }
+        guard earliest != self.armed else { return }
+        self.armed = earliest
+        let wait = max(earliest.timeIntervalSince(.now), 0)
+        self.timer.schedule(deadline: .now() + wait, leeway: .nanoseconds(Int(self.tolerance * nanosecondsPerSecond)))
+    }
+}
+
+/// Binary min-heap of job deadlines, earliest first, ties in the order jobs were scheduled.
+private struct DeadlineHeap {
+    private var items: [(deadline: Ticks, token: DeadlineScheduler.Token)] = []
+
+    var first: (deadline: Ticks, token: DeadlineScheduler.Token)? {
+        self.items.first
+    }
+
+    mutating func push(_ deadline: Ticks, token: DeadlineScheduler.Token) {
+        self.items.append((deadline, token))
+        var child = self.items.count - 1
+        while child > 0 {
+            let parent = (child - 1) / 2
+            guard self.before(child, parent) else { break }
+            self.items.swapAt(child, parent)
+            child = parent
+        }
+    }
+
+    mutating func pop() {
+        guard self.items.count > 1 else {
+            self.items.removeAll(keepingCapacity: true)
+            return
+        }
+        self.items[0] = self.items.removeLast()
+        var parent = 0
+        while true {
+            let left = parent * 2 + 1
+            let right = left + 1
+            var smallest = parent
+            if left < self.items.count && self.before(left, smallest) {
+                smallest = left
+            }
+            if right < self.items.count && self.before(right, smallest) {
+                smallest = right
+            }
+            guard smallest != parent else { return }
+            self.items.swapAt(parent, smallest)
+            parent = smallest
+        }
+    }
+
+    private func before(_ lhs: Int, _ rhs: Int) -> Bool {
+        let lhs = self.items[lhs]
+        let rhs = self.items[rhs]
+        return lhs.deadline < rhs.deadline || lhs.deadline == rhs.deadline && lhs.token < rhs.token
+    }
+}
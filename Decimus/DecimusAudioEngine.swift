@@ -12,6 +12,12 @@ class DecimusAudioEngine {
                                              channels: 1,
                                              interleaved: false)!
 
+    /// Most remote sources that can play at once.
+    static let maxPlayers = 128
+
+    /// Most frames a player is asked to render at a time.
+    static let maxRenderFrames: UInt32 = 4096
+
     private let logger: DecimusLogger = .init(DecimusAudioEngine.self)
 
     /// Microphone data in enqueued into this buffer.
@@ -22,7 +28,10 @@ class DecimusAudioEngine {
     private var notificationObservers: [NSObjectProtocol] = []
     private var sink: AVAudioSinkNode?
     private var stopped: Bool = false
-    private let elements = Mutex<[SourceIDType: AVAudioSourceNode]>([:])
+    // Every player is mixed from this node's single render callback.
+    private let mixer: QAudioMixer
+    private let player: AVAudioSourceNode
+    private let elements = Mutex<[SourceIDType: Int]>([:])
     private let inputNodePresent: Bool
     private let outputNodePresent: Bool
     private let captureAudio = Atomic(false)
@@ -155,6 +164,22 @@ class DecimusAudioEngine {
         }
         self.engine = engine
 
+        // Mixer for remote audio.
+        let mixer = QAudioMixer(capacity: Self.maxPlayers, maxFrames: Self.maxRenderFrames)
+        self.mixer = mixer
+        self.player = AVAudioSourceNode(format: Self.format) { silence, timestamp, frames, data in
+            let buffers = UnsafeMutableAudioBufferListPointer(data)
+            guard buffers.count == 1,
+                  let output = buffers[0].mData else { return 1 }
+            let audible = mixer.render(output.assumingMemoryBound(to: Float32.self),
+                                       frames: frames,
+                                       hostTime: timestamp.pointee.mHostTime)
+            silence.pointee = .init(audible == 0)
+            return .zero
+        }
+        engine.attach(self.player)
+        engine.connect(self.player, to: engine.mainMixerNode, format: Self.format)
+
         // Ducking.
         if self.inputNodePresent {
             #if !os(tvOS)
@@ -251,33 +276,59 @@ class DecimusAudioEngine {
         stopped = true
     }
 
-    /// Add a source node to this engine, to be mixed with any others.
+    /// Add a source to this engine, to be mixed with any others.
     /// - Parameter identifier: Identifier for this source.
-    /// - Parameter node: The source node supplying audio.
-    /// - Throws: Error if the target node has already been added.
-    func addPlayer(identifier: SourceIDType, node: AVAudioSourceNode) throws {
-        engine.attach(node)
-        engine.connect(node, to: engine.mainMixerNode, format: Self.format)
-        assert(node.numberOfOutputs == 1)
-        assert(node.outputFormat(forBus: 0) == Self.format)
-        self.logger.info("(\(identifier)) Attached node")
+    /// - Parameter render: Called on the render thread to fill up to the given number of frames of ``format`` audio.
+    /// Returns the frames written, anything after being silence, or 0 if silent.
+    /// - Throws: Error if the source has already been added, or too many are playing.
+    func addPlayer(identifier: SourceIDType,
+                   render: @escaping (UnsafeMutablePointer<Float32>, UInt32, UInt64) -> UInt32) throws {
         try self.elements.withLock { elements in
             guard elements[identifier] == nil else { throw "Add called for existing entry" }
-            elements[identifier] = node
+            var source = 0
+            guard self.mixer.addSource(render, source: &source) else {
+                throw "Can't play more than \(Self.maxPlayers) sources"
+            }
+            elements[identifier] = source
         }
+        self.logger.info("(\(identifier)) Added player")
     }
 
-    /// Remove a previously added source node.
-    /// - Parameter identifier: Identifier of the source node to remove.
-    /// - Throws: Error if the source node has not beed added,
+    /// Remove a previously added source. Its render callback will not be called once this returns.
+    /// - Parameter identifier: Identifier of the source to remove.
+    /// - Throws: Error if the source has not beed added,
     func removePlayer(identifier: SourceIDType) throws {
         try self.elements.withLock { elements in
-            guard let element = elements.removeValue(forKey: identifier) else {
+            guard let source = elements.removeValue(forKey: identifier) else {
                 throw "Remove called for non existent entry"
             }
-            engine.detach(element)
+            self.mixer.removeSource(source)
         }
-        self.logger.info("(\(identifier)) Removed player node")
+        self.logger.info("(\(identifier)) Removed player")
+    }
+
+    /// Set a source's playout gain.
+    /// - Parameter gain: Linear gain, 1 being unchanged.
+    /// - Parameter identifier: Identifier of the source.
+    func setGain(_ gain: Float32, identifier: SourceIDType) {
+        guard let source = self.elements.withLock({ $0[identifier] }) else { return }
+        self.mixer.setGain(gain, forSource: source)
+    }
+
+    /// Silence a source. A muted source is still consumed, and its level still reported.
+    /// - Parameter muted: True to silence the source.
+    /// - Parameter identifier: Identifier of the source.
+    func setMuted(_ muted: Bool, identifier: SourceIDType) {
+        guard let source = self.elements.withLock({ $0[identifier] }) else { return }
+        self.mixer.setMuted(muted, forSource: source)
+    }
+
+    /// The level of a source's most recently rendered audio, before gain.
+    /// - Parameter identifier: Identifier of the source.
+    /// - Returns: The level, or nil if there is no such source.
+    func level(identifier: SourceIDType) -> QAudioLevel? {
+        guard let source = self.elements.withLock({ $0[identifier] }) else { return nil }
+        return self.mixer.level(forSource: source)
     }
 
     /// Is the microphone / input device currently muted?
@@ -354,15 +405,10 @@ class DecimusAudioEngine {
             assert(engine.outputNode.inputFormat(forBus: 0) == Self.format)
         }
 
-        // We shouldn't need to reconnect source nodes to the mixer,
+        // We shouldn't need to reconnect the player to the mixer,
         // as the format should not have changed.
-        self.elements.withLock { elements in
-            for element in elements {
-                assert(element.value.numberOfOutputs == 1)
-                let sourceOutputFormat = element.value.outputFormat(forBus: 0)
-                assert(sourceOutputFormat == Self.format)
-            }
-        }
+        assert(self.player.numberOfOutputs == 1)
+        assert(self.player.outputFormat(forBus: 0) == Self.format)
     }
 
     private func reconfigureAndRestart() throws {
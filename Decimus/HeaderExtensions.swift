@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Foundation
+
+/// Header extension keys to values, supporting multiple values per key.
+///
+/// Stored in the flat layout described in `FlatExtensions.hh`: one contiguous buffer holding a
+/// small (key, offset, length) index followed by the value bytes. The buffer crosses the bridge as
+/// a single object and values are read in place, so there are no per-key allocations.
+struct HeaderExtensions: Equatable, Sendable {
+    private static let headerSize = 8
+    private static let entrySize = 16
+
+    /// The encoded buffer.
+    private(set) var flat: Data
+
+    /// The encoded buffer to hand to the bridge, or nil if there are no extensions.
+    var bridged: Data? {
+        self.isEmpty ? nil : self.flat
+    }
+
+    /// The number of values across all keys.
+    var count: Int {
+        Int(self.flat.withUnsafeBytes { $0.loadUnaligned(as: UInt32.self).littleEndian })
+    }
+
+    var isEmpty: Bool {
+        self.count == 0
+    }
+
+    /// Create an empty set of extensions.
+    init() {
+        self.flat = Data(count: Self.headerSize)
+    }
+
+    /// Wrap an encoded buffer.
+    /// - Parameter flat: Encoded extensions, typically received from the bridge.
+    /// - Throws: If the buffer is not a valid encoding.
+    init(flat: Data) throws {
+        // Work with zero based indices regardless of where the data came from.
+        let flat = flat.startIndex == 0 ? flat : Data(flat)
+        guard Self.validate(flat) else {
+            throw "Malformed header extensions"
+        }
+        self.flat = flat
+    }
+
+    /// Wrap an optional encoded buffer from the bridge.
+    /// - Returns: Nil if no extensions were given or they could not be parsed.
+    init?(bridged: Data?) {
+        guard let bridged,
+              let extensions = try? Self(flat: bridged) else {
+            return nil
+        }
+        self = extensions
+    }
+
+    /// All values for a key, in insertion order.
+    subscript(key: NSNumber) -> [Data]? {
+        get {
+            let values = self.values(key.uint64Value)
+            return values.isEmpty ? nil : values
+        }
+        set {
+            var rebuilt = HeaderExtensions()
+            let removed = key.uint64Value
+            for index in 0..<self.count {
+                let entry = self.entry(at: index)
+                guard entry.key != removed else { continue }
+                self.flat.withUnsafeBytes {
+                    rebuilt.append(entry.key, bytes: .init(rebasing: $0[entry.range]))
+                }
+            }
+            for value in newValue ?? [] {
+                rebuilt.append(removed, value)
+            }
+            self = rebuilt
+        }
+    }
+
+    /// Access the bytes of a value in place.
+    /// - Parameter key: The extension key.
+    /// - Parameter nth: Which of the key's values to access.
+    /// - Parameter body: Receives the value bytes, which are only valid for the duration of the call.
+    /// - Returns: The body's result, or nil if there is no such value.
+    func withValue<Result>(_ key: UInt64,
+                           nth: Int = 0,
+                           _ body: (UnsafeRawBufferPointer) throws -> Result) rethrows -> Result? {
+        guard let range = self.range(key, nth: nth) else { return nil }
+        return try self.flat.withUnsafeBytes {
+            try body(.init(rebasing: $0[range]))
+        }
+    }
+
+    /// Copy out the first value for a key.
+    func first(_ key: UInt64) -> Data? {
+        guard let range = self.range(key, nth: 0) else { return nil }
+        return Data(self.flat[range])
+    }
+
+    /// Copy out all values for a key, in insertion order.
+    func values(_ key: UInt64) -> [Data] {
+        (0..<self.count).compactMap {
+            let entry = self.entry(at: $0)
+            return entry.key == key ? Data(self.flat[entry.range]) : nil
+        }
+    }
+
+    /// Append a value for a key.
+    mutating func append(_ key: UInt64, _ value: Data) {
+        value.withUnsafeBytes { self.append(key, bytes: $0) }
+    }
+
+    /// Append a value for a key.
+    mutating func append(_ key: UInt64, bytes: UnsafeRawBufferPointer) {
+        let count = self.count
+        let entryStart = Self.headerSize + count * Self.entrySize
+        let offset = self.flat.count - entryStart
+        self.flat.reserveCapacity(self.flat.count + Self.entrySize + bytes.count)
+        self.flat.insert(contentsOf: repeatElement(0, count: Self.entrySize), at: entryStart)
+        self.flat.withUnsafeMutableBytes {
+            $0.storeBytes(of: UInt32(count + 1).littleEndian, as: UInt32.self)
+            $0.storeBytes(of: key.littleEndian, toByteOffset: entryStart, as: UInt64.self)
+            $0.storeBytes(of: UInt32(offset).littleEndian, toByteOffset: entryStart + 8, as: UInt32.self)
+            $0.storeBytes(of: UInt32(bytes.count).littleEndian, toByteOffset: entryStart + 12, as: UInt32.self)
+        }
+        self.flat.append(contentsOf: bytes)
+    }
+
+    // MARK: Index.
+
+    private func entry(at index: Int) -> (key: UInt64, range: Range<Int>) {
+        self.flat.withUnsafeBytes {
+            let entry = Self.headerSize + index * Self.entrySize
+            let key = $0.loadUnaligned(fromByteOffset: entry, as: UInt64.self).littleEndian
+            let offset = Int($0.loadUnaligned(fromByteOffset: entry + 8, as: UInt32.self).littleEndian)
+            let length = Int($0.loadUnaligned(fromByteOffset: entry + 12, as: UInt32.self).littleEndian)
+            let start = Self.headerSize + self.count * Self.entrySize + offset
+            return (key, start..<start + length)
+        }
+    }
+
+    private func range(_ key: UInt64, nth: Int) -> Range<Int>? {
+        var remaining = nth
+        for index in 0..<self.count {
+            let entry = self.entry(at: index)
+            guard entry.key == key else { continue }
+            if remaining == 0 {
+                return entry.range
+            }
+            remaining -= 1
+        }
+        return nil
+    }
+
+    private static func validate(_ flat: Data) -> Bool {
+        flat.withUnsafeBytes { bytes in
+            guard bytes.count >= Self.headerSize else { return false }
+            let count = Int(bytes.loadUnaligned(as: UInt32.self).littleEndian)
+            guard count <= (bytes.count - Self.headerSize) / Self.entrySize else { return false }
+            let valueBytes = bytes.count - Self.headerSize - count * Self.entrySize
+            for index in 0..<count {
+                let entry = Self.headerSize + index * Self.entrySize
+                let offset = Int(bytes.loadUnaligned(fromByteOffset: entry + 8, as: UInt32.self).littleEndian)
+                let length = Int(bytes.loadUnaligned(fromByteOffset: entry + 12, as: UInt32.self).littleEndian)
+                guard offset <= valueBytes, length <= valueBytes - offset else { return false }
+            }
+            return true
+        }
+    }
+}
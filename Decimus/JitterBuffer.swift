@@ -6,9 +6,6 @@ import CoreMedia
 import Observation
 import Synchronization
 
-// CMBufferQueue is thread-safe.
-extension CMBufferQueue: @retroactive @unchecked Sendable {}
-
 // swiftlint:disable force_cast
 
 /// Possible errors thrown by ``JitterBuffer``
@@ -16,6 +13,8 @@ enum JitterBufferError: Error {
     /// The buffer was full and this sample couldn't be enqueued.
     case full
     case old
+    /// A sample with this sequence number is already enqueued.
+    case duplicate
 }
 
 /// A very simplified jitter buffer designed to contain compressed frames in order.
@@ -53,7 +52,7 @@ final class JitterBuffer: Sendable {
 
     private let baseTargetDepthUs: Atomic<UInt64>
     private let adjustmentTargetDepthUs: Atomic<UInt64>
-    private let buffer: CMBufferQueue
+    private let buffer: Mutex<QSequenceRing>
     private let measurement: JitterBufferMeasurement?
     private let playingFromStart: Bool
     private let play: Atomic<Bool>
@@ -71,6 +70,8 @@ final class JitterBuffer: Sendable {
     protocol JitterItem: AnyObject {
         var sequenceNumber: UInt64 { get }
         var timestamp: CMTime { get }
+        /// Contribution to the buffer's depth.
+        var duration: CMTime { get }
     }
 
     /// Create a new video jitter buffer.
@@ -82,14 +83,15 @@ final class JitterBuffer: Sendable {
     /// - Parameter metricsSubmitter: Optionally, an object to submit metrics through.
     /// - Parameter minDepth: Starting target base depth in seconds.
     /// - Parameter capacity: Capacity in number of buffers / elements.
-    /// - Parameter handlers: CMBufferQueue.Handlers implementation to use.
+    /// Items are ordered by sequence number, and held items must span fewer than `capacity`
+    /// (rounded up to a power of 2) sequence numbers.
     init(identifier: String,
          metricsSubmitter: MetricsSubmitter?,
          minDepth: TimeInterval,
          capacity: Int,
-         handlers: CMBufferQueue.Handlers,
          playingFromStart: Bool = true) throws {
-        self.buffer = try .init(capacity: capacity, handlers: handlers)
+        guard capacity > 0 else { throw "Jitter buffer capacity must be positive" }
+        self.buffer = .init(.init(capacity: capacity))
         if let metricsSubmitter = metricsSubmitter {
             let measurement = JitterBufferMeasurement(namespace: identifier)
             metricsSubmitter.register(measurement: measurement)
@@ -158,7 +160,7 @@ final class JitterBuffer: Sendable {
     /// Write a video frame into the jitter buffer.
     /// Write should not be called concurrently with another write.
     /// - Parameter videoFrame: The sample to attempt to sort into the buffer.
-    /// - Throws: Buffer is full, or video frame is older than last read.
+    /// - Throws: Buffer is full, video frame is older than last read, or is already enqueued.
     func write<T: JitterItem>(item: T, from: Date) throws {
         // Check expiry.
         if self.lastSequenceSet.load(ordering: .acquiring) {
@@ -167,10 +169,16 @@ final class JitterBuffer: Sendable {
             }
         }
 
-        do {
-            try self.buffer.enqueue(item)
-        } catch let error as NSError {
-            guard error.code == -12764 else { throw error }
+        let durationUs = item.duration.isValid ? Int64(item.duration.seconds * microsecondsPerSecond) : 0
+        let result = self.buffer.withLock {
+            $0.insert(item, sequence: item.sequenceNumber, durationUs: durationUs)
+        }
+        switch result {
+        case .inserted:
+            break
+        case .duplicate:
+            throw JitterBufferError.duplicate
+        default:
             throw JitterBufferError.full
         }
 
@@ -189,10 +197,14 @@ final class JitterBuffer: Sendable {
             guard self.play.load(ordering: .acquiring) else { return nil }
         }
 
-        let depth: TimeInterval? = self.measurement != nil ? self.buffer.duration.seconds : nil
+        let (oldest, depthUs) = self.buffer.withLock { buffer in
+            let depthUs = buffer.durationUs()
+            return (buffer.popHead(), depthUs)
+        }
+        let depth: TimeInterval? = self.measurement != nil ? TimeInterval(depthUs) / microsecondsPerSecond : nil
 
         // Ensure there's something to get.
-        guard let oldest = self.buffer.dequeue() else {
+        guard let oldest else {
             self.doReadMetrics(depth, underrun: true, when: from)
             return nil
         }
@@ -206,24 +218,24 @@ final class JitterBuffer: Sendable {
     }
 
     /// Empty the buffer.
-    func clear() throws {
-        try self.buffer.reset()
+    func clear() {
+        self.buffer.withLock { $0.clear() }
     }
 
     func updateLastSequenceRead(_ seq: UInt64) {
         self.lastSequenceRead.store(seq, ordering: .releasing)
     }
 
-    /// Get the CMBuffer at the front of the buffer without removing it.
+    /// Get the item at the front of the buffer without removing it.
     /// - Returns: The head of the buffer, if any.
     func peek<T: JitterItem>() -> T? {
-        self.buffer.head as! T?
+        self.buffer.withLock { $0.head() } as! T?
     }
 
     /// Get the current depth of the queue (sum of all contained durations).
     /// - Returns: Duration in seconds.
     func getDepth() -> TimeInterval {
-        self.buffer.duration.seconds
+        TimeInterval(self.buffer.withLock { $0.durationUs() }) / microsecondsPerSecond
     }
 
     /// Get the point in time this item should ideally be played out.
@@ -257,7 +269,7 @@ final class JitterBuffer: Sendable {
     /// - Parameter offset: Offset from the start point at which media starts.
     /// - Returns: The time to wait, or nil if no estimation can be made. (There is no next frame).
     func calculateWaitTime(from: Ticks, offset: HostTimeOffset) -> TimeInterval? {
-        guard let peek = self.buffer.head else { return nil }
+        guard let peek = self.buffer.withLock({ $0.head() }) else { return nil }
         let item = peek as! JitterItem
         return self.calculateWaitTime(item: item, from: from, offset: offset)
     }
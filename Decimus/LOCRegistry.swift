@@ -4,9 +4,6 @@
 import CoreMedia
 import Foundation
 
-// Dictionary of header extension keys to values (supports multiple values per key)
-typealias HeaderExtensions = [NSNumber: [Data]]
-
 extension HeaderExtensions {
     mutating func setHeader(_ mediaExtension: MediaTypeHeaderExtension) throws {
         let data: Data
@@ -33,13 +30,7 @@ extension HeaderExtensions {
             let microseconds = UInt64(date.timeIntervalSince1970 * microsecondsPerSecond)
             data = withUnsafeBytes(of: microseconds) { Data($0) }
         }
-        let key = mediaExtension.extensionKey.rawValue
-        if var existing = self[key] {
-            existing.append(data)
-            self[key] = existing
-        } else {
-            self[key] = [data]
-        }
+        self.append(mediaExtension.extensionKey.rawValue.uint64Value, data)
     }
 
     mutating func setHeader(_ extensionsKey: UInt64, data: HeaderType) throws {
@@ -56,17 +47,36 @@ extension HeaderExtensions {
             }
             toSet = withUnsafeBytes(of: &value) { Data($0) }
         }
-        let key = NSNumber(value: extensionsKey)
-        if var existing = self[key] {
-            existing.append(toSet)
-            self[key] = existing
-        } else {
-            self[key] = [toSet]
-        }
+        self.append(extensionsKey, toSet)
     }
 
     func getHeader(_ extensionKey: MediaTypeHeaderExtensionValue) throws -> MediaTypeHeaderExtension? {
-        guard let dataArray = self[extensionKey.rawValue], let data = dataArray.first else {
+        let key = extensionKey.rawValue.uint64Value
+
+        // Fixed size values are parsed in place.
+        switch extensionKey {
+        case .audioLevel:
+            return try self.withValue(key) { bytes in
+                guard bytes.count == 1,
+                      let audioLevel = bytes.first,
+                      audioLevel < 128 else {
+                    throw "Bad audio level"
+                }
+                return .audioLevel(audioLevel)
+            }
+        case .captureTimestamp:
+            return try self.withValue(key) { bytes in
+                guard let timestampUs = bytes.parseInteger() as? UInt64 else {
+                    throw "Bad timestamp"
+                }
+                let interval = TimeInterval(timestampUs) / microsecondsPerSecond
+                return .captureTimestamp(.init(timeIntervalSince1970: interval))
+            }
+        default:
+            break
+        }
+
+        guard let data = self.first(key) else {
             return nil
         }
 
@@ -104,20 +114,9 @@ extension HeaderExtensions {
         case .videoFrameMarking:
             return .videoFrameMarking(data)
 
-        case .audioLevel:
-            guard data.count == 1,
-                  let audioLevel = data.first,
-                  audioLevel < 128 else {
-                throw "Bad audio level"
-            }
-            return .audioLevel(UInt8(audioLevel))
-
-        case .captureTimestamp:
-            guard let timestampUs = data.parseInteger() as? UInt64 else {
-                throw "Bad timestamp"
-            }
-            let interval = TimeInterval(timestampUs) / microsecondsPerSecond
-            return .captureTimestamp(.init(timeIntervalSince1970: interval))
+        case .audioLevel, .captureTimestamp:
+            // Handled in place above.
+            return nil
         }
     }
 
@@ -127,42 +126,38 @@ extension HeaderExtensions {
     }
 
     func getHeader(_ extensionKey: UInt64) throws -> HeaderType? {
-        guard let dataArray = self[.init(value: extensionKey)], let data = dataArray.first else {
-            return nil
-        }
-
         guard extensionKey % 2 == 0 else {
             // Odd key is byte array.
-            return .bytes(data)
+            return self.first(extensionKey).map { .bytes($0) }
         }
 
         // Even key is expanded varint value.
-        guard let parsed = data.parseInteger() else {
-            throw "Failed to parse value in even extension: \(extensionKey)"
+        return try self.withValue(extensionKey) { bytes in
+            guard let parsed = bytes.parseInteger() else {
+                throw "Failed to parse value in even extension: \(extensionKey)"
+            }
+            return .value(parsed)
         }
-        return .value(parsed)
     }
 }
 
 extension Data {
+    func parseInteger() -> (any BinaryInteger)? {
+        self.withUnsafeBytes { $0.parseInteger() }
+    }
+}
+
+extension UnsafeRawBufferPointer {
     func parseInteger() -> (any BinaryInteger)? {
         switch self.count {
         case MemoryLayout<UInt64>.size:
-            self.withUnsafeBytes {
-                $0.loadUnaligned(as: UInt64.self)
-            }
+            self.loadUnaligned(as: UInt64.self)
         case MemoryLayout<UInt32>.size:
-            self.withUnsafeBytes {
-                $0.loadUnaligned(as: UInt32.self)
-            }
+            self.loadUnaligned(as: UInt32.self)
         case MemoryLayout<UInt16>.size:
-            self.withUnsafeBytes {
-                $0.loadUnaligned(as: UInt16.self)
-            }
+            self.loadUnaligned(as: UInt16.self)
         case MemoryLayout<UInt8>.size:
-            self.withUnsafeBytes {
-                $0.loadUnaligned(as: UInt8.self)
-            }
+            self.loadUnaligned(as: UInt8.self)
         default:
             nil
         }
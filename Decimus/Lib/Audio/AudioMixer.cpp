@@ -0,0 +1,251 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "AudioMixer.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MIXER_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define MIXER_SSE2 1
+#endif
+
+namespace {
+// The mixer rendering on this thread, if any.
+thread_local const AudioMixer* rendering = nullptr;
+
+// output[i] += (from + (to - from) * i / frames) * input[i]. A constant gain when from == to.
+void Accumulate(float* output, const float* input, std::uint32_t frames, float from, float to)
+{
+    const float step = (to - from) / static_cast<float>(frames);
+    std::uint32_t index = 0;
+#if defined(MIXER_NEON)
+    const float offsets[4] = { 0, step, 2 * step, 3 * step };
+    auto gain = vaddq_f32(vdupq_n_f32(from), vld1q_f32(offsets));
+    const auto advance = vdupq_n_f32(4 * step);
+    for (; index + 4 <= frames; index += 4) {
+        vst1q_f32(output + index, vfmaq_f32(vld1q_f32(output + index), vld1q_f32(input + index), gain));
+        gain = vaddq_f32(gain, advance);
+    }
+#elif defined(MIXER_SSE2)
+    auto gain = _mm_add_ps(_mm_set1_ps(from), _mm_setr_ps(0, step, 2 * step, 3 * step));
+    const auto advance = _mm_set1_ps(4 * step);
+    for (; index + 4 <= frames; index += 4) {
+        const auto mixed = _mm_add_ps(_mm_loadu_ps(output + index), _mm_mul_ps(_mm_loadu_ps(input + index), gain));
+        _mm_storeu_ps(output + index, mixed);
+        gain = _mm_add_ps(gain, advance);
+    }
+#endif
+    for (; index < frames; ++index) {
+        output[index] += (from + step * static_cast<float>(index)) * input[index];
+    }
+}
+
+// Sum of squares and largest magnitude.
+void Analyze(const float* input, std::uint32_t frames, float& sumSquares, float& peak)
+{
+    std::uint32_t index = 0;
+    float sum = 0;
+    float largest = 0;
+#if defined(MIXER_NEON)
+    auto sums = vdupq_n_f32(0);
+    auto peaks = vdupq_n_f32(0);
+    for (; index + 4 <= frames; index += 4) {
+        const auto value = vld1q_f32(input + index);
+        sums = vfmaq_f32(sums, value, value);
+        peaks = vmaxq_f32(peaks, vabsq_f32(value));
+    }
+    sum = vaddvq_f32(sums);
+    largest = vmaxvq_f32(peaks);
+#elif defined(MIXER_SSE2)
+    const auto magnitude = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    auto sums = _mm_setzero_ps();
+    auto peaks = _mm_setzero_ps();
+    for (; index + 4 <= frames; index += 4) {
+        const auto value = _mm_loadu_ps(input + index);
+        sums = _mm_add_ps(sums, _mm_mul_ps(value, value));
+        peaks = _mm_max_ps(peaks, _mm_and_ps(value, magnitude));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, sums);
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    _mm_storeu_ps(lanes, peaks);
+    largest = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+#endif
+    for (; index < frames; ++index) {
+        sum += input[index] * input[index];
+        largest = std::max(largest, std::fabs(input[index]));
+    }
+    sumSquares = sum;
+    peak = largest;
+}
+
+// Clamp to [-1, 1].
+// - Returns: Samples that were out of range.
+std::uint32_t Clip(float* output, std::uint32_t frames)
+{
+    std::uint32_t index = 0;
+    std::uint32_t clipped = 0;
+#if defined(MIXER_NEON)
+    const auto one = vdupq_n_f32(1);
+    const auto minusOne = vdupq_n_f32(-1);
+    auto counts = vdupq_n_u32(0);
+    for (; index + 4 <= frames; index += 4) {
+        const auto value = vld1q_f32(output + index);
+        // Lanes are all ones (-1) where out of range.
+        counts = vsubq_u32(counts, vcagtq_f32(value, one));
+        vst1q_f32(output + index, vmaxq_f32(vminq_f32(value, one), minusOne));
+    }
+    clipped = vaddvq_u32(counts);
+#elif defined(MIXER_SSE2)
+    const auto one = _mm_set1_ps(1);
+    const auto minusOne = _mm_set1_ps(-1);
+    for (; index + 4 <= frames; index += 4) {
+        const auto value = _mm_loadu_ps(output + index);
+        const auto out = _mm_or_ps(_mm_cmpgt_ps(value, one), _mm_cmplt_ps(value, minusOne));
+        clipped += static_cast<std::uint32_t>(__builtin_popcount(static_cast<unsigned>(_mm_movemask_ps(out))));
+        _mm_storeu_ps(output + index, _mm_max_ps(_mm_min_ps(value, one), minusOne));
+    }
+#endif
+    for (; index < frames; ++index) {
+        const auto value = output[index];
+        if (value > 1 || value < -1) {
+            ++clipped;
+            output[index] = value > 1 ? 1 : -1;
+        }
+    }
+    return clipped;
+}
+}
+
+AudioMixer::AudioMixer(std::size_t capacity, std::uint32_t maxFrames)
+    : _capacity(capacity),
+      _maxFrames(maxFrames),
+      _sources(new Source[capacity]),
+      _scratch(new float[maxFrames])
+{
+}
+
+std::optional<std::size_t> AudioMixer::AddSource(PullCallback pull, void* userData)
+{
+    std::lock_guard lock(_control);
+    for (std::size_t index = 0; index < _capacity; ++index) {
+        auto& source = _sources[index];
+        if (source.pull.load(std::memory_order_relaxed) != nullptr) {
+            continue;
+        }
+        // Nothing reads an empty slot, so it can be set up before publishing the callback.
+        source.userData.store(userData, std::memory_order_relaxed);
+        source.gain.store(1, std::memory_order_relaxed);
+        source.muted.store(false, std::memory_order_relaxed);
+        source.rms.store(0, std::memory_order_relaxed);
+        source.peak.store(0, std::memory_order_relaxed);
+        source.applied = 1;
+        source.pull.store(pull, std::memory_order_release);
+        if (index >= _end.load(std::memory_order_relaxed)) {
+            _end.store(index + 1, std::memory_order_release);
+        }
+        return index;
+    }
+    return std::nullopt;
+}
+
+void AudioMixer::RemoveSource(std::size_t source)
+{
+    std::lock_guard lock(_control);
+    if (source >= _capacity) {
+        return;
+    }
+    // Sequentially consistent with the render thread's busy flag: either it sees the callback gone,
+    // or this sees it busy and waits for it to finish. Removed from within a render, the callback is the
+    // caller, and waiting for it would never end.
+    _sources[source].pull.store(nullptr, std::memory_order_seq_cst);
+    while (rendering != this && _sources[source].busy.load(std::memory_order_seq_cst)) {
+        std::this_thread::yield();
+    }
+    auto end = _end.load(std::memory_order_relaxed);
+    while (end > 0 && _sources[end - 1].pull.load(std::memory_order_relaxed) == nullptr) {
+        --end;
+    }
+    _end.store(end, std::memory_order_release);
+}
+
+void AudioMixer::SetGain(std::size_t source, float gain)
+{
+    if (source < _capacity) {
+        _sources[source].gain.store(gain, std::memory_order_relaxed);
+    }
+}
+
+void AudioMixer::SetMuted(std::size_t source, bool muted)
+{
+    if (source < _capacity) {
+        _sources[source].muted.store(muted, std::memory_order_relaxed);
+    }
+}
+
+AudioMixer::Level AudioMixer::GetLevel(std::size_t source) const
+{
+    if (source >= _capacity) {
+        return { 0, 0 };
+    }
+    return { _sources[source].rms.load(std::memory_order_relaxed),
+             _sources[source].peak.load(std::memory_order_relaxed) };
+}
+
+std::size_t AudioMixer::Render(float* output, std::uint32_t frames, std::uint64_t hostTime)
+{
+    rendering = this;
+    std::size_t audible = 0;
+    for (std::uint32_t offset = 0; offset < frames; offset += _maxFrames) {
+        audible = std::max(audible, RenderChunk(output + offset, std::min(_maxFrames, frames - offset), hostTime));
+    }
+    rendering = nullptr;
+    return audible;
+}
+
+std::size_t AudioMixer::RenderChunk(float* output, std::uint32_t frames, std::uint64_t hostTime)
+{
+    std::memset(output, 0, frames * sizeof(float));
+    std::size_t audible = 0;
+    const auto end = _end.load(std::memory_order_acquire);
+    for (std::size_t index = 0; index < end; ++index) {
+        auto& source = _sources[index];
+        source.busy.store(true, std::memory_order_seq_cst);
+        const auto pull = source.pull.load(std::memory_order_seq_cst);
+        if (pull == nullptr) {
+            source.busy.store(false, std::memory_order_release);
+            continue;
+        }
+
+        const auto userData = source.userData.load(std::memory_order_relaxed);
+        const auto written = std::min(pull(_scratch.get(), frames, hostTime, userData), frames);
+        float sumSquares = 0;
+        float peak = 0;
+        Analyze(_scratch.get(), written, sumSquares, peak);
+        source.rms.store(std::sqrt(sumSquares / static_cast<float>(frames)), std::memory_order_relaxed);
+        source.peak.store(peak, std::memory_order_relaxed);
+
+        const auto target = source.muted.load(std::memory_order_relaxed) ? 0.0f
+                                                                         : source.gain.load(std::memory_order_relaxed);
+        // Nothing heard, so nothing to ramp from.
+        auto applied = target;
+        if (written > 0 && (source.applied != 0 || target != 0)) {
+            // Ramp at a whole render's rate, so a partial one carries on from where it got to next time.
+            const auto reached = source.applied + (target - source.applied) * written / static_cast<float>(frames);
+            Accumulate(output, _scratch.get(), written, source.applied, reached);
+            applied = reached;
+            ++audible;
+        }
+        source.applied = applied;
+        source.busy.store(false, std::memory_order_release);
+    }
+    _clipped.fetch_add(Clip(output, frames), std::memory_order_relaxed);
+    return audible;
+}
@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef AudioMixer_hh
+#define AudioMixer_hh
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+/// Mixes any number of mono float sources into one output from a single render callback.
+///
+/// Each render pulls every source into a scratch buffer, measures its level, and sums it into the output
+/// with the source's gain, ramping between gains over a render to avoid clicks. The sum is then clipped
+/// to [-1, 1]. Gain and level loops are vectorized.
+///
+/// `Render` must be called from a single (render) thread, and never blocks or allocates. Sources may be
+/// added, removed and adjusted from any other thread. Removing a source waits for any in progress pull of
+/// it to finish, so its callback is never called once removal returns. A source removed from within a pull
+/// doesn't wait, and its callback is not called again after that pull returns.
+class AudioMixer
+{
+public:
+    /// Fill `destination` with up to `frames` samples.
+    /// - Returns: Samples written. Anything after is silence. 0 if the source is silent.
+    using PullCallback = std::uint32_t (*)(float* destination,
+                                           std::uint32_t frames,
+                                           std::uint64_t hostTime,
+                                           void* userData);
+
+    struct Level
+    {
+        /// Root mean square of the last render, before gain.
+        float rms;
+        /// Largest magnitude of the last render, before gain.
+        float peak;
+    };
+
+    /// - Parameter capacity: Most sources that can be mixed at once.
+    /// - Parameter maxFrames: Frames pulled from a source at a time. Larger renders are done in pieces.
+    AudioMixer(std::size_t capacity, std::uint32_t maxFrames);
+
+    AudioMixer(const AudioMixer&) = delete;
+    AudioMixer& operator=(const AudioMixer&) = delete;
+
+    /// Start mixing a source, at unity gain and unmuted.
+    /// - Returns: The source's index, or nothing if the mixer is full.
+    std::optional<std::size_t> AddSource(PullCallback pull, void* userData);
+
+    /// Stop mixing a source. Once this returns, or the pull it was called from does, the source's callback will
+    /// not be called again.
+    void RemoveSource(std::size_t source);
+
+    void SetGain(std::size_t source, float gain);
+    void SetMuted(std::size_t source, bool muted);
+    Level GetLevel(std::size_t source) const;
+
+    /// Output samples clipped so far.
+    std::uint64_t ClippedSamples() const { return _clipped.load(std::memory_order_relaxed); }
+
+    /// Mix every source into `output`, which is completely written.
+    /// - Returns: The number of sources that were audible in this render.
+    std::size_t Render(float* output, std::uint32_t frames, std::uint64_t hostTime);
+
+private:
+    struct Source
+    {
+        std::atomic<PullCallback> pull{ nullptr };
+        std::atomic<void*> userData{ nullptr };
+        // Set by the render thread while it is pulling from this source.
+        std::atomic<bool> busy{ false };
+        std::atomic<float> gain{ 1 };
+        std::atomic<bool> muted{ false };
+        std::atomic<float> rms{ 0 };
+        std::atomic<float> peak{ 0 };
+        // Gain last applied. Render thread only.
+        float applied = 1;
+    };
+
+    std::size_t RenderChunk(float* output, std::uint32_t frames, std::uint64_t hostTime);
+
+    const std::size_t _capacity;
+    const std::uint32_t _maxFrames;
+    std::unique_ptr<Source[]> _sources;
+    std::unique_ptr<float[]> _scratch;
+    // One past the highest slot in use, bounding the render loop.
+    std::atomic<std::size_t> _end{ 0 };
+    std::atomic<std::uint64_t> _clipped{ 0 };
+    // Serializes adding and removing sources.
+    std::mutex _control;
+};
+
+#endif /* AudioMixer_hh */
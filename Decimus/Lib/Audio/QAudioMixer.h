@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef QAudioMixer_h
+#define QAudioMixer_h
+
+#import <Foundation/Foundation.h>
+
+#ifdef __cplusplus
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "AudioMixer.hh"
+#endif
+
+/// Fill `destination` with up to `frames` samples from the render thread.
+/// - Returns: Samples written. Anything after is silence. 0 if the source is silent.
+typedef uint32_t (^QAudioMixerRender)(float* _Nonnull destination, uint32_t frames, uint64_t hostTime);
+
+/// Level of a source's last render, before gain. Layout matches `AudioMixer::Level`.
+typedef struct QAudioLevel {
+    float rms;
+    float peak;
+} QAudioLevel;
+
+/// Mixes mono float sources from a single render callback using `AudioMixer`.
+/// `render:frames:hostTime:` must only be called from one (render) thread. Everything else is thread safe.
+NS_SWIFT_SENDABLE
+@interface QAudioMixer : NSObject {
+#ifdef __cplusplus
+    std::unique_ptr<AudioMixer> mixer;
+    std::vector<QAudioMixerRender> renders;
+    std::mutex control;
+#endif
+}
+
+/// - Parameter capacity: Most sources that can be mixed at once.
+/// - Parameter maxFrames: Frames pulled from a source at a time.
+-(instancetype _Nonnull) initWithCapacity: (size_t) capacity maxFrames: (uint32_t) maxFrames;
+
+/// Start mixing a source at unity gain. The block is held until the source is removed.
+/// - Parameter source: Set to the source's index on success.
+/// - Returns: False if the mixer is full.
+-(BOOL) addSource: (QAudioMixerRender _Nonnull) render source: (size_t* _Nonnull) source;
+
+/// Stop mixing a source. Once this returns, its block will not be called again.
+-(void) removeSource: (size_t) source;
+-(void) setGain: (float) gain forSource: (size_t) source;
+-(void) setMuted: (BOOL) muted forSource: (size_t) source;
+-(QAudioLevel) levelForSource: (size_t) source;
+-(uint64_t) clippedSamples;
+
+/// Mix every source into `output`, which is completely written.
+/// - Returns: The number of sources audible in this render.
+-(size_t) render: (float* _Nonnull) output frames: (uint32_t) frames hostTime: (uint64_t) hostTime;
+
+@end
+
+#endif /* QAudioMixer_h */
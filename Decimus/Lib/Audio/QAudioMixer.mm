@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#import <Foundation/Foundation.h>
+#import "QAudioMixer.h"
+
+static std::uint32_t pullRender(float* destination, std::uint32_t frames, std::uint64_t hostTime, void* userData) {
+    // Retained by the mixer's `renders` for as long as the source exists, and here for the call, in case it
+    // removes its own source.
+    __attribute__((objc_precise_lifetime)) QAudioMixerRender render = (__bridge QAudioMixerRender)userData;
+    return render(destination, frames, hostTime);
+}
+
+@implementation QAudioMixer
+
+-(instancetype) initWithCapacity: (size_t) capacity maxFrames: (uint32_t) maxFrames {
+    self = [super init];
+    if (self) {
+        mixer = std::make_unique<AudioMixer>(capacity, maxFrames);
+        renders.resize(capacity);
+    }
+    return self;
+}
+
+-(BOOL) addSource: (QAudioMixerRender) render source: (size_t*) source {
+    std::lock_guard lock(control);
+    QAudioMixerRender copied = [render copy];
+    const auto added = mixer->AddSource(pullRender, (__bridge void*)copied);
+    if (!added.has_value()) {
+        return NO;
+    }
+    renders[*added] = copied;
+    *source = *added;
+    return YES;
+}
+
+-(void) removeSource: (size_t) source {
+    std::lock_guard lock(control);
+    mixer->RemoveSource(source);
+    if (source < renders.size()) {
+        renders[source] = nil;
+    }
+}
+
+-(void) setGain: (float) gain forSource: (size_t) source {
+    mixer->SetGain(source, gain);
+}
+
+-(void) setMuted: (BOOL) muted forSource: (size_t) source {
+    mixer->SetMuted(source, muted);
+}
+
+-(QAudioLevel) levelForSource: (size_t) source {
+    const auto level = mixer->GetLevel(source);
+    return { .rms = level.rms, .peak = level.peak };
+}
+
+-(uint64_t) clippedSamples {
+    return mixer->ClippedSamples();
+}
+
+-(size_t) render: (float*) output frames: (uint32_t) frames hostTime: (uint64_t) hostTime {
+    return mixer->Render(output, frames, hostTime);
+}
+
+@end
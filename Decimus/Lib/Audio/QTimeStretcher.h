@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef QTimeStretcher_h
+#define QTimeStretcher_h
+
+#import <Foundation/Foundation.h>
+
+#ifdef __cplusplus
+#include <memory>
+#include "TimeStretcher.hh"
+#endif
+
+/// Plays mono float audio faster or slower without changing pitch, using `TimeStretcher`.
+/// Not thread safe, except `removed` and `inserted`. Nothing blocks or allocates after creation.
+@interface QTimeStretcher : NSObject {
+#ifdef __cplusplus
+    std::unique_ptr<TimeStretcher> stretcher;
+#endif
+}
+
+@property (class, readonly) double minRate;
+@property (class, readonly) double maxRate;
+
+/// - Parameter sampleRate: Sample rate of the audio.
+/// - Parameter maxFrames: Most frames that will be read at a time.
+-(instancetype _Nonnull) initWithSampleRate: (uint32_t) sampleRate maxFrames: (uint32_t) maxFrames;
+
+/// Input frames that must be written before reading `frames` at `rate` can produce them all.
+-(uint32_t) inputNeeded: (uint32_t) frames rate: (double) rate;
+
+/// Space to write input to directly, to be followed by `commit:`.
+/// - Parameter frames: Frames wanted, reduced to what fits.
+-(float* _Nonnull) reserve: (uint32_t* _Nonnull) frames;
+-(void) commit: (uint32_t) frames;
+
+/// - Returns: Frames taken, less than given only if there is not enough space.
+-(uint32_t) write: (const float* _Nonnull) input frames: (uint32_t) frames;
+
+/// - Returns: Frames produced, less than asked only when input runs out.
+-(uint32_t) read: (float* _Nonnull) output frames: (uint32_t) frames rate: (double) rate;
+
+/// Frames written but not yet played.
+-(uint32_t) buffered;
+/// Input needed beyond what is being output, when not at a rate of 1.
+-(uint32_t) lookahead;
+-(void) reset;
+
+/// Input frames skipped by playing faster, in total.
+-(uint64_t) removed;
+/// Output frames added by playing slower, in total.
+-(uint64_t) inserted;
+
+@end
+
+#endif /* QTimeStretcher_h */
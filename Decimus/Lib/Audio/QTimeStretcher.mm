@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#import <Foundation/Foundation.h>
+#import "QTimeStretcher.h"
+
+@implementation QTimeStretcher
+
++(double) minRate {
+    return TimeStretcher::kMinRate;
+}
+
++(double) maxRate {
+    return TimeStretcher::kMaxRate;
+}
+
+-(instancetype) initWithSampleRate: (uint32_t) sampleRate maxFrames: (uint32_t) maxFrames {
+    self = [super init];
+    if (self) {
+        stretcher = std::make_unique<TimeStretcher>(sampleRate, maxFrames);
+    }
+    return self;
+}
+
+-(uint32_t) inputNeeded: (uint32_t) frames rate: (double) rate {
+    return stretcher->InputNeeded(frames, rate);
+}
+
+-(float*) reserve: (uint32_t*) frames {
+    return stretcher->Reserve(*frames);
+}
+
+-(void) commit: (uint32_t) frames {
+    stretcher->Commit(frames);
+}
+
+-(uint32_t) write: (const float*) input frames: (uint32_t) frames {
+    return stretcher->Write(input, frames);
+}
+
+-(uint32_t) read: (float*) output frames: (uint32_t) frames rate: (double) rate {
+    return stretcher->Read(output, frames, rate);
+}
+
+-(uint32_t) buffered {
+    return stretcher->Buffered();
+}
+
+-(uint32_t) lookahead {
+    return stretcher->SegmentFrames() + stretcher->ToleranceFrames();
+}
+
+-(void) reset {
+    stretcher->Reset();
+}
+
+-(uint64_t) removed {
+    return stretcher->Removed();
+}
+
+-(uint64_t) inserted {
+    return stretcher->Inserted();
+}
+
+@end
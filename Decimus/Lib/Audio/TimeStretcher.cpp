@@ -0,0 +1,283 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "TimeStretcher.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define STRETCHER_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define STRETCHER_SSE2 1
+#endif
+
+namespace {
+// Segments are 10ms, searched 6ms either side, which spans a pitch period down to ~80Hz.
+constexpr double kSegmentSeconds = 0.010;
+constexpr double kToleranceSeconds = 0.006;
+// Coarse search works on every 4th (averaged) sample, then refines this far either side at full rate.
+constexpr std::uint32_t kDecimation = 4;
+constexpr std::int64_t kRefine = kDecimation - 1;
+
+// Dot product of `candidate` with `reference`, and the energy of `candidate`.
+void Correlate(const float* candidate, const float* reference, std::uint32_t frames, float& dot, float& energy)
+{
+    std::uint32_t index = 0;
+    float dots = 0;
+    float energies = 0;
+#if defined(STRETCHER_NEON)
+    auto dotLanes = vdupq_n_f32(0);
+    auto energyLanes = vdupq_n_f32(0);
+    for (; index + 4 <= frames; index += 4) {
+        const auto value = vld1q_f32(candidate + index);
+        dotLanes = vfmaq_f32(dotLanes, value, vld1q_f32(reference + index));
+        energyLanes = vfmaq_f32(energyLanes, value, value);
+    }
+    dots = vaddvq_f32(dotLanes);
+    energies = vaddvq_f32(energyLanes);
+#elif defined(STRETCHER_SSE2)
+    auto dotLanes = _mm_setzero_ps();
+    auto energyLanes = _mm_setzero_ps();
+    for (; index + 4 <= frames; index += 4) {
+        const auto value = _mm_loadu_ps(candidate + index);
+        dotLanes = _mm_add_ps(dotLanes, _mm_mul_ps(value, _mm_loadu_ps(reference + index)));
+        energyLanes = _mm_add_ps(energyLanes, _mm_mul_ps(value, value));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, dotLanes);
+    dots = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    _mm_storeu_ps(lanes, energyLanes);
+    energies = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+    for (; index < frames; ++index) {
+        dots += candidate[index] * reference[index];
+        energies += candidate[index] * candidate[index];
+    }
+    dot = dots;
+    energy = energies;
+}
+
+// Normalized cross-correlation, up to the reference's (constant) energy.
+float Similarity(const float* candidate, const float* reference, std::uint32_t frames)
+{
+    float dot = 0;
+    float energy = 0;
+    Correlate(candidate, reference, frames, dot, energy);
+    return dot / std::sqrt(energy + 1e-9f);
+}
+
+void Decimate(const float* input, std::uint32_t frames, float* output)
+{
+    for (std::uint32_t index = 0; index < frames; ++index) {
+        const auto* group = input + index * kDecimation;
+        output[index] = (group[0] + group[1]) + (group[2] + group[3]);
+    }
+}
+
+std::uint32_t Frames(std::uint32_t sampleRate, double seconds)
+{
+    return static_cast<std::uint32_t>(std::lround(sampleRate * seconds));
+}
+}
+
+TimeStretcher::TimeStretcher(std::uint32_t sampleRate, std::uint32_t maxFrames)
+    : _segment(std::max<std::uint32_t>(Frames(sampleRate, kSegmentSeconds), kDecimation)),
+      _tolerance(std::max<std::uint32_t>(Frames(sampleRate, kToleranceSeconds), kDecimation)),
+      _history(2 * _tolerance + _segment),
+      _capacity(_history + static_cast<std::uint32_t>(std::ceil(maxFrames * kMaxRate)) + 3 * _segment +
+                3 * _tolerance),
+      _input(new float[_capacity]),
+      _fade(new float[_segment]),
+      _pending(new float[_segment]),
+      _coarseCandidates(new float[(2 * _tolerance + _segment) / kDecimation + 1]),
+      _coarseReference(new float[_segment / kDecimation])
+{
+    // Raised cosine, so that with its complement the crossfade keeps constant amplitude for correlated signals.
+    for (std::uint32_t index = 0; index < _segment; ++index) {
+        _fade[index] = 0.5f - 0.5f * static_cast<float>(std::cos(M_PI * (index + 0.5) / _segment));
+    }
+}
+
+std::uint32_t TimeStretcher::InputNeeded(std::uint32_t frames, double rate) const
+{
+    if (frames <= _pendingCount) {
+        return 0;
+    }
+    const auto remaining = static_cast<std::int64_t>(frames - _pendingCount);
+    std::int64_t end = 0;
+    if (rate == 1) {
+        end = _natural + remaining;
+    } else {
+        // Each segment starts, at worst, a tolerance after its ideal position, and the next one crossfades
+        // from its natural continuation.
+        rate = std::clamp(rate, kMinRate, kMaxRate);
+        const auto steps = (remaining + _segment - 1) / _segment;
+        const auto hop = _segment * rate;
+        const auto last = _position + static_cast<double>(steps - 1) * hop;
+        end = std::max(static_cast<std::int64_t>(std::ceil(last)) + _tolerance + _segment, _natural + _segment);
+        if (steps > 1) {
+            end = std::max(static_cast<std::int64_t>(std::ceil(last - hop)) + _tolerance + 2 * _segment, end);
+        }
+    }
+    return static_cast<std::uint32_t>(std::max<std::int64_t>(end - _end, 0));
+}
+
+float* TimeStretcher::Reserve(std::uint32_t& frames)
+{
+    if (_end + frames > _capacity) {
+        Compact();
+    }
+    frames = std::min(frames, _capacity - static_cast<std::uint32_t>(_end));
+    return _input.get() + _end;
+}
+
+void TimeStretcher::Commit(std::uint32_t frames)
+{
+    _end = std::min<std::int64_t>(_end + frames, _capacity);
+}
+
+std::uint32_t TimeStretcher::Write(const float* input, std::uint32_t frames)
+{
+    auto* destination = Reserve(frames);
+    std::memcpy(destination, input, frames * sizeof(float));
+    Commit(frames);
+    return frames;
+}
+
+std::uint32_t TimeStretcher::Read(float* output, std::uint32_t frames, double rate)
+{
+    if (rate != 1) {
+        rate = std::clamp(rate, kMinRate, kMaxRate);
+    }
+    std::uint32_t produced = 0;
+    while (produced < frames) {
+        if (_pendingCount > 0) {
+            const auto count = std::min(_pendingCount, frames - produced);
+            std::memcpy(output + produced, _pending.get() + _pendingOffset, count * sizeof(float));
+            _pendingOffset += count;
+            _pendingCount -= count;
+            produced += count;
+            continue;
+        }
+        if (rate == 1) {
+            // Straight through, keeping the ideal position in step for the next stretch.
+            const auto count = static_cast<std::uint32_t>(std::min<std::int64_t>(frames - produced, _end - _natural));
+            std::memcpy(output + produced, _input.get() + _natural, count * sizeof(float));
+            _natural += count;
+            _position = static_cast<double>(_natural);
+            produced += count;
+            break;
+        }
+        if (!Step(rate)) {
+            break;
+        }
+    }
+    return produced;
+}
+
+std::uint32_t TimeStretcher::Buffered() const
+{
+    return _pendingCount + static_cast<std::uint32_t>(_end - _natural);
+}
+
+void TimeStretcher::Reset()
+{
+    _end = 0;
+    _natural = 0;
+    _position = 0;
+    _pendingOffset = 0;
+    _pendingCount = 0;
+}
+
+bool TimeStretcher::Step(double rate)
+{
+    const auto target = static_cast<std::int64_t>(std::llround(_position));
+    const auto low = std::max<std::int64_t>(target - _tolerance, 0);
+    const auto high = std::min<std::int64_t>(target + _tolerance, _end - _segment);
+    if (_natural + _segment > _end || high < low) {
+        return false;
+    }
+
+    // The natural continuation matches itself perfectly, so is used whenever it is in range; drift away
+    // from the ideal position builds up until it no longer is, and then a pitch period or so is skipped
+    // or repeated.
+    const auto* natural = _input.get() + _natural;
+    if (_natural >= low && _natural <= high) {
+        std::memcpy(_pending.get(), natural, _segment * sizeof(float));
+        Account(_segment, _segment);
+        _natural += _segment;
+    } else {
+        const auto candidate = Search(target, low, high);
+        const auto* next = _input.get() + candidate;
+        for (std::uint32_t index = 0; index < _segment; ++index) {
+            _pending[index] = natural[index] + _fade[index] * (next[index] - natural[index]);
+        }
+        Account(candidate + _segment - _natural, _segment);
+        _natural = candidate + _segment;
+    }
+    _position += _segment * rate;
+    _pendingOffset = 0;
+    _pendingCount = _segment;
+    return true;
+}
+
+std::int64_t TimeStretcher::Search(std::int64_t target, std::int64_t low, std::int64_t high) const
+{
+    const auto* input = _input.get();
+    const auto* reference = input + _natural;
+
+    // Coarse.
+    const auto coarseReference = _segment / kDecimation;
+    const auto coarseCandidates = static_cast<std::uint32_t>(high - low) / kDecimation + 1;
+    Decimate(reference, coarseReference, _coarseReference.get());
+    Decimate(input + low, coarseCandidates + coarseReference - 1, _coarseCandidates.get());
+    // Ties, as in silence, go to the ideal position.
+    auto coarseBest = static_cast<std::uint32_t>(std::min<std::int64_t>((target - low) / kDecimation,
+                                                                       coarseCandidates - 1));
+    auto bestScore = Similarity(_coarseCandidates.get() + coarseBest, _coarseReference.get(), coarseReference);
+    for (std::uint32_t index = 0; index < coarseCandidates; ++index) {
+        const auto score = Similarity(_coarseCandidates.get() + index, _coarseReference.get(), coarseReference);
+        if (score > bestScore) {
+            bestScore = score;
+            coarseBest = index;
+        }
+    }
+
+    // Fine.
+    const auto center = low + static_cast<std::int64_t>(coarseBest) * kDecimation;
+    auto best = center;
+    bestScore = Similarity(input + center, reference, _segment);
+    for (auto candidate = std::max(center - kRefine, low); candidate <= std::min(center + kRefine, high); ++candidate) {
+        const auto score = Similarity(input + candidate, reference, _segment);
+        if (score > bestScore) {
+            bestScore = score;
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+void TimeStretcher::Compact()
+{
+    const auto drop = std::min(_natural, static_cast<std::int64_t>(_position)) - _history;
+    if (drop <= 0) {
+        return;
+    }
+    std::memmove(_input.get(), _input.get() + drop, (_end - drop) * sizeof(float));
+    _end -= drop;
+    _natural -= drop;
+    _position -= static_cast<double>(drop);
+}
+
+void TimeStretcher::Account(std::int64_t consumed, std::int64_t produced)
+{
+    if (consumed > produced) {
+        _removed.fetch_add(static_cast<std::uint64_t>(consumed - produced), std::memory_order_relaxed);
+    } else if (produced > consumed) {
+        _inserted.fetch_add(static_cast<std::uint64_t>(produced - consumed), std::memory_order_relaxed);
+    }
+}
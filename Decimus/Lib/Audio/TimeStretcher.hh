@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef TimeStretcher_hh
+#define TimeStretcher_hh
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/// Plays mono float audio faster or slower without changing its pitch, using WSOLA
+/// (waveform similarity overlap-add).
+///
+/// Output is built in segments of `SegmentFrames`. Each segment crossfades the natural continuation of the
+/// last one into the input at the ideal (rate scaled) position, nudged by up to `ToleranceFrames` to where
+/// the waveform best matches, so periodic sounds like voiced speech are joined in phase. The search is
+/// done coarsely on a decimated signal, then refined.
+///
+/// At a rate of exactly 1 input is passed straight through, adding no latency and no processing. Any other
+/// rate needs `SegmentFrames + ToleranceFrames` of input beyond what is being output.
+///
+/// Not thread safe, except `Removed` and `Inserted`. `Write` and `Read` never block or allocate, so can be
+/// called from a render thread.
+class TimeStretcher
+{
+public:
+    static constexpr double kMinRate = 0.85;
+    static constexpr double kMaxRate = 1.15;
+
+    /// - Parameter sampleRate: Sample rate of the audio, which sets the segment and search sizes.
+    /// - Parameter maxFrames: Most frames that will be read at a time.
+    TimeStretcher(std::uint32_t sampleRate, std::uint32_t maxFrames);
+
+    TimeStretcher(const TimeStretcher&) = delete;
+    TimeStretcher& operator=(const TimeStretcher&) = delete;
+
+    /// Input frames that must be written before `Read(frames, rate)` can produce all of its frames.
+    std::uint32_t InputNeeded(std::uint32_t frames, double rate) const;
+
+    /// Space to append input to directly, to be followed by `Commit`.
+    /// - Parameter frames: Frames wanted, reduced to what fits.
+    float* Reserve(std::uint32_t& frames);
+
+    /// Append input written to `Reserve`d space.
+    void Commit(std::uint32_t frames);
+
+    /// Append input.
+    /// - Returns: Frames taken, which is less than given only if there is not enough space.
+    std::uint32_t Write(const float* input, std::uint32_t frames);
+
+    /// Produce output, playing input at `rate` (clamped to `kMinRate`...`kMaxRate`) times real time.
+    /// - Returns: Frames produced, which is less than asked only when input runs out.
+    std::uint32_t Read(float* output, std::uint32_t frames, double rate);
+
+    /// Frames written but not yet played. When stretching, this is the latency added.
+    std::uint32_t Buffered() const;
+
+    /// Drop all audio, such as after a discontinuity.
+    void Reset();
+
+    /// Input frames skipped by playing faster, in total.
+    std::uint64_t Removed() const { return _removed.load(std::memory_order_relaxed); }
+    /// Output frames added by playing slower, in total.
+    std::uint64_t Inserted() const { return _inserted.load(std::memory_order_relaxed); }
+
+    std::uint32_t SegmentFrames() const { return _segment; }
+    std::uint32_t ToleranceFrames() const { return _tolerance; }
+
+private:
+    // Produce the next segment into `_pending`.
+    // - Returns: False if there isn't enough input.
+    bool Step(double rate);
+    // Best matching input position for the next segment, within [low, high].
+    std::int64_t Search(std::int64_t target, std::int64_t low, std::int64_t high) const;
+    // Move everything no longer reachable out of the input.
+    void Compact();
+    void Account(std::int64_t consumed, std::int64_t produced);
+
+    const std::uint32_t _segment;
+    const std::uint32_t _tolerance;
+    // Input kept behind the natural position, for segments that step backwards when slowing down.
+    const std::uint32_t _history;
+    const std::uint32_t _capacity;
+    std::unique_ptr<float[]> _input;
+    std::unique_ptr<float[]> _fade;
+    std::unique_ptr<float[]> _pending;
+    // Decimated search scratch, for the candidate region and the reference.
+    std::unique_ptr<float[]> _coarseCandidates;
+    std::unique_ptr<float[]> _coarseReference;
+
+    // Input frames held.
+    std::int64_t _end = 0;
+    // Where unstretched playout would continue from.
+    std::int64_t _natural = 0;
+    // Ideal input position of the next segment. Tracks `_natural` at a rate of 1.
+    double _position = 0;
+    std::uint32_t _pendingOffset = 0;
+    std::uint32_t _pendingCount = 0;
+
+    std::atomic<std::uint64_t> _removed{ 0 };
+    std::atomic<std::uint64_t> _inserted{ 0 };
+};
+
+#endif /* TimeStretcher_hh */
@@ -0,0 +1,193 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "AnnexBScanner.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ANNEXB_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define ANNEXB_SSE2 1
+#endif
+
+namespace {
+constexpr std::uint8_t kH264Sei = 6;
+constexpr std::uint8_t kHEVCPrefixSei = 39;
+
+bool IsMarker(const std::uint8_t* at)
+{
+    return at[0] == 0 && at[1] == 0 && (at[2] | 2) == 3;
+}
+
+// First `00 00 01` (start code) or `00 00 03` (emulation prevention) at or after `cursor`, or `end`.
+const std::uint8_t* FindMarker(const std::uint8_t* cursor, const std::uint8_t* end)
+{
+    if (end - cursor < 3) {
+        return end;
+    }
+
+#if defined(ANNEXB_NEON)
+    const auto zero = vdupq_n_u8(0);
+    const auto two = vdupq_n_u8(2);
+    const auto three = vdupq_n_u8(3);
+    while (end - cursor >= 18) {
+        const auto first = vceqq_u8(vld1q_u8(cursor), zero);
+        const auto second = vceqq_u8(vld1q_u8(cursor + 1), zero);
+        const auto third = vceqq_u8(vorrq_u8(vld1q_u8(cursor + 2), two), three);
+        const auto match = vandq_u8(vandq_u8(first, second), third);
+        if (vmaxvq_u8(match) != 0) {
+            // Narrow to 4 bits per byte to find the first match.
+            const auto nibbles = vshrn_n_u16(vreinterpretq_u16_u8(match), 4);
+            const auto bits = vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+            return cursor + (__builtin_ctzll(bits) >> 2);
+        }
+        cursor += 16;
+    }
+#elif defined(ANNEXB_SSE2)
+    const auto zero = _mm_setzero_si128();
+    const auto two = _mm_set1_epi8(2);
+    const auto three = _mm_set1_epi8(3);
+    const auto load = [](const std::uint8_t* at) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(at)); };
+    while (end - cursor >= 18) {
+        const auto first = _mm_cmpeq_epi8(load(cursor), zero);
+        const auto second = _mm_cmpeq_epi8(load(cursor + 1), zero);
+        const auto third = _mm_cmpeq_epi8(_mm_or_si128(load(cursor + 2), two), three);
+        const auto mask = _mm_movemask_epi8(_mm_and_si128(_mm_and_si128(first, second), third));
+        if (mask != 0) {
+            return cursor + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+        cursor += 16;
+    }
+#else
+    // Scalar: skip ahead by as much as the byte at +2 (or +1) rules out.
+    while (end - cursor >= 18) {
+        if (cursor[2] > 3) {
+            cursor += 3;
+        } else if (cursor[1] != 0) {
+            cursor += 2;
+        } else if (!IsMarker(cursor)) {
+            cursor += 1;
+        } else {
+            return cursor;
+        }
+    }
+#endif
+
+    for (; end - cursor >= 3; ++cursor) {
+        if (IsMarker(cursor)) {
+            return cursor;
+        }
+    }
+    return end;
+}
+}
+
+std::size_t ScanAnnexB(const std::uint8_t* data,
+                       std::size_t length,
+                       NalCodec codec,
+                       NalSpan* spans,
+                       std::size_t capacity)
+{
+    const std::size_t headerLength = codec == NalCodec::H264 ? 1 : 2;
+    const std::uint8_t sei = codec == NalCodec::H264 ? kH264Sei : kHEVCPrefixSei;
+    const auto* end = data + length;
+
+    std::size_t count = 0;
+    NalSpan current {};
+    bool open = false;
+    // End of the current NAL unit if it is an SEI bounded by its payload size, else 0.
+    std::size_t bound = 0;
+
+    const auto close = [&](std::size_t until) {
+        current.length = (bound != 0 ? bound : until) - current.offset;
+        if (count < capacity) {
+            spans[count] = current;
+        }
+        ++count;
+        open = false;
+        bound = 0;
+    };
+
+    const auto* cursor = data;
+    while (true) {
+        const auto* marker = FindMarker(cursor, end);
+        if (marker == end) {
+            break;
+        }
+        const auto at = static_cast<std::size_t>(marker - data);
+        cursor = marker + 3;
+
+        if (marker[2] == 3) {
+            if (open && bound == 0) {
+                current.escaped = true;
+            } else if (open && at + 2 < bound) {
+                // The payload size counts unescaped bytes.
+                current.escaped = true;
+                bound = std::min(bound + 1, length);
+            }
+            continue;
+        }
+
+        // Start codes inside a bounded SEI are payload.
+        if (open && bound != 0 && at < bound) {
+            continue;
+        }
+
+        // A zero before `00 00 01` makes it the 4 byte form.
+        std::size_t start = at;
+        if (at > 0 && data[at - 1] == 0 && !(open && bound != 0 && at - 1 < bound)) {
+            start = at - 1;
+        }
+        if (open) {
+            close(start);
+        }
+
+        const auto offset = at + 3;
+        if (offset >= length) {
+            break;
+        }
+        const auto header = data[offset];
+        const auto type = static_cast<std::uint8_t>(codec == NalCodec::H264 ? header & 0x1F : (header >> 1) & 0x3F);
+        current = NalSpan { offset, 0, static_cast<std::uint8_t>(offset - start), type, false };
+        open = true;
+
+        // Header, payload type, payload size, payload, stop bit.
+        const auto sizeIndex = offset + headerLength + 1;
+        if (type == sei && sizeIndex < length) {
+            bound = std::min(sizeIndex + 1 + data[sizeIndex] + 1, length);
+        }
+    }
+
+    if (open) {
+        close(length);
+    }
+    return count;
+}
+
+std::size_t UnescapeRbsp(const std::uint8_t* source, std::size_t length, std::uint8_t* destination)
+{
+    if (length == 0) {
+        return 0;
+    }
+    const auto* end = source + length;
+    const auto* cursor = source;
+    std::size_t written = 0;
+    while (true) {
+        const auto* marker = FindMarker(cursor, end);
+        if (marker == end) {
+            break;
+        }
+        // Keep the zeros and drop the 03. A start code isn't expected here, but isn't ours to remove.
+        const auto kept = static_cast<std::size_t>(marker + (marker[2] == 3 ? 2 : 3) - cursor);
+        std::memmove(destination + written, cursor, kept);
+        written += kept;
+        cursor = marker + 3;
+    }
+    const auto remaining = static_cast<std::size_t>(end - cursor);
+    std::memmove(destination + written, cursor, remaining);
+    return written + remaining;
+}
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef AnnexBScanner_hh
+#define AnnexBScanner_hh
+
+#include <cstddef>
+#include <cstdint>
+
+enum class NalCodec : std::uint8_t
+{
+    H264,
+    HEVC,
+};
+
+/// A NAL unit within an Annex B bitstream.
+struct NalSpan
+{
+    /// Offset of the NAL unit header, immediately after the start code.
+    std::size_t offset;
+    /// Length of the NAL unit, header included, start code excluded.
+    std::size_t length;
+    /// 3 for `00 00 01`, 4 for `00 00 00 01`.
+    std::uint8_t startCodeLength;
+    /// NAL unit type, decoded for the codec.
+    std::uint8_t type;
+    /// True if the NAL unit contains emulation prevention bytes (`00 00 03`).
+    bool escaped;
+};
+
+/// Finds every NAL unit in an Annex B bitstream in a single pass.
+///
+/// Start codes and emulation prevention sequences are located 16 bytes at a time (SSE2 or NEON,
+/// falling back to a scalar skip search), so large keyframes are scanned without per NAL searches
+/// or allocations.
+///
+/// Application SEIs are written without emulation prevention, so an SEI is bounded by its
+/// (single byte) payload size rather than the next start code, and any start code inside it is ignored.
+///
+/// - Parameter spans: Caller owned output, written up to `capacity`.
+/// - Returns: The number of NAL units found, which may exceed `capacity`.
+std::size_t ScanAnnexB(const std::uint8_t* data,
+                       std::size_t length,
+                       NalCodec codec,
+                       NalSpan* spans,
+                       std::size_t capacity);
+
+/// Remove emulation prevention bytes, turning a NAL unit into its RBSP.
+/// `destination` must hold `length` bytes and may be the same as `source`.
+/// - Returns: The unescaped length.
+std::size_t UnescapeRbsp(const std::uint8_t* source, std::size_t length, std::uint8_t* destination);
+
+#endif /* AnnexBScanner_hh */
@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef QAnnexBScanner_h
+#define QAnnexBScanner_h
+
+#import <Foundation/Foundation.h>
+
+typedef NS_ENUM(uint8_t, QNalCodec) {
+    kQNalCodecH264,
+    kQNalCodecHEVC,
+};
+
+/// A NAL unit within an Annex B bitstream. Layout matches `NalSpan`.
+typedef struct QNalSpan {
+    /// Offset of the NAL unit header, immediately after the start code.
+    size_t offset;
+    /// Length of the NAL unit, header included, start code excluded.
+    size_t length;
+    /// 3 or 4.
+    uint8_t startCodeLength;
+    /// NAL unit type, decoded for the codec.
+    uint8_t type;
+    /// True if the NAL unit contains emulation prevention bytes.
+    bool escaped;
+} QNalSpan;
+
+/// Single pass Annex B start code scanning using `AnnexBScanner`.
+@interface QAnnexBScanner : NSObject
+
+/// Find the NAL units in an Annex B bitstream.
+/// - Returns: The number of NAL units found. If larger than `capacity`, only the first `capacity` were written.
++(size_t) scan: (const void* _Nonnull) data
+        length: (size_t) length
+         codec: (QNalCodec) codec
+         spans: (QNalSpan* _Nonnull) spans
+      capacity: (size_t) capacity;
+
+/// Remove emulation prevention bytes. `destination` must hold `length` bytes and may equal `source`.
+/// - Returns: The unescaped length.
++(size_t) unescape: (const void* _Nonnull) source
+            length: (size_t) length
+       destination: (void* _Nonnull) destination;
+
+@end
+
+#endif /* QAnnexBScanner_h */
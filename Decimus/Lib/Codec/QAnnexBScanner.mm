@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#import <Foundation/Foundation.h>
+#import "QAnnexBScanner.h"
+
+#include <cstddef>
+
+#include "AnnexBScanner.hh"
+
+// Spans are written straight into the caller's buffer.
+static_assert(sizeof(QNalSpan) == sizeof(NalSpan), "NalSpan layout mismatch");
+static_assert(offsetof(QNalSpan, offset) == offsetof(NalSpan, offset), "NalSpan layout mismatch");
+static_assert(offsetof(QNalSpan, length) == offsetof(NalSpan, length), "NalSpan layout mismatch");
+static_assert(offsetof(QNalSpan, startCodeLength) == offsetof(NalSpan, startCodeLength), "NalSpan layout mismatch");
+static_assert(offsetof(QNalSpan, type) == offsetof(NalSpan, type), "NalSpan layout mismatch");
+static_assert(offsetof(QNalSpan, escaped) == offsetof(NalSpan, escaped), "NalSpan layout mismatch");
+
+@implementation QAnnexBScanner
+
++(size_t) scan: (const void*) data
+        length: (size_t) length
+         codec: (QNalCodec) codec
+         spans: (QNalSpan*) spans
+      capacity: (size_t) capacity
+{
+    return ScanAnnexB(static_cast<const std::uint8_t*>(data),
+                      length,
+                      codec == kQNalCodecH264 ? NalCodec::H264 : NalCodec::HEVC,
+                      reinterpret_cast<NalSpan*>(spans),
+                      capacity);
+}
+
++(size_t) unescape: (const void*) source
+            length: (size_t) length
+       destination: (void*) destination
+{
+    return UnescapeRbsp(static_cast<const std::uint8_t*>(source), length, static_cast<std::uint8_t*>(destination));
+}
+
+@end
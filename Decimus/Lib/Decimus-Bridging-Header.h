@@ -5,7 +5,16 @@
 #define Decimus_Bridging_Header_h
 
 #import "Jitter/QJitterBuffer.h"
+#import "Jitter/QSequenceRing.h"
+#import "Codec/QAnnexBScanner.h"
 #import "EncodedBuffer/EncodedFrameBufferAllocator.h"
+#import "Payload/QPayloadPool.h"
+#import "Metrics/QMetricsCollector.h"
+#import "Metrics/QHistogram.h"
+#import "Audio/QAudioMixer.h"
+#import "Audio/QTimeStretcher.h"
+#import "Stats/QArrivalStats.h"
+#import "Video/QQualityTable.h"
 #import "Utilities/SwiftInterop.h"
 
 #import "libquicr/QFullTrackName.h"
@@ -16,6 +25,7 @@
 #import "libquicr/QClientCallbacks.h"
 #import "libquicr/QClientObjC.h"
 #import "libquicr/QPublishTrackHandlerObjC.h"
+#import "libquicr/QPublishBatch.h"
 #import "libquicr/QSubscribeTrackHandlerObjC.h"
 #import "libquicr/QFetchTrackHandlerObjC.h"
 #import "libquicr/QLocation.h"
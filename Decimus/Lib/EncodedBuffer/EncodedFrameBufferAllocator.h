@@ -13,22 +13,33 @@
 
 #ifdef __cplusplus
 #include "ExtBufferAllocator.hh"
+#include <memory>
 #endif
 
+typedef struct BufferAllocatorStats {
+    size_t slots;
+    size_t inUse;
+    size_t highWaterMark;
+    uint64_t allocations;
+    uint64_t failures;
+} BufferAllocatorStats;
+
 @interface BufferAllocator : NSObject {
     CFAllocatorContext context;
     CFAllocatorRef allocatorRef;
 #ifdef __cplusplus
-    ExtBufferAllocator *extBufferAllocatorPtr;
+    std::shared_ptr<ExtBufferAllocator> extBufferAllocatorPtr;
 #endif
 }
-- (instancetype) init: (size_t) preAllocSize hdrSize: (size_t) preAllocHdrSize;
+- (instancetype) init: (size_t) preAllocSize hdrSize: (size_t) preAllocHdrSize slots: (size_t) slots;
 - (void) dealloc;
 - (CFAllocatorRef) allocator;
-- (void *) allocateBufferHeader: (size_t) length;
-- (void) retrieveFullBufferPointer: (void **) fullBufferPtr len: (size_t *) length;
+- (void *) allocateBufferHeader: (size_t) length buffer: (void *) bufferPtr;
+- (void) retrieveFullBufferPointer: (void *) bufferPtr full: (void **) fullBufferPtr len: (size_t *) length;
 - (void *) iosAllocBuffer: (CFIndex) allocSize;
+- (void) iosRetainBuffer: (void *) bufferPtr;
 - (void) iosDeallocBuffer: (void *) bufferPtr;
+- (BufferAllocatorStats) stats;
 @end
 
 #endif /* EncodedFrameBufferAllocator_h */
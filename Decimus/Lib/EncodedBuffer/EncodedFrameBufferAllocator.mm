@@ -13,169 +13,100 @@
 #include "ExtBufferAllocator.hh"
 
 #ifdef __cplusplus
-#include <inttypes.h>
-#include <iostream>
+#include <cstdlib>
 #endif
 
+// CFAllocator callbacks. The context's info is a heap shared_ptr of the CFAllocator's own, so the slots
+// outlive this wrapper for as long as anything (VideoToolbox, block buffers) still holds the CFAllocator.
+// Requests that don't fit a free slot fall back to malloc, and deallocation dispatches on whether the
+// pointer came from a slot.
+static const void *extendedRetain(const void *info) {
+    return new std::shared_ptr<ExtBufferAllocator>(*static_cast<const std::shared_ptr<ExtBufferAllocator> *>(info));
+}
+
+static void extendedRelease(const void *info) {
+    delete static_cast<const std::shared_ptr<ExtBufferAllocator> *>(info);
+}
+
+static void *extendedAllocate(CFIndex allocSize, CFOptionFlags hint, void *info) {
+    const auto& extBufferAllocatorPtr = *static_cast<std::shared_ptr<ExtBufferAllocator> *>(info);
+    if (auto buffer = extBufferAllocatorPtr->allocateBuffer(allocSize)) {
+        return buffer;
+    }
+    return malloc(allocSize);
+}
+
+static void extendedDeallocate(void *ptr, void *info) {
+    const auto& extBufferAllocatorPtr = *static_cast<std::shared_ptr<ExtBufferAllocator> *>(info);
+    if (extBufferAllocatorPtr->owns(ptr)) {
+        extBufferAllocatorPtr->releaseBuffer(ptr);
+    } else {
+        free(ptr);
+    }
+}
+
 @implementation BufferAllocator
 
-- (instancetype) init: (size_t) preAllocSize hdrSize: (size_t) preAllocHdrSize {
+- (instancetype) init: (size_t) preAllocSize hdrSize: (size_t) preAllocHdrSize slots: (size_t) slots {
     self = [super init];
     if (self) {
-        extBufferAllocatorPtr = new ExtBufferAllocator(preAllocSize, preAllocHdrSize);
-        //NSLog(@"init: ext buffer ptr %p", extBufferAllocatorPtr);
+        extBufferAllocatorPtr = std::make_shared<ExtBufferAllocator>(preAllocSize, preAllocHdrSize, slots);
     }
     return self;
 }
 
 - (void) dealloc {
-    if (extBufferAllocatorPtr) {
-        delete extBufferAllocatorPtr;
+    if (allocatorRef) {
+        CFRelease(allocatorRef);
     }
-   // CFRelease(allocatorRef);
 }
 
 - (CFAllocatorRef)allocator {
+    if (allocatorRef) {
+        return allocatorRef;
+    }
     CFAllocatorGetContext(kCFAllocatorDefault, &context);
-    context.allocate = extBufferAllocatorPtr->_extendedAllocate;
-    context.deallocate = extBufferAllocatorPtr->_extendedDeallocate;
-    context.info = extBufferAllocatorPtr;
+    context.allocate = extendedAllocate;
+    context.reallocate = nullptr;
+    context.deallocate = extendedDeallocate;
+    // Copied by `retain` when the CFAllocator is created, and that copy released with it.
+    context.retain = extendedRetain;
+    context.release = extendedRelease;
+    context.copyDescription = nullptr;
+    context.info = &extBufferAllocatorPtr;
     allocatorRef = CFAllocatorCreate(nil, &context);
-    // NSLog(@"%p\n", ((struct CFAllocator *)allocatorRef));
     return allocatorRef;
 }
 
-- (void *) allocateBufferHeader: (size_t) length {
-    // NSLog(@"allocateBufferHeader: ext buffer ptr %p", extBufferAllocatorPtr);
-    return extBufferAllocatorPtr->allocateBufferHeader(length);
-}
-    
-- (void) retrieveFullBufferPointer: (void **) fullBufferPtr len: (size_t *) lengthPtr {
-    extBufferAllocatorPtr->retrieveFullBufferPointer(fullBufferPtr, lengthPtr);
-}
-
-- (void *) iosAllocBuffer: (CFIndex) allocSize {
-    return extBufferAllocatorPtr->_extendedAllocate(allocSize, 0, extBufferAllocatorPtr);
-}
-
-- (void) iosDeallocBuffer: (void *) bufferPtr {
-    extBufferAllocatorPtr->_extendedDeallocate(bufferPtr, extBufferAllocatorPtr);
-}
-
-@end
-
-/*
- * Allocate a reusable buffer.
- *
- *   |        <----------- preAllocateSize ------------->              |
- *                 |<--- hdrSize --->|
- *   +-----------------------------------------------------------------+
- *   | {blank}     | hdr2 | hdr1     | buffer            | {blank}.... |
- *   +-----------------------------------------------------------------+
- *                                   ^
- *                                   |
- *                                   frameBufferPtr
- *
- * Supply a CFAllocatorRef that can be used in block buffer allocation.
- * Pre-allocate this buffer and reuse it. The pre-allocated buffer size
- * and maximum header size are used to size the overall buffer and
- * header offset.
- */
-ExtBufferAllocator::ExtBufferAllocator(std::size_t preAllocateSize,
-                                       std::size_t preAllocateHdrSize) :
-                                        preAllocateSize(preAllocateSize),
-                                        preAllocateHdrSize(preAllocateHdrSize)
-{
-    if (preAllocateSize <= 4ul * 1024 * 1024) { // 4M max
-        preAllocatedBuffer = (std::uint8_t *)malloc(preAllocateSize);
-        if (preAllocatedBuffer == nullptr) {
-            std::cerr << "BufferAllocator() - preallocation erro" << std::endl;
-        }
-        frameBufferPtr = preAllocatedBuffer;
-        frameBufferSize = 0;
-        firstHeaderPtr = preAllocatedBuffer;
-        
-        if (preAllocateHdrSize < preAllocateSize) {
-            frameBufferPtr = preAllocatedBuffer + preAllocateHdrSize;
-            firstHeaderPtr = frameBufferPtr;
-//            NSLog(@"ExtBufferAllocator() - [%p]->[%p:[[%p/%lu] -> [%ld] -> [%p/%lu]]",
-//                  this,
-//                  preAllocatedBuffer,
-//                  firstHeaderPtr, preAllocateHdrSize,
-//                  frameBufferPtr - firstHeaderPtr,
-//                  frameBufferPtr, preAllocateSize);
-        } else {
-            std::cerr << "BufferAllocate() - preallocate header size invalid" << std::endl;
-        }
-    } else {
-        std::cerr << "BufferAllocator() - preallocation size too large" << std::endl;
-    }
-}
-
-ExtBufferAllocator::~ExtBufferAllocator() {
-    free(preAllocatedBuffer);
+- (void *) allocateBufferHeader: (size_t) length buffer: (void *) bufferPtr {
+    return extBufferAllocatorPtr->allocateBufferHeader(bufferPtr, length);
 }
 
-void ExtBufferAllocator::resetBuffers() {
-    firstHeaderPtr = frameBufferPtr;
-    frameBufferSize = 0;
+- (void) retrieveFullBufferPointer: (void *) bufferPtr full: (void **) fullBufferPtr len: (size_t *) lengthPtr {
+    extBufferAllocatorPtr->retrieveFullBufferPointer(bufferPtr, fullBufferPtr, lengthPtr);
 }
 
-void *ExtBufferAllocator::_extendedAllocate(CFIndex allocSize, CFOptionFlags hint, void *info) {
-    auto extBufferAllocatorPtr = (ExtBufferAllocator *)info;
-    // NSLog(@"_extendedAllocate: ext buffer ptr [%p/%lu]", extBufferAllocatorPtr, allocSize);
-
-    if (extBufferAllocatorPtr) {
-        return extBufferAllocatorPtr->allocateBuffer(allocSize);
-    }
-    return nullptr;
-}
-
-void ExtBufferAllocator::_extendedDeallocate(void *ptr, void *info) {
-    // reset header pointer and sizes
-    auto extBufferAllocatorPtr = (ExtBufferAllocator *)info;
-    // NSLog(@"_extendedDeallocate: ext buffer ptr %p", extBufferAllocatorPtr);
-    if (extBufferAllocatorPtr) {
-        extBufferAllocatorPtr->resetBuffers();
-    }
-}
-
-void *ExtBufferAllocator::allocateBuffer(std::size_t bufferSize) {
-    if (bufferSize <= (preAllocateSize - preAllocateHdrSize)) {
-        frameBufferSize = bufferSize;
-        //NSLog(@"allocateBuffer: buffer ptr [%p/%lu]", frameBufferPtr, frameBufferSize);
-        return frameBufferPtr;
-    }
-    return (void *)nullptr;
+- (void *) iosAllocBuffer: (CFIndex) allocSize {
+    return extBufferAllocatorPtr->allocateBuffer(allocSize);
 }
 
-std::size_t ExtBufferAllocator::getAvailHdrSize() {
-    if (firstHeaderPtr > preAllocatedBuffer) {
-        return firstHeaderPtr - preAllocatedBuffer;
-    }
-    return 0;
+- (void) iosRetainBuffer: (void *) bufferPtr {
+    extBufferAllocatorPtr->retainBuffer(bufferPtr);
 }
 
-void *ExtBufferAllocator::allocateBufferHeader(std::size_t length)
-{
-    if (getAvailHdrSize() >= length) {
-        firstHeaderPtr -= length;
-//        NSLog(@"allocateBufferHeader() - [%p]->[%p:[[%p/%lu] -> [%ld] -> [%p/%lu]]",
-//              this,
-//              preAllocatedBuffer,
-//              firstHeaderPtr, length,
-//              frameBufferPtr - firstHeaderPtr,
-//              frameBufferPtr, frameBufferSize);
-        
-        return firstHeaderPtr;
-    }
-    return nullptr;
+- (void) iosDeallocBuffer: (void *) bufferPtr {
+    extBufferAllocatorPtr->releaseBuffer(bufferPtr);
 }
 
-void ExtBufferAllocator::retrieveFullBufferPointer(void **bufferPtr, size_t *length) {
-    *bufferPtr = firstHeaderPtr;
-    *length = (frameBufferPtr - firstHeaderPtr) + frameBufferSize;
+- (BufferAllocatorStats) stats {
+    const auto stats = extBufferAllocatorPtr->stats();
+    return {
+        .slots = stats.slots,
+        .inUse = stats.inUse,
+        .highWaterMark = stats.highWaterMark,
+        .allocations = stats.allocations,
+        .failures = stats.failures
+    };
 }
 
-
-
+@end
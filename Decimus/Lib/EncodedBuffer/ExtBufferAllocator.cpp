@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: Copyright (c) 2023 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "ExtBufferAllocator.hh"
+
+namespace {
+constexpr std::size_t kAlignment = 64;
+
+std::size_t alignUp(std::size_t value)
+{
+    return (value + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+std::uint64_t pack(std::uint32_t tag, std::uint32_t index)
+{
+    return (static_cast<std::uint64_t>(tag) << 32) | index;
+}
+}
+
+ExtBufferAllocator::ExtBufferAllocator(std::size_t slotSize, std::size_t hdrSize, std::size_t slots) :
+    _slotSize(slotSize),
+    _hdrSize(hdrSize),
+    _slots(slots < kNoSlot ? slots : kNoSlot - 1),
+    _stride(alignUp(hdrSize + slotSize)),
+    _slab(new std::uint8_t[_stride * _slots]),
+    _meta(new Slot[_slots])
+{
+    for (std::uint32_t index = 0; index < _slots; index++) {
+        _meta[index].next.store(index + 1 < _slots ? index + 1 : kNoSlot, std::memory_order_relaxed);
+    }
+    _freeHead.store(pack(0, _slots > 0 ? 0 : kNoSlot), std::memory_order_release);
+}
+
+std::uint8_t *ExtBufferAllocator::frameAt(std::uint32_t index) const
+{
+    return _slab.get() + static_cast<std::size_t>(index) * _stride + _hdrSize;
+}
+
+std::uint32_t ExtBufferAllocator::indexOf(const void *buffer) const
+{
+    const auto *ptr = static_cast<const std::uint8_t *>(buffer);
+    const auto *first = _slab.get() + _hdrSize;
+    if (ptr < first || ptr >= _slab.get() + _stride * _slots) {
+        return kNoSlot;
+    }
+    const auto offset = static_cast<std::size_t>(ptr - first);
+    if (offset % _stride != 0) {
+        return kNoSlot;
+    }
+    return static_cast<std::uint32_t>(offset / _stride);
+}
+
+bool ExtBufferAllocator::owns(const void *buffer) const
+{
+    return indexOf(buffer) != kNoSlot;
+}
+
+std::uint32_t ExtBufferAllocator::pop()
+{
+    auto head = _freeHead.load(std::memory_order_acquire);
+    while (true) {
+        const auto index = static_cast<std::uint32_t>(head);
+        if (index == kNoSlot) {
+            return kNoSlot;
+        }
+        const auto next = _meta[index].next.load(std::memory_order_relaxed);
+        const auto tag = static_cast<std::uint32_t>(head >> 32) + 1;
+        if (_freeHead.compare_exchange_weak(head, pack(tag, next),
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+            return index;
+        }
+    }
+}
+
+void ExtBufferAllocator::push(std::uint32_t index)
+{
+    auto head = _freeHead.load(std::memory_order_acquire);
+    while (true) {
+        _meta[index].next.store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+        const auto tag = static_cast<std::uint32_t>(head >> 32) + 1;
+        if (_freeHead.compare_exchange_weak(head, pack(tag, index),
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+            return;
+        }
+    }
+}
+
+void *ExtBufferAllocator::allocateBuffer(std::size_t bufferSize)
+{
+    const auto index = bufferSize <= _slotSize ? pop() : kNoSlot;
+    if (index == kNoSlot) {
+        _failures.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    _allocations.fetch_add(1, std::memory_order_relaxed);
+    const auto inUse = _inUse.fetch_add(1, std::memory_order_relaxed) + 1;
+    auto high = _highWaterMark.load(std::memory_order_relaxed);
+    while (inUse > high && !_highWaterMark.compare_exchange_weak(high, inUse, std::memory_order_relaxed)) {}
+
+    auto &slot = _meta[index];
+    slot.frameSize = bufferSize;
+    slot.hdrUsed = 0;
+    slot.refs.store(1, std::memory_order_release);
+    return frameAt(index);
+}
+
+void *ExtBufferAllocator::allocateBufferHeader(void *buffer, std::size_t length)
+{
+    const auto index = indexOf(buffer);
+    if (index == kNoSlot) {
+        return nullptr;
+    }
+    auto &slot = _meta[index];
+    if (_hdrSize - slot.hdrUsed < length) {
+        return nullptr;
+    }
+    slot.hdrUsed += length;
+    return frameAt(index) - slot.hdrUsed;
+}
+
+void ExtBufferAllocator::retrieveFullBufferPointer(void *buffer, void **bufferPtr, std::size_t *length) const
+{
+    const auto index = indexOf(buffer);
+    if (index == kNoSlot) {
+        *bufferPtr = nullptr;
+        *length = 0;
+        return;
+    }
+    const auto &slot = _meta[index];
+    *bufferPtr = frameAt(index) - slot.hdrUsed;
+    *length = slot.hdrUsed + slot.frameSize;
+}
+
+void ExtBufferAllocator::retainBuffer(void *buffer)
+{
+    const auto index = indexOf(buffer);
+    if (index != kNoSlot) {
+        _meta[index].refs.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ExtBufferAllocator::releaseBuffer(void *buffer)
+{
+    const auto index = indexOf(buffer);
+    if (index == kNoSlot) {
+        return;
+    }
+    if (_meta[index].refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        _inUse.fetch_sub(1, std::memory_order_relaxed);
+        push(index);
+    }
+}
+
+ExtBufferAllocator::Stats ExtBufferAllocator::stats() const
+{
+    return Stats {
+        _slots,
+        _inUse.load(std::memory_order_relaxed),
+        _highWaterMark.load(std::memory_order_relaxed),
+        _allocations.load(std::memory_order_relaxed),
+        _failures.load(std::memory_order_relaxed),
+    };
+}
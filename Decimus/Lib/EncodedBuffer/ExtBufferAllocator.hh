@@ -2,45 +2,107 @@
 // SPDX-License-Identifier: BSD-2-Clause
 
 //
-//  ExtBufferAllocator.hpp
+//  ExtBufferAllocator.hh
 //  Decimus
 //
 //  Created by Scott Henning on 8/7/23.
 //
 #ifndef ExtBufferAllocator_h
 #define ExtBufferAllocator_h
-#import <Foundation/Foundation.h>
-#import <CoreFoundation/CoreFoundation.h>
-
-//#include <cstddef>
-//#include <cstdint>
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 
+/*
+ * Fixed set of reusable encoded frame buffers.
+ *
+ *   |<------------------------- stride ------------------------->|
+ *   |<--- hdrSize --->|<------------- slotSize ------------->|    |
+ *   +-------------------------------------------------------------+
+ *   | {blank} | hdr2 | hdr1 | buffer                 | {blank}    |  slot 0
+ *   +-------------------------------------------------------------+
+ *   | ...                                                         |  slot 1..N-1
+ *   +-------------------------------------------------------------+
+ *                          ^
+ *                          |
+ *                          frame buffer pointer
+ *
+ * Each slot holds one frame at a time, so up to N frames can be in flight.
+ * Headers (e.g. SEIs) are prepended into the reserved space immediately before
+ * the frame so the full buffer stays contiguous. Slots are refcounted and return
+ * to the free list when the last reference is released. Allocation and release
+ * are lock-free and may happen on different threads.
+ */
 class ExtBufferAllocator {
 public:
-    ExtBufferAllocator(std::size_t preAllocateSize, std::size_t preAllocateHdrSize);
-    ~ExtBufferAllocator();
+    struct Stats {
+        std::size_t slots;
+        std::size_t inUse;
+        std::size_t highWaterMark;
+        std::uint64_t allocations;
+        std::uint64_t failures;
+    };
+
+    ExtBufferAllocator(std::size_t slotSize, std::size_t hdrSize, std::size_t slots);
+    ~ExtBufferAllocator() = default;
+
+    ExtBufferAllocator(const ExtBufferAllocator&) = delete;
+    ExtBufferAllocator& operator=(const ExtBufferAllocator&) = delete;
+
+    /// Claim a free slot for a frame of the given size, with a reference count of 1.
+    /// Returns nullptr if the frame is too large or every slot is in use.
     void *allocateBuffer(std::size_t bufferSize);
-    void *allocateBufferHeader(std::size_t length);
-    void retrieveFullBufferPointer(void **bufferPtr, size_t *length);
-    
-    void resetBuffers();
-    
-    static void *_extendedAllocate(CFIndex allocSize, CFOptionFlags hint, void *info);
-    static void _extendedDeallocate(void *ptr, void *info);
-    
-    
+
+    /// Prepend a header of the given length in front of the frame (or previously prepended headers).
+    /// Returns nullptr if the slot's header space is exhausted.
+    void *allocateBufferHeader(void *buffer, std::size_t length);
+
+    /// Get the start and total length of the headers plus frame.
+    void retrieveFullBufferPointer(void *buffer, void **bufferPtr, std::size_t *length) const;
+
+    /// Add a reference to the slot holding this buffer.
+    void retainBuffer(void *buffer);
+
+    /// Drop a reference to the slot holding this buffer, freeing it on the last reference.
+    /// Pointers not owned by this allocator are ignored.
+    void releaseBuffer(void *buffer);
+
+    /// True if this pointer is a frame buffer from this allocator.
+    bool owns(const void *buffer) const;
+
+    std::size_t slotSize() const { return _slotSize; }
+    Stats stats() const;
+
 private:
-    std::size_t getAvailHdrSize();
-
-    std::size_t preAllocateSize;
-    std::size_t preAllocateHdrSize;
-    std::uint8_t *preAllocatedBuffer;
-    
-    std::uint8_t *frameBufferPtr;
-    std::size_t frameBufferSize;
-    
-    std::uint8_t *firstHeaderPtr;
+    static constexpr std::uint32_t kNoSlot = UINT32_MAX;
+
+    struct Slot {
+        std::atomic<std::uint32_t> refs{ 0 };
+        std::atomic<std::uint32_t> next{ kNoSlot };
+        std::size_t frameSize = 0;
+        std::size_t hdrUsed = 0;
+    };
+
+    std::uint8_t *frameAt(std::uint32_t index) const;
+    std::uint32_t indexOf(const void *buffer) const;
+    std::uint32_t pop();
+    void push(std::uint32_t index);
+
+    const std::size_t _slotSize;
+    const std::size_t _hdrSize;
+    const std::size_t _slots;
+    const std::size_t _stride;
+    std::unique_ptr<std::uint8_t[]> _slab;
+    std::unique_ptr<Slot[]> _meta;
+
+    // Tagged free list head: upper 32 bits are an ABA tag, lower 32 bits the slot index.
+    std::atomic<std::uint64_t> _freeHead;
+    std::atomic<std::size_t> _inUse{ 0 };
+    std::atomic<std::size_t> _highWaterMark{ 0 };
+    std::atomic<std::uint64_t> _allocations{ 0 };
+    std::atomic<std::uint64_t> _failures{ 0 };
 };
 
 #endif /* ExtBufferAllocator_h */
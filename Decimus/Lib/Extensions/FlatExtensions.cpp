@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "FlatExtensions.hh"
+
+#include <limits>
+
+namespace {
+template<typename T>
+T load(const std::uint8_t* ptr)
+{
+    T value = 0;
+    for (std::size_t byte = 0; byte < sizeof(T); byte++) {
+        value |= static_cast<T>(ptr[byte]) << (8 * byte);
+    }
+    return value;
+}
+
+template<typename T>
+void store(std::uint8_t* ptr, T value)
+{
+    for (std::size_t byte = 0; byte < sizeof(T); byte++) {
+        ptr[byte] = static_cast<std::uint8_t>(value >> (8 * byte));
+    }
+}
+
+std::size_t valuesStart(std::size_t count)
+{
+    return kFlatExtensionsHeaderSize + count * kFlatExtensionsEntrySize;
+}
+}
+
+// FlatExtensionsWriter.
+
+FlatExtensionsWriter::FlatExtensionsWriter(std::vector<std::uint8_t>& buffer, std::size_t entries, std::size_t valueBytes)
+    : _buffer(buffer), _reserved(entries)
+{
+    _buffer.clear();
+    _buffer.reserve(valuesStart(entries) + valueBytes);
+    _buffer.resize(valuesStart(entries));
+}
+
+bool FlatExtensionsWriter::Add(std::uint64_t key, const std::uint8_t* data, std::size_t length)
+{
+    const std::size_t offset = _buffer.size() - valuesStart(_reserved);
+    if (_added == _reserved ||
+        length > std::numeric_limits<std::uint32_t>::max() ||
+        offset > std::numeric_limits<std::uint32_t>::max() - length) {
+        return false;
+    }
+    auto* entry = _buffer.data() + kFlatExtensionsHeaderSize + _added * kFlatExtensionsEntrySize;
+    store<std::uint64_t>(entry, key);
+    store<std::uint32_t>(entry + 8, static_cast<std::uint32_t>(offset));
+    store<std::uint32_t>(entry + 12, static_cast<std::uint32_t>(length));
+    if (length > 0) {
+        _buffer.insert(_buffer.end(), data, data + length);
+    }
+    _added++;
+    return true;
+}
+
+void FlatExtensionsWriter::Finish()
+{
+    if (_added < _reserved) {
+        // Offsets are relative to the values, so dropping unused index entries needs no fixups.
+        auto unused = _buffer.begin() + static_cast<std::ptrdiff_t>(valuesStart(_added));
+        _buffer.erase(unused, unused + static_cast<std::ptrdiff_t>((_reserved - _added) * kFlatExtensionsEntrySize));
+        _reserved = _added;
+    }
+    store<std::uint32_t>(_buffer.data(), static_cast<std::uint32_t>(_added));
+    store<std::uint32_t>(_buffer.data() + 4, 0);
+}
+
+// FlatExtensionsView.
+
+bool FlatExtensionsView::Validate(const std::uint8_t* data, std::size_t length)
+{
+    if (data == nullptr || length < kFlatExtensionsHeaderSize) {
+        return false;
+    }
+    const std::size_t count = load<std::uint32_t>(data);
+    if (count > (length - kFlatExtensionsHeaderSize) / kFlatExtensionsEntrySize) {
+        return false;
+    }
+    const std::size_t valueBytes = length - valuesStart(count);
+    for (std::size_t index = 0; index < count; index++) {
+        const auto* entry = data + kFlatExtensionsHeaderSize + index * kFlatExtensionsEntrySize;
+        const std::size_t offset = load<std::uint32_t>(entry + 8);
+        const std::size_t size = load<std::uint32_t>(entry + 12);
+        if (offset > valueBytes || size > valueBytes - offset) {
+            return false;
+        }
+    }
+    return true;
+}
+
+FlatExtensionsView::FlatExtensionsView(const std::uint8_t* data, std::size_t length)
+{
+    if (Validate(data, length)) {
+        _data = data;
+        _count = load<std::uint32_t>(data);
+    }
+}
+
+FlatExtension FlatExtensionsView::At(std::size_t index) const
+{
+    if (index >= _count) {
+        return FlatExtension { 0, nullptr, 0 };
+    }
+    const auto* entry = _data + kFlatExtensionsHeaderSize + index * kFlatExtensionsEntrySize;
+    return FlatExtension {
+        load<std::uint64_t>(entry),
+        _data + valuesStart(_count) + load<std::uint32_t>(entry + 8),
+        load<std::uint32_t>(entry + 12),
+    };
+}
+
+bool FlatExtensionsView::Find(std::uint64_t key, FlatExtension& out, std::size_t nth) const
+{
+    for (std::size_t index = 0; index < _count; index++) {
+        const auto* entry = _data + kFlatExtensionsHeaderSize + index * kFlatExtensionsEntrySize;
+        if (load<std::uint64_t>(entry) != key) {
+            continue;
+        }
+        if (nth-- == 0) {
+            out = At(index);
+            return true;
+        }
+    }
+    return false;
+}
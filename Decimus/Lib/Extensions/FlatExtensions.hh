@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef FlatExtensions_hh
+#define FlatExtensions_hh
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Flat header extension encoding, shared by the bridge and Swift's HeaderExtensions.
+ *
+ *   +-------------+-------------+------------------------------+------------------+
+ *   | u32 count   | u32 reserved| count x { u64 key,           | value bytes ...  |
+ *   |             |             |           u32 offset,        |                  |
+ *   |             |             |           u32 length }       |                  |
+ *   +-------------+-------------+------------------------------+------------------+
+ *   0             4             8                               8 + 16 * count
+ *
+ * All fields are little endian. Offsets are relative to the start of the value bytes.
+ * Keys may repeat; repeated keys hold multiple values in insertion order.
+ * The whole set is one contiguous buffer, so it crosses the bridge as a single NSData
+ * and values are read in place without per-key allocations.
+ */
+struct FlatExtension
+{
+    std::uint64_t key;
+    const std::uint8_t* data;
+    std::size_t length;
+};
+
+constexpr std::size_t kFlatExtensionsHeaderSize = 8;
+constexpr std::size_t kFlatExtensionsEntrySize = 16;
+
+/// Encodes a fixed number of entries into a caller owned buffer, reusing its capacity.
+class FlatExtensionsWriter
+{
+public:
+    /// Reset the buffer and reserve the index for the given number of entries.
+    FlatExtensionsWriter(std::vector<std::uint8_t>& buffer, std::size_t entries, std::size_t valueBytes = 0);
+
+    /// Append a value. Returns false if every reserved entry has been used or the value is too large.
+    bool Add(std::uint64_t key, const std::uint8_t* data, std::size_t length);
+
+    /// Finalize the buffer. Unused reserved entries are compacted away.
+    void Finish();
+
+private:
+    std::vector<std::uint8_t>& _buffer;
+    std::size_t _reserved;
+    std::size_t _added = 0;
+};
+
+/// Read only, bounds checked view over an encoded buffer.
+class FlatExtensionsView
+{
+public:
+    FlatExtensionsView() = default;
+
+    /// View the given bytes. If they aren't a valid encoding, the view is invalid and empty.
+    FlatExtensionsView(const std::uint8_t* data, std::size_t length);
+
+    /// True if the given bytes are a well formed encoding with every value in bounds.
+    static bool Validate(const std::uint8_t* data, std::size_t length);
+
+    bool Valid() const { return _data != nullptr; }
+    std::size_t Count() const { return _count; }
+    FlatExtension At(std::size_t index) const;
+
+    /// Find the nth value for a key. Returns false if not present.
+    bool Find(std::uint64_t key, FlatExtension& out, std::size_t nth = 0) const;
+
+private:
+    const std::uint8_t* _data = nullptr;
+    std::size_t _count = 0;
+};
+
+#endif /* FlatExtensions_hh */
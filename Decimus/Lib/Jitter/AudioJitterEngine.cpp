@@ -0,0 +1,340 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "AudioJitterEngine.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+std::size_t NextPowerOfTwo(std::size_t value)
+{
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+// Enough for the max depth, plus the slot being read and one of reordering headroom.
+std::size_t SlotCount(std::size_t maxElements, std::size_t packetElements)
+{
+    const std::size_t packets = packetElements == 0 ? 0 : (maxElements + packetElements - 1) / packetElements;
+    return NextPowerOfTwo(std::max<std::size_t>(packets + 2, 4));
+}
+
+std::size_t ToElements(std::chrono::milliseconds duration, std::uint32_t clockRate)
+{
+    return static_cast<std::size_t>(duration.count()) * clockRate / 1000;
+}
+}
+
+AudioJitterEngine::AudioJitterEngine(std::size_t elementSize,
+                                     std::size_t packetElements,
+                                     std::uint32_t clockRate,
+                                     std::chrono::milliseconds maxLength,
+                                     std::chrono::milliseconds minLength)
+    : _elementSize(elementSize),
+      _packetElements(packetElements),
+      _clockRate(clockRate),
+      _maxElements(std::max(ToElements(maxLength, clockRate), packetElements)),
+      _minElements(std::min(ToElements(minLength, clockRate), _maxElements)),
+      _slots(SlotCount(_maxElements, packetElements)),
+      _mask(_slots - 1)
+{
+    if (elementSize == 0 || packetElements == 0 || clockRate == 0) {
+        throw std::invalid_argument("Element size, packet elements and clock rate must be non-zero");
+    }
+    _slotArray = std::make_unique<Slot[]>(_slots);
+    _storage = std::make_unique<std::uint8_t[]>(_slots * _packetElements * _elementSize);
+    _concealment = std::make_unique<AudioJitterPacket[]>(_slots);
+}
+
+// Producer.
+
+std::uint64_t AudioJitterEngine::Head() const
+{
+    return std::max(_readSequence.load(std::memory_order_acquire), _skipTo.load(std::memory_order_relaxed));
+}
+
+std::size_t AudioJitterEngine::Prepare(std::uint64_t sequenceNumber, ConcealmentCallback concealment, void* userData)
+{
+    if (!_started || sequenceNumber >= Head() + _slots) {
+        // Nothing to conceal against, or a discontinuity that Enqueue will resolve.
+        return 0;
+    }
+    return Conceal(sequenceNumber, concealment, userData);
+}
+
+std::size_t AudioJitterEngine::Enqueue(const AudioJitterPacket* packets,
+                                       std::size_t count,
+                                       ConcealmentCallback concealment,
+                                       void* userData)
+{
+    std::size_t enqueued = 0;
+    for (std::size_t index = 0; index < count; index++) {
+        const auto& packet = packets[index];
+        const std::uint64_t sequence = packet.sequence_number;
+        if (packet.data == nullptr ||
+            packet.elements == 0 ||
+            packet.elements > _packetElements ||
+            packet.length < packet.elements * _elementSize) {
+            _droppedFrames.fetch_add(packet.elements, std::memory_order_relaxed);
+            continue;
+        }
+
+        if (!_started) {
+            _started = true;
+            _skipTo.store(sequence, std::memory_order_release);
+            _writeSequence.store(sequence, std::memory_order_release);
+        }
+
+        const auto head = Head();
+        if (sequence < head) {
+            // Already played out, whether real or concealed.
+            _updateMissedFrames.fetch_add(packet.elements, std::memory_order_relaxed);
+            continue;
+        }
+        if (sequence >= head + _slots) {
+            Jump(head, sequence);
+        }
+
+        if (sequence < _writeSequence.load(std::memory_order_relaxed)) {
+            enqueued += Update(packet);
+            continue;
+        }
+        Conceal(sequence, concealment, userData);
+        enqueued += Write(packet);
+        _writeSequence.store(sequence + 1, std::memory_order_release);
+    }
+    return enqueued;
+}
+
+std::size_t AudioJitterEngine::Conceal(std::uint64_t until, ConcealmentCallback concealment, void* userData)
+{
+    const auto from = _writeSequence.load(std::memory_order_relaxed);
+    if (until <= from) {
+        return 0;
+    }
+
+    const std::size_t length = _packetElements * _elementSize;
+    std::size_t count = 0;
+    for (auto sequence = from; sequence < until; sequence++) {
+        if ((SlotFor(sequence).tag.load(std::memory_order_acquire) & 3) != kEmpty) {
+            // Still held by the consumer after a discontinuity. Leave a hole, which the consumer steps over.
+            continue;
+        }
+        _concealment[count++] = AudioJitterPacket { static_cast<unsigned long>(sequence),
+                                                    DataFor(sequence),
+                                                    length,
+                                                    _packetElements };
+    }
+
+    if (concealment != nullptr) {
+        concealment(_concealment.get(), count, userData);
+    } else {
+        for (std::size_t index = 0; index < count; index++) {
+            std::memset(_concealment[index].data, 0, length);
+        }
+    }
+
+    for (std::size_t index = 0; index < count; index++) {
+        const std::uint64_t sequence = _concealment[index].sequence_number;
+        auto& slot = SlotFor(sequence);
+        slot.elements = _packetElements;
+        _buffered.fetch_add(_packetElements, std::memory_order_relaxed);
+        slot.tag.store(Tag(sequence, kConcealed), std::memory_order_release);
+    }
+    _writeSequence.store(until, std::memory_order_release);
+
+    _filledPackets.fetch_add(count, std::memory_order_relaxed);
+    _concealedFrames.fetch_add(count * _packetElements, std::memory_order_relaxed);
+    return count * _packetElements;
+}
+
+std::size_t AudioJitterEngine::Write(const AudioJitterPacket& packet)
+{
+    const std::uint64_t sequence = packet.sequence_number;
+    auto& slot = SlotFor(sequence);
+    if ((slot.tag.load(std::memory_order_acquire) & 3) != kEmpty) {
+        _droppedFrames.fetch_add(packet.elements, std::memory_order_relaxed);
+        return 0;
+    }
+    std::memcpy(DataFor(sequence), packet.data, packet.elements * _elementSize);
+    slot.elements = packet.elements;
+    _buffered.fetch_add(packet.elements, std::memory_order_relaxed);
+    slot.tag.store(Tag(sequence, kFilled), std::memory_order_release);
+    return packet.elements;
+}
+
+std::size_t AudioJitterEngine::Update(const AudioJitterPacket& packet)
+{
+    const std::uint64_t sequence = packet.sequence_number;
+    auto& slot = SlotFor(sequence);
+    auto expected = Tag(sequence, kConcealed);
+    if (!slot.tag.compare_exchange_strong(expected,
+                                          Tag(sequence, kBusy),
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_acquire)) {
+        if (expected == Tag(sequence, kFilled)) {
+            // Duplicate.
+            _droppedFrames.fetch_add(packet.elements, std::memory_order_relaxed);
+        } else {
+            // The consumer got to the concealed data first.
+            _updateMissedFrames.fetch_add(packet.elements, std::memory_order_relaxed);
+        }
+        return 0;
+    }
+
+    std::memcpy(DataFor(sequence), packet.data, packet.elements * _elementSize);
+    if (packet.elements > slot.elements) {
+        _buffered.fetch_add(packet.elements - slot.elements, std::memory_order_relaxed);
+    } else {
+        _buffered.fetch_sub(slot.elements - packet.elements, std::memory_order_relaxed);
+    }
+    slot.elements = packet.elements;
+    slot.tag.store(Tag(sequence, kFilled), std::memory_order_release);
+    _updatedFrames.fetch_add(packet.elements, std::memory_order_relaxed);
+    return packet.elements;
+}
+
+void AudioJitterEngine::Jump(std::uint64_t head, std::uint64_t sequence)
+{
+    // Too far ahead to fit. Discard everything the consumer hasn't started on and resume from here.
+    const auto write = _writeSequence.load(std::memory_order_relaxed);
+    for (auto discard = head; discard < write; discard++) {
+        auto& slot = SlotFor(discard);
+        auto expected = slot.tag.load(std::memory_order_acquire);
+        const auto state = expected & 3;
+        if ((expected >> 2) != discard || (state != kFilled && state != kConcealed)) {
+            continue;
+        }
+        if (slot.tag.compare_exchange_strong(expected, 0, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            _buffered.fetch_sub(slot.elements, std::memory_order_relaxed);
+            _skippedFrames.fetch_add(slot.elements, std::memory_order_relaxed);
+        }
+    }
+    _skipTo.store(sequence, std::memory_order_release);
+    _writeSequence.store(sequence, std::memory_order_release);
+}
+
+// Consumer.
+
+bool AudioJitterEngine::ClaimHead()
+{
+    // Each pass either claims, gives up, or moves the head forward, so this is bounded.
+    for (std::size_t attempt = 0; attempt <= _slots + 1; attempt++) {
+        const auto sequence = _readSequence.load(std::memory_order_relaxed);
+        const auto skipTo = _skipTo.load(std::memory_order_acquire);
+        const auto write = _writeSequence.load(std::memory_order_acquire);
+        auto& slot = SlotFor(sequence);
+        auto tag = slot.tag.load(std::memory_order_acquire);
+        if ((tag >> 2) == sequence) {
+            const auto state = tag & 3;
+            if (state == kBusy) {
+                // The producer is replacing concealment. Don't wait for it.
+                return false;
+            }
+            if (state == kFilled || state == kConcealed) {
+                if (slot.tag.compare_exchange_strong(tag,
+                                                     Tag(sequence, kBusy),
+                                                     std::memory_order_acq_rel,
+                                                     std::memory_order_acquire)) {
+                    _claimed = true;
+                    _readOffset = 0;
+                    return true;
+                }
+                continue;
+            }
+        }
+
+        if (skipTo > sequence) {
+            _readSequence.store(skipTo, std::memory_order_release);
+        } else if (sequence < write) {
+            // Written past but not stored: step over the hole.
+            _readSequence.store(sequence + 1, std::memory_order_release);
+        } else {
+            return false;
+        }
+    }
+    return false;
+}
+
+void AudioJitterEngine::ReleaseHead()
+{
+    const auto sequence = _readSequence.load(std::memory_order_relaxed);
+    SlotFor(sequence).tag.store(0, std::memory_order_release);
+    _readSequence.store(sequence + 1, std::memory_order_release);
+    _claimed = false;
+    _readOffset = 0;
+}
+
+std::size_t AudioJitterEngine::Dequeue(std::uint8_t* destination, std::size_t destinationLength, std::size_t elements)
+{
+    if (destination == nullptr) {
+        return 0;
+    }
+    elements = std::min(elements, destinationLength / _elementSize);
+
+    if (!_playing) {
+        const auto buffered = _buffered.load(std::memory_order_relaxed);
+        if (buffered == 0 || buffered < _minElements) {
+            return 0;
+        }
+        _playing = true;
+    }
+
+    // Skip old audio to get back under the max depth.
+    while (!_claimed && _buffered.load(std::memory_order_relaxed) > _maxElements && ClaimHead()) {
+        const auto skipped = SlotFor(_readSequence.load(std::memory_order_relaxed)).elements;
+        _buffered.fetch_sub(skipped, std::memory_order_relaxed);
+        _skippedFrames.fetch_add(skipped, std::memory_order_relaxed);
+        ReleaseHead();
+    }
+
+    std::size_t copied = 0;
+    while (copied < elements) {
+        if (!_claimed && !ClaimHead()) {
+            break;
+        }
+        const auto sequence = _readSequence.load(std::memory_order_relaxed);
+        const auto& slot = SlotFor(sequence);
+        const auto toCopy = std::min(slot.elements - _readOffset, elements - copied);
+        std::memcpy(destination + copied * _elementSize,
+                    DataFor(sequence) + _readOffset * _elementSize,
+                    toCopy * _elementSize);
+        copied += toCopy;
+        _readOffset += toCopy;
+        _buffered.fetch_sub(toCopy, std::memory_order_relaxed);
+        if (_readOffset == slot.elements) {
+            ReleaseHead();
+        }
+    }
+
+    if (copied < elements && _buffered.load(std::memory_order_relaxed) == 0) {
+        // Ran dry, so build back up to the minimum before playing again.
+        _playing = false;
+    }
+    return copied;
+}
+
+// Any thread.
+
+AudioJitterEngine::Metrics AudioJitterEngine::GetMetrics() const
+{
+    return Metrics {
+        _concealedFrames.load(std::memory_order_relaxed),
+        _skippedFrames.load(std::memory_order_relaxed),
+        _filledPackets.load(std::memory_order_relaxed),
+        _updatedFrames.load(std::memory_order_relaxed),
+        _updateMissedFrames.load(std::memory_order_relaxed),
+        _droppedFrames.load(std::memory_order_relaxed),
+    };
+}
+
+std::chrono::milliseconds AudioJitterEngine::GetCurrentDepth() const
+{
+    const auto buffered = _buffered.load(std::memory_order_relaxed);
+    return std::chrono::milliseconds(buffered * 1000 / _clockRate);
+}
@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef AudioJitterEngine_hh
+#define AudioJitterEngine_hh
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/// A packet of audio elements, layout compatible with libjitter's `Packet`.
+struct AudioJitterPacket
+{
+    unsigned long sequence_number;
+    void* data;
+    std::size_t length;
+    std::size_t elements;
+};
+
+/// Single producer, single consumer audio jitter buffer.
+///
+/// Packets are stored in a fixed array of slots indexed by `sequence % slots`, so inserting out of order
+/// packets and finding the head are both O(1). The producer (network thread) owns `Prepare` and `Enqueue`,
+/// which fill gaps with concealment and overwrite concealed slots if the real packet turns up in time.
+/// The consumer (render thread) owns `Dequeue`, which never blocks, never waits on the producer and never
+/// allocates: a slot the producer is busy updating is treated as not yet available.
+///
+/// All storage, including the packet array handed to the concealment callback, is allocated up front.
+/// Metrics and depth may be read from any thread.
+class AudioJitterEngine
+{
+public:
+    using ConcealmentCallback = void (*)(AudioJitterPacket* packets, std::size_t count, void* userData);
+
+    struct Metrics
+    {
+        std::size_t concealedFrames;
+        std::size_t skippedFrames;
+        std::size_t filledPackets;
+        std::size_t updatedFrames;
+        std::size_t updateMissedFrames;
+        std::size_t droppedFrames;
+    };
+
+    /// - Parameter elementSize: Bytes per element (frame).
+    /// - Parameter packetElements: Elements in a nominal packet. Packets larger than this are dropped.
+    /// - Parameter clockRate: Elements per second.
+    /// - Parameter maxLength: Depth above which the consumer skips old audio.
+    /// - Parameter minLength: Depth to buffer before starting (or restarting after an underrun) playout.
+    AudioJitterEngine(std::size_t elementSize,
+                      std::size_t packetElements,
+                      std::uint32_t clockRate,
+                      std::chrono::milliseconds maxLength,
+                      std::chrono::milliseconds minLength);
+
+    AudioJitterEngine(const AudioJitterEngine&) = delete;
+    AudioJitterEngine& operator=(const AudioJitterEngine&) = delete;
+
+    /// Producer. Conceal any gap before the given sequence number, ahead of decoding it.
+    /// - Returns: Number of concealed elements.
+    std::size_t Prepare(std::uint64_t sequenceNumber, ConcealmentCallback concealment, void* userData);
+
+    /// Producer. Copy packets in, concealing any gap before them.
+    /// - Returns: Number of elements enqueued from the given packets, excluding concealment.
+    std::size_t Enqueue(const AudioJitterPacket* packets,
+                        std::size_t count,
+                        ConcealmentCallback concealment,
+                        void* userData);
+
+    /// Consumer. Copy up to the given number of elements out. Wait-free.
+    /// - Returns: Number of elements copied.
+    std::size_t Dequeue(std::uint8_t* destination, std::size_t destinationLength, std::size_t elements);
+
+    Metrics GetMetrics() const;
+    std::chrono::milliseconds GetCurrentDepth() const;
+    std::size_t SlotElements() const { return _packetElements; }
+    std::size_t Slots() const { return _slots; }
+
+private:
+    enum State : std::uint64_t
+    {
+        kEmpty = 0,
+        kFilled = 1,
+        kConcealed = 2,
+        kBusy = 3,
+    };
+
+    struct Slot
+    {
+        // Sequence number and state, packed as (sequence << 2 | state).
+        std::atomic<std::uint64_t> tag{ 0 };
+        std::size_t elements = 0;
+    };
+
+    static std::uint64_t Tag(std::uint64_t sequence, State state) { return (sequence << 2) | state; }
+    Slot& SlotFor(std::uint64_t sequence) const { return _slotArray[sequence & _mask]; }
+    std::uint8_t* DataFor(std::uint64_t sequence) const
+    {
+        return _storage.get() + (sequence & _mask) * _packetElements * _elementSize;
+    }
+
+    // Producer.
+    std::uint64_t Head() const;
+    std::size_t Conceal(std::uint64_t until, ConcealmentCallback concealment, void* userData);
+    std::size_t Write(const AudioJitterPacket& packet);
+    std::size_t Update(const AudioJitterPacket& packet);
+    void Jump(std::uint64_t head, std::uint64_t sequence);
+
+    // Consumer.
+    bool ClaimHead();
+    void ReleaseHead();
+
+    const std::size_t _elementSize;
+    const std::size_t _packetElements;
+    const std::uint32_t _clockRate;
+    const std::size_t _maxElements;
+    const std::size_t _minElements;
+    const std::size_t _slots;
+    const std::uint64_t _mask;
+    std::unique_ptr<Slot[]> _slotArray;
+    std::unique_ptr<std::uint8_t[]> _storage;
+    std::unique_ptr<AudioJitterPacket[]> _concealment;
+
+    // Producer state. The next sequence to write, and where the consumer should resume after a discontinuity.
+    bool _started = false;
+    alignas(64) std::atomic<std::uint64_t> _writeSequence{ 0 };
+    std::atomic<std::uint64_t> _skipTo{ 0 };
+
+    // Consumer state.
+    alignas(64) std::atomic<std::uint64_t> _readSequence{ 0 };
+    std::size_t _readOffset = 0;
+    bool _claimed = false;
+    bool _playing = false;
+
+    // Shared.
+    alignas(64) std::atomic<std::size_t> _buffered{ 0 };
+    std::atomic<std::size_t> _concealedFrames{ 0 };
+    std::atomic<std::size_t> _skippedFrames{ 0 };
+    std::atomic<std::size_t> _filledPackets{ 0 };
+    std::atomic<std::size_t> _updatedFrames{ 0 };
+    std::atomic<std::size_t> _updateMissedFrames{ 0 };
+    std::atomic<std::size_t> _droppedFrames{ 0 };
+};
+
+#endif /* AudioJitterEngine_hh */
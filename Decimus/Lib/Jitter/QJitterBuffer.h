@@ -10,19 +10,24 @@
 #include "Metrics.h"
 #ifdef __cplusplus
 #include <memory>
-#include "JitterBuffer.hh"
+#include "AudioJitterEngine.hh"
 #endif
 
 typedef void(*PacketCallback)(struct Packet*, size_t, void*);
 typedef void(*CantinaLogCallback)(uint8_t, NSString*, bool);
 
+/// Audio jitter buffer backed by `AudioJitterEngine`.
+/// Enqueue and prepare must be called from a single producer thread, and dequeue from a single
+/// consumer (render) thread. Dequeue never blocks or allocates. Nothing is logged from the audio
+/// path, so the log callback only reports a failure to create the buffer.
 @interface QJitterBuffer : NSObject {
 #ifdef __cplusplus
-    std::unique_ptr<JitterBuffer> jitterBuffer;
+    std::unique_ptr<AudioJitterEngine> jitterBuffer;
 #endif
 }
 
--(instancetype) initElementSize:(size_t)element_size
+/// - Returns: nil if the sizes are invalid, such as a zero element size, packet size or clock rate.
+-(nullable instancetype) initElementSize:(size_t)element_size
                     packetElements:(size_t)packet_elements
                     clockRate:(unsigned long)clock_rate
                     maxLengthMs:(unsigned long)max_length_ms
@@ -4,12 +4,30 @@
 #import <Foundation/Foundation.h>
 #import "QJitterBuffer.h"
 
-#import <Foundation/Foundation.h>
-
-#include <stdlib.h>
+#include <cstddef>
+#include <stdexcept>
 
 #include "Packet.h"
-#include "JitterBuffer.hh"
+#include "AudioJitterEngine.hh"
+
+// The engine hands its preallocated packet array straight to the concealment callback.
+static_assert(sizeof(Packet) == sizeof(AudioJitterPacket), "Packet layout mismatch");
+static_assert(offsetof(Packet, sequence_number) == offsetof(AudioJitterPacket, sequence_number), "Packet layout mismatch");
+static_assert(offsetof(Packet, data) == offsetof(AudioJitterPacket, data), "Packet layout mismatch");
+static_assert(offsetof(Packet, length) == offsetof(AudioJitterPacket, length), "Packet layout mismatch");
+static_assert(offsetof(Packet, elements) == offsetof(AudioJitterPacket, elements), "Packet layout mismatch");
+
+struct Concealment
+{
+    PacketCallback callback;
+    void* userData;
+};
+
+static void conceal(AudioJitterPacket* packets, std::size_t count, void* userData)
+{
+    const auto* concealment = static_cast<const Concealment*>(userData);
+    concealment->callback(reinterpret_cast<Packet*>(packets), count, concealment->userData);
+}
 
 @implementation QJitterBuffer
 -(id)initElementSize: (size_t)elementSize
@@ -22,17 +40,23 @@
     self = [super init];
     if (self)
     {
-        jitterBuffer = std::make_unique<JitterBuffer>(
-            elementSize,
-            packet_elements,
-            clock_rate,
-            std::chrono::milliseconds{max_length_ms},
-            std::chrono::milliseconds{min_length_ms},
-            std::make_shared<cantina::CustomLogger>([=](auto level, const std::string& msg, bool b) {
-              NSString* m = [NSString stringWithCString:msg.c_str() encoding:[NSString defaultCStringEncoding]];
-              logCallback(static_cast<uint8_t>(level), m, b);
-            })
-        );
+        try
+        {
+            jitterBuffer = std::make_unique<AudioJitterEngine>(
+                elementSize,
+                packet_elements,
+                static_cast<std::uint32_t>(clock_rate),
+                std::chrono::milliseconds{max_length_ms},
+                std::chrono::milliseconds{min_length_ms}
+            );
+        }
+        catch (const std::exception& e)
+        {
+            if (logCallback) {
+                logCallback(0, [NSString stringWithUTF8String:e.what()], false);
+            }
+            return nil;
+        }
     }
     return self;
 }
@@ -42,32 +66,15 @@
                  userData: (void*)user_data
 {
     if (!jitterBuffer) return 0;
-    try
-    {
-        return jitterBuffer->Prepare((const std::uint32_t)sequence_number,
-                                     [&](std::vector<Packet>& p) { return concealment_callback(p.data(), p.size(), user_data); });
-    }
-    catch(...)
-    {
-        return 0;
-    }
+    Concealment concealment { concealment_callback, user_data };
+    return jitterBuffer->Prepare(sequence_number, concealment_callback ? conceal : nullptr, &concealment);
 }
 
 -(size_t)enqueuePacket:(Packet)packet
                 concealmentCallback:(PacketCallback)concealment_callback
                 userData:(void*)user_data
 {
-    if (!jitterBuffer) return 0;
-
-    try
-    {
-        return jitterBuffer->Enqueue({1, packet},
-                                     [&](std::vector<Packet>& p) { return concealment_callback(p.data(), p.size(), user_data); });
-    }
-    catch(...)
-    {
-        return 0;
-    }
+    return [self enqueuePackets:&packet size:1 concealmentCallback:concealment_callback userData:user_data];
 }
 
 -(size_t)enqueuePackets:(Packet[])packets
@@ -76,16 +83,11 @@
                 userData:(void*)user_data
 {
     if (!jitterBuffer) return 0;
-
-    try
-    {
-        return jitterBuffer->Enqueue({packets, packets + size},
-                                     [&](std::vector<Packet>& p) { return concealment_callback(p.data(), p.size(), user_data); });
-    }
-    catch(...)
-    {
-        return 0;
-    }
+    Concealment concealment { concealment_callback, user_data };
+    return jitterBuffer->Enqueue(reinterpret_cast<const AudioJitterPacket*>(packets),
+                                 size,
+                                 concealment_callback ? conceal : nullptr,
+                                 &concealment);
 }
 
 -(size_t)dequeue:(uint8_t*)destination
@@ -93,25 +95,25 @@
                 elements:(size_t)elements
 {
     if (!jitterBuffer) return 0;
-
-    try
-    {
-        return jitterBuffer->Dequeue(destination, destination_length, elements);
-    }
-    catch(...)
-    {
-        return 0;
-    }
+    return jitterBuffer->Dequeue(destination, destination_length, elements);
 }
 
 -(Metrics)getMetrics
 {
-    // if (!jitterBuffer) return 0;
-    return jitterBuffer->GetMetrics();
+    Metrics metrics {};
+    if (!jitterBuffer) return metrics;
+    const auto engine = jitterBuffer->GetMetrics();
+    metrics.concealed_frames = engine.concealedFrames;
+    metrics.skipped_frames = engine.skippedFrames;
+    metrics.filled_packets = engine.filledPackets;
+    metrics.updated_frames = engine.updatedFrames;
+    metrics.update_missed_frames = engine.updateMissedFrames;
+    return metrics;
 }
 
 -(size_t)getCurrentDepth
 {
+    if (!jitterBuffer) return 0;
     return jitterBuffer->GetCurrentDepth().count();
 }
 @end
@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef QSequenceRing_h
+#define QSequenceRing_h
+
+#import <Foundation/Foundation.h>
+
+#ifdef __cplusplus
+#include <memory>
+#include <vector>
+#include "SequenceRing.hh"
+#endif
+
+typedef NS_ENUM(uint8_t, QSequenceRingResult) {
+    kQSequenceRingResultInserted,
+    kQSequenceRingResultFull,
+    kQSequenceRingResultDuplicate,
+};
+
+/// Holds objects in sequence number order using `SequenceRing`.
+/// Not thread safe.
+@interface QSequenceRing : NSObject {
+#ifdef __cplusplus
+    std::unique_ptr<SequenceRing> ring;
+    std::vector<id> items;
+#endif
+}
+
+-(instancetype _Nonnull) initWithCapacity: (size_t) capacity;
+/// - Parameter durationUs: This item's contribution to the total duration, in microseconds.
+-(QSequenceRingResult) insert: (id _Nonnull) item sequence: (uint64_t) sequence durationUs: (int64_t) durationUs;
+-(id _Nullable) head;
+-(id _Nullable) popHead;
+-(void) clear;
+-(size_t) count;
+-(int64_t) durationUs;
+
+@end
+
+#endif /* QSequenceRing_h */
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#import <Foundation/Foundation.h>
+#import "QSequenceRing.h"
+
+@implementation QSequenceRing
+
+-(instancetype) initWithCapacity: (size_t) capacity {
+    self = [super init];
+    if (self) {
+        ring = std::make_unique<SequenceRing>(capacity);
+        items.resize(ring->Slots());
+    }
+    return self;
+}
+
+-(QSequenceRingResult) insert: (id) item sequence: (uint64_t) sequence durationUs: (int64_t) durationUs {
+    std::size_t slot = 0;
+    switch (ring->Insert(sequence, durationUs, slot)) {
+        case SequenceRing::InsertResult::Inserted:
+            items[slot] = item;
+            return kQSequenceRingResultInserted;
+        case SequenceRing::InsertResult::Full:
+            return kQSequenceRingResultFull;
+        case SequenceRing::InsertResult::Duplicate:
+            return kQSequenceRingResultDuplicate;
+    }
+    return kQSequenceRingResultFull;
+}
+
+-(id) head {
+    std::uint64_t sequence = 0;
+    std::size_t slot = 0;
+    return ring->Head(sequence, slot) ? items[slot] : nil;
+}
+
+-(id) popHead {
+    std::size_t slot = 0;
+    if (!ring->Pop(slot)) {
+        return nil;
+    }
+    id item = items[slot];
+    items[slot] = nil;
+    return item;
+}
+
+-(void) clear {
+    ring->Clear();
+    std::fill(items.begin(), items.end(), nil);
+}
+
+-(size_t) count {
+    return ring->Count();
+}
+
+-(int64_t) durationUs {
+    return ring->Duration();
+}
+
+@end
@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "SequenceRing.hh"
+
+#include <algorithm>
+
+namespace {
+std::size_t NextPowerOfTwo(std::size_t value)
+{
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+}
+
+SequenceRing::SequenceRing(std::size_t capacity)
+    : _capacity(std::max<std::size_t>(capacity, 1)),
+      _entries(NextPowerOfTwo(_capacity)),
+      _mask(_entries.size() - 1)
+{
+}
+
+SequenceRing::InsertResult SequenceRing::Insert(std::uint64_t sequence, std::int64_t duration, std::size_t& slot)
+{
+    if (_count > 0) {
+        if (_count == _capacity) {
+            return InsertResult::Full;
+        }
+        const auto head = std::min(_head, sequence);
+        const auto tail = std::max(_tail, sequence);
+        if (tail - head >= _entries.size()) {
+            return InsertResult::Full;
+        }
+    }
+
+    slot = SlotFor(sequence);
+    auto& entry = _entries[slot];
+    if (entry.present) {
+        // Within the window, so an occupied slot can only be this sequence.
+        return InsertResult::Duplicate;
+    }
+    entry = Entry { sequence, duration, true };
+
+    if (_count == 0) {
+        _head = sequence;
+        _tail = sequence;
+    } else {
+        _head = std::min(_head, sequence);
+        _tail = std::max(_tail, sequence);
+    }
+    _count++;
+    _duration += duration;
+    return InsertResult::Inserted;
+}
+
+bool SequenceRing::Head(std::uint64_t& sequence, std::size_t& slot) const
+{
+    if (_count == 0) {
+        return false;
+    }
+    sequence = _head;
+    slot = SlotFor(_head);
+    return true;
+}
+
+bool SequenceRing::Pop(std::size_t& slot)
+{
+    if (_count == 0) {
+        return false;
+    }
+    slot = SlotFor(_head);
+    auto& entry = _entries[slot];
+    _duration -= entry.duration;
+    entry.present = false;
+    _count--;
+
+    if (_count > 0) {
+        // Step over any gap. Every sequence is passed at most once, so this is amortized O(1).
+        do {
+            _head++;
+        } while (!_entries[SlotFor(_head)].present);
+    }
+    return true;
+}
+
+void SequenceRing::Clear()
+{
+    for (auto& entry : _entries) {
+        entry.present = false;
+    }
+    _count = 0;
+    _duration = 0;
+}
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef SequenceRing_hh
+#define SequenceRing_hh
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Reorder buffer index keyed by sequence number.
+///
+/// Entries live at `sequence % slots`, so inserting in any order and finding the oldest entry are O(1)
+/// (popping the head steps over any gap to the next entry, amortized O(1)). The total duration of
+/// held entries is maintained as they come and go rather than recomputed.
+///
+/// This only tracks sequence numbers, durations and slot positions; callers keep their own items in
+/// a parallel array indexed by the returned slot. Not thread safe.
+class SequenceRing
+{
+public:
+    enum class InsertResult
+    {
+        Inserted,
+        /// Already holding `capacity` entries, or the sequence is too far from those held to share the ring.
+        Full,
+        /// An entry with this sequence number is already held.
+        Duplicate,
+    };
+
+    explicit SequenceRing(std::size_t capacity);
+
+    InsertResult Insert(std::uint64_t sequence, std::int64_t duration, std::size_t& slot);
+
+    /// The oldest (lowest sequence) entry, if any.
+    bool Head(std::uint64_t& sequence, std::size_t& slot) const;
+
+    /// Remove the oldest entry, if any.
+    bool Pop(std::size_t& slot);
+
+    void Clear();
+
+    std::size_t Count() const { return _count; }
+    std::size_t Capacity() const { return _capacity; }
+    std::size_t Slots() const { return _entries.size(); }
+    std::int64_t Duration() const { return _duration; }
+
+private:
+    struct Entry
+    {
+        std::uint64_t sequence = 0;
+        std::int64_t duration = 0;
+        bool present = false;
+    };
+
+    std::size_t SlotFor(std::uint64_t sequence) const { return static_cast<std::size_t>(sequence & _mask); }
+
+    const std::size_t _capacity;
+    std::vector<Entry> _entries;
+    const std::uint64_t _mask;
+    std::size_t _count = 0;
+    std::int64_t _duration = 0;
+    std::uint64_t _head = 0;
+    std::uint64_t _tail = 0;
+};
+
+#endif /* SequenceRing_hh */
@@ -0,0 +1,228 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Histogram.hh"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+constexpr auto kEmptyMin = std::numeric_limits<std::int64_t>::max();
+constexpr auto kEmptyMax = std::numeric_limits<std::int64_t>::min();
+
+std::uint64_t Magnitude(std::int64_t value)
+{
+    // Well defined for INT64_MIN, unlike negation.
+    return value < 0 ? ~static_cast<std::uint64_t>(value) + 1 : static_cast<std::uint64_t>(value);
+}
+
+unsigned BitWidth(std::uint64_t value)
+{
+    return value == 0 ? 0 : 64 - static_cast<unsigned>(__builtin_clzll(value));
+}
+
+unsigned CheckedBits(std::int64_t lowest, std::int64_t highest, unsigned significantBits)
+{
+    if (lowest > 0 || highest < 0) {
+        throw std::invalid_argument("Histogram range must include 0");
+    }
+    if (significantBits < 2 || significantBits > 16) {
+        throw std::invalid_argument("Histogram significant bits must be between 2 and 16");
+    }
+    return significantBits;
+}
+}
+
+Histogram::Histogram(std::int64_t lowest, std::int64_t highest, unsigned significantBits)
+    : _lowest(lowest),
+      _highest(highest),
+      _significantBits(CheckedBits(lowest, highest, significantBits)),
+      _subBucketCount(std::uint64_t{ 1 } << significantBits),
+      _subBucketHalf(std::uint64_t{ 1 } << (significantBits - 1)),
+      _negativeBuckets(lowest < 0 ? MagnitudeIndex(Magnitude(lowest)) : 0),
+      _buckets(_negativeBuckets + MagnitudeIndex(static_cast<std::uint64_t>(highest)) + 1),
+      _counts(new std::atomic<std::uint64_t>[_buckets]),
+      _min(kEmptyMin),
+      _max(kEmptyMax)
+{
+    for (std::size_t index = 0; index < _buckets; ++index) {
+        _counts[index].store(0, std::memory_order_relaxed);
+    }
+}
+
+std::size_t Histogram::MagnitudeIndex(std::uint64_t magnitude) const
+{
+    if (magnitude < _subBucketCount) {
+        return static_cast<std::size_t>(magnitude);
+    }
+    const auto shift = BitWidth(magnitude) - _significantBits;
+    const auto top = magnitude >> shift;
+    return static_cast<std::size_t>(_subBucketCount + (shift - 1) * _subBucketHalf + (top - _subBucketHalf));
+}
+
+std::uint64_t Histogram::LowestMagnitude(std::size_t magnitudeIndex) const
+{
+    if (magnitudeIndex < _subBucketCount) {
+        return magnitudeIndex;
+    }
+    const auto offset = magnitudeIndex - _subBucketCount;
+    const auto shift = offset / _subBucketHalf + 1;
+    const auto top = _subBucketHalf + offset % _subBucketHalf;
+    return top << shift;
+}
+
+std::uint64_t Histogram::HighestMagnitude(std::size_t magnitudeIndex) const
+{
+    if (magnitudeIndex < _subBucketCount) {
+        return magnitudeIndex;
+    }
+    const auto shift = (magnitudeIndex - _subBucketCount) / _subBucketHalf + 1;
+    return LowestMagnitude(magnitudeIndex) + (std::uint64_t{ 1 } << shift) - 1;
+}
+
+std::size_t Histogram::IndexOf(std::int64_t value) const
+{
+    if (value < 0) {
+        return _negativeBuckets - MagnitudeIndex(Magnitude(value));
+    }
+    return _negativeBuckets + MagnitudeIndex(static_cast<std::uint64_t>(value));
+}
+
+std::int64_t Histogram::HighestEquivalent(std::size_t index) const
+{
+    if (index < _negativeBuckets) {
+        // The value in a negative bucket nearest zero.
+        return static_cast<std::int64_t>(~LowestMagnitude(_negativeBuckets - index) + 1);
+    }
+    return static_cast<std::int64_t>(HighestMagnitude(index - _negativeBuckets));
+}
+
+void Histogram::Record(std::int64_t value)
+{
+    UpdateMin(value);
+    UpdateMax(value);
+    // Counted before the bucket, so that a concurrent drain never takes more from a bucket than from the total.
+    _count.fetch_add(1, std::memory_order_relaxed);
+    const auto clamped = value < _lowest ? _lowest : value > _highest ? _highest : value;
+    _counts[IndexOf(clamped)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Histogram::UpdateMin(std::int64_t value)
+{
+    auto current = _min.load(std::memory_order_relaxed);
+    while (value < current && !_min.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+void Histogram::UpdateMax(std::int64_t value)
+{
+    auto current = _max.load(std::memory_order_relaxed);
+    while (value > current && !_max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+bool Histogram::SameLayout(const Histogram& other) const
+{
+    return _lowest == other._lowest && _highest == other._highest && _significantBits == other._significantBits;
+}
+
+bool Histogram::Merge(const Histogram& other)
+{
+    if (!SameLayout(other)) {
+        return false;
+    }
+    std::uint64_t merged = 0;
+    for (std::size_t index = 0; index < _buckets; ++index) {
+        const auto count = other._counts[index].load(std::memory_order_relaxed);
+        if (count != 0) {
+            _counts[index].fetch_add(count, std::memory_order_relaxed);
+            merged += count;
+        }
+    }
+    if (merged != 0) {
+        UpdateMin(other._min.load(std::memory_order_relaxed));
+        UpdateMax(other._max.load(std::memory_order_relaxed));
+        _count.fetch_add(merged, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool Histogram::DrainInto(Histogram& into)
+{
+    if (!SameLayout(into)) {
+        return false;
+    }
+    // A sample recorded while draining may be counted in one interval and its min or max in the other.
+    const auto min = _min.exchange(kEmptyMin, std::memory_order_relaxed);
+    const auto max = _max.exchange(kEmptyMax, std::memory_order_relaxed);
+    std::uint64_t drained = 0;
+    for (std::size_t index = 0; index < _buckets; ++index) {
+        const auto count = _counts[index].exchange(0, std::memory_order_relaxed);
+        if (count != 0) {
+            into._counts[index].fetch_add(count, std::memory_order_relaxed);
+            drained += count;
+        }
+    }
+    if (drained != 0) {
+        into.UpdateMin(min);
+        into.UpdateMax(max);
+        into._count.fetch_add(drained, std::memory_order_relaxed);
+    }
+    _count.fetch_sub(drained, std::memory_order_relaxed);
+    return true;
+}
+
+void Histogram::Reset()
+{
+    for (std::size_t index = 0; index < _buckets; ++index) {
+        _counts[index].store(0, std::memory_order_relaxed);
+    }
+    _count.store(0, std::memory_order_relaxed);
+    _min.store(kEmptyMin, std::memory_order_relaxed);
+    _max.store(kEmptyMax, std::memory_order_relaxed);
+}
+
+std::int64_t Histogram::Min() const
+{
+    const auto min = _min.load(std::memory_order_relaxed);
+    return min == kEmptyMin ? 0 : min;
+}
+
+std::int64_t Histogram::Max() const
+{
+    const auto max = _max.load(std::memory_order_relaxed);
+    return max == kEmptyMax ? 0 : max;
+}
+
+std::int64_t Histogram::ValueAtPercentile(double percentile) const
+{
+    std::uint64_t total = 0;
+    for (std::size_t index = 0; index < _buckets; ++index) {
+        total += _counts[index].load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    const auto clampedPercentile = std::isnan(percentile) ? 0.0 : std::fmin(std::fmax(percentile, 0.0), 100.0);
+    const auto rank = static_cast<std::uint64_t>(std::ceil(clampedPercentile / 100.0 * static_cast<double>(total)));
+    const auto target = rank == 0 ? 1 : rank > total ? total : rank;
+
+    const auto min = Min();
+    const auto max = Max();
+    std::uint64_t seen = 0;
+    for (std::size_t index = 0; index < _buckets; ++index) {
+        seen += _counts[index].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            const auto value = HighestEquivalent(index);
+            return value < min ? min : value > max ? max : value;
+        }
+    }
+    return max;
+}
+
+double Histogram::RelativeError() const
+{
+    return std::ldexp(1.0, -static_cast<int>(_significantBits - 1));
+}
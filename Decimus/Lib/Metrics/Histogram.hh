@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef Histogram_hh
+#define Histogram_hh
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/// Log linear (HDR style) histogram of integer values.
+///
+/// Magnitudes below 2^significantBits each get their own bucket. Above that, every power of two range is
+/// split into 2^(significantBits - 1) equal buckets, so a reported value is never more than
+/// 2^-(significantBits - 1) larger in magnitude than the true one. Negative values are tracked by magnitude in
+/// a mirrored set of buckets.
+///
+/// Recording is lock free, thread safe and never allocates. Histograms with the same layout can be merged.
+class Histogram
+{
+public:
+    /// - Parameter lowest: Smallest value tracked. Smaller values are counted as this. 0 or below.
+    /// - Parameter highest: Largest value tracked. Larger values are counted as this. 0 or above.
+    /// - Parameter significantBits: Precision, between 2 and 16.
+    /// - Throws std::invalid_argument: If the range or precision are out of bounds.
+    Histogram(std::int64_t lowest, std::int64_t highest, unsigned significantBits);
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    void Record(std::int64_t value);
+
+    /// Add another histogram's counts to this one.
+    /// - Returns: False, changing nothing, if the layouts differ.
+    bool Merge(const Histogram& other);
+
+    /// Move every count into `into`, leaving this histogram empty.
+    /// Safe to call while other threads record: each sample ends up in exactly one of the two.
+    /// - Returns: False, changing nothing, if the layouts differ.
+    bool DrainInto(Histogram& into);
+
+    void Reset();
+
+    std::uint64_t Count() const { return _count.load(std::memory_order_relaxed); }
+    /// Exact smallest recorded value, or 0 if empty.
+    std::int64_t Min() const;
+    /// Exact largest recorded value, or 0 if empty.
+    std::int64_t Max() const;
+
+    /// The value that `percentile` percent of samples are at or below, within the precision of the
+    /// histogram and never outside the recorded min and max. 0 if empty.
+    /// - Parameter percentile: 0 to 100.
+    std::int64_t ValueAtPercentile(double percentile) const;
+
+    /// Largest relative error of a reported value's magnitude.
+    double RelativeError() const;
+
+    bool SameLayout(const Histogram& other) const;
+
+private:
+    std::size_t IndexOf(std::int64_t value) const;
+    std::size_t MagnitudeIndex(std::uint64_t magnitude) const;
+    std::uint64_t HighestMagnitude(std::size_t magnitudeIndex) const;
+    std::uint64_t LowestMagnitude(std::size_t magnitudeIndex) const;
+    std::int64_t HighestEquivalent(std::size_t index) const;
+    void UpdateMin(std::int64_t value);
+    void UpdateMax(std::int64_t value);
+
+    const std::int64_t _lowest;
+    const std::int64_t _highest;
+    const unsigned _significantBits;
+    const std::uint64_t _subBucketCount;
+    const std::uint64_t _subBucketHalf;
+    // Buckets for negative magnitudes, stored in descending order of magnitude ahead of the rest
+    // so that the whole array is in ascending order of value.
+    const std::size_t _negativeBuckets;
+    const std::size_t _buckets;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> _counts;
+    std::atomic<std::uint64_t> _count{ 0 };
+    std::atomic<std::int64_t> _min;
+    std::atomic<std::int64_t> _max;
+};
+
+#endif /* Histogram_hh */
@@ -0,0 +1,354 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "MetricsCollector.hh"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+std::size_t NextPowerOfTwo(std::size_t value)
+{
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+// Line protocol escaping. Newlines can't be represented, so are dropped.
+void AppendEscaped(std::string& out, std::string_view value, std::string_view special)
+{
+    for (const char character : value) {
+        if (character == '\n' || character == '\r') {
+            continue;
+        }
+        if (special.find(character) != std::string_view::npos) {
+            out.push_back('\\');
+        }
+        out.push_back(character);
+    }
+}
+
+constexpr std::string_view kMeasurementSpecial = ", ";
+constexpr std::string_view kKeySpecial = ",= ";
+constexpr std::string_view kStringSpecial = "\"\\";
+
+std::string EncodeTags(std::vector<std::pair<std::string, std::string>> tags)
+{
+    std::sort(tags.begin(), tags.end());
+    std::string encoded;
+    for (const auto& [key, value] : tags) {
+        // Empty keys and values aren't valid line protocol.
+        if (key.empty() || value.empty()) {
+            continue;
+        }
+        encoded.push_back(',');
+        AppendEscaped(encoded, key, kKeySpecial);
+        encoded.push_back('=');
+        AppendEscaped(encoded, value, kKeySpecial);
+    }
+    return encoded;
+}
+
+template <typename Integer>
+void AppendInteger(std::string& out, Integer value)
+{
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+// Shortest of 15 or 17 significant digits that round trips.
+void AppendDouble(std::string& out, double value)
+{
+    char buffer[32];
+    auto length = std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+    if (std::strtod(buffer, nullptr) != value) {
+        length = std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    }
+    out.append(buffer, static_cast<std::size_t>(length));
+}
+
+thread_local std::shared_ptr<MetricsRing> localRing;
+}
+
+MetricsRing::MetricsRing(std::size_t capacity)
+    : _slots(NextPowerOfTwo(std::max<std::size_t>(capacity, 1))),
+      _mask(_slots.size() - 1)
+{
+}
+
+bool MetricsRing::Push(const MetricSample* samples, std::size_t count)
+{
+    const auto tail = _tail.load(std::memory_order_relaxed);
+    if (_slots.size() - (tail - _head.load(std::memory_order_acquire)) < count) {
+        return false;
+    }
+    for (std::size_t index = 0; index < count; ++index) {
+        _slots[(tail + index) & _mask] = samples[index];
+    }
+    _tail.store(tail + count, std::memory_order_release);
+    return true;
+}
+
+bool MetricsRing::Empty() const
+{
+    return _head.load(std::memory_order_relaxed) == _tail.load(std::memory_order_acquire);
+}
+
+MetricsCollector& MetricsCollector::Shared()
+{
+    static MetricsCollector collector;
+    return collector;
+}
+
+std::uint32_t MetricsCollector::InternField(std::string_view name)
+{
+    std::string escaped;
+    AppendEscaped(escaped, name, kKeySpecial);
+    std::lock_guard lock(_internMutex);
+    const auto [it, inserted] = _fieldIds.try_emplace(escaped, static_cast<std::uint32_t>(_fields.size()));
+    if (inserted) {
+        _fields.push_back(std::move(escaped));
+    }
+    return it->second;
+}
+
+std::uint32_t MetricsCollector::InternTags(std::vector<std::pair<std::string, std::string>> tags)
+{
+    auto encoded = EncodeTags(std::move(tags));
+    if (encoded.empty()) {
+        return 0;
+    }
+    std::lock_guard lock(_internMutex);
+    const auto [it, inserted] = _tagIds.try_emplace(encoded, static_cast<std::uint32_t>(_tags.size()));
+    if (inserted) {
+        _tags.push_back(std::move(encoded));
+    }
+    return it->second;
+}
+
+std::uint32_t MetricsCollector::TransientTags(std::vector<std::pair<std::string, std::string>> tags)
+{
+    auto encoded = EncodeTags(std::move(tags));
+    if (encoded.empty()) {
+        return 0;
+    }
+    std::lock_guard lock(_internMutex);
+    std::uint32_t id;
+    do {
+        id = kTransient | (_nextTransient++ & ~kTransient);
+    } while (_transientTags.count(id) != 0);
+    _transientTags.emplace(id, std::move(encoded));
+    return id;
+}
+
+std::uint32_t MetricsCollector::InternString(std::string_view value)
+{
+    std::string escaped;
+    AppendEscaped(escaped, value, kStringSpecial);
+    std::lock_guard lock(_internMutex);
+    const auto [it, inserted] = _stringIds.try_emplace(escaped, static_cast<std::uint32_t>(_strings.size()));
+    if (inserted) {
+        _strings.push_back(std::move(escaped));
+    }
+    return it->second;
+}
+
+std::uint32_t MetricsCollector::RegisterMeasurement()
+{
+    std::lock_guard lock(_collectMutex);
+    const auto measurement = _nextMeasurement++;
+    _pending.try_emplace(measurement);
+    return measurement;
+}
+
+void MetricsCollector::UnregisterMeasurement(std::uint32_t measurement)
+{
+    std::lock_guard lock(_collectMutex);
+    CollectLocked();
+    const auto it = _pending.find(measurement);
+    if (it == _pending.end()) {
+        return;
+    }
+    std::lock_guard internLock(_internMutex);
+    for (const auto& sample : it->second) {
+        ReleaseTransientLocked(sample.tags);
+    }
+    _pending.erase(it);
+}
+
+void MetricsCollector::Record(const MetricSample* samples, std::size_t count)
+{
+    if (count == 0 || LocalRing().Push(samples, count)) {
+        return;
+    }
+    _dropped.fetch_add(count, std::memory_order_relaxed);
+    if (samples[0].tags & kTransient) {
+        std::lock_guard lock(_internMutex);
+        ReleaseTransientLocked(samples[0].tags);
+    }
+}
+
+MetricsRing& MetricsCollector::LocalRing()
+{
+    if (!localRing) {
+        localRing = std::make_shared<MetricsRing>(kRingCapacity);
+        std::lock_guard lock(_ringsMutex);
+        _rings.push_back(localRing);
+    }
+    return *localRing;
+}
+
+void MetricsCollector::CollectLocked()
+{
+    std::vector<std::shared_ptr<MetricsRing>> rings;
+    {
+        std::lock_guard lock(_ringsMutex);
+        rings = _rings;
+    }
+
+    std::vector<std::uint32_t> orphaned;
+    for (const auto& ring : rings) {
+        ring->Drain([&](const MetricSample& sample) {
+            const auto it = _pending.find(sample.measurement);
+            if (it != _pending.end()) {
+                it->second.push_back(sample);
+            } else if (sample.tags & kTransient) {
+                orphaned.push_back(sample.tags);
+            }
+        });
+    }
+    rings.clear();
+
+    if (!orphaned.empty()) {
+        std::lock_guard lock(_internMutex);
+        for (const auto tags : orphaned) {
+            ReleaseTransientLocked(tags);
+        }
+    }
+
+    // Drop the rings of exited threads once they're empty.
+    std::lock_guard lock(_ringsMutex);
+    _rings.erase(std::remove_if(_rings.begin(),
+                                _rings.end(),
+                                [](const auto& ring) { return ring.use_count() == 1 && ring->Empty(); }),
+                 _rings.end());
+}
+
+void MetricsCollector::ReleaseTransientLocked(std::uint32_t tags)
+{
+    if (tags & kTransient) {
+        _transientTags.erase(tags);
+    }
+}
+
+std::size_t MetricsCollector::Encode(std::uint32_t measurement, std::string_view prefix, std::string& out)
+{
+    std::lock_guard lock(_collectMutex);
+    CollectLocked();
+    const auto it = _pending.find(measurement);
+    if (it == _pending.end() || it->second.empty()) {
+        return 0;
+    }
+
+    std::lock_guard internLock(_internMutex);
+    auto& samples = it->second;
+    std::size_t lines = 0;
+    std::size_t index = 0;
+    while (index < samples.size()) {
+        const auto& first = samples[index];
+        const auto lineStart = out.size();
+        out.append(prefix);
+        if (first.tags & kTransient) {
+            const auto tags = _transientTags.find(first.tags);
+            if (tags != _transientTags.end()) {
+                out.append(tags->second);
+            }
+        } else if (first.tags < _tags.size()) {
+            out.append(_tags[first.tags]);
+        }
+
+        // Consecutive samples with the same timestamp and tags share a line.
+        auto separator = ' ';
+        auto end = index;
+        for (; end < samples.size() && samples[end].timestamp == first.timestamp && samples[end].tags == first.tags;
+             ++end) {
+            const auto& sample = samples[end];
+            if (sample.field >= _fields.size()) {
+                continue;
+            }
+            // Line protocol can't represent non-finite floats.
+            if (sample.kind == MetricKind::Double) {
+                double value;
+                std::memcpy(&value, &sample.value, sizeof(value));
+                if (!std::isfinite(value)) {
+                    continue;
+                }
+            }
+            out.push_back(separator);
+            out.append(_fields[sample.field]);
+            out.push_back('=');
+            AppendValue(out, sample);
+            separator = ',';
+        }
+
+        if (separator == ' ') {
+            out.resize(lineStart);
+        } else {
+            if (first.timestamp != kNoMetricTimestamp) {
+                out.push_back(' ');
+                AppendInteger(out, first.timestamp);
+            }
+            out.push_back('\n');
+            ++lines;
+        }
+        ReleaseTransientLocked(first.tags);
+        index = end;
+    }
+    samples.clear();
+    return lines;
+}
+
+void MetricsCollector::AppendValue(std::string& out, const MetricSample& sample) const
+{
+    switch (sample.kind) {
+        case MetricKind::Int:
+            AppendInteger(out, static_cast<std::int64_t>(sample.value));
+            out.push_back('i');
+            break;
+        case MetricKind::UInt:
+            AppendInteger(out, sample.value);
+            out.push_back('u');
+            break;
+        case MetricKind::Double: {
+            double value;
+            std::memcpy(&value, &sample.value, sizeof(value));
+            AppendDouble(out, value);
+            break;
+        }
+        case MetricKind::Bool:
+            out.append(sample.value ? "true" : "false");
+            break;
+        case MetricKind::String:
+            out.push_back('"');
+            if (sample.value < _strings.size()) {
+                out.append(_strings[sample.value]);
+            }
+            out.push_back('"');
+            break;
+    }
+}
+
+std::string MetricsCollector::EncodePrefix(std::string_view name, std::vector<std::pair<std::string, std::string>> tags)
+{
+    std::string prefix;
+    AppendEscaped(prefix, name, kMeasurementSpecial);
+    prefix.append(EncodeTags(std::move(tags)));
+    return prefix;
+}
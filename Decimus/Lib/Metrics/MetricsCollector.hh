@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef MetricsCollector_hh
+#define MetricsCollector_hh
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+enum class MetricKind : std::uint8_t
+{
+    Int,
+    UInt,
+    Double,
+    Bool,
+    // Value is an interned string id.
+    String,
+};
+
+/// Timestamp of a sample without one, left for the server to fill in.
+constexpr std::int64_t kNoMetricTimestamp = INT64_MIN;
+
+/// One recorded value. Fixed width, so recording never allocates.
+struct MetricSample
+{
+    /// Nanoseconds since the Unix epoch, or `kNoMetricTimestamp`.
+    std::int64_t timestamp;
+    /// Bit pattern of a value of `kind`.
+    std::uint64_t value;
+    std::uint32_t measurement;
+    std::uint32_t field;
+    /// Interned or transient tag set, 0 for none.
+    std::uint32_t tags;
+    MetricKind kind;
+};
+
+/// Single producer, single consumer ring of samples.
+class MetricsRing
+{
+public:
+    explicit MetricsRing(std::size_t capacity);
+
+    /// Producer. Pushes all of `samples` or none of them, so the consumer never sees part of a point.
+    /// Returns false if there isn't room.
+    bool Push(const MetricSample* samples, std::size_t count);
+
+    /// Consumer. Pass every queued sample to `consume`, oldest first.
+    template <typename Consume>
+    std::size_t Drain(Consume&& consume)
+    {
+        const auto head = _head.load(std::memory_order_relaxed);
+        const auto tail = _tail.load(std::memory_order_acquire);
+        for (auto index = head; index != tail; ++index) {
+            consume(_slots[index & _mask]);
+        }
+        _head.store(tail, std::memory_order_release);
+        return tail - head;
+    }
+
+    bool Empty() const;
+
+private:
+    std::vector<MetricSample> _slots;
+    const std::size_t _mask;
+    alignas(64) std::atomic<std::size_t> _head{ 0 };
+    alignas(64) std::atomic<std::size_t> _tail{ 0 };
+};
+
+/// Process wide metrics collection.
+///
+/// Recording threads each push into their own `MetricsRing`, so the recording path takes no locks once a
+/// thread has recorded its first sample. Field names, tag sets and string values are interned up front and
+/// samples carry only their ids. Draining collects every ring, sorts samples by measurement and encodes them
+/// as InfluxDB line protocol into a caller owned buffer.
+class MetricsCollector
+{
+public:
+    static MetricsCollector& Shared();
+
+    MetricsCollector(const MetricsCollector&) = delete;
+    MetricsCollector& operator=(const MetricsCollector&) = delete;
+
+    std::uint32_t InternField(std::string_view name);
+    /// Intern a tag set. Tag sets are never freed, so values must come from a small, bounded set.
+    std::uint32_t InternTags(std::vector<std::pair<std::string, std::string>> tags);
+    /// A tag set for exactly one point, freed once that point is encoded or dropped.
+    std::uint32_t TransientTags(std::vector<std::pair<std::string, std::string>> tags);
+    /// Intern a string value. As with tags, values must come from a small, bounded set.
+    std::uint32_t InternString(std::string_view value);
+
+    std::uint32_t RegisterMeasurement();
+    /// Discard anything recorded and not yet encoded for this measurement.
+    void UnregisterMeasurement(std::uint32_t measurement);
+
+    /// Record a point from any thread. Lock free after a thread's first call.
+    /// The samples of a point share a timestamp and tags, and are queued together so they encode as one line.
+    void Record(const MetricSample* samples, std::size_t count);
+
+    /// Append a measurement's pending samples to `out` as line protocol, one line per timestamp and tag set.
+    /// - Parameter prefix: The encoded measurement name and tags, from `EncodePrefix`.
+    /// - Returns: The number of lines appended.
+    std::size_t Encode(std::uint32_t measurement, std::string_view prefix, std::string& out);
+
+    /// Samples lost to a full ring.
+    std::size_t Dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+    static std::string EncodePrefix(std::string_view name, std::vector<std::pair<std::string, std::string>> tags);
+
+private:
+    static constexpr std::size_t kRingCapacity = 4096;
+    static constexpr std::uint32_t kTransient = 0x80000000;
+
+    MetricsCollector() = default;
+
+    MetricsRing& LocalRing();
+    void CollectLocked();
+    void ReleaseTransientLocked(std::uint32_t tags);
+    void AppendValue(std::string& out, const MetricSample& sample) const;
+
+    // Interned names, tag sets and strings. Index 0 of tags is the empty set.
+    std::mutex _internMutex;
+    std::unordered_map<std::string, std::uint32_t> _fieldIds;
+    std::vector<std::string> _fields;
+    std::unordered_map<std::string, std::uint32_t> _tagIds;
+    std::vector<std::string> _tags{ std::string() };
+    std::unordered_map<std::string, std::uint32_t> _stringIds;
+    std::vector<std::string> _strings;
+    std::unordered_map<std::uint32_t, std::string> _transientTags;
+    std::uint32_t _nextTransient = 0;
+
+    // Every thread's ring. A ring only referenced from here belongs to a thread that has exited.
+    std::mutex _ringsMutex;
+    std::vector<std::shared_ptr<MetricsRing>> _rings;
+
+    // Collected samples awaiting encoding, by measurement.
+    std::mutex _collectMutex;
+    std::unordered_map<std::uint32_t, std::vector<MetricSample>> _pending;
+    std::uint32_t _nextMeasurement = 1;
+
+    std::atomic<std::size_t> _dropped{ 0 };
+};
+
+#endif /* MetricsCollector_hh */
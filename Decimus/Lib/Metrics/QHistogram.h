@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef QHistogram_h
+#define QHistogram_h
+
+#import <Foundation/Foundation.h>
+
+#ifdef __cplusplus
+#include <memory>
+#include "Histogram.hh"
+#endif
+
+/// Log linear histogram using `Histogram`.
+/// Recording is lock free and safe from any thread.
+NS_SWIFT_SENDABLE
+@interface QHistogram : NSObject {
+#ifdef __cplusplus
+    std::unique_ptr<Histogram> histogram;
+#endif
+}
+
+/// - Parameter lowest: Smallest value tracked, 0 or below. Values outside the range are clamped.
+/// - Parameter highest: Largest value tracked, 0 or above.
+/// - Parameter significantBits: Precision, between 2 and 16.
+-(instancetype _Nonnull) initWithLowest: (int64_t) lowest
+                                highest: (int64_t) highest
+                        significantBits: (uint8_t) significantBits;
+-(void) record: (int64_t) value;
+/// - Returns: False if the histograms' layouts differ.
+-(BOOL) merge: (QHistogram* _Nonnull) other;
+/// Move every count into `into`, leaving this histogram empty.
+/// - Returns: False if the histograms' layouts differ.
+-(BOOL) drainInto: (QHistogram* _Nonnull) into;
+-(void) reset;
+-(uint64_t) count;
+-(int64_t) min;
+-(int64_t) max;
+/// - Parameter percentile: 0 to 100.
+-(int64_t) valueAtPercentile: (double) percentile;
+/// Largest relative error of a reported value.
+-(double) relativeError;
+
+@end
+
+#endif /* QHistogram_h */
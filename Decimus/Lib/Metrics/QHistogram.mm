@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#import <Foundation/Foundation.h>
+#import "QHistogram.h"
+
+@implementation QHistogram
+
+-(instancetype) initWithLowest: (int64_t) lowest highest: (int64_t) highest significantBits: (uint8_t) significantBits {
+    self = [super init];
+    if (self) {
+        histogram = std::make_unique<Histogram>(lowest, highest, significantBits);
+    }
+    return self;
+}
+
+-(void) record: (int64_t) value {
+    histogram->Record(value);
+}
+
+-(BOOL) merge: (QHistogram*) other {
+    return histogram->Merge(*other->histogram);
+}
+
+-(BOOL) drainInto: (QHistogram*) into {
+    return histogram->DrainInto(*into->histogram);
+}
+
+-(void) reset {
+    histogram->Reset();
+}
+
+-(uint64_t) count {
+    return histogram->Count();
+}
+
+-(int64_t) min {
+    return histogram->Min();
+}
+
+-(int64_t) max {
+    return histogram->Max();
+}
+
+-(int64_t) valueAtPercentile: (double) percentile {
+    return histogram->ValueAtPercentile(percentile);
+}
+
+-(double) relativeError {
+    return histogram->RelativeError();
+}
+
+@end
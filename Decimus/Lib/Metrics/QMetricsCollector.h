@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef QMetricsCollector_h
+#define QMetricsCollector_h
+
+#import <Foundation/Foundation.h>
+
+#ifdef __cplusplus
+#include <string>
+#endif
+
+typedef NS_ENUM(uint8_t, QMetricKind) {
+    kQMetricKindInt,
+    kQMetricKindUInt,
+    kQMetricKindDouble,
+    kQMetricKindBool,
+    kQMetricKindString,
+};
+
+/// One field of a point.
+typedef struct QMetricValue {
+    uint32_t field;
+    QMetricKind kind;
+    /// Bit pattern of a value of `kind`.
+    uint64_t value;
+} QMetricValue;
+
+/// Process wide, lock free metrics recording using `MetricsCollector`.
+/// Timestamps are nanoseconds since the Unix epoch, or INT64_MIN for none.
+@interface QMetricsCollector : NSObject
+
++(uint32_t) internField: (NSString* _Nonnull) name;
+/// Tag sets are never freed, so values must come from a small, bounded set.
++(uint32_t) internTags: (NSDictionary<NSString*, NSString*>* _Nonnull) tags;
+/// A tag set for exactly one recorded point.
++(uint32_t) transientTags: (NSDictionary<NSString*, NSString*>* _Nonnull) tags;
+/// String values are never freed, so must come from a small, bounded set.
++(uint32_t) internString: (NSString* _Nonnull) value;
+
++(uint32_t) registerMeasurement;
++(void) unregisterMeasurement: (uint32_t) measurement;
+
++(void) record: (uint32_t) measurement
+         field: (uint32_t) field
+          kind: (QMetricKind) kind
+         value: (uint64_t) value
+     timestamp: (int64_t) timestamp
+          tags: (uint32_t) tags;
+
+/// Record several fields sharing a timestamp and tags as one point, encoded as one line.
++(void) record: (uint32_t) measurement
+        values: (const QMetricValue* _Nonnull) values
+         count: (size_t) count
+     timestamp: (int64_t) timestamp
+          tags: (uint32_t) tags;
+
+/// Samples lost to a full per thread ring.
++(size_t) dropped;
+
+@end
+
+/// Encodes collected samples as InfluxDB line protocol into a reusable buffer.
+/// Not thread safe.
+@interface QInfluxLineEncoder : NSObject {
+#ifdef __cplusplus
+    std::string buffer;
+#endif
+}
+
+-(void) reset;
+/// Append a measurement's pending samples.
+/// - Returns: The number of lines appended.
+-(size_t) appendMeasurement: (uint32_t) measurement
+                       name: (NSString* _Nonnull) name
+                       tags: (NSDictionary<NSString*, NSString*>* _Nonnull) tags;
+/// The encoded lines, without copying. Only valid until the next append or reset.
+-(NSData* _Nonnull) data;
+
+@end
+
+#endif /* QMetricsCollector_h */
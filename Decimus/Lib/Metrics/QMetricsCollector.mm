@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#import <Foundation/Foundation.h>
+#import "QMetricsCollector.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "MetricsCollector.hh"
+
+static_assert(static_cast<uint8_t>(MetricKind::Int) == kQMetricKindInt, "MetricKind mismatch");
+static_assert(static_cast<uint8_t>(MetricKind::UInt) == kQMetricKindUInt, "MetricKind mismatch");
+static_assert(static_cast<uint8_t>(MetricKind::Double) == kQMetricKindDouble, "MetricKind mismatch");
+static_assert(static_cast<uint8_t>(MetricKind::Bool) == kQMetricKindBool, "MetricKind mismatch");
+static_assert(static_cast<uint8_t>(MetricKind::String) == kQMetricKindString, "MetricKind mismatch");
+
+static std::vector<std::pair<std::string, std::string>> convertTags(NSDictionary<NSString*, NSString*>* tags)
+{
+    std::vector<std::pair<std::string, std::string>> converted;
+    converted.reserve(tags.count);
+    [tags enumerateKeysAndObjectsUsingBlock:^(NSString* key, NSString* value, BOOL*) {
+        converted.emplace_back(std::string([key UTF8String]), std::string([value UTF8String]));
+    }];
+    return converted;
+}
+
+@implementation QMetricsCollector
+
++(uint32_t) internField: (NSString*) name
+{
+    return MetricsCollector::Shared().InternField([name UTF8String]);
+}
+
++(uint32_t) internTags: (NSDictionary<NSString*, NSString*>*) tags
+{
+    return MetricsCollector::Shared().InternTags(convertTags(tags));
+}
+
++(uint32_t) transientTags: (NSDictionary<NSString*, NSString*>*) tags
+{
+    return MetricsCollector::Shared().TransientTags(convertTags(tags));
+}
+
++(uint32_t) internString: (NSString*) value
+{
+    return MetricsCollector::Shared().InternString([value UTF8String]);
+}
+
++(uint32_t) registerMeasurement
+{
+    return MetricsCollector::Shared().RegisterMeasurement();
+}
+
++(void) unregisterMeasurement: (uint32_t) measurement
+{
+    MetricsCollector::Shared().UnregisterMeasurement(measurement);
+}
+
++(void) record: (uint32_t) measurement
+         field: (uint32_t) field
+          kind: (QMetricKind) kind
+         value: (uint64_t) value
+     timestamp: (int64_t) timestamp
+          tags: (uint32_t) tags
+{
+    const MetricSample sample{ timestamp, value, measurement, field, tags, static_cast<MetricKind>(kind) };
+    MetricsCollector::Shared().Record(&sample, 1);
+}
+
++(void) record: (uint32_t) measurement
+        values: (const QMetricValue*) values
+         count: (size_t) count
+     timestamp: (int64_t) timestamp
+          tags: (uint32_t) tags
+{
+    // Points are a handful of fields, so only unusually large ones allocate.
+    constexpr size_t inlineCount = 16;
+    MetricSample inlineSamples[inlineCount];
+    std::vector<MetricSample> allocated;
+    MetricSample* samples = inlineSamples;
+    if (count > inlineCount) {
+        allocated.resize(count);
+        samples = allocated.data();
+    }
+    for (size_t index = 0; index < count; ++index) {
+        const auto& value = values[index];
+        samples[index] = { timestamp, value.value, measurement, value.field, tags, static_cast<MetricKind>(value.kind) };
+    }
+    MetricsCollector::Shared().Record(samples, count);
+}
+
++(size_t) dropped
+{
+    return MetricsCollector::Shared().Dropped();
+}
+
+@end
+
+@implementation QInfluxLineEncoder
+
+-(void) reset
+{
+    buffer.clear();
+}
+
+-(size_t) appendMeasurement: (uint32_t) measurement
+                       name: (NSString*) name
+                       tags: (NSDictionary<NSString*, NSString*>*) tags
+{
+    const auto prefix = MetricsCollector::EncodePrefix([name UTF8String], convertTags(tags));
+    return MetricsCollector::Shared().Encode(measurement, prefix, buffer);
+}
+
+-(NSData*) data
+{
+    return [NSData dataWithBytesNoCopy:buffer.data() length:buffer.size() freeWhenDone:NO];
+}
+
+@end
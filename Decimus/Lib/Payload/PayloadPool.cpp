@@ -0,0 +1,210 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "PayloadPool.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace {
+constexpr std::size_t kCacheLine = 64;
+
+std::size_t AlignUp(std::size_t value, std::size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+std::uint64_t Pack(std::uint32_t tag, std::uint32_t index)
+{
+    return (static_cast<std::uint64_t>(tag) << 32) | index;
+}
+}
+
+// PooledPayload.
+
+PooledPayload::PooledPayload(const PooledPayload& other) : _slot(other._slot)
+{
+    if (_slot) {
+        _slot->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+PooledPayload::PooledPayload(PooledPayload&& other) noexcept : _slot(other._slot)
+{
+    other._slot = nullptr;
+}
+
+PooledPayload& PooledPayload::operator=(PooledPayload other) noexcept
+{
+    std::swap(_slot, other._slot);
+    return *this;
+}
+
+PooledPayload::~PooledPayload()
+{
+    if (_slot && _slot->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        PayloadPool::Release(_slot);
+    }
+}
+
+bool PooledPayload::Pooled() const
+{
+    return _slot && _slot->index != PayloadPool::kHeapIndex;
+}
+
+// PayloadPool.
+
+std::shared_ptr<PayloadPool> PayloadPool::Create(std::size_t slotSize, std::size_t slots)
+{
+    return std::shared_ptr<PayloadPool>(new PayloadPool(slotSize, slots));
+}
+
+PayloadPool::PayloadPool(std::size_t slotSize, std::size_t slots)
+    : _slotSize(slotSize),
+      _slots(std::min<std::size_t>(slots, kHeapIndex - 1)),
+      _stride(AlignUp(sizeof(PayloadSlot) + slotSize, kCacheLine)),
+      _slab(new std::uint8_t[_stride * _slots + kCacheLine])
+{
+    // Thread every slot onto the free list. The last slot points at the sentinel index.
+    for (std::uint32_t index = 0; index < _slots; index++) {
+        auto* slot = new (SlotAt(index)) PayloadSlot();
+        slot->index = index;
+        slot->capacity = _slotSize;
+        slot->pool = this;
+        slot->next.store(index + 1 < _slots ? index + 1 : kHeapIndex, std::memory_order_relaxed);
+    }
+    _freeHead.store(Pack(0, _slots > 0 ? 0 : kHeapIndex), std::memory_order_release);
+}
+
+PayloadPool::~PayloadPool()
+{
+    for (std::uint32_t index = 0; index < _slots; index++) {
+        SlotAt(index)->~PayloadSlot();
+    }
+}
+
+PayloadSlot* PayloadPool::SlotAt(std::uint32_t index) const
+{
+    auto base = reinterpret_cast<std::uintptr_t>(_slab.get());
+    base = AlignUp(base, kCacheLine);
+    return reinterpret_cast<PayloadSlot*>(base + static_cast<std::uintptr_t>(index) * _stride);
+}
+
+PayloadSlot* PayloadPool::Pop()
+{
+    auto head = _freeHead.load(std::memory_order_acquire);
+    while (true) {
+        const auto index = static_cast<std::uint32_t>(head);
+        if (index == kHeapIndex) return nullptr;
+        auto* slot = SlotAt(index);
+        const auto next = slot->next.load(std::memory_order_relaxed);
+        const auto tag = static_cast<std::uint32_t>(head >> 32) + 1;
+        if (_freeHead.compare_exchange_weak(head, Pack(tag, next),
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+            return slot;
+        }
+    }
+}
+
+void PayloadPool::Push(PayloadSlot* slot)
+{
+    auto head = _freeHead.load(std::memory_order_acquire);
+    while (true) {
+        slot->next.store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+        const auto tag = static_cast<std::uint32_t>(head >> 32) + 1;
+        if (_freeHead.compare_exchange_weak(head, Pack(tag, slot->index),
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+            return;
+        }
+    }
+}
+
+PooledPayload PayloadPool::Acquire(const std::uint8_t* data, std::size_t length)
+{
+    _acquired.fetch_add(1, std::memory_order_relaxed);
+    PayloadSlot* slot = length <= _slotSize ? Pop() : nullptr;
+    if (slot) {
+        const auto inUse = _inUse.fetch_add(1, std::memory_order_relaxed) + 1;
+        auto high = _highWaterMark.load(std::memory_order_relaxed);
+        while (inUse > high && !_highWaterMark.compare_exchange_weak(high, inUse, std::memory_order_relaxed)) {}
+        slot->keepAlive = shared_from_this();
+    } else {
+        // Too large or exhausted, fall back to a one-off heap allocation.
+        _overflows.fetch_add(1, std::memory_order_relaxed);
+        void* memory = ::operator new(sizeof(PayloadSlot) + length);
+        slot = new (memory) PayloadSlot();
+        slot->index = kHeapIndex;
+        slot->capacity = length;
+    }
+    slot->length = length;
+    slot->refs.store(1, std::memory_order_relaxed);
+    if (length > 0) {
+        std::memcpy(slot->Bytes(), data, length);
+    }
+    return PooledPayload(slot);
+}
+
+void PayloadPool::Release(PayloadSlot* slot)
+{
+    if (slot->index == kHeapIndex) {
+        slot->~PayloadSlot();
+        ::operator delete(slot);
+        return;
+    }
+
+    // The pool may only be kept alive by this slot, so hold it until the slot is back on the free list.
+    auto pool = std::move(slot->keepAlive);
+    slot->length = 0;
+    pool->_inUse.fetch_sub(1, std::memory_order_relaxed);
+    pool->Push(slot);
+}
+
+PayloadPool::Stats PayloadPool::GetStats() const
+{
+    return Stats {
+        _slots,
+        _inUse.load(std::memory_order_relaxed),
+        _highWaterMark.load(std::memory_order_relaxed),
+        _acquired.load(std::memory_order_relaxed),
+        _overflows.load(std::memory_order_relaxed),
+    };
+}
+
+// PayloadAllocator.
+
+PayloadAllocator::PayloadAllocator(const std::vector<SizeClass>& classes)
+{
+    auto sorted = classes;
+    std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) { return lhs.slotSize < rhs.slotSize; });
+    for (const auto& sizeClass : sorted) {
+        _pools.push_back(PayloadPool::Create(sizeClass.slotSize, sizeClass.slots));
+    }
+    if (_pools.empty()) {
+        _pools.push_back(PayloadPool::Create(0, 0));
+    }
+}
+
+std::shared_ptr<PayloadAllocator> PayloadAllocator::Shared()
+{
+    // Audio objects, typical video deltas, and large keyframes.
+    static const auto shared = std::make_shared<PayloadAllocator>(std::vector<SizeClass> {
+        { 2 * 1024, 512 },
+        { 64 * 1024, 128 },
+        { 512 * 1024, 16 },
+    });
+    return shared;
+}
+
+PooledPayload PayloadAllocator::Acquire(const std::uint8_t* data, std::size_t length)
+{
+    for (const auto& pool : _pools) {
+        if (length <= pool->SlotSize()) {
+            return pool->Acquire(data, length);
+        }
+    }
+    // Larger than every class: the largest pool records the overflow and heap allocates.
+    return _pools.back()->Acquire(data, length);
+}
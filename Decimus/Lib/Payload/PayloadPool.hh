@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef PayloadPool_hh
+#define PayloadPool_hh
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class PayloadPool;
+
+/// Header preceding every pooled payload's bytes.
+/// Slab slots and heap fallbacks share this layout so that handles don't care where they came from.
+struct PayloadSlot
+{
+    std::atomic<std::uint32_t> refs{ 0 };
+    std::atomic<std::uint32_t> next{ 0 };
+    std::uint32_t index = 0;
+    std::size_t length = 0;
+    std::size_t capacity = 0;
+    PayloadPool* pool = nullptr;
+    std::shared_ptr<PayloadPool> keepAlive;
+
+    std::uint8_t* Bytes() { return reinterpret_cast<std::uint8_t*>(this + 1); }
+};
+
+/// Refcounted handle to a pooled payload.
+/// Copies share the underlying slot, which returns to its pool when the last handle is destroyed.
+class PooledPayload
+{
+public:
+    PooledPayload() = default;
+    PooledPayload(const PooledPayload& other);
+    PooledPayload(PooledPayload&& other) noexcept;
+    PooledPayload& operator=(PooledPayload other) noexcept;
+    ~PooledPayload();
+
+    std::uint8_t* Data() const { return _slot ? _slot->Bytes() : nullptr; }
+    std::size_t Size() const { return _slot ? _slot->length : 0; }
+    bool Pooled() const;
+    explicit operator bool() const { return _slot != nullptr; }
+
+private:
+    friend class PayloadPool;
+    explicit PooledPayload(PayloadSlot* slot) : _slot(slot) {}
+    PayloadSlot* _slot = nullptr;
+};
+
+/// Fixed-size slab of refcounted payload buffers.
+///
+/// Payloads are copied in once on acquire, and the slot stays alive until the last handle releases it.
+/// Acquire and release are lock-free, so any thread may drop the final reference.
+/// Payloads larger than the slot size, or arriving when the slab is exhausted, fall back to a
+/// single heap allocation with the same handle semantics.
+class PayloadPool : public std::enable_shared_from_this<PayloadPool>
+{
+public:
+    struct Stats
+    {
+        std::size_t capacity;
+        std::size_t inUse;
+        std::size_t highWaterMark;
+        std::uint64_t acquired;
+        std::uint64_t overflows;
+    };
+
+    static std::shared_ptr<PayloadPool> Create(std::size_t slotSize, std::size_t slots);
+    ~PayloadPool();
+
+    PayloadPool(const PayloadPool&) = delete;
+    PayloadPool& operator=(const PayloadPool&) = delete;
+
+    /// Copy the given bytes into a pooled buffer.
+    PooledPayload Acquire(const std::uint8_t* data, std::size_t length);
+
+    std::size_t SlotSize() const { return _slotSize; }
+    Stats GetStats() const;
+
+private:
+    friend class PooledPayload;
+    static constexpr std::uint32_t kHeapIndex = UINT32_MAX;
+
+    PayloadPool(std::size_t slotSize, std::size_t slots);
+    PayloadSlot* SlotAt(std::uint32_t index) const;
+    PayloadSlot* Pop();
+    void Push(PayloadSlot* slot);
+    static void Release(PayloadSlot* slot);
+
+    const std::size_t _slotSize;
+    const std::size_t _slots;
+    const std::size_t _stride;
+    std::unique_ptr<std::uint8_t[]> _slab;
+
+    // Tagged head of the free list: upper 32 bits are an ABA tag, lower 32 bits the slot index.
+    std::atomic<std::uint64_t> _freeHead;
+    std::atomic<std::size_t> _inUse{ 0 };
+    std::atomic<std::size_t> _highWaterMark{ 0 };
+    std::atomic<std::uint64_t> _acquired{ 0 };
+    std::atomic<std::uint64_t> _overflows{ 0 };
+};
+
+/// A set of payload pools with increasing slot sizes.
+/// Each acquire uses the smallest pool that fits, so small audio objects don't pin video sized slots.
+class PayloadAllocator
+{
+public:
+    struct SizeClass
+    {
+        std::size_t slotSize;
+        std::size_t slots;
+    };
+
+    explicit PayloadAllocator(const std::vector<SizeClass>& classes);
+
+    /// Process wide allocator shared by all receive handlers.
+    static std::shared_ptr<PayloadAllocator> Shared();
+
+    PooledPayload Acquire(const std::uint8_t* data, std::size_t length);
+    const std::vector<std::shared_ptr<PayloadPool>>& Pools() const { return _pools; }
+
+private:
+    std::vector<std::shared_ptr<PayloadPool>> _pools;
+};
+
+#endif /* PayloadPool_hh */
@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef QPayloadPool_h
+#define QPayloadPool_h
+
+#import <Foundation/Foundation.h>
+
+#ifdef __cplusplus
+#include "PayloadPool.hh"
+#include <memory>
+#endif
+
+typedef struct QPayloadPoolStats {
+    size_t slotSize;
+    size_t capacity;
+    size_t inUse;
+    size_t highWaterMark;
+    uint64_t acquired;
+    uint64_t overflows;
+} QPayloadPoolStats;
+
+/// Refcounted receive buffers backing object payloads handed to Swift.
+/// Returned data owns its slot and stays valid for as long as it is retained.
+NS_SWIFT_SENDABLE
+@interface QPayloadPool : NSObject
+{
+#ifdef __cplusplus
+@public
+    std::shared_ptr<PayloadAllocator> allocator;
+#endif
+}
+
+/// The process wide pool used by subscribe and fetch handlers.
++(QPayloadPool* _Nonnull) shared;
+-(instancetype _Nonnull) initWithSlotSize: (size_t) slotSize slots: (size_t) slots;
+-(NSData* _Nonnull) dataWithBytes: (const void* _Nullable) bytes length: (size_t) length;
+-(size_t) poolCount;
+-(QPayloadPoolStats) statsForPool: (size_t) index;
+@end
+
+#ifdef __cplusplus
+/// Wrap a pooled payload as NSData. The data holds a reference to the slot until it is deallocated.
+[[maybe_unused]]
+static NSData* _Nonnull pooledData(PooledPayload payload) {
+    auto* bytes = payload.Data();
+    const auto length = payload.Size();
+    return [[NSData alloc] initWithBytesNoCopy:bytes
+                                        length:length
+                                   deallocator:^(void*, NSUInteger) {
+        // Captured by value; the slot is released when this block is destroyed.
+        (void)payload;
+    }];
+}
+#endif
+
+#endif /* QPayloadPool_h */
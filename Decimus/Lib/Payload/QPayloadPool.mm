@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#import "QPayloadPool.h"
+
+@implementation QPayloadPool
+
++(QPayloadPool*) shared {
+    static QPayloadPool* shared = nil;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        shared = [[QPayloadPool alloc] init];
+        shared->allocator = PayloadAllocator::Shared();
+    });
+    return shared;
+}
+
+-(instancetype) initWithSlotSize: (size_t) slotSize slots: (size_t) slots {
+    self = [super init];
+    if (self) {
+        allocator = std::make_shared<PayloadAllocator>(std::vector<PayloadAllocator::SizeClass> { { slotSize, slots } });
+    }
+    return self;
+}
+
+-(NSData*) dataWithBytes: (const void*) bytes length: (size_t) length {
+    assert(allocator);
+    return pooledData(allocator->Acquire(static_cast<const std::uint8_t*>(bytes), length));
+}
+
+-(size_t) poolCount {
+    assert(allocator);
+    return allocator->Pools().size();
+}
+
+-(QPayloadPoolStats) statsForPool: (size_t) index {
+    assert(allocator);
+    const auto& pool = allocator->Pools().at(index);
+    const auto stats = pool->GetStats();
+    return QPayloadPoolStats {
+        .slotSize = pool->SlotSize(),
+        .capacity = stats.capacity,
+        .inUse = stats.inUse,
+        .highWaterMark = stats.highWaterMark,
+        .acquired = stats.acquired,
+        .overflows = stats.overflows,
+    };
+}
+
+@end
@@ -0,0 +1,240 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "ArrivalStats.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+std::size_t PowerOfTwo(std::size_t capacity)
+{
+    std::size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+}
+
+// ArrivalRing.
+
+ArrivalRing::ArrivalRing(std::size_t capacity)
+    : _capacity(PowerOfTwo(std::max<std::size_t>(capacity, 1))),
+      _mask(_capacity - 1),
+      _arrivals(new double[_capacity]()),
+      _values(new double[_capacity]())
+{
+}
+
+// SlidingWindow.
+
+SlidingWindow::SlidingWindow(std::size_t capacity, double length)
+    : _ring(capacity),
+      _length(length)
+{
+}
+
+bool SlidingWindow::Add(double arrival, double value)
+{
+    const auto head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) == _ring.Capacity()) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    const auto slot = _ring.Slot(head);
+    _ring.Arrivals()[slot] = arrival;
+    _ring.Values()[slot] = value;
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+std::size_t SlidingWindow::Expire(double now)
+{
+    auto tail = _tail.load(std::memory_order_relaxed);
+    const auto head = _head.load(std::memory_order_acquire);
+    const auto* arrivals = _ring.Arrivals();
+    while (tail != head && now - arrivals[_ring.Slot(tail)] > _length) {
+        ++tail;
+    }
+    _tail.store(tail, std::memory_order_release);
+    return static_cast<std::size_t>(head - tail);
+}
+
+std::size_t SlidingWindow::Copy(double* values, std::size_t capacity) const
+{
+    const auto tail = _tail.load(std::memory_order_relaxed);
+    const auto head = _head.load(std::memory_order_acquire);
+    const auto count = std::min(static_cast<std::size_t>(head - tail), capacity);
+    // At most two contiguous runs, either side of the wrap.
+    const auto start = _ring.Slot(tail);
+    const auto first = std::min(count, _ring.Capacity() - start);
+    std::memcpy(values, _ring.Values() + start, first * sizeof(double));
+    std::memcpy(values + first, _ring.Values(), (count - first) * sizeof(double));
+    return count;
+}
+
+// WindowMin.
+
+WindowMin::WindowMin(std::size_t capacity, double length, double secondsPerTick)
+    : _ring(capacity),
+      _candidates(new std::uint64_t[_ring.Capacity()]()),
+      _length(length),
+      _secondsPerTick(secondsPerTick)
+{
+}
+
+double WindowMin::Offset(std::uint64_t sequence) const
+{
+    // Separate statements, so that the multiply isn't fused into the subtract, and this rounds exactly as
+    // the same calculation in Swift does.
+    const auto slot = _ring.Slot(sequence);
+    const auto seconds = _ring.Arrivals()[slot] * _secondsPerTick;
+    return seconds - _ring.Values()[slot];
+}
+
+void WindowMin::Push(double arrival, double timestamp)
+{
+    Expire(arrival);
+    if (Count() == _ring.Capacity()) {
+        ++_tail;
+        if (_front != _back && _candidates[_ring.Slot(_front)] < _tail) {
+            ++_front;
+        }
+    }
+
+    const auto sequence = _head++;
+    const auto slot = _ring.Slot(sequence);
+    _ring.Arrivals()[slot] = arrival;
+    _ring.Values()[slot] = timestamp;
+    const auto offset = Offset(sequence);
+
+    // Anything with a larger offset arrived earlier, so will expire first, and can never be the minimum again.
+    while (_back != _front && Offset(_candidates[_ring.Slot(_back - 1)]) > offset) {
+        --_back;
+    }
+    _candidates[_ring.Slot(_back++)] = sequence;
+}
+
+void WindowMin::Expire(double now)
+{
+    const auto* arrivals = _ring.Arrivals();
+    while (_tail != _head && (now - arrivals[_ring.Slot(_tail)]) * _secondsPerTick > _length) {
+        ++_tail;
+    }
+    while (_front != _back && _candidates[_ring.Slot(_front)] < _tail) {
+        ++_front;
+    }
+}
+
+bool WindowMin::Min(double& arrival, double& timestamp) const
+{
+    if (_front == _back) {
+        return false;
+    }
+    const auto slot = _ring.Slot(_candidates[_ring.Slot(_front)]);
+    arrival = _ring.Arrivals()[slot];
+    timestamp = _ring.Values()[slot];
+    return true;
+}
+
+// JitterEstimator.
+
+JitterEstimator::JitterEstimator(double alpha)
+    : _alpha(alpha)
+{
+}
+
+bool JitterEstimator::Record(double timestamp, double arrival)
+{
+    const auto transit = arrival - timestamp;
+    if (!_started) {
+        _started = true;
+        _transit = transit;
+        return false;
+    }
+    const auto d = std::abs(transit - _transit);
+    _transit = transit;
+    // Unfused, as in `WindowMin::Offset`.
+    const auto step = (1.0 / 16.0) * (d - Jitter());
+    const auto jitter = Jitter() + step;
+    const auto weighted = _alpha * jitter;
+    const auto carried = (1 - _alpha) * Smoothed();
+    _jitter.store(jitter, std::memory_order_relaxed);
+    _smoothed.store(weighted + carried, std::memory_order_relaxed);
+    return true;
+}
+
+// SetVariance.
+
+SetVariance::SetVariance(std::uint32_t expected, std::uint32_t max)
+    : _expected(std::max<std::uint32_t>(expected, 1)),
+      _max(max),
+      _slots(static_cast<std::size_t>(max) + 1),
+      _keys(new double[_slots]()),
+      _oldest(new double[_slots]()),
+      _newest(new double[_slots]()),
+      _started(new std::uint64_t[_slots]()),
+      _counts(new std::uint32_t[_slots]()),
+      _flushed(new Flush[max / 2 + 1])
+{
+}
+
+std::size_t SetVariance::Find(double key) const
+{
+    const auto* keys = _keys.get();
+    const auto* counts = _counts.get();
+    for (std::size_t slot = 0; slot < _slots; ++slot) {
+        if (counts[slot] != 0 && keys[slot] == key) {
+            return slot;
+        }
+    }
+    return _slots;
+}
+
+void SetVariance::FlushOldest()
+{
+    for (std::uint32_t flush = 0; flush <= _max / 2; ++flush) {
+        std::size_t oldest = _slots;
+        for (std::size_t slot = 0; slot < _slots; ++slot) {
+            if (_counts[slot] != 0 && (oldest == _slots || _started[slot] < _started[oldest])) {
+                oldest = slot;
+            }
+        }
+        _flushed[_flushedCount++] = { _newest[oldest] - _oldest[oldest], _counts[oldest] };
+        _counts[oldest] = 0;
+        --_inFlight;
+    }
+}
+
+bool SetVariance::Record(double key, double arrival, double& variance)
+{
+    _flushedCount = 0;
+    if (_inFlight > _max) {
+        FlushOldest();
+    }
+
+    auto slot = Find(key);
+    if (slot == _slots) {
+        slot = static_cast<std::size_t>(std::find(_counts.get(), _counts.get() + _slots, 0u) - _counts.get());
+        _keys[slot] = key;
+        _oldest[slot] = arrival;
+        _newest[slot] = arrival;
+        _started[slot] = _sequence++;
+        _counts[slot] = 1;
+        ++_inFlight;
+    } else {
+        _oldest[slot] = std::min(_oldest[slot], arrival);
+        _newest[slot] = std::max(_newest[slot], arrival);
+        ++_counts[slot];
+    }
+
+    if (_counts[slot] < _expected) {
+        return false;
+    }
+    variance = _newest[slot] - _oldest[slot];
+    _counts[slot] = 0;
+    --_inFlight;
+    return true;
+}
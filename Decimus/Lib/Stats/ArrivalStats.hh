@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef ArrivalStats_hh
+#define ArrivalStats_hh
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/// Statistics over object arrivals, for the per-object receive path.
+///
+/// Samples are (arrival, value) pairs held structure-of-arrays in fixed capacity rings, so nothing allocates
+/// after construction and scans run over contiguous doubles. Each type has a single writer and does no
+/// locking; where a reader may be on another thread, that is called out.
+
+/// Fixed capacity ring of (arrival, value) samples. Capacity is rounded up to a power of two.
+class ArrivalRing
+{
+public:
+    explicit ArrivalRing(std::size_t capacity);
+
+    std::size_t Capacity() const { return _capacity; }
+    std::size_t Slot(std::uint64_t sequence) const { return static_cast<std::size_t>(sequence & _mask); }
+
+    double* Arrivals() { return _arrivals.get(); }
+    const double* Arrivals() const { return _arrivals.get(); }
+    double* Values() { return _values.get(); }
+    const double* Values() const { return _values.get(); }
+
+private:
+    const std::size_t _capacity;
+    const std::uint64_t _mask;
+    std::unique_ptr<double[]> _arrivals;
+    std::unique_ptr<double[]> _values;
+};
+
+/// Values that arrived within the last `length`.
+///
+/// Single producer, single consumer: `Add` from one thread, `Expire` and `Copy` from one other, lock free.
+class SlidingWindow
+{
+public:
+    /// - Parameter capacity: Most samples held. Samples added beyond this are dropped.
+    /// - Parameter length: How long a sample stays in the window, in the units of its arrival.
+    SlidingWindow(std::size_t capacity, double length);
+
+    /// Producer.
+    /// - Returns: False if full, and the sample was dropped.
+    bool Add(double arrival, double value);
+
+    /// Consumer. Drop samples that arrived more than `length` before `now`, stopping at the first that didn't.
+    /// - Returns: Samples left.
+    std::size_t Expire(double now);
+
+    /// Consumer. Copy held values, oldest first.
+    /// - Returns: Values copied, at most `capacity`.
+    std::size_t Copy(double* values, std::size_t capacity) const;
+
+    std::size_t Capacity() const { return _ring.Capacity(); }
+    std::uint64_t Dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+    ArrivalRing _ring;
+    const double _length;
+    // Next to write, owned by the producer.
+    std::atomic<std::uint64_t> _head{ 0 };
+    // Oldest held, owned by the consumer.
+    std::atomic<std::uint64_t> _tail{ 0 };
+    std::atomic<std::uint64_t> _dropped{ 0 };
+};
+
+/// Smallest `arrival * secondsPerTick - timestamp` over samples that arrived within the last `length` seconds:
+/// the least delayed sample, and so the best estimate of the offset between sender and receiver clocks.
+///
+/// Kept incrementally with a monotonic deque of candidates, so both adding and expiring are amortized O(1).
+/// Arrivals are expected in order. Not thread safe.
+class WindowMin
+{
+public:
+    /// - Parameter capacity: Most samples held. Past this, the oldest are dropped before they expire.
+    /// - Parameter length: Window length, in seconds.
+    /// - Parameter secondsPerTick: Scale of arrivals, which are ticks.
+    WindowMin(std::size_t capacity, double length, double secondsPerTick);
+
+    /// Expire as of `arrival`, then add the sample.
+    void Push(double arrival, double timestamp);
+
+    /// Drop samples that arrived more than `length` before `now`.
+    void Expire(double now);
+
+    /// The sample with the smallest offset, the oldest such on a tie.
+    /// - Returns: False if there are none.
+    bool Min(double& arrival, double& timestamp) const;
+
+    std::size_t Count() const { return static_cast<std::size_t>(_head - _tail); }
+
+private:
+    double Offset(std::uint64_t sequence) const;
+
+    ArrivalRing _ring;
+    // Sequence numbers of samples that could yet be the minimum, with increasing offsets.
+    std::unique_ptr<std::uint64_t[]> _candidates;
+    const double _length;
+    const double _secondsPerTick;
+    std::uint64_t _head = 0;
+    std::uint64_t _tail = 0;
+    std::uint64_t _front = 0;
+    std::uint64_t _back = 0;
+};
+
+/// Interarrival jitter as defined by RFC 3550 (gain 1/16), with a further exponentially smoothed value.
+///
+/// `Record` from one thread; `Jitter` and `Smoothed` can be read from any.
+class JitterEstimator
+{
+public:
+    /// - Parameter alpha: Smoothing factor applied to the jitter.
+    explicit JitterEstimator(double alpha);
+
+    /// - Parameter timestamp: Sender timestamp, in seconds.
+    /// - Parameter arrival: Arrival time, in seconds.
+    /// - Returns: False for the first arrival, which only sets the baseline transit time.
+    bool Record(double timestamp, double arrival);
+
+    double Jitter() const { return _jitter.load(std::memory_order_relaxed); }
+    double Smoothed() const { return _smoothed.load(std::memory_order_relaxed); }
+
+private:
+    const double _alpha;
+    double _transit = 0;
+    bool _started = false;
+    std::atomic<double> _jitter{ 0 };
+    std::atomic<double> _smoothed{ 0 };
+};
+
+/// Spread of arrival times of sets of objects sharing a key, such as the layers of one frame.
+///
+/// A set completes when it has `expected` arrivals, reporting newest minus oldest. More than `max` sets in
+/// flight flushes the oldest half (`max / 2 + 1`) incomplete. Not thread safe.
+class SetVariance
+{
+public:
+    struct Flush
+    {
+        double variance;
+        std::uint32_t count;
+    };
+
+    SetVariance(std::uint32_t expected, std::uint32_t max);
+
+    /// - Parameter variance: Set to the variance when this arrival completes its set.
+    /// - Returns: True if this arrival completed its set.
+    bool Record(double key, double arrival, double& variance);
+
+    /// Sets flushed by the last `Record`.
+    std::size_t Flushed() const { return _flushedCount; }
+    const Flush& FlushedAt(std::size_t index) const { return _flushed[index]; }
+
+    std::size_t InFlight() const { return _inFlight; }
+
+private:
+    // Slot holding `key`, or of `_slots` if none.
+    std::size_t Find(double key) const;
+    void FlushOldest();
+
+    const std::uint32_t _expected;
+    const std::uint32_t _max;
+    const std::size_t _slots;
+    std::unique_ptr<double[]> _keys;
+    std::unique_ptr<double[]> _oldest;
+    std::unique_ptr<double[]> _newest;
+    std::unique_ptr<std::uint64_t[]> _started;
+    // 0 for a free slot.
+    std::unique_ptr<std::uint32_t[]> _counts;
+    std::unique_ptr<Flush[]> _flushed;
+    std::size_t _flushedCount = 0;
+    std::size_t _inFlight = 0;
+    std::uint64_t _sequence = 0;
+};
+
+#endif /* ArrivalStats_hh */
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef QArrivalStats_h
+#define QArrivalStats_h
+
+#import <Foundation/Foundation.h>
+
+#ifdef __cplusplus
+#include <memory>
+#include "ArrivalStats.hh"
+#endif
+
+/// Values that arrived within a window, using `SlidingWindow`.
+/// Lock free for one thread adding and one other expiring and copying.
+@interface QSlidingWindow : NSObject {
+#ifdef __cplusplus
+    std::unique_ptr<SlidingWindow> window;
+#endif
+}
+
+/// - Parameter capacity: Most values held. Values added beyond this are dropped.
+/// - Parameter length: How long a value stays in the window, in the units of its arrival.
+-(instancetype _Nonnull) initWithCapacity: (size_t) capacity length: (double) length;
+/// - Returns: False if full, and the value was dropped.
+-(BOOL) add: (double) arrival value: (double) value;
+/// Drop values that arrived more than the window length before `now`.
+/// - Returns: Values left.
+-(size_t) expire: (double) now;
+/// Copy held values, oldest first.
+/// - Returns: Values copied, at most `capacity`.
+-(size_t) read: (double* _Nonnull) values capacity: (size_t) capacity;
+-(uint64_t) dropped;
+
+@end
+
+/// Least delayed sample within a window, using `WindowMin`.
+/// Not thread safe.
+@interface QWindowMin : NSObject {
+#ifdef __cplusplus
+    std::unique_ptr<WindowMin> window;
+#endif
+}
+
+/// - Parameter capacity: Most samples held. Past this, the oldest are dropped before they expire.
+/// - Parameter length: Window length, in seconds.
+/// - Parameter secondsPerTick: Scale of arrivals.
+-(instancetype _Nonnull) initWithCapacity: (size_t) capacity
+                                   length: (double) length
+                           secondsPerTick: (double) secondsPerTick;
+/// Expire as of `arrival`, then add the sample.
+/// - Parameter arrival: Arrival time, in ticks.
+/// - Parameter timestamp: Sender timestamp, in seconds.
+-(void) push: (uint64_t) arrival timestamp: (double) timestamp;
+-(void) expire: (uint64_t) now;
+/// The sample with the smallest arrival less timestamp.
+/// - Returns: False if there are none.
+-(BOOL) min: (uint64_t* _Nonnull) arrival timestamp: (double* _Nonnull) timestamp;
+-(size_t) count;
+
+@end
+
+/// RFC 3550 interarrival jitter, using `JitterEstimator`.
+/// Record from one thread; values can be read from any.
+NS_SWIFT_SENDABLE
+@interface QJitterEstimator : NSObject {
+#ifdef __cplusplus
+    std::unique_ptr<JitterEstimator> estimator;
+#endif
+}
+
+/// - Parameter alpha: Smoothing factor applied to the jitter.
+-(instancetype _Nonnull) initWithAlpha: (double) alpha;
+/// - Returns: False for the first arrival, which only sets the baseline.
+-(BOOL) record: (double) timestamp arrival: (double) arrival;
+-(double) jitter;
+-(double) smoothed;
+
+@end
+
+/// Arrival spread of sets of objects sharing a key, using `SetVariance`.
+/// Not thread safe.
+@interface QSetVariance : NSObject {
+#ifdef __cplusplus
+    std::unique_ptr<SetVariance> variances;
+#endif
+}
+
+/// - Parameter expected: Arrivals that complete a set.
+/// - Parameter max: Sets in flight before the oldest half are flushed.
+-(instancetype _Nonnull) initWithExpected: (uint32_t) expected max: (uint32_t) max;
+/// - Parameter variance: Set to newest less oldest arrival when this arrival completes its set.
+/// - Returns: True if this arrival completed its set.
+-(BOOL) record: (double) key arrival: (double) arrival variance: (double* _Nonnull) variance;
+/// Incomplete sets flushed by the last record.
+-(size_t) flushed;
+-(double) flushedVariance: (size_t) index;
+-(uint32_t) flushedCount: (size_t) index;
+
+@end
+
+#endif /* QArrivalStats_h */
@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#import <Foundation/Foundation.h>
+#import "QArrivalStats.h"
+
+@implementation QSlidingWindow
+
+-(instancetype) initWithCapacity: (size_t) capacity length: (double) length {
+    self = [super init];
+    if (self) {
+        window = std::make_unique<SlidingWindow>(capacity, length);
+    }
+    return self;
+}
+
+-(BOOL) add: (double) arrival value: (double) value {
+    return window->Add(arrival, value);
+}
+
+-(size_t) expire: (double) now {
+    return window->Expire(now);
+}
+
+-(size_t) read: (double*) values capacity: (size_t) capacity {
+    return window->Copy(values, capacity);
+}
+
+-(uint64_t) dropped {
+    return window->Dropped();
+}
+
+@end
+
+@implementation QWindowMin
+
+-(instancetype) initWithCapacity: (size_t) capacity length: (double) length secondsPerTick: (double) secondsPerTick {
+    self = [super init];
+    if (self) {
+        window = std::make_unique<WindowMin>(capacity, length, secondsPerTick);
+    }
+    return self;
+}
+
+-(void) push: (uint64_t) arrival timestamp: (double) timestamp {
+    window->Push(static_cast<double>(arrival), timestamp);
+}
+
+-(void) expire: (uint64_t) now {
+    window->Expire(static_cast<double>(now));
+}
+
+-(BOOL) min: (uint64_t*) arrival timestamp: (double*) timestamp {
+    double ticks = 0;
+    if (!window->Min(ticks, *timestamp)) {
+        return false;
+    }
+    *arrival = static_cast<uint64_t>(ticks);
+    return true;
+}
+
+-(size_t) count {
+    return window->Count();
+}
+
+@end
+
+@implementation QJitterEstimator
+
+-(instancetype) initWithAlpha: (double) alpha {
+    self = [super init];
+    if (self) {
+        estimator = std::make_unique<JitterEstimator>(alpha);
+    }
+    return self;
+}
+
+-(BOOL) record: (double) timestamp arrival: (double) arrival {
+    return estimator->Record(timestamp, arrival);
+}
+
+-(double) jitter {
+    return estimator->Jitter();
+}
+
+-(double) smoothed {
+    return estimator->Smoothed();
+}
+
+@end
+
+@implementation QSetVariance
+
+-(instancetype) initWithExpected: (uint32_t) expected max: (uint32_t) max {
+    self = [super init];
+    if (self) {
+        variances = std::make_unique<SetVariance>(expected, max);
+    }
+    return self;
+}
+
+-(BOOL) record: (double) key arrival: (double) arrival variance: (double*) variance {
+    return variances->Record(key, arrival, *variance);
+}
+
+-(size_t) flushed {
+    return variances->Flushed();
+}
+
+-(double) flushedVariance: (size_t) index {
+    return variances->FlushedAt(index).variance;
+}
+
+-(uint32_t) flushedCount: (size_t) index {
+    return variances->FlushedAt(index).count;
+}
+
+@end
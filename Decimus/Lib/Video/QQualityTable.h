@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef QQualityTable_h
+#define QQualityTable_h
+
+#import <Foundation/Foundation.h>
+
+#ifdef __cplusplus
+#include <memory>
+#include "QualityTable.hh"
+#endif
+
+/// The latest decoded frame of each quality layer of a simulreceive set, using `QualityTable`.
+/// Each layer is updated lock free by one decoder. Deciding, and reading the decision, is for one
+/// scheduling thread.
+NS_SWIFT_SENDABLE
+@interface QQualityTable : NSObject {
+#ifdef __cplusplus
+    std::unique_ptr<QualityTable> table;
+    QualityTable::Decision decision;
+#endif
+}
+
+/// - Parameter layers: Number of layers, in descending order of configured width. At most 32.
+-(instancetype _Nullable) initWithLayers: (size_t) layers;
+
+/// Publish a layer's newly decoded frame.
+/// - Parameter pts: Presentation timestamp, in microseconds.
+-(void) update: (size_t) layer pts: (int64_t) pts width: (uint32_t) width discontinuous: (bool) discontinuous;
+
+/// Choose a frame from those pending, newer than `after`: of those at the oldest timestamp, the widest,
+/// preferring those that aren't discontinuous.
+/// - Returns: False if nothing is pending.
+-(BOOL) decide: (int64_t) after;
+/// Mark the shortlisted frames of the last decision as used.
+-(void) consume;
+
+// The last decision.
+-(size_t) selected;
+-(BOOL) onlyChoice;
+-(BOOL) pristine;
+-(int64_t) pts;
+/// Bit per layer with a frame at the decided timestamp.
+-(uint32_t) shortlist;
+-(uint32_t) width: (size_t) layer;
+/// A pending layer with a frame of `width`, or -1.
+-(NSInteger) pendingWithWidth: (uint32_t) width;
+
+@end
+
+#endif /* QQualityTable_h */
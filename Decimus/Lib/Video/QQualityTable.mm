@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#import <Foundation/Foundation.h>
+#import "QQualityTable.h"
+
+@implementation QQualityTable
+
+-(instancetype) initWithLayers: (size_t) layers {
+    if (layers > QualityTable::kMaxLayers) {
+        return nil;
+    }
+    self = [super init];
+    if (self) {
+        table = std::make_unique<QualityTable>(layers);
+    }
+    return self;
+}
+
+-(void) update: (size_t) layer pts: (int64_t) pts width: (uint32_t) width discontinuous: (bool) discontinuous {
+    table->Update(layer, { pts, width, discontinuous });
+}
+
+-(BOOL) decide: (int64_t) after {
+    return table->Decide(after, decision);
+}
+
+-(void) consume {
+    table->Consume(decision);
+}
+
+-(size_t) selected {
+    return decision.selected;
+}
+
+-(BOOL) onlyChoice {
+    return decision.onlyChoice;
+}
+
+-(BOOL) pristine {
+    return decision.pristine;
+}
+
+-(int64_t) pts {
+    return decision.pts;
+}
+
+-(uint32_t) shortlist {
+    return decision.shortlist;
+}
+
+-(uint32_t) width: (size_t) layer {
+    return decision.frames[layer].width;
+}
+
+-(NSInteger) pendingWithWidth: (uint32_t) width {
+    size_t layer = 0;
+    if (!QualityTable::PendingWithWidth(decision, width, layer)) {
+        return -1;
+    }
+    return static_cast<NSInteger>(layer);
+}
+
+@end
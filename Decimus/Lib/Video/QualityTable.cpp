@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "QualityTable.hh"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+std::size_t CheckedLayers(std::size_t layers)
+{
+    if (layers > QualityTable::kMaxLayers) {
+        throw std::invalid_argument("Too many quality layers");
+    }
+    return layers;
+}
+}
+
+QualityTable::QualityTable(std::size_t layers)
+    : _layers(CheckedLayers(layers)),
+      _slots(new Slot[std::max<std::size_t>(layers, 1)])
+{
+    _consumed.fill(std::numeric_limits<std::int64_t>::min());
+}
+
+void QualityTable::Update(std::size_t layer, const Frame& frame)
+{
+    auto& slot = _slots[layer];
+    const auto sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.pts.store(frame.pts, std::memory_order_relaxed);
+    slot.width.store(frame.width, std::memory_order_relaxed);
+    slot.discontinuous.store(frame.discontinuous, std::memory_order_relaxed);
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool QualityTable::Read(std::size_t layer, Frame& frame) const
+{
+    const auto& slot = _slots[layer];
+    while (true) {
+        const auto before = slot.sequence.load(std::memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+        if (before & 1) {
+            continue;
+        }
+        frame.pts = slot.pts.load(std::memory_order_relaxed);
+        frame.width = slot.width.load(std::memory_order_relaxed);
+        frame.discontinuous = slot.discontinuous.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+}
+
+bool QualityTable::Decide(std::int64_t after, Decision& decision) const
+{
+    decision.pending = 0;
+    decision.shortlist = 0;
+    auto oldest = std::numeric_limits<std::int64_t>::max();
+    std::size_t count = 0;
+    for (std::size_t layer = 0; layer < _layers; ++layer) {
+        auto& frame = decision.frames[layer];
+        if (!Read(layer, frame) || frame.pts <= after || frame.pts <= _consumed[layer]) {
+            continue;
+        }
+        decision.pending |= 1u << layer;
+        oldest = std::min(oldest, frame.pts);
+        ++count;
+    }
+    if (count == 0) {
+        return false;
+    }
+
+    // Of the frames at the oldest timestamp, the widest that isn't discontinuous, or else the widest.
+    decision.pts = oldest;
+    decision.onlyChoice = count == 1;
+    std::size_t widest = _layers;
+    std::size_t widestPristine = _layers;
+    for (std::size_t layer = 0; layer < _layers; ++layer) {
+        const auto& frame = decision.frames[layer];
+        if (!(decision.pending & (1u << layer)) || frame.pts != oldest) {
+            continue;
+        }
+        decision.shortlist |= 1u << layer;
+        if (widest == _layers || frame.width > decision.frames[widest].width) {
+            widest = layer;
+        }
+        if (!frame.discontinuous &&
+            (widestPristine == _layers || frame.width > decision.frames[widestPristine].width)) {
+            widestPristine = layer;
+        }
+    }
+    decision.pristine = widestPristine != _layers;
+    decision.selected = decision.pristine ? widestPristine : widest;
+    return true;
+}
+
+void QualityTable::Consume(const Decision& decision)
+{
+    for (std::size_t layer = 0; layer < _layers; ++layer) {
+        if (decision.shortlist & (1u << layer)) {
+            _consumed[layer] = decision.frames[layer].pts;
+        }
+    }
+}
+
+bool QualityTable::PendingWithWidth(const Decision& decision, std::uint32_t width, std::size_t& layer)
+{
+    for (std::size_t index = 0; index < kMaxLayers; ++index) {
+        if ((decision.pending & (1u << index)) && decision.frames[index].width == width) {
+            layer = index;
+            return true;
+        }
+    }
+    return false;
+}
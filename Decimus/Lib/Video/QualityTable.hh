@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef QualityTable_hh
+#define QualityTable_hh
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/// The latest decoded frame of each quality layer of a simulreceive set, for choosing which to display.
+///
+/// Layers are fixed at creation, in descending order of configured width, which breaks ties between equal
+/// widths. Each layer is published by its decoder with `Update`, lock free (a per layer sequence lock, so a
+/// reader never sees a torn frame and a writer never waits). `Decide` and `Consume` are for a single
+/// scheduling thread.
+class QualityTable
+{
+public:
+    static constexpr std::size_t kMaxLayers = 32;
+
+    struct Frame
+    {
+        /// Presentation timestamp, in microseconds.
+        std::int64_t pts = 0;
+        std::uint32_t width = 0;
+        bool discontinuous = false;
+    };
+
+    struct Decision
+    {
+        /// Snapshot of every layer's frame, valid where `pending` is set.
+        std::array<Frame, kMaxLayers> frames;
+        /// Layers with a frame newer than both the last shown and the last consumed.
+        std::uint32_t pending = 0;
+        /// Pending layers whose frame is at the oldest pending timestamp.
+        std::uint32_t shortlist = 0;
+        /// The widest of `shortlist`, preferring those that aren't discontinuous.
+        std::size_t selected = 0;
+        /// Only one layer was pending.
+        bool onlyChoice = false;
+        /// The selected frame isn't discontinuous.
+        bool pristine = false;
+        /// Timestamp of the shortlisted frames.
+        std::int64_t pts = 0;
+    };
+
+    /// - Throws std::invalid_argument: If there are more than `kMaxLayers` layers.
+    explicit QualityTable(std::size_t layers);
+
+    QualityTable(const QualityTable&) = delete;
+    QualityTable& operator=(const QualityTable&) = delete;
+
+    std::size_t Layers() const { return _layers; }
+
+    /// Publish a layer's newly decoded frame. One writer per layer.
+    void Update(std::size_t layer, const Frame& frame);
+
+    /// The latest frame of a layer.
+    /// - Returns: False if it has none yet.
+    bool Read(std::size_t layer, Frame& frame) const;
+
+    /// Choose a frame from those pending, newer than `after`: of those at the oldest timestamp, the widest.
+    /// - Returns: False if nothing is pending.
+    bool Decide(std::int64_t after, Decision& decision) const;
+
+    /// Mark the shortlisted frames of `decision` as used, so they are never pending again.
+    void Consume(const Decision& decision);
+
+    /// A pending layer of `decision` with a frame of `width`, the first in layer order.
+    /// - Returns: False if there are none.
+    static bool PendingWithWidth(const Decision& decision, std::uint32_t width, std::size_t& layer);
+
+private:
+    // A cache line each, so decoders publishing different layers don't contend.
+    struct alignas(64) Slot
+    {
+        // Odd while being written; 0 until first written.
+        std::atomic<std::uint32_t> sequence{ 0 };
+        std::atomic<std::int64_t> pts{ 0 };
+        std::atomic<std::uint32_t> width{ 0 };
+        std::atomic<bool> discontinuous{ false };
+    };
+
+    const std::size_t _layers;
+    std::unique_ptr<Slot[]> _slots;
+    // Timestamp of each layer's last consumed frame. Scheduler only.
+    std::array<std::int64_t, kMaxLayers> _consumed;
+};
+
+#endif /* QualityTable_hh */
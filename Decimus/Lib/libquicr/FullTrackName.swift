@@ -79,6 +79,9 @@ func moqDecodeTuple(_ string: Substring) throws -> Data {
 }
 
 /// A MoQ full track name identifies a track within a namespace.
+///
+/// Names are interned: every instance of the same name, here or handed out by libquicr, carries the same
+/// ``trackId``, so comparing and hashing names is an integer operation.
 final class FullTrackName: QFullTrackName, Hashable, CustomStringConvertible, Sendable {
     /// Serialized representation per MoQ encoding (RFC Section 1.5).
     var description: String {
@@ -88,19 +91,21 @@ final class FullTrackName: QFullTrackName, Hashable, CustomStringConvertible, Se
     }
 
     static func == (lhs: FullTrackName, rhs: FullTrackName) -> Bool {
-        lhs.nameSpace == rhs.nameSpace && lhs.name == rhs.name
+        lhs.trackId == rhs.trackId
     }
 
     /// The namespace portion of the full track name.
     let nameSpace: [Data]
     /// The name portion of the full track name.
     let name: Data
+    /// Interned identifier shared with the Objective-C representation, which equality and hashing use.
+    let trackId: UInt64
 
     /// Construct a full track name from UTF8 string components.
     /// - Parameter namespace: UTF8 string namespace array.
     /// - Parameter name: UTF8 string name.
     /// - Throws: ``FullTrackNameError/parseError`` if strings are not UTF8.
-    init(namespace: [String], name: String) throws {
+    convenience init(namespace: [String], name: String) throws {
         var components: [Data] = []
         for element in namespace {
             guard let bytes = element.data(using: .utf8) else {
@@ -108,21 +113,27 @@ final class FullTrackName: QFullTrackName, Hashable, CustomStringConvertible, Se
             }
             components.append(bytes)
         }
-        self.nameSpace = components
         guard let nameData = name.data(using: .utf8) else {
             throw FullTrackNameError.parseError
         }
-        self.name = nameData
+        self.init(nameSpace: components, name: nameData)
     }
 
+    /// Construct a full track name from its binary components.
+    convenience init(nameSpace: [Data], name: Data) {
+        self.init(QFullTrackNameImpl.intern(nameSpace: nameSpace, name: name))
+    }
+
+    /// Construct from another representation of an already interned name.
     init(_ ftn: QFullTrackName) {
         self.nameSpace = ftn.nameSpace
         self.name = ftn.name
+        self.trackId = ftn.trackId
     }
 
     /// Parse a serialized MoQ name string (RFC Section 1.5) back into a FullTrackName.
     /// - Throws: ``FullTrackNameError/invalidEncoding`` on malformed input.
-    init(serialized: String) throws {
+    convenience init(serialized: String) throws {
         // Split on "--" to separate namespace from track name.
         guard let separatorRange = serialized.range(of: "--") else {
             throw FullTrackNameError.invalidEncoding
@@ -135,13 +146,11 @@ final class FullTrackName: QFullTrackName, Hashable, CustomStringConvertible, Se
         let tuples = nsPart.split(separator: "-", omittingEmptySubsequences: false)
         guard !tuples.isEmpty else { throw FullTrackNameError.invalidEncoding }
 
-        self.nameSpace = try tuples.map { try moqDecodeTuple($0) }
-        self.name = try moqDecodeTuple(namePart)
+        self.init(nameSpace: try tuples.map { try moqDecodeTuple($0) }, name: try moqDecodeTuple(namePart))
     }
 
     func hash(into hasher: inout Hasher) {
-        hasher.combine(self.name)
-        hasher.combine(self.nameSpace)
+        hasher.combine(self.trackId)
     }
 
     func matchesPrefix(_ prefix: NamespacePrefix) -> Bool {
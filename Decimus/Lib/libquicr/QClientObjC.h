@@ -44,10 +44,14 @@ NS_SWIFT_SENDABLE
 - (QClientStatus)disconnect;
 - (void)publishTrackWithHandler:(QPublishTrackHandlerObjC * _Nonnull)handler;
 - (void)unpublishTrackWithHandler:(QPublishTrackHandlerObjC * _Nonnull)handler;
+/// Publish many tracks in one call, as when joining. The same as publishing each in turn, which never waits on a response.
+- (void)publishTracksWithHandlers:(NSArray<QPublishTrackHandlerObjC *> * _Nonnull)handlers;
 - (void)publishNamespace:(NSData * _Nonnull)trackNamespace;
 - (void)publishNamespaceDone:(NSData * _Nonnull)trackNamespace;
 - (void)subscribeTrackWithHandler:(QSubscribeTrackHandlerObjC * _Nonnull)handler;
 - (void)unsubscribeTrackWithHandler:(QSubscribeTrackHandlerObjC * _Nonnull)handler;
+/// Subscribe to many tracks in one call, as when joining. The same as subscribing to each in turn, which never waits on a SUBSCRIBE_OK.
+- (void)subscribeTracksWithHandlers:(NSArray<QSubscribeTrackHandlerObjC *> * _Nonnull)handlers;
 - (void)fetchTrackWithHandler:(QFetchTrackHandlerObjC * _Nonnull)handler;
 - (void)cancelFetchTrackWithHandler:(QFetchTrackHandlerObjC * _Nonnull)handler;
 - (QPublishNamespaceStatus)getPublishNamespaceStatus:(NSData * _Nonnull)trackNamespace;
@@ -7,6 +7,7 @@
 #include <memory>
 #include <iostream>
 #include <map>
+#include <vector>
 #include "TransportConfig.h"
 #include "quicr/handlers/subscribe_namespace_handler.h"
 
@@ -123,6 +124,26 @@ static quicr::PublishResponse convert(QPublishResponse response, QPublishAttribu
     }
 }
 
+-(void)publishTracksWithHandlers: (NSArray<QPublishTrackHandlerObjC*>*) trackHandlers
+{
+    assert(qClientPtr);
+    std::vector<std::shared_ptr<quicr::PublishTrackHandler>> handlers;
+    handlers.reserve(trackHandlers.count);
+    for (QPublishTrackHandlerObjC* trackHandler in trackHandlers)
+    {
+        if (trackHandler->handlerPtr)
+        {
+            handlers.push_back(std::static_pointer_cast<quicr::PublishTrackHandler>(trackHandler->handlerPtr));
+        }
+    }
+
+    // This only saves a call from Swift per track: each publish returns without waiting on a response anyway.
+    for (const auto& handler : handlers)
+    {
+        qClientPtr->PublishTrack(handler);
+    }
+}
+
 -(void)unpublishTrackWithHandler: (QPublishTrackHandlerObjC*) trackHandler
 {
     assert(qClientPtr);
@@ -143,6 +164,26 @@ static quicr::PublishResponse convert(QPublishResponse response, QPublishAttribu
     }
 }
 
+-(void)subscribeTracksWithHandlers: (NSArray<QSubscribeTrackHandlerObjC*>*) trackHandlers
+{
+    assert(qClientPtr);
+    std::vector<std::shared_ptr<quicr::SubscribeTrackHandler>> handlers;
+    handlers.reserve(trackHandlers.count);
+    for (QSubscribeTrackHandlerObjC* trackHandler in trackHandlers)
+    {
+        if (trackHandler->handlerPtr)
+        {
+            handlers.push_back(std::static_pointer_cast<quicr::SubscribeTrackHandler>(trackHandler->handlerPtr));
+        }
+    }
+
+    // This only saves a call from Swift per track: each subscribe returns without waiting on SUBSCRIBE_OK anyway.
+    for (const auto& handler : handlers)
+    {
+        qClientPtr->SubscribeTrack(handler);
+    }
+}
+
 -(void)unsubscribeTrackWithHandler: (QSubscribeTrackHandlerObjC*) trackHandler
 {
     assert(qClientPtr);
@@ -65,6 +65,10 @@ typedef struct QObjectHeaders {
 
 #ifdef __cplusplus
 #include <quicr/messages/messages.h>
+#include "FlatExtensions.hh"
+#import "QPayloadPool.h"
+#include <algorithm>
+#include <vector>
 
 [[maybe_unused]]
 static QStreamHeaderProperties* _Nullable convertStreamHeaderProperties(const std::optional<quicr::messages::StreamHeaderProperties>& props) {
@@ -86,23 +90,75 @@ static quicr::messages::StreamHeaderProperties convertStreamHeaderProperties(QSt
     };
 }
 
+/// Encode extensions into the flat layout described in FlatExtensions.hh, backed by a pooled buffer.
 [[maybe_unused]]
-static NSMutableDictionary<NSNumber*, NSArray<NSData*>*>* _Nullable convertExtensions(const std::optional<quicr::Extensions>& extensions) {
-    if (!extensions.has_value()) {
+static NSData* _Nullable convertExtensions(const std::optional<quicr::Extensions>& extensions) {
+    if (!extensions.has_value() || extensions->empty()) {
         return nil;
     }
 
-    NSMutableDictionary<NSNumber*, NSArray<NSData*>*>* result = [NSMutableDictionary dictionary];
+    std::size_t entries = 0;
+    std::size_t valueBytes = 0;
     for (const auto& kvps : *extensions) {
-        NSNumber* key = @(kvps.first);
-        NSMutableArray<NSData*>* dataArray = [NSMutableArray arrayWithCapacity:kvps.second.size()];
-        for (const auto& kvp : kvps.second) {
-            NSData* data = [[NSData alloc] initWithBytesNoCopy:(void*)kvp.data() length:kvp.size() deallocator:nil];
-            [dataArray addObject:data];
+        entries += kvps.second.size();
+        for (const auto& value : kvps.second) {
+            valueBytes += value.size();
         }
-        [result setObject:dataArray forKey:key];
     }
-    return result;
+
+    thread_local std::vector<std::uint8_t> scratch;
+    FlatExtensionsWriter writer(scratch, entries, valueBytes);
+    for (const auto& kvps : *extensions) {
+        for (const auto& value : kvps.second) {
+            writer.Add(kvps.first, value.data(), value.size());
+        }
+    }
+    writer.Finish();
+    return pooledData(PayloadAllocator::Shared()->Acquire(scratch.data(), scratch.size()));
+}
+
+/// Decode flat extensions into existing storage, reusing its map nodes and vector capacity.
+[[maybe_unused]]
+static void convertExtensions(NSData* _Nullable flat, std::optional<quicr::Extensions>& out) {
+    const FlatExtensionsView view(reinterpret_cast<const std::uint8_t*>(flat.bytes), flat.length);
+    if (view.Count() == 0) {
+        out.reset();
+        return;
+    }
+    if (!out.has_value()) {
+        out.emplace();
+    }
+
+    // Count values per key in this object, then resize and fill each key's values in place.
+    thread_local std::vector<std::pair<std::uint64_t, std::size_t>> counts;
+    counts.clear();
+    for (std::size_t index = 0; index < view.Count(); index++) {
+        const auto key = view.At(index).key;
+        auto found = std::find_if(counts.begin(), counts.end(), [key](const auto& count) { return count.first == key; });
+        if (found == counts.end()) {
+            counts.emplace_back(key, 1);
+        } else {
+            found->second++;
+        }
+    }
+    for (auto it = out->begin(); it != out->end();) {
+        const auto key = it->first;
+        if (std::none_of(counts.begin(), counts.end(), [key](const auto& count) { return count.first == key; })) {
+            it = out->erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto& [key, count] : counts) {
+        auto& values = (*out)[key];
+        values.resize(count);
+        count = 0;
+    }
+    for (std::size_t index = 0; index < view.Count(); index++) {
+        const auto entry = view.At(index);
+        auto found = std::find_if(counts.begin(), counts.end(), [&entry](const auto& count) { return count.first == entry.key; });
+        (*out)[entry.key][found->second++].assign(entry.data, entry.data + entry.length);
+    }
 }
 #endif
 
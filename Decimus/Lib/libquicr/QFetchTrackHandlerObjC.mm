@@ -5,8 +5,12 @@
 #import "QSubscribeTrackHandlerObjC.h"
 #import "QFetchTrackHandlerObjC.h"
 #import "QCommon.h"
+#import "QPayloadPool.h"
 
-@implementation QFetchTrackHandlerObjC : NSObject
+@implementation QFetchTrackHandlerObjC : NSObject {
+    // Interned, so fetching it is free and it compares by identifier.
+    QFullTrackNameImpl* _fullTrackName;
+}
 
 -(id _Nonnull) initWithFullTrackName: (id<QFullTrackName> _Nonnull) full_track_name
                             priority: (uint8_t) priority
@@ -14,7 +18,7 @@
                        startLocation: (id<QLocation> _Nonnull) start_location
                          endLocation: (id<QFetchEndLocation> _Nonnull) end_location
 {
-    quicr::FullTrackName fullTrackName = ftnConvert(full_track_name);
+    const quicr::FullTrackName& fullTrackName = ftnConvert(full_track_name);
     std::optional<quicr::messages::GroupOrder> order;
     if (groupOrder != kQGroupOrderOriginalPublisherOrder) {
         order = static_cast<quicr::messages::GroupOrder>(groupOrder);
@@ -35,6 +39,7 @@
                                                       order,
                                                       startLocation,
                                                       endLocation);
+    _fullTrackName = ftnConvert(fullTrackName);
     return self;
 }
 
@@ -45,8 +50,8 @@
 }
 
 -(id<QFullTrackName>) getFullTrackName {
-    assert(handlerPtr);
-    return ftnConvert(handlerPtr->GetFullTrackName());
+    assert(_fullTrackName);
+    return _fullTrackName;
 }
 
 -(uint8_t) getPriority {
@@ -135,9 +140,10 @@ void QFetchTrackHandler::ObjectReceived(const quicr::ObjectHeaders& object_heade
         const auto extensions = convertExtensions(object_headers.extensions);
         const auto immutableExtensions = convertExtensions(object_headers.immutable_extensions);
 
-        NSData* nsData = [[NSData alloc] initWithBytesNoCopy:(void*)data.data() length:data.size() deallocator:nil];
+        // Copy once into a pooled slot that lives as long as any consumer retains the data.
+        NSData* nsData = pooledData(_payloads->Acquire(data.data(), data.size()));
 
-        [_callbacks objectReceived:headers data:nsData extensions:extensions immutableExtensions:immutableExtensions streamHeaderProperties:convertStreamHeaderProperties(stream_mode)];
+        [_callbacks objectReceived:headers data:nsData flatExtensions:extensions flatImmutableExtensions:immutableExtensions streamHeaderProperties:convertStreamHeaderProperties(stream_mode)];
     }
 }
 
@@ -168,8 +174,8 @@ void QFetchTrackHandler::PartialObjectReceived(const quicr::ObjectHeaders& objec
         const auto extensions = convertExtensions(object_headers.extensions);
         const auto immutableExtensions = convertExtensions(object_headers.immutable_extensions);
 
-        NSData* nsData = [[NSData alloc] initWithBytesNoCopy:(void*)data.data() length:data.size() deallocator:nil];
-        [_callbacks partialObjectReceived:headers data:nsData extensions:extensions immutableExtensions:immutableExtensions];
+        NSData* nsData = pooledData(_payloads->Acquire(data.data(), data.size()));
+        [_callbacks partialObjectReceived:headers data:nsData flatExtensions:extensions flatImmutableExtensions:immutableExtensions];
     }
 }
 
@@ -15,12 +15,20 @@ typedef NSArray<NSData*>* _Nonnull QTrackNamespace;
 @protocol QFullTrackName
 @property (readonly, strong) QName name;
 @property (readonly, strong) QTrackNamespace nameSpace;
+/// Interned identifier. Equal names have equal identifiers, and 0 is never used.
+@property (readonly) uint64_t trackId;
 @end
 
+/// The single, shared representation of an interned full track name.
+NS_SWIFT_SENDABLE
 @interface QFullTrackNameImpl: NSObject<QFullTrackName>
-@property (strong) QName name;
-@property (strong) QTrackNamespace nameSpace;
--(instancetype _Nonnull) initWithNamespace: (QTrackNamespace) nameSpace name: (QName) name;
+@property (readonly, strong) QName name;
+@property (readonly, strong) QTrackNamespace nameSpace;
+@property (readonly) uint64_t trackId;
+-(instancetype _Nonnull) init NS_UNAVAILABLE;
+/// The shared representation of a name, interning it on first sight.
++(QFullTrackNameImpl* _Nonnull) internNamespace: (QTrackNamespace) nameSpace
+                                           name: (QName) name NS_SWIFT_NAME(intern(nameSpace:name:));
 @end
 
 #ifdef __cplusplus
@@ -35,14 +43,13 @@ static QTrackNamespace nsConvert(const quicr::TrackNamespace& nameSpace) {
     return tuple;
 }
 
+[[maybe_unused]]
 static QName nameConvert(const std::vector<std::uint8_t> name) {
     return [[NSData alloc] initWithBytes:(void*)name.data() length:name.size()];
 }
 
-[[maybe_unused]]
-static id<QFullTrackName> _Nonnull ftnConvert(const quicr::FullTrackName& ftn) {
-    return [[QFullTrackNameImpl alloc] initWithNamespace:nsConvert(ftn.name_space) name:nameConvert(ftn.name)];
-}
+/// The interned representation of a libquicr name.
+QFullTrackNameImpl* _Nonnull ftnConvert(const quicr::FullTrackName& ftn);
 
 static quicr::TrackNamespace nsConvert(QTrackNamespace qNamespace) {
     std::vector<std::vector<std::uint8_t>> tuple;
@@ -53,18 +60,14 @@ static quicr::TrackNamespace nsConvert(QTrackNamespace qNamespace) {
     return tuple;
 }
 
+[[maybe_unused]]
 static std::vector<std::uint8_t> nameConvert(QName qName) {
     const auto nameBytes = reinterpret_cast<const std::uint8_t*>(qName.bytes);
     return { nameBytes, nameBytes + qName.length };
 }
 
-[[maybe_unused]]
-static quicr::FullTrackName ftnConvert(id<QFullTrackName> _Nonnull qFtn) {
-    return {
-        .name_space = nsConvert(qFtn.nameSpace),
-        .name = nameConvert(qFtn.name)
-    };
-}
+/// The libquicr form of a name, shared with every other use of it.
+const quicr::FullTrackName& ftnConvert(id<QFullTrackName> _Nonnull qFtn);
 #endif
 
 #endif
@@ -2,13 +2,89 @@
 // SPDX-License-Identifier: BSD-2-Clause
 
 #import "QFullTrackName.h"
+#include "TrackNameTable.hh"
+
+@interface QFullTrackNameImpl ()
+-(instancetype _Nonnull) initWithId: (uint64_t) trackId nameSpace: (QTrackNamespace) nameSpace name: (QName) name;
+@end
+
+namespace {
+struct InternedName {
+    QFullTrackNameImpl* objc;
+    quicr::FullTrackName cpp;
+};
+
+TrackNameTable<InternedName>& Table() {
+    // Never destroyed, as names may be converted during teardown.
+    static auto* table = new TrackNameTable<InternedName>();
+    return *table;
+}
+
+TrackNameKey& ScratchKey() {
+    thread_local TrackNameKey key;
+    return key;
+}
+
+const TrackNameTable<InternedName>::Entry& Intern(const TrackNameKey& key, const quicr::FullTrackName& ftn) {
+    return Table().Intern(key, [&](std::uint64_t trackId) {
+        // Built from the libquicr form, so the shared representation never aliases a caller's mutable data.
+        QFullTrackNameImpl* objc = [[QFullTrackNameImpl alloc] initWithId:trackId
+                                                               nameSpace:nsConvert(ftn.name_space)
+                                                                    name:nameConvert(ftn.name)];
+        return InternedName { .objc = objc, .cpp = ftn };
+    });
+}
+
+const TrackNameTable<InternedName>::Entry& Intern(QTrackNamespace nameSpace, QName name) {
+    auto& key = ScratchKey();
+    key.Reset(nameSpace.count);
+    for (NSData* element in nameSpace) {
+        key.Append(reinterpret_cast<const std::uint8_t*>(element.bytes), element.length);
+    }
+    key.Append(reinterpret_cast<const std::uint8_t*>(name.bytes), name.length);
+    return Table().Intern(key, [&](std::uint64_t trackId) {
+        quicr::FullTrackName cpp = {
+            .name_space = nsConvert(nameSpace),
+            .name = nameConvert(name)
+        };
+        QFullTrackNameImpl* objc = [[QFullTrackNameImpl alloc] initWithId:trackId
+                                                               nameSpace:nsConvert(cpp.name_space)
+                                                                    name:nameConvert(cpp.name)];
+        return InternedName { .objc = objc, .cpp = std::move(cpp) };
+    });
+}
+}
 
 @implementation QFullTrackNameImpl
 
--(instancetype _Nonnull) initWithNamespace: (QTrackNamespace) nameSpace name: (QName) name {
-    self.nameSpace = nameSpace;
-    self.name = name;
+-(instancetype _Nonnull) initWithId: (uint64_t) trackId nameSpace: (QTrackNamespace) nameSpace name: (QName) name {
+    self = [super init];
+    _trackId = trackId;
+    _nameSpace = [nameSpace copy];
+    _name = name;
     return self;
 }
 
++(QFullTrackNameImpl* _Nonnull) internNamespace: (QTrackNamespace) nameSpace name: (QName) name {
+    return Intern(nameSpace, name).value.objc;
+}
+
 @end
+
+QFullTrackNameImpl* _Nonnull ftnConvert(const quicr::FullTrackName& ftn) {
+    auto& key = ScratchKey();
+    const auto& entries = ftn.name_space.GetEntries();
+    key.Reset(entries.size());
+    for (const auto& element : entries) {
+        key.Append(element.data(), element.size());
+    }
+    key.Append(ftn.name.data(), ftn.name.size());
+    return Intern(key, ftn).value.objc;
+}
+
+const quicr::FullTrackName& ftnConvert(id<QFullTrackName> _Nonnull qFtn) {
+    if (const auto* entry = Table().Find(qFtn.trackId)) {
+        return entry->value.cpp;
+    }
+    return Intern(qFtn.nameSpace, qFtn.name).value.cpp;
+}
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef QPublishBatch_h
+#define QPublishBatch_h
+
+#ifdef __cplusplus
+#include "QPublishTrackHandler.h"
+#include <memory>
+#include <vector>
+#endif
+
+#import <Foundation/Foundation.h>
+#import "QCommon.h"
+#import "QPublishTrackHandlerObjC.h"
+
+#ifdef __cplusplus
+/// One converted object waiting to be published.
+struct QPublishBatchEntry {
+    std::shared_ptr<QPublishTrackHandler> handler;
+    quicr::ObjectHeaders headers;
+    quicr::BytesSpan payload;
+    std::optional<quicr::messages::StreamHeaderProperties> streamMode;
+};
+#endif
+
+/// A reusable batch of objects to publish, on one or many tracks.
+/// Objects are converted to libquicr headers as they are added, into storage that is kept across batches,
+/// so a steady state publisher doesn't reallocate headers or extension vectors per object.
+/// Payloads are referenced, not copied, and retained until the batch is published or cleared.
+/// Not thread safe: use one batch per publishing context.
+@interface QPublishBatch : NSObject
+{
+#ifdef __cplusplus
+    std::vector<QPublishBatchEntry> _entries;
+    size_t _count;
+    NSMutableArray<NSData*>* _payloads;
+#endif
+}
+
+-(instancetype _Nonnull) initWithCapacity: (size_t) capacity;
+-(void) addObject: (QObjectHeaders) objectHeaders
+             data: (NSData* _Nonnull) data
+       extensions: (NSData* _Nullable) extensions
+immutableExtensions: (NSData* _Nullable) immutableExtensions
+streamHeaderProperties: (QStreamHeaderProperties* _Nullable) streamHeaderProperties
+          handler: (QPublishTrackHandlerObjC* _Nonnull) handler;
+/// Publish every object in order, then clear the batch.
+/// - Parameter statuses: Optional array of at least `count` entries receiving each object's status.
+/// - Returns: The number of objects published with an OK status.
+-(size_t) publish: (QPublishObjectStatus* _Nullable) statuses;
+-(size_t) count;
+-(void) clear;
+@end
+
+#endif /* QPublishBatch_h */
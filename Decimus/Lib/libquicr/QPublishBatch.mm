@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#import <Foundation/Foundation.h>
+#import "QPublishBatch.h"
+#include <iostream>
+
+@implementation QPublishBatch
+
+-(instancetype) initWithCapacity: (size_t) capacity {
+    self = [super init];
+    if (self) {
+        _entries.resize(capacity);
+        _count = 0;
+        _payloads = [NSMutableArray arrayWithCapacity:capacity];
+    }
+    return self;
+}
+
+-(void) addObject: (QObjectHeaders) objectHeaders
+             data: (NSData* _Nonnull) data
+       extensions: (NSData* _Nullable) extensions
+immutableExtensions: (NSData* _Nullable) immutableExtensions
+streamHeaderProperties: (QStreamHeaderProperties* _Nullable) streamHeaderProperties
+          handler: (QPublishTrackHandlerObjC* _Nonnull) handler {
+    assert(handler->handlerPtr);
+    if (_count == _entries.size()) {
+        _entries.resize(_entries.empty() ? 1 : _entries.size() * 2);
+    }
+    auto& entry = _entries[_count++];
+    entry.handler = handler->handlerPtr;
+
+    auto& headers = entry.headers;
+    headers.group_id = objectHeaders.groupId;
+    headers.subgroup_id = objectHeaders.subgroupId;
+    headers.object_id = objectHeaders.objectId;
+    headers.payload_length = objectHeaders.payloadLength;
+    headers.status = static_cast<quicr::ObjectStatus>(objectHeaders.status);
+    if (objectHeaders.priority != nullptr) {
+        headers.priority = *objectHeaders.priority;
+    } else {
+        headers.priority = std::nullopt;
+    }
+    if (objectHeaders.ttl != nullptr) {
+        headers.ttl = *objectHeaders.ttl;
+    } else {
+        headers.ttl = std::nullopt;
+    }
+    convertExtensions(extensions, headers.extensions);
+    convertExtensions(immutableExtensions, headers.immutable_extensions);
+
+    [_payloads addObject:data];
+    entry.payload = quicr::BytesSpan { reinterpret_cast<const std::uint8_t*>(data.bytes), data.length };
+
+    if (streamHeaderProperties != nil) {
+        entry.streamMode.emplace(convertStreamHeaderProperties(streamHeaderProperties));
+    } else {
+        entry.streamMode.reset();
+    }
+}
+
+-(size_t) publish: (QPublishObjectStatus* _Nullable) statuses {
+    size_t published = 0;
+    for (size_t index = 0; index < _count; index++) {
+        auto& entry = _entries[index];
+        QPublishObjectStatus status;
+        try {
+            status = static_cast<QPublishObjectStatus>(entry.handler->PublishObject(entry.headers,
+                                                                                   entry.payload,
+                                                                                   entry.streamMode));
+        } catch (const std::exception& e) {
+            std::cerr << "Exception in publish batch: " << e.what() << std::endl;
+            status = kQPublishObjectStatusInternalError;
+        }
+        if (status == kQPublishObjectStatusOk) {
+            published++;
+        }
+        if (statuses != nullptr) {
+            statuses[index] = status;
+        }
+    }
+    [self clear];
+    return published;
+}
+
+-(size_t) count {
+    return _count;
+}
+
+-(void) clear {
+    // Keep the converted storage for reuse, but don't hold on to handlers or payloads.
+    for (size_t index = 0; index < _count; index++) {
+        _entries[index].handler.reset();
+        _entries[index].payload = {};
+    }
+    _count = 0;
+    [_payloads removeAllObjects];
+}
+
+@end
@@ -48,15 +48,18 @@ NS_SWIFT_SENDABLE
 
 -(id _Nonnull) initWithFullTrackName: (id<QFullTrackName> _Nonnull) full_track_name trackMode: (QTrackMode) track_mode defaultPriority: (uint8_t) priority defaultTTL: (uint32_t) ttl callbacks: (id<QPublishTrackHandlerCallbacks> _Nonnull) callbacks;
 -(id<QFullTrackName> _Nonnull) getFullTrackName;
+/// Extensions are passed in the flat encoding described in FlatExtensions.hh.
 -(QPublishObjectStatus)publishObject: (QObjectHeaders) objectHeaders
                                 data: (NSData* _Nonnull) data
-                          extensions: (NSDictionary<NSNumber*, NSArray<NSData*>*>* _Nullable) extensions
-                 immutableExtensions: (NSDictionary<NSNumber*, NSArray<NSData*>*>* _Nullable) immutableExtensions
+                          extensions: (NSData* _Nullable) extensions
+                 immutableExtensions: (NSData* _Nullable) immutableExtensions
               streamHeaderProperties: (QStreamHeaderProperties* _Nullable) streamHeaderProperties;
+/// Publish the next piece of an object. The first piece's headers give the whole object's payload length, and
+/// the object is complete once that many bytes have been published. Stream mode only.
 -(QPublishObjectStatus)publishPartialObject: (QObjectHeaders) objectHeaders
                                        data: (NSData* _Nonnull) data
-                                 extensions: (NSDictionary<NSNumber*, NSArray<NSData*>*>* _Nullable) extensions
-                        immutableExtensions: (NSDictionary<NSNumber*, NSArray<NSData*>*>* _Nullable) immutableExtensions;
+                                 extensions: (NSData* _Nullable) extensions
+                        immutableExtensions: (NSData* _Nullable) immutableExtensions;
 -(void) endSubgroup: (uint64_t) groupId
          subgroupId: (uint64_t) subgroupId
           completed: (bool) completed;
@@ -6,46 +6,29 @@
 #import "QCommon.h"
 #include <iostream>
 
-@implementation QPublishTrackHandlerObjC : NSObject
+@implementation QPublishTrackHandlerObjC : NSObject {
+    // Interned, so fetching it is free and it compares by identifier.
+    QFullTrackNameImpl* _fullTrackName;
+}
 
 -(id) initWithFullTrackName: (id<QFullTrackName>) full_track_name trackMode: (QTrackMode) track_mode defaultPriority: (uint8_t) priority defaultTTL: (uint32_t) ttl callbacks: (id<QPublishTrackHandlerCallbacks>) callbacks
 {
-    quicr::FullTrackName fullTrackName = ftnConvert(full_track_name);
+    const quicr::FullTrackName& fullTrackName = ftnConvert(full_track_name);
     quicr::TrackMode moqTrackMode = (quicr::TrackMode)track_mode;
     handlerPtr = std::make_shared<QPublishTrackHandler>(fullTrackName, moqTrackMode, priority, ttl);
+    _fullTrackName = ftnConvert(fullTrackName);
     handlerPtr->SetCallbacks(callbacks);
     return self;
 }
 
 -(id<QFullTrackName>) getFullTrackName {
-    assert(handlerPtr);
-    return ftnConvert(handlerPtr->GetFullTrackName());
-}
-
-std::optional<quicr::Extensions> from(NSDictionary<NSNumber*, NSArray<NSData*>*>* _Nullable extensions) {
-    std::optional<quicr::Extensions> moqExtensions;
-    if (extensions == nil || extensions.count == 0) {
-        moqExtensions = std::nullopt;
-    } else {
-        quicr::Extensions built;
-        for (NSNumber* number in extensions) {
-            NSArray<NSData*>* values = extensions[number];
-            std::vector<std::vector<std::uint8_t>> dataValues;
-            for (NSData* value in values) {
-                const auto* ptr = reinterpret_cast<const std::uint8_t*>(value.bytes);
-                dataValues.push_back(std::vector<std::uint8_t>(ptr, ptr + value.length));
-            }
-            built[number.unsignedLongLongValue] = dataValues;
-        }
-        // TODO: Move?
-        moqExtensions = built;
-    }
-    return moqExtensions;
+    assert(_fullTrackName);
+    return _fullTrackName;
 }
 
 quicr::ObjectHeaders from(QObjectHeaders objectHeaders,
-                          NSDictionary<NSNumber*, NSArray<NSData*>*>* _Nullable extensions,
-                          NSDictionary<NSNumber*, NSArray<NSData*>*>* _Nullable immutable_extensions) {
+                          NSData* _Nullable extensions,
+                          NSData* _Nullable immutable_extensions) {
     std::optional<std::uint8_t> priority;
     if (objectHeaders.priority != nullptr) {
         priority = *objectHeaders.priority;
@@ -60,6 +43,11 @@ quicr::ObjectHeaders from(QObjectHeaders objectHeaders,
         ttl = std::nullopt;
     }
 
+    std::optional<quicr::Extensions> moqExtensions;
+    convertExtensions(extensions, moqExtensions);
+    std::optional<quicr::Extensions> moqImmutableExtensions;
+    convertExtensions(immutable_extensions, moqImmutableExtensions);
+
     return quicr::ObjectHeaders {
         .group_id = objectHeaders.groupId,
         .subgroup_id = objectHeaders.subgroupId,
@@ -68,15 +56,15 @@ quicr::ObjectHeaders from(QObjectHeaders objectHeaders,
         .ttl = ttl,
         .payload_length = objectHeaders.payloadLength,
         .status = static_cast<quicr::ObjectStatus>(objectHeaders.status),
-        .extensions = from(extensions),
-        .immutable_extensions = from(immutable_extensions),
+        .extensions = std::move(moqExtensions),
+        .immutable_extensions = std::move(moqImmutableExtensions),
     };
 }
 
 -(QPublishObjectStatus)publishObject: (QObjectHeaders) objectHeaders
                                 data: (NSData* _Nonnull) data
-                          extensions: (NSDictionary<NSNumber*, NSArray<NSData*>*>* _Nullable) extensions
-                 immutableExtensions: (NSDictionary<NSNumber*, NSArray<NSData*>*>* _Nullable) immutableExtensions
+                          extensions: (NSData* _Nullable) extensions
+                 immutableExtensions: (NSData* _Nullable) immutableExtensions
               streamHeaderProperties: (QStreamHeaderProperties*) streamHeaderProperties
 {
     assert(handlerPtr);
@@ -98,16 +86,16 @@ quicr::ObjectHeaders from(QObjectHeaders objectHeaders,
 
 -(QPublishObjectStatus)publishPartialObject: (QObjectHeaders) objectHeaders
                                        data: (NSData* _Nonnull) data
-                                 extensions:(NSDictionary<NSNumber*, NSArray<NSData*>*>* _Nullable) extensions
-                        immutableExtensions:(NSDictionary<NSNumber*, NSArray<NSData*>*>* _Nullable) immutableExtensions {
+                                 extensions:(NSData* _Nullable) extensions
+                        immutableExtensions:(NSData* _Nullable) immutableExtensions {
     assert(handlerPtr);
     quicr::ObjectHeaders headers = from(objectHeaders, extensions, immutableExtensions);
     auto* ptr = reinterpret_cast<const std::uint8_t*>([data bytes]);
     quicr::BytesSpan span { ptr, data.length };
     // TODO: PublishPartialObject is not implemented in libquicr!
-    abort();
     // auto status = handlerPtr->PublishPartialObject(headers, span);
     // return static_cast<QPublishObjectStatus>(status);
+    return kQPublishObjectStatusInternalError;
 }
 
 -(void) endSubgroup: (uint64_t) groupId
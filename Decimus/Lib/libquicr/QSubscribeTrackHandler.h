@@ -7,6 +7,7 @@
 #include "quicr/handlers/subscribe_track_handler.h"
 #include "quicr/track_name.h"
 #import "QSubscribeTrackHandlerCallbacks.h"
+#include "PayloadPool.hh"
 
 class QSubscribeTrackHandler : public quicr::SubscribeTrackHandler
 {
@@ -29,6 +30,7 @@ public:
 
 private:
     __weak id<QSubscribeTrackHandlerCallbacks> _callbacks;
+    std::shared_ptr<PayloadAllocator> _payloads = PayloadAllocator::Shared();
 };
 
 #endif /* QSubscribeTrackHandler_h */
@@ -26,14 +26,15 @@ typedef struct QSubscribeTrackMetrics {
 
 @protocol QSubscribeTrackHandlerCallbacks
 - (void) statusChanged: (QSubscribeTrackHandlerStatus) status;
+/// Extensions are passed in the flat encoding described in FlatExtensions.hh.
 - (void) objectReceived: (QObjectHeaders) objectHeaders
                    data: (NSData* _Nonnull) data
-             extensions: (NSDictionary<NSNumber*, NSArray<NSData*>*>* _Nullable) extensions
-    immutableExtensions: (NSDictionary<NSNumber*, NSArray<NSData*>*>* _Nullable) immutableExtensions
-              streamHeaderProperties: (QStreamHeaderProperties* _Nullable) streamHeaderProperties;
+         flatExtensions: (NSData* _Nullable) extensions
+flatImmutableExtensions: (NSData* _Nullable) immutableExtensions
+ streamHeaderProperties: (QStreamHeaderProperties* _Nullable) streamHeaderProperties;
 - (void) partialObjectReceived: (QObjectHeaders) objectHeaders
                           data: (NSData* _Nonnull) data
-                    extensions: (NSDictionary<NSNumber*, NSArray<NSData*>*>* _Nullable) extensions
-           immutableExtensions: (NSDictionary<NSNumber*, NSArray<NSData*>*>* _Nullable) immutableExtensions;
+                flatExtensions: (NSData* _Nullable) extensions
+       flatImmutableExtensions: (NSData* _Nullable) immutableExtensions;
 - (void) metricsSampled: (QSubscribeTrackMetrics) metrics;
 @end
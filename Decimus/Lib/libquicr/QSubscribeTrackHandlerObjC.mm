@@ -4,17 +4,22 @@
 #import <Foundation/Foundation.h>
 #import "QSubscribeTrackHandlerObjC.h"
 #import "QCommon.h"
+#import "QPayloadPool.h"
 
-@implementation QSubscribeTrackHandlerObjC : NSObject
+@implementation QSubscribeTrackHandlerObjC : NSObject {
+    // Interned, so fetching it is free and it compares by identifier.
+    QFullTrackNameImpl* _fullTrackName;
+}
 
 -(id) initWithFullTrackName: (id<QFullTrackName>) full_track_name priority:(uint8_t)priority groupOrder:(QGroupOrder)groupOrder publisherInitiated:(BOOL)publisherInitiated
 {
-    quicr::FullTrackName fullTrackName = ftnConvert(full_track_name);
+    const quicr::FullTrackName& fullTrackName = ftnConvert(full_track_name);
     std::optional<quicr::messages::GroupOrder> order;
     if (groupOrder != kQGroupOrderOriginalPublisherOrder) {
         order = static_cast<quicr::messages::GroupOrder>(groupOrder);
     }
     handlerPtr = std::make_shared<QSubscribeTrackHandler>(fullTrackName, priority, order, std::nullopt, publisherInitiated);
+    _fullTrackName = ftnConvert(fullTrackName);
     return self;
 }
 
@@ -30,8 +35,8 @@
 }
 
 -(id<QFullTrackName>) getFullTrackName {
-    assert(handlerPtr);
-    return ftnConvert(handlerPtr->GetFullTrackName());
+    assert(_fullTrackName);
+    return _fullTrackName;
 }
 
 -(uint8_t) getPriority {
@@ -161,9 +166,10 @@ void QSubscribeTrackHandler::ObjectReceived(const quicr::ObjectHeaders& object_h
         // Convert extensions.
         auto extensions = convertExtensions(object_headers.extensions);
         auto immutable = convertExtensions(object_headers.immutable_extensions);
-        NSData* nsData = [[NSData alloc] initWithBytesNoCopy:(void*)data.data() length:data.size() deallocator:nil];
+        // Copy once into a pooled slot that lives as long as any consumer retains the data.
+        NSData* nsData = pooledData(_payloads->Acquire(data.data(), data.size()));
 
-        [_callbacks objectReceived:headers data:nsData extensions:extensions immutableExtensions:immutable streamHeaderProperties:convertStreamHeaderProperties(stream_mode)];
+        [_callbacks objectReceived:headers data:nsData flatExtensions:extensions flatImmutableExtensions:immutable streamHeaderProperties:convertStreamHeaderProperties(stream_mode)];
     }
 }
 
@@ -193,8 +199,8 @@ void QSubscribeTrackHandler::PartialObjectReceived(const quicr::ObjectHeaders& o
         const auto extensions = convertExtensions(object_headers.extensions);
         const auto immutable = convertExtensions(object_headers.immutable_extensions);
 
-        NSData* nsData = [[NSData alloc] initWithBytesNoCopy:(void*)data.data() length:data.size() deallocator:nil];
-        [_callbacks partialObjectReceived:headers data:nsData extensions:extensions immutableExtensions:immutable];
+        NSData* nsData = pooledData(_payloads->Acquire(data.data(), data.size()));
+        [_callbacks partialObjectReceived:headers data:nsData flatExtensions:extensions flatImmutableExtensions:immutable];
     }
 }
 
@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef TrackNameTable_hh
+#define TrackNameTable_hh
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// Canonical bytes of a full track name: the namespace tuple count, each tuple and then the name, each
+/// length prefixed so that no two distinct names share a key. Reusable, so building a key to look up an
+/// already interned name doesn't allocate.
+class TrackNameKey
+{
+public:
+    /// Start a new key.
+    /// - Parameter tuples: Number of namespace tuples that will be appended before the name.
+    void Reset(std::size_t tuples)
+    {
+        _bytes.clear();
+        AppendLength(tuples);
+    }
+
+    /// Append the next namespace tuple or, last, the name.
+    void Append(const std::uint8_t* bytes, std::size_t length)
+    {
+        AppendLength(length);
+        _bytes.insert(_bytes.end(), bytes, bytes + length);
+    }
+
+    /// 64 bit FNV-1a of the key.
+    std::uint64_t Hash() const
+    {
+        std::uint64_t hash = 0xcbf29ce484222325;
+        for (const auto byte : _bytes) {
+            hash = (hash ^ byte) * 0x100000001b3;
+        }
+        return hash;
+    }
+
+    const std::vector<std::uint8_t>& Bytes() const { return _bytes; }
+
+private:
+    void AppendLength(std::size_t length)
+    {
+        const auto value = static_cast<std::uint32_t>(length);
+        std::uint8_t bytes[sizeof(value)];
+        std::memcpy(bytes, &value, sizeof(value));
+        _bytes.insert(_bytes.end(), bytes, bytes + sizeof(value));
+    }
+
+    std::vector<std::uint8_t> _bytes;
+};
+
+/// Interns full track names, giving every distinct name a stable identifier and one shared, immutable `Value`.
+///
+/// Identifiers are dense, starting at 1, so 0 never names a track. Entries live as long as the table; the
+/// names a client sees are bounded by its catalog, so nothing is evicted. Lookups of known names, by key or
+/// by identifier, only take a shared lock.
+template<typename Value>
+class TrackNameTable
+{
+public:
+    struct Entry
+    {
+        std::uint64_t id;
+        Value value;
+        std::vector<std::uint8_t> key;
+    };
+
+    /// The entry for `key`, creating its value with `make(id)` if this is the first time the name has been seen.
+    template<typename Make>
+    const Entry& Intern(const TrackNameKey& key, Make&& make)
+    {
+        const auto hash = key.Hash();
+        {
+            std::shared_lock lock(_mutex);
+            if (const auto* found = FindLocked(key, hash)) {
+                return *found;
+            }
+        }
+        std::unique_lock lock(_mutex);
+        // Another thread may have added it in between.
+        if (const auto* found = FindLocked(key, hash)) {
+            return *found;
+        }
+        const auto id = static_cast<std::uint64_t>(_entries.size()) + 1;
+        // Deque growth never moves existing entries, so returned references stay valid.
+        _entries.push_back({ id, make(id), key.Bytes() });
+        _index.emplace(hash, id);
+        return _entries.back();
+    }
+
+    /// The entry with identifier `id`, or null if there is none.
+    const Entry* Find(std::uint64_t id) const
+    {
+        std::shared_lock lock(_mutex);
+        if (id == 0 || id > _entries.size()) {
+            return nullptr;
+        }
+        return &_entries[id - 1];
+    }
+
+    std::size_t Size() const
+    {
+        std::shared_lock lock(_mutex);
+        return _entries.size();
+    }
+
+private:
+    const Entry* FindLocked(const TrackNameKey& key, std::uint64_t hash) const
+    {
+        const auto [begin, end] = _index.equal_range(hash);
+        for (auto it = begin; it != end; ++it) {
+            const auto& entry = _entries[it->second - 1];
+            if (entry.key == key.Bytes()) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    mutable std::shared_mutex _mutex;
+    std::deque<Entry> _entries;
+    // Key hash to identifier. A multimap, as distinct keys may collide.
+    std::unordered_multimap<std::uint64_t, std::uint64_t> _index;
+};
+
+#endif /* TrackNameTable_hh */
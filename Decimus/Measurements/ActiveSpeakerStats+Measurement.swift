@@ -1,6 +1,10 @@
 // SPDX-FileCopyrightText: Copyright (c) 2023 Cisco Systems
 // SPDX-License-Identifier: BSD-2-Clause
 
+private extension MetricField {
+    static let events = MetricField("events")
+}
+
 extension ActiveSpeakerStats {
     final class ActiveSpeakerStatsMeasurement: MetricsMeasurement {
         let storage = MeasurementStorage()
@@ -8,10 +12,10 @@ extension ActiveSpeakerStats {
         let tags: [String: String] = [:]
 
         func record(identifier: ParticipantId, timestamp: Date, event: CurrentState) {
-            record(field: "events",
-                   value: event.description as AnyObject,
+            record(field: .events,
+                   value: event.description,
                    timestamp: timestamp,
-                   tags: ["participant": "\(identifier.participantId)"])
+                   tags: .dynamic(["participant": "\(identifier.participantId)"]))
         }
     }
 }
@@ -4,6 +4,10 @@
 import Foundation
 import Synchronization
 
+private extension MetricField {
+    static let sequence = MetricField("sequence")
+}
+
 final class ActivityTransitionMeasurement: MetricsMeasurement {
     let storage = MeasurementStorage()
     let name = "activity_transition"
@@ -12,9 +16,9 @@ final class ActivityTransitionMeasurement: MetricsMeasurement {
 
     func record(participant: String, direction: String, timestamp: Date) {
         let val = sequence.wrappingAdd(1, ordering: .relaxed).newValue
-        record(field: "sequence",
-               value: val as AnyObject,
+        record(field: .sequence,
+               value: val,
                timestamp: timestamp,
-               tags: ["participant": participant, "direction": direction])
+               tags: .dynamic(["participant": participant, "direction": direction]))
     }
 }
@@ -3,11 +3,28 @@
 
 import Synchronization
 
+private extension MetricField {
+    static let txLostPkts = MetricField("tx_lost_pkts")
+    static let txDgramLost = MetricField("tx_dgram_lost")
+    static let txTimerLosses = MetricField("tx_timer_losses")
+    static let txSpuriousLosses = MetricField("tx_spurious_losses")
+    static let txRetransmits = MetricField("tx_retransmits")
+    static let txCongested = MetricField("tx_congested")
+    static let cwinCongested = MetricField("cwin_congested")
+    static let prevCwinCongested = MetricField("prev_cwin_congested")
+    static let rxDgrams = MetricField("rx_dgrams")
+    static let rxDgramsBytes = MetricField("rx_dgrams_bytes")
+    static let txDgramCb = MetricField("tx_dgram_cb")
+    static let txDgramAck = MetricField("tx_dgram_ack")
+    static let txDgramSpurious = MetricField("tx_dgram_spurious")
+    static let txDgramDrops = MetricField("tx_dgram_drops")
+}
+
 extension MetricsMeasurement {
     func record(_ prefix: String, values: QMinMaxAvg, time: Date) {
-        self.record(field: "\(prefix)_min", value: values.min as AnyObject, timestamp: time)
-        self.record(field: "\(prefix)_max", value: values.max as AnyObject, timestamp: time)
-        self.record(field: "\(prefix)_avg", value: values.avg as AnyObject, timestamp: time)
+        self.record(field: MetricField("\(prefix)_min"), value: values.min, timestamp: time)
+        self.record(field: MetricField("\(prefix)_max"), value: values.max, timestamp: time)
+        self.record(field: MetricField("\(prefix)_avg"), value: values.avg, timestamp: time)
     }
 }
 
@@ -35,25 +52,25 @@ extension MoqCallController {
         func record(_ metrics: QConnectionMetrics) {
             let time = Date.now
             self.record("rtt_us", values: metrics.quic.rtt_us, time: time)
-            self.record(field: "tx_lost_pkts", value: metrics.quic.tx_lost_pkts as AnyObject, timestamp: time)
-            self.record(field: "tx_dgram_lost", value: metrics.quic.tx_dgram_lost as AnyObject, timestamp: time)
-            self.record(field: "tx_timer_losses", value: metrics.quic.tx_timer_losses as AnyObject, timestamp: time)
-            self.record(field: "tx_spurious_losses", value: metrics.quic.tx_spurious_losses as AnyObject, timestamp: time)
-            self.record(field: "tx_retransmits", value: metrics.quic.tx_retransmits as AnyObject, timestamp: time)
-            self.record(field: "tx_congested", value: metrics.quic.tx_congested as AnyObject, timestamp: time)
+            self.record(field: .txLostPkts, value: metrics.quic.tx_lost_pkts, timestamp: time)
+            self.record(field: .txDgramLost, value: metrics.quic.tx_dgram_lost, timestamp: time)
+            self.record(field: .txTimerLosses, value: metrics.quic.tx_timer_losses, timestamp: time)
+            self.record(field: .txSpuriousLosses, value: metrics.quic.tx_spurious_losses, timestamp: time)
+            self.record(field: .txRetransmits, value: metrics.quic.tx_retransmits, timestamp: time)
+            self.record(field: .txCongested, value: metrics.quic.tx_congested, timestamp: time)
             self.record("tx_rate_bps", values: metrics.quic.tx_rate_bps, time: time)
             self.record("tx_cwin_bytes", values: metrics.quic.tx_cwin_bytes, time: time)
             self.record("tx_in_transit_bytes", values: metrics.quic.tx_in_transit_bytes, time: time)
-            self.record(field: "cwin_congested", value: metrics.quic.cwin_congested as AnyObject, timestamp: time)
-            self.record(field: "prev_cwin_congested", value: metrics.quic.prev_cwin_congested as AnyObject, timestamp: time)
+            self.record(field: .cwinCongested, value: metrics.quic.cwin_congested, timestamp: time)
+            self.record(field: .prevCwinCongested, value: metrics.quic.prev_cwin_congested, timestamp: time)
             self.record("rx_rate_bps", values: metrics.quic.rx_rate_bps, time: time)
             self.record("stt_us", values: metrics.quic.srtt_us, time: time)
-            self.record(field: "rx_dgrams", value: metrics.quic.rx_dgrams as AnyObject, timestamp: time)
-            self.record(field: "rx_dgrams_bytes", value: metrics.quic.rx_dgrams_bytes as AnyObject, timestamp: time)
-            self.record(field: "tx_dgram_cb", value: metrics.quic.tx_dgram_cb as AnyObject, timestamp: time)
-            self.record(field: "tx_dgram_ack", value: metrics.quic.tx_dgram_ack as AnyObject, timestamp: time)
-            self.record(field: "tx_dgram_spurious", value: metrics.quic.tx_dgram_spurious as AnyObject, timestamp: time)
-            self.record(field: "tx_dgram_drops", value: metrics.quic.tx_dgram_drops as AnyObject, timestamp: time)
+            self.record(field: .rxDgrams, value: metrics.quic.rx_dgrams, timestamp: time)
+            self.record(field: .rxDgramsBytes, value: metrics.quic.rx_dgrams_bytes, timestamp: time)
+            self.record(field: .txDgramCb, value: metrics.quic.tx_dgram_cb, timestamp: time)
+            self.record(field: .txDgramAck, value: metrics.quic.tx_dgram_ack, timestamp: time)
+            self.record(field: .txDgramSpurious, value: metrics.quic.tx_dgram_spurious, timestamp: time)
+            self.record(field: .txDgramDrops, value: metrics.quic.tx_dgram_drops, timestamp: time)
         }
     }
 }
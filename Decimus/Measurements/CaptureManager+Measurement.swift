@@ -3,6 +3,13 @@
 
 import Synchronization
 
+private extension MetricField {
+    static let droppedFrames = MetricField("droppedFrames")
+    static let capturedFrames = MetricField("capturedFrames")
+    static let timestamp = MetricField("timestamp")
+    static let pressureState = MetricField("pressureState")
+}
+
 extension CaptureManager {
     final class CaptureManagerMeasurement: MetricsMeasurement {
         let storage = MeasurementStorage()
@@ -13,19 +20,19 @@ extension CaptureManager {
 
         func droppedFrame(timestamp: Date?) {
             let val = dropped.wrappingAdd(1, ordering: .relaxed).newValue
-            record(field: "droppedFrames", value: val as AnyObject, timestamp: timestamp)
+            record(field: .droppedFrames, value: val, timestamp: timestamp)
         }
 
         func capturedFrame(frameTimestamp: TimeInterval, metricsTimestamp: Date?) {
             let val = capturedFrames.wrappingAdd(1, ordering: .relaxed).newValue
-            record(field: "capturedFrames", value: val as AnyObject, timestamp: metricsTimestamp)
+            record(field: .capturedFrames, value: val, timestamp: metricsTimestamp)
             if let metricsTimestamp = metricsTimestamp {
-                record(field: "timestamp", value: frameTimestamp as AnyObject, timestamp: metricsTimestamp)
+                record(field: .timestamp, value: frameTimestamp, timestamp: metricsTimestamp)
             }
         }
 
         func pressureStateChanged(level: Int, metricsTimestamp: Date) {
-            record(field: "pressureState", value: level as AnyObject, timestamp: metricsTimestamp)
+            record(field: .pressureState, value: level, timestamp: metricsTimestamp)
         }
     }
 }
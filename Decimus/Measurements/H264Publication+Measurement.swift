@@ -3,6 +3,17 @@
 
 import Synchronization
 
+private extension MetricField {
+    static let sentBytes = MetricField("sentBytes")
+    static let publishedFrames = MetricField("publishedFrames")
+    static let timestamp = MetricField("timestamp")
+    static let publishedAge = MetricField("publishedAge")
+    static let sentPixels = MetricField("sentPixels")
+    static let age = MetricField("age")
+    static let encodedAge = MetricField("encodedAge")
+    static let audioActivity = MetricField("audioActivity")
+}
+
 extension H264Publication {
     final class VideoPublicationMeasurement: MetricsMeasurement {
         let storage = MeasurementStorage()
@@ -16,34 +27,51 @@ extension H264Publication {
             self.tags = ["namespace": namespace]
         }
 
-        func sentFrame(bytes: UInt64, timestamp: TimeInterval, age: TimeInterval?, metricsTimestamp: Date?) {
+        /// A published frame's metrics, as one point.
+        func sentFrame(bytes: UInt64,
+                       timestamp: TimeInterval,
+                       age: TimeInterval?,
+                       activity: UInt8?,
+                       metricsTimestamp: Date?) {
             let frameVal = publishedFrames.wrappingAdd(1, ordering: .relaxed).newValue
             let byteVal = self.bytes.wrappingAdd(bytes, ordering: .relaxed).newValue
-            record(field: "sentBytes", value: byteVal as AnyObject, timestamp: metricsTimestamp)
-            record(field: "publishedFrames", value: frameVal as AnyObject, timestamp: metricsTimestamp)
-            if let metricsTimestamp = metricsTimestamp {
-                record(field: "timestamp", value: timestamp as AnyObject, timestamp: metricsTimestamp)
+            var values: [MetricValue] = [.init(.sentBytes, byteVal), .init(.publishedFrames, frameVal)]
+            if metricsTimestamp != nil {
+                values.append(.init(.timestamp, timestamp))
                 assert(age != nil)
-                record(field: "publishedAge", value: age as AnyObject, timestamp: metricsTimestamp)
+                if let age {
+                    values.append(.init(.publishedAge, age))
+                }
+                if let activity {
+                    values.append(.init(.audioActivity, activity))
+                }
             }
+            record(values, timestamp: metricsTimestamp)
         }
 
-        func sentPixels(sent: UInt64, timestamp: Date?) {
-            let val = pixels.wrappingAdd(sent, ordering: .relaxed).newValue
-            record(field: "sentPixels", value: val as AnyObject, timestamp: timestamp)
-        }
-
-        func age(age: TimeInterval, presentationTimestamp: TimeInterval, metricsTimestamp: Date) {
-            let tags = ["timestamp": "\(presentationTimestamp)"]
-            record(field: "age", value: age as AnyObject, timestamp: metricsTimestamp, tags: tags)
+        /// A captured frame's metrics, as one point. The age and activity are only recorded with a timestamp.
+        func capturedFrame(pixels: UInt64,
+                           age: TimeInterval,
+                           presentationTimestamp: TimeInterval,
+                           activity: UInt8?,
+                           metricsTimestamp: Date?) {
+            let pixelVal = self.pixels.wrappingAdd(pixels, ordering: .relaxed).newValue
+            guard let metricsTimestamp else {
+                record(field: .sentPixels, value: pixelVal, timestamp: nil)
+                return
+            }
+            var values: [MetricValue] = [.init(.sentPixels, pixelVal), .init(.age, age)]
+            if let activity {
+                values.append(.init(.audioActivity, activity))
+            }
+            // The presentation timestamp tags the whole point, so it's encoded once per frame.
+            record(values,
+                   timestamp: metricsTimestamp,
+                   tags: .dynamic(["timestamp": "\(presentationTimestamp)"]))
         }
 
         func encoded(age: TimeInterval, timestamp: Date) {
-            record(field: "encodedAge", value: age as AnyObject, timestamp: timestamp)
-        }
-
-        func audioActivity(_ value: UInt8, timestamp: Date) {
-            record(field: "audioActivity", value: value as AnyObject, timestamp: timestamp)
+            record(field: .encodedAge, value: age, timestamp: timestamp)
         }
     }
 }
@@ -3,6 +3,16 @@
 
 import Synchronization
 
+private extension MetricField {
+    static let currentDepth = MetricField("currentDepth")
+    static let targetDepth = MetricField("targetDepth")
+    static let adjustment = MetricField("adjustment")
+    static let underruns = MetricField("underruns")
+    static let writes = MetricField("writes")
+    static let flushed = MetricField("flushed")
+    static let reads = MetricField("reads")
+}
+
 extension JitterBuffer {
     final class JitterBufferMeasurement: MetricsMeasurement {
         let storage = MeasurementStorage()
@@ -13,6 +23,9 @@ extension JitterBuffer {
         private let writes = Atomic<UInt64>(0)
         private let flushedCount = Atomic<UInt64>(0)
         private let pausedWaitTime = Mutex<Bool>(false)
+        // Negative when a frame is already late.
+        private let waitTimes = LatencyHistogram("waitTime", range: -10...10)
+        var histograms: [LatencyHistogram] { [self.waitTimes] }
 
         init(namespace: QuicrNamespace) {
             self.tags = ["namespace": namespace]
@@ -23,26 +36,26 @@ extension JitterBuffer {
                   depth.truncatingRemainder(dividingBy: 1) != 0 else {
                 return
             }
-            record(field: "currentDepth", value: UInt32(depth * 1000) as AnyObject, timestamp: timestamp)
-            self.record(field: "targetDepth", value: target, timestamp: timestamp)
+            record(field: .currentDepth, value: UInt32(depth * 1000), timestamp: timestamp)
+            self.record(field: .targetDepth, value: target, timestamp: timestamp)
             if adjustment > 0 {
-                self.record(field: "adjustment", value: adjustment, timestamp: timestamp)
+                self.record(field: .adjustment, value: adjustment, timestamp: timestamp)
             }
         }
 
         func underrun(timestamp: Date?) {
             let val = underruns.wrappingAdd(1, ordering: .relaxed).newValue
-            record(field: "underruns", value: val as AnyObject, timestamp: timestamp)
+            record(field: .underruns, value: val, timestamp: timestamp)
         }
 
         func write(timestamp: Date?) {
             let val = writes.wrappingAdd(1, ordering: .relaxed).newValue
-            record(field: "writes", value: val as AnyObject, timestamp: timestamp)
+            record(field: .writes, value: val, timestamp: timestamp)
         }
 
         func flushed(count: UInt, timestamp: Date?) {
             let val = flushedCount.wrappingAdd(UInt64(count), ordering: .relaxed).newValue
-            record(field: "flushed", value: val as AnyObject, timestamp: timestamp)
+            record(field: .flushed, value: val, timestamp: timestamp)
         }
 
         func waitTime(value: TimeInterval, timestamp: Date?) {
@@ -54,12 +67,12 @@ extension JitterBuffer {
                 return false
             }
             guard !paused else { return }
-            record(field: "waitTime", value: value as AnyObject, timestamp: timestamp)
+            self.waitTimes.record(value, timestamp: timestamp, into: self)
         }
 
         func read(timestamp: Date?) {
             let val = reads.wrappingAdd(1, ordering: .relaxed).newValue
-            record(field: "reads", value: val as AnyObject, timestamp: timestamp)
+            record(field: .reads, value: val, timestamp: timestamp)
         }
     }
 }
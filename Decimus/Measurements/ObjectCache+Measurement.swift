@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Foundation
+import Synchronization
+
+private extension MetricField {
+    static let hits = MetricField("hits")
+    static let misses = MetricField("misses")
+    static let evictions = MetricField("evictions")
+    static let bytes = MetricField("bytes")
+}
+
+extension ObjectCache {
+    final class ObjectCacheMeasurement: MetricsMeasurement {
+        let storage = MeasurementStorage()
+        let name = "ObjectCache"
+        let tags: [String: String] = [:]
+        private let hits = Atomic<UInt64>(0)
+        private let misses = Atomic<UInt64>(0)
+        private let evictions = Atomic<UInt64>(0)
+
+        func lookup(hit: Bool, timestamp: Date?) {
+            if hit {
+                let val = self.hits.wrappingAdd(1, ordering: .relaxed).newValue
+                record(field: .hits, value: val, timestamp: timestamp)
+            } else {
+                let val = self.misses.wrappingAdd(1, ordering: .relaxed).newValue
+                record(field: .misses, value: val, timestamp: timestamp)
+            }
+        }
+
+        func evicted(count: Int, bytes: Int, timestamp: Date?) {
+            let val = self.evictions.wrappingAdd(UInt64(count), ordering: .relaxed).newValue
+            record(field: .evictions, value: val, timestamp: timestamp)
+            record(field: .bytes, value: bytes, timestamp: timestamp)
+        }
+    }
+}
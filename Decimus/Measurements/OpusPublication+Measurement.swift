@@ -3,6 +3,14 @@
 
 import Synchronization
 
+private extension MetricField {
+    static let publishedBytes = MetricField("publishedBytes")
+    static let publishedFrames = MetricField("publishedFrames")
+    static let encode = MetricField("encode")
+    static let audioActivity = MetricField("audioActivity")
+    static let voiceActive = MetricField("voiceActive")
+}
+
 extension OpusPublication {
     final class OpusPublicationMeasurement: MetricsMeasurement {
         let storage = MeasurementStorage()
@@ -18,17 +26,17 @@ extension OpusPublication {
         func publishedBytes(sentBytes: Int, timestamp: Date?) {
             let frameVal = frames.wrappingAdd(1, ordering: .relaxed).newValue
             let byteVal = bytes.wrappingAdd(UInt64(sentBytes), ordering: .relaxed).newValue
-            record(field: "publishedBytes", value: byteVal as AnyObject, timestamp: timestamp)
-            record(field: "publishedFrames", value: frameVal as AnyObject, timestamp: timestamp)
+            record(field: .publishedBytes, value: byteVal, timestamp: timestamp)
+            record(field: .publishedFrames, value: frameVal, timestamp: timestamp)
         }
 
         func encode(_ count: Int, timestamp: Date) {
-            record(field: "encode", value: count as AnyObject, timestamp: timestamp)
+            record(field: .encode, value: count, timestamp: timestamp)
         }
 
         func audioActivity(_ value: UInt8, voiceActive: Bool, timestamp: Date) {
-            record(field: "audioActivity", value: value as AnyObject, timestamp: timestamp)
-            record(field: "voiceActive", value: (voiceActive ? 1 : 0) as AnyObject, timestamp: timestamp)
+            record(field: .audioActivity, value: value, timestamp: timestamp)
+            record(field: .voiceActive, value: voiceActive ? 1 : 0, timestamp: timestamp)
         }
     }
 }
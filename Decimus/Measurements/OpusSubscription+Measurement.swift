@@ -4,6 +4,26 @@
 import AVFAudio
 import Synchronization
 
+private extension MetricField {
+    static let receivedFrames = MetricField("receivedFrames")
+    static let receivedBytes = MetricField("receivedBytes")
+    static let missingSeqs = MetricField("missingSeqs")
+    static let framesUnderrun = MetricField("framesUnderrun")
+    static let framesConcealed = MetricField("framesConcealed")
+    static let callbacks = MetricField("callbacks")
+    static let stretchRemoved = MetricField("stretchRemoved")
+    static let stretchInserted = MetricField("stretchInserted")
+    static let concealed = MetricField("concealed")
+    static let filled = MetricField("filled")
+    static let skipped = MetricField("skipped")
+    static let missed = MetricField("missed")
+    static let updated = MetricField("updated")
+    static let dropped = MetricField("dropped")
+    static let currentDepth = MetricField("currentDepth")
+    static let delay = MetricField("delay")
+    static let playoutFull = MetricField("playoutFull")
+}
+
 extension OpusSubscription {
     final class OpusSubscriptionMeasurement: MetricsMeasurement {
         let storage = MeasurementStorage()
@@ -21,59 +41,60 @@ extension OpusSubscription {
 
         func receivedFrames(received: AVAudioFrameCount, timestamp: Date?) {
             let val = frames.wrappingAdd(UInt64(received), ordering: .relaxed).newValue
-            record(field: "receivedFrames", value: val as AnyObject, timestamp: timestamp)
+            record(field: .receivedFrames, value: val, timestamp: timestamp)
         }
 
         func receivedBytes(received: UInt, timestamp: Date?) {
             let val = bytes.wrappingAdd(UInt64(received), ordering: .relaxed).newValue
-            record(field: "receivedBytes", value: val as AnyObject, timestamp: timestamp)
+            record(field: .receivedBytes, value: val, timestamp: timestamp)
         }
 
         func missingSeq(missingCount: UInt64, timestamp: Date?) {
             let val = missing.wrappingAdd(missingCount, ordering: .relaxed).newValue
-            record(field: "missingSeqs", value: val as AnyObject, timestamp: timestamp)
+            record(field: .missingSeqs, value: val, timestamp: timestamp)
         }
 
         func framesUnderrun(underrun: UInt64, timestamp: Date?) {
-            record(field: "framesUnderrun", value: underrun as AnyObject, timestamp: timestamp)
+            record(field: .framesUnderrun, value: underrun, timestamp: timestamp)
         }
 
         func concealmentFrames(concealed: UInt64, timestamp: Date?) {
-            record(field: "framesConcealed", value: concealed as AnyObject, timestamp: timestamp)
+            record(field: .framesConcealed, value: concealed, timestamp: timestamp)
         }
 
         func callbacks(callbacks: UInt64, timestamp: Date?) {
-            record(field: "callbacks", value: callbacks as AnyObject, timestamp: timestamp)
+            record(field: .callbacks, value: callbacks, timestamp: timestamp)
         }
 
-        func removedSilence(removed: UInt64, timestamp: Date?) {
-            record(field: "removedSilence", value: removed as AnyObject, timestamp: timestamp)
+        func stretched(removed: UInt64, inserted: UInt64, timestamp: Date?) {
+            record(field: .stretchRemoved, value: removed, timestamp: timestamp)
+            record(field: .stretchInserted, value: inserted, timestamp: timestamp)
         }
 
         func recordLibJitterMetrics(metrics: Metrics, timestamp: Date?) {
-            record(field: "concealed", value: metrics.concealed_frames as AnyObject, timestamp: timestamp)
-            record(field: "filled", value: metrics.filled_packets as AnyObject, timestamp: timestamp)
-            record(field: "skipped", value: metrics.skipped_frames as AnyObject, timestamp: timestamp)
-            record(field: "missed", value: metrics.update_missed_frames as AnyObject, timestamp: timestamp)
-            record(field: "updated", value: metrics.updated_frames as AnyObject, timestamp: timestamp)
+            record(field: .concealed, value: metrics.concealed_frames, timestamp: timestamp)
+            record(field: .filled, value: metrics.filled_packets, timestamp: timestamp)
+            record(field: .skipped, value: metrics.skipped_frames, timestamp: timestamp)
+            record(field: .missed, value: metrics.update_missed_frames, timestamp: timestamp)
+            record(field: .updated, value: metrics.updated_frames, timestamp: timestamp)
         }
 
         func droppedFrames(dropped: Int, timestamp: Date?) {
             let val = self.dropped.wrappingAdd(UInt64(dropped), ordering: .relaxed).newValue
-            record(field: "dropped", value: val as AnyObject, timestamp: timestamp)
+            record(field: .dropped, value: val, timestamp: timestamp)
         }
 
         func depth(depthMs: Int, timestamp: Date) {
-            record(field: "currentDepth", value: TimeInterval(depthMs) / 1000.0, timestamp: timestamp)
+            record(field: .currentDepth, value: TimeInterval(depthMs) / 1000.0, timestamp: timestamp)
         }
 
         func frameDelay(delay: TimeInterval, metricsTimestamp: Date) {
-            record(field: "delay", value: delay, timestamp: metricsTimestamp)
+            record(field: .delay, value: delay, timestamp: metricsTimestamp)
         }
 
         func playoutFull(timestamp: Date?) {
             let val = playoutFullCount.wrappingAdd(1, ordering: .relaxed).newValue
-            record(field: "playoutFull", value: val as AnyObject, timestamp: timestamp)
+            record(field: .playoutFull, value: val, timestamp: timestamp)
         }
     }
 }
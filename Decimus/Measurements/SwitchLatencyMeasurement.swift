@@ -3,6 +3,17 @@
 
 import Foundation
 
+private extension MetricField {
+    static let groupDepth = MetricField("group_depth")
+    static let activationToJoinDecisionMs = MetricField("activation_to_join_decision_ms")
+    static let joinExecutionMs = MetricField("join_execution_ms")
+    static let fetchObjectCount = MetricField("fetch_object_count")
+    static let decodeMs = MetricField("decode_ms")
+    static let renderMs = MetricField("render_ms")
+    static let totalSwitchMs = MetricField("total_switch_ms")
+    static let requestToRenderMs = MetricField("request_to_render_ms")
+}
+
 final class SwitchLatencyMeasurement: MetricsMeasurement {
     let storage = MeasurementStorage()
     let name = "switch_latency"
@@ -16,11 +27,11 @@ final class SwitchLatencyMeasurement: MetricsMeasurement {
             return
         }
 
-        let perPointTags: [String: String] = [
+        let perPointTags = MetricTags.dynamic([
             "participant": participant,
             "activation_type": context.activationType.rawValue,
             "join_strategy": joinStrategy.rawValue
-        ]
+        ])
 
         let activationToJoinDecisionMs = joinDecisionTime.timeIntervalSince(context.activationTime) * 1000.0
         let joinExecutionMs = joinCompleteTime.timeIntervalSince(joinDecisionTime) * 1000.0
@@ -28,33 +39,19 @@ final class SwitchLatencyMeasurement: MetricsMeasurement {
         let renderMs = renderTime.timeIntervalSince(decodeTime) * 1000.0
         let totalSwitchMs = renderTime.timeIntervalSince(context.activationTime.hostDate) * 1000.0
 
-        record(field: "group_depth",
-               value: context.groupDepth as AnyObject,
-               timestamp: renderTime,
-               tags: perPointTags)
-        record(field: "activation_to_join_decision_ms",
-               value: activationToJoinDecisionMs,
-               timestamp: renderTime,
-               tags: perPointTags)
-        record(field: "join_execution_ms",
-               value: joinExecutionMs,
-               timestamp: renderTime,
-               tags: perPointTags)
-        record(field: "fetch_object_count",
-               value: (context.fetchObjectCount ?? 0) as AnyObject,
-               timestamp: renderTime,
-               tags: perPointTags)
-        record(field: "decode_ms",
-               value: decodeMs,
-               timestamp: renderTime,
-               tags: perPointTags)
-        record(field: "render_ms",
-               value: renderMs,
-               timestamp: renderTime,
-               tags: perPointTags)
-        record(field: "total_switch_ms",
-               value: totalSwitchMs,
-               timestamp: renderTime,
-               tags: perPointTags)
+        var values: [MetricValue] = [
+            .init(.groupDepth, context.groupDepth),
+            .init(.activationToJoinDecisionMs, activationToJoinDecisionMs),
+            .init(.joinExecutionMs, joinExecutionMs),
+            .init(.fetchObjectCount, context.fetchObjectCount ?? 0),
+            .init(.decodeMs, decodeMs),
+            .init(.renderMs, renderMs),
+            .init(.totalSwitchMs, totalSwitchMs)
+        ]
+        if let requestTime = context.requestTime {
+            // Includes the subscribe round trip, or resume, that activation timing starts after.
+            values.append(.init(.requestToRenderMs, renderTime.timeIntervalSince(requestTime.hostDate) * 1000.0))
+        }
+        record(values, timestamp: renderTime, tags: perPointTags)
     }
 }
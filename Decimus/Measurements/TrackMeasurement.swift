@@ -1,6 +1,18 @@
 // SPDX-FileCopyrightText: Copyright (c) 2023 Cisco Systems
 // SPDX-License-Identifier: BSD-2-Clause
 
+private extension MetricField {
+    static let txBytes = MetricField("tx_bytes")
+    static let txObjs = MetricField("tx_objs")
+    static let txBufferDrops = MetricField("tx_buffer_drops")
+    static let txQueueDiscards = MetricField("tx_queue_discards")
+    static let txQueueExpired = MetricField("tx_queue_expired")
+    static let txDelayedCallback = MetricField("tx_delayed_callback")
+    static let txResetWait = MetricField("tx_reset_wait")
+    static let rxBytes = MetricField("rx_bytes")
+    static let rxObjs = MetricField("rx_objs")
+}
+
 final class TrackMeasurement: MetricsMeasurement {
     enum PubSub {
         case publish
@@ -31,21 +43,21 @@ final class TrackMeasurement: MetricsMeasurement {
 
     func record(_ metrics: QPublishTrackMetrics) {
         let time = Date.now
-        record(field: "tx_bytes", value: metrics.bytesPublished as AnyObject, timestamp: time)
-        record(field: "tx_objs", value: metrics.objectsPublished as AnyObject, timestamp: time)
+        record(field: .txBytes, value: metrics.bytesPublished, timestamp: time)
+        record(field: .txObjs, value: metrics.objectsPublished, timestamp: time)
         record("tx_queue_size", values: metrics.quic.tx_queue_size, time: time)
         record("tx_callback_ms", values: metrics.quic.tx_callback_ms, time: time)
         record("tx_object_duration_us", values: metrics.quic.tx_object_duration_us, time: time)
-        record(field: "tx_buffer_drops", value: metrics.quic.tx_buffer_drops as AnyObject, timestamp: time)
-        record(field: "tx_queue_discards", value: metrics.quic.tx_queue_discards as AnyObject, timestamp: time)
-        record(field: "tx_queue_expired", value: metrics.quic.tx_queue_expired as AnyObject, timestamp: time)
-        record(field: "tx_delayed_callback", value: metrics.quic.tx_delayed_callback as AnyObject, timestamp: time)
-        record(field: "tx_reset_wait", value: metrics.quic.tx_reset_wait as AnyObject, timestamp: time)
+        record(field: .txBufferDrops, value: metrics.quic.tx_buffer_drops, timestamp: time)
+        record(field: .txQueueDiscards, value: metrics.quic.tx_queue_discards, timestamp: time)
+        record(field: .txQueueExpired, value: metrics.quic.tx_queue_expired, timestamp: time)
+        record(field: .txDelayedCallback, value: metrics.quic.tx_delayed_callback, timestamp: time)
+        record(field: .txResetWait, value: metrics.quic.tx_reset_wait, timestamp: time)
     }
 
     func record(_ metrics: QSubscribeTrackMetrics) {
         let time = Date.now
-        record(field: "rx_bytes", value: metrics.bytesReceived as AnyObject, timestamp: time)
-        record(field: "rx_objs", value: metrics.objectsReceived as AnyObject, timestamp: time)
+        record(field: .rxBytes, value: metrics.bytesReceived, timestamp: time)
+        record(field: .rxObjs, value: metrics.objectsReceived, timestamp: time)
     }
 }
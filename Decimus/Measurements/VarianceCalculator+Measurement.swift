@@ -1,19 +1,34 @@
 // SPDX-FileCopyrightText: Copyright (c) 2023 Cisco Systems
 // SPDX-License-Identifier: BSD-2-Clause
 
+import Synchronization
+
+private extension MetricField {
+    static let variance = MetricField("variance")
+}
+
 extension VarianceCalculator {
     final class VarianceCalculatorMeasurement: MetricsMeasurement {
         let storage = MeasurementStorage()
         let name = "VarianceCalculator"
         let tags: [String: String]
+        // The count is bounded by the number of expected occurrences, so each is interned once.
+        private let countTags = Mutex<[Int: MetricTags]>([:])
 
         init(source: String, stage: String) {
             self.tags = ["sourceId": source, "stage": stage]
         }
 
         func reportVariance(variance: TimeInterval, timestamp: Date, count: Int) {
-            let tags: [String: String] = ["count": "\(count)"]
-            record(field: "variance", value: variance, timestamp: timestamp, tags: tags)
+            let tags = self.countTags.withLock { tags in
+                if let existing = tags[count] {
+                    return existing
+                }
+                let created = MetricTags(["count": "\(count)"])
+                tags[count] = created
+                return created
+            }
+            record(field: .variance, value: variance, timestamp: timestamp, tags: tags)
         }
     }
 }
@@ -3,6 +3,33 @@
 
 import Synchronization
 
+private extension MetricField {
+    static let timestamp = MetricField("timestamp")
+    static let receivedFrames = MetricField("receivedFrames")
+    static let age = MetricField("age")
+    static let ageDecode = MetricField("ageDecode")
+    static let ageDecoded = MetricField("ageDecoded")
+    static let decodedFrames = MetricField("decodedFrames")
+    static let receivedBytes = MetricField("receivedBytes")
+    static let enqueueTimestamp = MetricField("enqueueTimestamp")
+    static let delay = MetricField("delay")
+}
+
+private extension MetricTags {
+    static func cached(_ cached: Bool) -> Self {
+        cached ? Self.cachedTrue : Self.cachedFalse
+    }
+    private static let cachedTrue = MetricTags(["cached": "true"])
+    private static let cachedFalse = MetricTags(["cached": "false"])
+
+    static func received(idr: Bool, cached: Bool) -> Self {
+        Self.receivedTags[(idr ? 2 : 0) + (cached ? 1 : 0)]
+    }
+    private static let receivedTags = [false, true].flatMap { idr in
+        [false, true].map { cached in MetricTags(["idr": "\(idr)", "cached": "\(cached)"]) }
+    }
+}
+
 extension VideoHandler {
     final class VideoHandlerMeasurement: MetricsMeasurement {
         let storage = MeasurementStorage()
@@ -11,69 +38,61 @@ extension VideoHandler {
         private let frames = Atomic<UInt64>(0)
         private let bytes = Atomic<UInt64>(0)
         private let decoded = Atomic<UInt64>(0)
+        // Negative if the publisher's clock is ahead.
+        private let traversalTimes = LatencyHistogram("traversalTime", range: -10...60)
+        var histograms: [LatencyHistogram] { [self.traversalTimes] }
 
         init(namespace: QuicrNamespace) {
             self.tags = ["namespace": namespace]
         }
 
         func timestamp(timestamp: TimeInterval, when: Date, cached: Bool) {
-            let tags = ["cached": "\(cached)"]
-            self.record(field: "timestamp", value: timestamp, timestamp: when, tags: tags)
+            self.record(field: .timestamp, value: timestamp, timestamp: when, tags: .cached(cached))
         }
 
         func receivedFrame(timestamp: Date?, idr: Bool, cached: Bool) {
             let val = frames.wrappingAdd(1, ordering: .relaxed).newValue
-            let tags: [String: String]?
-            if timestamp != nil {
-                tags = ["idr": "\(idr)", "cached": "\(cached)"]
-            } else {
-                tags = nil
-            }
-            record(field: "receivedFrames",
-                   value: val as AnyObject,
+            record(field: .receivedFrames,
+                   value: val,
                    timestamp: timestamp,
-                   tags: tags)
+                   tags: timestamp != nil ? .received(idr: idr, cached: cached) : nil)
         }
 
         func age(age: TimeInterval, timestamp: Date, cached: Bool) {
-            let tags = ["cached": "\(cached)"]
-            record(field: "age", value: age as AnyObject, timestamp: timestamp, tags: tags)
+            record(field: .age, value: age, timestamp: timestamp, tags: .cached(cached))
         }
 
         func writeDecoder(age: TimeInterval, timestamp: Date) {
-            self.record(field: "ageDecode", value: age, timestamp: timestamp)
+            self.record(field: .ageDecode, value: age, timestamp: timestamp)
         }
 
         func decodedAge(age: TimeInterval, timestamp: Date) {
-            self.record(field: "ageDecoded", value: age, timestamp: timestamp)
+            self.record(field: .ageDecoded, value: age, timestamp: timestamp)
         }
 
         func decodedFrame(timestamp: Date?) {
             let val = decoded.wrappingAdd(1, ordering: .relaxed).newValue
-            record(field: "decodedFrames", value: val as AnyObject, timestamp: timestamp)
+            record(field: .decodedFrames, value: val, timestamp: timestamp)
         }
 
         func receivedBytes(received: Int, timestamp: Date?, cached: Bool) {
             let val = bytes.wrappingAdd(UInt64(received), ordering: .relaxed).newValue
-            let tags: [String: String]?
-            if timestamp != nil {
-                tags = ["cached": "\(cached)"]
-            } else {
-                tags = nil
-            }
-            record(field: "receivedBytes", value: val as AnyObject, timestamp: timestamp, tags: tags)
+            record(field: .receivedBytes,
+                   value: val,
+                   timestamp: timestamp,
+                   tags: timestamp != nil ? .cached(cached) : nil)
         }
 
         func enqueuedFrame(frameTimestamp: TimeInterval, metricsTimestamp: Date) {
-            record(field: "enqueueTimestamp", value: frameTimestamp as AnyObject, timestamp: metricsTimestamp)
+            record(field: .enqueueTimestamp, value: frameTimestamp, timestamp: metricsTimestamp)
         }
 
         func frameDelay(delay: TimeInterval, metricsTimestamp: Date) {
-            record(field: "delay", value: delay, timestamp: metricsTimestamp)
+            record(field: .delay, value: delay, timestamp: metricsTimestamp)
         }
 
         func moqTraversalTime(time: TimeInterval, metricsTimestamp: Date) {
-            self.record(field: "traversalTime", value: time, timestamp: metricsTimestamp)
+            self.traversalTimes.record(time, timestamp: metricsTimestamp, into: self)
         }
     }
 }
@@ -3,6 +3,12 @@
 
 import CoreMedia
 
+private extension MetricField {
+    static let selection = MetricField("selection")
+    static let variance = MetricField("variance")
+    static let age = MetricField("age")
+}
+
 extension VideoSubscriptionSet {
     struct SimulreceiveChoiceReport {
         let item: SimulreceiveItem
@@ -24,24 +30,24 @@ extension VideoSubscriptionSet {
             var offset: TimeInterval = 0
             for choice in choices {
                 let height = choice.item.image.image.formatDescription!.dimensions.height
-                let tags: [String: String] = [
+                let tags = MetricTags.dynamic([
                     "namespace": "\(choice.item.fullTrackName)",
                     "selected": String(choice.selected),
                     "timestamp": String(choice.item.image.image.presentationTimeStamp.seconds),
                     "reason": choice.reason,
                     "displayed": String(choice.displayed)
-                ]
-                record(field: "selection", value: height as AnyObject, timestamp: timestamp + offset, tags: tags)
+                ])
+                record(field: .selection, value: height, timestamp: timestamp + offset, tags: tags)
                 offset += (1 / 1_000_000)
             }
         }
 
         func reportVariance(variance: TimeInterval, when: Date) {
-            record(field: "variance", value: variance as AnyObject, timestamp: when)
+            record(field: .variance, value: variance, timestamp: when)
         }
 
         func age(_ age: TimeInterval, timestamp: Date) {
-            self.record(field: "age", value: age, timestamp: timestamp)
+            self.record(field: .age, value: age, timestamp: timestamp)
         }
     }
 }
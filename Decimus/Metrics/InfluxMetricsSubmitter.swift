@@ -20,13 +20,16 @@ final class InfluxMetricsSubmitter: @unchecked Sendable, MetricsSubmitter {
     private let client: InfluxDBClient
     private let measurements = Mutex<[UUID: WeakMeasurement]>([:])
     private let tags: [String: String]
+    // Reused between submissions, so steady state encoding doesn't allocate.
+    private let encoder = Mutex(QInfluxLineEncoder())
+    private let dropped = Atomic<Int>(0)
 
-    init(token: String, config: InfluxConfig, tags: [String: String]) {
+    init(token: String, config: InfluxConfig, tags: [String: String], gzip: Bool = true) {
         client = .init(url: config.url,
                        token: token,
                        options: .init(bucket: config.bucket,
                                       org: config.org,
-                                      enableGzip: true))
+                                      enableGzip: gzip))
         self.tags = tags
     }
 
@@ -45,39 +48,20 @@ final class InfluxMetricsSubmitter: @unchecked Sendable, MetricsSubmitter {
         // Snapshot measurements under lock, then release.
         let snapshot: [UUID: WeakMeasurement] = measurements.withLock { $0 }
 
-        var points: [InfluxDBClient.Point] = []
         var toRemove: [UUID] = []
-        for pair in snapshot {
-            let weakMeasurement = pair.value
-            guard let measurement = weakMeasurement.measurement else {
-                self.logger.warning("Removing dead measurement")
-                toRemove.append(weakMeasurement.id)
-                continue
-            }
-            let fields = measurement.drain()
-            let name = measurement.name
-            let mTags = measurement.tags
-            for timestampedDict in fields {
-                let point: InfluxDBClient.Point = .init(name)
-                for tag in mTags {
-                    point.addTag(key: tag.key, value: tag.value)
-                }
-                for tag in self.tags {
-                    point.addTag(key: tag.key, value: tag.value)
-                }
-                if let realTime = timestampedDict.key {
-                    point.time(time: .date(realTime))
-                }
-                for appPoint in timestampedDict.value {
-                    if let tags = appPoint.tags {
-                        for tag in tags {
-                            point.addTag(key: tag.key, value: tag.value)
-                        }
-                    }
-                    point.addField(key: appPoint.fieldName, value: Self.getFieldValue(value: appPoint.value))
-                    points.append(point)
+        let body: String = self.encoder.withLock { encoder in
+            encoder.reset()
+            var lines = 0
+            for pair in snapshot {
+                let weakMeasurement = pair.value
+                guard let measurement = weakMeasurement.measurement else {
+                    self.logger.warning("Removing dead measurement")
+                    toRemove.append(weakMeasurement.id)
+                    continue
                 }
+                lines += measurement.drain(into: encoder, tags: self.tags)
             }
+            return lines > 0 ? String(decoding: encoder.data(), as: UTF8.self) : ""
         }
 
         // Clean up dead weak references.
@@ -89,34 +73,23 @@ final class InfluxMetricsSubmitter: @unchecked Sendable, MetricsSubmitter {
             }
         }
 
-        guard !points.isEmpty else { return }
+        let dropped = Int(QMetricsCollector.dropped())
+        let previous = self.dropped.exchange(dropped, ordering: .relaxed)
+        if dropped > previous {
+            self.logger.warning("Dropped \(dropped - previous) metrics samples")
+        }
+
+        guard !body.isEmpty else { return }
 
         do {
-            try await client.makeWriteAPI().write(points: points, responseQueue: .global(qos: .utility))
+            try await client.makeWriteAPI().write(precision: .ns,
+                                                  record: body,
+                                                  responseQueue: .global(qos: .utility))
         } catch {
             self.logger.warning("Failed to write metrics: \(error)")
         }
     }
 
-    private static func getFieldValue(value: AnyObject) -> InfluxDBClient.Point.FieldValue? {
-        switch value {
-        case is Int16, is Int32, is Int64:
-            return .int((value as? Int)!)
-        case is UInt8, is UInt16, is UInt32, is UInt64:
-            return .uint((value as? UInt)!)
-        case is Float:
-            return .double(Double((value as? Float)!))
-        case is Double:
-            return .double((value as? Double)!)
-        case is String:
-            return .string((value as? String)!)
-        case is Bool:
-            return .boolean((value as? Bool)!)
-        default:
-            return nil
-        }
-    }
-
     deinit {
         client.close()
     }
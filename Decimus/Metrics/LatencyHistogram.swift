@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Foundation
+import Synchronization
+
+/// Aggregates a time interval metric into percentiles, rather than recording every sample.
+///
+/// Samples are bucketed into a `QHistogram` at microsecond resolution. Each fixed period, judged by
+/// the timestamps samples are recorded with, the period's p50, p90, p99, max and count are recorded
+/// into the owning measurement as `<name>_p50` etc. Anything left is summarized when the measurement is
+/// drained for submission, for which the measurement must list it in `histograms`.
+final class LatencyHistogram: Sendable {
+    /// Aggregation period when none is given, matching the default submission interval.
+    static let defaultPeriod: TimeInterval = 5
+
+    private struct Layout: Hashable {
+        let lowest: Int64
+        let highest: Int64
+    }
+
+    private static let significantBits: UInt8 = 7
+    // Summaries are infrequent, so histograms of a layout share one to drain into.
+    private static let scratch = Mutex<[Layout: QHistogram]>([:])
+
+    private let live: QHistogram
+    private let layout: Layout
+    private let period: TimeInterval
+    private let window = Atomic<Int64>(.min)
+    private let p50: MetricField
+    private let p90: MetricField
+    private let p99: MetricField
+    private let maximum: MetricField
+    private let samples: MetricField
+
+    /// - Parameter name: Field name prefix.
+    /// - Parameter range: Values tracked, in seconds. Values outside are counted as the nearest bound.
+    /// - Parameter period: Interval to summarize over, in seconds.
+    init(_ name: String, range: ClosedRange<TimeInterval>, period: TimeInterval = LatencyHistogram.defaultPeriod) {
+        precondition(range.contains(0))
+        precondition(period > 0)
+        self.layout = .init(lowest: Self.microseconds(range.lowerBound), highest: Self.microseconds(range.upperBound))
+        self.live = .init(lowest: self.layout.lowest,
+                          highest: self.layout.highest,
+                          significantBits: Self.significantBits)
+        self.period = period
+        self.p50 = .init("\(name)_p50")
+        self.p90 = .init("\(name)_p90")
+        self.p99 = .init("\(name)_p99")
+        self.maximum = .init("\(name)_max")
+        self.samples = .init("\(name)_count")
+    }
+
+    /// Record a sample, first summarizing the previous period into `measurement` if this sample starts a new one.
+    /// - Parameter value: The sample, in seconds.
+    /// - Parameter timestamp: When the sample was taken, or nil to leave it to the next drain.
+    func record(_ value: TimeInterval, timestamp: Date?, into measurement: some MetricsMeasurement) {
+        guard !value.isNaN else { return }
+        if let timestamp {
+            let window = Int64((timestamp.timeIntervalSince1970 / self.period).rounded(.down))
+            let current = self.window.load(ordering: .relaxed)
+            if window > current,
+               self.window.compareExchange(expected: current, desired: window, ordering: .relaxed).exchanged,
+               current != .min {
+                let end = Date(timeIntervalSince1970: TimeInterval(current + 1) * self.period)
+                self.summarize(into: measurement, timestamp: end)
+            }
+        }
+        self.live.record(Self.microseconds(value))
+    }
+
+    /// Record the percentiles of everything recorded since the last summary, if anything.
+    func summarize(into measurement: some MetricsMeasurement, timestamp: Date) {
+        Self.scratch.withLock { scratch in
+            let summary: QHistogram
+            if let existing = scratch[self.layout] {
+                summary = existing
+                summary.reset()
+            } else {
+                summary = .init(lowest: self.layout.lowest,
+                                highest: self.layout.highest,
+                                significantBits: Self.significantBits)
+                scratch[self.layout] = summary
+            }
+            let drained = self.live.drain(into: summary)
+            assert(drained)
+            guard summary.count() > 0 else { return }
+            measurement.record(field: self.p50, value: Self.seconds(summary.value(atPercentile: 50)), timestamp: timestamp)
+            measurement.record(field: self.p90, value: Self.seconds(summary.value(atPercentile: 90)), timestamp: timestamp)
+            measurement.record(field: self.p99, value: Self.seconds(summary.value(atPercentile: 99)), timestamp: timestamp)
+            measurement.record(field: self.maximum, value: Self.seconds(summary.max()), timestamp: timestamp)
+            measurement.record(field: self.samples, value: summary.count(), timestamp: timestamp)
+        }
+    }
+
+    private static func microseconds(_ seconds: TimeInterval) -> Int64 {
+        Int64(exactly: (seconds * 1_000_000).rounded()) ?? (seconds > 0 ? .max : .min)
+    }
+
+    private static func seconds(_ microseconds: Int64) -> TimeInterval {
+        TimeInterval(microseconds) / 1_000_000
+    }
+}
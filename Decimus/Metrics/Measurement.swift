@@ -2,64 +2,180 @@
 // SPDX-License-Identifier: BSD-2-Clause
 
 import Foundation
-import Synchronization
 
-struct Point {
-    let fieldName: String
-    let value: AnyObject
-    let tags: [String: String]?
+/// A field name, interned once so that recorded samples carry only a fixed width id.
+/// Declare these statically rather than per record.
+struct MetricField: Sendable, Hashable {
+    let id: UInt32
+
+    init(_ name: String) {
+        self.id = QMetricsCollector.internField(name)
+    }
 }
 
-typealias Fields = [Date?: [Point]]
+/// Per point tags.
+struct MetricTags: Sendable {
+    private enum Storage: Sendable {
+        case interned(UInt32)
+        case dynamic([String: String])
+    }
+    private let storage: Storage
+
+    /// Interned once and never freed. For tags drawn from a small, bounded set of values.
+    init(_ tags: [String: String]) {
+        self.storage = .interned(QMetricsCollector.internTags(tags))
+    }
+
+    private init(dynamic tags: [String: String]) {
+        self.storage = .dynamic(tags)
+    }
 
-/// Mutex-backed storage shared by every Measurement. Holding this by composition
+    /// Encoded per record and freed once submitted. For unbounded values such as identifiers or timestamps.
+    /// Record a point's fields together with ``MetricsMeasurement/record(_:timestamp:tags:)``, so that they
+    /// share one encoding and one line.
+    static func dynamic(_ tags: [String: String]) -> Self {
+        .init(dynamic: tags)
+    }
+
+    /// The id to record a single point with.
+    fileprivate var id: UInt32 {
+        switch self.storage {
+        case .interned(let id):
+            return id
+        case .dynamic(let tags):
+            return QMetricsCollector.transientTags(tags)
+        }
+    }
+}
+
+/// One field's value, to record several as one point.
+typealias MetricValue = QMetricValue
+
+extension MetricValue {
+    /// Always written as a signed integer field, as a single integer record is.
+    init<Value: BinaryInteger>(_ field: MetricField, _ value: Value) {
+        self.init(field: field.id, kind: .int, value: UInt64(bitPattern: Int64(clamping: value)))
+    }
+
+    /// Always written as a float field, whether or not the value is integral.
+    init<Value: BinaryFloatingPoint>(_ field: MetricField, _ value: Value) {
+        self.init(field: field.id, kind: .double, value: Double(value).bitPattern)
+    }
+
+    init(_ field: MetricField, _ value: Bool) {
+        self.init(field: field.id, kind: .bool, value: value ? 1 : 0)
+    }
+
+    /// String values are interned, so must come from a small, bounded set.
+    init(_ field: MetricField, _ value: String) {
+        self.init(field: field.id, kind: .string, value: UInt64(QMetricsCollector.internString(value)))
+    }
+}
+
+/// Collector registration shared by every Measurement. Holding this by composition
 /// (rather than inheriting from a base class) lets concrete measurements be `final`
-/// and get real `Sendable` conformance, with @unchecked localised here where
-/// `AnyObject` field values force it.
+/// and get real `Sendable` conformance.
+///
+/// Samples are recorded into the calling thread's ring in `QMetricsCollector` without locking,
+/// and collected when the submitter drains.
 final class MeasurementStorage: Sendable {
     let id = UUID()
-    private let fields = Mutex<Fields>([:])
+    let handle = QMetricsCollector.registerMeasurement()
 
-    func record(field: String, value: AnyObject, timestamp: Date?, tags: [String: String]?) {
-        self.fields.withLock { f in
-            if f[timestamp] == nil { f[timestamp] = [] }
-            f[timestamp]!.append(.init(fieldName: field, value: value, tags: tags))
-        }
+    func record(field: MetricField, kind: QMetricKind, value: UInt64, timestamp: Date?, tags: MetricTags?) {
+        QMetricsCollector.record(self.handle,
+                                 field: field.id,
+                                 kind: kind,
+                                 value: value,
+                                 timestamp: Self.nanoseconds(timestamp),
+                                 tags: tags?.id ?? 0)
     }
 
-    func drain() -> Fields {
-        self.fields.withLock { f in
-            let r = f
-            f.removeAll(keepingCapacity: true)
-            return r
+    func record(_ values: [MetricValue], timestamp: Date?, tags: MetricTags?) {
+        guard !values.isEmpty else { return }
+        let tags = tags?.id ?? 0
+        values.withUnsafeBufferPointer { values in
+            QMetricsCollector.record(self.handle,
+                                     values: values.baseAddress!,
+                                     count: values.count,
+                                     timestamp: Self.nanoseconds(timestamp),
+                                     tags: tags)
         }
     }
+
+    private static func nanoseconds(_ timestamp: Date?) -> Int64 {
+        guard let timestamp else { return .min }
+        return Int64((timestamp.timeIntervalSince1970 * 1_000_000_000).rounded())
+    }
+
+    deinit {
+        QMetricsCollector.unregisterMeasurement(self.handle)
+    }
 }
 
 protocol MetricsMeasurement: AnyObject, Sendable {
     var storage: MeasurementStorage { get }
     var name: String { get }
     var tags: [String: String] { get }
+    /// Aggregated metrics to summarize on each drain.
+    var histograms: [LatencyHistogram] { get }
 }
 
 extension MetricsMeasurement {
     var id: UUID { self.storage.id }
+    var histograms: [LatencyHistogram] { [] }
 
-    func record(field: String, value: AnyObject, timestamp: Date?, tags: [String: String]? = nil) {
-        self.storage.record(field: field, value: value, timestamp: timestamp, tags: tags)
+    /// Always written as a signed integer field, so that a field's type doesn't depend on the
+    /// width or signedness of the value recorded into it.
+    func record<Value: BinaryInteger>(field: MetricField, value: Value, timestamp: Date?, tags: MetricTags? = nil) {
+        self.storage.record(field: field,
+                            kind: .int,
+                            value: UInt64(bitPattern: Int64(clamping: value)),
+                            timestamp: timestamp,
+                            tags: tags)
     }
 
-    /// Existing behaviour preserved: adds `.ulpOfOne` to integer-valued doubles to
-    /// force InfluxDB float field typing.
-    func record(field: String, value: Double, timestamp: Date?, tags: [String: String]? = nil) {
-        let floatValue: TimeInterval
-        if value == 0 || Int(exactly: value) != nil {
-            floatValue = value + .ulpOfOne
-        } else {
-            floatValue = value
-        }
-        self.record(field: field, value: floatValue as AnyObject, timestamp: timestamp, tags: tags)
+    /// Always written as a float field, whether or not the value is integral.
+    func record<Value: BinaryFloatingPoint>(field: MetricField,
+                                            value: Value,
+                                            timestamp: Date?,
+                                            tags: MetricTags? = nil) {
+        self.storage.record(field: field,
+                            kind: .double,
+                            value: Double(value).bitPattern,
+                            timestamp: timestamp,
+                            tags: tags)
+    }
+
+    func record(field: MetricField, value: Bool, timestamp: Date?, tags: MetricTags? = nil) {
+        self.storage.record(field: field, kind: .bool, value: value ? 1 : 0, timestamp: timestamp, tags: tags)
+    }
+
+    /// String values are interned, so must come from a small, bounded set.
+    func record(field: MetricField, value: String, timestamp: Date?, tags: MetricTags? = nil) {
+        self.storage.record(field: field,
+                            kind: .string,
+                            value: UInt64(QMetricsCollector.internString(value)),
+                            timestamp: timestamp,
+                            tags: tags)
     }
 
-    func drain() -> Fields { self.storage.drain() }
+    /// Record several fields as one point: one line, with any dynamic tags encoded once for all of them.
+    func record(_ values: [MetricValue], timestamp: Date?, tags: MetricTags? = nil) {
+        self.storage.record(values, timestamp: timestamp, tags: tags)
+    }
+
+    /// Encode everything recorded since the last drain as line protocol.
+    /// - Parameter encoder: Encoder to append to.
+    /// - Parameter tags: Tags to add to every line, alongside the measurement's own.
+    /// - Returns: The number of lines appended.
+    @discardableResult
+    func drain(into encoder: QInfluxLineEncoder, tags: [String: String] = [:]) -> Int {
+        let now = Date.now
+        for histogram in self.histograms {
+            histogram.summarize(into: self, timestamp: now)
+        }
+        let merged = self.tags.merging(tags) { $1 }
+        return encoder.appendMeasurement(self.storage.handle, name: self.name, tags: merged)
+    }
 }
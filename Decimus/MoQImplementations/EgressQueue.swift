@@ -0,0 +1,332 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import DequeModule
+import Foundation
+
+/// Order in which tracks' objects leave the client when the uplink is congested, most important first.
+enum EgressClass: Int, Comparable, CaseIterable, Sendable {
+    /// Audio, and other small latency critical data.
+    case audio
+    /// The lowest quality video layer, enough to keep video going.
+    case baseLayer
+    /// Higher quality video layers.
+    case enhancementLayer
+
+    static func < (lhs: Self, rhs: Self) -> Bool {
+        lhs.rawValue < rhs.rawValue
+    }
+}
+
+/// Budgets and bitrate feedback behaviour of an ``EgressQueue``.
+struct EgressConfig {
+    /// Shared uplink budget in bits per second, or 0 for no shared budget.
+    var uplinkBitrate: UInt64
+    /// Seconds of the uplink's rate that may be sent at once.
+    var burst: TimeInterval = 0.02
+    /// Seconds a queued video object may wait before it is no longer worth sending.
+    var staleVideoAge: TimeInterval = 0.3
+    /// Each track may send at this multiple of its nominal bitrate.
+    var trackHeadroom: Double = 2
+    /// Seconds of a track's rate it may send at once, covering its key frames.
+    var trackBurst: TimeInterval = 1
+    /// Queueing delay above which a video track is asked to lower its bitrate.
+    var congestedDelay: TimeInterval = 0.1
+    /// Seconds between revisions of a video track's target bitrate.
+    var adjustInterval: TimeInterval = 0.5
+    /// Target bitrate multiplier on congestion.
+    var decrease: Double = 0.85
+    /// Target bitrate multiplier while uncongested.
+    var increase: Double = 1.05
+    /// Lowest fraction of its nominal bitrate a track is asked for.
+    var minimumFraction: Double = 0.25
+}
+
+/// A token bucket measured in bytes.
+///
+/// Sending is allowed while any tokens remain, going into debt for an object larger than what remains, so that
+/// no object is too large to ever be sent and a large one holds back what follows until its debt is repaid.
+struct TokenBucket {
+    /// Refill rate in bytes per second.
+    let rate: Double
+    private let burst: Double
+    private(set) var tokens: Double
+    private var updated: Ticks
+
+    /// Create a full bucket.
+    /// - Parameter bitrate: Refill rate in bits per second.
+    /// - Parameter burst: Seconds of refill the bucket holds.
+    /// - Parameter now: The current time.
+    init(bitrate: UInt64, burst: TimeInterval, now: Ticks) {
+        self.rate = Double(bitrate) / 8
+        self.burst = max(self.rate * burst, 1)
+        self.tokens = self.burst
+        self.updated = now
+    }
+
+    /// True if sending is allowed, as of the last refill.
+    var available: Bool {
+        self.tokens > 0
+    }
+
+    /// Add the tokens accrued since the last refill.
+    mutating func refill(_ now: Ticks) {
+        guard now > self.updated else { return }
+        self.tokens = min(self.burst, self.tokens + now.timeIntervalSince(self.updated) * self.rate)
+        self.updated = now
+    }
+
+    /// Charge for sent bytes.
+    mutating func consume(_ bytes: Int) {
+        self.tokens -= Double(bytes)
+    }
+
+    /// Seconds from `now` until sending is allowed.
+    func wait(_ now: Ticks) -> TimeInterval {
+        let elapsed = now > self.updated ? now.timeIntervalSince(self.updated) : 0
+        let tokens = self.tokens + elapsed * self.rate
+        return tokens > 0 ? 0 : (1 - tokens) / self.rate
+    }
+}
+
+/// Decides when, and in what order, tracks' objects are handed to their sinks, and which are too late to send.
+///
+/// Each track has a token bucket at a multiple of its nominal bitrate, and all share the uplink's budget. Each
+/// class sees only what it and more important classes have spent of the uplink, so a large key frame that puts
+/// the uplink in debt holds back only its own and less important classes: audio never waits behind video, nor
+/// base layers behind enhancements. Of what can be sent, the most important class goes first, and within a
+/// class the longest waiting object. A video object that has waited past ``EgressConfig/staleVideoAge`` is
+/// dropped along with the rest of its group, which can't be decoded without it. Video tracks' queueing delay
+/// and drops produce target bitrates to feed back to their encoders.
+///
+/// Objects are handed over in order per track, and only one at a time: after a send, call
+/// ``completed(_:)`` before the track's next object is eligible. Not thread safe, and driven by the caller's
+/// clock, see ``EgressScheduler``.
+struct EgressQueue<Payload> {
+    typealias Track = Int
+
+    /// What happens to an offered object.
+    enum Admission: Equatable {
+        /// Send it now, then call ``EgressQueue/completed(_:)``.
+        case send
+        /// ``EgressQueue/enqueue(_:track:groupId:bytes:now:)`` it, to be sent later.
+        case queue
+        /// Discard it, its group having been dropped.
+        case drop
+    }
+
+    /// Events for a track's publication.
+    enum Feedback: Equatable {
+        /// Stale objects were dropped, so the next should be a key frame.
+        case dropped(Track)
+        /// The bitrate the track's encoder should target, in bits per second.
+        case targetBitrate(Track, UInt32)
+    }
+
+    private struct Entry {
+        // Nil for markers, which are free and never stale.
+        let groupId: UInt64?
+        let bytes: Int
+        let enqueued: Ticks
+        let payload: Payload
+    }
+
+    private struct TrackState {
+        let egressClass: EgressClass
+        let nominal: UInt32
+        let staleAfter: TimeInterval?
+        var bucket: TokenBucket?
+        var queue = Deque<Entry>()
+        var inFlight = false
+        var droppedGroup: UInt64?
+        var target: UInt32
+        // Worst queueing delay, and whether anything was dropped, since the target was last revised.
+        var delay: TimeInterval = 0
+        var dropped = false
+        var adjusted: Ticks
+    }
+
+    private let config: EgressConfig
+    // The uplink's budget, as seen by each class.
+    private var uplink: [TokenBucket]
+    private var tracks: [Track: TrackState] = [:]
+    private var feedback: [Feedback] = []
+
+    /// Create a queue.
+    /// - Parameter config: Budgets and bitrate feedback behaviour.
+    /// - Parameter now: The current time.
+    init(config: EgressConfig, now: Ticks) {
+        self.config = config
+        if config.uplinkBitrate > 0 {
+            self.uplink = .init(repeating: .init(bitrate: config.uplinkBitrate, burst: config.burst, now: now),
+                                count: EgressClass.allCases.count)
+        } else {
+            self.uplink = []
+        }
+    }
+
+    /// Start pacing a track.
+    /// - Parameter track: Identifier for the track.
+    /// - Parameter egressClass: Its priority.
+    /// - Parameter bitrate: Its nominal bitrate in bits per second, or 0 to not pace it individually.
+    /// - Parameter now: The current time.
+    mutating func add(_ track: Track, egressClass: EgressClass, bitrate: UInt32, now: Ticks) {
+        let rate = UInt64(Double(bitrate) * self.config.trackHeadroom)
+        self.tracks[track] = .init(egressClass: egressClass,
+                                   nominal: bitrate,
+                                   staleAfter: egressClass == .audio ? nil : self.config.staleVideoAge,
+                                   bucket: rate > 0 ? .init(bitrate: rate, burst: self.config.trackBurst, now: now) : nil,
+                                   target: bitrate,
+                                   adjusted: now)
+    }
+
+    /// Stop pacing a track, discarding anything it has queued.
+    mutating func remove(_ track: Track) {
+        self.tracks.removeValue(forKey: track)
+    }
+
+    /// Decide what to do with a track's object. If it can be sent now, it is charged and the track is marked in
+    /// flight.
+    /// - Parameter track: The object's track.
+    /// - Parameter groupId: The object's group, or nil for a marker that must keep its place in the track's
+    /// order but costs nothing.
+    /// - Parameter bytes: The object's size.
+    /// - Parameter now: The current time.
+    /// - Returns: What to do with it.
+    mutating func admit(track: Track, groupId: UInt64?, bytes: Int, now: Ticks) -> Admission {
+        guard var state = self.tracks[track] else { return .send }
+        defer { self.tracks[track] = state }
+        self.adjust(track, &state, now: now)
+        if let groupId, let dropped = state.droppedGroup {
+            guard groupId != dropped else { return .drop }
+            state.droppedGroup = nil
+        }
+        guard state.queue.isEmpty,
+              !state.inFlight,
+              groupId == nil || self.affordable(&state, now: now) else {
+            return .queue
+        }
+        self.charge(&state, bytes: bytes)
+        return .send
+    }
+
+    /// Queue an object that ``admit(track:groupId:bytes:now:)`` said to.
+    mutating func enqueue(_ payload: Payload, track: Track, groupId: UInt64?, bytes: Int, now: Ticks) {
+        self.tracks[track]?.queue.append(.init(groupId: groupId, bytes: bytes, enqueued: now, payload: payload))
+    }
+
+    /// Take the next object to send, if any is allowed now. It is charged, and its track marked in flight.
+    /// - Parameter now: The current time.
+    /// - Returns: The object and its track, or nil if nothing can be sent yet.
+    mutating func next(now: Ticks) -> (track: Track, payload: Payload)? {
+        for index in self.uplink.indices {
+            self.uplink[index].refill(now)
+        }
+        var chosen: (track: Track, egressClass: EgressClass, enqueued: Ticks)?
+        // In track order, so that ties and feedback are deterministic.
+        for track in self.tracks.keys.sorted() {
+            guard var state = self.tracks[track] else { continue }
+            self.dropStale(track, &state, now: now)
+            self.adjust(track, &state, now: now)
+            state.bucket?.refill(now)
+            self.tracks[track] = state
+            guard !state.inFlight,
+                  let head = state.queue.first,
+                  head.groupId == nil || self.affordable(&state, now: now) else { continue }
+            if let best = chosen, (best.egressClass, best.enqueued) <= (state.egressClass, head.enqueued) {
+                continue
+            }
+            chosen = (track, state.egressClass, head.enqueued)
+        }
+        guard let chosen,
+              var state = self.tracks[chosen.track],
+              let entry = state.queue.popFirst() else { return nil }
+        state.delay = max(state.delay, now.timeIntervalSince(entry.enqueued))
+        self.charge(&state, bytes: entry.bytes)
+        self.tracks[chosen.track] = state
+        return (chosen.track, entry.payload)
+    }
+
+    /// A track's object has been handed to its sink.
+    mutating func completed(_ track: Track) {
+        self.tracks[track]?.inFlight = false
+    }
+
+    /// Seconds from `now` until ``next(now:)`` may have something, or nil if nothing queued can become sendable
+    /// by time alone.
+    func nextWake(now: Ticks) -> TimeInterval? {
+        var wake: TimeInterval?
+        for state in self.tracks.values {
+            guard !state.inFlight, let head = state.queue.first else { continue }
+            var wait: TimeInterval = 0
+            if head.groupId != nil {
+                wait = state.bucket?.wait(now) ?? 0
+                if !self.uplink.isEmpty {
+                    wait = max(wait, self.uplink[state.egressClass.rawValue].wait(now))
+                }
+            }
+            wake = min(wake ?? wait, wait)
+        }
+        return wake
+    }
+
+    /// Take the feedback produced since last called.
+    mutating func takeFeedback() -> [Feedback] {
+        defer { self.feedback.removeAll(keepingCapacity: true) }
+        return self.feedback
+    }
+
+    private mutating func affordable(_ state: inout TrackState, now: Ticks) -> Bool {
+        state.bucket?.refill(now)
+        guard state.bucket?.available ?? true else { return false }
+        guard !self.uplink.isEmpty else { return true }
+        self.uplink[state.egressClass.rawValue].refill(now)
+        return self.uplink[state.egressClass.rawValue].available
+    }
+
+    private mutating func charge(_ state: inout TrackState, bytes: Int) {
+        state.bucket?.consume(bytes)
+        // Seen by this class and those less important.
+        for index in self.uplink.indices where index >= state.egressClass.rawValue {
+            self.uplink[index].consume(bytes)
+        }
+        state.inFlight = true
+    }
+
+    private mutating func dropStale(_ track: Track, _ state: inout TrackState, now: Ticks) {
+        guard let staleAfter = state.staleAfter else { return }
+        while let head = state.queue.first,
+              let groupId = head.groupId,
+              now.timeIntervalSince(head.enqueued) > staleAfter {
+            // The rest of its group depends on it, so is no use either.
+            state.queue.removeAll { $0.groupId == groupId }
+            state.droppedGroup = groupId
+            state.dropped = true
+            self.feedback.append(.dropped(track))
+        }
+    }
+
+    private mutating func adjust(_ track: Track, _ state: inout TrackState, now: Ticks) {
+        guard state.egressClass != .audio,
+              state.nominal > 0,
+              now.timeIntervalSince(state.adjusted) >= self.config.adjustInterval else { return }
+        let waiting = state.queue.first.map { now.timeIntervalSince($0.enqueued) } ?? 0
+        let delay = max(state.delay, waiting)
+        let target: Double
+        if state.dropped || delay > self.config.congestedDelay {
+            target = Double(state.target) * self.config.decrease
+        } else if delay < self.config.congestedDelay / 4 {
+            target = Double(state.target) * self.config.increase
+        } else {
+            target = Double(state.target)
+        }
+        let nominal = Double(state.nominal)
+        let clamped = UInt32(min(nominal, max(nominal * self.config.minimumFraction, target)))
+        state.adjusted = now
+        state.delay = 0
+        state.dropped = false
+        guard clamped != state.target else { return }
+        state.target = clamped
+        self.feedback.append(.targetBitrate(track, clamped))
+    }
+}
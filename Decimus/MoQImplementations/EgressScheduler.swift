@@ -0,0 +1,412 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Foundation
+import Synchronization
+
+/// Paces every publication's objects onto the uplink ahead of libquicr, see ``EgressQueue``.
+///
+/// Publications publish through a ``PacedSink`` made here. An object that can go immediately is published on the
+/// caller's thread as before; otherwise it is copied and queued, and published later from the scheduler's
+/// thread, in priority order. Queued objects that become sendable together are handed to libquicr as one
+/// ``QPublishBatch``.
+final class EgressScheduler: Sendable {
+    fileprivate enum Operation {
+        case object(PacedSink.Object)
+        case endSubgroup(groupId: UInt64, subgroupId: UInt64, completed: Bool)
+    }
+
+    private struct State {
+        var egress: EgressQueue<Operation>
+        var sinks: [EgressQueue<Operation>.Track: WeakSink] = [:]
+        /// When the job publishing queued objects next runs, or nil if it isn't running.
+        var wake: Ticks?
+        /// The running job, or nil if it isn't running or its token hasn't been stored yet.
+        var job: DeadlineScheduler.Token?
+    }
+
+    private enum Arm {
+        case start
+        case reschedule(DeadlineScheduler.Token, by: Ticks)
+    }
+
+    private struct WeakSink {
+        weak var sink: PacedSink?
+    }
+
+    private let state: Mutex<State>
+    private let scheduler: DeadlineScheduler
+    private let nextTrack = Atomic<EgressQueue<Operation>.Track>(0)
+    // Only used from the scheduler's thread.
+    private nonisolated(unsafe) let batch = QPublishBatch(capacity: 16)
+
+    /// Create a scheduler.
+    /// - Parameter config: Uplink budget and bitrate feedback behaviour.
+    /// - Parameter scheduler: Where queued objects are published from.
+    init(config: EgressConfig,
+         scheduler: DeadlineScheduler = .init(label: "Egress", tolerance: 0.0005)) {
+        self.state = .init(.init(egress: .init(config: config, now: .now)))
+        self.scheduler = scheduler
+    }
+
+    /// Pace a track's objects.
+    /// - Parameter inner: The track's transport sink.
+    /// - Parameter egressClass: The track's priority.
+    /// - Parameter bitrate: The track's nominal bitrate in bits per second, or 0 to not pace it individually.
+    /// - Returns: A sink to publish the track through.
+    func makeSink(_ inner: MoQSink, egressClass: EgressClass, bitrate: UInt32) -> PacedSink {
+        let track = self.nextTrack.add(1, ordering: .relaxed).newValue
+        let sink = PacedSink(inner, scheduler: self, track: track)
+        self.state.withLock { state in
+            state.egress.add(track, egressClass: egressClass, bitrate: bitrate, now: .now)
+            state.sinks[track] = .init(sink: sink)
+        }
+        return sink
+    }
+
+    fileprivate func remove(_ track: EgressQueue<Operation>.Track) {
+        self.state.withLock { state in
+            state.egress.remove(track)
+            state.sinks.removeValue(forKey: track)
+        }
+    }
+
+    fileprivate func admit(_ track: EgressQueue<Operation>.Track,
+                           groupId: UInt64?,
+                           bytes: Int) -> EgressQueue<Operation>.Admission {
+        var admission = EgressQueue<Operation>.Admission.send
+        var feedback: [(PacedSink, EgressQueue<Operation>.Feedback)] = []
+        self.state.withLock { state in
+            admission = state.egress.admit(track: track, groupId: groupId, bytes: bytes, now: .now)
+            feedback = Self.takeFeedback(&state)
+        }
+        Self.deliver(feedback)
+        return admission
+    }
+
+    fileprivate func enqueue(_ operation: Operation,
+                             track: EgressQueue<Operation>.Track,
+                             groupId: UInt64?,
+                             bytes: Int) {
+        let arm = self.state.withLock { state in
+            state.egress.enqueue(operation, track: track, groupId: groupId, bytes: bytes, now: .now)
+            return Self.arm(&state)
+        }
+        self.apply(arm)
+    }
+
+    fileprivate func completed(_ track: EgressQueue<Operation>.Track) {
+        // Anything the track queued meanwhile may now be sendable.
+        let arm = self.state.withLock { state in
+            state.egress.completed(track)
+            return Self.arm(&state)
+        }
+        self.apply(arm)
+    }
+
+    // Start the job if it isn't running, or wake it sooner if something can now be sent before it would wake,
+    // so that a newly queued important object doesn't wait out a long sleep for a less important one.
+    private static func arm(_ state: inout State) -> Arm? {
+        let now = Ticks.now
+        guard let wait = state.egress.nextWake(now: now) else { return nil }
+        guard let wake = state.wake else {
+            state.wake = now
+            return .start
+        }
+        let deadline = now.addingTimeInterval(wait)
+        guard deadline < wake else { return nil }
+        state.wake = deadline
+        // Without a token, the job is only just starting, and is woken by then once its token is stored.
+        guard let job = state.job else { return nil }
+        return .reschedule(job, by: deadline)
+    }
+
+    private func apply(_ arm: Arm?) {
+        switch arm {
+        case .start:
+            let job = self.scheduler.schedule { [weak self] _ in
+                self?.run()
+            }
+            // The job may already have run and gone back to sleep, missing a sooner wake asked for before its token
+            // was stored. Tokens increase, so one start racing a later one can't leave the older, stopped job's token.
+            let wake = self.state.withLock { state in
+                state.job = max(state.job ?? job, job)
+                return state.wake
+            }
+            if let wake {
+                self.scheduler.reschedule(job, by: wake)
+            }
+        case .reschedule(let job, let deadline):
+            self.scheduler.reschedule(job, by: deadline)
+        case nil:
+            break
+        }
+    }
+
+    private static func takeFeedback(_ state: inout State) -> [(PacedSink, EgressQueue<Operation>.Feedback)] {
+        state.egress.takeFeedback().compactMap { feedback in
+            let track = switch feedback {
+            case .dropped(let track), .targetBitrate(let track, _): track
+            }
+            guard let sink = state.sinks[track]?.sink else { return nil }
+            return (sink, feedback)
+        }
+    }
+
+    private static func deliver(_ feedback: [(PacedSink, EgressQueue<Operation>.Feedback)]) {
+        for (sink, feedback) in feedback {
+            switch feedback {
+            case .dropped:
+                sink.dropped()
+            case .targetBitrate(_, let bitrate):
+                sink.targetBitrate(bitrate)
+            }
+        }
+    }
+
+    // Publish everything sendable, then wait until more might be.
+    private func run() -> TimeInterval? {
+        while true {
+            var sendable: [(track: EgressQueue<Operation>.Track, payload: Operation, sink: PacedSink?)] = []
+            var wake: TimeInterval?
+            var feedback: [(PacedSink, EgressQueue<Operation>.Feedback)] = []
+            self.state.withLock { state in
+                let now = Ticks.now
+                // At most one per track, as each is in flight until completed.
+                while let next = state.egress.next(now: now) {
+                    sendable.append((next.track, next.payload, state.sinks[next.track]?.sink))
+                }
+                if sendable.isEmpty {
+                    wake = state.egress.nextWake(now: now)
+                    state.wake = wake.map { now.addingTimeInterval($0) }
+                    if wake == nil {
+                        // Stopping, so the next start must not find this job's token.
+                        state.job = nil
+                    }
+                }
+                feedback = Self.takeFeedback(&state)
+            }
+            Self.deliver(feedback)
+            guard !sendable.isEmpty else { return wake }
+            self.publish(sendable.map { ($0.payload, $0.sink) })
+            self.state.withLock { state in
+                for next in sendable {
+                    state.egress.completed(next.track)
+                }
+            }
+        }
+    }
+
+    // In the order chosen, runs of objects on libquicr tracks being converted and handed over as one batch.
+    private func publish(_ sendable: [(payload: Operation, sink: PacedSink?)]) {
+        var batched: [(sink: PacedSink, object: PacedSink.Object)] = []
+        for (payload, sink) in sendable {
+            guard let sink else { continue }
+            if let object = sink.add(payload, to: self.batch) {
+                batched.append((sink, object))
+                continue
+            }
+            self.flush(&batched)
+            sink.perform(payload)
+        }
+        self.flush(&batched)
+    }
+
+    private func flush(_ batched: inout [(sink: PacedSink, object: PacedSink.Object)]) {
+        guard !batched.isEmpty else { return }
+        var statuses = [QPublishObjectStatus](repeating: .ok, count: batched.count)
+        self.batch.publish(&statuses)
+        for ((sink, object), status) in zip(batched, statuses) {
+            sink.published(object, status: status)
+        }
+        batched.removeAll(keepingCapacity: true)
+    }
+}
+
+/// A ``MoQSink`` whose objects are paced by an ``EgressScheduler`` before reaching the transport.
+///
+/// An object published immediately returns the transport's status. A queued one returns ``QPublishObjectStatus/ok``,
+/// and later failure to publish it, or its being dropped as stale, is reported to the installed
+/// ``OnDropped`` instead. Objects of a group already dropped return ``QPublishObjectStatus/internalError``.
+/// Objects are only paced whole.
+final class PacedSink: MoQSink {
+    typealias OnDropped = @Sendable () -> Void
+    typealias OnTargetBitrate = @Sendable (UInt32) -> Void
+
+    fileprivate struct Object {
+        let groupId: UInt64
+        let subgroupId: UInt64
+        let objectId: UInt64
+        let payloadLength: UInt64
+        let status: QObjectStatus
+        let priority: UInt8?
+        let ttl: UInt16?
+        let data: Data
+        let extensions: HeaderExtensions?
+        let immutableExtensions: HeaderExtensions?
+        let streamHeaderProperties: QStreamHeaderProperties?
+    }
+
+    private struct Feedback {
+        let onDropped: OnDropped
+        let onTargetBitrate: OnTargetBitrate
+    }
+
+    private let logger: DecimusLogger
+    /// The transport sink objects are published to.
+    let inner: MoQSink
+    private let scheduler: EgressScheduler
+    private let track: EgressQueue<EgressScheduler.Operation>.Track
+    private let feedback = Mutex<Feedback?>(nil)
+
+    var fullTrackName: FullTrackName {
+        self.inner.fullTrackName
+    }
+
+    var status: QPublishTrackHandlerStatus {
+        self.inner.status
+    }
+
+    var canPublish: Bool {
+        self.inner.canPublish
+    }
+
+    fileprivate init(_ inner: MoQSink, scheduler: EgressScheduler, track: EgressQueue<EgressScheduler.Operation>.Track) {
+        self.logger = .init(PacedSink.self, prefix: "\(inner.fullTrackName)")
+        self.inner = inner
+        self.scheduler = scheduler
+        self.track = track
+    }
+
+    deinit {
+        self.scheduler.remove(self.track)
+    }
+
+    func setCallbacks(onStatus: @escaping OnStatus, onMetrics: @escaping OnMetrics) {
+        self.inner.setCallbacks(onStatus: onStatus, onMetrics: onMetrics)
+    }
+
+    /// Install the pacing callbacks, which fire on the scheduler's or a publishing thread.
+    /// - Parameter onDropped: Objects were dropped, so the next should start a new group.
+    /// - Parameter onTargetBitrate: The bitrate the track's encoder should target, in bits per second.
+    func setFeedback(onDropped: @escaping OnDropped, onTargetBitrate: @escaping OnTargetBitrate) {
+        self.feedback.withLock { $0 = .init(onDropped: onDropped, onTargetBitrate: onTargetBitrate) }
+    }
+
+    func publishObject(_ headers: QObjectHeaders,
+                       data: Data,
+                       extensions: HeaderExtensions?,
+                       immutableExtensions: HeaderExtensions?,
+                       streamHeaderProperties: QStreamHeaderProperties?) -> QPublishObjectStatus {
+        switch self.scheduler.admit(self.track, groupId: headers.groupId, bytes: data.count) {
+        case .send:
+            defer { self.scheduler.completed(self.track) }
+            return self.inner.publishObject(headers,
+                                            data: data,
+                                            extensions: extensions,
+                                            immutableExtensions: immutableExtensions,
+                                            streamHeaderProperties: streamHeaderProperties)
+        case .drop:
+            return .internalError
+        case .queue:
+            // The caller's data may only be borrowed for this call.
+            let copy = data.withUnsafeBytes { Data($0) }
+            let object = Object(groupId: headers.groupId,
+                                subgroupId: headers.subgroupId,
+                                objectId: headers.objectId,
+                                payloadLength: headers.payloadLength,
+                                status: headers.status,
+                                priority: headers.priority?.pointee,
+                                ttl: headers.ttl?.pointee,
+                                data: copy,
+                                extensions: extensions,
+                                immutableExtensions: immutableExtensions,
+                                streamHeaderProperties: streamHeaderProperties)
+            self.scheduler.enqueue(.object(object), track: self.track, groupId: headers.groupId, bytes: copy.count)
+            return .ok
+        }
+    }
+
+    func endSubgroup(groupId: UInt64, subgroupId: UInt64, completed: Bool) {
+        // Kept in order behind any queued objects.
+        let operation = EgressScheduler.Operation.endSubgroup(groupId: groupId,
+                                                              subgroupId: subgroupId,
+                                                              completed: completed)
+        switch self.scheduler.admit(self.track, groupId: nil, bytes: 0) {
+        case .send:
+            self.perform(operation)
+            self.scheduler.completed(self.track)
+        case .queue:
+            self.scheduler.enqueue(operation, track: self.track, groupId: nil, bytes: 0)
+        case .drop:
+            assertionFailure("Markers are never dropped")
+        }
+    }
+
+    fileprivate func perform(_ operation: EgressScheduler.Operation) {
+        switch operation {
+        case .object(let object):
+            let status = Self.withHeaders(object) { headers in
+                self.inner.publishObject(headers,
+                                         data: object.data,
+                                         extensions: object.extensions,
+                                         immutableExtensions: object.immutableExtensions,
+                                         streamHeaderProperties: object.streamHeaderProperties)
+            }
+            self.published(object, status: status)
+        case .endSubgroup(let groupId, let subgroupId, let completed):
+            self.inner.endSubgroup(groupId: groupId, subgroupId: subgroupId, completed: completed)
+        }
+    }
+
+    /// Add a queued operation to a batch, if it can be published as part of one.
+    /// - Returns: The object added, to report the batch's status for, or nil if the operation must be performed
+    /// alone.
+    fileprivate func add(_ operation: EgressScheduler.Operation, to batch: QPublishBatch) -> Object? {
+        guard case .object(let object) = operation,
+              let inner = self.inner as? QPublishTrackHandlerSink else { return nil }
+        Self.withHeaders(object) { headers in
+            batch.addObject(headers,
+                            data: object.data,
+                            extensions: object.extensions?.bridged,
+                            immutableExtensions: object.immutableExtensions?.bridged,
+                            streamHeaderProperties: object.streamHeaderProperties,
+                            handler: inner.handler)
+        }
+        return object
+    }
+
+    fileprivate func published(_ object: Object, status: QPublishObjectStatus) {
+        guard !status.accepted else { return }
+        self.logger.warning("Failed to publish queued object \(object.groupId):\(object.objectId): \(status)")
+        self.dropped()
+    }
+
+    fileprivate func dropped() {
+        self.feedback.get()?.onDropped()
+    }
+
+    fileprivate func targetBitrate(_ bitrate: UInt32) {
+        self.logger.info("Target bitrate: \(bitrate)")
+        self.feedback.get()?.onTargetBitrate(bitrate)
+    }
+
+    private static func withHeaders<Result>(_ object: Object, _ body: (QObjectHeaders) -> Result) -> Result {
+        Self.withPointer(to: object.priority) { priority in
+            Self.withPointer(to: object.ttl) { ttl in
+                body(.init(groupId: object.groupId,
+                           subgroupId: object.subgroupId,
+                           objectId: object.objectId,
+                           payloadLength: object.payloadLength,
+                           status: object.status,
+                           priority: priority,
+                           ttl: ttl))
+            }
+        }
+    }
+
+    private static func withPointer<T, Result>(to value: T?, _ body: (UnsafePointer<T>?) -> Result) -> Result {
+        guard let value else { return body(nil) }
+        return withUnsafePointer(to: value) { body($0) }
+    }
+}
@@ -15,6 +15,10 @@ protocol MoQSink: AnyObject, Sendable {
     /// Whether the sink is ready to publish objects.
     var canPublish: Bool { get }
 
+    /// Whether objects can be published in pieces with ``publishPartialObject(_:data:extensions:immutableExtensions:)``.
+    /// Not yet for any sink reaching libquicr, whose PublishPartialObject is unimplemented.
+    var supportsPartialObjects: Bool { get }
+
     /// Install the status and metrics callbacks and begin delivering them.
     /// Callbacks fire on the underlying transport thread.
     /// - Parameter onStatus: Status callback.
@@ -34,6 +38,86 @@ protocol MoQSink: AnyObject, Sendable {
                        immutableExtensions: HeaderExtensions?,
                        streamHeaderProperties: QStreamHeaderProperties?) -> QPublishObjectStatus
 
+    /// Publish the next piece of an object, so that it goes on the wire before the rest is ready.
+    /// - Parameters:
+    ///   - headers: The object's headers, whose payload length is the whole object's.
+    ///   - data: The piece's payload data.
+    ///   - extensions: Optional mutable header extensions, taken from the first piece.
+    ///   - immutableExtensions: Optional immutable header extensions, taken from the first piece.
+    /// - Returns: Status indicating success or failure reason.
+    func publishPartialObject(_ headers: QObjectHeaders,
+                              data: Data,
+                              extensions: HeaderExtensions?,
+                              immutableExtensions: HeaderExtensions?) -> QPublishObjectStatus
+
     /// End the given subgroup.
     func endSubgroup(groupId: UInt64, subgroupId: UInt64, completed: Bool)
 }
+
+extension MoQSink {
+    var supportsPartialObjects: Bool {
+        false
+    }
+
+    func publishPartialObject(_ headers: QObjectHeaders,
+                              data: Data,
+                              extensions: HeaderExtensions?,
+                              immutableExtensions: HeaderExtensions?) -> QPublishObjectStatus {
+        .internalError
+    }
+
+    /// Publish a complete object, in pieces if it is larger than a piece.
+    ///
+    /// Each piece is handed to the transport in turn, so that a large object's first bytes are sent while the rest
+    /// are still being handed over. Sinks that can't publish pieces are given the object whole.
+    /// - Parameters:
+    ///   - headers: Object headers including group/object IDs, payload length, priority, TTL.
+    ///   - data: The payload data.
+    ///   - pieceSize: Most bytes to publish at once, or 0 to publish whole.
+    ///   - extensions: Optional mutable header extensions.
+    ///   - immutableExtensions: Optional immutable header extensions.
+    /// - Returns: Status indicating success or failure reason.
+    func publishObject(_ headers: QObjectHeaders,
+                       data: Data,
+                       pieceSize: Int,
+                       extensions: HeaderExtensions?,
+                       immutableExtensions: HeaderExtensions?) -> QPublishObjectStatus {
+        guard pieceSize > 0, data.count > pieceSize, self.supportsPartialObjects else {
+            return self.publishObject(headers,
+                                      data: data,
+                                      extensions: extensions,
+                                      immutableExtensions: immutableExtensions,
+                                      streamHeaderProperties: nil)
+        }
+        return data.withUnsafeBytes { buffer in
+            var offset = 0
+            while offset < buffer.count {
+                let count = min(pieceSize, buffer.count - offset)
+                let piece = Data(bytesNoCopy: .init(mutating: buffer.baseAddress! + offset),
+                                 count: count,
+                                 deallocator: .none)
+                let first = offset == 0
+                let status = self.publishPartialObject(headers,
+                                                       data: piece,
+                                                       extensions: first ? extensions : nil,
+                                                       immutableExtensions: first ? immutableExtensions : nil)
+                guard status.accepted else { return status }
+                offset += count
+            }
+            return .ok
+        }
+    }
+}
+
+extension QPublishObjectStatus {
+    /// Whether an object, or a piece of one, was published. A piece is accepted as needing more of its object, or
+    /// completing it, rather than as ok.
+    var accepted: Bool {
+        switch self {
+        case .ok, .objectContinuationDataNeeded, .objectDataComplete:
+            true
+        default:
+            false
+        }
+    }
+}
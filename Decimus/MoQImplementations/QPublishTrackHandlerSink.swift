@@ -45,9 +45,7 @@ final class QPublishTrackHandlerSink: MoQSink {
 
     private let callbacks: PublishCallbackBox
 
-    var fullTrackName: FullTrackName {
-        .init(self.handler.getFullTrackName())
-    }
+    let fullTrackName: FullTrackName
 
     var status: QPublishTrackHandlerStatus {
         self.handler.getStatus()
@@ -75,6 +73,7 @@ final class QPublishTrackHandlerSink: MoQSink {
                              defaultPriority: defaultPriority,
                              defaultTTL: defaultTTL,
                              callbacks: callbacks)
+        self.fullTrackName = .init(self.handler.getFullTrackName())
     }
 
     func setCallbacks(onStatus: @escaping OnStatus, onMetrics: @escaping OnMetrics) {
@@ -88,8 +87,8 @@ final class QPublishTrackHandlerSink: MoQSink {
                        streamHeaderProperties: QStreamHeaderProperties?) -> QPublishObjectStatus {
         self.handler.publishObject(headers,
                                    data: data,
-                                   extensions: extensions,
-                                   immutableExtensions: immutableExtensions,
+                                   extensions: extensions?.bridged,
+                                   immutableExtensions: immutableExtensions?.bridged,
                                    streamHeaderProperties: streamHeaderProperties)
     }
 
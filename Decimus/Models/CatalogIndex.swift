@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import OrderedCollections
+
+/// What a ``CatalogIndex`` needs to know of a catalog track.
+protocol CatalogTrack: Equatable, Decodable {
+    /// How the catalog encodes a namespace.
+    associatedtype Namespace: Decodable
+    /// The track's namespace, if it has one.
+    var namespace: Namespace? { get }
+    /// The track's name.
+    var name: String { get }
+    /// The tuples of a namespace, ending with its publishing participant.
+    static func tuples(of namespace: Namespace) -> [String]
+}
+
+extension CatalogTrack {
+    /// The track's namespace tuples, if it has a namespace.
+    var namespaceTuples: [String]? {
+        self.namespace.map(Self.tuples(of:))
+    }
+}
+
+/// The tracks of a catalog, indexed by namespace prefix: their namespace without the publishing participant.
+///
+/// Patches are applied incrementally, reporting only the prefixes that appeared or disappeared, so that acting on
+/// an update costs in proportion to what changed rather than to the size of the catalog. A delta costs in
+/// proportion to its own size; a full catalog is diffed against the index.
+struct CatalogIndex<Track: CatalogTrack> {
+    /// Identifies a track across updates.
+    struct Key: Hashable {
+        let namespace: [String]
+        let name: String
+
+        /// The namespace prefix the track is indexed under.
+        var prefix: [String] {
+            Array(self.namespace.dropLast())
+        }
+    }
+
+    /// What applying a patch changed.
+    struct Changes {
+        /// Prefixes that gained their first tracks, with those tracks, in catalog order.
+        var added: OrderedDictionary<[String], [Track]> = [:]
+        /// Prefixes that lost their last track.
+        var removed: Set<[String]> = []
+
+        /// True if no prefix appeared or disappeared.
+        var isEmpty: Bool {
+            self.added.isEmpty && self.removed.isEmpty
+        }
+    }
+
+    private var prefixes: [[String]: OrderedDictionary<Key, Track>] = [:]
+
+    /// Number of tracks in the catalog.
+    private(set) var count = 0
+
+    /// Number of namespace prefixes with at least one track.
+    var prefixCount: Int {
+        self.prefixes.count
+    }
+
+    /// The tracks under a namespace prefix.
+    /// - Parameter prefix: Namespace tuples, without the publishing participant.
+    /// - Returns: The prefix's tracks, in catalog order.
+    func tracks(prefix: [String]) -> [Track] {
+        self.prefixes[prefix].map { Array($0.values) } ?? []
+    }
+
+    /// The catalog track describing a published track.
+    /// - Parameter namespace: The published track's namespace tuples, ending with its publishing participant.
+    /// - Parameter name: The published track's name.
+    /// - Returns: The track itself if the catalog lists it, else the first under its namespace prefix, if any.
+    func track(namespace: [String], name: String) -> Track? {
+        let key = Key(namespace: namespace, name: name)
+        guard let bucket = self.prefixes[key.prefix] else { return nil }
+        return bucket[key] ?? bucket.values.first
+    }
+
+    /// Apply an update.
+    /// - Parameter patch: A full catalog, or a delta against this one.
+    /// - Returns: The prefixes that appeared or disappeared.
+    mutating func apply(_ patch: CatalogPatch<Track>) -> Changes {
+        var changes = Changes()
+        switch patch {
+        case .full(let tracks):
+            let keyed = tracks.compactMap { track in Self.key(track).map { ($0, track) } }
+            let incoming = Set(keyed.map(\.0))
+            var gone: [Key] = []
+            for bucket in self.prefixes.values {
+                for key in bucket.keys where !incoming.contains(key) {
+                    gone.append(key)
+                }
+            }
+            for key in gone {
+                self.remove(key, changes: &changes)
+            }
+            // In catalog order, so that a prefix's tracks are too.
+            for (key, track) in keyed {
+                self.insert(key, track: track, changes: &changes)
+            }
+        case .delta(let add, let remove):
+            for removal in remove {
+                guard let key = Self.key(namespace: removal.namespace.map(Track.tuples(of:)), name: removal.name) else {
+                    continue
+                }
+                self.remove(key, changes: &changes)
+            }
+            for track in add {
+                guard let key = Self.key(track) else { continue }
+                self.insert(key, track: track, changes: &changes)
+            }
+        }
+        return changes
+    }
+
+    private static func key(_ track: Track) -> Key? {
+        self.key(namespace: track.namespaceTuples, name: track.name)
+    }
+
+    private static func key(namespace: [String]?, name: String) -> Key? {
+        guard let namespace, !namespace.isEmpty else { return nil }
+        return .init(namespace: namespace, name: name)
+    }
+
+    private mutating func insert(_ key: Key, track: Track, changes: inout Changes) {
+        let prefix = key.prefix
+        guard self.prefixes[prefix] != nil else {
+            self.prefixes[prefix] = [key: track]
+            self.count += 1
+            // Back within the same update is no change at all.
+            if changes.removed.remove(prefix) == nil {
+                changes.added[prefix] = [track]
+            }
+            return
+        }
+        if self.prefixes[prefix]!.updateValue(track, forKey: key) == nil {
+            self.count += 1
+        } else {
+            changes.added[prefix]?.removeAll { Self.key($0) == key }
+        }
+        changes.added[prefix]?.append(track)
+    }
+
+    private mutating func remove(_ key: Key, changes: inout Changes) {
+        let prefix = key.prefix
+        guard self.prefixes[prefix]?.removeValue(forKey: key) != nil else { return }
+        self.count -= 1
+        if changes.added[prefix] != nil {
+            changes.added[prefix]!.removeAll { Self.key($0) == key }
+        }
+        guard self.prefixes[prefix]!.isEmpty else { return }
+        self.prefixes.removeValue(forKey: prefix)
+        // Gone within the same update it arrived in is no change at all.
+        if changes.added.removeValue(forKey: prefix) == nil {
+            changes.removed.insert(prefix)
+        }
+    }
+}
+
+extension CatalogIndex.Changes: Sendable where Track: Sendable {}
@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+/// An update published on an MSF catalog track: either a whole catalog, or a delta against the catalog so far.
+enum CatalogPatch<Track: CatalogTrack>: Decodable {
+    /// A track to remove, of which a delta carries only the namespace and name.
+    struct Removal: Decodable {
+        let namespace: Track.Namespace?
+        let name: String
+    }
+
+    /// Every track in the catalog, replacing what came before.
+    case full([Track])
+    /// Tracks to add or replace, and tracks to remove.
+    case delta(add: [Track], remove: [Removal])
+
+    private enum CodingKeys: String, CodingKey {
+        case deltaUpdate
+        case tracks
+        case addTracks
+        case removeTracks
+    }
+
+    init(from decoder: Decoder) throws {
+        let container = try decoder.container(keyedBy: CodingKeys.self)
+        guard try container.decodeIfPresent(Bool.self, forKey: .deltaUpdate) ?? false else {
+            self = .full(try container.decode([Track].self, forKey: .tracks))
+            return
+        }
+        self = .delta(add: try container.decodeIfPresent([Track].self, forKey: .addTracks) ?? [],
+                      remove: try container.decodeIfPresent([Removal].self, forKey: .removeTracks) ?? [])
+    }
+}
@@ -38,22 +38,26 @@ extension MSF.Track {
     }
 }
 
+extension MSF.Track: CatalogTrack {
+    static func tuples(of namespace: Namespace) -> [String] {
+        namespace.tuples
+    }
+}
+
 extension [MSF.Track] {
     /// Find the catalog track matching an incoming publish by track name.
     func findMatch(name: String) -> MSF.Track? {
         first { $0.name == name }
     }
-}
 
-extension MSF.Catalog {
-    /// Convert this catalog into `ManifestPublication`s, grouped by namespace prefix.
+    /// Convert these catalog tracks into `ManifestPublication`s, grouped by namespace prefix.
     /// The `localParticipantId` is appended as the last namespace tuple for publications.
     func toPublications(localParticipantId: String) -> [ManifestPublication] {
         // Group tracks by their namespace prefix (without participant ID).
         var publications: [String: ManifestPublication] = [:]
         var profiles: [String: [Profile]] = [:]
 
-        for track in tracks {
+        for track in self {
             guard let namespace = track.namespace else { continue }
             var tuples = namespace.tuples
             // Pop remote participant, replace with local.
@@ -248,11 +248,7 @@ final class H264Publication: FrameListener, PublicationInstance {
             let protected: Data
             if let sframeContext = publication.sframeContext {
                 do {
-                    protected = try sframeContext.context.mutex.withLock { context in
-                        try context.protect(epochId: sframeContext.currentEpoch,
-                                            senderId: sframeContext.senderId,
-                                            plaintext: data)
-                    }
+                    protected = try sframeContext.protect(data)
                 } catch {
                     publication.logger.error("Failed to protect data: \(error.localizedDescription)")
                     return (QPublishObjectStatus.internalError, 0)
@@ -305,10 +301,8 @@ final class H264Publication: FrameListener, PublicationInstance {
         measurement.sentFrame(bytes: UInt64(bytes),
                               timestamp: presentationDate.timeIntervalSince1970,
                               age: sent?.timeIntervalSince(presentationDate) ?? nil,
+                              activity: sentActivityValue?.rawValue,
                               metricsTimestamp: sent)
-        if publication.granularMetrics, let sent, let sentActivityValue {
-            measurement.audioActivity(sentActivityValue.rawValue, timestamp: sent)
-        }
     }
 
     required init(profile: Profile,
@@ -367,6 +361,11 @@ final class H264Publication: FrameListener, PublicationInstance {
         self.sink.setCallbacks(
             onStatus: { [weak self] status in self?.handleStatus(status) },
             onMetrics: { [weak self] metrics in self?.trackMeasurement?.record(metrics) })
+        if let paced = self.sink as? PacedSink {
+            paced.setFeedback(
+                onDropped: { [weak self] in self?.handleDropped() },
+                onTargetBitrate: { [weak self] bitrate in self?.handleTargetBitrate(bitrate) })
+        }
     }
 
     internal func publish(groupId: UInt64,
@@ -412,6 +411,20 @@ final class H264Publication: FrameListener, PublicationInstance {
         }
     }
 
+    private func handleDropped() {
+        // The rest of the group can't be decoded without what was dropped.
+        self.logger.debug("[\(self.profile.namespace.joined())] Stale objects dropped, requesting key frame")
+        self.generateKeyFrame.store(true, ordering: .releasing)
+    }
+
+    private func handleTargetBitrate(_ bitrate: UInt32) {
+        do {
+            try self.encoder.setBitrate(bitrate)
+        } catch {
+            self.logger.warning("Failed to set target bitrate \(bitrate): \(error.localizedDescription)")
+        }
+    }
+
     /// This callback fires when a video frame arrives.
     func onFrame(_ sampleBuffer: CMSampleBuffer,
                  timestamp: Date) {
@@ -483,17 +496,12 @@ final class H264Publication: FrameListener, PublicationInstance {
         let date: Date? = self.granularMetrics ? timestamp : nil
         let now = Date.now
         let activityValue: UInt8? = self.granularMetrics ? self.lastVoiceActivityState.get()?.rawValue : nil
-        measurement.sentPixels(sent: pixels, timestamp: date)
-        if let date = date {
-            // TODO: This age is probably useless.
-            let age = now.timeIntervalSince(timestamp)
-            measurement.age(age: age,
-                            presentationTimestamp: timestamp.timeIntervalSince1970,
-                            metricsTimestamp: date)
-        }
-        if let activityValue, let date {
-            measurement.audioActivity(activityValue, timestamp: date)
-        }
+        // TODO: This age is probably useless.
+        measurement.capturedFrame(pixels: pixels,
+                                  age: now.timeIntervalSince(timestamp),
+                                  presentationTimestamp: timestamp.timeIntervalSince1970,
+                                  activity: activityValue,
+                                  metricsTimestamp: date)
     }
 
     /// Returns the parameter sets contained within the sample's format, if any.
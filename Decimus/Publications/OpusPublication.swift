@@ -223,11 +223,7 @@ final class OpusPublication: AudioPublication, PublicationInstance {
         let protected: Data
         if let sframeContext {
             do {
-                protected = try sframeContext.context.mutex.withLock { locked in
-                    try locked.protect(epochId: sframeContext.currentEpoch,
-                                       senderId: sframeContext.senderId,
-                                       plaintext: data)
-                }
+                protected = try sframeContext.protect(data)
             } catch {
                 self.logger.error("Failed to protect: \(error.localizedDescription)")
                 return
@@ -42,7 +42,8 @@ class PublicationFactoryImpl: PublicationFactory {
     private let verbose: Bool
     private let keyFrameOnUpdate: Bool
     private let startingGroup: UInt64?
-    private let sframeContext: SendSFrameContext?
+    private let sframeKeyring: SFrameKeyring?
+    private let egressScheduler: EgressScheduler?
     private let mediaInterop: Bool
     private let appExtensionMode: AppExtensionMode
     private let overrideNamespace: [String]?
@@ -61,7 +62,8 @@ class PublicationFactoryImpl: PublicationFactory {
          verbose: Bool,
          keyFrameOnUpdate: Bool,
          startingGroup: UInt64?,
-         sframeContext: SendSFrameContext?,
+         sframeKeyring: SFrameKeyring?,
+         egressScheduler: EgressScheduler?,
          mediaInterop: Bool,
          appExtensionMode: AppExtensionMode,
          overrideNamespace: [String]?,
@@ -79,7 +81,8 @@ class PublicationFactoryImpl: PublicationFactory {
         self.verbose = verbose
         self.keyFrameOnUpdate = keyFrameOnUpdate
         self.startingGroup = startingGroup
-        self.sframeContext = sframeContext
+        self.sframeKeyring = sframeKeyring
+        self.egressScheduler = egressScheduler
         self.mediaInterop = mediaInterop
         self.appExtensionMode = appExtensionMode
         self.overrideNamespace = overrideNamespace
@@ -93,8 +96,18 @@ class PublicationFactoryImpl: PublicationFactory {
                 relayId: String) throws -> [(FullTrackName, any PublicationInstance)] {
         var publications: [(FullTrackName, any PublicationInstance)] = []
         var count = 0
-        for profile in publication.profileSet.profiles {
-            let config = codecFactory.makeCodecConfig(from: profile.qualityProfile, bitrateType: .average)
+        let configs = publication.profileSet.profiles.map {
+            codecFactory.makeCodecConfig(from: $0.qualityProfile, bitrateType: .average)
+        }
+        // The lowest quality video is the base layer.
+        let baseBitrate = configs.filter { $0 is VideoCodecConfig }.map(\.bitrate).min()
+        for (profile, config) in zip(publication.profileSet.profiles, configs) {
+            let egressClass: EgressClass = switch config.codec {
+            case .h264, .hevc:
+                config.bitrate == baseBitrate ? .baseLayer : .enhancementLayer
+            default:
+                .audio
+            }
             var profile = profile
             if let overrideNamespace = self.overrideNamespace {
                 profile = profile.transformNamespace(overrideNamespace: overrideNamespace,
@@ -109,7 +122,8 @@ class PublicationFactoryImpl: PublicationFactory {
                                                   config: config,
                                                   metricsSubmitter: self.metricsSubmitter,
                                                   endpointId: endpointId,
-                                                  relayId: relayId)
+                                                  relayId: relayId,
+                                                  egressClass: egressClass)
                 publications.append((fullTrackName, publication))
             } catch {
                 self.logger.warning("[\(fullTrackName)] Couldn't create publication: \(error.localizedDescription)",
@@ -125,7 +139,8 @@ class PublicationFactoryImpl: PublicationFactory {
                 config: CodecConfig,
                 metricsSubmitter: MetricsSubmitter?,
                 endpointId: String,
-                relayId: String) throws -> any PublicationInstance {
+                relayId: String,
+                egressClass: EgressClass) throws -> any PublicationInstance {
         switch config.codec {
         case .h264, .hevc:
             guard let captureManager = self.captureManager else {
@@ -164,12 +179,12 @@ class PublicationFactoryImpl: PublicationFactory {
                               userData: userData)
             }
 
-            let sink = QPublishTrackHandlerSink(
+            let sink = self.pace(QPublishTrackHandlerSink(
                 fullTrackName: try profile.getFullTrackName(),
                 trackMode: self.reliability.video ? .stream : .datagram,
                 defaultPriority: try profile.getPriority(index: 0),
                 defaultTTL: UInt32(try profile.getTTL(index: 0))
-            )
+            ), egressClass: egressClass, bitrate: config.bitrate)
 
             let publication = try H264Publication(profile: profile,
                                                   config: config,
@@ -182,7 +197,7 @@ class PublicationFactoryImpl: PublicationFactory {
                                                   stagger: self.stagger,
                                                   verbose: self.verbose,
                                                   keyFrameOnUpdate: self.keyFrameOnUpdate,
-                                                  sframeContext: self.sframeContext,
+                                                  sframeContext: self.sframeKeyring?.makeSendContext(),
                                                   mediaInterop: self.mediaInterop,
                                                   appExtensionMode: self.appExtensionMode,
                                                   sharedVoiceActivity: self.voiceActivity?.sharedVoiceActivity,
@@ -197,10 +212,12 @@ class PublicationFactoryImpl: PublicationFactory {
             guard let config = config as? AudioCodecConfig else {
                 throw CodecError.invalidCodecConfig(type(of: config))
             }
-            let sink = QPublishTrackHandlerSink(fullTrackName: try profile.getFullTrackName(),
-                                                trackMode: self.reliability.audio ? .stream : .datagram,
-                                                defaultPriority: try profile.getPriority(index: 0),
-                                                defaultTTL: UInt32(try profile.getTTL(index: 0)))
+            let sink = self.pace(QPublishTrackHandlerSink(fullTrackName: try profile.getFullTrackName(),
+                                                          trackMode: self.reliability.audio ? .stream : .datagram,
+                                                          defaultPriority: try profile.getPriority(index: 0),
+                                                          defaultTTL: UInt32(try profile.getTTL(index: 0))),
+                                 egressClass: egressClass,
+                                 bitrate: config.bitrate)
             return try OpusPublication(profile: profile,
                                        participantId: self.participantId,
                                        metricsSubmitter: metricsSubmitter,
@@ -212,27 +229,34 @@ class PublicationFactoryImpl: PublicationFactory {
                                        relayId: relayId,
                                        startActive: true,
                                        incrementing: .group,
-                                       sframeContext: self.sframeContext,
+                                       sframeContext: self.sframeKeyring?.makeSendContext(),
                                        mediaInterop: self.mediaInterop,
                                        appExtensionMode: self.appExtensionMode,
                                        voiceActivity: self.voiceActivity,
                                        sink: sink)
         case .text:
-            let sink = QPublishTrackHandlerSink(fullTrackName: try profile.getFullTrackName(),
-                                                trackMode: .stream,
-                                                defaultPriority: try profile.getPriority(index: 0),
-                                                defaultTTL: UInt32(try profile.getTTL(index: 0)))
+            let sink = self.pace(QPublishTrackHandlerSink(fullTrackName: try profile.getFullTrackName(),
+                                                          trackMode: .stream,
+                                                          defaultPriority: try profile.getPriority(index: 0),
+                                                          defaultTTL: UInt32(try profile.getTTL(index: 0))),
+                                 egressClass: egressClass,
+                                 bitrate: config.bitrate)
             return try TextPublication(participantId: self.participantId,
                                        incrementing: .object,
                                        profile: profile,
                                        submitter: metricsSubmitter,
                                        endpointId: endpointId,
                                        relayId: relayId,
-                                       sframeContext: self.sframeContext,
+                                       sframeContext: self.sframeKeyring?.makeSendContext(),
                                        startingGroupId: self.startingGroup ?? 0,
                                        sink: sink)
         default:
             throw CodecError.noCodecFound(config.codec)
         }
     }
+
+    /// Publish through the egress scheduler, if pacing.
+    private func pace(_ sink: MoQSink, egressClass: EgressClass, bitrate: UInt32) -> MoQSink {
+        self.egressScheduler?.makeSink(sink, egressClass: egressClass, bitrate: bitrate) ?? sink
+    }
 }
@@ -52,11 +52,7 @@ final class TextPublication: PublicationInstance {
         let data: Data
         if let sframeContext = self.sframeContext {
             do {
-                data = try sframeContext.context.mutex.withLock { context in
-                    try context.protect(epochId: sframeContext.currentEpoch,
-                                        senderId: sframeContext.senderId,
-                                        plaintext: .init(message.utf8))
-                }
+                data = try sframeContext.protect(.init(message.utf8))
             } catch {
                 self.logger.error("Failed to protect message: \(error.localizedDescription)")
                 return
@@ -3,17 +3,18 @@
 
 /// Calculates interarrival jitter according to RFC 3550.
 final class RFC3550Jitter: Sendable {
-    private nonisolated(unsafe) var transit: TimeInterval?
+    private let estimator: QJitterEstimator
     /// Current jitter value.
-    private(set) nonisolated(unsafe) var jitter: TimeInterval = 0
+    var jitter: TimeInterval { self.estimator.jitter() }
     /// Exponentially smoothed value.
-    private(set) nonisolated(unsafe) var smoothed: TimeInterval = 0
+    var smoothed: TimeInterval { self.estimator.smoothed() }
     private let measurement: RFC3550JitterMeasurement?
 
     /// Alpha for exponential smoothing.
-    private let alpha = 0.1
+    private static let alpha = 0.1
 
     init(identifier: String, submitter: MetricsSubmitter?) {
+        self.estimator = .init(alpha: Self.alpha)
         guard let submitter else {
             self.measurement = nil
             return
@@ -23,26 +24,10 @@ final class RFC3550Jitter: Sendable {
         self.measurement = measurement
     }
 
-    /// Record an arrival timestamp. This must only be called from 1 concurrency context.
+    /// Record an arrival timestamp. This must only be called from 1 concurrency context,
+    /// but values can be read from any.
     func record(timestamp: TimeInterval, arrival: Date) {
-        // Calculation.
-        let transit = arrival.timeIntervalSince1970 - timestamp
-        guard let lastTransit = self.transit else {
-            self.transit = transit
-            return
-        }
-
-        var d = transit - lastTransit
-        self.transit = transit
-        if d < 0 {
-            d = -d
-        }
-        self.jitter += (1.0 / 16.0) * (d - self.jitter)
-
-        // Smoothed.
-        self.smoothed = self.alpha * self.jitter + (1 - self.alpha) * self.smoothed
-
-        // Record metric.
+        guard self.estimator.record(timestamp, arrival: arrival.timeIntervalSince1970) else { return }
         self.measurement?.jitter(jitter: self.jitter, smoothed: self.smoothed, date: arrival)
     }
 }
@@ -51,13 +36,16 @@ final class RFC3550JitterMeasurement: MetricsMeasurement {
     let storage = MeasurementStorage()
     let name = "RFC3550"
     let tags: [String: String]
+    private let jitters = LatencyHistogram("jitter", range: 0...10)
+    private let smoothedJitters = LatencyHistogram("smoothed", range: 0...10)
+    var histograms: [LatencyHistogram] { [self.jitters, self.smoothedJitters] }
 
     init(namespace: QuicrNamespace) {
         self.tags = ["namespace": namespace]
     }
 
     func jitter(jitter: TimeInterval, smoothed: TimeInterval, date: Date) {
-        self.record(field: "jitter", value: jitter, timestamp: date)
-        self.record(field: "smoothed", value: smoothed, timestamp: date)
+        self.jitters.record(jitter, timestamp: date, into: self)
+        self.smoothedJitters.record(smoothed, timestamp: date, into: self)
     }
 }
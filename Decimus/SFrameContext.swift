@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import CryptoKit
+import Foundation
+import SFrame
+import Synchronization
+
+/// An SFrame context for unprotecting received objects.
+final class SFrameContext: Sendable {
+    let mutex: Mutex<MLS>
+
+    init(_ sframe: MLS) {
+        self.mutex = .init(sframe)
+    }
+
+    /// Unprotect a received object.
+    /// - Parameter ciphertext: The SFrame protected object.
+    /// - Returns: The plaintext.
+    func unprotect(_ ciphertext: Data) throws -> Data {
+        try self.mutex.withLock { try $0.unprotect(ciphertext: ciphertext) }
+    }
+
+    /// Unprotect several received objects, taking the context once.
+    /// - Parameter ciphertexts: The SFrame protected objects.
+    /// - Returns: The plaintexts, in the same order.
+    func unprotect(_ ciphertexts: [Data]) throws -> [Data] {
+        try self.mutex.withLock { context in
+            try ciphertexts.map { try context.unprotect(ciphertext: $0) }
+        }
+    }
+}
+
+/// An SFrame context for protecting objects as one sender in one epoch.
+final class SendSFrameContext: Sendable {
+    typealias OnReleased = @Sendable (SFrameContext) -> Void
+
+    let context: SFrameContext
+    let senderId: MLS.SenderID
+    let currentEpoch: MLS.EpochID
+    private let onReleased: OnReleased?
+
+    convenience init(sframe: MLS, senderId: MLS.SenderID, currentEpoch: MLS.EpochID) {
+        self.init(context: .init(sframe), senderId: senderId, currentEpoch: currentEpoch, onReleased: nil)
+    }
+
+    /// Create from an existing context.
+    /// - Parameter onReleased: Called with the context when this is released.
+    init(context: SFrameContext, senderId: MLS.SenderID, currentEpoch: MLS.EpochID, onReleased: OnReleased?) {
+        self.context = context
+        self.senderId = senderId
+        self.currentEpoch = currentEpoch
+        self.onReleased = onReleased
+    }
+
+    deinit {
+        self.onReleased?(self.context)
+    }
+
+    /// Protect an object for publishing.
+    /// - Parameter plaintext: The object.
+    /// - Returns: The SFrame protected object.
+    func protect(_ plaintext: Data) throws -> Data {
+        try self.context.mutex.withLock { context in
+            try context.protect(epochId: self.currentEpoch, senderId: self.senderId, plaintext: plaintext)
+        }
+    }
+
+    /// Protect several objects for publishing, taking the context once.
+    /// - Parameter plaintexts: The objects.
+    /// - Returns: The SFrame protected objects, in the same order.
+    func protect(_ plaintexts: [Data]) throws -> [Data] {
+        try self.context.mutex.withLock { context in
+            try plaintexts.map {
+                try context.protect(epochId: self.currentEpoch, senderId: self.senderId, plaintext: $0)
+            }
+        }
+    }
+}
+
+/// Makes independent SFrame contexts from a call's key, one per publication and subscription.
+///
+/// Sharing one context means every protect and unprotect in the call queues on its lock. Each context made
+/// here has its own key state, so they only contend with themselves. Send contexts each get their own
+/// sender ID, so that their independent counters never reuse a nonce under the same key: the call's sender
+/// ID, shifted up by ``contextBits``, with a per context index in the low bits. Receivers derive keys from
+/// the key ID in each object's header, so need no changes.
+///
+/// At most `1 << contextBits` send contexts can be in use at once. A released one's index is reused along with
+/// its key state, so that the next context with its sender ID carries on its counter rather than repeating its
+/// nonces.
+final class SFrameKeyring: Sendable {
+    /// Bits of a send context's sender ID identifying the context.
+    static let contextBits = 8
+
+    private struct SendContexts {
+        /// Index of the next new context.
+        var next: MLS.SenderID = 0
+        /// Contexts no longer in use, by index.
+        var released: [(index: MLS.SenderID, context: SFrameContext)] = []
+    }
+
+    let senderId: MLS.SenderID
+    let currentEpoch: MLS.EpochID
+    private let secret: SymmetricKey
+    private let sendContexts = Mutex(SendContexts())
+
+    /// Create a keyring.
+    /// - Parameter key: The shared SFrame key.
+    /// - Parameter senderId: The sender ID of this participant.
+    /// - Parameter currentEpoch: The epoch to protect in.
+    init(key: String, senderId: MLS.SenderID, currentEpoch: MLS.EpochID) throws {
+        self.senderId = senderId
+        self.currentEpoch = currentEpoch
+        self.secret = SymmetricKey(data: Data(key.utf8))
+        // Fail early on an unusable key.
+        _ = try self.makeMLS()
+    }
+
+    /// Make a context to protect one publication's objects with.
+    /// - Returns: The context, with a sender ID of its own among those in use.
+    func makeSendContext() throws -> SendSFrameContext {
+        let index: MLS.SenderID
+        let context: SFrameContext
+        if let released = self.sendContexts.withLock({ $0.released.popLast() }) {
+            index = released.index
+            context = released.context
+        } else {
+            context = .init(try self.makeMLS())
+            index = try self.sendContexts.withLock { contexts in
+                guard contexts.next < 1 << Self.contextBits else {
+                    throw "Too many SFrame send contexts in use"
+                }
+                defer { contexts.next += 1 }
+                return contexts.next
+            }
+        }
+        return .init(context: context,
+                     senderId: self.senderId << Self.contextBits | index,
+                     currentEpoch: self.currentEpoch) { [weak self] context in
+            self?.sendContexts.withLock { $0.released.append((index, context)) }
+        }
+    }
+
+    /// Make a context to unprotect one subscription's objects with.
+    /// - Returns: The context.
+    func makeReceiveContext() throws -> SFrameContext {
+        .init(try self.makeMLS())
+    }
+
+    private func makeMLS() throws -> MLS {
+        guard let suite = registry[.aes_128_gcm_sha256_128] else {
+            throw "Unsupported CipherSuite"
+        }
+        let context = try MLS(provider: SwiftCryptoProvider(suite: suite), epochBits: 1)
+        try context.addEpoch(epochId: self.currentEpoch, sframeEpochSecret: self.secret)
+        return context
+    }
+}
@@ -1,21 +1,36 @@
 // SPDX-FileCopyrightText: Copyright (c) 2025 Cisco Systems
 // SPDX-License-Identifier: BSD-2-Clause
 
-import DequeModule
-import Synchronization
+/// A value that a `SlidingTimeWindow` can hold, which is stored as a `Double`.
+protocol SlidingWindowValue: Numeric, Sendable {
+    init(windowValue: Double)
+    var windowValue: Double { get }
+}
+
+extension Double: SlidingWindowValue {
+    init(windowValue: Double) { self = windowValue }
+    var windowValue: Double { self }
+}
+
+extension Int: SlidingWindowValue {
+    init(windowValue: Double) { self.init(windowValue) }
+    var windowValue: Double { Double(self) }
+}
 
 /// Container for a sliding time window of values
 /// whose validity is determined by age.
-class SlidingTimeWindow<T: Numeric & Sendable> {
-    private let values: Mutex<Deque<(timestamp: Date, value: T)>>
-    private let length: TimeInterval
+/// Values can be added from one concurrency context while they are read from another, without locking.
+class SlidingTimeWindow<T: SlidingWindowValue> {
+    /// Capacity used when none is reserved.
+    static var defaultCapacity: Int { 4096 }
+
+    private let values: QSlidingWindow
 
     /// Create a new sliding time window.
     /// - Parameter length: The length of the window.
-    /// - Parameter reserved: Optionally, capacity to reserve in elements.
+    /// - Parameter reserved: Optionally, capacity in elements. Values added while full are dropped.
     init(length: TimeInterval, reserved: Int? = nil) {
-        self.length = length
-        self.values = .init(.init(minimumCapacity: reserved ?? 0))
+        self.values = .init(capacity: reserved ?? Self.defaultCapacity, length: length)
     }
 
     /// Add a timestamped value to the window.
@@ -23,23 +38,19 @@ class SlidingTimeWindow<T: Numeric & Sendable> {
     ///  - timestamp: The timestamp of the value.
     ///  - value: The value to add.
     func add(timestamp: Date, value: T) {
-        self.values.withLock { $0.append((timestamp, value)) }
+        self.values.add(timestamp.timeIntervalSinceReferenceDate, value: value.windowValue)
     }
 
     /// Given a point in time, return all older values within the window.
     /// - Parameter from: The time from which the window will start.
     /// - Returns: An array of values no older than the window.
     func get(from: Date) -> [T] {
-        self.values.withLock { values in
-            var toRemove = IndexSet()
-            for index in values.indices {
-                let element = values[index]
-                guard from.timeIntervalSince(element.timestamp) > self.length else { break }
-                toRemove.insert(index)
-            }
-            values.remove(atOffsets: toRemove)
-            return values.reduce(into: []) { $0.append($1.value) }
+        let count = self.values.expire(from.timeIntervalSinceReferenceDate)
+        guard count > 0 else { return [] }
+        let values = [Double](unsafeUninitializedCapacity: count) { buffer, initialized in
+            initialized = self.values.read(buffer.baseAddress!, capacity: count)
         }
+        return values.map { T(windowValue: $0) }
     }
 }
 
@@ -37,6 +37,7 @@ class ActiveSpeakerApply<T> where T: QSubscribeTrackHandlerObjC {
     private let participantId: ParticipantId
     private let activeSpeakerStats: ActiveSpeakerStats?
     private let pauseResume: Bool
+    private let pool: PreSubscriptionPool?
 
     // For current state reporting.
     private(set) var lastRenderedSpeakers: OrderedSet<ParticipantId> = []
@@ -49,13 +50,15 @@ class ActiveSpeakerApply<T> where T: QSubscribeTrackHandlerObjC {
     ///  - subscriptions: Manifest of all available subscriptions.
     ///  - factory: Factory for subscription handler creation.
     ///  - participantId: Local participant ID.
+    ///  - pool: Optionally, keeps likely next speakers subscribed but paused.
     init(notifier: ActiveSpeakerNotifier,
          controller: MoqCallController,
          videoSubscriptions: [ManifestSubscription],
          factory: SubscriptionFactory,
          participantId: ParticipantId,
          activeSpeakerStats: ActiveSpeakerStats?,
-         pauseResume: Bool) throws {
+         pauseResume: Bool,
+         pool: PreSubscriptionPool? = nil) throws {
         self.notifier = notifier
         self.controller = controller
         guard videoSubscriptions.allSatisfy({ $0.mediaType == ManifestMediaTypes.video.rawValue }) else {
@@ -68,6 +71,7 @@ class ActiveSpeakerApply<T> where T: QSubscribeTrackHandlerObjC {
         self.participantId = participantId
         self.activeSpeakerStats = activeSpeakerStats
         self.pauseResume = pauseResume
+        self.pool = pool
         self.callbackToken = self.notifier.registerActiveSpeakerCallback { [weak self] activeSpeakers in
             Task { @MainActor in
                 self?.onActiveSpeakersChanged(activeSpeakers)
@@ -97,6 +101,7 @@ class ActiveSpeakerApply<T> where T: QSubscribeTrackHandlerObjC {
         let now = Date.now
         if real {
             self.lastReceived = speakers
+            self.pool?.predictor.speakersChanged(speakers, when: .now)
             if let stats = self.activeSpeakerStats {
                 Task(priority: .utility) {
                     for speaker in speakers {
@@ -119,6 +124,9 @@ class ActiveSpeakerApply<T> where T: QSubscribeTrackHandlerObjC {
 
         // Update slots.
         self.recheck(real: real, desiredSlots: speakers.count, when: now)
+
+        // Ready for whoever is likely next.
+        self.pool?.update(rendered: self.lastRenderedSpeakers)
     }
 
     private func recheck(real: Bool, desiredSlots: Int, when: Date) {
@@ -138,7 +146,10 @@ class ActiveSpeakerApply<T> where T: QSubscribeTrackHandlerObjC {
             guard existingSets[manifestSet.sourceID] == nil else {
                 // We already have this set, what state is it in?
                 let existingSet = existingSets[manifestSet.sourceID]!
-                if self.pauseResume && existingSet.isPaused {
+                if self.pool?.claim(existingSet) == true {
+                    // Resumed from the pool, with a new group on its way.
+                    self.logger.debug("[ActiveSpeakers] Resumed pre-subscribed: \(id)")
+                } else if self.pauseResume && existingSet.isPaused {
                     // If it's paused, it should be resumed.
                     existingSet.resume()
                 }
@@ -200,7 +211,9 @@ class ActiveSpeakerApply<T> where T: QSubscribeTrackHandlerObjC {
 
         // Everything new is now setup. At this point, we should be rechecking our subscriptions from scratch.
         // If there are more active subscriptions than live subscriptions, we need to unsubscribe from them.
-        let inPlay = self.pauseResume ? existingSets.filter { !$0.value.isPaused }.count : existingSets.count
+        // Sets held by the pool are its own business.
+        let managed = existingSets.filter { !(self.pool?.isMember($0.value) ?? false) }
+        let inPlay = self.pauseResume ? managed.filter { !$0.value.isPaused }.count : managed.count
         if currentSlots == desiredSlots && inPlay > desiredSlots {
             // Remove one.
             self.unsubscribe(real: real, when: when)
@@ -213,7 +226,9 @@ class ActiveSpeakerApply<T> where T: QSubscribeTrackHandlerObjC {
 
     private func unsubscribe(real: Bool, when: Date) {
         let filter: (any SubscriptionSet) -> Bool = {
-            $0 is VideoSubscriptionSet && !self.lastRenderedSpeakers.contains($0.participantId)
+            $0 is VideoSubscriptionSet &&
+                !self.lastRenderedSpeakers.contains($0.participantId) &&
+                !(self.pool?.isMember($0) ?? false)
         }
         let filterWithPause: (any SubscriptionSet) -> Bool = { !$0.isPaused && filter($0) }
 
@@ -223,7 +238,10 @@ class ActiveSpeakerApply<T> where T: QSubscribeTrackHandlerObjC {
             .filter(self.pauseResume ? filterWithPause : filter)
             .sorted(by: { $0.participantId < $1.participantId })
             .first {
-            if self.pauseResume {
+            if self.pool?.adopt(toUnsub) == true {
+                // Likely to speak again soon, so held paused by the pool.
+                self.logger.debug("[ActiveSpeakers] Pre-subscribed: \(toUnsub.participantId)")
+            } else if self.pauseResume {
                 // Pause.
                 self.logger.debug("[ActiveSpeakers] Pausing : \(toUnsub.participantId)")
                 toUnsub.pause()
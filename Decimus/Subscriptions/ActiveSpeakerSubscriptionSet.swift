@@ -9,6 +9,7 @@ class ActiveSpeakerSubscriptionSet: ObservableSubscriptionSet, @unchecked Sendab
     private let ourParticipantId: ParticipantId?
     private let metricsSubmitter: MetricsSubmitter?
     private let activeSpeakerStats: ActiveSpeakerStats?
+    private let speakerPredictor: SpeakerPredictor?
 
     /// Individual active speaker subscriptions.
     private var handlers: [FullTrackName: QSubscribeTrackHandlerObjC] = [:]
@@ -26,11 +27,13 @@ class ActiveSpeakerSubscriptionSet: ObservableSubscriptionSet, @unchecked Sendab
          ourParticipantId: ParticipantId?,
          submitter: MetricsSubmitter?,
          activeSpeakerStats: ActiveSpeakerStats?,
+         speakerPredictor: SpeakerPredictor? = nil,
          config: AudioHandler.Config) {
         self.engine = engine
         self.ourParticipantId = ourParticipantId
         self.metricsSubmitter = submitter
         self.activeSpeakerStats = activeSpeakerStats
+        self.speakerPredictor = speakerPredictor
         self.audioHandlerConfig = config
         super.init(sourceId: subscription.sourceID, participantId: subscription.participantId)
     }
@@ -61,8 +64,15 @@ class ActiveSpeakerSubscriptionSet: ObservableSubscriptionSet, @unchecked Sendab
             return
         }
 
-        // Metrics.
+        // Loud audio suggests who will be announced as speaking next.
         let now = Ticks.now
+        if let speakerPredictor = self.speakerPredictor,
+           let level = (try? extensions?.getHeader(.audioLevel)) ?? (try? immutableExtensions.getHeader(.audioLevel)),
+           case .audioLevel(let audioLevel) = level {
+            speakerPredictor.audioLevel(participantId, level: audioLevel, when: now)
+        }
+
+        // Metrics.
         if let activeSpeakerStats = self.activeSpeakerStats {
             Task(priority: .utility) {
                 await activeSpeakerStats.audioDetected(participantId,
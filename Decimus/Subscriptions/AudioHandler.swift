@@ -1,7 +1,6 @@
 // SPDX-FileCopyrightText: Copyright (c) 2023 Cisco Systems
 // SPDX-License-Identifier: BSD-2-Clause
 
-import Accelerate
 import Foundation
 import AVFAudio
 import CoreAudio
@@ -11,16 +10,20 @@ enum OpusSubscriptionError: Error {
     case failedDecoderCreation
 }
 
+/// Decodes and conceals audio. Returned buffers may be reused by the decoder, so a decoded buffer is only valid
+/// until the next `write`, and a concealed one until the next `plc`.
 protocol AudioDecoder {
     var decodedFormat: AVAudioFormat { get }
     var encodedFormat: AVAudioFormat { get }
+    /// Most frames one `write` or `plc` call can return.
+    var maxFrames: AVAudioFrameCount { get }
     func write(data: Data) throws -> AVAudioPCMBuffer
     func frames(data: Data) throws -> AVAudioFrameCount
     func plc(frames: AVAudioFrameCount) throws -> AVAudioPCMBuffer
     func reset() throws
 }
 
-class AudioHandler: TimeAlignable {
+class AudioHandler: TimeAlignable, DequeueSchedulable {
     struct Config {
         let jitterDepth: TimeInterval
         let jitterMax: TimeInterval
@@ -38,18 +41,17 @@ class AudioHandler: TimeAlignable {
     private var decoder: AudioDecoder
     private let engine: DecimusAudioEngine
     private let asbd: UnsafeMutablePointer<AudioStreamBasicDescription>
-    private var node: AVAudioSourceNode?
     private var oldJitterBuffer: QJitterBuffer?
     private var playoutBuffer: CircularBuffer?
     private let measurement: OpusSubscription.OpusSubscriptionMeasurement?
     private let underrun = Atomic<UInt64>(0)
     private let callbacks = Atomic<UInt64>(0)
-    private let silenceRemoved = Atomic<UInt64>(0)
     private let granularMetrics: Bool
-    private var dequeueTask: Task<Void, Never>?
+    private let dequeueCoordinator: VideoDequeueCoordinator
     private var lastUsedSequence: UInt64?
     private let windowSizeUs = Atomic<UInt32>(0)
     private var windowSize: OpusWindowSize?
+    private var windowDuration: CMTime = .invalid
     private let metricsSubmitter: MetricsSubmitter?
     private let config: Config
     private let playing: Atomic<Bool> = .init(false)
@@ -57,7 +59,12 @@ class AudioHandler: TimeAlignable {
     var jitterBuffer: JitterBuffer?
     let timeDiff = TimeDiff()
 
-    private var silenceDetectionBuffer: UnsafeMutableBufferPointer<Float32>?
+    // Time stretching of playout, only touched by the render thread once created.
+    private var stretcher: QTimeStretcher?
+    private var rateController: PlayoutRateController
+    private var playoutRate: Double = 1
+    // Set when playout jumps, for the render thread to drop what the stretcher holds from before.
+    private let resetStretcher = Atomic<Bool>(false)
 
     // Time based buffer.
     private var timeAligner: TimeAligner?
@@ -70,11 +77,14 @@ class AudioHandler: TimeAlignable {
         let sequenceNumber: UInt64
         /// Capture timestamp of this audio (first frame's time).
         let timestamp: CMTime
+        /// Duration of this opus packet.
+        let duration: CMTime
 
-        init(data: Data, sequenceNumber: UInt64, timestamp: CMTime) {
+        init(data: Data, sequenceNumber: UInt64, timestamp: CMTime, duration: CMTime) {
             self.data = data
             self.sequenceNumber = sequenceNumber
             self.timestamp = timestamp
+            self.duration = duration
         }
     }
 
@@ -83,7 +93,8 @@ class AudioHandler: TimeAlignable {
          decoder: AudioDecoder,
          measurement: OpusSubscription.OpusSubscriptionMeasurement?,
          metricsSubmitter: MetricsSubmitter?,
-         config: Config) throws {
+         config: Config,
+         dequeueCoordinator: VideoDequeueCoordinator = .shared) throws {
         self.identifier = identifier
         self.engine = engine
         self.measurement = measurement
@@ -92,88 +103,47 @@ class AudioHandler: TimeAlignable {
         self.asbd = .init(mutating: decoder.decodedFormat.streamDescription)
         self.config = config
         self.metricsSubmitter = metricsSubmitter
+        self.dequeueCoordinator = dequeueCoordinator
         self.jitterCalculation = .init(identifier: identifier, submitter: metricsSubmitter)
+        self.rateController = .init(start: config.playoutBufferTime * 2, stop: config.playoutBufferTime)
         if !self.config.useNewJitterBuffer {
             // Create the jitter buffer.
             let opusPacketSize = self.asbd.pointee.mSampleRate * config.opusWindowSize.rawValue
-            self.oldJitterBuffer = QJitterBuffer(elementSize: Int(asbd.pointee.mBytesPerPacket),
-                                                 packetElements: Int(opusPacketSize),
-                                                 clockRate: UInt(asbd.pointee.mSampleRate),
-                                                 maxLengthMs: UInt(config.jitterMax * 1000),
-                                                 minLengthMs: UInt(config.jitterDepth * 1000)) { _, msg, _ in
+            let jitterBuffer = QJitterBuffer(elementSize: Int(asbd.pointee.mBytesPerPacket),
+                                             packetElements: Int(opusPacketSize),
+                                             clockRate: UInt(asbd.pointee.mSampleRate),
+                                             maxLengthMs: UInt(config.jitterMax * 1000),
+                                             minLengthMs: UInt(config.jitterDepth * 1000)) { _, msg, _ in
                 guard let msg else { return }
                 print(msg)
             }
-            // Create the player node.
-            self.node = .init(format: self.decoder.decodedFormat, renderBlock: self.renderBlock)
-            let node = AVAudioSourceNode(format: self.decoder.decodedFormat, renderBlock: self.renderBlock)
-            self.node = node
-            try self.engine.addPlayer(identifier: identifier, node: node)
+            guard let jitterBuffer else { throw "Failed to create jitter buffer" }
+            self.oldJitterBuffer = jitterBuffer
             self.jitterBuffer = nil
+            try self.addPlayer()
         }
     }
 
     deinit {
-        // Remove the audio playout.
+        self.dequeueCoordinator.unregister(self.dequeueIdentifier)
+
+        // Remove the audio playout, which waits out any render still using this.
         do {
             try engine.removePlayer(identifier: self.identifier)
         } catch {
             self.logger.warning("Couldn't remove player: \(error.localizedDescription)")
         }
-
-        // Reset the node.
-        node?.reset()
-
-        // Deallocate silence detection buffer.
-        if let silenceDetectionBuffer = self.silenceDetectionBuffer {
-            silenceDetectionBuffer.deallocate()
-            self.silenceDetectionBuffer = nil
-        }
     }
 
     func createNewJitterBuffer(windowDuration: CMTime) throws -> JitterBuffer {
         guard self.config.useNewJitterBuffer else { throw "Configuration Issue" }
-        // swiftlint:disable force_cast
-        let handlers = CMBufferQueue.Handlers { builder in
-            builder.compare {
-                let first = $0 as! AudioJitterItem
-                let second = $1 as! AudioJitterItem
-                let seq1 = first.sequenceNumber
-                let seq2 = second.sequenceNumber
-                if seq1 < seq2 {
-                    return .compareLessThan
-                } else if seq1 > seq2 {
-                    return .compareGreaterThan
-                } else if seq1 == seq2 {
-                    return .compareEqualTo
-                }
-                assert(false)
-                return .compareLessThan
-            }
-            builder.getDecodeTimeStamp {
-                ($0 as! AudioJitterItem).timestamp
-            }
-            builder.getDuration { _ in
-                windowDuration
-            }
-            builder.getPresentationTimeStamp {
-                ($0 as! AudioJitterItem).timestamp
-            }
-            builder.getSize {
-                ($0 as! AudioJitterItem).data.count
-            }
-            builder.isDataReady { _ in
-                true
-            }
-        }
-        // swiftlint:enable force_cast
         guard windowDuration.seconds > 0 else { throw "Bad window size" }
         let buffer = try JitterBuffer(identifier: self.identifier,
                                       metricsSubmitter: self.metricsSubmitter,
                                       minDepth: self.config.jitterDepth,
-                                      capacity: Int(self.config.jitterMax / windowDuration.seconds),
-                                      handlers: handlers)
+                                      capacity: Int(self.config.jitterMax / windowDuration.seconds))
         self.jitterBuffer = buffer
+        self.windowDuration = windowDuration
 
         let format = DecimusAudioEngine.format
         let playoutLength = UInt32(format.sampleRate *
@@ -181,6 +151,8 @@ class AudioHandler: TimeAlignable {
                                     self.config.jitterMax)
         self.playoutBuffer = try .init(length: playoutLength,
                                        format: self.asbd.pointee)
+        self.stretcher = .init(sampleRate: UInt32(format.sampleRate),
+                               maxFrames: DecimusAudioEngine.maxRenderFrames)
         let slidingWindowLength: TimeInterval = self.config.slidingWindowTime
         let capacity = Int(slidingWindowLength * (1.0 / self.config.opusWindowSize.rawValue))
         self.timeAligner = .init(windowLength: slidingWindowLength,
@@ -188,11 +160,8 @@ class AudioHandler: TimeAlignable {
             guard let self = self else { return [] }
             return [self]
         }
-        self.createDequeueTask()
-        // Create the player node.
-        let node = AVAudioSourceNode(format: self.decoder.decodedFormat, renderBlock: self.renderBlock)
-        self.node = node
-        try self.engine.addPlayer(identifier: self.identifier, node: node)
+        self.dequeueCoordinator.register(self)
+        try self.addPlayer()
         return buffer
     }
 
@@ -235,21 +204,29 @@ class AudioHandler: TimeAlignable {
             // Emplace this encoded data into the jitter buffer.
             let usSinceEpoch = timestamp.timeIntervalSince1970 * microsecondsPerSecond
             let timestamp = CMTime(value: CMTimeValue(usSinceEpoch), timescale: CMTimeScale(microsecondsPerSecond))
-            let item = AudioJitterItem(data: data, sequenceNumber: sequence, timestamp: timestamp)
+            let item = AudioJitterItem(data: data,
+                                       sequenceNumber: sequence,
+                                       timestamp: timestamp,
+                                       duration: self.windowDuration)
             do {
                 try jitterBuffer.write(item: item, from: date.hostDate)
             } catch JitterBufferError.full {
                 self.logger.warning("Didn't enqueue audio as jitter buffer is full")
             } catch JitterBufferError.old {
                 self.logger.warning("Didn't enqueue audio as already concealed / used")
+            } catch JitterBufferError.duplicate {
+                self.logger.warning("Didn't enqueue audio as already enqueued")
             }
 
             if let measurement = self.measurement {
                 let metricsDate = self.granularMetrics ? date.hostDate : nil
                 measurement.callbacks(callbacks: self.callbacks.load(ordering: .relaxed),
                                       timestamp: metricsDate)
-                measurement.removedSilence(removed: self.silenceRemoved.load(ordering: .relaxed),
-                                           timestamp: metricsDate)
+                if let stretcher = self.stretcher {
+                    measurement.stretched(removed: stretcher.removed(),
+                                          inserted: stretcher.inserted(),
+                                          timestamp: metricsDate)
+                }
                 measurement.framesUnderrun(underrun: self.underrun.load(ordering: .relaxed),
                                            timestamp: metricsDate)
             }
@@ -283,8 +260,36 @@ class AudioHandler: TimeAlignable {
         }
     }
 
-    private lazy var renderBlock: AVAudioSourceNodeRenderBlock = { [weak self] silence, timestamp, numFrames, data in
-        guard let self = self else { return .zero }
+    /// Start playing out through the engine's mixer.
+    private func addPlayer() throws {
+        guard self.decoder.decodedFormat == DecimusAudioEngine.format else {
+            throw "Decoded format \(self.decoder.decodedFormat) doesn't match playout format"
+        }
+        // The render thread must never own the handler, or could release it and run deinit there, removing the
+        // player from inside its own render. Unretained is safe as deinit removes the player before anything is
+        // freed, waiting out any render in progress.
+        try self.engine.addPlayer(identifier: self.identifier) { [unowned(unsafe) self] destination, frames, hostTime in
+            var silence: ObjCBool = false
+            var timestamp = AudioTimeStamp()
+            timestamp.mHostTime = hostTime
+            timestamp.mFlags = .hostTimeValid
+            let bytes = frames * self.asbd.pointee.mBytesPerFrame
+            var list = AudioBufferList(mNumberBuffers: 1,
+                                       mBuffers: .init(mNumberChannels: self.asbd.pointee.mChannelsPerFrame,
+                                                       mDataByteSize: bytes,
+                                                       mData: destination))
+            guard self.render(&silence, &timestamp, frames, &list) == .zero,
+                  !silence.boolValue else {
+                return 0
+            }
+            return frames
+        }
+    }
+
+    private func render(_ silence: UnsafeMutablePointer<ObjCBool>,
+                        _ timestamp: UnsafePointer<AudioTimeStamp>,
+                        _ numFrames: AVAudioFrameCount,
+                        _ data: UnsafeMutablePointer<AudioBufferList>) -> OSStatus {
         self.playing.store(true, ordering: .releasing)
         // Fill the buffers as best we can.
         self.callbacks.wrappingAdd(UInt64(numFrames), ordering: .relaxed)
@@ -311,143 +316,57 @@ class AudioHandler: TimeAlignable {
         assert(buffer.mDataByteSize == numFrames * self.asbd.pointee.mBytesPerFrame)
 
         var copiedFrames = 0
-        if let playoutBuffer = self.playoutBuffer {
-            // Dequeue audio from the playout buffer, catching up where late if possible.
-            var currentDestination = data.pointee
-            var currentDestinationSamples = numFrames
-            assert(numFrames == currentDestination.mBuffers.mDataByteSize / self.asbd.pointee.mBytesPerFrame)
-            var iterations = 0
-            while currentDestinationSamples > 0 {
-                iterations += 1
-                let currentSamples = Int(currentDestinationSamples)
-                if self.silenceDetectionBuffer == nil {
-                    self.silenceDetectionBuffer = .allocate(capacity: currentSamples)
-                } else if let buffer = self.silenceDetectionBuffer,
-                          buffer.count < currentSamples {
-                    buffer.deallocate()
-                    self.silenceDetectionBuffer = .allocate(capacity: currentSamples)
-                }
-
-                // Work in timed chunks.
-                let analysisSizeTime: TimeInterval = 0.005 // 5ms.
-                let analysisSizeFrames = AVAudioFrameCount(ceil(analysisSizeTime * self.asbd.pointee.mSampleRate))
-
-                // Attempt to dequeue the required frames from the playout buffer.
-                let result = playoutBuffer.dequeue(frames: currentDestinationSamples, buffer: &currentDestination)
-                guard result.frames > 0 else {
-                    // No frames were available, so we're done.
-                    break
-                }
-                var validThisPass = result.frames
-
-                // How early or late is this frame?
-                let now = timestamp.pointee.mHostTime
-                let dueAt = result.timestamp.mHostTime
-                let dueIn = SignedTicks(dueAt) - SignedTicks(now)
-                let lateThreshold = SignedTicks(self.config.playoutBufferTime.ticks)
-                // TODO: This doubling is a bit of a hack.
-                guard dueIn < (-lateThreshold * 2) else {
-                    // This wasn't late, we're done.
-                    copiedFrames += Int(validThisPass)
-                    break
-                }
+        if let playoutBuffer = self.playoutBuffer,
+           let stretcher = self.stretcher {
+            if self.resetStretcher.exchange(false, ordering: .acquiring) {
+                stretcher.reset()
+            }
 
-                // Late!
-                // If there is more data to consume, we should remove any silence, and dequeue more to fill.
-                let remaining = playoutBuffer.peek().frames
-                guard remaining > 0 else {
-                    // Nothing left to use, nothing we can do.
-                    copiedFrames += Int(validThisPass)
-                    break
-                }
+            // How late is the audio that would play now, counting what the stretcher is holding?
+            let sampleRate = self.asbd.pointee.mSampleRate
+            let head = playoutBuffer.peek()
+            let held = stretcher.buffered()
+            var late: TimeInterval = 0
+            if head.frames > 0 {
+                late = timestamp.pointee.mHostTime.timeIntervalSince(head.timestamp.mHostTime)
+                late += TimeInterval(held) / sampleRate
+            }
 
-                // There are more frames to consume, so let's try and catch up a bit by removing silence.
-
-                var writeIndex = 0
-                let silenceThreshold: Float32 = 0.001
-                var removed: AVAudioFrameCount = 0
-
-                assert(self.asbd.pointee.mBytesPerFrame == MemoryLayout<Float32>.size)
-                let lengthSamples: UnsafeMutableBufferPointer<Float32>
-                lengthSamples = .init(start: currentDestination.mBuffers.mData?.bindMemory(to: Float32.self,
-                                                                                           capacity: currentSamples),
-                                      count: currentSamples)
-
-                // Silence detection.
-                let dequeuedFrames = result.frames
-                vDSP_vabs(lengthSamples.baseAddress!,
-                          1,
-                          self.silenceDetectionBuffer!.baseAddress!,
-                          1,
-                          vDSP_Length(lengthSamples.count))
-
-                var index = 0
-                let incrementBy = min(Int(analysisSizeFrames), lengthSamples.count)
-                while index <= lengthSamples.count - incrementBy {
-                    let rms = Self.rms(buffer: self.silenceDetectionBuffer!.baseAddress!.advanced(by: index),
-                                       count: incrementBy)
-                    if rms < silenceThreshold {
-                        // Skip this entire silent chunk.
-                        removed += AVAudioFrameCount(incrementBy)
-                        validThisPass -= AVAudioFrameCount(incrementBy)
-                        guard removed < remaining else { break }
-                    } else {
-                        // Keep this chunk.
-                        if index != writeIndex {
-                            memmove(lengthSamples.baseAddress!.advanced(by: writeIndex),
-                                    lengthSamples.baseAddress!.advanced(by: index),
-                                    Int(incrementBy) * MemoryLayout<Float32>.size)
-                        }
-                        writeIndex += incrementBy
-                    }
-                    index += incrementBy
-                }
+            // Catch up by playing faster when late, and stretch by playing slower when running low.
+            let available = head.frames + held
+            var rate = self.rateController.rate(late: late,
+                                                available: available,
+                                                frames: numFrames,
+                                                lookahead: stretcher.lookahead())
+            var needed = stretcher.inputNeeded(numFrames, rate: rate)
+            if rate > 1 && needed > head.frames {
+                // Not enough buffered to search ahead, so there's nothing to catch up with.
+                rate = 1
+                needed = stretcher.inputNeeded(numFrames, rate: rate)
+            }
 
-                // Remainder.
-                let leftToCheck = lengthSamples.count - index
-                if leftToCheck > 0 && remaining > removed + AVAudioFrameCount(leftToCheck) {
-                    let rms = Self.rms(buffer: self.silenceDetectionBuffer!.baseAddress!.advanced(by: index),
-                                       count: leftToCheck)
-                    if rms < silenceThreshold {
-                        // Skip this entire silent chunk.
-                        removed += AVAudioFrameCount(leftToCheck)
-                        validThisPass -= AVAudioFrameCount(leftToCheck)
-                    } else {
-                        // Keep this chunk.
-                        if index != writeIndex {
-                            memmove(lengthSamples.baseAddress!.advanced(by: writeIndex),
-                                    lengthSamples.baseAddress!.advanced(by: index),
-                                    leftToCheck * MemoryLayout<Float32>.size)
-                        }
-                        writeIndex += leftToCheck
-                    }
-                    index += incrementBy
-                }
+            // Move what's needed from the playout buffer straight into the stretcher.
+            var toDequeue = min(needed, head.frames)
+            if toDequeue > 0 {
+                let input = stretcher.reserve(&toDequeue)
+                var list = AudioBufferList(mNumberBuffers: 1,
+                                           mBuffers: .init(mNumberChannels: self.asbd.pointee.mChannelsPerFrame,
+                                                           mDataByteSize: toDequeue * self.asbd.pointee.mBytesPerFrame,
+                                                           mData: UnsafeMutableRawPointer(input)))
+                let result = playoutBuffer.dequeue(frames: toDequeue, buffer: &list)
+                stretcher.commit(result.frames)
+            }
 
-                if removed > 0 {
-                    self.silenceRemoved.wrappingAdd(UInt64(removed), ordering: .relaxed)
-                }
+            assert(self.asbd.pointee.mBytesPerFrame == MemoryLayout<Float32>.size)
+            let destination = buffer.mData!.assumingMemoryBound(to: Float32.self)
+            copiedFrames = Int(stretcher.read(destination, frames: numFrames, rate: rate))
 
-                // Now we attempt to dequeue more frames to fill up to the target.
-                // Update our state, and iterate.
-
-                // Bytes we just filled.
-                let usedBytes = validThisPass * self.asbd.pointee.mBytesPerFrame
-                // Move the buffer forward.
-                currentDestination.mBuffers.mData = currentDestination.mBuffers.mData!.advanced(by: Int(usedBytes))
-                // Update available space.
-                currentDestination.mBuffers.mDataByteSize -= UInt32(usedBytes)
-                // Update required samples.
-                currentDestinationSamples -= validThisPass
-                // Update total frames copied this pass.
-                copiedFrames += Int(validThisPass)
-
-                #if DEBUG
-                let timeSaved = TimeInterval(removed) * (1.0 / self.asbd.pointee.mSampleRate) * 1000
-                // swiftlint:disable:next line_length
-                self.logger.debug("Audio was late at playout: \(Ticks(abs(dueIn)).seconds * 1000)ms. Removed \(removed) (\(timeSaved)ms) silent frames. Took: \(iterations) iterations")
-                #endif
+            #if DEBUG
+            if rate != self.playoutRate {
+                self.logger.debug("Audio playout rate \(self.playoutRate) -> \(rate). \(late * 1000)ms late")
             }
+            #endif
+            self.playoutRate = rate
         } else if let jitterBuffer = self.oldJitterBuffer {
             copiedFrames = jitterBuffer.dequeue(buffer.mData,
                                                 destinationLength: Int(buffer.mDataByteSize),
@@ -479,13 +398,6 @@ class AudioHandler: TimeAlignable {
         return .zero
     }
 
-    private static func rms(buffer: UnsafeMutablePointer<Float32>, count: Int) -> Float32 {
-        var sum: Float32 = 0.0
-        let count = vDSP_Length(count)
-        vDSP_svesq(buffer, 1, &sum, count)
-        return sqrt(sum / Float32(count))
-    }
-
     private let plcCallback: PacketCallback = { packets, count, userData in
         guard let userData = userData else {
             assert(false)
@@ -493,28 +405,45 @@ class AudioHandler: TimeAlignable {
         }
         let handler: AudioHandler = Unmanaged<AudioHandler>.fromOpaque(userData).takeUnretainedValue()
         var concealed: UInt64 = 0
-        for index in 0..<count {
-            // Make PLC packets.
-            var packet = packets!.advanced(by: index)
+        var index = 0
+        while index < count {
+            // Conceal as many consecutive packets as the decoder can in one call.
+            var end = index
+            var frames = 0
+            while end < count,
+                  frames + packets![end].elements <= Int(handler.decoder.maxFrames) {
+                frames += packets![end].elements
+                end += 1
+            }
+            guard end > index else {
+                handler.logger.error("Can't conceal packet of \(packets![index].elements) frames")
+                index += 1
+                continue
+            }
             do {
-                // TODO: This can be optimized with some further work to decode PLC directly into the buffer.
-                let plcData = try handler.decoder.plc(frames: AVAudioFrameCount(packet.pointee.elements))
+                let plcData = try handler.decoder.plc(frames: AVAudioFrameCount(frames))
                 let list = plcData.audioBufferList
                 guard list.pointee.mNumberBuffers == 1 else {
                     throw "Not sure what to do with this"
                 }
 
-                // Get audio data as packet list.
+                // Split the concealed audio across the packets.
                 let audioBuffer = list.pointee.mBuffers
                 guard let data = audioBuffer.mData else {
                     throw "AudioBuffer data was nil"
                 }
-                assert(packet.pointee.length == audioBuffer.mDataByteSize)
-                memcpy(packet.pointee.data, data, packet.pointee.length)
-                concealed += UInt64(packet.pointee.elements)
+                var offset = 0
+                for slot in index..<end {
+                    let packet = packets![slot]
+                    assert(offset + packet.length <= Int(audioBuffer.mDataByteSize))
+                    memcpy(packet.data, data + offset, packet.length)
+                    offset += packet.length
+                }
+                concealed += UInt64(frames)
             } catch {
                 handler.logger.error("\(error.localizedDescription)")
             }
+            index = end
         }
         if let measurement = handler.measurement {
             let constConcealed = concealed
@@ -563,73 +492,60 @@ class AudioHandler: TimeAlignable {
         }
     }
 
-    private func createDequeueTask() {
-        // Start the frame dequeue task.
-        self.dequeueTask = .init(priority: .high) { [weak self] in
-            while !Task.isCancelled {
-                let waitTime: TimeInterval
-                let windowSize: OpusWindowSize
-                if let self = self {
-                    let now = Ticks.now
-                    // Get current window size / backup wait.
-                    if let set = self.windowSize {
-                        windowSize = set
-                    } else {
-                        let stored = self.windowSizeUs.load(ordering: .acquiring)
-                        if stored == 0 {
-                            windowSize = .twentyMs
-                        } else {
-                            let interval = TimeInterval(stored) / microsecondsPerSecond
-                            guard let window = OpusWindowSize(rawValue: interval) else {
-                                self.logger.error("Bad opus window size calculation")
-                                return
-                            }
-                            self.windowSize = window
-                            windowSize = window
-                        }
-                    }
+    // MARK: DequeueSchedulable implementation.
 
-                    // Wait until we expect to have a frame available.
-                    if let calc = self.calculateWaitTime(from: now) {
-                        // Deliberately dequeue early to account for the playout buffer target size.
-                        waitTime = calc - self.config.playoutBufferTime
-                    } else {
-                        waitTime = windowSize.rawValue
-                    }
-                } else {
-                    return
-                }
+    var dequeueIdentifier: String {
+        "\(self.identifier) \(ObjectIdentifier(self))"
+    }
 
-                // Sleep without holding a strong reference.
-                if waitTime > 0 {
-                    try? await Task.sleep(for: .seconds(waitTime),
-                                          tolerance: .seconds(waitTime / 2),
-                                          clock: .continuous)
-                }
+    func calculateNextDeadline(from now: Ticks) -> Ticks? {
+        guard let windowSize = self.currentWindowSize() else { return nil }
 
-                // Regain our strong reference after sleeping.
-                if let self = self {
-                    // Attempt to dequeue an opus packet.
-                    let now = Ticks.now
-                    guard let item: AudioJitterItem  = self.jitterBuffer!.read(from: now.hostDate) else { continue }
-
-                    // Record the actual delay (difference between when this should
-                    // be presented, and now).
-                    if self.granularMetrics,
-                       let measurement = self.measurement {
-                        if let time = self.calculateWaitTime(item: item, from: now) {
-                            // Adjust this time to reflect our deliberate early dequeue.
-                            let adjusted = time - self.config.playoutBufferTime
-                            measurement.frameDelay(delay: -adjusted, metricsTimestamp: now.hostDate)
-                        }
-                    }
+        // Wait until we expect to have a frame available.
+        if let calc = self.calculateWaitTime(from: now) {
+            // Deliberately dequeue early to account for the playout buffer target size.
+            return now.addingTimeInterval(calc - self.config.playoutBufferTime)
+        }
+        return now.addingTimeInterval(windowSize.rawValue)
+    }
 
-                    // Decode, conceal, enqueue for playout.
-                    self.checkForDiscontinuity(item, window: windowSize, when: now.hostDate)
-                    self.decode(item, when: now.hostDate)
-                }
+    func processFrame(at now: Ticks) -> Bool {
+        // Attempt to dequeue an opus packet.
+        guard let windowSize = self.currentWindowSize() else { return false }
+        guard let item: AudioJitterItem = self.jitterBuffer!.read(from: now.hostDate) else { return true }
+
+        // Record the actual delay (difference between when this should
+        // be presented, and now).
+        if self.granularMetrics,
+           let measurement = self.measurement {
+            if let time = self.calculateWaitTime(item: item, from: now) {
+                // Adjust this time to reflect our deliberate early dequeue.
+                let adjusted = time - self.config.playoutBufferTime
+                measurement.frameDelay(delay: -adjusted, metricsTimestamp: now.hostDate)
             }
         }
+
+        // Decode, conceal, enqueue for playout.
+        self.checkForDiscontinuity(item, window: windowSize, when: now.hostDate)
+        self.decode(item, when: now.hostDate)
+        return true
+    }
+
+    /// Get current window size / backup wait.
+    /// - Returns: The window size, or nil if it couldn't be determined.
+    private func currentWindowSize() -> OpusWindowSize? {
+        if let set = self.windowSize {
+            return set
+        }
+        let stored = self.windowSizeUs.load(ordering: .acquiring)
+        guard stored != 0 else { return .twentyMs }
+        let interval = TimeInterval(stored) / microsecondsPerSecond
+        guard let window = OpusWindowSize(rawValue: interval) else {
+            self.logger.error("Bad opus window size calculation")
+            return nil
+        }
+        self.windowSize = window
+        return window
     }
 
     private func decode(_ item: AudioJitterItem, when: Date) {
@@ -698,16 +614,13 @@ class AudioHandler: TimeAlignable {
         guard packetsToGenerate <= self.config.maxPlcThreshold else {
             self.logger.warning("Discontinuity too large: \(packetsToGenerate)")
             self.playoutBuffer?.clear()
+            self.resetStretcher.store(true, ordering: .releasing)
             do {
                 try self.decoder.reset()
             } catch {
                 self.logger.warning("Couldn't reset decoder: \(error.localizedDescription)")
             }
-            do {
-                try self.jitterBuffer?.clear()
-            } catch {
-                self.logger.warning("Couldn't clear jitter buffer: \(error.localizedDescription)")
-            }
+            self.jitterBuffer?.clear()
             return
         }
 
@@ -720,13 +633,17 @@ class AudioHandler: TimeAlignable {
             return
         }
         let itemDate = self.jitterBuffer!.getPlayoutDate(item: item, offset: diff)
-        for packet in 0..<packetsToGenerate {
+        let frames = AVAudioFrameCount(window.rawValue * self.decoder.encodedFormat.sampleRate)
+        let packetsPerCall = max(1, UInt64(self.decoder.maxFrames / frames))
+        var generated: UInt64 = 0
+        while generated < packetsToGenerate {
+            // Conceal as many packets at once as the decoder allows.
+            let packets = min(packetsPerCall, packetsToGenerate - generated)
             do {
-                let frames = AVAudioFrameCount(window.rawValue * self.decoder.encodedFormat.sampleRate)
-                let plc = try self.decoder.plc(frames: frames)
-                lastUsedSequence += 1
+                let plc = try self.decoder.plc(frames: frames * AVAudioFrameCount(packets))
+                lastUsedSequence += packets
                 self.jitterBuffer!.updateLastSequenceRead(lastUsedSequence)
-                let backwards = packetsToGenerate - packet
+                let backwards = packetsToGenerate - generated
                 let backwardsTicks = (TimeInterval(backwards) * window.rawValue).ticks
                 let date = itemDate - backwardsTicks
                 var timestamp = AudioTimeStamp(mSampleTime: 0,
@@ -747,6 +664,7 @@ class AudioHandler: TimeAlignable {
             } catch {
                 self.logger.error("Failure generating PLC: \(error.localizedDescription)")
             }
+            generated += packets
         }
     }
 }
@@ -62,6 +62,28 @@ class Fetch: QFetchTrackHandlerObjC, QSubscribeTrackHandlerCallbacks {
         self.logger.debug("Status changed: \(status)")
     }
 
+    func objectReceived(_ objectHeaders: QObjectHeaders,
+                        data: Data,
+                        flatExtensions extensions: Data?,
+                        flatImmutableExtensions immutableExtensions: Data?,
+                        streamHeaderProperties: QStreamHeaderProperties?) {
+        self.objectReceived(objectHeaders,
+                            data: data,
+                            extensions: .init(bridged: extensions),
+                            immutableExtensions: .init(bridged: immutableExtensions),
+                            streamHeaderProperties: streamHeaderProperties)
+    }
+
+    func partialObjectReceived(_ objectHeaders: QObjectHeaders,
+                               data: Data,
+                               flatExtensions extensions: Data?,
+                               flatImmutableExtensions immutableExtensions: Data?) {
+        self.partialObjectReceived(objectHeaders,
+                                   data: data,
+                                   extensions: .init(bridged: extensions),
+                                   immutableExtensions: .init(bridged: immutableExtensions))
+    }
+
     func objectReceived(_ objectHeaders: QObjectHeaders,
                         data: Data,
                         extensions: HeaderExtensions?,
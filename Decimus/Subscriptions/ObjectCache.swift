@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Foundation
+import Synchronization
+
+/// Keeps the current group of recently received tracks, so that joining one of them mid group can start from its
+/// key frame without going back to the relay.
+///
+/// Only objects received while a track is held paused are kept, such as those of pre-subscribed speakers, as only
+/// paused tracks are later joined mid group. Copying every object of every playing track on the receive path would
+/// cost more than the joins it could save.
+///
+/// Entries are keyed by track, group and object, but held and evicted a group at a time: a group missing its first
+/// objects can't be decoded, so evicting objects singly would only waste what remains. Each track keeps only its
+/// latest group, and when over budget the least recently used track's group goes first.
+final class ObjectCache: Sendable {
+    /// A cached object, as received.
+    struct Object: Sendable {
+        let groupId: UInt64
+        let subgroupId: UInt64
+        let objectId: UInt64
+        let data: Data
+        let extensions: HeaderExtensions?
+
+        var headers: QObjectHeaders {
+            .init(groupId: self.groupId,
+                  subgroupId: self.subgroupId,
+                  objectId: self.objectId,
+                  payloadLength: UInt64(self.data.count),
+                  status: .available,
+                  priority: nil,
+                  ttl: nil)
+        }
+
+        fileprivate var bytes: Int {
+            self.data.count + (self.extensions?.flat.count ?? 0)
+        }
+    }
+
+    /// Cache effectiveness so far.
+    struct Stats: Equatable {
+        /// Lookups that could start a join.
+        var hits = 0
+        /// Lookups that couldn't.
+        var misses = 0
+        /// Groups evicted to stay within budget.
+        var evictions = 0
+        /// Bytes currently held.
+        var bytes = 0
+    }
+
+    private struct Group {
+        let groupId: UInt64
+        var objects: [UInt64: Object] = [:]
+        var bytes = 0
+        var lastUsed: UInt64
+    }
+
+    private struct State {
+        var groups: [FullTrackName: Group] = [:]
+        var stats = Stats()
+        var clock: UInt64 = 0
+    }
+
+    private let budget: Int
+    private let state = Mutex(State())
+    private let measurement: ObjectCacheMeasurement?
+
+    /// Effectiveness of the cache so far.
+    var stats: Stats {
+        self.state.withLock { $0.stats }
+    }
+
+    /// Create a cache.
+    /// - Parameter budget: Most bytes of objects to hold across all tracks.
+    /// - Parameter metricsSubmitter: Optionally, submitter for hit rate and eviction metrics.
+    init(budget: Int, metricsSubmitter: MetricsSubmitter?) {
+        self.budget = budget
+        if let metricsSubmitter {
+            let measurement = ObjectCacheMeasurement()
+            metricsSubmitter.register(measurement: measurement)
+            self.measurement = measurement
+        } else {
+            self.measurement = nil
+        }
+    }
+
+    /// Keep a received object.
+    ///
+    /// A group's first object replaces the track's previous group. Objects of a group whose start wasn't kept are
+    /// ignored, as they could never be used.
+    /// - Parameters:
+    ///   - fullTrackName: The object's track.
+    ///   - headers: The object's headers.
+    ///   - data: Payload, as received. Copied, as it may be a pooled receive buffer that must go back to its pool,
+    ///     and whose capacity the budget would otherwise not see.
+    ///   - extensions: Header extensions, as they will be handed to the handler.
+    func insert(_ fullTrackName: FullTrackName, headers: QObjectHeaders, data: Data, extensions: HeaderExtensions?) {
+        guard data.count + (extensions?.flat.count ?? 0) <= self.budget else { return }
+        let object = Object(groupId: headers.groupId,
+                            subgroupId: headers.subgroupId,
+                            objectId: headers.objectId,
+                            data: data.withUnsafeBytes { Data($0) },
+                            extensions: extensions)
+        var evicted = 0
+        var bytes = 0
+        self.state.withLock { state in
+            state.clock += 1
+            if headers.objectId == 0 {
+                if let previous = state.groups[fullTrackName] {
+                    guard headers.groupId > previous.groupId else { return }
+                    state.stats.bytes -= previous.bytes
+                }
+                state.groups[fullTrackName] = .init(groupId: headers.groupId, lastUsed: state.clock)
+            }
+            // Mutate groups in place, as copying one would copy all its objects.
+            guard state.groups[fullTrackName]?.groupId == headers.groupId,
+                  state.groups[fullTrackName]?.objects[headers.objectId] == nil else { return }
+
+            // Make room, oldest first, leaving this track's group until last.
+            while state.stats.bytes + object.bytes > self.budget {
+                let victim = state.groups
+                    .filter { $0.key != fullTrackName }
+                    .min { $0.value.lastUsed < $1.value.lastUsed }
+                guard let victim else { break }
+                state.groups[victim.key] = nil
+                state.stats.bytes -= victim.value.bytes
+                state.stats.evictions += 1
+                evicted += 1
+            }
+            if state.stats.bytes + object.bytes > self.budget {
+                // This group alone is over budget.
+                state.stats.bytes -= state.groups.removeValue(forKey: fullTrackName)!.bytes
+                state.stats.evictions += 1
+                evicted += 1
+            } else {
+                state.groups[fullTrackName]!.objects[headers.objectId] = object
+                state.groups[fullTrackName]!.bytes += object.bytes
+                state.groups[fullTrackName]!.lastUsed = state.clock
+                state.stats.bytes += object.bytes
+            }
+            bytes = state.stats.bytes
+        }
+        if evicted > 0 {
+            self.measurement?.evicted(count: evicted, bytes: bytes, timestamp: .now)
+        }
+    }
+
+    /// Get the objects needed to join a track mid group.
+    /// - Parameters:
+    ///   - fullTrackName: The track.
+    ///   - groupId: The group being joined.
+    ///   - objectId: The first object that will arrive live.
+    /// - Returns: The group's objects from its start up to but excluding the given object, or nil if not all are held.
+    func objects(_ fullTrackName: FullTrackName, groupId: UInt64, before objectId: UInt64) -> [Object]? {
+        var objects: [Object]?
+        self.state.withLock { state in
+            state.clock += 1
+            if let group = state.groups[fullTrackName],
+               group.groupId == groupId {
+                let run = (0..<objectId).compactMap { group.objects[$0] }
+                if run.count == Int(objectId) {
+                    objects = run
+                    state.groups[fullTrackName]!.lastUsed = state.clock
+                }
+            }
+            if objects != nil {
+                state.stats.hits += 1
+            } else {
+                state.stats.misses += 1
+            }
+        }
+        self.measurement?.lookup(hit: objects != nil, timestamp: .now)
+        return objects
+    }
+}
@@ -172,7 +172,7 @@ class OpusSubscription: Subscription, @unchecked Sendable {
         let unprotected: Data
         if let sframeContext {
             do {
-                unprotected = try sframeContext.mutex.withLock { try $0.unprotect(ciphertext: data) }
+                unprotected = try sframeContext.unprotect(data)
             } catch {
                 self.logger.error("Failed to unprotect: \(error.localizedDescription)")
                 return
@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Foundation
+import OrderedCollections
+
+/// Reassembles objects received in pieces into whole objects.
+///
+/// Each subgroup arrives on its own stream, and streams interleave, so one object is assembled per
+/// (group, subgroup) at a time. Pieces are appended into a buffer that is reused from object to object
+/// unless a consumer still holds the last object assembled in it.
+struct PartialObjectAssembler {
+    /// A whole object.
+    struct Assembled {
+        let data: Data
+        let extensions: HeaderExtensions?
+        let immutableExtensions: HeaderExtensions?
+    }
+
+    private struct Stream: Hashable {
+        let groupId: UInt64
+        let subgroupId: UInt64
+    }
+
+    private struct Assembly {
+        let objectId: UInt64
+        let expected: Int
+        var buffer: Data
+        let extensions: HeaderExtensions?
+        let immutableExtensions: HeaderExtensions?
+    }
+
+    /// Most objects assembled at once before the longest waiting is given up on.
+    private let maxStreams: Int
+    /// Objects in progress, longest waiting first.
+    private var assemblies: OrderedDictionary<Stream, Assembly> = [:]
+    private var spare = Data()
+
+    /// Number of objects that never completed: superseded on their stream, or given up on, before their last
+    /// piece arrived.
+    private(set) var incomplete = 0
+
+    /// - Parameter maxStreams: Most objects, one per stream, to assemble at once.
+    init(maxStreams: Int = 8) {
+        self.maxStreams = maxStreams
+    }
+
+    /// Add the next piece of an object.
+    /// - Parameters:
+    ///   - headers: The object's headers, whose payload length is the whole object's.
+    ///   - data: The piece.
+    ///   - extensions: Header extensions, taken from the object's first piece.
+    ///   - immutableExtensions: Immutable header extensions, taken from the object's first piece.
+    /// - Returns: The whole object, once this is its last piece.
+    mutating func append(_ headers: QObjectHeaders,
+                         data: Data,
+                         extensions: HeaderExtensions?,
+                         immutableExtensions: HeaderExtensions?) -> Assembled? {
+        let stream = Stream(groupId: headers.groupId, subgroupId: headers.subgroupId)
+        if let assembly = self.assemblies[stream],
+           assembly.objectId != headers.objectId {
+            // The stream moved on before the last object's last piece.
+            self.incomplete += 1
+            self.assemblies.removeValue(forKey: stream)
+            self.spare = assembly.buffer
+        }
+        if self.assemblies[stream] == nil {
+            if self.assemblies.count >= self.maxStreams {
+                self.incomplete += 1
+                self.spare = self.assemblies.removeFirst().value.buffer
+            }
+            var buffer = self.spare
+            self.spare = Data()
+            buffer.removeAll(keepingCapacity: true)
+            buffer.reserveCapacity(Int(headers.payloadLength))
+            self.assemblies[stream] = .init(objectId: headers.objectId,
+                                            expected: Int(headers.payloadLength),
+                                            buffer: buffer,
+                                            extensions: extensions,
+                                            immutableExtensions: immutableExtensions)
+        }
+        self.assemblies[stream]!.buffer.append(data)
+        guard self.assemblies[stream]!.buffer.count >= self.assemblies[stream]!.expected else { return nil }
+
+        let assembly = self.assemblies.removeValue(forKey: stream)!
+        self.spare = assembly.buffer
+        guard assembly.buffer.count == assembly.expected else {
+            // More than promised: malformed.
+            self.incomplete += 1
+            return nil
+        }
+        return .init(data: assembly.buffer,
+                     extensions: assembly.extensions,
+                     immutableExtensions: assembly.immutableExtensions)
+    }
+}
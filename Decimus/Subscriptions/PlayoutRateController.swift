@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+/// Chooses the rate to time stretch playout at.
+///
+/// Audio more than `start` late is played faster until it is back within `stop`, faster the later it is.
+/// When the audio buffered for playout runs low, it is played slower to stretch it until more arrives,
+/// rather than running out and concealing.
+struct PlayoutRateController {
+    /// Speed up applied as soon as catching up starts.
+    static let minimumSpeedUp = 0.05
+    /// Lateness past `stop` at which the fastest rate is used.
+    static let fullSpeedLateness: TimeInterval = 0.2
+
+    private let start: TimeInterval
+    private let stop: TimeInterval
+    private let minRate: Double
+    private let maxRate: Double
+    private(set) var catchingUp = false
+
+    /// - Parameter start: Lateness to start catching up at.
+    /// - Parameter stop: Lateness to stop catching up at. Less than `start`, so it doesn't flap.
+    /// - Parameter minRate: Slowest rate.
+    /// - Parameter maxRate: Fastest rate.
+    init(start: TimeInterval,
+         stop: TimeInterval,
+         minRate: Double = QTimeStretcher.minRate,
+         maxRate: Double = QTimeStretcher.maxRate) {
+        assert(stop < start)
+        self.start = start
+        self.stop = stop
+        self.minRate = minRate
+        self.maxRate = maxRate
+    }
+
+    /// The rate to play the next render at.
+    /// - Parameter late: How late the next audio to play is.
+    /// - Parameter available: Frames buffered for playout.
+    /// - Parameter frames: Frames to render.
+    /// - Parameter lookahead: Frames a stretch needs buffered beyond what it outputs.
+    /// - Returns: 1 to play normally, above 1 to catch up, below 1 to stretch.
+    mutating func rate(late: TimeInterval, available: UInt32, frames: UInt32, lookahead: UInt32) -> Double {
+        if self.catchingUp {
+            self.catchingUp = late > self.stop
+        } else {
+            self.catchingUp = late > self.start
+        }
+        if self.catchingUp {
+            let excess = (late - self.stop) / Self.fullSpeedLateness
+            let speedUp = Self.minimumSpeedUp + (self.maxRate - 1 - Self.minimumSpeedUp) * excess
+            return 1 + min(speedUp, self.maxRate - 1)
+        }
+        // Another render at normal speed would leave less than a stretch needs, so slow down while we can.
+        if available >= lookahead && available < frames + lookahead {
+            return self.minRate
+        }
+        return 1
+    }
+}
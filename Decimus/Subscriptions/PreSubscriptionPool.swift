@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import OrderedCollections
+
+/// Keeps the video of the likeliest next active speakers subscribed but paused, so that switching to one of them
+/// is a resume and a new group rather than a subscribe round trip and a wait for the next key frame.
+///
+/// Speakers are taken in the order a ``SpeakerPredictor`` ranks them, up to a count and while their combined
+/// costs fit the budgets. Paused tracks draw no media, so the bitrate budget bounds what the pool's tracks would
+/// draw if resumed together, and the memory budget what their decoding would then hold.
+@MainActor
+final class PreSubscriptionPool {
+    /// Limits on what the pool may hold.
+    struct Config: Codable {
+        /// Most speakers to keep pre-subscribed, or 0 to disable.
+        var count: Int
+        /// Most combined bitrate of pre-subscribed video, in kbps.
+        var bitrateKbps: UInt32
+        /// Most memory pre-subscribed video may use once playing, in megabytes.
+        var memoryMB: Int
+
+        init() {
+            self.count = 0
+            self.bitrateKbps = 6000
+            self.memoryMB = 64
+        }
+    }
+
+    private struct Cost {
+        var bitrate: UInt64 = 0
+        var memory: Int = 0
+
+        static func + (lhs: Cost, rhs: Cost) -> Cost {
+            .init(bitrate: lhs.bitrate + rhs.bitrate, memory: lhs.memory + rhs.memory)
+        }
+    }
+
+    /// Decoded frames a playing video track holds at once: the decode queue and its reference frames.
+    private static let framesHeld = 4
+
+    let predictor: SpeakerPredictor
+    private let controller: MoqCallController
+    private let videoSubscriptions: [ParticipantId: ManifestSubscription]
+    private let factory: SubscriptionFactory
+    private let participantId: ParticipantId
+    private let config: Config
+    private let costs: [ParticipantId: Cost]
+    private let logger = DecimusLogger(PreSubscriptionPool.self)
+
+    /// Speakers the pool wants, as of the last update.
+    private(set) var targets: OrderedSet<ParticipantId> = []
+    /// Sets currently held paused by the pool.
+    private(set) var members: Set<SourceIDType> = []
+
+    /// Create a pool.
+    /// - Parameters:
+    ///   - controller: Call controller managing subscriptions.
+    ///   - videoSubscriptions: Manifest of all available video subscriptions.
+    ///   - factory: Factory for subscription handler creation.
+    ///   - participantId: Local participant ID, never pre-subscribed.
+    ///   - predictor: Ranks the likeliest next speakers.
+    ///   - config: Limits on what the pool may hold.
+    ///   - codecFactory: Resolves profiles to their costs.
+    init(controller: MoqCallController,
+         videoSubscriptions: [ManifestSubscription],
+         factory: SubscriptionFactory,
+         participantId: ParticipantId,
+         predictor: SpeakerPredictor,
+         config: Config,
+         codecFactory: CodecFactory = CodecFactoryImpl()) {
+        self.controller = controller
+        self.videoSubscriptions = videoSubscriptions.reduce(into: [:]) { $0[$1.participantId] = $1 }
+        self.factory = factory
+        self.participantId = participantId
+        self.predictor = predictor
+        self.config = config
+        self.costs = videoSubscriptions.reduce(into: [:]) { costs, subscription in
+            costs[subscription.participantId] = subscription.profileSet.profiles.reduce(into: Cost()) { cost, profile in
+                let codec = codecFactory.makeCodecConfig(from: profile.qualityProfile, bitrateType: .average)
+                guard let video = codec as? VideoCodecConfig else { return }
+                cost.bitrate += UInt64(video.bitrate)
+                cost.memory += Int(video.width) * Int(video.height) * 3 / 2 * Self.framesHeld
+            }
+        }
+    }
+
+    /// True if the pool holds this set.
+    func isMember(_ set: SubscriptionSet) -> Bool {
+        self.members.contains(set.sourceId)
+    }
+
+    /// Re-rank the likeliest next speakers, pre-subscribing to new ones and unsubscribing from those no longer likely.
+    /// - Parameter rendered: Speakers currently rendered, which are never pooled.
+    func update(rendered: OrderedSet<ParticipantId>) {
+        guard self.config.count > 0 else { return }
+
+        // Take speakers in rank order while they fit.
+        let budget = Cost(bitrate: UInt64(self.config.bitrateKbps) * 1000,
+                          memory: self.config.memoryMB * 1024 * 1024)
+        var total = Cost()
+        var targets: OrderedSet<ParticipantId> = []
+        for speaker in self.predictor.ranked(when: .now) where targets.count < self.config.count {
+            guard speaker != self.participantId,
+                  !rendered.contains(speaker),
+                  let cost = self.costs[speaker] else { continue }
+            let next = total + cost
+            guard next.bitrate <= budget.bitrate,
+                  next.memory <= budget.memory else { continue }
+            total = next
+            targets.append(speaker)
+        }
+        self.targets = targets
+
+        // Let go of those no longer wanted.
+        for sourceId in self.members {
+            guard let set = self.controller.getSubscriptionSet(sourceId) else {
+                self.members.remove(sourceId)
+                continue
+            }
+            guard !targets.contains(set.participantId) else { continue }
+            self.members.remove(sourceId)
+            self.logger.debug("Unsubscribing from no longer likely: \(set.participantId)")
+            do {
+                try self.controller.unsubscribeToSet(sourceId)
+            } catch {
+                self.logger.error("Failed to unsubscribe from \(set.participantId): \(error.localizedDescription)")
+            }
+        }
+
+        // Subscribe to, or take over, the newly wanted.
+        for speaker in targets {
+            guard let manifest = self.videoSubscriptions[speaker],
+                  !self.members.contains(manifest.sourceID) else { continue }
+            if let existing = self.controller.getSubscriptionSet(manifest.sourceID) {
+                // Left paused is free to take; otherwise it's still in use, and may be adopted when released.
+                if existing.isPaused {
+                    _ = self.adopt(existing)
+                }
+                continue
+            }
+            self.logger.debug("Pre-subscribing to: \(speaker)")
+            do {
+                let set = try self.controller.subscribeToSet(details: manifest,
+                                                             factory: self.factory,
+                                                             subscribeType: .subscribe)
+                set.pause()
+                self.members.insert(set.sourceId)
+            } catch {
+                self.logger.error("Failed to pre-subscribe to \(speaker): \(error.localizedDescription)")
+            }
+        }
+    }
+
+    /// Take over a set that is no longer rendered, if its speaker is among the likeliest next.
+    /// - Parameter set: The set to take over.
+    /// - Returns: True if the pool now holds the set, paused.
+    func adopt(_ set: SubscriptionSet) -> Bool {
+        guard self.targets.contains(set.participantId) else { return false }
+        if !set.isPaused {
+            set.pause()
+        }
+        self.members.insert(set.sourceId)
+        self.logger.debug("Holding: \(set.participantId)")
+        return true
+    }
+
+    /// Hand a pooled set over to be rendered: resume it, and ask for a new group to start decoding from.
+    /// - Parameter set: The set to be rendered.
+    /// - Returns: True if the set was pooled and has been resumed.
+    func claim(_ set: SubscriptionSet) -> Bool {
+        guard self.members.remove(set.sourceId) != nil else { return false }
+        self.logger.debug("Switching to pre-subscribed: \(set.participantId)")
+        let now = Ticks.now
+        for handler in set.getHandlers().values {
+            (handler as? VideoSubscription)?.switchRequested(when: now, preSubscribed: true)
+        }
+        if set.isPaused {
+            set.resume()
+        }
+        for handler in set.getHandlers().values where handler.isNewGroupRequestSupported() {
+            handler.requestNewGroup()
+        }
+        return true
+    }
+}
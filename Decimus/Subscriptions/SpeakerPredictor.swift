@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Foundation
+import OrderedCollections
+import Synchronization
+
+/// Ranks participants by how likely they are to be the next active speaker.
+///
+/// Two signals feed the ranking, each decaying exponentially so that old behaviour is forgotten: how often and how
+/// highly a participant has featured in active speaker lists, which changes slowly, and how loud their audio has
+/// just been, which rises just before a participant is announced as speaking.
+final class SpeakerPredictor: Sendable {
+    private struct Score {
+        var history: Double = 0
+        var voice: Double = 0
+        var updated: Ticks
+
+        mutating func decay(to now: Ticks, historyHalfLife: TimeInterval, voiceHalfLife: TimeInterval) {
+            let elapsed = max(0, now.timeIntervalSince(self.updated))
+            self.history *= pow(0.5, elapsed / historyHalfLife)
+            self.voice *= pow(0.5, elapsed / voiceHalfLife)
+            self.updated = max(now, self.updated)
+        }
+    }
+
+    private let historyHalfLife: TimeInterval
+    private let voiceHalfLife: TimeInterval
+    private let scores = Mutex<[ParticipantId: Score]>([:])
+
+    /// Create a predictor.
+    /// - Parameter historyHalfLife: Seconds for the weight of having been an active speaker to halve.
+    /// - Parameter voiceHalfLife: Seconds for the weight of recent audio to halve.
+    init(historyHalfLife: TimeInterval = 60, voiceHalfLife: TimeInterval = 2) {
+        self.historyHalfLife = historyHalfLife
+        self.voiceHalfLife = voiceHalfLife
+    }
+
+    /// Record a new active speaker list.
+    /// - Parameter speakers: Active speakers, most active first.
+    /// - Parameter when: When the list was received.
+    func speakersChanged(_ speakers: OrderedSet<ParticipantId>, when: Ticks) {
+        self.scores.withLock { scores in
+            for (rank, speaker) in speakers.enumerated() {
+                scores[speaker, default: .init(updated: when)].decay(to: when,
+                                                                     historyHalfLife: self.historyHalfLife,
+                                                                     voiceHalfLife: self.voiceHalfLife)
+                scores[speaker]!.history += 1 / Double(rank + 1)
+            }
+        }
+    }
+
+    /// Record the level of a participant's audio.
+    /// - Parameter participant: The participant.
+    /// - Parameter level: Audio level in -dBov, as in the LOC audio level extension: 0 is loudest, 127 silent.
+    /// - Parameter when: When the audio was received.
+    func audioLevel(_ participant: ParticipantId, level: UInt8, when: Ticks) {
+        let loudness = Double(127 - min(level, 127)) / 127
+        self.scores.withLock { scores in
+            scores[participant, default: .init(updated: when)].decay(to: when,
+                                                                     historyHalfLife: self.historyHalfLife,
+                                                                     voiceHalfLife: self.voiceHalfLife)
+            // Smoothed rather than summed, as audio arrives at a rate unrelated to activity.
+            scores[participant]!.voice = max(scores[participant]!.voice, loudness)
+        }
+    }
+
+    /// Participants, most likely next speaker first.
+    /// - Parameter when: The time to rank at.
+    /// - Returns: Every participant seen, ranked.
+    func ranked(when: Ticks) -> [ParticipantId] {
+        var ranked: [(ParticipantId, Double)] = []
+        self.scores.withLock { scores in
+            ranked.reserveCapacity(scores.count)
+            for participant in scores.keys {
+                scores[participant]!.decay(to: when,
+                                           historyHalfLife: self.historyHalfLife,
+                                           voiceHalfLife: self.voiceHalfLife)
+                let score = scores[participant]!
+                // Someone speaking now is about to be announced, whatever their history.
+                ranked.append((participant, score.history + 2 * score.voice))
+            }
+        }
+        return ranked
+            .sorted { $0.1 != $1.1 ? $0.1 > $1.1 : $0.0 < $1.0 }
+            .map(\.0)
+    }
+}
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright (c) 2023 Cisco Systems
 // SPDX-License-Identifier: BSD-2-Clause
 
+import Synchronization
+
 extension QSubscribeTrackHandlerStatus: Equatable, CaseIterable {
     public static let allCases: [QSubscribeTrackHandlerStatus] = [
         .notAuthorized,
@@ -29,6 +31,7 @@ class Subscription: QSubscribeTrackHandlerObjC, QSubscribeTrackHandlerCallbacks,
     private let quicrMeasurement: TrackMeasurement?
     private let logger = DecimusLogger(Subscription.self)
     private let statusCallback: StatusCallback?
+    private let partialObjects = Mutex(PartialObjectAssembler())
 
     /// Create a new subscription for the given profile.
     /// - Parameters:
@@ -84,6 +87,30 @@ class Subscription: QSubscribeTrackHandlerObjC, QSubscribeTrackHandlerCallbacks,
         self.statusCallback?(status)
     }
 
+    /// Bridge entry point for a full object, with extensions in their flat encoding.
+    func objectReceived(_ objectHeaders: QObjectHeaders,
+                        data: Data,
+                        flatExtensions extensions: Data?,
+                        flatImmutableExtensions immutableExtensions: Data?,
+                        streamHeaderProperties: QStreamHeaderProperties?) {
+        self.objectReceived(objectHeaders,
+                            data: data,
+                            extensions: .init(bridged: extensions),
+                            immutableExtensions: .init(bridged: immutableExtensions),
+                            streamHeaderProperties: streamHeaderProperties)
+    }
+
+    /// Bridge entry point for a partial object, with extensions in their flat encoding.
+    func partialObjectReceived(_ objectHeaders: QObjectHeaders,
+                               data: Data,
+                               flatExtensions extensions: Data?,
+                               flatImmutableExtensions immutableExtensions: Data?) {
+        self.partialObjectReceived(objectHeaders,
+                                   data: data,
+                                   extensions: .init(bridged: extensions),
+                                   immutableExtensions: .init(bridged: immutableExtensions))
+    }
+
     /// Fires when a full object has been received.
     /// - Parameters:
     ///   - objectHeaders: The headers for this object.
@@ -96,16 +123,31 @@ class Subscription: QSubscribeTrackHandlerObjC, QSubscribeTrackHandlerCallbacks,
                         immutableExtensions: HeaderExtensions?,
                         streamHeaderProperties: QStreamHeaderProperties?) {}
 
-    /// Fires when a partial object has been received.
+    /// Fires when a piece of an object has been received.
+    /// The default implementation assembles the pieces, delivering each whole object to `objectReceived`.
     /// - Parameters:
     ///   - objectHeaders: The headers for this object.
-    ///   - data: Object payload bytes.
+    ///   - data: Payload bytes of this piece.
     ///   - extensions: Header extensions, if any.
     ///   - immutableExtensions: Immutable header extensions, if any.
     func partialObjectReceived(_ objectHeaders: QObjectHeaders,
                                data: Data,
                                extensions: HeaderExtensions?,
-                               immutableExtensions: HeaderExtensions?) {}
+                               immutableExtensions: HeaderExtensions?) {
+        var assembled: PartialObjectAssembler.Assembled?
+        self.partialObjects.withLock {
+            assembled = $0.append(objectHeaders,
+                                  data: data,
+                                  extensions: extensions,
+                                  immutableExtensions: immutableExtensions)
+        }
+        guard let assembled else { return }
+        self.objectReceived(objectHeaders,
+                            data: assembled.data,
+                            extensions: assembled.extensions,
+                            immutableExtensions: assembled.immutableExtensions,
+                            streamHeaderProperties: nil)
+    }
 
     /// Fires when the underlying handler produces metrics.
     /// The default implementation submits these metrics through the provided submitter, if any.
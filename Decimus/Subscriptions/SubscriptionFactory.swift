@@ -93,6 +93,10 @@ struct SubscriptionConfig: Codable {
     var quicrLogs: Bool
     /// Override picoquic pacing for priorities.
     var quicPriorityLimit: UInt8
+    /// Uplink budget in kbps to pace publications to ahead of the transport, or 0 to not pace.
+    var egressBitrateKbps: UInt32
+    /// Seconds a paced video object may wait before it is dropped as stale.
+    var egressStaleVideoAge: TimeInterval
     /// SFrame encryption of media settings.
     var sframeSettings: SFrameSettings
     /// True to publish keyframe on subscribe update.
@@ -107,6 +111,12 @@ struct SubscriptionConfig: Codable {
     var useAnnounce: Bool
     /// Max size of decoder queue before frames dropped.
     var decoderQueueSize: Int
+    /// Implementation of video decode.
+    var videoDecoder: VideoDecoderBackend
+    /// Megabytes of video received while paused to keep for joining mid group, or 0 to always go to the relay.
+    var objectCacheMB: Int
+    /// Video of likely next active speakers to keep subscribed but paused.
+    var preSubscription: PreSubscriptionPool.Config
 
     /// Create with default settings.
     init() {
@@ -136,6 +146,8 @@ struct SubscriptionConfig: Codable {
         pauseResume = false
         quicrLogs = false
         quicPriorityLimit = 0
+        self.egressBitrateKbps = 0
+        self.egressStaleVideoAge = 0.3
         self.sframeSettings = .init()
         stagger = true
         self.keyFrameOnSubscribeUpdate = false
@@ -144,9 +156,14 @@ struct SubscriptionConfig: Codable {
         self.joinConfig = .init(fetchUpperThreshold: 1, newGroupUpperThreshold: 4)
         self.useAnnounce = false
         self.decoderQueueSize = 2
+        self.videoDecoder = .videoToolbox
+        self.objectCacheMB = 32
+        self.preSubscription = .init()
     }
 }
 
+/// Creates subscription sets and their handlers from a manifest.
+/// Implementations must be safe to call concurrently, as sets are constructed in parallel when joining.
 protocol SubscriptionFactory {
     func create(subscription: ManifestSubscription,
                 codecFactory: CodecFactory,
@@ -171,15 +188,23 @@ class SubscriptionFactoryImpl: SubscriptionFactory {
     private let joinDate: Date
     private let controller: MoqCallController
     private let verbose: Bool
-    var activeSpeakerNotifier: ActiveSpeakerNotifierSubscription?
+    private let notifier = Mutex<ActiveSpeakerNotifierSubscription?>(nil)
     private let activeSpeakerStats: ActiveSpeakerStats?
     private let startingGroup: UInt64?
     private let manualActiveSpeaker: Bool
-    private let sframeContext: SFrameContext?
+    private let sframeKeyring: SFrameKeyring?
     private let calculateLatency: Bool
     private let wifiScanDetector: WiFiScanDetector?
     private let mediaInterop: Bool
     private let switchLatencyMeasurement: SwitchLatencyMeasurement?
+    private let objectCache: ObjectCache?
+    /// Ranks the likeliest next speakers, from the active speaker audio this factory's sets receive.
+    let speakerPredictor = SpeakerPredictor()
+
+    /// The active speaker notification subscription, once created.
+    var activeSpeakerNotifier: ActiveSpeakerNotifierSubscription? {
+        self.notifier.get()
+    }
 
     init(videoParticipants: VideoParticipants,
          metricsSubmitter: MetricsSubmitter?,
@@ -193,7 +218,7 @@ class SubscriptionFactoryImpl: SubscriptionFactory {
          verbose: Bool,
          startingGroup: UInt64?,
          manualActiveSpeaker: Bool,
-         sframeContext: SFrameContext?,
+         sframeKeyring: SFrameKeyring?,
          calculateLatency: Bool,
          mediaInterop: Bool,
          switchLatencyMeasurement: SwitchLatencyMeasurement? = nil) {
@@ -209,7 +234,7 @@ class SubscriptionFactoryImpl: SubscriptionFactory {
         self.verbose = verbose
         self.startingGroup = startingGroup
         self.manualActiveSpeaker = manualActiveSpeaker
-        self.sframeContext = sframeContext
+        self.sframeKeyring = sframeKeyring
         self.calculateLatency = calculateLatency
         if self.subscriptionConfig.videoJitterBuffer.spikePrediction {
             self.wifiScanDetector = MockWiFiScanDetector()
@@ -218,6 +243,13 @@ class SubscriptionFactoryImpl: SubscriptionFactory {
         }
         self.mediaInterop = mediaInterop
         self.switchLatencyMeasurement = switchLatencyMeasurement
+        // Shared by all video subscriptions, so that it outlives any one of them.
+        if subscriptionConfig.objectCacheMB > 0 {
+            self.objectCache = .init(budget: subscriptionConfig.objectCacheMB * 1024 * 1024,
+                                     metricsSubmitter: metricsSubmitter)
+        } else {
+            self.objectCache = nil
+        }
     }
 
     func create(subscription: ManifestSubscription,
@@ -246,6 +278,7 @@ class SubscriptionFactoryImpl: SubscriptionFactory {
                                                 ourParticipantId: self.participantId,
                                                 submitter: self.metricsSubmitter,
                                                 activeSpeakerStats: self.activeSpeakerStats,
+                                                speakerPredictor: self.speakerPredictor,
                                                 config: config)
         }
 
@@ -284,6 +317,7 @@ class SubscriptionFactoryImpl: SubscriptionFactory {
                                             activeSpeakerStats: self.activeSpeakerStats,
                                             cleanupTime: self.subscriptionConfig.cleanupTime,
                                             slidingWindowTime: self.subscriptionConfig.videoJitterBuffer.window,
+                                            scheduler: .playout,
                                             config: .init(calculateLatency: self.calculateLatency,
                                                           qualityHitThreshold: self.subscriptionConfig.qualityHitThreshold))
         }
@@ -337,13 +371,14 @@ class SubscriptionFactoryImpl: SubscriptionFactory {
         }
 
         if profile.qualityProfile == "playtime" {
-            self.activeSpeakerNotifier = try ActiveSpeakerNotifierSubscription(profile: profile,
-                                                                               endpointId: endpointId,
-                                                                               relayId: relayId,
-                                                                               submitter: self.metricsSubmitter,
-                                                                               publisherInitiated: publisherInitiated,
-                                                                               statusChanged: unregister)
-            return self.activeSpeakerNotifier!
+            let notifier = try ActiveSpeakerNotifierSubscription(profile: profile,
+                                                                 endpointId: endpointId,
+                                                                 relayId: relayId,
+                                                                 submitter: self.metricsSubmitter,
+                                                                 publisherInitiated: publisherInitiated,
+                                                                 statusChanged: unregister)
+            self.notifier.withLock { $0 = notifier }
+            return notifier
         }
 
         let config = codecFactory.makeCodecConfig(from: profile.qualityProfile, bitrateType: .average)
@@ -366,6 +401,7 @@ class SubscriptionFactoryImpl: SubscriptionFactory {
                                          jitterBufferConfig: subConfig.videoJitterBuffer,
                                          simulreceive: subConfig.simulreceive,
                                          variances: set.decodedVariances,
+                                         simulreceiveLayer: set.simulreceiveLayer(for: ftn),
                                          endpointId: endpointId,
                                          relayId: relayId,
                                          participantId: set.participantId,
@@ -377,10 +413,12 @@ class SubscriptionFactoryImpl: SubscriptionFactory {
                                          subscriptionConfig: .init(joinConfig: joinConfig,
                                                                    calculateLatency: self.calculateLatency,
                                                                    mediaInterop: self.mediaInterop,
-                                                                   decodeQueueSize: subConfig.decoderQueueSize),
-                                         sframeContext: self.sframeContext,
+                                                                   decodeQueueSize: subConfig.decoderQueueSize,
+                                                                   videoDecoder: subConfig.videoDecoder),
+                                         sframeContext: self.sframeKeyring?.makeReceiveContext(),
                                          wifiScanDetector: self.wifiScanDetector,
                                          switchLatencyMeasurement: self.switchLatencyMeasurement,
+                                         objectCache: self.objectCache,
                                          publisherInitiated: publisherInitiated,
                                          callback: { [weak set] details in
                                             guard let set = set else { return }
@@ -409,7 +447,7 @@ class SubscriptionFactoryImpl: SubscriptionFactory {
                                         useNewJitterBuffer: self.subscriptionConfig.useNewJitterBuffer,
                                         cleanupTime: self.subscriptionConfig.cleanupTime,
                                         activeSpeakerStats: self.manualActiveSpeaker ? self.activeSpeakerStats : nil,
-                                        sframeContext: self.sframeContext,
+                                        sframeContext: self.sframeKeyring?.makeReceiveContext(),
                                         maxPlcThreshold: self.subscriptionConfig.audioPlcLimit,
                                         playoutBufferTime: self.subscriptionConfig.playoutBufferTime,
                                         slidingWindowTime: self.subscriptionConfig.videoJitterBuffer.window,
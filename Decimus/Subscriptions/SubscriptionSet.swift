@@ -72,6 +72,18 @@ class ObservableSubscriptionSet: SubscriptionSet, @unchecked Sendable {
         self.handlers.get()
     }
 
+    /// Get the handler for one track, without copying all of them.
+    /// - Parameter ftn: The full track name to lookup on.
+    /// - Returns: The handler, if any.
+    func getHandler(_ ftn: FullTrackName) -> Subscription? {
+        self.handlers.withLock { $0[ftn] }
+    }
+
+    /// True if this set has any handlers.
+    var hasHandlers: Bool {
+        self.handlers.withLock { !$0.isEmpty }
+    }
+
     func removeHandler(_ ftn: FullTrackName) -> Subscription? {
         let removed = self.handlers.withLock { $0.removeValue(forKey: ftn) }
         if removed != nil {
@@ -86,7 +98,7 @@ class ObservableSubscriptionSet: SubscriptionSet, @unchecked Sendable {
             guard handlers[ftn] == nil else {
                 throw SubscriptionSetError.handlerExists
             }
-            handlers[.init(handler.getFullTrackName())] = handler
+            handlers[ftn] = handler
         }
         self.dispatchAdd(for: ftn)
     }
@@ -11,6 +11,8 @@ enum ActivationType: String {
     case reactivation = "reactivation"
     /// Existing subscription, existing handler.
     case existing = "existing"
+    /// Subscription held paused in anticipation, resumed for this switch.
+    case preSubscribed = "pre_subscribed"
 }
 
 /// Join strategy chosen for mid-stream join.
@@ -23,6 +25,8 @@ enum JoinStrategy: String {
     case wait = "wait"
     /// Started on an IDR.
     case idr = "idr"
+    /// Replayed the group so far from the client's object cache.
+    case cache = "cache"
 }
 
 /// Accumulates timestamps through the join flow for a single switch event.
@@ -31,6 +35,8 @@ struct SwitchContext {
     let activationType: ActivationType
     let activationTime: Ticks
     let groupDepth: UInt64
+    /// When the switch was asked for, by subscribing or resuming, if known.
+    var requestTime: Ticks?
 
     var joinStrategy: JoinStrategy?
     var joinDecisionTime: Ticks?
@@ -59,7 +59,7 @@ final class TextSubscriptions: Sendable {
         let unprotected: Data
         if let sframeContext = self.sframeContext {
             do {
-                unprotected = try sframeContext.mutex.withLock { try $0.unprotect(ciphertext: data) }
+                unprotected = try sframeContext.unprotect(data)
             } catch {
                 self.logger.error("Failed to unprotect text message: \(error.localizedDescription)")
                 return
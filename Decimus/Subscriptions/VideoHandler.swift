@@ -39,7 +39,7 @@ struct ObjectReceived {
 typealias ObjectReceivedCallback = (_ details: ObjectReceived) -> Void
 
 /// Handles decoding, jitter, and rendering of a video stream.
-final class VideoHandler: TimeAlignable, CustomStringConvertible, Sendable { // swiftlint:disable:this type_body_length
+final class VideoHandler: TimeAlignable, CustomStringConvertible, DequeueSchedulable, Sendable { // swiftlint:disable:this type_body_length
     /// The current configuration in use.
     let config: VideoCodecConfig
     /// The full track name identifiying this stream.
@@ -50,7 +50,7 @@ final class VideoHandler: TimeAlignable, CustomStringConvertible, Sendable { //
     let timeDiff = TimeDiff()
 
     private let logger: DecimusLogger
-    private let decoder: VTDecoder?
+    private let decoder: VideoDecoder?
     private let participants: VideoParticipants
     private let measurement: VideoHandlerMeasurement?
     private let namegate = SequentialObjectBlockingNameGate()
@@ -76,7 +76,8 @@ final class VideoHandler: TimeAlignable, CustomStringConvertible, Sendable { //
     private nonisolated(unsafe) var lastGroup: UInt64?
     private nonisolated(unsafe) var lastObject: UInt64?
     private nonisolated(unsafe) var decodeTask: Task<(), Never>?
-    private nonisolated(unsafe) var dequeueTask: Task<(), Never>?
+    private let dequeueCoordinator: VideoDequeueCoordinator
+    private nonisolated(unsafe) var dequeueRegistered = false
     private nonisolated(unsafe) var dequeueBehaviour: VideoDequeuer?
     private nonisolated(unsafe) var lastFps: UInt16?
     private nonisolated(unsafe) var lastDimensions: CMVideoDimensions?
@@ -85,6 +86,7 @@ final class VideoHandler: TimeAlignable, CustomStringConvertible, Sendable { //
     nonisolated(unsafe) var description = "VideoHandler"
 
     private let variances: VarianceCalculator
+    private let simulreceiveLayer: SimulreceiveLayer?
 
     private struct Callbacks {
         var callbacks: [Int: ObjectReceivedCallback] = [:]
@@ -122,6 +124,8 @@ final class VideoHandler: TimeAlignable, CustomStringConvertible, Sendable { //
         let mediaInterop: Bool
         /// Max number of decoded frames to buffer.
         let decodeBufferSize: Int
+        /// Implementation of decode.
+        let videoDecoder: VideoDecoderBackend
     }
 
     /// Create a new video handler.
@@ -145,13 +149,15 @@ final class VideoHandler: TimeAlignable, CustomStringConvertible, Sendable { //
          jitterBufferConfig: JitterBuffer.Config,
          simulreceive: SimulreceiveMode,
          variances: VarianceCalculator,
+         simulreceiveLayer: SimulreceiveLayer? = nil,
          participantId: ParticipantId,
          subscribeDate: Date,
          joinDate: Date,
          activeSpeakerStats: ActiveSpeakerStats?,
          handlerConfig: Config,
          wifiDetector: WiFiScanDetector?,
-         switchLatencyMeasurement: SwitchLatencyMeasurement? = nil) throws {
+         switchLatencyMeasurement: SwitchLatencyMeasurement? = nil,
+         dequeueCoordinator: VideoDequeueCoordinator = .shared) throws {
         if simulreceive != .none && jitterBufferConfig.mode == .layer {
             throw "Simulreceive and layer are not compatible"
         }
@@ -172,17 +178,20 @@ final class VideoHandler: TimeAlignable, CustomStringConvertible, Sendable { //
         self.simulreceive = simulreceive
         self.metricsSubmitter = metricsSubmitter
         self.variances = variances
+        self.simulreceiveLayer = simulreceiveLayer
         self.participantId = participantId
         self.activeSpeakerStats = activeSpeakerStats
         self.handlerConfig = handlerConfig
         self.detector = wifiDetector
         self.switchLatencyMeasurement = switchLatencyMeasurement
+        self.dequeueCoordinator = dequeueCoordinator
         self.targetJitterDepth = self.jitterBufferConfig.minDepth
         self.jitterCalculation = .init(identifier: "\(self.fullTrackName)",
                                        submitter: metricsSubmitter)
         if jitterBufferConfig.mode != .layer {
             // Create the decoder.
-            self.decoder = .init(config: self.config, decodeBufferSize: handlerConfig.decodeBufferSize)
+            self.decoder = handlerConfig.videoDecoder.makeDecoder(config: self.config,
+                                                                  decodeBufferSize: handlerConfig.decodeBufferSize)
         } else {
             self.decoder = nil
         }
@@ -229,7 +238,9 @@ final class VideoHandler: TimeAlignable, CustomStringConvertible, Sendable { //
 
     deinit {
         self.decodeTask?.cancel()
-        self.dequeueTask?.cancel()
+        if self.dequeueRegistered {
+            self.dequeueCoordinator.unregister(self.dequeueIdentifier)
+        }
         if let spikeToken = self.spikeToken {
             self.detector!.removeNotifyCallback(token: spikeToken)
         }
@@ -405,8 +416,8 @@ final class VideoHandler: TimeAlignable, CustomStringConvertible, Sendable { //
             if let publishTimestampDate = try? extensions.getHeader(.publishTimestamp),
                case .publishTimestamp(let extracted) = publishTimestampDate {
                 publishTimestamp = extracted
-                if self.granularMetrics,
-                   let measurement = self.measurement {
+                // Aggregated, so cheap enough to record without granular metrics.
+                if let measurement = self.measurement {
                     let now = when.hostDate
                     let traversal = now.timeIntervalSince(extracted)
                     measurement.moqTraversalTime(time: traversal, metricsTimestamp: now)
@@ -471,15 +482,13 @@ final class VideoHandler: TimeAlignable, CustomStringConvertible, Sendable { //
                self.jitterBufferConfig.mode != .none {
                 // Create the video jitter buffer.
                 jitterBuffer = try self.createJitterBuffer(frame: frame)
-                assert(self.dequeueTask == nil)
-                createDequeueTask()
+                assert(!self.dequeueRegistered)
+                self.dequeueRegistered = true
+                self.dequeueCoordinator.register(self)
             }
         }
 
-        // Do we need to copy the frame data?
-        let copy = self.jitterBuffer != nil || self.jitterBufferConfig.mode == .layer
-        let frame: DecimusVideoFrame = copy ? try .init(copy: frame) : frame
-
+        // No copy is needed to hold the frame: its block buffers retain the pooled received payload.
         // Either write the frame to the jitter buffer or otherwise decode it.
         if let jitterBuffer = self.jitterBuffer {
             let item = try DecimusVideoFrameJitterItem(frame)
@@ -489,6 +498,8 @@ final class VideoHandler: TimeAlignable, CustomStringConvertible, Sendable { //
                 self.logger.warning("Didn't enqueue as queue was full")
             } catch JitterBufferError.old {
                 self.logger.warning("Didn't enqueue as frame was older than last read")
+            } catch JitterBufferError.duplicate {
+                self.logger.warning("Didn't enqueue as frame was already enqueued")
             }
         } else {
             try decode(sample: frame, from: details.when.hostDate)
@@ -631,121 +642,71 @@ final class VideoHandler: TimeAlignable, CustomStringConvertible, Sendable { //
                                                 kd: 0.001)
         }
 
-        // Create the video jitter buffer.
-        // swiftlint:disable force_cast
-        let handlers = CMBufferQueue.Handlers { builder in
-            builder.compare {
-                let first = $0 as! DecimusVideoFrameJitterItem
-                let second = $1 as! DecimusVideoFrameJitterItem
-                let seq1 = first.sequenceNumber
-                let seq2 = second.sequenceNumber
-                if seq1 < seq2 {
-                    return .compareLessThan
-                } else if seq1 > seq2 {
-                    return .compareGreaterThan
-                } else if seq1 == seq2 {
-                    return .compareEqualTo
-                }
-                assert(false)
-                return .compareLessThan
-            }
-            builder.getDecodeTimeStamp {
-                ($0 as! DecimusVideoFrameJitterItem).frame.samples.first?.decodeTimeStamp ?? .invalid
-            }
-            builder.getDuration {
-                ($0 as! DecimusVideoFrameJitterItem).frame.samples.first?.duration ?? .invalid
-            }
-            builder.getPresentationTimeStamp {
-                ($0 as! DecimusVideoFrameJitterItem).frame.samples.first?.presentationTimeStamp ?? .invalid
-            }
-            builder.getSize {
-                ($0 as! DecimusVideoFrameJitterItem).frame.samples.reduce(0) { $0 + $1.totalSampleSize }
-            }
-            builder.isDataReady {
-                ($0 as! DecimusVideoFrameJitterItem).frame.samples.allSatisfy { $0.dataReadiness == .ready }
-            }
-        }
-        // swiftlint:enable force_cast
         self.duration = duration
         return try .init(identifier: "\(self.fullTrackName)",
                          metricsSubmitter: self.metricsSubmitter,
                          minDepth: self.jitterBufferConfig.minDepth,
                          capacity: Int(floor(self.jitterBufferConfig.capacity / duration)),
-                         handlers: handlers,
                          playingFromStart: false)
     }
 
-    private func createDequeueTask() {
-        // Start the frame dequeue task.
-        self.dequeueTask = .init(priority: .high) { [weak self] in
-            while !Task.isCancelled {
-                let waitTime: TimeInterval
-                let now: Ticks
-                if let self = self {
-                    now = .now
-
-                    // Wait until we expect to have a frame available.
-                    let jitterBuffer = self.jitterBuffer! // Jitter buffer must exist at this point.
-                    if let pid = self.dequeueBehaviour as? PIDDequeuer {
-                        pid.currentDepth = jitterBuffer.getDepth()
-                        waitTime = self.dequeueBehaviour!.calculateWaitTime(from: now.hostDate)
-                    } else {
-                        guard let duration = self.duration else {
-                            self.logger.error("Missing duration")
-                            return
-                        }
-                        waitTime = calculateWaitTime(from: now) ?? duration
-                    }
-                } else {
-                    return
-                }
+    // MARK: DequeueSchedulable implementation.
 
-                // Sleep without holding a strong reference.
-                if waitTime > 0 {
-                    try? await Task.sleep(for: .seconds(waitTime),
-                                          tolerance: .seconds(waitTime / 2),
-                                          clock: .continuous)
-                }
+    var dequeueIdentifier: String {
+        "\(self.fullTrackName) \(ObjectIdentifier(self))"
+    }
 
-                // Regain our strong reference after sleeping.
-                if let self = self {
-                    // Attempt to dequeue a frame.
-                    if let item: DecimusVideoFrameJitterItem = self.jitterBuffer!.read(from: now.hostDate) {
-                        if self.granularMetrics,
-                           let measurement = self.measurement,
-                           let time = self.calculateWaitTime(item: item, from: now) {
-                            measurement.frameDelay(delay: -time, metricsTimestamp: now.hostDate)
-                        }
-
-                        // Because of ordering and FETCH, it's possible the sample
-                        // does not have a format set. At the point of dequeue, we should
-                        // apply the matching group's format if we have it, so that this sample
-                        // does has a format.
-                        let okay = item.frame.samples.allSatisfy { $0.formatDescription != nil }
-                        let frame: DecimusVideoFrame
-                        if okay {
-                            frame = item.frame
-                        } else {
-                            guard let format = self.currentFormats.withLock({ $0[item.frame.groupId] }) else {
-                                self.logger.warning("[\(item.frame.groupId):\(item.frame.objectId)] Dropping frame with no format")
-                                continue
-                            }
-                            do {
-                                frame = try self.regen(item.frame, format: format)
-                            } catch {
-                                self.logger.error("Failed to regen sample: \(error.localizedDescription)")
-                                return
-                            }
-                        }
-                        do {
-                            try self.decode(sample: frame, from: now.hostDate)
-                        } catch {
-                            self.logger.error("[\(frame.groupId):\(frame.objectId)] Failed to write to decoder: \(error.localizedDescription)")
-                        }
-                    }
-                }
+    func calculateNextDeadline(from now: Ticks) -> Ticks? {
+        // Wait until we expect to have a frame available.
+        let jitterBuffer = self.jitterBuffer! // Jitter buffer must exist at this point.
+        let waitTime: TimeInterval
+        if let pid = self.dequeueBehaviour as? PIDDequeuer {
+            pid.currentDepth = jitterBuffer.getDepth()
+            waitTime = pid.calculateWaitTime(from: now.hostDate)
+        } else {
+            guard let duration = self.duration else {
+                self.logger.error("Missing duration")
+                return nil
             }
+            waitTime = self.calculateWaitTime(from: now) ?? duration
+        }
+        return now.addingTimeInterval(waitTime)
+    }
+
+    func processFrame(at now: Ticks) -> Bool {
+        guard let item: DecimusVideoFrameJitterItem = self.jitterBuffer!.read(from: now.hostDate) else { return true }
+        if self.granularMetrics,
+           let measurement = self.measurement,
+           let time = self.calculateWaitTime(item: item, from: now) {
+            measurement.frameDelay(delay: -time, metricsTimestamp: now.hostDate)
+        }
+
+        // Because of ordering and FETCH, it's possible the sample
+        // does not have a format set. At the point of dequeue, we should
+        // apply the matching group's format if we have it, so that this sample
+        // does has a format.
+        let okay = item.frame.samples.allSatisfy { $0.formatDescription != nil }
+        let frame: DecimusVideoFrame
+        if okay {
+            frame = item.frame
+        } else {
+            guard let format = self.currentFormats.withLock({ $0[item.frame.groupId] }) else {
+                self.logger.warning("[\(item.frame.groupId):\(item.frame.objectId)] Dropping frame with no format")
+                return true
+            }
+            do {
+                frame = try self.regen(item.frame, format: format)
+            } catch {
+                self.logger.error("Failed to regen sample: \(error.localizedDescription)")
+                return false
+            }
+        }
+        do {
+            try self.decode(sample: frame, from: now.hostDate)
+        } catch {
+            self.logger.error("[\(frame.groupId):\(frame.objectId)] Failed to write to decoder: \(error.localizedDescription)")
         }
+        return true
     }
 
     /// Regenerate the frame to have the given format.
@@ -1029,6 +990,7 @@ final class VideoHandler: TimeAlignable, CustomStringConvertible, Sendable { //
             self.lastDecodedImage.withLock { $0 = .init(image: sample,
                                                         fps: UInt(self.config.fps),
                                                         discontinous: sample.discontinous) }
+            self.simulreceiveLayer?.decoded(sample)
         }
 
         // Consume pending switch context and record decode time.
@@ -1121,6 +1083,7 @@ class DecimusVideoFrameJitterItem: JitterBuffer.JitterItem {
     let frame: DecimusVideoFrame
     let sequenceNumber: UInt64
     let timestamp: CMTime
+    let duration: CMTime
 
     init(_ frame: DecimusVideoFrame) throws {
         guard let seq = frame.sequenceNumber,
@@ -1130,5 +1093,6 @@ class DecimusVideoFrameJitterItem: JitterBuffer.JitterItem {
         self.frame = frame
         self.sequenceNumber = seq
         self.timestamp = time
+        self.duration = frame.samples.first?.duration ?? .invalid
     }
 }
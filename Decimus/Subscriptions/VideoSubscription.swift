@@ -24,6 +24,8 @@ class VideoSubscription: Subscription, @unchecked Sendable {
         let mediaInterop: Bool
         /// Max decode queue size.
         let decodeQueueSize: Int
+        /// Implementation of decode.
+        let videoDecoder: VideoDecoderBackend
     }
 
     private let fullTrackName: FullTrackName
@@ -35,6 +37,7 @@ class VideoSubscription: Subscription, @unchecked Sendable {
     private let jitterBufferConfig: JitterBuffer.Config
     private let simulreceive: SimulreceiveMode
     private let variances: VarianceCalculator
+    private let simulreceiveLayer: SimulreceiveLayer?
     private let callback: ObjectReceivedCallback
     private var token: Int = 0
     private let logger: DecimusLogger
@@ -61,6 +64,9 @@ class VideoSubscription: Subscription, @unchecked Sendable {
     private let sframeContext: SFrameContext?
     private let wifiScanDetector: WiFiScanDetector?
     private let switchLatencyMeasurement: SwitchLatencyMeasurement?
+    private let objectCache: ObjectCache?
+    /// When the next switch to this subscription was asked for, and whether it was held paused in anticipation.
+    private let switchRequest: Mutex<(when: Ticks, preSubscribed: Bool)?>
     private let paused = Atomic(false)
     private var lastSeenGroup: UInt64?
     private var maxGroupSeen: UInt64?
@@ -172,6 +178,7 @@ class VideoSubscription: Subscription, @unchecked Sendable {
          jitterBufferConfig: JitterBuffer.Config,
          simulreceive: SimulreceiveMode,
          variances: VarianceCalculator,
+         simulreceiveLayer: SimulreceiveLayer? = nil,
          endpointId: String,
          relayId: String,
          participantId: ParticipantId,
@@ -184,6 +191,7 @@ class VideoSubscription: Subscription, @unchecked Sendable {
          sframeContext: SFrameContext?,
          wifiScanDetector: WiFiScanDetector?,
          switchLatencyMeasurement: SwitchLatencyMeasurement? = nil,
+         objectCache: ObjectCache? = nil,
          publisherInitiated: Bool,
          callback: @escaping ObjectReceivedCallback,
          statusChanged: @escaping StatusCallback) throws {
@@ -196,6 +204,7 @@ class VideoSubscription: Subscription, @unchecked Sendable {
         self.jitterBufferConfig = jitterBufferConfig
         self.simulreceive = simulreceive
         self.variances = variances
+        self.simulreceiveLayer = simulreceiveLayer
         self.callback = callback
         self.participantId = participantId
         self.creationDate = .now
@@ -209,10 +218,14 @@ class VideoSubscription: Subscription, @unchecked Sendable {
         self.subscriptionConfig = subscriptionConfig
         self.wifiScanDetector = wifiScanDetector
         self.switchLatencyMeasurement = switchLatencyMeasurement
+        self.objectCache = objectCache
+        // Subscribing is the first request.
+        self.switchRequest = .init((.now, false))
         self.logger = .init(VideoSubscription.self, prefix: "\(self.fullTrackName)")
         let handlerConfig = VideoHandler.Config(calculateLatency: self.subscriptionConfig.calculateLatency,
                                                 mediaInterop: self.subscriptionConfig.mediaInterop,
-                                                decodeBufferSize: self.subscriptionConfig.decodeQueueSize)
+                                                decodeBufferSize: self.subscriptionConfig.decodeQueueSize,
+                                                videoDecoder: self.subscriptionConfig.videoDecoder)
         let handler = try VideoHandler(fullTrackName: fullTrackName,
                                        config: config,
                                        participants: participants,
@@ -222,6 +235,7 @@ class VideoSubscription: Subscription, @unchecked Sendable {
                                        jitterBufferConfig: jitterBufferConfig,
                                        simulreceive: simulreceive,
                                        variances: variances,
+                                       simulreceiveLayer: simulreceiveLayer,
                                        participantId: participantId,
                                        subscribeDate: self.creationDate,
                                        joinDate: joinDate,
@@ -260,11 +274,20 @@ class VideoSubscription: Subscription, @unchecked Sendable {
         self.logger.info("Paused")
     }
 
+    /// Note that a switch to this subscription has just been asked for, for the switch's latency measurement.
+    /// - Parameter when: When the switch was asked for.
+    /// - Parameter preSubscribed: True if the subscription was held paused in anticipation of the switch.
+    func switchRequested(when: Ticks, preSubscribed: Bool) {
+        self.switchRequest.withLock { $0 = (when, preSubscribed) }
+    }
+
     override func resume() {
         let exchange = self.paused.compareExchange(expected: true,
                                                    desired: false,
                                                    ordering: .acquiringAndReleasing)
         assert(exchange.exchanged, "Resume called when not paused")
+        // Resuming is a request, unless one was already noted.
+        self.switchRequest.withLock { $0 = $0 ?? (.now, false) }
         super.resume()
         self.logger.info("Resumed")
     }
@@ -310,6 +333,11 @@ class VideoSubscription: Subscription, @unchecked Sendable {
             return .drop
         }
 
+        // Recently received, so the group so far may be to hand.
+        if let result = self.joinFromCache(objectHeaders: objectHeaders) {
+            return result
+        }
+
         guard objectHeaders.objectId < self.joinConfig.fetchUpperThreshold else {
             // Check new group supported.
             guard self.isNewGroupRequestSupported() else {
@@ -355,13 +383,59 @@ class VideoSubscription: Subscription, @unchecked Sendable {
         }
     }
 
+    /// Join from the object cache, replaying the group so far to the handler.
+    /// - Returns: What to do with this object, or nil if the cache can't supply the group.
+    private func joinFromCache(objectHeaders: QObjectHeaders) -> Result? {
+        guard let cached = self.objectCache?.objects(self.fullTrackName,
+                                                     groupId: objectHeaders.groupId,
+                                                     before: objectHeaders.objectId),
+              let handler = self.handler.get() else {
+            return nil
+        }
+        let decision = Ticks.now
+        // Cached as received.
+        let payloads: [Data]
+        do {
+            payloads = try self.sframeContext?.unprotect(cached.map(\.data)) ?? cached.map(\.data)
+        } catch {
+            self.logger.error("Unprotect failure joining from cache: \(error.localizedDescription)")
+            return nil
+        }
+        self.logger.debug("Joining \(objectHeaders.groupId):\(objectHeaders.objectId) from cache")
+        handler.pause()
+        for (object, payload) in zip(cached, payloads) {
+            handler.objectReceived(object.headers,
+                                   data: payload,
+                                   extensions: object.extensions,
+                                   when: .now,
+                                   cached: true,
+                                   drop: false)
+        }
+        if self.getCurrentState() != .running {
+            try! self.stateMachine.transition(to: .running)
+        }
+        self.lastSeenGroup = objectHeaders.groupId
+        let ctx = self.switchContext.withLock { ctx in
+            ctx?.joinStrategy = .cache
+            ctx?.joinDecisionTime = decision
+            ctx?.joinCompleteTime = .now
+            ctx?.fetchObjectCount = UInt64(cached.count)
+            let captured = ctx
+            ctx = nil
+            return captured
+        }
+        return .normal(true, switchContext: ctx)
+    }
+
     private func determineState(objectHeaders: QObjectHeaders,
                                 activation: ActivationType,
                                 when: Ticks) -> Result {
         func makeSwitchContext() -> SwitchContext {
-            .init(activationType: activation,
-                  activationTime: when,
-                  groupDepth: objectHeaders.objectId)
+            let request = self.switchRequest.consume()
+            return .init(activationType: request?.preSubscribed == true ? .preSubscribed : activation,
+                         activationTime: when,
+                         groupDepth: objectHeaders.objectId,
+                         requestTime: request?.when)
         }
 
         var getAction: Result { switch self.getCurrentState() {
@@ -438,8 +512,13 @@ class VideoSubscription: Subscription, @unchecked Sendable {
                                  extensions: HeaderExtensions?,
                                  immutableExtensions: HeaderExtensions?,
                                  streamHeaderProperties: QStreamHeaderProperties?) {
-        // If we're paused, drop this.
+        // If we're paused, drop this, but keep it in case we resume mid group, as a pre-subscribed set does.
+        // Kept as received, to only be unprotected if it's joined from.
         guard !self.paused.load(ordering: .acquiring) else {
+            self.objectCache?.insert(self.fullTrackName,
+                                     headers: objectHeaders,
+                                     data: data,
+                                     extensions: immutableExtensions ?? extensions)
             if self.verbose {
                 self.logger.debug("Dropping object while in app paused state: \(objectHeaders.groupId) \(objectHeaders.objectId)")
             }
@@ -491,18 +570,7 @@ class VideoSubscription: Subscription, @unchecked Sendable {
             self.maxGroupSeen = objectHeaders.groupId
         }
 
-        // Unprotect.
-        let unprotected: Data
-        if let sframeContext {
-            do {
-                unprotected = try sframeContext.mutex.withLock { try $0.unprotect(ciphertext: data) }
-            } catch {
-                self.logger.error("Unprotect failure: \(error.localizedDescription)")
-                return
-            }
-        } else {
-            unprotected = data
-        }
+        guard let unprotected = self.unprotect(data) else { return }
 
         // Check for action & state change.
         let effectiveExtensions = immutableExtensions ?? extensions
@@ -539,6 +607,16 @@ class VideoSubscription: Subscription, @unchecked Sendable {
         }
     }
 
+    private func unprotect(_ data: Data) -> Data? {
+        guard let sframeContext else { return data }
+        do {
+            return try sframeContext.unprotect(data)
+        } catch {
+            self.logger.error("Unprotect failure: \(error.localizedDescription)")
+            return nil
+        }
+    }
+
     private func getCreateHandler() throws -> (handler: VideoHandler, activation: ActivationType) {
         try self.handler.withLock { lockedHandler in
             if let existing = lockedHandler {
@@ -546,7 +624,8 @@ class VideoSubscription: Subscription, @unchecked Sendable {
             }
             let config = VideoHandler.Config(calculateLatency: self.subscriptionConfig.calculateLatency,
                                              mediaInterop: self.subscriptionConfig.mediaInterop,
-                                             decodeBufferSize: self.subscriptionConfig.decodeQueueSize)
+                                             decodeBufferSize: self.subscriptionConfig.decodeQueueSize,
+                                             videoDecoder: self.subscriptionConfig.videoDecoder)
             let newHandler = try VideoHandler(fullTrackName: self.fullTrackName,
                                               config: self.config,
                                               participants: self.participants,
@@ -556,6 +635,7 @@ class VideoSubscription: Subscription, @unchecked Sendable {
                                               jitterBufferConfig: self.jitterBufferConfig,
                                               simulreceive: self.simulreceive,
                                               variances: self.variances,
+                                              simulreceiveLayer: self.simulreceiveLayer,
                                               participantId: self.participantId,
                                               subscribeDate: self.creationDate,
                                               joinDate: self.joinDate,
@@ -633,17 +713,7 @@ class VideoSubscription: Subscription, @unchecked Sendable {
         }
 
         // Unprotect.
-        let unprotected: Data
-        if let sframeContext {
-            do {
-                unprotected = try sframeContext.mutex.withLock { try $0.unprotect(ciphertext: data) }
-            } catch {
-                self.logger.error("Unprotect failure: \(error.localizedDescription)")
-                return
-            }
-        } else {
-            unprotected = data
-        }
+        guard let unprotected = self.unprotect(data) else { return }
 
         // Pass.
         handler.objectReceived(headers,
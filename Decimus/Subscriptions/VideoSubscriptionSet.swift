@@ -26,17 +26,21 @@ class VideoSubscriptionSet: ObservableSubscriptionSet, DisplayNotification, @unc
     private let videoBehaviour: VideoBehaviour
     private let granularMetrics: Bool
     private let jitterBufferConfig: JitterBuffer.Config
-    private var renderTask: Task<(), Never>?
+    private let scheduler: DeadlineScheduler
+    private let rendering = Atomic<Bool>(false)
     private let simulreceive: SimulreceiveMode
     private var lastTime: CMTime?
     private var qualityMisses = 0
     private var qualityHits = 0
     private var last: FullTrackName?
-    private var lastImage: AvailableImage?
+    private var lastShown: (pts: Int64, width: UInt32, discontinuous: Bool)?
     private let qualityMissThreshold: Int
     private var cleanupTask: Task<(), Never>?
     private let lastUpdateTime = Atomic<Ticks>(.now)
     private let profiles: [FullTrackName: VideoCodecConfig]
+    private let layers: [FullTrackName]
+    private let qualityTable: QQualityTable
+    private let highestFps: UInt16
     private let cleanupTimer: TimeInterval
     private var pauseMissCounts: [FullTrackName: Int] = [:]
     private let pauseMissThreshold: Int
@@ -85,6 +89,7 @@ class VideoSubscriptionSet: ObservableSubscriptionSet, DisplayNotification, @unc
          activeSpeakerStats: ActiveSpeakerStats?,
          cleanupTime: TimeInterval,
          slidingWindowTime: TimeInterval,
+         scheduler: DeadlineScheduler,
          config: Config) throws {
         if simulreceive != .none && jitterBufferConfig.mode == .layer {
             throw "Simulreceive and layer are not compatible"
@@ -122,6 +127,7 @@ class VideoSubscriptionSet: ObservableSubscriptionSet, DisplayNotification, @unc
         self.joinDate = joinDate
         self.activeSpeakerStats = activeSpeakerStats
         self.cleanupTimer = cleanupTime
+        self.scheduler = scheduler
         self.config = config
 
         // Adjust and store expected quality profiles.
@@ -139,6 +145,14 @@ class VideoSubscriptionSet: ObservableSubscriptionSet, DisplayNotification, @unc
         // Store all the containing profiles.
         self.profiles = createdProfiles
         let maxFps = createdProfiles.values.reduce(into: 0) { $0 = max($0, Int($1.fps)) }
+        self.highestFps = UInt16(clamping: max(maxFps, 1))
+
+        // Quality layers, widest first.
+        self.layers = createdProfiles.sorted { $0.value.width > $1.value.width }.map { $0.key }
+        guard let qualityTable = QQualityTable(layers: self.layers.count) else {
+            throw "Too many qualities for simulreceive: \(self.layers.count)"
+        }
+        self.qualityTable = qualityTable
         let capacityGuess = TimeInterval(maxFps) * TimeInterval(createdProfiles.count) * slidingWindowTime
 
         // Base.
@@ -187,8 +201,8 @@ class VideoSubscriptionSet: ObservableSubscriptionSet, DisplayNotification, @unc
         let result = super.removeHandler(ftn)
         if self.simulreceive == .enable,
            self.getHandlers().isEmpty {
+            // The render job stops itself when it next runs.
             self.logger.debug("Destroying simulreceive render as no live subscriptions")
-            self.renderTask?.cancel()
             self.participant.clear()
         }
         return result
@@ -250,12 +264,10 @@ class VideoSubscriptionSet: ObservableSubscriptionSet, DisplayNotification, @unc
             _ = self.variances.calculateSetVariance(timestamp: timestamp, now: details.when.hostDate)
         }
 
-        // If we're responsible for rendering.
-        if self.simulreceive != .none {
-            // Start the render task.
-            if self.renderTask == nil || self.renderTask!.isCancelled {
-                self.startRenderTask()
-            }
+        // If we're responsible for rendering, and not already.
+        if self.simulreceive != .none,
+           self.rendering.compareExchange(expected: false, desired: true, ordering: .acquiringAndReleasing).exchanged {
+            self.startRendering()
         }
 
         // Record the last time this updated.
@@ -268,34 +280,36 @@ class VideoSubscriptionSet: ObservableSubscriptionSet, DisplayNotification, @unc
         }
     }
 
-    private func startRenderTask() {
-        self.renderTask = .init(priority: .high) { [weak self] in
-            while !Task.isCancelled {
-                let duration: TimeInterval
-                if let self = self {
-                    let now = Ticks.now
-                    if self.getHandlers().isEmpty {
-                        self.renderTask?.cancel()
-                        duration = TimeInterval.nan
-                    } else {
-                        do {
-                            duration = try self.makeSimulreceiveDecision(at: now)
-                        } catch {
-                            self.logger.error("Simulreceive failure: \(error.localizedDescription)")
-                            self.renderTask?.cancel()
-                            duration = TimeInterval.nan
-                        }
-                    }
-                } else {
-                    return
-                }
-                if duration > 0 {
-                    try? await Task.sleep(for: .seconds(duration))
-                }
+    /// The layer of the quality table that a subscription's decoded frames should be published to.
+    /// - Parameter ftn: The full track name of the subscription.
+    /// - Returns: The layer, or nil if this set isn't rendering simulreceive or the track isn't one of its qualities.
+    func simulreceiveLayer(for ftn: FullTrackName) -> SimulreceiveLayer? {
+        guard self.simulreceive != .none,
+              let index = self.layers.firstIndex(of: ftn) else { return nil }
+        return .init(table: self.qualityTable, index: index)
+    }
+
+    private func startRendering() {
+        self.scheduler.schedule { [weak self] now in
+            guard let self = self else { return nil }
+            guard self.hasHandlers else {
+                self.rendering.store(false, ordering: .releasing)
+                return nil
+            }
+            do {
+                return try self.makeSimulreceiveDecision(at: now)
+            } catch {
+                self.logger.error("Simulreceive failure: \(error.localizedDescription)")
+                self.rendering.store(false, ordering: .releasing)
+                return nil
             }
         }
     }
 
+    private func videoHandler(_ ftn: FullTrackName) -> VideoHandler? {
+        (self.getHandler(ftn) as? VideoSubscription)?.handler.get()
+    }
+
     struct SimulreceiveItem: Equatable {
         static func == (lhs: VideoSubscriptionSet.SimulreceiveItem,
                         rhs: VideoSubscriptionSet.SimulreceiveItem) -> Bool {
@@ -305,117 +319,68 @@ class VideoSubscriptionSet: ObservableSubscriptionSet, DisplayNotification, @unc
         let image: AvailableImage
     }
 
-    enum SimulreceiveReason {
-        case onlyChoice(item: SimulreceiveItem)
-        case highestRes(item: SimulreceiveItem, pristine: Bool)
-    }
-
-    internal static func makeSimulreceiveDecision(choices: inout any Collection<SimulreceiveItem>) -> SimulreceiveReason? {
-        // Early return.
-        guard choices.count > 1 else {
-            if let first = choices.first {
-                return .onlyChoice(item: first)
-            }
-            return nil
-        }
-
-        // Oldest should be the oldest value that hasn't already been shown.
-        let oldest: CMTime = choices.reduce(CMTime.positiveInfinity) { min($0, $1.image.image.presentationTimeStamp) }
-
-        // Filter out any frames that don't match the desired point in time.
-        choices = choices.filter { $0.image.image.presentationTimeStamp == oldest }
-
-        // We want the highest non-discontinous frame.
-        // If all are non-discontinous, we'll take the highest quality.
-        func getWidth(_ item: SimulreceiveItem) -> Int32 {
-            item.image.image.formatDescription!.dimensions.width
+    private func waitTime(_ handler: VideoHandler, sample: CMSampleBuffer?, at: Ticks) -> TimeInterval {
+        if let duration = handler.calculateWaitTime(from: at) {
+            return duration
         }
-        let sorted = choices.sorted { getWidth($0) > getWidth($1) }
-        let pristine = sorted.filter { !$0.image.discontinous }
-        if let pristine = pristine.first {
-            return .highestRes(item: pristine, pristine: true)
-        } else if let sorted = sorted.first {
-            return .highestRes(item: sorted, pristine: false)
-        } else {
-            return nil
+        if let sample, sample.duration.isValid {
+            return sample.duration.seconds
         }
+        return 1 / TimeInterval(self.highestFps)
     }
 
     // swiftlint:disable cyclomatic_complexity
     // swiftlint:disable function_body_length
     private func makeSimulreceiveDecision(at: Ticks) throws -> TimeInterval {
-        // Gather up what frames we have to choose from.
-        var initialChoices: [SimulreceiveItem] = []
-        let subscriptions = self.getHandlers().mapValues { $0 as! VideoSubscription } // swiftlint:disable:this force_cast
-        for subscription in subscriptions {
-            guard let handler = subscription.value.handler.get() else {
-                continue
+        // Choose from the frames the decoders have published that are newer than the last shown.
+        let table = self.qualityTable
+        guard table.decide(self.lastShown?.pts ?? .min) else {
+            // Wait for next.
+            if let last = self.last,
+               let handler = self.videoHandler(last) {
+                return handler.calculateWaitTime(from: at) ?? (1 / Double(handler.config.fps))
             }
-            handler.lastDecodedImage.withLock { lockedImage in
-                guard let available = lockedImage else { return }
-                if let lastTime = self.lastImage?.image.presentationTimeStamp,
-                   available.image.presentationTimeStamp <= lastTime {
-                    // This would be backwards in time, so we'll never use it.
-                    lockedImage = nil
-                    return
-                }
-                initialChoices.append(.init(fullTrackName: handler.fullTrackName, image: available))
+            return 1 / TimeInterval(self.highestFps)
+        }
+        let decided = table.selected()
+        let pts = table.pts()
+        guard let decidedHandler = self.videoHandler(self.layers[decided]) else {
+            // Published before its subscription went away.
+            table.consume()
+            return 0
+        }
+
+        // Only the chosen frame's image is needed to display it.
+        var image: AvailableImage?
+        var current: Int64?
+        decidedHandler.lastDecodedImage.withLock { lockedImage in
+            current = lockedImage?.image.presentationTimeStamp.microseconds
+            if current == pts {
+                image = lockedImage
             }
         }
-
-        // Make a decision about which frame to use.
-        var choices = initialChoices as any Collection<SimulreceiveItem>
-        let decisionTime = self.measurement == nil ? nil : at.hostDate
-        let decision = Self.makeSimulreceiveDecision(choices: &choices)
-
-        guard let decision = decision else {
-            // Wait for next.
-            let duration: TimeInterval
-            if let lastNamespace = self.last,
-               let handler = subscriptions[lastNamespace]?.handler.get() {
-                duration = handler.calculateWaitTime(from: at) ?? (1 / Double(handler.config.fps))
-            } else {
-                var highestFps: UInt16 = 1
-                for subscription in subscriptions {
-                    guard let handler = subscription.value.handler.get() else {
-                        continue
-                    }
-                    highestFps = max(highestFps, handler.config.fps)
-                }
-                duration = TimeInterval(1 / highestFps)
+        guard let image else {
+            if let current, current > pts {
+                // Superseded since it was published, and its replacement is about to be.
+                return 0
             }
-            return duration
+            table.consume()
+            return 0
         }
 
         // Consume all images from our shortlist.
-        for choice in choices {
-            let handler = subscriptions[choice.fullTrackName]!.handler.get()!
-            handler.lastDecodedImage.withLock { lockedImage in
-                let theirTime = lockedImage?.image.presentationTimeStamp
-                let ourTime = choice.image.image.presentationTimeStamp
-                if theirTime == ourTime {
-                    lockedImage = nil
-                }
-            }
-        }
-
-        var selected: SimulreceiveItem
-        switch decision {
-        case .highestRes(let out, _):
-            selected = out
-        case .onlyChoice(let out):
-            selected = out
-        }
+        table.consume()
 
         // If we are changing in quality (resolution or to a discontinuous image)
         // we will only do so after a few hits.
+        var selected = decided
         var wouldStepDown = false
         var wouldStepUp = false
-        if let last = self.lastImage {
-            let incomingWidth = selected.image.image.formatDescription!.dimensions.width
-            if incomingWidth < last.image.formatDescription!.dimensions.width || selected.image.discontinous && !last.discontinous {
+        if let last = self.lastShown {
+            let incomingWidth = table.width(decided)
+            if incomingWidth < last.width || !table.pristine() && !last.discontinuous {
                 wouldStepDown = true
-            } else if incomingWidth > last.image.formatDescription!.dimensions.width {
+            } else if incomingWidth > last.width {
                 wouldStepUp = true
             }
         }
@@ -431,19 +396,15 @@ class VideoSubscriptionSet: ObservableSubscriptionSet, DisplayNotification, @unc
         // For step-up, continue rendering current quality during threshold period, if available.
         var continuingCurrentQuality = false
         if wouldStepUp && self.qualityHits < self.config.qualityHitThreshold,
-           let lastImage = self.lastImage {
-            let lastWidth = lastImage.image.formatDescription!.dimensions.width
-            if let currentQualityChoice = initialChoices.first(where: {
-                $0.image.image.formatDescription!.dimensions.width == lastWidth
-            }) {
-                selected = currentQualityChoice
+           let lastShown = self.lastShown {
+            let currentQuality = table.pending(withWidth: lastShown.width)
+            if currentQuality >= 0 {
+                selected = currentQuality
                 wouldStepUp = false
                 continuingCurrentQuality = true
             }
         }
 
-        let selectedSample = selected.image.image
-
         // We want to record misses for qualities we have already stepped down from, and pause them
         // if they exceed this count.
         if self.pauseResume {
@@ -470,11 +431,9 @@ class VideoSubscriptionSet: ObservableSubscriptionSet, DisplayNotification, @unc
             //            }
         }
 
-        guard let subscription = subscriptions[selected.fullTrackName] else {
-            throw "Missing expected subscription for namespace: \(selected.fullTrackName)"
-        }
-        guard let handler = subscription.handler.get() else {
-            throw "Missing video hanler for namespace: \(selected.fullTrackName)"
+        let selectedName = self.layers[selected]
+        guard let handler = selected == decided ? decidedHandler : self.videoHandler(selectedName) else {
+            throw "Missing video hanler for namespace: \(selectedName)"
         }
 
         let stepDown = wouldStepDown && self.qualityMisses < self.qualityMissThreshold
@@ -482,31 +441,29 @@ class VideoSubscriptionSet: ObservableSubscriptionSet, DisplayNotification, @unc
         let qualitySkip = stepDown || stepUp || continuingCurrentQuality
         if let measurement = self.measurement,
            self.granularMetrics {
+            let reason = table.onlyChoice() ? "Only choice" : "Highest \(table.pristine() ? "Pristine" : "Discontinous")"
+            let shortlist = table.shortlist()
             var report: [VideoSubscriptionSet.SimulreceiveChoiceReport] = []
-            for choice in choices {
-                let isSelectedForDisplay = choice.fullTrackName == selected.fullTrackName
-                switch decision {
-                case .highestRes(let item, let pristine):
-                    if choice.fullTrackName == item.fullTrackName {
-                        let reason = "Highest \(pristine ? "Pristine" : "Discontinous")"
-                        report.append(.init(item: choice,
-                                            selected: true,
-                                            reason: reason,
-                                            displayed: isSelectedForDisplay && !qualitySkip))
-                        continue
-                    }
-                case .onlyChoice(let item):
-                    if choice.fullTrackName == item.fullTrackName {
-                        report.append(.init(item: choice,
-                                            selected: true,
-                                            reason: "Only choice",
-                                            displayed: isSelectedForDisplay && !qualitySkip))
-                        continue
+            for layer in self.layers.indices where shortlist & (1 << layer) != 0 {
+                let fullTrackName = self.layers[layer]
+                var available = layer == decided ? image : nil
+                if available == nil {
+                    self.videoHandler(fullTrackName)?.lastDecodedImage.withLock { lockedImage in
+                        if lockedImage?.image.presentationTimeStamp.microseconds == pts {
+                            available = lockedImage
+                        }
                     }
                 }
-
-                // Note the choice we're actually displaying even if we didn't select.
-                if isSelectedForDisplay && continuingCurrentQuality {
+                guard let available else { continue }
+                let choice = SimulreceiveItem(fullTrackName: fullTrackName, image: available)
+                let isSelectedForDisplay = layer == selected
+                if layer == decided {
+                    report.append(.init(item: choice,
+                                        selected: true,
+                                        reason: reason,
+                                        displayed: isSelectedForDisplay && !qualitySkip))
+                } else if isSelectedForDisplay && continuingCurrentQuality {
+                    // Note the choice we're actually displaying even if we didn't select.
                     report.append(.init(item: choice,
                                         selected: false,
                                         reason: "Continuing current quality during step-up threshold",
@@ -518,7 +475,7 @@ class VideoSubscriptionSet: ObservableSubscriptionSet, DisplayNotification, @unc
             let completedReport = report
             do {
                 try measurement.reportSimulreceiveChoice(choices: completedReport,
-                                                         timestamp: decisionTime!)
+                                                         timestamp: at.hostDate)
             } catch {
                 self.logger.warning("Failed to report simulreceive metrics: \(error.localizedDescription)")
             }
@@ -526,28 +483,16 @@ class VideoSubscriptionSet: ObservableSubscriptionSet, DisplayNotification, @unc
 
         if qualitySkip {
             // We only want to change in quality if we've missed a few hits.
-            if let duration = handler.calculateWaitTime(from: at) {
-                return duration
-            }
-            if selectedSample.duration.isValid {
-                return selectedSample.duration.seconds
-            }
-            var highestFps: UInt16 = 1
-            for subscription in subscriptions {
-                guard let handler = subscription.value.handler.get() else {
-                    continue
-                }
-                highestFps = max(highestFps, handler.config.fps)
-            }
-            return 1 / TimeInterval(highestFps)
+            return self.waitTime(handler, sample: selected == decided ? image.image : nil, at: at)
         }
 
         // Proceed with rendering this frame.
+        let selectedSample = image.image
         self.qualityMisses = 0
         self.qualityHits = 0
         self.pauseMissCounts[handler.fullTrackName] = 0
         self.last = handler.fullTrackName
-        self.lastImage = selected.image
+        self.lastShown = (pts, table.width(decided), !table.pristine())
 
         if self.simulreceive == .enable {
             // Set to display immediately.
@@ -638,20 +583,7 @@ class VideoSubscriptionSet: ObservableSubscriptionSet, DisplayNotification, @unc
         }
 
         // Wait until we have expect to have the next frame available.
-        if let duration = handler.calculateWaitTime(from: at) {
-            return duration
-        }
-        if selectedSample.duration.isValid {
-            return selectedSample.duration.seconds
-        }
-        var highestFps: UInt16 = 1
-        for subscription in subscriptions {
-            guard let handler = subscription.value.handler.get() else {
-                continue
-            }
-            highestFps = max(highestFps, handler.config.fps)
-        }
-        return 1 / TimeInterval(highestFps)
+        return self.waitTime(handler, sample: selectedSample, at: at)
     }
     // swiftlint:enable cyclomatic_complexity
     // swiftlint:enable function_body_length
@@ -687,3 +619,25 @@ class VideoSubscriptionSet: ObservableSubscriptionSet, DisplayNotification, @unc
         self.displayCallbacks.fire()
     }
 }
+
+/// A subscription's layer in its simulreceive set's quality table, which its decoder publishes frames to.
+struct SimulreceiveLayer: Sendable {
+    let table: QQualityTable
+    let index: Int
+
+    /// Publish a newly decoded sample as the latest of this layer.
+    /// - Parameter sample: The decoded sample, after it is made available as the handler's last decoded image.
+    func decoded(_ sample: CMSampleBuffer) {
+        let width = sample.formatDescription?.dimensions.width ?? 0
+        self.table.update(self.index,
+                          pts: sample.presentationTimeStamp.microseconds,
+                          width: UInt32(clamping: width),
+                          discontinuous: sample.discontinous)
+    }
+}
+
+private extension CMTime {
+    var microseconds: Int64 {
+        self.convertScale(Int32(microsecondsPerSecond), method: .default).value
+    }
+}
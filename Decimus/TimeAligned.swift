@@ -72,43 +72,44 @@ struct TimeDiff: ~Copyable {
 }
 
 final class TimeAligner {
-    private let hostTimeWindow: Mutex<[HostTimeOffset]>
-    private let windowLength: TimeInterval
+    private let hostTimeWindow: QWindowMin
+    /// The current best offset, as the bit pattern of its sender timestamp and its receiver host time.
+    /// Written on arrival, read by window maintenance.
+    private let best = Atomic<WordPair>(.init(first: 0, second: 0))
     private var windowMaintenance: Task<(), Never>?
     typealias GetAlignables = () -> [TimeAlignable]
     private let getAlignables: GetAlignables
 
+    /// - Parameter windowLength: How long an arrival counts towards the estimate.
+    /// - Parameter capacity: Expected arrivals within a window. Twice this are held before the oldest are dropped.
+    /// - Parameter alignables: Those to align.
     init(windowLength: TimeInterval, capacity: Int, alignables: @escaping GetAlignables) {
-        self.hostTimeWindow = .init([])
-        self.windowLength = windowLength
+        self.hostTimeWindow = .init(capacity: max(capacity, 1) * 2,
+                                    length: windowLength,
+                                    secondsPerTick: Ticks(1).seconds)
         self.getAlignables = alignables
     }
 
-    private func doWindowMaintenance(when: Ticks) -> HostTimeOffset? {
-        // Look at all the times in our window.
-        // The smallest diff between sender and receiver time is our best
-        // estimate of the correct offset, as live media cannot arrive early.
-        self.hostTimeWindow.withLock { entries in
-            entries.removeAll { when.timeIntervalSince($0.receiverHostTime) > self.windowLength }
-            guard !entries.isEmpty else { return nil }
-            return entries.min { lhs, rhs in
-                let lhsDiff = lhs.receiverHostTime.seconds - lhs.senderTimestamp
-                let rhsDiff = rhs.receiverHostTime.seconds - rhs.senderTimestamp
-                return lhsDiff < rhsDiff
-            }
-        }
-    }
-
+    /// Record an arrival. This must only be called from 1 concurrency context.
+    /// - Parameter timestamp: Sender timestamp of the arrival.
+    /// - Parameter when: Receiver host time of the arrival.
+    /// - Parameter force: Align immediately, rather than at the next window maintenance.
     func doTimestampTimeDiff(_ timestamp: TimeInterval, when: Ticks, force: Bool = false) {
-        let offset = HostTimeOffset(senderTimestamp: timestamp,
-                                    receiverHostTime: when)
-        self.hostTimeWindow.withLock { $0.append(offset) }
+        // The smallest diff between sender and receiver time in our window is our best
+        // estimate of the correct offset, as live media cannot arrive early.
+        self.hostTimeWindow.push(when, timestamp: timestamp)
+        var receiverHostTime: Ticks = 0
+        var senderTimestamp: TimeInterval = 0
+        guard self.hostTimeWindow.min(&receiverHostTime, timestamp: &senderTimestamp) else { return }
+        let best = HostTimeOffset(senderTimestamp: senderTimestamp, receiverHostTime: receiverHostTime)
+        self.best.store(.init(first: UInt(senderTimestamp.bitPattern), second: UInt(receiverHostTime)),
+                        ordering: .releasing)
 
         if !force && self.windowMaintenance == nil {
             self.windowMaintenance = .init(priority: .utility) { [weak self] in
                 while !Task.isCancelled {
                     if let self = self {
-                        self.set(.now)
+                        self.set(self.currentBest())
                     } else {
                         return
                     }
@@ -117,13 +118,20 @@ final class TimeAligner {
             }
         }
 
-        if force || self.hostTimeWindow.withLock({ $0.count == 1 }) {
-            self.set(when)
+        if force || self.hostTimeWindow.count() == 1 {
+            self.set(best)
         }
     }
 
-    private func set(_ date: Ticks) {
-        guard let hostEntry = self.doWindowMaintenance(when: date) else { return }
+    private func currentBest() -> HostTimeOffset? {
+        let pair = self.best.load(ordering: .acquiring)
+        guard pair.second != 0 else { return nil }
+        return .init(senderTimestamp: TimeInterval(bitPattern: UInt64(pair.first)),
+                     receiverHostTime: Ticks(pair.second))
+    }
+
+    private func set(_ hostEntry: HostTimeOffset?) {
+        guard let hostEntry else { return }
 
         for alignable in self.getAlignables() {
             alignable.timeDiff.setTimeDiff(diff: hostEntry)
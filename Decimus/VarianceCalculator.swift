@@ -5,21 +5,21 @@ import Synchronization
 
 /// Calculate the variance between a set of timestamped events and their time of occurance.
 final class VarianceCalculator: Sendable {
-    private let variances: Mutex<[TimeInterval: [Date]]> = .init([:])
-    private let varianceMaxCount: Int
+    // Writers can be on different decode threads, so serialize them. Uncontended in practice.
+    private let variances: Mutex<QSetVariance>
     private let expectedOccurrences: Int
     private let measurement: VarianceCalculatorMeasurement?
 
     /// Create a new calculator.
     /// - Parameter expectedOccurences The number of occurences after which a calculation will be completed.
-    /// - Parameter max The number of calculations in flight before flushing.
+    /// - Parameter max The number of calculations in flight before flushing the oldest half.
     init(expectedOccurrences: Int,
          max: Int = 10,
          submitter: MetricsSubmitter? = nil,
          source: String? = nil,
          stage: String? = nil) throws {
         self.expectedOccurrences = expectedOccurrences
-        self.varianceMaxCount = max
+        self.variances = .init(.init(expected: UInt32(expectedOccurrences), max: UInt32(max)))
         if let submitter = submitter {
             guard let source = source,
                   let stage = stage else {
@@ -34,46 +34,26 @@ final class VarianceCalculator: Sendable {
     }
 
     /// Record a variance.
+    /// - Parameter timestamp: Identifies the set this occurrence belongs to.
+    /// - Parameter now: When it occurred.
+    /// - Returns: The spread between the first and last occurrence, if this completed the set.
     func calculateSetVariance(timestamp: TimeInterval, now: Date) -> TimeInterval? {
-        let variances = self.variances.withLock { varianceMap in
-            // Cleanup.
-            if varianceMap.count > self.varianceMaxCount {
-                for index in 0...self.varianceMaxCount / 2 {
-                    let variance = varianceMap.remove(at: varianceMap.index(varianceMap.startIndex,
-                                                                            offsetBy: index))
-                    _ = calculateSetVariance(times: variance.value, now: now)
+        self.variances.withLock { variances in
+            var variance: TimeInterval = 0
+            let complete = variances.record(timestamp,
+                                            arrival: now.timeIntervalSinceReferenceDate,
+                                            variance: &variance)
+            if let measurement = self.measurement {
+                for index in 0..<variances.flushed() {
+                    measurement.reportVariance(variance: variances.flushedVariance(index),
+                                               timestamp: now,
+                                               count: Int(variances.flushedCount(index)))
+                }
+                if complete {
+                    measurement.reportVariance(variance: variance, timestamp: now, count: self.expectedOccurrences)
                 }
             }
-
-            guard var variances = varianceMap[timestamp] else {
-                varianceMap[timestamp] = [now]
-                return [Date]?.none
-            }
-
-            variances.append(now)
-            guard variances.count == self.expectedOccurrences else {
-                // If we're not done, just store for next time.
-                varianceMap[timestamp] = variances
-                return [Date]?.none
-            }
-
-            // We're done, remove and report.
-            varianceMap.removeValue(forKey: timestamp)
-            return variances
-        }
-        guard let variances = variances else { return nil }
-        return calculateSetVariance(times: variances, now: now)
-    }
-
-    private func calculateSetVariance(times: [Date], now: Date) -> TimeInterval {
-        var oldest = Date.distantFuture
-        var newest = Date.distantPast
-        for date in times {
-            oldest = min(oldest, date)
-            newest = max(newest, date)
+            return complete ? variance : nil
         }
-        let variance = newest.timeIntervalSince(oldest)
-        self.measurement?.reportVariance(variance: variance, timestamp: now, count: times.count)
-        return variance
     }
 }
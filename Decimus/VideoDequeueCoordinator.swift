@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Synchronization
+
+/// A media handler that dequeues from its jitter buffer at deadlines, driven by ``VideoDequeueCoordinator``.
+protocol DequeueSchedulable: AnyObject {
+    /// Unique identifier of this handler's registration.
+    var dequeueIdentifier: String { get }
+
+    /// When this handler next wants to process a frame.
+    /// - Parameter from: The current time.
+    /// - Returns: The deadline, or nil to stop being scheduled.
+    func calculateNextDeadline(from: Ticks) -> Ticks?
+
+    /// Dequeue and process a frame, if one is available.
+    /// - Parameter at: The current time.
+    /// - Returns: False to stop being scheduled.
+    func processFrame(at: Ticks) throws -> Bool
+}
+
+/// Dequeues every registered handler from one playout clock.
+///
+/// Rather than a sleeping task per handler, each handler's next deadline (from its jitter buffer's playout
+/// date) is kept in one ``DeadlineScheduler``, serviced by a single high priority thread that processes all
+/// handlers due within its tolerance in the same wakeup. Handlers are only called from that thread, and are
+/// held weakly.
+final class VideoDequeueCoordinator: Sendable {
+    /// All audio and video playout.
+    static let shared = VideoDequeueCoordinator(scheduler: .playout)
+
+    private final class Registration: @unchecked Sendable {
+        weak var handler: DequeueSchedulable?
+        // Only accessed by the job.
+        var primed = false
+
+        init(_ handler: DequeueSchedulable) {
+            self.handler = handler
+        }
+    }
+
+    private let logger = DecimusLogger(VideoDequeueCoordinator.self)
+    private let scheduler: DeadlineScheduler
+    private let tokens = Mutex<[String: DeadlineScheduler.Token]>([:])
+
+    /// Create a coordinator.
+    /// - Parameter scheduler: The scheduler to run handlers from.
+    init(scheduler: DeadlineScheduler) {
+        self.scheduler = scheduler
+    }
+
+    /// Start dequeuing a handler, replacing any existing registration with the same identifier.
+    /// - Parameter handler: The handler, first asked for its deadline as soon as possible.
+    func register(_ handler: DequeueSchedulable) {
+        let identifier = handler.dequeueIdentifier
+        let registration = Registration(handler)
+        let logger = self.logger
+        let token = self.scheduler.schedule { now in
+            guard let handler = registration.handler else { return nil }
+            if registration.primed {
+                do {
+                    guard try handler.processFrame(at: now) else { return nil }
+                } catch {
+                    logger.error("[\(identifier)] Failed to process frame: \(error.localizedDescription)")
+                }
+            }
+            registration.primed = true
+            guard let deadline = handler.calculateNextDeadline(from: now) else { return nil }
+            return deadline.timeIntervalSince(now)
+        }
+        let replaced = self.tokens.withLock { $0.updateValue(token, forKey: identifier) }
+        if let replaced {
+            self.scheduler.cancel(replaced)
+        }
+    }
+
+    /// Stop dequeuing a handler. It will not be called again, though may be being called now.
+    /// - Parameter identifier: The handler's ``DequeueSchedulable/dequeueIdentifier``.
+    func unregister(_ identifier: String) {
+        guard let token = self.tokens.withLock({ $0.removeValue(forKey: identifier) }) else { return }
+        self.scheduler.cancel(token)
+    }
+}
@@ -54,6 +54,20 @@ struct SubscriptionSettingsView: View {
                           format: .number)
                     .labelsHidden()
             }
+            LabeledContent("Video decoder") {
+                Picker("Video decoder", selection: $subscriptionConfig.value.videoDecoder) {
+                    ForEach(VideoDecoderBackend.allCases) {
+                        Text(String(describing: $0))
+                    }
+                }
+                .pickerStyle(.segmented)
+                .labelsHidden()
+            }
+            LabeledContent("Video Join Cache (MB, 0 off)") {
+                NumberView(value: self.$subscriptionConfig.value.objectCacheMB,
+                           formatStyle: IntegerFormatStyle<Int>.number.grouping(.never),
+                           name: "MB")
+            }
             LabeledToggle("Experimental WiFi Adaptation",
                           isOn: self.$subscriptionConfig.value.videoJitterBuffer.spikePrediction)
             LabeledToggle("New Audio Buffer",
@@ -185,6 +199,24 @@ struct SubscriptionSettingsView: View {
             LabeledToggle("Do Pause/Resume",
                           isOn: $subscriptionConfig.value.pauseResume)
 
+            LabeledContent("Pre-subscribed speakers (0 off)") {
+                NumberView(value: self.$subscriptionConfig.value.preSubscription.count,
+                           formatStyle: IntegerFormatStyle<Int>.number.grouping(.never),
+                           name: "Speakers")
+            }
+            if self.subscriptionConfig.value.preSubscription.count > 0 {
+                LabeledContent("Pre-subscribed bitrate (kbps)") {
+                    NumberView(value: self.$subscriptionConfig.value.preSubscription.bitrateKbps,
+                               formatStyle: IntegerFormatStyle<UInt32>.number.grouping(.never),
+                               name: "kbps")
+                }
+                LabeledContent("Pre-subscribed memory (MB)") {
+                    NumberView(value: self.$subscriptionConfig.value.preSubscription.memoryMB,
+                               formatStyle: IntegerFormatStyle<Int>.number.grouping(.never),
+                               name: "MB")
+                }
+            }
+
             LabeledToggle("Use Announce Flow",
                           isOn: $subscriptionConfig.value.useAnnounce)
 
@@ -243,6 +275,19 @@ struct SubscriptionSettingsView: View {
                                     enableQlog: $subscriptionConfig.value.enableQlog,
                                     quicPriorityLimit:
                                         $subscriptionConfig.value.quicPriorityLimit)
+            LabeledContent("Egress Pacing (kbps, 0 off)") {
+                NumberView(value: self.$subscriptionConfig.value.egressBitrateKbps,
+                           formatStyle: IntegerFormatStyle<UInt32>.number.grouping(.never),
+                           name: "kbps")
+            }
+            if self.subscriptionConfig.value.egressBitrateKbps > 0 {
+                LabeledContent("Drop Paced Video After (s)") {
+                    TextField("Drop after (s)",
+                              value: self.$subscriptionConfig.value.egressStaleVideoAge,
+                              format: .number)
+                        .labelsHidden()
+                }
+            }
         }
         .onAppear {
             self.subscriptionConfig.value.videoJitterBuffer.minDepth = self.subscriptionConfig.value.jitterDepthTime
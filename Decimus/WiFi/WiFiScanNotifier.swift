@@ -36,13 +36,17 @@ class CoreWLANWiFiScanNotifier: WiFiScanNotifier, CWEventDelegate {
     }
 }
 
+private extension MetricField {
+    static let updated = MetricField("Updated")
+}
+
 final class WiFiCacheEventMeasurement: MetricsMeasurement {
     let storage = MeasurementStorage()
     let name = "WiFi Scan"
     let tags: [String: String] = [:]
 
     func updated(timestamp: Date) {
-        self.record(field: "Updated", value: 1, timestamp: timestamp)
+        self.record(field: .updated, value: 1.0, timestamp: timestamp)
     }
 }
 
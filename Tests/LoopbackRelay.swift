@@ -0,0 +1,202 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Foundation
+import Synchronization
+@testable import QuicR
+
+/// An in-process stand-in for a relay, forwarding every object published to a track to the track's subscriptions.
+///
+/// Objects cross the same seams they do with a real relay: publications hand them to a ``MoQSink``, and subscriptions
+/// receive them through the bridge entry points, with extensions in their flat encoding. Each subscriber
+/// receives on its own serial queue, as each client does on its own transport thread. Partially published
+/// objects are forwarded piece by piece, as they arrive.
+final class LoopbackRelay: Sendable {
+    private struct Subscriber {
+        let subscription: Subscription
+        let queue: DispatchQueue
+        /// When the subscriber's link finishes carrying what it has been given.
+        var linkFree: Ticks = 0
+    }
+
+    private let subscribers = Mutex<[FullTrackName: [Subscriber]]>([:])
+    private let delay: TimeInterval
+    private let bitrate: UInt64?
+    private let forwarded = Atomic<Int>(0)
+    /// Answers requests in the order they arrive, as over a control stream.
+    private let control = DispatchQueue(label: "LoopbackRelay.control")
+
+    /// Objects, or pieces of objects, handed to subscribers so far.
+    var objectsForwarded: Int {
+        self.forwarded.load(ordering: .relaxed)
+    }
+
+    /// Create a relay.
+    /// - Parameter delay: One way delay added to every object.
+    /// - Parameter bitrate: If set, the bits per second of each subscriber's link, over which objects are serialized.
+    init(delay: TimeInterval = 0, bitrate: UInt64? = nil) {
+        self.delay = delay
+        self.bitrate = bitrate
+    }
+
+    /// Make a sink publishing to this relay.
+    /// - Parameter fullTrackName: The track to publish.
+    /// - Returns: The sink.
+    func makeSink(_ fullTrackName: FullTrackName) -> LoopbackSink {
+        .init(fullTrackName: fullTrackName, relay: self)
+    }
+
+    /// Deliver a track's objects to a subscription.
+    /// - Parameter fullTrackName: The track to subscribe to.
+    /// - Parameter subscription: Where to deliver its objects.
+    func subscribe(_ fullTrackName: FullTrackName, subscription: Subscription) {
+        let queue = DispatchQueue(label: "LoopbackRelay.\(fullTrackName)", qos: .userInitiated)
+        self.subscribers.withLock {
+            $0[fullTrackName, default: []].append(.init(subscription: subscription, queue: queue))
+        }
+    }
+
+    /// Make a client of this relay, whose subscriptions are answered a round trip after they're made.
+    /// The client keeps the relay alive.
+    /// - Parameter subscribed: Called as each subscription is answered, on the relay's control queue.
+    /// - Returns: The client.
+    func makeClient(subscribed: @escaping @Sendable (Subscription) -> Void = { _ in }) -> MockClient {
+        let roundTrip = self.delay * 2
+        return MockClient(publish: { _ in },
+                          unpublish: { _ in },
+                          subscribe: { subscription in
+                            self.subscribe(FullTrackName(subscription.getFullTrackName()), subscription: subscription)
+                            self.control.asyncAfter(deadline: .now() + roundTrip) {
+                                subscription.statusChanged(.ok)
+                                subscribed(subscription)
+                            }
+                          },
+                          unsubscribe: { subscription in
+                            self.unsubscribe(FullTrackName(subscription.getFullTrackName()), subscription: subscription)
+                          },
+                          fetch: { _ in },
+                          fetchCancel: { _ in })
+    }
+
+    /// Stop delivering a track's objects to a subscription.
+    /// - Parameter fullTrackName: The track.
+    /// - Parameter subscription: The subscription to stop delivering to.
+    func unsubscribe(_ fullTrackName: FullTrackName, subscription: Subscription) {
+        self.subscribers.withLock {
+            $0[fullTrackName]?.removeAll { $0.subscription === subscription }
+        }
+    }
+
+    fileprivate func forward(_ fullTrackName: FullTrackName,
+                             groupId: UInt64,
+                             subgroupId: UInt64,
+                             objectId: UInt64,
+                             payloadLength: UInt64,
+                             data: Data,
+                             extensions: Data?,
+                             immutableExtensions: Data?,
+                             partial: Bool) {
+        // When each subscriber receives it: after the hop, and after its link has carried it.
+        let now = Ticks.now
+        let transmission = self.bitrate.map { TimeInterval(data.count * 8) / TimeInterval($0) } ?? 0
+        var deliveries: [(Subscriber, TimeInterval)] = []
+        self.subscribers.withLock { subscribers in
+            guard let indices = subscribers[fullTrackName]?.indices else { return }
+            for index in indices {
+                let linkFree = max(now, subscribers[fullTrackName]![index].linkFree).addingTimeInterval(transmission)
+                subscribers[fullTrackName]![index].linkFree = linkFree
+                deliveries.append((subscribers[fullTrackName]![index], linkFree.timeIntervalSince(now) + self.delay))
+            }
+        }
+        for (subscriber, wait) in deliveries {
+            let deliver: @Sendable () -> Void = {
+                let headers = QObjectHeaders(groupId: groupId,
+                                             subgroupId: subgroupId,
+                                             objectId: objectId,
+                                             payloadLength: payloadLength,
+                                             status: .available,
+                                             priority: nil,
+                                             ttl: nil)
+                if partial {
+                    subscriber.subscription.partialObjectReceived(headers,
+                                                                  data: data,
+                                                                  flatExtensions: extensions,
+                                                                  flatImmutableExtensions: immutableExtensions)
+                } else {
+                    subscriber.subscription.objectReceived(headers,
+                                                           data: data,
+                                                           flatExtensions: extensions,
+                                                           flatImmutableExtensions: immutableExtensions,
+                                                           streamHeaderProperties: nil)
+                }
+            }
+            if wait > 0 {
+                subscriber.queue.asyncAfter(deadline: .now() + wait, execute: deliver)
+            } else {
+                subscriber.queue.async(execute: deliver)
+            }
+        }
+        self.forwarded.add(deliveries.count, ordering: .relaxed)
+    }
+}
+
+/// A ``MoQSink`` publishing to a ``LoopbackRelay``.
+final class LoopbackSink: MoQSink {
+    let fullTrackName: FullTrackName
+    private let relay: LoopbackRelay
+
+    var status: QPublishTrackHandlerStatus {
+        .ok
+    }
+
+    var canPublish: Bool {
+        true
+    }
+
+    var supportsPartialObjects: Bool {
+        true
+    }
+
+    fileprivate init(fullTrackName: FullTrackName, relay: LoopbackRelay) {
+        self.fullTrackName = fullTrackName
+        self.relay = relay
+    }
+
+    func setCallbacks(onStatus: @escaping OnStatus, onMetrics: @escaping OnMetrics) {}
+
+    func publishObject(_ headers: QObjectHeaders,
+                       data: Data,
+                       extensions: HeaderExtensions?,
+                       immutableExtensions: HeaderExtensions?,
+                       streamHeaderProperties: QStreamHeaderProperties?) -> QPublishObjectStatus {
+        // The caller's data may only be borrowed for this call, as libquicr copies it into its send buffers.
+        self.relay.forward(self.fullTrackName,
+                           groupId: headers.groupId,
+                           subgroupId: headers.subgroupId,
+                           objectId: headers.objectId,
+                           payloadLength: headers.payloadLength,
+                           data: data.withUnsafeBytes { Data($0) },
+                           extensions: extensions?.bridged,
+                           immutableExtensions: immutableExtensions?.bridged,
+                           partial: false)
+        return .ok
+    }
+
+    func publishPartialObject(_ headers: QObjectHeaders,
+                              data: Data,
+                              extensions: HeaderExtensions?,
+                              immutableExtensions: HeaderExtensions?) -> QPublishObjectStatus {
+        self.relay.forward(self.fullTrackName,
+                           groupId: headers.groupId,
+                           subgroupId: headers.subgroupId,
+                           objectId: headers.objectId,
+                           payloadLength: headers.payloadLength,
+                           data: data.withUnsafeBytes { Data($0) },
+                           extensions: extensions?.bridged,
+                           immutableExtensions: immutableExtensions?.bridged,
+                           partial: true)
+        return .ok
+    }
+
+    func endSubgroup(groupId: UInt64, subgroupId: UInt64, completed: Bool) {}
+}
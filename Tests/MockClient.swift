@@ -50,6 +50,12 @@ class MockClient: MoqClient {
         self.publish(handler)
     }
 
+    func publishTracks(withHandlers handlers: [QPublishTrackHandlerObjC]) {
+        for handler in handlers {
+            self.publish(handler)
+        }
+    }
+
     func unpublishTrack(withHandler handler: QPublishTrackHandlerObjC) {
         self.unpublish(handler)
     }
@@ -65,6 +71,12 @@ class MockClient: MoqClient {
         self.subscribe(handler as! Subscription)
     }
 
+    func subscribeTracks(withHandlers handlers: [QSubscribeTrackHandlerObjC]) {
+        for handler in handlers {
+            self.subscribe(handler as! Subscription)
+        }
+    }
+
     func unsubscribeTrack(withHandler handler: QSubscribeTrackHandlerObjC) {
         self.unsubscribe(handler as! Subscription)
     }
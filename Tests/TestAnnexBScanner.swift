@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import CoreMedia
+import XCTest
+@testable import QuicR
+
+final class TestAnnexBScanner: XCTestCase {
+    private func scan(_ bytes: [UInt8], codec: QNalCodec = .h264) -> [QNalSpan] {
+        bytes.withUnsafeBytes { data in
+            AnnexB.withNalus(data, codec: codec) { Array($0) }
+        }
+    }
+
+    func testStartCodes() {
+        let bytes: [UInt8] = [
+            0x00, 0x00, 0x00, 0x01, 0x67, 1, 2,
+            0x00, 0x00, 0x01, 0x68, 3,
+            0x00, 0x00, 0x00, 0x01, 0x65, 4, 5, 6
+        ]
+        let nalus = scan(bytes)
+        XCTAssertEqual(nalus.map(\.offset), [4, 10, 16])
+        XCTAssertEqual(nalus.map(\.length), [3, 2, 4])
+        XCTAssertEqual(nalus.map(\.startCodeLength), [4, 3, 4])
+        XCTAssertEqual(nalus.map(\.type), [7, 8, 5])
+        XCTAssertFalse(nalus.contains { $0.escaped })
+    }
+
+    func testHEVCTypes() {
+        let bytes: [UInt8] = [
+            0x00, 0x00, 0x00, 0x01, 0x40, 0x01, 1,
+            0x00, 0x00, 0x01, 0x26, 0x01, 2
+        ]
+        XCTAssertEqual(scan(bytes, codec: .hevc).map(\.type), [32, 19])
+    }
+
+    func testEmulationPrevention() {
+        let bytes: [UInt8] = [0x00, 0x00, 0x01, 0x41, 0x00, 0x00, 0x03, 0x01, 0x00, 0x00, 0x03, 0x00]
+        let nalus = scan(bytes)
+        XCTAssertEqual(nalus.count, 1)
+        XCTAssertTrue(nalus[0].escaped)
+
+        var unescaped = [UInt8](repeating: 0, count: bytes.count)
+        let length = QAnnexBScanner.unescape(bytes, length: bytes.count, destination: &unescaped)
+        XCTAssertEqual(Array(unescaped[..<length]), [0x00, 0x00, 0x01, 0x41, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00])
+    }
+
+    // Application SEIs aren't escaped, so a start code in their payload must not split them.
+    func testSeiBoundedByPayloadSize() {
+        let bytes: [UInt8] = [
+            0x00, 0x00, 0x00, 0x01, 0x06, 0x05, 0x04, 0x00, 0x00, 0x01, 0x07, 0x80,
+            0x00, 0x00, 0x00, 0x01, 0x41, 9
+        ]
+        let nalus = scan(bytes)
+        XCTAssertEqual(nalus.map(\.type), [6, 1])
+        XCTAssertEqual(nalus[0].length, 8)
+        XCTAssertEqual(nalus[1].offset, 16)
+    }
+
+    func testManyNalus() {
+        var bytes: [UInt8] = []
+        for index in 0..<100 {
+            bytes += [0x00, 0x00, 0x01, 0x41, UInt8(index)]
+        }
+        let nalus = scan(bytes)
+        XCTAssertEqual(nalus.count, 100)
+        XCTAssertEqual(nalus.last?.offset, 99 * 5 + 3)
+    }
+
+    func testDepacketize() throws {
+        let bytes: [UInt8] = [
+            0x00, 0x00, 0x00, 0x01, 0x06, 0x05, 0x02, 0x00, 0x00, 0x03, 0x80,
+            0x00, 0x00, 0x00, 0x01, 0x65, 1, 2, 3,
+            0x00, 0x00, 0x01, 0x41, 4, 5
+        ]
+        var format: CMFormatDescription?
+        var seis: [Data] = []
+        let buffers = try XCTUnwrap(try H264Utilities().depacketize(Data(bytes), format: &format, copy: false) {
+            seis.append($0)
+        })
+
+        // Emulation prevention is removed for the SEI parser.
+        XCTAssertEqual(seis, [Data([0x00, 0x00, 0x00, 0x01, 0x06, 0x05, 0x02, 0x00, 0x00, 0x80])])
+
+        // Both start code lengths are rewritten as a 4 byte length.
+        XCTAssertEqual(buffers.count, 2)
+        var first = [UInt8](repeating: 0, count: buffers[0].dataLength)
+        try first.withUnsafeMutableBytes { try buffers[0].copyDataBytes(to: $0) }
+        XCTAssertEqual(first, [0x00, 0x00, 0x00, 0x04, 0x65, 1, 2, 3])
+        var second = [UInt8](repeating: 0, count: buffers[1].dataLength)
+        try second.withUnsafeMutableBytes { try buffers[1].copyDataBytes(to: $0) }
+        XCTAssertEqual(second, [0x00, 0x00, 0x00, 0x03, 0x41, 4, 5])
+    }
+
+    // A 4K keyframe sized bitstream: slices of escaped, entropy coded looking bytes.
+    private static let keyframe: Data = {
+        var generator = SystemRandomNumberGenerator()
+        var bytes: [UInt8] = []
+        bytes.reserveCapacity(1_100_000)
+        for slice in 0..<16 {
+            bytes += [0x00, 0x00, 0x00, 0x01, slice == 0 ? 0x65 : 0x41]
+            var zeros = 0
+            for _ in 0..<65536 {
+                let byte = UInt8.random(in: 0...255, using: &generator)
+                if zeros >= 2 && byte <= 3 {
+                    bytes.append(0x03)
+                    zeros = 0
+                }
+                bytes.append(byte)
+                zeros = byte == 0 ? zeros + 1 : 0
+            }
+        }
+        return Data(bytes)
+    }()
+
+    func testPerformanceScan() {
+        let keyframe = Self.keyframe
+        measure {
+            for _ in 0..<100 {
+                let found = keyframe.withUnsafeBytes {
+                    AnnexB.withNalus($0, codec: .h264) { $0.count }
+                }
+                XCTAssertEqual(found, 16)
+            }
+        }
+    }
+
+    // The previous approach: repeated start code searches.
+    func testPerformanceRangeOf() {
+        let keyframe = Self.keyframe
+        let startCode = Data(H264Utilities.naluStartCode)
+        measure {
+            for _ in 0..<100 {
+                var ranges: [Range<Data.Index>] = []
+                var startIndex = keyframe.startIndex
+                while let range = keyframe.range(of: startCode, in: startIndex..<keyframe.endIndex) {
+                    ranges.append(range)
+                    startIndex = range.upperBound
+                }
+                XCTAssertEqual(ranges.count, 16)
+            }
+        }
+    }
+}
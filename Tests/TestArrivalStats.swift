@@ -0,0 +1,222 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Foundation
+import Numerics
+import Testing
+@testable import QuicR
+
+// The implementations these replaced, to check against.
+
+private final class ReferenceJitter {
+    private var transit: TimeInterval?
+    private(set) var jitter: TimeInterval = 0
+    private(set) var smoothed: TimeInterval = 0
+
+    func record(timestamp: TimeInterval, arrival: Date) {
+        let transit = arrival.timeIntervalSince1970 - timestamp
+        guard let lastTransit = self.transit else {
+            self.transit = transit
+            return
+        }
+        var d = transit - lastTransit
+        self.transit = transit
+        if d < 0 {
+            d = -d
+        }
+        self.jitter += (1.0 / 16.0) * (d - self.jitter)
+        self.smoothed = 0.1 * self.jitter + 0.9 * self.smoothed
+    }
+}
+
+private final class ReferenceSlidingWindow {
+    private var values: [(timestamp: Date, value: TimeInterval)] = []
+    private let length: TimeInterval
+
+    init(length: TimeInterval) {
+        self.length = length
+    }
+
+    func add(timestamp: Date, value: TimeInterval) {
+        self.values.append((timestamp, value))
+    }
+
+    func get(from: Date) -> [TimeInterval] {
+        while let first = self.values.first, from.timeIntervalSince(first.timestamp) > self.length {
+            self.values.removeFirst()
+        }
+        return self.values.map { $0.value }
+    }
+}
+
+private final class ReferenceWindowMin {
+    private var entries: [HostTimeOffset] = []
+    private let windowLength: TimeInterval
+
+    init(windowLength: TimeInterval) {
+        self.windowLength = windowLength
+    }
+
+    func add(_ timestamp: TimeInterval, when: Ticks) -> HostTimeOffset? {
+        self.entries.append(.init(senderTimestamp: timestamp, receiverHostTime: when))
+        self.entries.removeAll { when.timeIntervalSince($0.receiverHostTime) > self.windowLength }
+        return self.entries.min { lhs, rhs in
+            lhs.receiverHostTime.seconds - lhs.senderTimestamp < rhs.receiverHostTime.seconds - rhs.senderTimestamp
+        }
+    }
+}
+
+/// Without cleanup, which depended on dictionary order.
+private final class ReferenceVariance {
+    private var variances: [TimeInterval: [Date]] = [:]
+    private let expectedOccurrences: Int
+
+    init(expectedOccurrences: Int) {
+        self.expectedOccurrences = expectedOccurrences
+    }
+
+    func calculateSetVariance(timestamp: TimeInterval, now: Date) -> TimeInterval? {
+        guard var times = self.variances[timestamp] else {
+            self.variances[timestamp] = [now]
+            return nil
+        }
+        times.append(now)
+        guard times.count == self.expectedOccurrences else {
+            self.variances[timestamp] = times
+            return nil
+        }
+        self.variances.removeValue(forKey: timestamp)
+        return times.max()!.timeIntervalSince(times.min()!)
+    }
+}
+
+private let seeds: [UInt64] = [1, 2, 3, 42, 1234]
+
+struct TestArrivalStats {
+    @Test("Jitter matches", arguments: seeds)
+    func jitter(seed: UInt64) {
+        var random = SeededGenerator(state: seed)
+        let jitter = RFC3550Jitter(identifier: "test", submitter: nil)
+        let reference = ReferenceJitter()
+        var timestamp = 1_700_000_000.0
+        for _ in 0..<2000 {
+            timestamp += 0.02
+            let arrival = Date(timeIntervalSince1970: timestamp + 0.05 + .random(in: 0...0.03, using: &random))
+            jitter.record(timestamp: timestamp, arrival: arrival)
+            reference.record(timestamp: timestamp, arrival: arrival)
+            #expect(jitter.jitter.isApproximatelyEqual(to: reference.jitter, absoluteTolerance: 1e-12))
+            #expect(jitter.smoothed.isApproximatelyEqual(to: reference.smoothed, absoluteTolerance: 1e-12))
+        }
+    }
+
+    @Test("Sliding window matches", arguments: seeds)
+    func slidingWindow(seed: UInt64) {
+        var random = SeededGenerator(state: seed)
+        let length = Double.random(in: 0.5...3, using: &random)
+        let window = SlidingTimeWindow<TimeInterval>(length: length)
+        let reference = ReferenceSlidingWindow(length: length)
+        var now = Date.now
+        for _ in 0..<5000 {
+            now = now.addingTimeInterval(.random(in: 0...0.05, using: &random))
+            if Int.random(in: 0..<10, using: &random) == 0 {
+                #expect(window.get(from: now) == reference.get(from: now))
+            } else {
+                let value = TimeInterval.random(in: 0...1, using: &random)
+                window.add(timestamp: now, value: value)
+                reference.add(timestamp: now, value: value)
+            }
+        }
+    }
+
+    @Test("Sliding window drops when full")
+    func slidingWindowFull() {
+        let window = SlidingTimeWindow<Int>(length: 10, reserved: 4)
+        let start = Date.now
+        for value in 0..<6 {
+            window.add(timestamp: start, value: value)
+        }
+        #expect(window.get(from: start) == [0, 1, 2, 3])
+        #expect(window.get(from: start.addingTimeInterval(11)) == [])
+        window.add(timestamp: start, value: 4)
+        #expect(window.get(from: start) == [4])
+    }
+
+    @Test("Window min matches", arguments: seeds)
+    func windowMin(seed: UInt64) {
+        var random = SeededGenerator(state: seed)
+        let length = Double.random(in: 0.2...2, using: &random)
+        let window = QWindowMin(capacity: 8192, length: length, secondsPerTick: Ticks(1).seconds)
+        let reference = ReferenceWindowMin(windowLength: length)
+        var when = Ticks.now
+        for _ in 0..<5000 {
+            when += TimeInterval.random(in: 0...0.02, using: &random).ticks
+            // Network delay of up to 100ms, in steps so that ties happen.
+            let timestamp = when.seconds - 0.01 * Double(Int.random(in: 0...10, using: &random))
+            window.push(when, timestamp: timestamp)
+            let expected = reference.add(timestamp, when: when)
+            var receiverHostTime: Ticks = 0
+            var senderTimestamp: TimeInterval = 0
+            #expect(window.min(&receiverHostTime, timestamp: &senderTimestamp))
+            #expect(HostTimeOffset(senderTimestamp: senderTimestamp, receiverHostTime: receiverHostTime) == expected)
+        }
+    }
+
+    @Test("Window min expires")
+    func windowMinExpires() {
+        let window = QWindowMin(capacity: 4, length: 1, secondsPerTick: Ticks(1).seconds)
+        let start = Ticks.now
+        window.push(start, timestamp: start.seconds - 0.01)
+        window.push(start + 0.5.ticks, timestamp: start.seconds + 0.5 - 0.05)
+        window.push(start + 0.9.ticks, timestamp: start.seconds + 0.9 - 0.02)
+        var receiverHostTime: Ticks = 0
+        var senderTimestamp: TimeInterval = 0
+        #expect(window.min(&receiverHostTime, timestamp: &senderTimestamp))
+        #expect(receiverHostTime == start)
+        window.expire(start + 1.2.ticks)
+        #expect(window.count() == 2)
+        #expect(window.min(&receiverHostTime, timestamp: &senderTimestamp))
+        #expect(receiverHostTime == start + 0.9.ticks)
+        window.expire(start + 2.ticks)
+        #expect(!window.min(&receiverHostTime, timestamp: &senderTimestamp))
+    }
+
+    @Test("Set variance matches", arguments: seeds)
+    func setVariance(seed: UInt64) throws {
+        var random = SeededGenerator(state: seed)
+        let expected = Int.random(in: 2...6, using: &random)
+        let max = 10
+        let calculator = try VarianceCalculator(expectedOccurrences: expected, max: max)
+        let reference = ReferenceVariance(expectedOccurrences: expected)
+        var now = Date.now
+        for _ in 0..<5000 {
+            // Never more than `max` in flight, so never cleaned up.
+            let timestamp = TimeInterval(Int.random(in: 0..<max, using: &random))
+            now = now.addingTimeInterval(.random(in: 0...0.01, using: &random))
+            #expect(calculator.calculateSetVariance(timestamp: timestamp, now: now) ==
+                    reference.calculateSetVariance(timestamp: timestamp, now: now))
+        }
+    }
+
+    @Test("Set variance flushes oldest")
+    func setVarianceFlush() {
+        let variances = QSetVariance(expected: 3, max: 4)
+        var variance: TimeInterval = 0
+        for key in 0..<5 {
+            #expect(!variances.record(TimeInterval(key), arrival: TimeInterval(key), variance: &variance))
+            #expect(variances.flushed() == 0)
+        }
+        // More than max in flight: the 3 oldest go before the 4th set's second arrival.
+        #expect(!variances.record(0, arrival: 10, variance: &variance))
+        #expect(variances.flushed() == 3)
+        #expect((0..<3).allSatisfy { variances.flushedCount($0) == 1 && variances.flushedVariance($0) == 0 })
+        #expect(!variances.record(3, arrival: 11, variance: &variance))
+        #expect(variances.record(3, arrival: 12, variance: &variance))
+        #expect(variance == 9)
+    }
+
+    @Test("Single occurrence sets complete immediately")
+    func setVarianceSingle() throws {
+        let calculator = try VarianceCalculator(expectedOccurrences: 1)
+        #expect(calculator.calculateSetVariance(timestamp: 1, now: .now) == 0)
+    }
+}
@@ -0,0 +1,207 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import XCTest
+@testable import QuicR
+
+final class TestAudioJitterEngine: XCTestCase {
+    private static let sampleRate = 48000
+    private static let packetElements = 480
+    private static let concealedValue = Float32(-1)
+
+    private let concealment: PacketCallback = { packets, count, _ in
+        guard let packets else { return }
+        for index in 0..<count {
+            let packet = packets.advanced(by: index).pointee
+            let samples = packet.data.assumingMemoryBound(to: Float32.self)
+            samples.update(repeating: TestAudioJitterEngine.concealedValue, count: packet.elements)
+        }
+    }
+
+    private func makeBuffer(maxMs: UInt = 100, minMs: UInt = 20) -> QJitterBuffer {
+        .init(elementSize: MemoryLayout<Float32>.size,
+              packetElements: Self.packetElements,
+              clockRate: UInt(Self.sampleRate),
+              maxLengthMs: maxMs,
+              minLengthMs: minMs) { _, _, _ in }!
+    }
+
+    private func enqueue(_ buffer: QJitterBuffer, sequence: UInt64) -> Int {
+        var samples = [Float32](repeating: Float32(sequence), count: Self.packetElements)
+        return samples.withUnsafeMutableBytes {
+            let packet = Packet(sequence_number: UInt(sequence),
+                                data: $0.baseAddress,
+                                length: $0.count,
+                                elements: Self.packetElements)
+            return buffer.enqueue(packet, concealmentCallback: self.concealment, userData: nil)
+        }
+    }
+
+    private func dequeue(_ buffer: QJitterBuffer, into samples: inout [Float32]) -> Int {
+        let count = samples.count
+        return samples.withUnsafeMutableBytes {
+            buffer.dequeue($0.baseAddress!.assumingMemoryBound(to: UInt8.self),
+                           destinationLength: $0.count,
+                           elements: count)
+        }
+    }
+
+    func testInOrder() {
+        let buffer = makeBuffer()
+        for sequence in 0..<3 {
+            XCTAssertEqual(enqueue(buffer, sequence: UInt64(sequence)), Self.packetElements)
+        }
+        XCTAssertEqual(buffer.getCurrentDepth(), 30)
+
+        var output = [Float32](repeating: 0, count: Self.packetElements * 3)
+        XCTAssertEqual(dequeue(buffer, into: &output), output.count)
+        for (index, sample) in output.enumerated() {
+            XCTAssertEqual(sample, Float32(index / Self.packetElements))
+        }
+        XCTAssertEqual(buffer.getCurrentDepth(), 0)
+    }
+
+    func testInvalidSizes() {
+        // Fails to create, rather than aborting.
+        XCTAssertNil(QJitterBuffer(elementSize: 0,
+                                   packetElements: Self.packetElements,
+                                   clockRate: UInt(Self.sampleRate),
+                                   maxLengthMs: 100,
+                                   minLengthMs: 20) { _, _, _ in })
+        XCTAssertNil(QJitterBuffer(elementSize: MemoryLayout<Float32>.size,
+                                   packetElements: Self.packetElements,
+                                   clockRate: 0,
+                                   maxLengthMs: 100,
+                                   minLengthMs: 20) { _, _, _ in })
+    }
+
+    func testConcealAndUpdate() {
+        let buffer = makeBuffer(minMs: 0)
+        _ = enqueue(buffer, sequence: 0)
+        _ = enqueue(buffer, sequence: 3)
+        var metrics = buffer.getMetrics()
+        XCTAssertEqual(metrics.concealed_frames, Self.packetElements * 2)
+
+        // 1 arrives in time to replace its concealment, 2 doesn't.
+        XCTAssertEqual(enqueue(buffer, sequence: 1), Self.packetElements)
+        var output = [Float32](repeating: 0, count: Self.packetElements * 4)
+        XCTAssertEqual(dequeue(buffer, into: &output), output.count)
+        XCTAssertEqual(output[Self.packetElements], 1)
+        XCTAssertEqual(output[Self.packetElements * 2], Self.concealedValue)
+        XCTAssertEqual(output[Self.packetElements * 3], 3)
+        XCTAssertEqual(enqueue(buffer, sequence: 2), 0)
+
+        metrics = buffer.getMetrics()
+        XCTAssertEqual(metrics.updated_frames, Self.packetElements)
+        XCTAssertEqual(metrics.update_missed_frames, Self.packetElements)
+    }
+
+    func testPrepare() {
+        let buffer = makeBuffer(minMs: 0)
+        _ = enqueue(buffer, sequence: 0)
+        XCTAssertEqual(buffer.prepare(3, concealmentCallback: self.concealment, userData: nil), Self.packetElements * 2)
+        XCTAssertEqual(buffer.getCurrentDepth(), 30)
+    }
+
+    func testMinimumDepth() {
+        let buffer = makeBuffer(minMs: 30)
+        var output = [Float32](repeating: 0, count: Self.packetElements)
+        _ = enqueue(buffer, sequence: 0)
+        XCTAssertEqual(dequeue(buffer, into: &output), 0)
+        _ = enqueue(buffer, sequence: 1)
+        _ = enqueue(buffer, sequence: 2)
+        XCTAssertEqual(dequeue(buffer, into: &output), output.count)
+    }
+
+    func testDiscontinuity() {
+        let buffer = makeBuffer(minMs: 0)
+        _ = enqueue(buffer, sequence: 0)
+        XCTAssertEqual(enqueue(buffer, sequence: 10_000), Self.packetElements)
+        var output = [Float32](repeating: 0, count: Self.packetElements)
+        XCTAssertEqual(dequeue(buffer, into: &output), output.count)
+        XCTAssertEqual(output[0], 10_000)
+    }
+
+    // Producer and render threads running at once: every sample out must be real or concealed audio.
+    func testConcurrent() {
+        let buffer = makeBuffer(maxMs: 80, minMs: 20)
+        let packets = 5000
+        let corrupt = Mutex(0)
+        DispatchQueue.concurrentPerform(iterations: 2) { thread in
+            if thread == 0 {
+                var generator = SeededGenerator(state: 1)
+                for sequence in 0..<packets {
+                    guard Int.random(in: 0..<20, using: &generator) != 0 else { continue }
+                    _ = enqueue(buffer, sequence: UInt64(sequence))
+                }
+            } else {
+                var output = [Float32](repeating: 0, count: 256)
+                var bad = 0
+                for _ in 0..<packets * 2 {
+                    let copied = dequeue(buffer, into: &output)
+                    bad += output[0..<copied].filter { $0 != Self.concealedValue && ($0 < 0 || $0 >= Float32(packets)) }.count
+                }
+                corrupt.withLock { $0 += bad }
+            }
+        }
+        XCTAssertEqual(corrupt.get(), 0)
+    }
+
+    // Replays a jittery arrival trace against a 10ms render cadence and reports dequeue latency percentiles.
+    func testTraceReplay() {
+        let buffer = makeBuffer(maxMs: 200, minMs: 40)
+        var generator = SeededGenerator(state: 42)
+
+        // 20 seconds of 10ms packets, 30ms +/- exponential jitter, 2% loss.
+        let packetMs = 10.0
+        var arrivals: [(time: Double, sequence: UInt64)] = []
+        for sequence in 0..<2000 {
+            guard Double.random(in: 0..<1, using: &generator) >= 0.02 else { continue }
+            let jitter = -log(1 - Double.random(in: 0..<1, using: &generator)) * 8
+            arrivals.append((Double(sequence) * packetMs + 30 + jitter, UInt64(sequence)))
+        }
+        arrivals.sort { $0.time < $1.time }
+
+        var output = [Float32](repeating: 0, count: Self.packetElements)
+        var latencies: [UInt64] = []
+        latencies.reserveCapacity(2100)
+        var next = arrivals.startIndex
+        var underrun = 0
+        var renderTime = 0.0
+        while renderTime < 20_500 {
+            while next < arrivals.endIndex && arrivals[next].time <= renderTime {
+                _ = enqueue(buffer, sequence: arrivals[next].sequence)
+                next += 1
+            }
+            let start = DispatchTime.now().uptimeNanoseconds
+            let copied = dequeue(buffer, into: &output)
+            latencies.append(DispatchTime.now().uptimeNanoseconds - start)
+            underrun += output.count - copied
+            renderTime += packetMs
+        }
+
+        latencies.sort()
+        func percentile(_ value: Double) -> UInt64 {
+            latencies[min(latencies.count - 1, Int(Double(latencies.count) * value))]
+        }
+        let metrics = buffer.getMetrics()
+        print("Dequeue ns p50: \(percentile(0.5)) p90: \(percentile(0.9)) p99: \(percentile(0.99)) max: \(latencies.last!)")
+        print("Concealed: \(metrics.concealed_frames) skipped: \(metrics.skipped_frames) " +
+              "updated: \(metrics.updated_frames) missed: \(metrics.update_missed_frames) underrun: \(underrun)")
+        XCTAssertGreaterThan(metrics.concealed_frames, 0)
+        XCTAssertLessThan(underrun, Self.packetElements * 200)
+    }
+
+    func testPerformance() {
+        let buffer = makeBuffer(minMs: 0)
+        var output = [Float32](repeating: 0, count: Self.packetElements)
+        var sequence: UInt64 = 0
+        measure {
+            for _ in 0..<1000 {
+                _ = enqueue(buffer, sequence: sequence)
+                _ = dequeue(buffer, into: &output)
+                sequence += 1
+            }
+        }
+    }
+}
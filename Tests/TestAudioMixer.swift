@@ -0,0 +1,222 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import XCTest
+import Synchronization
+@testable import QuicR
+
+private final class Flag: Sendable {
+    private let value = Atomic(false)
+
+    var isSet: Bool { self.value.load(ordering: .acquiring) }
+
+    func set() {
+        self.value.store(true, ordering: .releasing)
+    }
+}
+
+private final class Counter: Sendable {
+    private let value = Atomic(0)
+
+    var count: Int { self.value.load(ordering: .acquiring) }
+
+    func increment() {
+        self.value.wrappingAdd(1, ordering: .releasing)
+    }
+}
+
+final class TestAudioMixer: XCTestCase {
+    // 10ms at 48kHz.
+    private static let frames: UInt32 = 480
+
+    private func render(_ mixer: QAudioMixer, frames: UInt32 = TestAudioMixer.frames) -> (audible: Int, output: [Float32]) {
+        var output = [Float32](repeating: .nan, count: Int(frames))
+        let audible = output.withUnsafeMutableBufferPointer {
+            mixer.render($0.baseAddress!, frames: frames, hostTime: 0)
+        }
+        return (audible, output)
+    }
+
+    private func addConstant(_ mixer: QAudioMixer, value: Float32, limit: UInt32 = .max) -> Int {
+        var source = 0
+        XCTAssertTrue(mixer.addSource({ destination, frames, _ in
+            let written = min(frames, limit)
+            destination.update(repeating: value, count: Int(written))
+            return written
+        }, source: &source))
+        return source
+    }
+
+    func testSumsSources() {
+        let mixer = QAudioMixer(capacity: 4, maxFrames: 256)
+        _ = self.addConstant(mixer, value: 0.25)
+        // A partial source is silent after what it wrote, in each pull.
+        let partial = self.addConstant(mixer, value: 0.5, limit: 100)
+        let (audible, output) = self.render(mixer)
+        XCTAssertEqual(audible, 2)
+        for (index, sample) in output.enumerated() {
+            XCTAssertEqual(sample, index % 256 < 100 ? 0.75 : 0.25, accuracy: 1e-6, "\(index)")
+        }
+        XCTAssertEqual(mixer.level(forSource: partial).peak, 0.5, accuracy: 1e-6)
+    }
+
+    func testGainRampsAndMute() {
+        let mixer = QAudioMixer(capacity: 4, maxFrames: 512)
+        let source = self.addConstant(mixer, value: 0.5)
+
+        // Gain changes ramp over one render, then hold.
+        mixer.setGain(2, forSource: source)
+        let ramped = self.render(mixer).output
+        XCTAssertEqual(ramped.first!, 0.5, accuracy: 1e-6)
+        XCTAssertEqual(ramped.last!, 1, accuracy: 0.01)
+        XCTAssertTrue(zip(ramped, ramped.dropFirst()).allSatisfy { $0 <= $1 })
+        XCTAssertEqual(self.render(mixer).output, .init(repeating: 1, count: Int(Self.frames)))
+
+        // Muting ramps to silence, but still consumes and measures the source.
+        mixer.setMuted(true, forSource: source)
+        _ = self.render(mixer)
+        let (audible, output) = self.render(mixer)
+        XCTAssertEqual(audible, 0)
+        XCTAssertEqual(output, .init(repeating: 0, count: Int(Self.frames)))
+        XCTAssertEqual(mixer.level(forSource: source).rms, 0.5, accuracy: 1e-6)
+    }
+
+    func testPartialGainRamp() {
+        let mixer = QAudioMixer(capacity: 4, maxFrames: 512)
+        let source = self.addConstant(mixer, value: 0.5, limit: Self.frames / 2)
+
+        // Half a render ramps half way, and the next carries on from there rather than jumping to the gain.
+        mixer.setGain(2, forSource: source)
+        let first = self.render(mixer).output
+        let second = self.render(mixer).output
+        let half = Int(Self.frames / 2)
+        XCTAssertEqual(first[half - 1], 0.75, accuracy: 0.01)
+        XCTAssertEqual(second.first!, first[half - 1], accuracy: 0.01)
+        XCTAssertTrue(zip(second, second.dropFirst()).prefix(half - 1).allSatisfy { $0 <= $1 })
+    }
+
+    func testClipping() {
+        let mixer = QAudioMixer(capacity: 4, maxFrames: 512)
+        _ = self.addConstant(mixer, value: 0.75)
+        _ = self.addConstant(mixer, value: 0.75)
+        let negative = self.addConstant(mixer, value: -0.5)
+        mixer.setGain(6, forSource: negative)
+        _ = self.render(mixer)
+        let output = self.render(mixer).output
+        XCTAssertEqual(output, .init(repeating: -1, count: Int(Self.frames)))
+        XCTAssertGreaterThanOrEqual(mixer.clippedSamples(), UInt64(Self.frames))
+    }
+
+    func testOddSizes() {
+        let mixer = QAudioMixer(capacity: 4, maxFrames: 64)
+        _ = self.addConstant(mixer, value: 0.1)
+        for frames: UInt32 in [1, 3, 7, 63, 65, 1023] {
+            XCTAssertEqual(self.render(mixer, frames: frames).output,
+                           .init(repeating: 0.1, count: Int(frames)),
+                           "\(frames)")
+        }
+    }
+
+    func testCapacityAndReuse() {
+        let mixer = QAudioMixer(capacity: 2, maxFrames: 64)
+        let first = self.addConstant(mixer, value: 0.1)
+        _ = self.addConstant(mixer, value: 0.2)
+        var source = 0
+        XCTAssertFalse(mixer.addSource({ _, _, _ in 0 }, source: &source))
+        mixer.removeSource(first)
+        XCTAssertEqual(self.addConstant(mixer, value: 0.3), first)
+        XCTAssertEqual(self.render(mixer, frames: 8).output.first!, 0.5, accuracy: 1e-6)
+    }
+
+    func testRemoveDuringRender() async {
+        let mixer = QAudioMixer(capacity: 8, maxFrames: 512)
+        let stopped = Flag()
+        let calledAfterRemoval = Flag()
+        await withTaskGroup(of: Void.self) { group in
+            group.addTask {
+                var output = [Float32](repeating: 0, count: Int(Self.frames))
+                while !stopped.isSet {
+                    output.withUnsafeMutableBufferPointer {
+                        _ = mixer.render($0.baseAddress!, frames: Self.frames, hostTime: 0)
+                    }
+                }
+            }
+            group.addTask {
+                for _ in 0..<2_000 {
+                    let removed = Flag()
+                    var source = 0
+                    _ = mixer.addSource({ destination, frames, _ in
+                        if removed.isSet {
+                            calledAfterRemoval.set()
+                        }
+                        destination.update(repeating: 0.1, count: Int(frames))
+                        return frames
+                    }, source: &source)
+                    mixer.removeSource(source)
+                    removed.set()
+                }
+                stopped.set()
+            }
+        }
+        XCTAssertFalse(calledAfterRemoval.isSet)
+    }
+
+    func testRemoveFromRender() {
+        let mixer = QAudioMixer(capacity: 4, maxFrames: 256)
+        let pulls = Counter()
+        var source = 0
+        XCTAssertTrue(mixer.addSource({ [unowned mixer] destination, frames, _ in
+            pulls.increment()
+            // Removing itself, the first source added, mustn't wait on the pull it's in.
+            mixer.removeSource(0)
+            destination.update(repeating: 0.5, count: Int(frames))
+            return frames
+        }, source: &source))
+        XCTAssertEqual(source, 0)
+
+        // That pull still plays, but there are no more, even later in the same render.
+        let (audible, output) = self.render(mixer)
+        XCTAssertEqual(audible, 1)
+        XCTAssertEqual(output[255], 0.5, accuracy: 1e-6)
+        XCTAssertEqual(output[256], 0)
+        XCTAssertEqual(self.render(mixer).audible, 0)
+        XCTAssertEqual(pulls.count, 1)
+    }
+
+    /// Nanoseconds to mix one 10ms frame as the number of sources grows.
+    func testScaling() {
+        let clock = ContinuousClock()
+        var output = [Float32](repeating: 0, count: Int(Self.frames))
+        for sources in [1, 4, 16, 64] {
+            let mixer = QAudioMixer(capacity: 64, maxFrames: Self.frames)
+            for index in 0..<sources {
+                _ = self.addConstant(mixer, value: Float32(index) / 1000)
+            }
+            let iterations = 2_000
+            let elapsed = clock.measure {
+                output.withUnsafeMutableBufferPointer {
+                    for _ in 0..<iterations {
+                        _ = mixer.render($0.baseAddress!, frames: Self.frames, hostTime: 0)
+                    }
+                }
+            }
+            let nanoseconds = Double(elapsed.components.attoseconds) / 1e9 + Double(elapsed.components.seconds) * 1e9
+            print("Mixing \(sources) sources: \(Int(nanoseconds / Double(iterations)))ns per frame")
+        }
+    }
+
+    func testPerformanceMix32() {
+        let mixer = QAudioMixer(capacity: 64, maxFrames: Self.frames)
+        for index in 0..<32 {
+            _ = self.addConstant(mixer, value: Float32(index) / 1000)
+        }
+        var output = [Float32](repeating: 0, count: Int(Self.frames))
+        measure {
+            output.withUnsafeMutableBufferPointer {
+                for _ in 0..<1_000 {
+                    _ = mixer.render($0.baseAddress!, frames: Self.frames, hostTime: 0)
+                }
+            }
+        }
+    }
+}
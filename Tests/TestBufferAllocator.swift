@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import CoreMedia
+import XCTest
+@testable import QuicR
+
+final class TestBufferAllocator: XCTestCase {
+    func testHeaderPrepend() throws {
+        let allocator = BufferAllocator(1024, hdrSize: 64, slots: 2)
+        let frame = try XCTUnwrap(allocator.iosAllocBuffer(100))
+        frame.initializeMemory(as: UInt8.self, repeating: 0xAA, count: 100)
+
+        let first = try XCTUnwrap(allocator.allocateBufferHeader(10, buffer: frame))
+        first.initializeMemory(as: UInt8.self, repeating: 0x01, count: 10)
+        let second = try XCTUnwrap(allocator.allocateBufferHeader(20, buffer: frame))
+        second.initializeMemory(as: UInt8.self, repeating: 0x02, count: 20)
+        XCTAssertEqual(first, frame - 10)
+        XCTAssertEqual(second, frame - 30)
+        XCTAssertNil(allocator.allocateBufferHeader(40, buffer: frame))
+
+        var full: UnsafeMutableRawPointer?
+        var length = 0
+        allocator.retrieveFullBufferPointer(frame, full: &full, len: &length)
+        XCTAssertEqual(full, second)
+        XCTAssertEqual(length, 130)
+        let bytes = Data(bytes: try XCTUnwrap(full), count: length)
+        XCTAssertEqual(bytes, Data(repeating: 0x02, count: 20) + Data(repeating: 0x01, count: 10) + Data(repeating: 0xAA, count: 100))
+
+        // A reused slot starts with no headers.
+        allocator.iosDeallocBuffer(frame)
+        let reused = try XCTUnwrap(allocator.iosAllocBuffer(10))
+        allocator.retrieveFullBufferPointer(reused, full: &full, len: &length)
+        XCTAssertEqual(full, reused)
+        XCTAssertEqual(length, 10)
+        allocator.iosDeallocBuffer(reused)
+    }
+
+    func testSlotsAndCounters() throws {
+        let allocator = BufferAllocator(1024, hdrSize: 64, slots: 3)
+        XCTAssertNil(allocator.iosAllocBuffer(2048))
+
+        var frames: [UnsafeMutableRawPointer] = []
+        for _ in 0..<3 {
+            frames.append(try XCTUnwrap(allocator.iosAllocBuffer(512)))
+        }
+        XCTAssertEqual(Set(frames).count, 3)
+        XCTAssertNil(allocator.iosAllocBuffer(512))
+
+        var stats = allocator.stats()
+        XCTAssertEqual(stats.slots, 3)
+        XCTAssertEqual(stats.inUse, 3)
+        XCTAssertEqual(stats.highWaterMark, 3)
+        XCTAssertEqual(stats.allocations, 3)
+        XCTAssertEqual(stats.failures, 2)
+
+        // Refcounted: the slot is only freed on the last release.
+        allocator.iosRetainBuffer(frames[0])
+        allocator.iosDeallocBuffer(frames[0])
+        XCTAssertEqual(allocator.stats().inUse, 3)
+        for frame in frames {
+            allocator.iosDeallocBuffer(frame)
+        }
+        stats = allocator.stats()
+        XCTAssertEqual(stats.inUse, 0)
+        XCTAssertEqual(stats.highWaterMark, 3)
+
+        // Foreign pointers are ignored.
+        var foreign: UInt8 = 0
+        allocator.iosDeallocBuffer(&foreign)
+        XCTAssertEqual(allocator.stats().inUse, 0)
+    }
+
+    func testBlockBufferReleasesSlot() throws {
+        let allocator = BufferAllocator(1024, hdrSize: 64, slots: 1)
+        let frame = try XCTUnwrap(allocator.iosAllocBuffer(16))
+        var buffer: CMBlockBuffer? = try .init(buffer: .init(start: frame, count: 16)) { [allocator] buffer, _ in
+            allocator.iosDeallocBuffer(buffer.baseAddress)
+        }
+        XCTAssertNotNil(buffer)
+        XCTAssertEqual(allocator.stats().inUse, 1)
+        buffer = nil
+        XCTAssertEqual(allocator.stats().inUse, 0)
+    }
+
+    func testAllocatorOutlivesWrapper() throws {
+        var wrapper: BufferAllocator? = BufferAllocator(1024, hdrSize: 64, slots: 1)
+        let allocator = try XCTUnwrap(wrapper).allocator().takeUnretainedValue()
+        let memory = try XCTUnwrap(CFAllocatorAllocate(allocator, 512, 0))
+        memory.initializeMemory(as: UInt8.self, repeating: 0xAA, count: 512)
+
+        // Whatever still holds the CFAllocator keeps its slots alive.
+        wrapper = nil
+        CFAllocatorDeallocate(allocator, memory)
+        let reused = try XCTUnwrap(CFAllocatorAllocate(allocator, 512, 0))
+        XCTAssertEqual(reused, memory)
+        CFAllocatorDeallocate(allocator, reused)
+    }
+
+    func testTwoThreadStress() async {
+        let slots = 8
+        let iterations = 20_000
+        let allocator = BufferAllocator(256, hdrSize: 16, slots: slots)
+        let (stream, continuation) = AsyncStream<UInt>.makeStream()
+
+        // Consumer frees on a different thread than the producer allocates.
+        let consumer = Task.detached {
+            var corrupt = 0
+            for await address in stream {
+                let frame = UnsafeMutableRawPointer(bitPattern: address)!
+                let bytes = frame.assumingMemoryBound(to: UInt8.self)
+                let header = (frame - 4).assumingMemoryBound(to: UInt8.self)
+                if bytes[0] != bytes[255] || header[0] != bytes[0] {
+                    corrupt += 1
+                }
+                allocator.iosDeallocBuffer(frame)
+            }
+            return corrupt
+        }
+
+        let producer = Task.detached {
+            for iteration in 0..<iterations {
+                var frame = allocator.iosAllocBuffer(256)
+                while frame == nil {
+                    await Task.yield()
+                    frame = allocator.iosAllocBuffer(256)
+                }
+                let value = UInt8(truncatingIfNeeded: iteration)
+                frame!.initializeMemory(as: UInt8.self, repeating: value, count: 256)
+                allocator.allocateBufferHeader(4, buffer: frame!)!.initializeMemory(as: UInt8.self, repeating: value, count: 4)
+                continuation.yield(UInt(bitPattern: frame!))
+            }
+            continuation.finish()
+        }
+
+        await producer.value
+        let corrupt = await consumer.value
+        let stats = allocator.stats()
+        XCTAssertEqual(corrupt, 0)
+        XCTAssertEqual(stats.inUse, 0)
+        XCTAssertEqual(stats.allocations, UInt64(iterations))
+        XCTAssertLessThanOrEqual(stats.highWaterMark, slots)
+    }
+}
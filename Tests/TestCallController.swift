@@ -11,12 +11,64 @@ final class TestFullTrackName: XCTestCase {
         // QFullTrackName.
         let namespace = "namespace"
         let name = "name"
-        let qftn = QFullTrackNameImpl()
-        qftn.nameSpace = [namespace.data(using: .utf8)!]
-        qftn.name = name.data(using: .utf8)!
+        let qftn = QFullTrackNameImpl.intern(nameSpace: [namespace.data(using: .utf8)!], name: name.data(using: .utf8)!)
         let swift = FullTrackName(qftn as QFullTrackName)
         XCTAssertEqual(swift.name, qftn.name)
         XCTAssertEqual(swift.nameSpace, qftn.nameSpace)
+        XCTAssertEqual(swift.trackId, qftn.trackId)
+        XCTAssertEqual(swift, try FullTrackName(namespace: [namespace], name: name))
+    }
+
+    /// Every representation of a name shares one identifier and one Objective-C instance.
+    func testInterning() throws {
+        let first = try FullTrackName(namespace: ["intern", "a"], name: "b")
+        let second = try FullTrackName(serialized: first.description)
+        XCTAssertNotEqual(first.trackId, 0)
+        XCTAssertEqual(first.trackId, second.trackId)
+        XCTAssertEqual(first, second)
+        XCTAssertEqual(first.hashValue, second.hashValue)
+        XCTAssertTrue(QFullTrackNameImpl.intern(nameSpace: first.nameSpace, name: first.name)
+                        === QFullTrackNameImpl.intern(nameSpace: second.nameSpace, name: second.name))
+
+        // Moving bytes between the namespace and name makes a different name.
+        let shifted = try FullTrackName(namespace: ["intern", "ab"], name: "")
+        let joined = try FullTrackName(namespace: ["interna"], name: "b")
+        XCTAssertNotEqual(first, shifted)
+        XCTAssertNotEqual(first, joined)
+        XCTAssertNotEqual(shifted.trackId, joined.trackId)
+    }
+
+    /// Concurrent interning of the same names agrees on identifiers.
+    func testConcurrentInterning() async throws {
+        let names = (0..<500).map { "concurrent\($0)" }
+        let results = await withTaskGroup(of: [UInt64].self) { group in
+            for _ in 0..<8 {
+                group.addTask {
+                    names.map { FullTrackName(nameSpace: [Data("intern".utf8)], name: Data($0.utf8)).trackId }
+                }
+            }
+            return await group.reduce(into: []) { $0.append($1) }
+        }
+        XCTAssertEqual(Set(results.first!).count, names.count)
+        for result in results {
+            XCTAssertEqual(result, results.first)
+        }
+    }
+
+    /// Lookups keyed by name, as subscription sets do per object.
+    func testPerformanceLookup() throws {
+        let names = try (0..<100).map { try FullTrackName(namespace: ["moq://example.com/conference/12345", "video"],
+                                                          name: "participant\($0)") }
+        let table = Dictionary(uniqueKeysWithValues: names.enumerated().map { ($1, $0) })
+        measure {
+            var total = 0
+            for _ in 0..<1_000 {
+                for name in names {
+                    total &+= table[name]!
+                }
+            }
+            XCTAssertEqual(total, 1_000 * 4950)
+        }
     }
 
     /// RFC Section 1.5 example: example.net/team2/project_x track=report.
@@ -37,7 +89,7 @@ final class TestFullTrackName: XCTestCase {
         let ns1 = Data([0x00, 0xFF, 0x80])
         let ns2 = Data([0x61, 0x62]) // "ab"
         let name = Data([0x01, 0x02])
-        let ftn = FullTrackName(QFullTrackNameImpl(namespace: [ns1, ns2], name: name))
+        let ftn = FullTrackName(nameSpace: [ns1, ns2], name: name)
         XCTAssertEqual(ftn.description, ".00.ff.80-ab--.01.02")
         let parsed = try FullTrackName(serialized: ftn.description)
         XCTAssertEqual(ftn, parsed)
@@ -444,6 +496,48 @@ final class TestCallController: XCTestCase {
         XCTAssert(self.assertFtnEquality(ftns2, rhs: [ftn1, ftn2]))
     }
 
+    func testSubscribeToSets() async throws {
+        let details = (0..<20).map { index in
+            ManifestSubscription(mediaType: "video",
+                                 sourceName: "test",
+                                 sourceID: "\(index)",
+                                 label: "testLabel",
+                                 participantId: .init(UInt32(index)),
+                                 profileSet: .init(type: "video",
+                                                   profiles: (0..<2).map {
+                                                    .init(qualityProfile: "h264",
+                                                          expiry: nil,
+                                                          priorities: nil,
+                                                          namespace: ["\(index)", "\($0)"])
+                                                   }))
+        }
+
+        // Create controller.
+        var subscribed: [QFullTrackName] = []
+        let client = MockClient(publish: { _ in },
+                                unpublish: { _ in },
+                                subscribe: { subscribed.append($0.getFullTrackName()) },
+                                unsubscribe: { _ in },
+                                fetch: { _ in },
+                                fetchCancel: { _ in })
+        let controller = MoqCallController(endpointUri: "1", client: client, submitter: nil) { }
+        try await controller.connect()
+
+        // Every set should be created, in order, and tracked.
+        let results = try controller.subscribeToSets(details, factory: MockSubscriptionFactory { _ in })
+        XCTAssertEqual(try results.map { try $0.get().sourceId }, details.map { $0.sourceID })
+        XCTAssertEqual(Set(controller.getSubscriptionSets().map { $0.sourceId }), Set(details.map { $0.sourceID }))
+        for result in results {
+            XCTAssertEqual(try result.get().getHandlers().count, 2)
+        }
+
+        // Every track should be subscribed to, once.
+        let expected: [QFullTrackName] = try details.flatMap { details in
+            try details.profileSet.profiles.map { try FullTrackName(namespace: $0.namespace, name: "") }
+        }
+        XCTAssert(self.assertFtnEquality(subscribed, rhs: expected))
+    }
+
     func testSubscribeNamespaceHandlerAlter() async throws {
         let publish: MockClient.PublishTrackCallback = { _ in }
         let unpublish: MockClient.PublishTrackCallback = { _ in }
@@ -0,0 +1,199 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Foundation
+import MSF
+import Testing
+@testable import QuicR
+
+struct TestCatalogIndex {
+    private struct Track: CatalogTrack {
+        let namespace: [String]?
+        let name: String
+        var bitrate: Int?
+
+        static func tuples(of namespace: [String]) -> [String] {
+            namespace
+        }
+    }
+
+    private func track(_ prefix: String, _ participant: Int, bitrate: Int? = nil) -> Track {
+        .init(namespace: ["nab", prefix, "\(participant)"], name: "video", bitrate: bitrate)
+    }
+
+    private func removal(_ track: Track) -> CatalogPatch<Track>.Removal {
+        .init(namespace: track.namespace, name: track.name)
+    }
+
+    @Test("Full catalogs report only prefixes appearing and disappearing")
+    func full() {
+        var index = CatalogIndex<Track>()
+        var changes = index.apply(.full([self.track("b", 1), self.track("a", 2), self.track("a", 1)]))
+        // In catalog order.
+        #expect(Array(changes.added.keys) == [["nab", "b"], ["nab", "a"]])
+        #expect(changes.added[["nab", "a"]] == [self.track("a", 2), self.track("a", 1)])
+        #expect(index.tracks(prefix: ["nab", "a"]) == [self.track("a", 2), self.track("a", 1)])
+        #expect(changes.removed.isEmpty)
+        #expect(index.count == 3)
+        #expect(index.prefixCount == 2)
+
+        // The same again is nothing.
+        changes = index.apply(.full([self.track("a", 1), self.track("a", 2), self.track("b", 1)]))
+        #expect(changes.isEmpty)
+
+        // Tracks coming and going under a prefix that stays, or changing, aren't prefixes changing.
+        changes = index.apply(.full([self.track("a", 2), self.track("a", 3), self.track("b", 1, bitrate: 1000)]))
+        #expect(changes.isEmpty)
+        #expect(index.tracks(prefix: ["nab", "b"]).first?.bitrate == 1000)
+
+        // Losing every track of a prefix removes it.
+        changes = index.apply(.full([self.track("b", 1)]))
+        #expect(changes.added.isEmpty)
+        #expect(changes.removed == [["nab", "a"]])
+        #expect(index.count == 1)
+        #expect(index.tracks(prefix: ["nab", "a"]).isEmpty)
+    }
+
+    @Test("Published tracks match exactly, else by prefix")
+    func lookup() {
+        var index = CatalogIndex<Track>()
+        _ = index.apply(.full([self.track("a", 1, bitrate: 1), self.track("a", 2, bitrate: 2)]))
+        #expect(index.track(namespace: ["nab", "a", "2"], name: "video")?.bitrate == 2)
+        #expect(index.track(namespace: ["nab", "a", "1"], name: "video")?.bitrate == 1)
+        // Someone not in the catalog, publishing under a known prefix, gets its first track.
+        #expect(index.track(namespace: ["nab", "a", "3"], name: "video")?.bitrate == 1)
+        #expect(index.track(namespace: ["nab", "a", "2"], name: "audio")?.bitrate == 1)
+        #expect(index.track(namespace: ["nab", "b", "1"], name: "video") == nil)
+    }
+
+    @Test("Deltas add and remove tracks")
+    func delta() {
+        var index = CatalogIndex<Track>()
+        _ = index.apply(.full([self.track("a", 1)]))
+        var changes = index.apply(.delta(add: [self.track("a", 2), self.track("b", 1)], remove: []))
+        #expect(Array(changes.added.keys) == [["nab", "b"]])
+        #expect(changes.removed.isEmpty)
+        #expect(index.count == 3)
+
+        changes = index.apply(.delta(add: [], remove: [self.removal(self.track("a", 1)), self.removal(self.track("a", 2))]))
+        #expect(changes.added.isEmpty)
+        #expect(changes.removed == [["nab", "a"]])
+
+        // Removing what isn't there, and tracks without a namespace, are ignored.
+        changes = index.apply(.delta(add: [.init(namespace: nil, name: "video")],
+                                     remove: [self.removal(self.track("c", 1)), .init(namespace: nil, name: "video")]))
+        #expect(changes.isEmpty)
+        #expect(index.count == 1)
+    }
+
+    @Test("A prefix that comes and goes within one update is no change")
+    func transient() {
+        var index = CatalogIndex<Track>()
+        _ = index.apply(.full([self.track("a", 1)]))
+        // Replaced by another participant's track.
+        var changes = index.apply(.delta(add: [self.track("a", 2)], remove: [self.removal(self.track("a", 1))]))
+        #expect(changes.isEmpty)
+        // Removed, then added back.
+        changes = index.apply(.full([self.track("a", 3)]))
+        #expect(changes.isEmpty)
+        #expect(index.tracks(prefix: ["nab", "a"]) == [self.track("a", 3)])
+    }
+
+    @Test("Patches are parsed as full catalogs or deltas")
+    func parse() throws {
+        let full = """
+        {"version": 1, "tracks": [{"namespace": ["nab", "a", "1"], "name": "video"}]}
+        """
+        guard case .full(let tracks) = try JSONDecoder().decode(CatalogPatch<Track>.self, from: Data(full.utf8)) else {
+            Issue.record("Expected a full catalog")
+            return
+        }
+        #expect(tracks == [self.track("a", 1)])
+
+        let delta = """
+        {"version": 1, "deltaUpdate": true,
+         "addTracks": [{"namespace": ["nab", "a", "2"], "name": "video"}],
+         "removeTracks": [{"namespace": ["nab", "a", "1"], "name": "video"}]}
+        """
+        let patch = try JSONDecoder().decode(CatalogPatch<Track>.self, from: Data(delta.utf8))
+        guard case .delta(let add, let remove) = patch else {
+            Issue.record("Expected a delta")
+            return
+        }
+        #expect(add == [self.track("a", 2)])
+        #expect(remove.map(\.namespace) == [["nab", "a", "1"]])
+        #expect(remove.map(\.name) == ["video"])
+
+        let onlyAdds = """
+        {"deltaUpdate": true, "addTracks": []}
+        """
+        guard case .delta([], []) = try JSONDecoder().decode(CatalogPatch<Track>.self, from: Data(onlyAdds.utf8)) else {
+            Issue.record("Expected an empty delta")
+            return
+        }
+    }
+
+    @Test("Catalog removals need only a namespace and name")
+    func parseRemoval() throws {
+        // Nothing else an MSF track requires.
+        let delta = """
+        {"version": 1, "deltaUpdate": true, "removeTracks": [{"name": "video"}]}
+        """
+        let patch = try JSONDecoder().decode(CatalogPatch<MSF.Track>.self, from: Data(delta.utf8))
+        guard case .delta(let add, let remove) = patch else {
+            Issue.record("Expected a delta")
+            return
+        }
+        #expect(add.isEmpty)
+        #expect(remove.count == 1)
+        #expect(remove.first?.name == "video")
+        #expect(remove.first?.namespace == nil)
+    }
+
+    /// A large broadcast catalog with participants joining and leaving: each update as a delta, against the same
+    /// update as a whole catalog diffed against the last.
+    @Test("Updates", arguments: [1_000, 10_000])
+    func updates(tracks: Int) {
+        let prefixes = 100
+        let updates = 500
+        var generator = SeededGenerator(state: 42)
+        var live = (0..<tracks).map { self.track("\($0 % prefixes)", $0) }
+        var next = tracks
+        var deltaIndex = CatalogIndex<Track>()
+        var fullIndex = CatalogIndex<Track>()
+        _ = deltaIndex.apply(.full(live))
+        _ = fullIndex.apply(.full(live))
+
+        var deltaTime: TimeInterval = 0
+        var fullTime: TimeInterval = 0
+        var changed = 0
+        for _ in 0..<updates {
+            // A few leave, and a few join.
+            var removed: [Track] = []
+            for _ in 0..<Int.random(in: 0...4, using: &generator) where !live.isEmpty {
+                removed.append(live.remove(at: Int.random(in: 0..<live.count, using: &generator)))
+            }
+            let added = (0..<Int.random(in: 0...4, using: &generator)).map { _ in
+                defer { next += 1 }
+                return self.track("\(Int.random(in: 0..<prefixes + 10, using: &generator))", next)
+            }
+            live.append(contentsOf: added)
+
+            var start = Ticks.now
+            let deltaChanges = deltaIndex.apply(.delta(add: added, remove: removed.map(self.removal)))
+            deltaTime += Ticks.now.timeIntervalSince(start)
+            start = Ticks.now
+            let fullChanges = fullIndex.apply(.full(live))
+            fullTime += Ticks.now.timeIntervalSince(start)
+
+            #expect(deltaChanges.removed == fullChanges.removed)
+            #expect(Set(deltaChanges.added.keys) == Set(fullChanges.added.keys))
+            changed += deltaChanges.added.count + deltaChanges.removed.count
+        }
+        #expect(deltaIndex.count == live.count)
+        #expect(fullIndex.count == live.count)
+        print("Catalog, \(tracks) tracks, \(updates) updates: \(changed) prefix changes, " +
+              "\(deltaTime / Double(updates) * 1_000_000)µs per delta, " +
+              "\(fullTime / Double(updates) * 1_000_000)µs per full catalog")
+    }
+}
@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Foundation
+import Synchronization
+import Testing
+@testable import QuicR
+
+/// Stands in for a media handler with a fixed frame interval.
+private final class SyntheticHandler: DequeueSchedulable, @unchecked Sendable {
+    let dequeueIdentifier: String
+    private let interval: TimeInterval
+    private var deadline: Ticks
+    // Seconds each frame was processed after its deadline, negative if early.
+    let slips = Mutex<[TimeInterval]>([])
+
+    init(identifier: String, interval: TimeInterval, start: Ticks) {
+        self.dequeueIdentifier = identifier
+        self.interval = interval
+        self.deadline = start
+    }
+
+    func calculateNextDeadline(from: Ticks) -> Ticks? {
+        self.deadline
+    }
+
+    func processFrame(at: Ticks) throws -> Bool {
+        let slip = at.timeIntervalSince(self.deadline)
+        self.slips.withLock { $0.append(slip) }
+        self.deadline = self.deadline.addingTimeInterval(self.interval)
+        return true
+    }
+}
+
+private final class Runs: Sendable {
+    let count = Mutex(0)
+}
+
+@Suite("Deadline scheduler", .serialized)
+struct DeadlineSchedulerTests {
+    /// Wait for a condition, with a timeout generous enough for a loaded test machine.
+    private func wait(timeout: TimeInterval = 5, for condition: () -> Bool) async throws -> Bool {
+        let start = Ticks.now
+        while !condition() {
+            guard Ticks.now.timeIntervalSince(start) < timeout else { return false }
+            try await Task.sleep(for: .milliseconds(1))
+        }
+        return true
+    }
+
+    @Test("Stops a job that returns nil")
+    func stops() async throws {
+        let scheduler = DeadlineScheduler(label: "test")
+        let runs = Runs()
+        scheduler.schedule { _ in
+            runs.count.withLock { runs in
+                runs += 1
+                return runs < 3 ? 0.001 : nil
+            }
+        }
+        #expect(try await self.wait { runs.count.get() >= 3 })
+        try await Task.sleep(for: .milliseconds(50))
+        #expect(runs.count.get() == 3)
+    }
+
+    @Test("Cancelled jobs don't run again")
+    func cancels() async throws {
+        let scheduler = DeadlineScheduler(label: "test")
+        let runs = Runs()
+        // Long enough between runs that cancelling promptly after the first always beats the second.
+        let token = scheduler.schedule { _ in
+            runs.count.withLock { $0 += 1 }
+            return 0.2
+        }
+        #expect(try await self.wait { runs.count.get() >= 1 })
+        scheduler.cancel(token)
+        try await Task.sleep(for: .milliseconds(400))
+        #expect(runs.count.get() == 1)
+    }
+
+    @Test("Rescheduled jobs run sooner, but never later")
+    func reschedules() async throws {
+        let scheduler = DeadlineScheduler(label: "test")
+        let runs = Runs()
+        let token = scheduler.schedule { _ in
+            runs.count.withLock { $0 += 1 }
+            return 60
+        }
+        #expect(try await self.wait { runs.count.get() >= 1 })
+        scheduler.reschedule(token, by: .now.addingTimeInterval(120))
+        scheduler.reschedule(token, by: .now.addingTimeInterval(0.01))
+        // Well before the job would otherwise next run.
+        #expect(try await self.wait(timeout: 10) { runs.count.get() >= 2 })
+        #expect(runs.count.get() == 2)
+    }
+
+    /// Simulates a call's worth of handlers on one playout clock, measuring wakeups per second and deadline slip.
+    @Test("Coalesces many handlers' wakeups", arguments: [UInt64(1), 2, 3])
+    func simulation(seed: UInt64) async throws {
+        var random = SeededGenerator(state: seed)
+        let tolerance: TimeInterval = 0.002
+        let scheduler = DeadlineScheduler(label: "simulation", tolerance: tolerance)
+        let coordinator = VideoDequeueCoordinator(scheduler: scheduler)
+
+        // 8 participants, each with 30fps video and 20ms audio, at random phases.
+        let start = Ticks.now.addingTimeInterval(0.01)
+        var handlers: [SyntheticHandler] = []
+        for participant in 0..<8 {
+            for (kind, interval) in [("video", 1.0 / 30), ("audio", 0.02)] {
+                let phase = TimeInterval.random(in: 0..<interval, using: &random)
+                handlers.append(.init(identifier: "\(kind) \(participant)",
+                                      interval: interval,
+                                      start: start.addingTimeInterval(phase)))
+            }
+        }
+        for handler in handlers {
+            coordinator.register(handler)
+        }
+
+        let duration: TimeInterval = 1
+        let before = scheduler.wakeups
+        try await Task.sleep(for: .seconds(duration))
+        for handler in handlers {
+            coordinator.unregister(handler.dequeueIdentifier)
+        }
+        let wakeups = TimeInterval(scheduler.wakeups - before) / duration
+        let slips = handlers.flatMap { $0.slips.get() }
+        let frames = TimeInterval(slips.count) / duration
+        let meanSlip = slips.reduce(0, +) / TimeInterval(max(slips.count, 1))
+        print("Wakeups/s: \(wakeups), frames/s: \(frames), mean slip: \(meanSlip * 1000)ms")
+
+        // One wakeup serves several handlers.
+        #expect(frames > 0)
+        #expect(wakeups < frames)
+        // Never earlier than the tolerance allows (and a tick for rounding), and not late on average.
+        #expect(slips.allSatisfy { $0 >= -tolerance - 0.0001 })
+        #expect(meanSlip < 0.005)
+    }
+}
@@ -0,0 +1,368 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Foundation
+import Synchronization
+import Testing
+@testable import QuicR
+
+private struct SimulatedObject: Equatable {
+    let track: Int
+    let groupId: UInt64
+    let objectId: UInt64
+    let bytes: Int
+    let created: Ticks
+}
+
+private struct Handoff: Equatable {
+    let object: SimulatedObject
+    let sent: Ticks
+
+    var delay: TimeInterval {
+        self.sent.timeIntervalSince(self.object.created)
+    }
+}
+
+/// Stands in for a publication: audio objects each in their own group, video in groups from a key frame.
+private struct SimulatedSource {
+    let track: Int
+    let egressClass: EgressClass
+    let bitrate: UInt32
+    let interval: TimeInterval
+    let keyFrameInterval: TimeInterval?
+    let keyFrameBytes: Int
+    var target: UInt32
+    var next: Ticks
+    var lastKeyFrame: Ticks
+    var groupId: UInt64 = 0
+    var objectId: UInt64 = 0
+    var forceKeyFrame = false
+
+    init(track: Int,
+         egressClass: EgressClass,
+         bitrate: UInt32,
+         fps: Double,
+         keyFrameInterval: TimeInterval?,
+         keyFrameBytes: Int,
+         start: Ticks) {
+        self.track = track
+        self.egressClass = egressClass
+        self.bitrate = bitrate
+        self.interval = 1 / fps
+        self.keyFrameInterval = keyFrameInterval
+        self.keyFrameBytes = keyFrameBytes
+        self.target = bitrate
+        self.next = start
+        self.lastKeyFrame = start
+    }
+
+    mutating func make(now: Ticks, random: inout SeededGenerator) -> SimulatedObject {
+        defer {
+            self.next = self.next.addingTimeInterval(self.interval)
+            self.objectId += 1
+        }
+        let frameBytes = Double(self.target) / 8 * self.interval
+        guard let keyFrameInterval else {
+            // Every object its own group.
+            self.groupId += 1
+            self.objectId = 0
+            return .init(track: self.track, groupId: self.groupId, objectId: 0, bytes: Int(frameBytes), created: now)
+        }
+        if self.groupId == 0 || self.forceKeyFrame || now.timeIntervalSince(self.lastKeyFrame) >= keyFrameInterval {
+            self.forceKeyFrame = false
+            self.lastKeyFrame = now
+            self.groupId += 1
+            self.objectId = 0
+            return .init(track: self.track,
+                         groupId: self.groupId,
+                         objectId: 0,
+                         bytes: self.keyFrameBytes * Int(self.target) / Int(self.bitrate),
+                         created: now)
+        }
+        return .init(track: self.track,
+                     groupId: self.groupId,
+                     objectId: self.objectId,
+                     bytes: Int(frameBytes * .random(in: 0.8...1.2, using: &random)),
+                     created: now)
+    }
+}
+
+private struct Simulation: Equatable {
+    var handoffs: [Handoff] = []
+    var targets: [Int: [UInt32]] = [:]
+    var dropped: [Int: Int] = [:]
+}
+
+private let audio = 0
+private let baseLayer = 1
+private let enhancementLayer = 2
+
+@Suite("Egress scheduler")
+struct EgressSchedulerTests {
+    private let config = EgressConfig(uplinkBitrate: 3_000_000)
+
+    /// Audio, a base layer and a 4K enhancement layer, wanting more than the uplink, over simulated time.
+    private func simulate(seed: UInt64) -> Simulation {
+        var random = SeededGenerator(state: seed)
+        let start = Ticks(1_000_000_000)
+        var queue = EgressQueue<SimulatedObject>(config: self.config, now: start)
+        var sources: [SimulatedSource] = [
+            .init(track: audio, egressClass: .audio, bitrate: 64_000, fps: 50,
+                  keyFrameInterval: nil, keyFrameBytes: 0, start: start),
+            .init(track: baseLayer, egressClass: .baseLayer, bitrate: 500_000, fps: 30,
+                  keyFrameInterval: 2, keyFrameBytes: 20_000, start: start),
+            .init(track: enhancementLayer, egressClass: .enhancementLayer, bitrate: 4_000_000, fps: 30,
+                  keyFrameInterval: 2, keyFrameBytes: 250_000, start: start)
+        ]
+        for source in sources {
+            queue.add(source.track, egressClass: source.egressClass, bitrate: source.bitrate, now: start)
+        }
+
+        // The fake handler sink: records what it's handed, and when.
+        var simulation = Simulation()
+        for millisecond in 0..<8000 {
+            let now = start.addingTimeInterval(TimeInterval(millisecond) / 1000)
+            for index in sources.indices where sources[index].next <= now {
+                let object = sources[index].make(now: now, random: &random)
+                switch queue.admit(track: object.track, groupId: object.groupId, bytes: object.bytes, now: now) {
+                case .send:
+                    simulation.handoffs.append(.init(object: object, sent: now))
+                    queue.completed(object.track)
+                case .queue:
+                    queue.enqueue(object, track: object.track, groupId: object.groupId, bytes: object.bytes, now: now)
+                case .drop:
+                    // As a publication does when its publish fails.
+                    sources[index].forceKeyFrame = true
+                    simulation.dropped[object.track, default: 0] += 1
+                }
+            }
+            while let next = queue.next(now: now) {
+                simulation.handoffs.append(.init(object: next.payload, sent: now))
+                queue.completed(next.track)
+            }
+            for feedback in queue.takeFeedback() {
+                switch feedback {
+                case .dropped(let track):
+                    sources[track].forceKeyFrame = true
+                    simulation.dropped[track, default: 0] += 1
+                case .targetBitrate(let track, let bitrate):
+                    sources[track].target = bitrate
+                    simulation.targets[track, default: []].append(bitrate)
+                }
+            }
+        }
+        return simulation
+    }
+
+    @Test("Simulated congested uplink", arguments: [UInt64(1), 2, 3])
+    func simulation(seed: UInt64) throws {
+        let simulation = self.simulate(seed: seed)
+        let handoffs = Dictionary(grouping: simulation.handoffs) { $0.object.track }
+        let audioHandoffs = try #require(handoffs[audio])
+        let baseHandoffs = try #require(handoffs[baseLayer])
+        let enhancementHandoffs = try #require(handoffs[enhancementLayer])
+        let worstBaseDelay = baseHandoffs.map(\.delay).max() ?? 0
+        print("Base worst delay: \(worstBaseDelay * 1000)ms, " +
+              "enhancement drops: \(simulation.dropped[enhancementLayer] ?? 0), " +
+              "enhancement targets: \(simulation.targets[enhancementLayer] ?? [])")
+
+        // Audio never waits, even behind 4K key frames.
+        #expect(audioHandoffs.count == 400)
+        #expect(audioHandoffs.allSatisfy { $0.delay == 0 })
+
+        // The base layer is barely held, and never dropped.
+        #expect(worstBaseDelay < 0.1)
+        #expect(simulation.dropped[baseLayer] == nil)
+
+        // The enhancement layer takes the congestion: dropped when stale, and asked to back off.
+        #expect(simulation.dropped[enhancementLayer, default: 0] > 0)
+        #expect(enhancementHandoffs.allSatisfy { $0.delay <= self.config.staleVideoAge + 0.001 })
+        let lowest = try #require(simulation.targets[enhancementLayer]?.min())
+        #expect(lowest < 4_000_000)
+        #expect(simulation.targets[audio] == nil)
+
+        for (_, trackHandoffs) in handoffs {
+            // In order per track, and of each group only ever a decodable prefix.
+            var last: (groupId: UInt64, objectId: UInt64)?
+            for handoff in trackHandoffs {
+                if let last, last.groupId == handoff.object.groupId {
+                    #expect(handoff.object.objectId == last.objectId + 1)
+                } else {
+                    #expect(last == nil || last!.groupId < handoff.object.groupId)
+                    #expect(handoff.object.objectId == 0)
+                }
+                last = (handoff.object.groupId, handoff.object.objectId)
+            }
+        }
+
+        // Within the uplink's budget over any second, give or take bursts and one overdraft per class.
+        let overdraft = 3 * Int(self.config.burst * 3_000_000 / 8) + 250_000 + 20_000 + 160
+        let start = simulation.handoffs[0].sent
+        for second in 0..<7 {
+            let from = start.addingTimeInterval(TimeInterval(second))
+            let to = from.addingTimeInterval(1)
+            let bytes = simulation.handoffs.filter { $0.sent >= from && $0.sent < to }.reduce(0) { $0 + $1.object.bytes }
+            #expect(bytes <= 3_000_000 / 8 + overdraft)
+        }
+    }
+
+    @Test("Simulation is deterministic")
+    func deterministic() {
+        #expect(self.simulate(seed: 7) == self.simulate(seed: 7))
+    }
+
+    @Test("Stale objects drop the rest of their group")
+    func dropsGroup() {
+        let start = Ticks(1_000_000_000)
+        var queue = EgressQueue<UInt64>(config: .init(uplinkBitrate: 80_000), now: start)
+        queue.add(1, egressClass: .enhancementLayer, bitrate: 0, now: start)
+
+        // A large key frame overdraws the uplink for a second.
+        #expect(queue.admit(track: 1, groupId: 1, bytes: 10_000, now: start) == .send)
+        queue.completed(1)
+        for object in UInt64(1)...3 {
+            #expect(queue.admit(track: 1, groupId: 1, bytes: 100, now: start) == .queue)
+            queue.enqueue(object, track: 1, groupId: 1, bytes: 100, now: start)
+        }
+        #expect(queue.next(now: start) == nil)
+        #expect(queue.nextWake(now: start) ?? 0 > 0.9)
+
+        // By then, they're stale.
+        let later = start.addingTimeInterval(1.1)
+        #expect(queue.next(now: later) == nil)
+        #expect(queue.takeFeedback() == [.dropped(1)])
+        #expect(queue.nextWake(now: later) == nil)
+        #expect(queue.admit(track: 1, groupId: 1, bytes: 100, now: later) == .drop)
+        #expect(queue.admit(track: 1, groupId: 2, bytes: 100, now: later) == .send)
+    }
+
+    @Test("Paced sink publishes in order through a fake handler")
+    func pacedSink() async throws {
+        final class Published: Sendable {
+            let objects = Mutex<[(groupId: UInt64, objectId: UInt64)]>([])
+        }
+        let published = Published()
+        let fake = MockSink(fullTrackName: try FullTrackName(namespace: ["egress"], name: "test"))
+        fake.onPublish = { groupId, objectId in
+            published.objects.withLock { $0.append((groupId, objectId)) }
+        }
+        // 10KB/s, so that the first object overdraws the uplink for most of 100ms.
+        let scheduler = EgressScheduler(config: .init(uplinkBitrate: 80_000))
+        let sink = scheduler.makeSink(fake, egressClass: .baseLayer, bitrate: 0)
+        var bytes = [UInt8](repeating: 0, count: 1000)
+        for objectId in UInt64(0)..<3 {
+            let status = bytes.withUnsafeMutableBytes { buffer in
+                // Borrowed, as publications do.
+                let data = Data(bytesNoCopy: buffer.baseAddress!, count: buffer.count, deallocator: .none)
+                return sink.publishObject(.init(groupId: 1,
+                                                subgroupId: 0,
+                                                objectId: objectId,
+                                                payloadLength: UInt64(data.count),
+                                                status: .available,
+                                                priority: nil,
+                                                ttl: nil),
+                                          data: data,
+                                          extensions: nil,
+                                          immutableExtensions: nil,
+                                          streamHeaderProperties: nil)
+            }
+            #expect(status == .ok)
+        }
+        // Only the first went immediately.
+        #expect(published.objects.get().count == 1)
+        try await Task.sleep(for: .milliseconds(500))
+        #expect(published.objects.get().map(\.objectId) == [0, 1, 2])
+    }
+
+    @Test("A sooner object wakes the scheduler from a longer sleep", arguments: [false, true])
+    func wakesSooner(restarted: Bool) async throws {
+        final class Published: Sendable {
+            let objects = Mutex<[(track: String, objectId: UInt64, at: Ticks)]>([])
+        }
+        let published = Published()
+        func sink(_ name: String) throws -> MockSink {
+            let sink = MockSink(fullTrackName: try FullTrackName(namespace: ["egress"], name: name))
+            sink.onPublish = { _, objectId in
+                published.objects.withLock { $0.append((name, objectId, .now)) }
+            }
+            return sink
+        }
+        func publish(_ sink: PacedSink, objectId: UInt64, bytes: Int) -> QPublishObjectStatus {
+            let data = Data(count: bytes)
+            return sink.publishObject(.init(groupId: 1,
+                                            subgroupId: 0,
+                                            objectId: objectId,
+                                            payloadLength: UInt64(data.count),
+                                            status: .available,
+                                            priority: nil,
+                                            ttl: nil),
+                                      data: data,
+                                      extensions: nil,
+                                      immutableExtensions: nil,
+                                      streamHeaderProperties: nil)
+        }
+
+        // 10KB/s. A large enhancement layer key frame leaves its next object waiting about a second.
+        let scheduler = EgressScheduler(config: .init(uplinkBitrate: 80_000))
+        let enhancement = scheduler.makeSink(try sink("enhancement"), egressClass: .enhancementLayer, bitrate: 0)
+        let base = scheduler.makeSink(try sink("base"), egressClass: .baseLayer, bitrate: 0)
+        if restarted {
+            // Queue something, and let the job send it and stop, so that what follows runs a new job.
+            let earlier = scheduler.makeSink(try sink("earlier"), egressClass: .enhancementLayer, bitrate: 0)
+            #expect(publish(earlier, objectId: 0, bytes: 1000) == .ok)
+            #expect(publish(earlier, objectId: 1, bytes: 100) == .ok)
+            try await Task.sleep(for: .milliseconds(300))
+            #expect(published.objects.get().count == 2)
+        }
+        #expect(publish(enhancement, objectId: 0, bytes: 10_000) == .ok)
+        #expect(publish(enhancement, objectId: 1, bytes: 100) == .ok)
+        try await Task.sleep(for: .milliseconds(50))
+
+        // The base layer's next object can go in about 100ms, long before the scheduler would next wake.
+        let start = Ticks.now
+        #expect(publish(base, objectId: 0, bytes: 1000) == .ok)
+        #expect(publish(base, objectId: 1, bytes: 100) == .ok)
+        try await Task.sleep(for: .milliseconds(400))
+        let objects = published.objects.get()
+        let sent = try #require(objects.first { $0.track == "base" && $0.objectId == 1 })
+        #expect(sent.at.timeIntervalSince(start) < 0.3)
+        #expect(!objects.contains { $0.track == "enhancement" && $0.objectId == 1 })
+    }
+
+    @Test("Queued objects on libquicr tracks are published as a batch")
+    func batched() async throws {
+        final class Dropped: Sendable {
+            let count = Atomic<Int>(0)
+        }
+        let dropped = Dropped()
+        let handler = QPublishTrackHandlerSink(fullTrackName: QFullTrackNameImpl(namespace: [Data("egress".utf8)],
+                                                                                 name: Data("batched".utf8)),
+                                               trackMode: .stream,
+                                               defaultPriority: 1,
+                                               defaultTTL: 1000)
+        let scheduler = EgressScheduler(config: .init(uplinkBitrate: 80_000))
+        let sink = scheduler.makeSink(handler, egressClass: .baseLayer, bitrate: 0)
+        sink.setFeedback(onDropped: { dropped.count.add(1, ordering: .relaxed) }, onTargetBitrate: { _ in })
+        let data = Data(repeating: 0, count: 1000)
+        var statuses: [QPublishObjectStatus] = []
+        for objectId in UInt64(0)..<3 {
+            statuses.append(sink.publishObject(.init(groupId: 1,
+                                                     subgroupId: 0,
+                                                     objectId: objectId,
+                                                     payloadLength: UInt64(data.count),
+                                                     status: .available,
+                                                     priority: nil,
+                                                     ttl: nil),
+                                               data: data,
+                                               extensions: nil,
+                                               immutableExtensions: nil,
+                                               streamHeaderProperties: nil))
+        }
+        // The first went straight to the handler, and the rest were queued.
+        #expect(statuses.dropFirst().allSatisfy { $0 == .ok })
+        try await Task.sleep(for: .milliseconds(500))
+
+        // Nothing is announced, so the batch's statuses are the handler's own, and failures are reported as drops.
+        #expect(dropped.count.load(ordering: .relaxed) == (statuses[0] == .ok ? 0 : 2))
+    }
+}
@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import XCTest
+@testable import QuicR
+
+final class TestHeaderExtensions: XCTestCase {
+    func testEmpty() throws {
+        let extensions = HeaderExtensions()
+        XCTAssertTrue(extensions.isEmpty)
+        XCTAssertNil(extensions.bridged)
+        XCTAssertNil(extensions[1])
+        XCTAssertNil(HeaderExtensions(bridged: nil))
+        XCTAssertEqual(try HeaderExtensions(flat: extensions.flat), extensions)
+    }
+
+    func testRoundTrip() throws {
+        var extensions = HeaderExtensions()
+        try extensions.setHeader(.audioLevel(42))
+        try extensions.setHeader(.captureTimestamp(.init(timeIntervalSince1970: 1234)))
+        try extensions.setHeader(3, data: .bytes(Data([1, 2, 3])))
+        try extensions.setHeader(4, data: .value(UInt64(99)))
+        XCTAssertEqual(extensions.count, 4)
+
+        // Through the bridge encoding and back.
+        let decoded = try XCTUnwrap(HeaderExtensions(bridged: extensions.bridged))
+        XCTAssertEqual(decoded, extensions)
+        guard case .audioLevel(let level) = try decoded.getHeader(.audioLevel) else {
+            XCTFail("Expected audio level")
+            return
+        }
+        XCTAssertEqual(level, 42)
+        guard case .captureTimestamp(let date) = try decoded.getHeader(.captureTimestamp) else {
+            XCTFail("Expected timestamp")
+            return
+        }
+        XCTAssertEqual(date.timeIntervalSince1970, 1234)
+        guard case .bytes(let bytes) = try decoded.getHeader(3) else {
+            XCTFail("Expected bytes")
+            return
+        }
+        XCTAssertEqual(bytes, Data([1, 2, 3]))
+        guard case .value(let value) = try decoded.getHeader(4) else {
+            XCTFail("Expected value")
+            return
+        }
+        XCTAssertEqual(UInt64(value), 99)
+        XCTAssertNil(try decoded.getHeader(5))
+    }
+
+    func testMultipleValues() {
+        var extensions = HeaderExtensions()
+        extensions.append(1, Data([1]))
+        extensions.append(2, Data())
+        extensions.append(1, Data([2, 2]))
+        XCTAssertEqual(extensions[1], [Data([1]), Data([2, 2])])
+        XCTAssertEqual(extensions[2], [Data()])
+        XCTAssertEqual(extensions.withValue(1, nth: 1) { $0.count }, 2)
+        XCTAssertNil(extensions.withValue(1, nth: 2) { $0.count })
+
+        // Replace and remove through the subscript.
+        extensions[1] = [Data([3])]
+        XCTAssertEqual(extensions[1], [Data([3])])
+        XCTAssertEqual(extensions[2], [Data()])
+        extensions[2] = nil
+        XCTAssertNil(extensions[2])
+        XCTAssertEqual(extensions.count, 1)
+    }
+
+    func testSlicedInput() throws {
+        var extensions = HeaderExtensions()
+        extensions.append(7, Data([7, 7, 7]))
+        let padded = Data([0xFF, 0xFF]) + extensions.flat
+        let sliced = padded[2...]
+        XCTAssertEqual(try HeaderExtensions(flat: sliced).first(7), Data([7, 7, 7]))
+    }
+
+    func testMalformed() {
+        XCTAssertThrowsError(try HeaderExtensions(flat: Data()))
+        XCTAssertThrowsError(try HeaderExtensions(flat: Data(count: 7)))
+
+        var extensions = HeaderExtensions()
+        extensions.append(1, Data([1, 2, 3, 4]))
+        var flat = extensions.flat
+
+        // Count larger than the index.
+        flat[0] = 2
+        XCTAssertThrowsError(try HeaderExtensions(flat: flat))
+        flat[0] = 1
+
+        // Value running past the end.
+        flat[8 + 12] = 5
+        XCTAssertThrowsError(try HeaderExtensions(flat: flat))
+        XCTAssertNil(HeaderExtensions(bridged: flat))
+    }
+
+    func testFuzz() {
+        var generator = SystemRandomNumberGenerator()
+        for _ in 0..<1000 {
+            var extensions = HeaderExtensions()
+            for _ in 0..<Int.random(in: 0...4, using: &generator) {
+                let value = Data((0..<Int.random(in: 0...8, using: &generator)).map { _ in UInt8.random(in: 0...255) })
+                extensions.append(.random(in: 0...8, using: &generator), value)
+            }
+            var flat = extensions.flat
+            for _ in 0..<Int.random(in: 1...4, using: &generator) {
+                flat[Int.random(in: 0..<flat.count, using: &generator)] = .random(in: 0...255, using: &generator)
+            }
+            if Bool.random(using: &generator) {
+                flat = flat.prefix(Int.random(in: 0...flat.count, using: &generator))
+            }
+
+            // Anything accepted must only ever read within its own bounds.
+            guard let parsed = try? HeaderExtensions(flat: flat) else { continue }
+            for key in 0...8 {
+                for value in parsed.values(UInt64(key)) {
+                    XCTAssertLessThanOrEqual(value.count, flat.count)
+                }
+            }
+        }
+    }
+
+    // Typical LOC set built on publish and read back on receive.
+    func testPerformance() {
+        measure {
+            for _ in 0..<1000 {
+                var extensions = HeaderExtensions()
+                try? extensions.setHeader(.audioLevel(10))
+                try? extensions.setHeader(.captureTimestamp(.now))
+                try? extensions.setHeader(4, data: .value(UInt64(1)))
+                guard let received = HeaderExtensions(bridged: extensions.bridged) else {
+                    XCTFail("Failed to decode")
+                    return
+                }
+                _ = try? received.getHeader(.audioLevel)
+                _ = try? received.getHeader(.captureTimestamp)
+                _ = try? received.getHeader(4)
+            }
+        }
+    }
+}
@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import XCTest
+@testable import QuicR
+
+private final class HistogramMeasurement: MetricsMeasurement {
+    let storage = MeasurementStorage()
+    let name = "Histogram"
+    let tags: [String: String] = [:]
+    let latency = LatencyHistogram("latency", range: -1...1, period: 1)
+    var histograms: [LatencyHistogram] { [self.latency] }
+}
+
+final class TestHistogram: XCTestCase {
+    private func exactPercentile(_ sorted: [Int64], _ percentile: Double) -> Int64 {
+        let rank = max(1, Int((percentile / 100 * Double(sorted.count)).rounded(.up)))
+        return sorted[rank - 1]
+    }
+
+    private func assertWithinError(_ histogram: QHistogram, _ values: [Int64], file: StaticString = #filePath, line: UInt = #line) {
+        let sorted = values.sorted()
+        XCTAssertEqual(histogram.count(), UInt64(values.count), file: file, line: line)
+        XCTAssertEqual(histogram.min(), sorted.first, file: file, line: line)
+        XCTAssertEqual(histogram.max(), sorted.last, file: file, line: line)
+        for percentile in [0, 1, 10, 50, 90, 99, 99.9, 100] {
+            let exact = self.exactPercentile(sorted, percentile)
+            let reported = histogram.value(atPercentile: percentile)
+            // Reported values are the top of their bucket, so never below the true value.
+            XCTAssertGreaterThanOrEqual(reported, exact, "p\(percentile)", file: file, line: line)
+            let error = Double(reported - exact) / Double(max(1, abs(exact)))
+            XCTAssertLessThanOrEqual(error, histogram.relativeError(), "p\(percentile)", file: file, line: line)
+        }
+    }
+
+    func testErrorBound() {
+        for significantBits: UInt8 in [2, 4, 7, 10] {
+            var generator = SeededGenerator(state: UInt64(significantBits))
+            let histogram = QHistogram(lowest: 0, highest: 60_000_000, significantBits: significantBits)
+            var values: [Int64] = []
+            for _ in 0..<100_000 {
+                // Log uniform over 1us to 60s, as latencies roughly are.
+                let value = Int64(exp(Double.random(in: 0...log(60_000_000), using: &generator)))
+                values.append(value)
+                histogram.record(value)
+            }
+            self.assertWithinError(histogram, values)
+        }
+    }
+
+    func testNegativeValues() {
+        var generator = SeededGenerator(state: 1)
+        let histogram = QHistogram(lowest: -1_000_000, highest: 1_000_000, significantBits: 7)
+        var values: [Int64] = []
+        for _ in 0..<50_000 {
+            let value = Int64.random(in: -1_000_000...1_000_000, using: &generator)
+            values.append(value)
+            histogram.record(value)
+        }
+        self.assertWithinError(histogram, values)
+    }
+
+    func testSmallValuesAreExact() {
+        let histogram = QHistogram(lowest: -200, highest: 200, significantBits: 7)
+        for value in Int64(-127)...127 {
+            histogram.reset()
+            histogram.record(value)
+            XCTAssertEqual(histogram.value(atPercentile: 50), value)
+        }
+    }
+
+    func testClamping() {
+        let histogram = QHistogram(lowest: 0, highest: 1000, significantBits: 7)
+        histogram.record(5000)
+        histogram.record(-5)
+        // Min and max stay exact, percentiles are bounded by the range.
+        XCTAssertEqual(histogram.min(), -5)
+        XCTAssertEqual(histogram.max(), 5000)
+        XCTAssertEqual(histogram.value(atPercentile: 0), 0)
+        XCTAssertLessThanOrEqual(histogram.value(atPercentile: 100), 1000 + Int64(1000 * histogram.relativeError()))
+    }
+
+    func testMergeAndDrain() {
+        let first = QHistogram(lowest: 0, highest: 1_000_000, significantBits: 7)
+        let second = QHistogram(lowest: 0, highest: 1_000_000, significantBits: 7)
+        var values: [Int64] = []
+        for value in Int64(1)...1000 {
+            values.append(value * 37)
+            (value.isMultiple(of: 2) ? first : second).record(value * 37)
+        }
+        XCTAssertTrue(first.merge(second))
+        self.assertWithinError(first, values)
+
+        let drained = QHistogram(lowest: 0, highest: 1_000_000, significantBits: 7)
+        XCTAssertTrue(first.drain(into: drained))
+        XCTAssertEqual(first.count(), 0)
+        self.assertWithinError(drained, values)
+
+        // Layouts must match.
+        let other = QHistogram(lowest: 0, highest: 1000, significantBits: 7)
+        XCTAssertFalse(first.merge(other))
+        XCTAssertFalse(drained.drain(into: other))
+        XCTAssertEqual(drained.count(), 1000)
+    }
+
+    func testConcurrentDrain() async {
+        let histogram = QHistogram(lowest: 0, highest: 1_000_000, significantBits: 7)
+        let drained = await withTaskGroup(of: UInt64.self) { group in
+            for _ in 0..<4 {
+                group.addTask {
+                    for value in 0..<10_000 {
+                        histogram.record(Int64(value))
+                    }
+                    return 0
+                }
+            }
+            for _ in 0..<4 {
+                group.addTask {
+                    let into = QHistogram(lowest: 0, highest: 1_000_000, significantBits: 7)
+                    for _ in 0..<50 {
+                        histogram.drain(into: into)
+                    }
+                    return into.count()
+                }
+            }
+            return await group.reduce(0, +)
+        }
+        XCTAssertEqual(drained + histogram.count(), 40_000)
+    }
+
+    func testLatencySummary() {
+        let measurement = HistogramMeasurement()
+        let start = Date(timeIntervalSince1970: 100)
+        for index in 0..<1000 {
+            measurement.latency.record(Double(index) / 1000, timestamp: start + Double(index) / 1000, into: measurement)
+        }
+        // The next period summarizes the first.
+        measurement.latency.record(-0.5, timestamp: start + 1, into: measurement)
+
+        let encoder = QInfluxLineEncoder()
+        XCTAssertEqual(measurement.drain(into: encoder), 2)
+        let lines = String(decoding: encoder.data(), as: UTF8.self).split(separator: "\n")
+        XCTAssertEqual(lines.count, 2)
+
+        // First period, timestamped at its end.
+        let first = String(lines[0])
+        XCTAssertTrue(first.hasPrefix("Histogram latency_p50="), first)
+        XCTAssertTrue(first.contains(",latency_count=1000i"), first)
+        XCTAssertTrue(first.hasSuffix(" 101000000000"), first)
+        let fields = Dictionary(uniqueKeysWithValues: first.split(separator: " ")[1].split(separator: ",").map {
+            let pair = $0.split(separator: "=")
+            return (String(pair[0]), String(pair[1]))
+        })
+        XCTAssertEqual(Double(fields["latency_p50"]!)!, 0.5, accuracy: 0.5 * 0.02)
+        XCTAssertEqual(Double(fields["latency_p90"]!)!, 0.9, accuracy: 0.9 * 0.02)
+        XCTAssertEqual(Double(fields["latency_p99"]!)!, 0.99, accuracy: 0.99 * 0.02)
+        XCTAssertEqual(fields["latency_max"], "0.999")
+
+        // The remainder, summarized by the drain. A lone sample is its own min and max, so exact.
+        XCTAssertTrue(lines[1].hasPrefix("Histogram latency_p50=-0.5,"), String(lines[1]))
+        XCTAssertTrue(lines[1].contains(",latency_count=1i"), String(lines[1]))
+
+        // Nothing left.
+        encoder.reset()
+        XCTAssertEqual(measurement.drain(into: encoder), 0)
+    }
+
+    func testPerformanceRecord() {
+        let histogram = QHistogram(lowest: -10_000_000, highest: 60_000_000, significantBits: 7)
+        measure {
+            for value in 0..<1_000_000 {
+                histogram.record(Int64(value))
+            }
+        }
+    }
+}
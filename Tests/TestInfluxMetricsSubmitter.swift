@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Network
+import XCTest
+@testable import QuicR
+
+private final class SubmittedMeasurement: MetricsMeasurement {
+    let storage = MeasurementStorage()
+    let name = "Submitted"
+    let tags: [String: String] = ["source": "test"]
+}
+
+private extension MetricField {
+    static let value = MetricField("value")
+    static let other = MetricField("other")
+}
+
+/// A local HTTP endpoint standing in for an InfluxDB server, recording each request's body.
+private final class InfluxStandIn: @unchecked Sendable {
+    struct Request {
+        let head: String
+        let body: String
+    }
+
+    private let listener: NWListener
+    private let queue = DispatchQueue(label: "InfluxStandIn")
+    private var received: [Request] = []
+
+    var requests: [Request] {
+        self.queue.sync { self.received }
+    }
+
+    init() throws {
+        self.listener = try NWListener(using: .tcp, on: .any)
+        self.listener.newConnectionHandler = { [weak self] connection in
+            guard let self else { return }
+            connection.start(queue: self.queue)
+            self.read(connection, buffered: Data())
+        }
+    }
+
+    /// - Returns: The port listened on.
+    func start() async throws -> UInt16 {
+        try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<UInt16, Error>) in
+            self.listener.stateUpdateHandler = { [listener] state in
+                switch state {
+                case .ready:
+                    listener.stateUpdateHandler = nil
+                    continuation.resume(returning: listener.port!.rawValue)
+                case .failed(let error):
+                    listener.stateUpdateHandler = nil
+                    continuation.resume(throwing: error)
+                default:
+                    break
+                }
+            }
+            self.listener.start(queue: self.queue)
+        }
+    }
+
+    func stop() {
+        self.listener.cancel()
+    }
+
+    private func read(_ connection: NWConnection, buffered: Data) {
+        connection.receive(minimumIncompleteLength: 1, maximumLength: 65536) { [weak self] data, _, complete, error in
+            guard let self else { return }
+            var buffered = buffered
+            if let data {
+                buffered.append(data)
+            }
+            if let request = Self.parse(buffered) {
+                self.received.append(request)
+                let response = "HTTP/1.1 204 No Content\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"
+                connection.send(content: Data(response.utf8), completion: .contentProcessed { _ in
+                    connection.cancel()
+                })
+            } else if complete || error != nil {
+                connection.cancel()
+            } else {
+                self.read(connection, buffered: buffered)
+            }
+        }
+    }
+
+    /// A complete request, once the headers and `Content-Length` bytes of body have arrived.
+    private static func parse(_ data: Data) -> Request? {
+        guard let separator = data.range(of: Data("\r\n\r\n".utf8)) else { return nil }
+        let head = String(decoding: data[data.startIndex..<separator.lowerBound], as: UTF8.self)
+        let length = head.split(separator: "\r\n")
+            .first { $0.lowercased().hasPrefix("content-length:") }
+            .flatMap { Int($0.split(separator: ":")[1].trimmingCharacters(in: .whitespaces)) } ?? 0
+        let body = data[separator.upperBound...]
+        guard body.count >= length else { return nil }
+        return .init(head: head, body: String(decoding: body.prefix(length), as: UTF8.self))
+    }
+}
+
+final class TestInfluxMetricsSubmitter: XCTestCase {
+    private var server: InfluxStandIn!
+    private var submitter: InfluxMetricsSubmitter!
+
+    override func setUp() async throws {
+        self.server = try InfluxStandIn()
+        let port = try await self.server.start()
+        var config = InfluxConfig()
+        config.url = "http://127.0.0.1:\(port)"
+        self.submitter = InfluxMetricsSubmitter(token: "token",
+                                                config: config,
+                                                tags: ["endpoint": "a b"],
+                                                gzip: false)
+    }
+
+    override func tearDown() {
+        self.server.stop()
+        self.server = nil
+        self.submitter = nil
+    }
+
+    func testSubmitWritesLineProtocol() async throws {
+        let measurement = SubmittedMeasurement()
+        self.submitter.register(measurement: measurement)
+        let first = Date(timeIntervalSince1970: 1)
+        let second = Date(timeIntervalSince1970: 2)
+        measurement.record(field: .value, value: 1, timestamp: first)
+        measurement.record(field: .other, value: 0.5, timestamp: first)
+        measurement.record(field: .value, value: 2, timestamp: second)
+
+        await self.submitter.submit()
+
+        let requests = self.server.requests
+        XCTAssertEqual(requests.count, 1)
+        let request = try XCTUnwrap(requests.first)
+        XCTAssertTrue(request.head.hasPrefix("POST /api/v2/write?"))
+        XCTAssertTrue(request.head.contains("precision=ns"))
+        XCTAssertEqual(request.body.split(separator: "\n"), [
+            "Submitted,endpoint=a\\ b,source=test value=1i,other=0.5 1000000000",
+            "Submitted,endpoint=a\\ b,source=test value=2i 2000000000"
+        ])
+
+        // Everything was drained, so there's nothing more to send.
+        await self.submitter.submit()
+        XCTAssertEqual(self.server.requests.count, 1)
+    }
+
+    func testDeadMeasurementsAreNotSubmitted() async {
+        var measurement: SubmittedMeasurement? = .init()
+        self.submitter.register(measurement: measurement!)
+        measurement!.record(field: .value, value: 1, timestamp: nil)
+        measurement = nil
+
+        await self.submitter.submit()
+        XCTAssertTrue(self.server.requests.isEmpty)
+    }
+
+    func testPerformanceRecordAndEncode() {
+        let measurement = SubmittedMeasurement()
+        let encoder = QInfluxLineEncoder()
+        let now = Date.now
+        // Within a single thread's ring capacity.
+        measure {
+            for index in 0..<2_000 {
+                measurement.record(field: .value, value: index, timestamp: now + Double(index))
+                measurement.record(field: .other, value: Double(index) / 3, timestamp: now + Double(index))
+            }
+            encoder.reset()
+            XCTAssertEqual(measurement.drain(into: encoder), 2_000)
+        }
+    }
+}
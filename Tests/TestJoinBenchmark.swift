@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Foundation
+import Synchronization
+import Testing
+@testable import QuicR
+
+/// Joining a call with many video tracks over a relay hop: how long until every subscription has been answered.
+///
+/// Serially is how a call was joined before bulk subscription: each set constructed and each of its tracks subscribed
+/// in turn. In bulk, sets and their handlers are constructed concurrently, then every track is subscribed in one call.
+/// Neither waits on one subscription's answer before the next, so bulk only gains by constructing concurrently.
+@MainActor
+struct TestJoinBenchmark {
+    private static let roundTrip: TimeInterval = 0.04
+
+    private func manifest(_ tracks: Int) -> [ManifestSubscription] {
+        (0..<tracks).map { index in
+            .init(mediaType: ManifestMediaTypes.video.rawValue,
+                  sourceName: "\(index)",
+                  sourceID: "\(index)",
+                  label: "\(index)",
+                  participantId: .init(UInt32(index + 1)),
+                  profileSet: .init(type: "video", profiles: [
+                    .init(qualityProfile: "h264,width=1280,height=720,fps=30,br=1500",
+                          expiry: nil,
+                          priorities: nil,
+                          namespace: ["join", "\(index)"])
+                  ]))
+        }
+    }
+
+    private func join(tracks: Int, bulk: Bool) async throws -> (issued: TimeInterval, joined: TimeInterval) {
+        let relay = LoopbackRelay(delay: Self.roundTrip / 2)
+        let (answered, answer) = AsyncStream<Void>.makeStream()
+        let client = relay.makeClient { _ in answer.yield() }
+        let controller = MoqCallController(endpointUri: "join", client: client, submitter: nil) { }
+        try await controller.connect()
+        let factory = SubscriptionFactoryImpl(videoParticipants: .init(),
+                                              metricsSubmitter: nil,
+                                              subscriptionConfig: .init(),
+                                              granularMetrics: false,
+                                              engine: nil,
+                                              participantId: nil,
+                                              joinDate: .now,
+                                              activeSpeakerStats: nil,
+                                              controller: controller,
+                                              verbose: false,
+                                              startingGroup: nil,
+                                              manualActiveSpeaker: false,
+                                              sframeKeyring: nil,
+                                              calculateLatency: false,
+                                              mediaInterop: false)
+        let manifest = self.manifest(tracks)
+
+        let start = Ticks.now
+        if bulk {
+            let results = try controller.subscribeToSets(manifest, factory: factory)
+            #expect(results.allSatisfy { (try? $0.get()) != nil })
+        } else {
+            for subscription in manifest {
+                try controller.subscribeToSet(details: subscription, factory: factory, subscribeType: .subscribe)
+            }
+        }
+        let issued = Ticks.now.timeIntervalSince(start)
+        var count = 0
+        for await _ in answered {
+            count += 1
+            if count == tracks { break }
+        }
+        let joined = Ticks.now.timeIntervalSince(start)
+        #expect(controller.getSubscriptionSets().count == tracks)
+        try controller.disconnect()
+        return (issued, joined)
+    }
+
+    @Test("Join", arguments: [10, 100, 1000])
+    func join(tracks: Int) async throws {
+        let serial = try await self.join(tracks: tracks, bulk: false)
+        let bulk = try await self.join(tracks: tracks, bulk: true)
+        let ratio = bulk.joined / serial.joined
+        for (name, result) in [("serial", serial), ("bulk", bulk)] {
+            print("Join, \(tracks) tracks, \(name): issued in \(result.issued * 1000)ms, " +
+                  "joined in \(result.joined * 1000)ms (\((result.joined - Self.roundTrip) * 1000)ms over the round trip)")
+        }
+        print("Join, \(tracks) tracks: bulk takes \(ratio) of serial")
+
+        // A round trip dwarfs constructing a few sets, but bulk must be no slower, give or take noise.
+        #expect(ratio < 1.2)
+        // With construction outweighing the round trip, and cores to construct on, it must be faster.
+        if tracks >= 1000 && ProcessInfo.processInfo.activeProcessorCount > 1 {
+            #expect(ratio < 0.9)
+        }
+    }
+}
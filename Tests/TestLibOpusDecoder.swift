@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import AVFAudio
+import Opus
+import XCTest
+@testable import QuicR
+
+final class TestLibOpusDecoder: XCTestCase {
+    private let format = DecimusAudioEngine.format
+    // 20ms.
+    private let window: AVAudioFrameCount = 960
+
+    /// An encoded stream of speech like audio, as it would be received.
+    private func record(seconds: Double) throws -> [Data] {
+        let encoder = try LibOpusEncoder(format: self.format, desiredWindowSize: .twentyMs, bitrate: 24000)
+        let pcm = AVAudioPCMBuffer(pcmFormat: self.format, frameCapacity: self.window)!
+        pcm.frameLength = self.window
+        var phase = 0.0
+        var packets: [Data] = []
+        for packet in 0..<Int(seconds / 0.02) {
+            for index in 0..<Int(self.window) {
+                let time = Double(packet * Int(self.window) + index) / self.format.sampleRate
+                phase += 2 * .pi * (120 + 30 * sin(2 * .pi * 1.3 * time)) / self.format.sampleRate
+                let harmonics = (1...8).reduce(0.0) { $0 + sin(Double($1) * phase) / Double($1) }
+                pcm.floatChannelData![0][index] = Float32(0.2 * harmonics * (0.5 + 0.5 * sin(2 * .pi * 3 * time)))
+            }
+            // Only valid until the next write, so copy.
+            packets.append(Data(try encoder.write(data: pcm)))
+        }
+        return packets
+    }
+
+    private func samples(_ buffer: AVAudioPCMBuffer) -> [Float32] {
+        Array(UnsafeBufferPointer(start: buffer.floatChannelData![0], count: Int(buffer.frameLength)))
+    }
+
+    func testDecodeReusesBuffer() throws {
+        let packets = try self.record(seconds: 0.1)
+        let decoder = try LibOpusDecoder(format: self.format)
+        let first = try decoder.write(data: packets[0])
+        let second = try decoder.write(data: packets[1])
+        XCTAssert(first === second)
+        XCTAssertEqual(second.frameLength, self.window)
+    }
+
+    func testMatchesAllocatingDecode() throws {
+        let packets = try self.record(seconds: 1)
+        let decoder = try LibOpusDecoder(format: self.format)
+        let reference = try Opus.Decoder(format: self.format, application: .voip)
+        for packet in packets {
+            let expected = try reference.decode(packet)
+            XCTAssertEqual(self.samples(try decoder.write(data: packet)), self.samples(expected))
+        }
+    }
+
+    func testBatchedPlc() throws {
+        let packets = try self.record(seconds: 0.2)
+        let decoder = try LibOpusDecoder(format: self.format)
+        let decoded = try decoder.write(data: packets[0])
+        let before = self.samples(decoded)
+
+        // A whole gap in one call, without touching the decoded audio.
+        let concealed = try decoder.plc(frames: self.window * 5)
+        XCTAssertEqual(concealed.frameLength, self.window * 5)
+        XCTAssertFalse(concealed === decoded)
+        XCTAssertEqual(self.samples(decoded), before)
+
+        XCTAssertEqual(decoder.maxFrames, 5760)
+        XCTAssertThrowsError(try decoder.plc(frames: decoder.maxFrames + self.window))
+    }
+
+    func testPerformanceDecodeStream() throws {
+        let packets = try self.record(seconds: 10)
+        let decoder = try LibOpusDecoder(format: self.format)
+        measure {
+            for packet in packets {
+                _ = try? decoder.write(data: packet)
+            }
+        }
+    }
+
+    /// The previous path, allocating a buffer per packet, for comparison.
+    func testPerformanceDecodeStreamAllocating() throws {
+        let packets = try self.record(seconds: 10)
+        let decoder = try Opus.Decoder(format: self.format, application: .voip)
+        measure {
+            for packet in packets {
+                _ = try? decoder.decode(packet)
+            }
+        }
+    }
+
+    func testPerformancePlc() throws {
+        let decoder = try LibOpusDecoder(format: self.format)
+        let clock = ContinuousClock()
+        for packets: AVAudioFrameCount in [1, 3, 6] {
+            let iterations = 500
+            let single = clock.measure {
+                for _ in 0..<iterations {
+                    for _ in 0..<packets {
+                        _ = try? decoder.plc(frames: self.window)
+                    }
+                }
+            }
+            let batched = clock.measure {
+                for _ in 0..<iterations {
+                    _ = try? decoder.plc(frames: self.window * packets)
+                }
+            }
+            print("Concealing \(packets) packets: \(single / iterations) per packet, \(batched / iterations) batched")
+        }
+    }
+}
@@ -10,38 +10,85 @@ private final class TestMeasurement: MetricsMeasurement {
     let tags: [String: String] = ["key": "value"]
 }
 
+private extension MetricField {
+    static let counter = MetricField("counter")
+    static let gauge = MetricField("gauge")
+    static let flag = MetricField("flag")
+    static let state = MetricField("state")
+    static let escaped = MetricField("with space")
+}
+
 @Suite
 struct TestMeasurementBase {
+    private func drain(_ measurement: TestMeasurement, tags: [String: String] = [:]) -> [String] {
+        let encoder = QInfluxLineEncoder()
+        let count = measurement.drain(into: encoder, tags: tags)
+        let lines = String(decoding: encoder.data(), as: UTF8.self).split(separator: "\n").map(String.init)
+        #expect(lines.count == count)
+        return lines
+    }
+
     @Test func recordAndDrain() {
         let measurement = TestMeasurement()
-        let now = Date.now
+        let now = Date(timeIntervalSince1970: 1.5)
 
-        measurement.record(field: "counter", value: 42 as AnyObject, timestamp: now)
-        measurement.record(field: "gauge", value: 3.14 as AnyObject, timestamp: now)
+        measurement.record(field: .counter, value: UInt64(42), timestamp: now)
+        measurement.record(field: .gauge, value: 3.25, timestamp: now)
+        measurement.record(field: .flag, value: true, timestamp: now)
+        measurement.record(field: .state, value: "a \"quoted\" state", timestamp: now)
 
-        let fields = measurement.drain()
-        #expect(fields.count == 1)
-        #expect(fields[now]?.count == 2)
-        #expect(fields[now]?[0].fieldName == "counter")
-        #expect(fields[now]?[1].fieldName == "gauge")
+        // Samples sharing a timestamp share a line.
+        #expect(drain(measurement) == [
+            "Test,key=value counter=42i,gauge=3.25,flag=true,state=\"a \\\"quoted\\\" state\" 1500000000"
+        ])
 
         // Drain again should be empty.
-        let empty = measurement.drain()
-        #expect(empty.isEmpty)
+        #expect(drain(measurement).isEmpty)
     }
 
     @Test func drainIsAtomic() {
         let measurement = TestMeasurement()
 
         // Record, drain, record more — second drain should only have new data.
-        measurement.record(field: "a", value: 1 as AnyObject, timestamp: nil)
-        let first = measurement.drain()
-        #expect(first.count == 1)
-
-        measurement.record(field: "b", value: 2 as AnyObject, timestamp: nil)
-        let second = measurement.drain()
-        #expect(second.count == 1)
-        #expect(second[nil]?[0].fieldName == "b")
+        measurement.record(field: .counter, value: 1, timestamp: nil)
+        #expect(drain(measurement) == ["Test,key=value counter=1i"])
+
+        measurement.record(field: .gauge, value: 2.0, timestamp: nil)
+        #expect(drain(measurement) == ["Test,key=value gauge=2"])
+    }
+
+    @Test func tags() {
+        let measurement = TestMeasurement()
+        let now = Date(timeIntervalSince1970: 2)
+        let interned = MetricTags(["z": "last", "a": "first"])
+
+        measurement.record(field: .counter, value: 1, timestamp: now, tags: interned)
+        measurement.record(field: .counter, value: 2, timestamp: now, tags: .dynamic(["id": "a b,c"]))
+        measurement.record(field: .escaped, value: 3, timestamp: now)
+
+        // Tags are sorted and escaped, and global tags take precedence over the measurement's.
+        #expect(drain(measurement, tags: ["key": "global"]) == [
+            "Test,key=global,a=first,z=last counter=1i 2000000000",
+            "Test,key=global,id=a\\ b\\,c counter=2i 2000000000",
+            "Test,key=global with\\ space=3i 2000000000"
+        ])
+    }
+
+    @Test func point() {
+        let measurement = TestMeasurement()
+        let now = Date(timeIntervalSince1970: 3)
+
+        // Fields recorded as a point share one line, and its dynamic tags, even between other records.
+        measurement.record(field: .counter, value: 1, timestamp: now)
+        measurement.record([.init(.counter, 2), .init(.gauge, 0.5), .init(.flag, false), .init(.state, "on")],
+                           timestamp: now,
+                           tags: .dynamic(["id": "a"]))
+        measurement.record(field: .gauge, value: 1.5, timestamp: now)
+        #expect(drain(measurement) == [
+            "Test,key=value counter=1i 3000000000",
+            "Test,key=value,id=a counter=2i,gauge=0.5,flag=false,state=\"on\" 3000000000",
+            "Test,key=value gauge=1.5 3000000000"
+        ])
     }
 
     @Test func properties() {
@@ -54,20 +101,26 @@ struct TestMeasurementBase {
         let measurement = TestMeasurement()
         let iterations = 1000
 
-        await withTaskGroup(of: Void.self) { group in
+        var drained = await withTaskGroup(of: Int.self) { group in
             for index in 0..<iterations {
                 group.addTask {
-                    measurement.record(field: "field\(index)", value: index as AnyObject, timestamp: nil)
+                    measurement.record(field: .counter,
+                                       value: index,
+                                       timestamp: nil,
+                                       tags: .dynamic(["index": "\(index)"]))
+                    return 0
                 }
             }
             for _ in 0..<10 {
                 group.addTask {
-                    _ = measurement.drain()
+                    measurement.drain(into: QInfluxLineEncoder())
                 }
             }
+            return await group.reduce(0, +)
         }
 
-        // Final drain should get whatever remains — no crash = success.
-        _ = measurement.drain()
+        // Every sample has its own tags, so its own line, and is drained exactly once.
+        drained += measurement.drain(into: QInfluxLineEncoder())
+        #expect(drained == iterations)
     }
 }
@@ -0,0 +1,192 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Foundation
+import Synchronization
+import Testing
+@testable import QuicR
+
+struct ObjectCacheTests {
+    private func track(_ index: Int) throws -> FullTrackName {
+        try .init(namespace: ["cache", "\(index)"], name: "video")
+    }
+
+    private func insert(_ cache: ObjectCache, _ track: FullTrackName, group: UInt64, objects: Range<UInt64>, bytes: Int) {
+        for objectId in objects {
+            cache.insert(track,
+                         headers: .init(groupId: group,
+                                        subgroupId: 0,
+                                        objectId: objectId,
+                                        payloadLength: UInt64(bytes),
+                                        status: .available,
+                                        priority: nil,
+                                        ttl: nil),
+                         data: Data(repeating: UInt8(truncatingIfNeeded: objectId), count: bytes),
+                         extensions: nil)
+        }
+    }
+
+    @Test("A received group can be joined")
+    func hit() throws {
+        let cache = ObjectCache(budget: 1_000_000, metricsSubmitter: nil)
+        let track = try self.track(0)
+        self.insert(cache, track, group: 5, objects: 0..<10, bytes: 100)
+        let objects = try #require(cache.objects(track, groupId: 5, before: 10))
+        #expect(objects.map(\.objectId) == Array(0..<10))
+        #expect(objects.allSatisfy { $0.data == Data(repeating: UInt8($0.objectId), count: 100) })
+        #expect(objects.allSatisfy { $0.groupId == 5 })
+        #expect(cache.stats == .init(hits: 1, misses: 0, evictions: 0, bytes: 1000))
+    }
+
+    @Test("Payloads are copied, so a pooled receive buffer isn't held")
+    func copies() throws {
+        final class Released: Sendable {
+            let value = Atomic(false)
+        }
+        let released = Released()
+        let cache = ObjectCache(budget: 1_000_000, metricsSubmitter: nil)
+        let track = try self.track(0)
+        do {
+            let buffer = UnsafeMutableRawPointer.allocate(byteCount: 100, alignment: 1)
+            buffer.initializeMemory(as: UInt8.self, repeating: 7, count: 100)
+            let data = Data(bytesNoCopy: buffer, count: 100, deallocator: .custom { pointer, _ in
+                pointer.deallocate()
+                released.value.store(true, ordering: .relaxed)
+            })
+            cache.insert(track,
+                         headers: .init(groupId: 1,
+                                        subgroupId: 0,
+                                        objectId: 0,
+                                        payloadLength: 100,
+                                        status: .available,
+                                        priority: nil,
+                                        ttl: nil),
+                         data: data,
+                         extensions: nil)
+        }
+        #expect(released.value.load(ordering: .relaxed))
+        let objects = try #require(cache.objects(track, groupId: 1, before: 1))
+        #expect(objects.first?.data == Data(repeating: 7, count: 100))
+    }
+
+    @Test("Groups without their start can't be joined")
+    func miss() throws {
+        let cache = ObjectCache(budget: 1_000_000, metricsSubmitter: nil)
+        let track = try self.track(0)
+        // Joined mid group: nothing useful to keep.
+        self.insert(cache, track, group: 5, objects: 3..<10, bytes: 100)
+        #expect(cache.objects(track, groupId: 5, before: 5) == nil)
+        #expect(cache.stats.bytes == 0)
+
+        // Other groups and unknown tracks miss too.
+        self.insert(cache, track, group: 6, objects: 0..<10, bytes: 100)
+        #expect(cache.objects(track, groupId: 7, before: 5) == nil)
+        #expect(cache.objects(try self.track(1), groupId: 6, before: 5) == nil)
+        // Further in than has been received.
+        #expect(cache.objects(track, groupId: 6, before: 20) == nil)
+        #expect(cache.stats.misses == 4)
+    }
+
+    @Test("A new group replaces the last")
+    func replace() throws {
+        let cache = ObjectCache(budget: 1_000_000, metricsSubmitter: nil)
+        let track = try self.track(0)
+        self.insert(cache, track, group: 1, objects: 0..<10, bytes: 100)
+        self.insert(cache, track, group: 2, objects: 0..<3, bytes: 100)
+        #expect(cache.stats.bytes == 300)
+        #expect(cache.objects(track, groupId: 1, before: 5) == nil)
+        #expect(cache.objects(track, groupId: 2, before: 3) != nil)
+
+        // Late objects of an older group don't displace the newer.
+        self.insert(cache, track, group: 1, objects: 0..<1, bytes: 100)
+        #expect(cache.objects(track, groupId: 2, before: 3) != nil)
+        #expect(cache.stats.evictions == 0)
+    }
+
+    @Test("The least recently used group is evicted")
+    func eviction() throws {
+        let cache = ObjectCache(budget: 2000, metricsSubmitter: nil)
+        let tracks = try (0..<3).map { try self.track($0) }
+        self.insert(cache, tracks[0], group: 0, objects: 0..<10, bytes: 100)
+        self.insert(cache, tracks[1], group: 0, objects: 0..<10, bytes: 100)
+        // Use the older, so that the other is least recent.
+        #expect(cache.objects(tracks[0], groupId: 0, before: 10) != nil)
+        self.insert(cache, tracks[2], group: 0, objects: 0..<1, bytes: 100)
+        #expect(cache.objects(tracks[1], groupId: 0, before: 1) == nil)
+        #expect(cache.objects(tracks[0], groupId: 0, before: 10) != nil)
+        #expect(cache.objects(tracks[2], groupId: 0, before: 1) != nil)
+        #expect(cache.stats.evictions == 1)
+        #expect(cache.stats.bytes == 1100)
+    }
+
+    @Test("A group larger than the budget isn't kept")
+    func oversize() throws {
+        let cache = ObjectCache(budget: 1000, metricsSubmitter: nil)
+        let track = try self.track(0)
+        self.insert(cache, track, group: 0, objects: 0..<20, bytes: 100)
+        #expect(cache.stats.bytes == 0)
+        #expect(cache.objects(track, groupId: 0, before: 15) == nil)
+        // Nor the rest of it, its start having gone.
+        #expect(cache.objects(track, groupId: 0, before: 5) == nil)
+    }
+
+    /// Active speaker switching across a call, each switch joining a speaker mid group.
+    ///
+    /// Every speaker's video is received continuously, held paused while not shown, at 30fps in 2s groups of a 40KB
+    /// key frame then 4KB frames. Switches are to a recent speaker three times in four, otherwise to anyone. Each
+    /// insert copies its object, which is the cost the receive path pays for every object of a paused track.
+    @Test("Switching", arguments: [(16, 4), (16, 32), (100, 32), (100, 256)])
+    func switching(speakers: Int, budgetMB: Int) throws {
+        let cache = ObjectCache(budget: budgetMB * 1024 * 1024, metricsSubmitter: nil)
+        let tracks = try (0..<speakers).map { try self.track($0) }
+        let keyFrame = Data(count: 40_000)
+        let frame = Data(count: 4000)
+        let frames = 30 * 60
+        var generator = SystemRandomNumberGenerator()
+        var recent: [Int] = [0]
+        var hits = 0
+        var switches = 0
+        var insertTime: TimeInterval = 0
+        var inserts = 0
+        var copied = 0
+        for index in 0..<frames {
+            let groupId = UInt64(index / 60)
+            let objectId = UInt64(index % 60)
+            let start = Ticks.now
+            for track in tracks {
+                cache.insert(track,
+                             headers: .init(groupId: groupId,
+                                            subgroupId: 0,
+                                            objectId: objectId,
+                                            payloadLength: 0,
+                                            status: .available,
+                                            priority: nil,
+                                            ttl: nil),
+                             data: objectId == 0 ? keyFrame : frame,
+                             extensions: nil)
+            }
+            insertTime += Ticks.now.timeIntervalSince(start)
+            inserts += tracks.count
+            copied += tracks.count * (objectId == 0 ? keyFrame.count : frame.count)
+
+            // Switch every second or so.
+            guard index % 30 == 29 else { continue }
+            let speaker = Int.random(in: 0..<4, using: &generator) < 3 ?
+                recent.randomElement(using: &generator)! :
+                Int.random(in: 0..<speakers, using: &generator)
+            if cache.objects(tracks[speaker], groupId: groupId, before: objectId + 1) != nil {
+                hits += 1
+            }
+            switches += 1
+            recent.removeAll { $0 == speaker }
+            recent.append(speaker)
+            recent = recent.suffix(4)
+        }
+        let stats = cache.stats
+        #expect(stats.hits == hits)
+        #expect(stats.bytes <= budgetMB * 1024 * 1024)
+        print("Object cache, \(speakers) speakers, \(budgetMB)MB: hit rate \(Double(hits) / Double(switches)), " +
+              "\(stats.evictions) evictions, \(insertTime / Double(inserts) * 1_000_000)µs per insert, " +
+              "\(Double(copied) / insertTime / 1_000_000)MB/s copied")
+    }
+}
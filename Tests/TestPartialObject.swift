@@ -0,0 +1,284 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Foundation
+import Synchronization
+import Testing
+@testable import QuicR
+
+struct PartialObjectTests {
+    private func headers(groupId: UInt64 = 0,
+                         subgroupId: UInt64 = 0,
+                         objectId: UInt64 = 0,
+                         payloadLength: Int) -> QObjectHeaders {
+        .init(groupId: groupId,
+              subgroupId: subgroupId,
+              objectId: objectId,
+              payloadLength: UInt64(payloadLength),
+              status: .available,
+              priority: nil,
+              ttl: nil)
+    }
+
+    private func payload(_ count: Int) -> Data {
+        Data((0..<count).map { UInt8(truncatingIfNeeded: $0) })
+    }
+
+    @Test("Pieces assemble into the whole object")
+    func assemble() {
+        var assembler = PartialObjectAssembler()
+        let data = self.payload(1000)
+        let headers = self.headers(payloadLength: data.count)
+        #expect(assembler.append(headers, data: data[0..<400], extensions: nil, immutableExtensions: nil) == nil)
+        #expect(assembler.append(headers, data: data[400..<800], extensions: nil, immutableExtensions: nil) == nil)
+        let whole = assembler.append(headers, data: data[800...], extensions: nil, immutableExtensions: nil)
+        #expect(whole?.data == data)
+        #expect(assembler.incomplete == 0)
+    }
+
+    @Test("Extensions come from the first piece")
+    func extensions() throws {
+        var assembler = PartialObjectAssembler()
+        var extensions = HeaderExtensions()
+        extensions[1] = [Data([1, 2, 3])]
+        let data = self.payload(10)
+        let headers = self.headers(payloadLength: data.count)
+        _ = assembler.append(headers, data: data[0..<5], extensions: extensions, immutableExtensions: nil)
+        let whole = try #require(assembler.append(headers, data: data[5...], extensions: nil, immutableExtensions: nil))
+        #expect(whole.extensions == extensions)
+        #expect(whole.immutableExtensions == nil)
+    }
+
+    @Test("An object superseded before completing is dropped")
+    func incomplete() {
+        var assembler = PartialObjectAssembler()
+        let data = self.payload(100)
+        _ = assembler.append(self.headers(objectId: 0, payloadLength: data.count),
+                             data: data[0..<50],
+                             extensions: nil,
+                             immutableExtensions: nil)
+        let next = self.headers(objectId: 1, payloadLength: data.count)
+        #expect(assembler.append(next, data: data[0..<50], extensions: nil, immutableExtensions: nil) == nil)
+        #expect(assembler.append(next, data: data[50...], extensions: nil, immutableExtensions: nil)?.data == data)
+        #expect(assembler.incomplete == 1)
+    }
+
+    @Test("Objects on interleaved streams assemble independently")
+    func interleaved() {
+        var assembler = PartialObjectAssembler(maxStreams: 2)
+        let base = self.payload(100)
+        let enhancement = Data(self.payload(60).reversed())
+        let baseHeaders = self.headers(subgroupId: 0, payloadLength: base.count)
+        let enhancementHeaders = self.headers(subgroupId: 1, payloadLength: enhancement.count)
+        #expect(assembler.append(baseHeaders, data: base[0..<50], extensions: nil, immutableExtensions: nil) == nil)
+        #expect(assembler.append(enhancementHeaders,
+                                 data: enhancement[0..<30],
+                                 extensions: nil,
+                                 immutableExtensions: nil) == nil)
+        #expect(assembler.append(baseHeaders, data: base[50...], extensions: nil, immutableExtensions: nil)?.data == base)
+        #expect(assembler.append(enhancementHeaders,
+                                 data: enhancement[30...],
+                                 extensions: nil,
+                                 immutableExtensions: nil)?.data == enhancement)
+        #expect(assembler.incomplete == 0)
+
+        // Beyond the most streams at once, the longest waiting is given up on.
+        for subgroupId in UInt64(0)..<3 {
+            _ = assembler.append(self.headers(groupId: 1, subgroupId: subgroupId, payloadLength: base.count),
+                                 data: base[0..<50],
+                                 extensions: nil,
+                                 immutableExtensions: nil)
+        }
+        #expect(assembler.incomplete == 1)
+        #expect(assembler.append(self.headers(groupId: 1, subgroupId: 2, payloadLength: base.count),
+                                 data: base[50...],
+                                 extensions: nil,
+                                 immutableExtensions: nil)?.data == base)
+    }
+
+    @Test("Large objects are published in pieces")
+    func pieces() throws {
+        let sink = MockSink(fullTrackName: try FullTrackName(namespace: ["partial"], name: "video"))
+        var pieces: [Int] = []
+        var wholes = 0
+        sink.onPublishPartial = { _, _, bytes in pieces.append(bytes) }
+        sink.onPublish = { _, _ in wholes += 1 }
+
+        let large = self.payload(2500)
+        #expect(sink.publishObject(self.headers(payloadLength: large.count),
+                                   data: large,
+                                   pieceSize: 1000,
+                                   extensions: nil,
+                                   immutableExtensions: nil) == .ok)
+        #expect(pieces == [1000, 1000, 500])
+        #expect(wholes == 0)
+
+        let small = self.payload(500)
+        #expect(sink.publishObject(self.headers(payloadLength: small.count),
+                                   data: small,
+                                   pieceSize: 1000,
+                                   extensions: nil,
+                                   immutableExtensions: nil) == .ok)
+        #expect(wholes == 1)
+    }
+
+    @Test("Pieces are accepted as needing more of the object, then completing it")
+    func pieceStatuses() throws {
+        let sink = MockSink(fullTrackName: try FullTrackName(namespace: ["partial"], name: "video"))
+        var published = 0
+        var statuses: [QPublishObjectStatus] = []
+        // As libquicr reports them.
+        sink.partialStatus = { headers, bytes in
+            published += bytes
+            let status: QPublishObjectStatus = UInt64(published) < headers.payloadLength ?
+                .objectContinuationDataNeeded :
+                .objectDataComplete
+            statuses.append(status)
+            return status
+        }
+        let large = self.payload(2500)
+        #expect(sink.publishObject(self.headers(payloadLength: large.count),
+                                   data: large,
+                                   pieceSize: 1000,
+                                   extensions: nil,
+                                   immutableExtensions: nil) == .ok)
+        #expect(statuses == [.objectContinuationDataNeeded, .objectContinuationDataNeeded, .objectDataComplete])
+
+        // A failed piece stops the rest.
+        statuses = []
+        sink.partialStatus = { _, _ in
+            statuses.append(.noSubscribers)
+            return .noSubscribers
+        }
+        #expect(sink.publishObject(self.headers(payloadLength: large.count),
+                                   data: large,
+                                   pieceSize: 1000,
+                                   extensions: nil,
+                                   immutableExtensions: nil) == .noSubscribers)
+        #expect(statuses == [.noSubscribers])
+    }
+
+    @Test("Sinks that can't publish pieces are given objects whole")
+    func unsupported() throws {
+        let sink = MockSink(fullTrackName: try FullTrackName(namespace: ["partial"], name: "video"))
+        sink.mockSupportsPartialObjects = false
+        var pieces = 0
+        var wholes = 0
+        sink.onPublishPartial = { _, _, _ in pieces += 1 }
+        sink.onPublish = { _, _ in wholes += 1 }
+        let large = self.payload(2500)
+        #expect(sink.publishObject(self.headers(payloadLength: large.count),
+                                   data: large,
+                                   pieceSize: 1000,
+                                   extensions: nil,
+                                   immutableExtensions: nil) == .ok)
+        #expect(pieces == 0)
+        #expect(wholes == 1)
+    }
+}
+
+/// Records when an object's first bytes and the whole object arrive.
+private final class TimingSubscription: Subscription, @unchecked Sendable {
+    struct Timing {
+        var firstByte: Ticks?
+        var complete: Ticks?
+        var data: Data?
+    }
+
+    let timing = Mutex(Timing())
+
+    init(_ fullTrackName: FullTrackName) throws {
+        try super.init(fullTrackName: fullTrackName,
+                       endpointId: "partial",
+                       relayId: "loopback",
+                       metricsSubmitter: nil,
+                       priority: 0,
+                       groupOrder: .originalPublisherOrder,
+                       filterType: .none,
+                       publisherInitiated: false,
+                       deliveryTimeout: nil,
+                       statusCallback: nil)
+    }
+
+    override func partialObjectReceived(_ objectHeaders: QObjectHeaders,
+                                        data: Data,
+                                        extensions: HeaderExtensions?,
+                                        immutableExtensions: HeaderExtensions?) {
+        let now = Ticks.now
+        self.timing.withLock { $0.firstByte = $0.firstByte ?? now }
+        super.partialObjectReceived(objectHeaders,
+                                    data: data,
+                                    extensions: extensions,
+                                    immutableExtensions: immutableExtensions)
+    }
+
+    override func objectReceived(_ objectHeaders: QObjectHeaders,
+                                 data: Data,
+                                 extensions: HeaderExtensions?,
+                                 immutableExtensions: HeaderExtensions?,
+                                 streamHeaderProperties: QStreamHeaderProperties?) {
+        let now = Ticks.now
+        self.timing.withLock {
+            $0.firstByte = $0.firstByte ?? now
+            $0.complete = now
+            $0.data = Data(data)
+        }
+    }
+}
+
+/// A key frame over a constrained link through the loopback relay, published whole and in pieces.
+@Suite(.serialized)
+struct PartialObjectLoopbackTests {
+    private struct Result {
+        let firstByte: TimeInterval
+        let complete: TimeInterval
+    }
+
+    private func send(_ data: Data, pieceSize: Int) async throws -> Result {
+        // 20Mbps: a 250KB key frame takes 100ms on the wire.
+        let relay = LoopbackRelay(delay: 0.005, bitrate: 20_000_000)
+        let name = try FullTrackName(namespace: ["partial", "\(pieceSize)"], name: "video")
+        let subscription = try TimingSubscription(name)
+        relay.subscribe(name, subscription: subscription)
+        let sink = relay.makeSink(name)
+
+        let start = Ticks.now
+        let status = sink.publishObject(.init(groupId: 0,
+                                              subgroupId: 0,
+                                              objectId: 0,
+                                              payloadLength: UInt64(data.count),
+                                              status: .available,
+                                              priority: nil,
+                                              ttl: nil),
+                                        data: data,
+                                        pieceSize: pieceSize,
+                                        extensions: nil,
+                                        immutableExtensions: nil)
+        #expect(status == .ok)
+        while subscription.timing.withLock({ $0.complete == nil }) {
+            try await Task.sleep(for: .milliseconds(5))
+        }
+        relay.unsubscribe(name, subscription: subscription)
+
+        var timing = TimingSubscription.Timing()
+        subscription.timing.withLock { timing = $0 }
+        #expect(timing.data == data)
+        return .init(firstByte: timing.firstByte!.timeIntervalSince(start),
+                     complete: timing.complete!.timeIntervalSince(start))
+    }
+
+    @Test("Time to first byte and to complete", .timeLimit(.minutes(1)))
+    func timeToFirstByte() async throws {
+        let keyFrame = Data((0..<250_000).map { UInt8(truncatingIfNeeded: $0 &* 31) })
+        let whole = try await self.send(keyFrame, pieceSize: 0)
+        let pieces = try await self.send(keyFrame, pieceSize: 16 * 1024)
+        for (label, result) in [("whole", whole), ("16KB pieces", pieces)] {
+            print("Partial objects, \(label): first byte \(result.firstByte * 1000)ms, " +
+                  "complete \(result.complete * 1000)ms")
+        }
+        // The first piece arrives after its own transmission, not the whole object's.
+        #expect(pieces.firstByte < whole.firstByte / 2)
+        // Pieces add no meaningful cost to the whole.
+        #expect(pieces.complete < whole.complete * 1.5)
+    }
+}
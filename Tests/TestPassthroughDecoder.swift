@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import CoreMedia
+import Testing
+@testable import QuicR
+
+struct PassthroughDecoderTests {
+    private let config = VideoCodecConfig(codec: .mock,
+                                          bitrate: 2_000_000,
+                                          fps: 30,
+                                          width: 1280,
+                                          height: 720,
+                                          bitrateType: .average)
+
+    private func sample(_ presentation: CMTime) throws -> CMSampleBuffer {
+        try CMSampleBuffer(dataBuffer: nil,
+                           formatDescription: nil,
+                           numSamples: 1,
+                           sampleTimings: [.init(duration: .init(value: 1, timescale: 30),
+                                                 presentationTimeStamp: presentation,
+                                                 decodeTimeStamp: .invalid)],
+                           sampleSizes: [])
+    }
+
+    @Test("Images carry the frame's timing at the stream's size")
+    func passthrough() async throws {
+        let decoder = PassthroughDecoder(config: self.config, decodeBufferSize: 10)
+        let frames = try (0..<3).map { try self.sample(.init(value: $0, timescale: 30)) }
+        frames[1].discontinous = true
+        for frame in frames {
+            try decoder.write(frame)
+        }
+
+        var iterator = decoder.decoded.makeAsyncIterator()
+        for frame in frames {
+            let decoded = try #require(await iterator.next())
+            let image = try #require(decoded.imageBuffer)
+            #expect(CVPixelBufferGetWidth(image) == 1280)
+            #expect(CVPixelBufferGetHeight(image) == 720)
+            #expect(decoded.formatDescription?.dimensions.width == 1280)
+            #expect(decoded.presentationTimeStamp == frame.presentationTimeStamp)
+            #expect(decoded.duration == frame.duration)
+            #expect(decoded.discontinous == frame.discontinous)
+        }
+    }
+
+    @Test("Backend selection")
+    func backends() {
+        #expect(VideoDecoderBackend.passthrough.makeDecoder(config: self.config,
+                                                            decodeBufferSize: 1) is PassthroughDecoder)
+        #expect(VideoDecoderBackend.videoToolbox.makeDecoder(config: self.config,
+                                                             decodeBufferSize: 1) is VTDecoder)
+    }
+
+    /// Decode throughput of many streams at once, as a call with that many video subscriptions would see.
+    @Test("Throughput", arguments: [1, 10, 50])
+    func throughput(streams: Int) async throws {
+        let framesPerStream = 300
+        let decoders = (0..<streams).map { _ in
+            PassthroughDecoder(config: self.config, decodeBufferSize: 2)
+        }
+        let start = Ticks.now
+        try await withThrowingTaskGroup(of: Void.self) { group in
+            for decoder in decoders {
+                group.addTask {
+                    // Consume as rendering would, so that images return to the pool.
+                    var iterator = decoder.decoded.makeAsyncIterator()
+                    for frame in 0..<framesPerStream {
+                        try decoder.write(try self.sample(.init(value: CMTimeValue(frame), timescale: 30)))
+                        _ = try #require(await iterator.next())
+                    }
+                }
+            }
+            try await group.waitForAll()
+        }
+        let elapsed = Ticks.now.timeIntervalSince(start)
+        print("Passthrough decode, \(streams) streams: \(Double(streams * framesPerStream) / elapsed) frames/s")
+    }
+}
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import XCTest
+@testable import QuicR
+
+final class TestPayloadPool: XCTestCase {
+    func testDataOutlivesScope() {
+        let pool = QPayloadPool(slotSize: 16, slots: 2)
+        let bytes: [UInt8] = [1, 2, 3, 4, 5]
+        var data: Data?
+        autoreleasepool {
+            data = bytes.withUnsafeBytes { pool.data(withBytes: $0.baseAddress, length: $0.count) }
+        }
+        XCTAssertEqual(data, Data(bytes))
+        XCTAssertEqual(pool.stats(forPool: 0).inUse, 1)
+        data = nil
+        XCTAssertEqual(pool.stats(forPool: 0).inUse, 0)
+    }
+
+    func testCountsAndReuse() {
+        let pool = QPayloadPool(slotSize: 16, slots: 2)
+        let bytes = [UInt8](repeating: 0xAB, count: 8)
+        var held: [Data] = []
+        autoreleasepool {
+            for _ in 0..<2 {
+                held.append(bytes.withUnsafeBytes { pool.data(withBytes: $0.baseAddress, length: $0.count) })
+            }
+        }
+        var stats = pool.stats(forPool: 0)
+        XCTAssertEqual(stats.capacity, 2)
+        XCTAssertEqual(stats.inUse, 2)
+        XCTAssertEqual(stats.highWaterMark, 2)
+        XCTAssertEqual(stats.overflows, 0)
+
+        // Exhausted, so this one comes from the heap.
+        autoreleasepool {
+            held.append(bytes.withUnsafeBytes { pool.data(withBytes: $0.baseAddress, length: $0.count) })
+        }
+        XCTAssertEqual(pool.stats(forPool: 0).overflows, 1)
+        XCTAssertEqual(held.last, Data(bytes))
+
+        // Released slots are handed out again.
+        held.removeAll()
+        autoreleasepool {
+            held.append(bytes.withUnsafeBytes { pool.data(withBytes: $0.baseAddress, length: $0.count) })
+        }
+        stats = pool.stats(forPool: 0)
+        XCTAssertEqual(stats.inUse, 1)
+        XCTAssertEqual(stats.highWaterMark, 2)
+        XCTAssertEqual(stats.overflows, 1)
+        XCTAssertEqual(stats.acquired, 4)
+    }
+
+    func testOversizeFallsBackToHeap() {
+        let pool = QPayloadPool(slotSize: 4, slots: 1)
+        let bytes = [UInt8](0..<32)
+        let data = bytes.withUnsafeBytes { pool.data(withBytes: $0.baseAddress, length: $0.count) }
+        XCTAssertEqual(data, Data(bytes))
+        let stats = pool.stats(forPool: 0)
+        XCTAssertEqual(stats.inUse, 0)
+        XCTAssertEqual(stats.overflows, 1)
+    }
+
+    func testSharedSizeClasses() {
+        let pool = QPayloadPool.shared()
+        XCTAssertGreaterThan(pool.poolCount(), 1)
+        var previous = 0
+        for index in 0..<pool.poolCount() {
+            let slotSize = pool.stats(forPool: index).slotSize
+            XCTAssertGreaterThan(slotSize, previous)
+            previous = slotSize
+        }
+    }
+
+    func testPerformancePooled() {
+        let pool = QPayloadPool(slotSize: 2048, slots: 64)
+        let bytes = [UInt8](repeating: 0x42, count: 1200)
+        measure {
+            for _ in 0..<10_000 {
+                autoreleasepool {
+                    _ = bytes.withUnsafeBytes { pool.data(withBytes: $0.baseAddress, length: $0.count) }
+                }
+            }
+        }
+    }
+
+    func testPerformanceCopy() {
+        let bytes = [UInt8](repeating: 0x42, count: 1200)
+        measure {
+            for _ in 0..<10_000 {
+                autoreleasepool {
+                    _ = bytes.withUnsafeBytes { NSData(bytes: $0.baseAddress, length: $0.count) }
+                }
+            }
+        }
+    }
+}
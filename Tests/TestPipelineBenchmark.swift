@@ -0,0 +1,344 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import CoreMedia
+import Foundation
+import Synchronization
+import Testing
+@testable import QuicR
+
+private enum SyntheticMedia {
+    /// Opus sized objects, 20ms apart, each their own group.
+    case audio
+    /// H.264 sized objects at 30fps, in 2 second groups starting with a key frame.
+    case video
+
+    var interval: TimeInterval {
+        switch self {
+        case .audio: 0.02
+        case .video: 1 / 30
+        }
+    }
+
+    var groupLength: UInt64 {
+        switch self {
+        case .audio: 1
+        case .video: 60
+        }
+    }
+
+    func bytes(sequence: UInt64, random: inout SeededGenerator) -> Int {
+        switch self {
+        case .audio:
+            .random(in: 80...160, using: &random)
+        case .video:
+            sequence % self.groupLength == 0 ? 40_000 : .random(in: 3_200...4_800, using: &random)
+        }
+    }
+}
+
+private let maxObjectBytes = 40_000
+
+/// Publishes one track of synthetic objects, with LOC capture timestamp and sequence number extensions.
+private final class SyntheticPublisher: Sendable {
+    private struct State {
+        var random: SeededGenerator
+        var sequence: UInt64 = 0
+    }
+
+    let media: SyntheticMedia
+    private let sink: MoQSink
+    private let payload = Data(repeating: 0xA5, count: maxObjectBytes)
+    private let state: Mutex<State>
+
+    init(_ media: SyntheticMedia, sink: MoQSink, seed: UInt64) {
+        self.media = media
+        self.sink = sink
+        self.state = .init(.init(random: .init(state: seed)))
+    }
+
+    func publish() {
+        var sequence: UInt64 = 0
+        var bytes = 0
+        self.state.withLock { state in
+            sequence = state.sequence
+            bytes = self.media.bytes(sequence: sequence, random: &state.random)
+            state.sequence += 1
+        }
+        var extensions = HeaderExtensions()
+        try? extensions.setHeader(.captureTimestamp(.now))
+        try? extensions.setHeader(.sequenceNumber(sequence))
+        let data = self.payload.prefix(bytes)
+        let status = self.sink.publishObject(.init(groupId: sequence / self.media.groupLength,
+                                                   subgroupId: 0,
+                                                   objectId: sequence % self.media.groupLength,
+                                                   payloadLength: UInt64(data.count),
+                                                   status: .available,
+                                                   priority: nil,
+                                                   ttl: nil),
+                                             data: data,
+                                             extensions: extensions,
+                                             immutableExtensions: nil,
+                                             streamHeaderProperties: nil)
+        assert(status == .ok)
+    }
+}
+
+private final class BenchmarkItem: JitterBuffer.JitterItem {
+    let sequenceNumber: UInt64
+    let timestamp: CMTime
+    let duration: CMTime
+    let capture: Date
+
+    init(sequenceNumber: UInt64, capture: Date, duration: TimeInterval) {
+        self.sequenceNumber = sequenceNumber
+        self.capture = capture
+        self.timestamp = .init(seconds: capture.timeIntervalSince1970, preferredTimescale: 1_000_000)
+        self.duration = .init(seconds: duration, preferredTimescale: 1_000_000)
+    }
+}
+
+private final class Recorder: Sendable {
+    private let latencies = Mutex<[TimeInterval]>([])
+    private let lostCount = Atomic<Int>(0)
+
+    var played: [TimeInterval] {
+        self.latencies.get()
+    }
+
+    var lost: Int {
+        self.lostCount.load(ordering: .relaxed)
+    }
+
+    func record(_ latency: TimeInterval) {
+        self.latencies.withLock { $0.append(latency) }
+    }
+
+    func recordLost() {
+        self.lostCount.add(1, ordering: .relaxed)
+    }
+}
+
+/// One subscriber's receive side of one track: subscription, jitter buffer, and playout.
+private final class TrackPlayout: Sendable {
+    private let media: SyntheticMedia
+    private let buffer: JitterBuffer
+    private let offset = Mutex<HostTimeOffset?>(nil)
+    private let recorder: Recorder
+
+    init(_ media: SyntheticMedia, depth: TimeInterval, recorder: Recorder) throws {
+        self.media = media
+        self.buffer = try .init(identifier: "benchmark",
+                                metricsSubmitter: nil,
+                                minDepth: depth,
+                                capacity: 4096)
+        self.recorder = recorder
+    }
+
+    func makeSubscription(_ fullTrackName: FullTrackName) throws -> Subscription {
+        try CallbackSubscription(fullTrackName: fullTrackName,
+                                 endpointId: "benchmark",
+                                 relayId: "loopback",
+                                 metricsSubmitter: nil,
+                                 priority: 0,
+                                 groupOrder: .originalPublisherOrder,
+                                 filterType: .none,
+                                 publisherInitiated: false,
+                                 deliveryTimeout: nil,
+                                 callback: { [weak self] _, _, extensions, _ in
+                                    self?.receive(extensions)
+                                 },
+                                 statusCallback: { _ in })
+    }
+
+    private func receive(_ extensions: HeaderExtensions?) {
+        guard let extensions,
+              case .captureTimestamp(let capture) = try? extensions.getHeader(.captureTimestamp),
+              case .sequenceNumber(let sequence) = try? extensions.getHeader(.sequenceNumber) else {
+            self.recorder.recordLost()
+            return
+        }
+        let item = BenchmarkItem(sequenceNumber: sequence, capture: capture, duration: self.media.interval)
+        self.offset.withLock { offset in
+            if offset == nil {
+                offset = .init(senderTimestamp: item.timestamp.seconds, receiverHostTime: .now)
+            }
+        }
+        do {
+            try self.buffer.write(item: item, from: .now)
+        } catch {
+            self.recorder.recordLost()
+        }
+    }
+
+    /// Play out everything due, returning when next to.
+    func play(_ now: Ticks) -> TimeInterval? {
+        let poll = 0.005
+        guard let offset = self.offset.get() else { return poll }
+        while let wait = self.buffer.calculateWaitTime(from: now, offset: offset) {
+            guard wait <= 0 else { return wait }
+            let item: BenchmarkItem? = self.buffer.read(from: now.hostDate)
+            if let item {
+                self.recorder.record(Date.now.timeIntervalSince(item.capture))
+            }
+        }
+        return poll
+    }
+}
+
+private struct Load: Sendable, CustomTestStringConvertible {
+    let publishers: Int
+    let subscribers: Int
+
+    var testDescription: String {
+        "\(self.publishers) publishers, \(self.subscribers) subscribers"
+    }
+}
+
+private struct Report {
+    let objects: Int
+    let seconds: TimeInterval
+    let cpuSeconds: TimeInterval
+    let latencies: [TimeInterval]
+    let lost: Int
+
+    func percentile(_ fraction: Double) -> TimeInterval {
+        guard !self.latencies.isEmpty else { return .infinity }
+        let sorted = self.latencies.sorted()
+        return sorted[min(sorted.count - 1, Int(Double(sorted.count) * fraction))]
+    }
+
+    func print(_ name: String, load: Load) {
+        Swift.print("Pipeline \(name), \(load.testDescription): " +
+                    "\(Int(Double(self.objects) / self.seconds)) objects/s, " +
+                    "\(self.cpuSeconds / Double(max(self.objects, 1)) * microsecondsPerSecond)us CPU/object, " +
+                    "p50 \(self.percentile(0.5) * 1000)ms, p99 \(self.percentile(0.99) * 1000)ms, lost \(self.lost)")
+    }
+}
+
+/// Publish, relay, subscribe, jitter buffer, and playout of synthetic media, end to end in process.
+///
+/// Every publisher is a participant publishing an audio and a video track, to which every subscriber
+/// subscribes. Latency is from capture timestamp to playout, so includes the jitter buffer's depth.
+@Suite("Pipeline benchmark", .serialized)
+struct PipelineBenchmarkTests {
+    private struct Pipeline {
+        let relay: LoopbackRelay
+        let publishers: [SyntheticPublisher]
+        let recorder: Recorder
+        let playout: DeadlineScheduler
+        let tokens: [DeadlineScheduler.Token]
+
+        init(_ load: Load, depth: TimeInterval, relayDelay: TimeInterval) throws {
+            self.relay = .init(delay: relayDelay)
+            self.recorder = .init()
+            self.playout = .init(label: "BenchmarkPlayout")
+            var publishers: [SyntheticPublisher] = []
+            var tokens: [DeadlineScheduler.Token] = []
+            for publisher in 0..<load.publishers {
+                for media in [SyntheticMedia.audio, .video] {
+                    let name = try FullTrackName(namespace: ["benchmark", "\(publisher)"], name: "\(media)")
+                    publishers.append(.init(media,
+                                            sink: self.relay.makeSink(name),
+                                            seed: UInt64(publishers.count + 1)))
+                    for _ in 0..<load.subscribers {
+                        let track = try TrackPlayout(media, depth: depth, recorder: self.recorder)
+                        let subscription = try track.makeSubscription(name)
+                        self.relay.subscribe(name, subscription: subscription)
+                        // The playout job holds the track, and the track its subscription's callback.
+                        tokens.append(self.playout.schedule { track.play($0) })
+                    }
+                }
+            }
+            self.publishers = publishers
+            self.tokens = tokens
+        }
+
+        /// Wait for every subscriber to play out, or lose, what was published.
+        func drain(_ expected: Int, timeout: TimeInterval) async throws {
+            let deadline = Ticks.now.addingTimeInterval(timeout)
+            while self.recorder.played.count + self.recorder.lost < expected, Ticks.now < deadline {
+                try await Task.sleep(for: .milliseconds(10))
+            }
+            for token in self.tokens {
+                self.playout.cancel(token)
+            }
+        }
+    }
+
+    private static func cpuTime() -> TimeInterval {
+        var usage = rusage()
+        getrusage(RUSAGE_SELF, &usage)
+        func seconds(_ time: timeval) -> TimeInterval {
+            TimeInterval(time.tv_sec) + TimeInterval(time.tv_usec) / microsecondsPerSecond
+        }
+        return seconds(usage.ru_utime) + seconds(usage.ru_stime)
+    }
+
+    /// Real time media over a relay hop: the latency a participant would see.
+    @Test("Real time",
+          arguments: [Load(publishers: 1, subscribers: 1), Load(publishers: 4, subscribers: 4),
+                      Load(publishers: 8, subscribers: 16)])
+    fileprivate func realTime(_ load: Load) async throws {
+        let depth = 0.06
+        let duration: TimeInterval = 3
+        let pipeline = try Pipeline(load, depth: depth, relayDelay: 0.01)
+        let capture = DeadlineScheduler(label: "BenchmarkCapture")
+        let stop = Ticks.now.addingTimeInterval(duration)
+        let startCpu = Self.cpuTime()
+        let start = Ticks.now
+        let tokens = pipeline.publishers.map { publisher in
+            capture.schedule { now in
+                guard now < stop else { return nil }
+                publisher.publish()
+                return publisher.media.interval
+            }
+        }
+        try await Task.sleep(for: .seconds(duration + 0.1))
+        for token in tokens {
+            capture.cancel(token)
+        }
+        try await pipeline.drain(pipeline.relay.objectsForwarded, timeout: 2)
+        let report = Report(objects: pipeline.relay.objectsForwarded,
+                            seconds: Ticks.now.timeIntervalSince(start),
+                            cpuSeconds: Self.cpuTime() - startCpu,
+                            latencies: pipeline.recorder.played,
+                            lost: pipeline.recorder.lost)
+        report.print("real time", load: load)
+
+        // Nothing lost, and nothing held much beyond the buffer's depth and the relay hop.
+        #expect(report.lost == 0)
+        #expect(report.latencies.count == report.objects)
+        #expect(report.percentile(0.99) < depth + 0.01 + 0.05)
+    }
+
+    /// Publishers as fast as they can: the most the pipeline can carry, and what each object costs.
+    @Test("Throughput",
+          arguments: [Load(publishers: 1, subscribers: 1), Load(publishers: 4, subscribers: 4),
+                      Load(publishers: 8, subscribers: 16)])
+    fileprivate func throughput(_ load: Load) async throws {
+        let objectsPerTrack = 2000
+        let pipeline = try Pipeline(load, depth: 0, relayDelay: 0)
+        let startCpu = Self.cpuTime()
+        let start = Ticks.now
+        await withTaskGroup(of: Void.self) { group in
+            for publisher in pipeline.publishers {
+                group.addTask {
+                    for _ in 0..<objectsPerTrack {
+                        publisher.publish()
+                    }
+                }
+            }
+        }
+        let expected = pipeline.publishers.count * objectsPerTrack * load.subscribers
+        try await pipeline.drain(expected, timeout: 30)
+        let report = Report(objects: pipeline.recorder.played.count,
+                            seconds: Ticks.now.timeIntervalSince(start),
+                            cpuSeconds: Self.cpuTime() - startCpu,
+                            latencies: pipeline.recorder.played,
+                            lost: pipeline.recorder.lost)
+        report.print("throughput", load: load)
+        #expect(report.objects == expected)
+        #expect(report.lost == 0)
+    }
+}
@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Foundation
+import Testing
+import OrderedCollections
+@testable import QuicR
+
+struct TestSpeakerPredictor {
+    @Test("Frequent and prominent speakers rank first")
+    func history() {
+        let predictor = SpeakerPredictor()
+        let now = Ticks.now
+        predictor.speakersChanged([.init(1), .init(2)], when: now)
+        predictor.speakersChanged([.init(3), .init(1)], when: now)
+        predictor.speakersChanged([.init(1)], when: now)
+        #expect(predictor.ranked(when: now) == [.init(1), .init(3), .init(2)])
+    }
+
+    @Test("Someone speaking now outranks history")
+    func voice() {
+        let predictor = SpeakerPredictor()
+        let now = Ticks.now
+        predictor.speakersChanged([.init(1), .init(2)], when: now)
+        predictor.audioLevel(.init(2), level: 10, when: now)
+        predictor.audioLevel(.init(3), level: 127, when: now)
+        #expect(predictor.ranked(when: now) == [.init(2), .init(1), .init(3)])
+    }
+
+    @Test("Old activity decays")
+    func decay() {
+        let predictor = SpeakerPredictor(historyHalfLife: 60, voiceHalfLife: 2)
+        let now = Ticks.now
+        predictor.speakersChanged([.init(1), .init(2)], when: now)
+        predictor.audioLevel(.init(2), level: 0, when: now)
+        #expect(predictor.ranked(when: now).first == .init(2))
+        // Voice has long since faded, history has not.
+        #expect(predictor.ranked(when: now.addingTimeInterval(20)).first == .init(1))
+        // A newer speaker overtakes a much older one.
+        predictor.speakersChanged([.init(3)], when: now.addingTimeInterval(300))
+        #expect(predictor.ranked(when: now.addingTimeInterval(300)).first == .init(3))
+    }
+}
+
+struct TestPreSubscriptionPool {
+    private func manifest(_ participant: UInt32) -> ManifestSubscription {
+        .init(mediaType: ManifestMediaTypes.video.rawValue,
+              sourceName: "\(participant)",
+              sourceID: "\(participant)",
+              label: "\(participant)",
+              participantId: .init(participant),
+              profileSet: .init(type: "video", profiles: [
+                .init(qualityProfile: "h264,width=1920,height=1080,fps=30,br=2000",
+                      expiry: nil,
+                      priorities: nil,
+                      namespace: ["\(participant)"])
+              ]))
+    }
+
+    private func controller() async throws -> (MoqCallController, TestActiveSpeaker.MockVideoSubscriptionFactory) {
+        let client = MockClient(publish: { _ in },
+                                unpublish: { _ in },
+                                subscribe: { _ in },
+                                unsubscribe: { _ in },
+                                fetch: { _ in },
+                                fetchCancel: { _ in })
+        let controller = MoqCallController(endpointUri: "4", client: client, submitter: nil) { }
+        try await controller.connect()
+        return (controller, TestActiveSpeaker.MockVideoSubscriptionFactory { _ in })
+    }
+
+    @Test("Likely speakers are held paused, and resumed when claimed")
+    func preSubscribe() async throws {
+        let (controller, factory) = try await self.controller()
+        let predictor = SpeakerPredictor()
+        var config = PreSubscriptionPool.Config()
+        config.count = 2
+        let pool = await PreSubscriptionPool(controller: controller,
+                                             videoSubscriptions: (1...4).map { self.manifest($0) },
+                                             factory: factory,
+                                             participantId: .init(4),
+                                             predictor: predictor,
+                                             config: config)
+
+        // 1 is rendered, 2 and 3 likely next, 4 is ourselves.
+        predictor.speakersChanged([.init(1), .init(2), .init(3), .init(4)], when: .now)
+        await pool.update(rendered: [.init(1)])
+        #expect(await pool.targets == [.init(2), .init(3)])
+        #expect(await pool.members == ["2", "3"])
+        let two = try #require(controller.getSubscriptionSet("2"))
+        #expect(two.isPaused)
+        #expect(controller.getSubscriptionSet("3")?.isPaused == true)
+        #expect(controller.getSubscriptionSet("1") == nil)
+        #expect(controller.getSubscriptionSet("4") == nil)
+
+        // Switching to 2 resumes it and releases it from the pool.
+        #expect(await pool.claim(two))
+        #expect(!two.isPaused)
+        #expect(await pool.members == ["3"])
+        #expect(await !pool.claim(two))
+
+        // No longer a target, 3 is unsubscribed.
+        await pool.update(rendered: [.init(1), .init(2), .init(3)])
+        #expect(await pool.members.isEmpty)
+        #expect(controller.getSubscriptionSet("3") == nil)
+    }
+
+    @Test("Released speakers are adopted only if likely")
+    func adopt() async throws {
+        let (controller, factory) = try await self.controller()
+        let predictor = SpeakerPredictor()
+        var config = PreSubscriptionPool.Config()
+        config.count = 1
+        let pool = await PreSubscriptionPool(controller: controller,
+                                             videoSubscriptions: (1...3).map { self.manifest($0) },
+                                             factory: factory,
+                                             participantId: .init(4),
+                                             predictor: predictor,
+                                             config: config)
+        let one = try controller.subscribeToSet(details: self.manifest(1), factory: factory, subscribeType: .subscribe)
+        let two = try controller.subscribeToSet(details: self.manifest(2), factory: factory, subscribeType: .subscribe)
+        predictor.speakersChanged([.init(1), .init(2)], when: .now)
+
+        // Both in use, so neither is taken.
+        await pool.update(rendered: [.init(1), .init(2)])
+        #expect(await pool.members.isEmpty)
+        #expect(!one.isPaused && !two.isPaused)
+
+        // Once released, the likelier is kept, paused.
+        await pool.update(rendered: [])
+        #expect(await pool.targets == [.init(1)])
+        #expect(await pool.adopt(one))
+        #expect(one.isPaused)
+        #expect(await !pool.adopt(two))
+        #expect(!two.isPaused)
+    }
+
+    @Test("Budgets limit the pool", arguments: [(6000, 64, 3), (4000, 64, 2), (6000, 25, 2), (0, 64, 0)])
+    func budgets(bitrateKbps: UInt32, memoryMB: Int, expected: Int) async throws {
+        let (controller, factory) = try await self.controller()
+        let predictor = SpeakerPredictor()
+        var config = PreSubscriptionPool.Config()
+        config.count = 5
+        config.bitrateKbps = bitrateKbps
+        config.memoryMB = memoryMB
+        let pool = await PreSubscriptionPool(controller: controller,
+                                             videoSubscriptions: (1...6).map { self.manifest($0) },
+                                             factory: factory,
+                                             participantId: .init(0),
+                                             predictor: predictor,
+                                             config: config)
+
+        // Each costs 2Mbps, and about 12MB of 1080p frames.
+        predictor.speakersChanged(OrderedSet((1...6).map { ParticipantId($0) }), when: .now)
+        await pool.update(rendered: [])
+        #expect(await pool.targets.count == expected)
+        #expect(await pool.members.count == expected)
+        #expect(controller.getSubscriptionSets().count == expected)
+        #expect(controller.getSubscriptionSets().allSatisfy { $0.isPaused })
+    }
+}
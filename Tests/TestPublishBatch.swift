@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import XCTest
+@testable import QuicR
+
+private final class NoopPublishCallbacks: NSObject, QPublishTrackHandlerCallbacks {
+    func statusChanged(_ status: QPublishTrackHandlerStatus) {}
+    func metricsSampled(_ metrics: QPublishTrackMetrics) {}
+}
+
+final class TestPublishBatch: XCTestCase {
+    private let callbacks = NoopPublishCallbacks()
+    private let payload = Data(repeating: 0x42, count: 160)
+    private let extensions: Data = {
+        var extensions = HeaderExtensions()
+        extensions.append(1, Data(repeating: 1, count: 8))
+        extensions.append(2, Data(repeating: 2, count: 4))
+        extensions.append(2, Data(repeating: 3, count: 2))
+        return extensions.flat
+    }()
+
+    private func makeHandler(_ name: String) -> QPublishTrackHandlerObjC {
+        let ftn = QFullTrackNameImpl(namespace: [Data("batch".utf8)], name: Data(name.utf8))
+        return .init(fullTrackName: ftn,
+                     trackMode: .stream,
+                     defaultPriority: 1,
+                     defaultTTL: 1000,
+                     callbacks: self.callbacks)
+    }
+
+    private func headers(_ objectId: UInt64) -> QObjectHeaders {
+        .init(groupId: 0,
+              subgroupId: 0,
+              objectId: objectId,
+              payloadLength: UInt64(self.payload.count),
+              status: .available,
+              priority: nil,
+              ttl: nil)
+    }
+
+    func testMatchesSinglePublish() {
+        let handlers = [makeHandler("a"), makeHandler("b")]
+        let batch = QPublishBatch(capacity: 1)
+        for objectId in 0..<4 {
+            batch.addObject(headers(UInt64(objectId)),
+                            data: self.payload,
+                            extensions: objectId.isMultiple(of: 2) ? self.extensions : nil,
+                            immutableExtensions: nil,
+                            streamHeaderProperties: nil,
+                            handler: handlers[objectId % handlers.count])
+        }
+        XCTAssertEqual(batch.count(), 4)
+
+        // Nothing is announced here, so every object should get the same status as a single publish.
+        var statuses = [QPublishObjectStatus](repeating: .ok, count: 4)
+        let published = batch.publish(&statuses)
+        XCTAssertEqual(batch.count(), 0)
+        for (index, status) in statuses.enumerated() {
+            let single = handlers[index % handlers.count].publishObject(headers(UInt64(index)),
+                                                                        data: self.payload,
+                                                                        extensions: nil,
+                                                                        immutableExtensions: nil,
+                                                                        streamHeaderProperties: nil)
+            XCTAssertEqual(status, single)
+        }
+        XCTAssertEqual(published, statuses.filter { $0 == .ok }.count)
+    }
+
+    func testClear() {
+        let batch = QPublishBatch(capacity: 4)
+        batch.addObject(headers(0),
+                        data: self.payload,
+                        extensions: self.extensions,
+                        immutableExtensions: self.extensions,
+                        streamHeaderProperties: nil,
+                        handler: makeHandler("a"))
+        batch.clear()
+        XCTAssertEqual(batch.count(), 0)
+        XCTAssertEqual(batch.publish(nil), 0)
+    }
+
+    // Single vs batch conversion cost for 10 tracks of 10 objects each.
+    func testPerformanceSingle() {
+        let handlers = (0..<10).map { makeHandler("\($0)") }
+        measure {
+            for round in 0..<100 {
+                for handler in handlers {
+                    _ = handler.publishObject(headers(UInt64(round)),
+                                              data: self.payload,
+                                              extensions: self.extensions,
+                                              immutableExtensions: nil,
+                                              streamHeaderProperties: nil)
+                }
+            }
+        }
+    }
+
+    func testPerformanceBatch() {
+        let handlers = (0..<10).map { makeHandler("\($0)") }
+        let batch = QPublishBatch(capacity: handlers.count)
+        measure {
+            for round in 0..<100 {
+                for handler in handlers {
+                    batch.addObject(headers(UInt64(round)),
+                                    data: self.payload,
+                                    extensions: self.extensions,
+                                    immutableExtensions: nil,
+                                    streamHeaderProperties: nil,
+                                    handler: handler)
+                }
+                _ = batch.publish(nil)
+            }
+        }
+    }
+}
@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import Foundation
+import Testing
+@testable import QuicR
+
+struct SFrameContextTests {
+    private func payload(_ size: Int) -> Data {
+        .init((0..<size).map { UInt8(truncatingIfNeeded: $0) })
+    }
+
+    @Test("Send contexts are independent senders")
+    func sendContexts() throws {
+        let keyring = try SFrameKeyring(key: "secret", senderId: 5, currentEpoch: 0)
+        let first = try keyring.makeSendContext()
+        let second = try keyring.makeSendContext()
+        #expect(first.senderId == 5 << SFrameKeyring.contextBits)
+        #expect(second.senderId == 5 << SFrameKeyring.contextBits | 1)
+
+        // Either can be unprotected by any receiver of the key.
+        let receive = try keyring.makeReceiveContext()
+        let plaintext = self.payload(1000)
+        #expect(try receive.unprotect(first.protect(plaintext)) == plaintext)
+        #expect(try receive.unprotect(second.protect(plaintext)) == plaintext)
+
+        // Both start from the same key state, but different sender IDs keep their nonces apart.
+        #expect(try first.protect(plaintext) != second.protect(plaintext))
+    }
+
+    @Test("Send contexts in use are limited")
+    func sendContextLimit() throws {
+        let keyring = try SFrameKeyring(key: "secret", senderId: 1, currentEpoch: 0)
+        var contexts = try (0..<(1 << SFrameKeyring.contextBits)).map { _ in try keyring.makeSendContext() }
+        #expect(throws: (any Error).self) { try keyring.makeSendContext() }
+
+        // Releasing one makes room.
+        let released = contexts.removeLast().senderId
+        #expect(try keyring.makeSendContext().senderId == released)
+    }
+
+    @Test("Released send contexts are reused without repeating nonces")
+    func sendContextReuse() throws {
+        let keyring = try SFrameKeyring(key: "secret", senderId: 1, currentEpoch: 0)
+        let receive = try keyring.makeReceiveContext()
+        let plaintext = self.payload(100)
+        var first: SendSFrameContext? = try keyring.makeSendContext()
+        let senderId = first!.senderId
+        let protected = try first!.protect(plaintext)
+        first = nil
+
+        let reused = try keyring.makeSendContext()
+        #expect(reused.senderId == senderId)
+        let again = try reused.protect(plaintext)
+        #expect(again != protected)
+        #expect(try receive.unprotect(again) == plaintext)
+    }
+
+    @Test("Batches round trip")
+    func batch() throws {
+        let keyring = try SFrameKeyring(key: "secret", senderId: 1, currentEpoch: 0)
+        let send = try keyring.makeSendContext()
+        let receive = try keyring.makeReceiveContext()
+        let plaintexts = [1, 100, 1200, 5000].map { self.payload($0) }
+        #expect(try receive.unprotect(send.protect(plaintexts)) == plaintexts)
+    }
+
+    @Test("Wrong key fails")
+    func wrongKey() throws {
+        let send = try SFrameKeyring(key: "secret", senderId: 1, currentEpoch: 0).makeSendContext()
+        let receive = try SFrameKeyring(key: "other", senderId: 1, currentEpoch: 0).makeReceiveContext()
+        let protected = try send.protect(self.payload(100))
+        #expect(throws: (any Error).self) { try receive.unprotect(protected) }
+    }
+
+    /// Protect and unprotect throughput by payload size, for one context and for
+    /// several publications at once, sharing a context or each with their own.
+    @Test("Throughput", arguments: [64, 1200, 16 * 1024, 128 * 1024])
+    func throughput(size: Int) async throws {
+        let keyring = try SFrameKeyring(key: "secret", senderId: 1, currentEpoch: 0)
+        let send = try keyring.makeSendContext()
+        let receive = try keyring.makeReceiveContext()
+        let plaintext = self.payload(size)
+        let count = max(100, 16 * 1024 * 1024 / size)
+
+        var protected: [Data] = []
+        protected.reserveCapacity(count)
+        let protectStart = Ticks.now
+        for _ in 0..<count {
+            protected.append(try send.protect(plaintext))
+        }
+        let protectTime = Ticks.now.timeIntervalSince(protectStart)
+        let unprotectStart = Ticks.now
+        for object in protected {
+            _ = try receive.unprotect(object)
+        }
+        let unprotectTime = Ticks.now.timeIntervalSince(unprotectStart)
+
+        // 4 publications at once.
+        let publications = 4
+        let shared = try keyring.makeSendContext()
+        let own = try (0..<publications).map { _ in try keyring.makeSendContext() }
+        func concurrently(_ context: @escaping @Sendable (Int) -> SendSFrameContext) async throws -> TimeInterval {
+            let start = Ticks.now
+            try await withThrowingTaskGroup(of: Void.self) { group in
+                for publication in 0..<publications {
+                    group.addTask {
+                        let context = context(publication)
+                        for _ in 0..<(count / publications) {
+                            _ = try context.protect(plaintext)
+                        }
+                    }
+                }
+                try await group.waitForAll()
+            }
+            return Ticks.now.timeIntervalSince(start)
+        }
+        let sharedTime = try await concurrently { _ in shared }
+        let ownTime = try await concurrently { own[$0] }
+
+        let megabytes = TimeInterval(count * size) / 1_000_000
+        print("SFrame \(size)B: protect \(megabytes / protectTime)MB/s, unprotect \(megabytes / unprotectTime)MB/s, " +
+              "\(publications) publications shared \(megabytes / sharedTime)MB/s, own \(megabytes / ownTime)MB/s")
+        #expect(try receive.unprotect(protected[count - 1]) == plaintext)
+    }
+}
@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import CoreMedia
+import XCTest
+@testable import QuicR
+
+final class TestSequenceRing: XCTestCase {
+    private class Item: NSObject {
+        let sequence: UInt64
+        init(_ sequence: UInt64) { self.sequence = sequence }
+    }
+
+    private func insert(_ ring: QSequenceRing, _ sequence: UInt64, durationUs: Int64 = 1) -> QSequenceRingResult {
+        ring.insert(Item(sequence), sequence: sequence, durationUs: durationUs)
+    }
+
+    private func pop(_ ring: QSequenceRing) -> UInt64? {
+        (ring.popHead() as? Item)?.sequence
+    }
+
+    func testOrdering() {
+        let ring = QSequenceRing(capacity: 8)
+        for sequence: UInt64 in [12, 10, 11, 14] {
+            XCTAssertEqual(insert(ring, sequence, durationUs: 10), .inserted)
+        }
+        XCTAssertEqual(ring.count(), 4)
+        XCTAssertEqual(ring.durationUs(), 40)
+        XCTAssertEqual((ring.head() as? Item)?.sequence, 10)
+
+        // Gaps are stepped over.
+        XCTAssertEqual([pop(ring), pop(ring), pop(ring), pop(ring)], [10, 11, 12, 14])
+        XCTAssertNil(ring.popHead())
+        XCTAssertEqual(ring.durationUs(), 0)
+    }
+
+    func testDuplicate() {
+        let ring = QSequenceRing(capacity: 4)
+        XCTAssertEqual(insert(ring, 1), .inserted)
+        XCTAssertEqual(insert(ring, 1), .duplicate)
+        XCTAssertEqual(ring.count(), 1)
+    }
+
+    func testFull() {
+        let ring = QSequenceRing(capacity: 3)
+        for sequence: UInt64 in 0..<3 {
+            XCTAssertEqual(insert(ring, sequence), .inserted)
+        }
+        XCTAssertEqual(insert(ring, 3), .full)
+        _ = pop(ring)
+        XCTAssertEqual(insert(ring, 3), .inserted)
+
+        // A sequence too far from the head to index without aliasing is also full.
+        XCTAssertEqual(insert(ring, 1000), .full)
+    }
+
+    func testClear() {
+        let ring = QSequenceRing(capacity: 4)
+        _ = insert(ring, 5)
+        ring.clear()
+        XCTAssertEqual(ring.count(), 0)
+        XCTAssertNil(ring.head())
+
+        // Anything is acceptable after a clear.
+        XCTAssertEqual(insert(ring, 1_000_000), .inserted)
+    }
+
+    // 150 deep with light reordering, as a video jitter buffer sees it.
+    private static let depth = 150
+    private static let sequences: [UInt64] = {
+        var sequences = (0..<UInt64(5000)).map { $0 }
+        for index in stride(from: 0, to: sequences.count - 3, by: 7) {
+            sequences.swapAt(index, index + 2)
+        }
+        return sequences
+    }()
+
+    func testPerformanceRing() {
+        measure {
+            let ring = QSequenceRing(capacity: Self.depth + 8)
+            for sequence in Self.sequences {
+                _ = insert(ring, sequence, durationUs: 33_333)
+                _ = ring.durationUs()
+                if ring.count() > Self.depth {
+                    _ = ring.popHead()
+                }
+            }
+        }
+    }
+
+    // What JitterBuffer used before: a sorted CMBufferQueue, summing durations on every read.
+    func testPerformanceSortedQueue() throws {
+        let handlers = CMBufferQueue.Handlers { builder in
+            builder.compare { first, second in
+                guard let first = first as? Item,
+                      let second = second as? Item else {
+                    return .compareEqualTo
+                }
+                return first.sequence < second.sequence ? .compareLessThan : .compareGreaterThan
+            }
+            builder.getDuration { _ in CMTime(value: 33_333, timescale: 1_000_000) }
+            builder.getDecodeTimeStamp { _ in .invalid }
+            builder.getPresentationTimeStamp { _ in .invalid }
+            builder.getSize { _ in 0 }
+            builder.isDataReady { _ in true }
+        }
+        measure {
+            guard let queue = try? CMBufferQueue(capacity: Self.depth + 8, handlers: handlers) else {
+                XCTFail("Failed to create queue")
+                return
+            }
+            for sequence in Self.sequences {
+                try? queue.enqueue(Item(sequence))
+                _ = queue.duration
+                if queue.bufferCount > Self.depth {
+                    _ = queue.dequeue()
+                }
+            }
+        }
+    }
+}
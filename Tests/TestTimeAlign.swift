@@ -50,37 +50,17 @@ struct TestTimeAlignable {
         let timeDiff = TimeDiff()
 
         init() {
-            let handlers = CMBufferQueue.Handlers { builder in
-                builder.compare { _, _ in
-                    .compareLessThan
-                }
-                builder.getDecodeTimeStamp { _ in
-                    .invalid
-                }
-                builder.getDuration { _ in
-                    .invalid
-                }
-                builder.getPresentationTimeStamp {
-                    (($0) as! JitterBuffer.JitterItem).timestamp // swiftlint:disable:this force_cast
-                }
-                builder.getSize { _ in
-                    0
-                }
-                builder.isDataReady { _ in
-                    true
-                }
-            }
             self.jitterBuffer = try? .init(identifier: "Test",
                                            metricsSubmitter: nil,
                                            minDepth: minDepth,
-                                           capacity: 5,
-                                           handlers: handlers)
+                                           capacity: 5)
         }
     }
 
     class JitterItemImpl: JitterBuffer.JitterItem {
         let sequenceNumber: UInt64
         let timestamp: CMTime
+        let duration: CMTime = .invalid
         init(sequenceNumber: UInt64, timestamp: Ticks) {
             self.sequenceNumber = sequenceNumber
             let value = timestamp.seconds * microsecondsPerSecond
@@ -0,0 +1,225 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+import AVFAudio
+import XCTest
+@testable import QuicR
+
+final class TestTimeStretcher: XCTestCase {
+    private static let sampleRate: Double = 48000
+    // 10ms.
+    private static let block: UInt32 = 480
+
+    // MARK: Fixtures.
+
+    /// A voiced, speech like signal: harmonics of a gliding pitch, with a syllable rate envelope.
+    private static func speech(seconds: Double, pitch: Double = 120, glide: Double = 30) -> [Float32] {
+        var phase = 0.0
+        return (0..<Int(seconds * Self.sampleRate)).map { index in
+            let time = Double(index) / Self.sampleRate
+            phase += 2 * .pi * (pitch + glide * sin(2 * .pi * 1.3 * time)) / Self.sampleRate
+            let harmonics = (1...12).reduce(0.0) { $0 + sin(Double($1) * phase) / Double($1) }
+            let envelope = 0.5 + 0.5 * sin(2 * .pi * 3 * time)
+            return Float32(0.15 * harmonics * envelope)
+        }
+    }
+
+    private static func tone(seconds: Double, frequency: Double) -> [Float32] {
+        (0..<Int(seconds * Self.sampleRate)).map {
+            Float32(0.5 * sin(2 * .pi * frequency * Double($0) / Self.sampleRate))
+        }
+    }
+
+    /// Write to a WAV file and read it back, as a recorded fixture would be.
+    private static func wav(_ samples: [Float32], name: String) throws -> [Float32] {
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("\(name).wav")
+        let format = AVAudioFormat(standardFormatWithSampleRate: Self.sampleRate, channels: 1)!
+        let buffer = AVAudioPCMBuffer(pcmFormat: format, frameCapacity: AVAudioFrameCount(samples.count))!
+        buffer.frameLength = buffer.frameCapacity
+        samples.withUnsafeBufferPointer {
+            buffer.floatChannelData![0].update(from: $0.baseAddress!, count: samples.count)
+        }
+        do {
+            let file = try AVAudioFile(forWriting: url, settings: format.settings)
+            try file.write(from: buffer)
+        }
+        let file = try AVAudioFile(forReading: url)
+        let read = AVAudioPCMBuffer(pcmFormat: file.processingFormat, frameCapacity: AVAudioFrameCount(file.length))!
+        try file.read(into: read)
+        return Array(UnsafeBufferPointer(start: read.floatChannelData![0], count: Int(read.frameLength)))
+    }
+
+    // MARK: Measurement.
+
+    /// Stretch all of `input`, written as needed.
+    /// - Returns: The output, and how much input it consumed.
+    private func stretch(_ input: [Float32], rate: Double, block: UInt32 = TestTimeStretcher.block)
+    -> (output: [Float32], consumed: Int) {
+        let stretcher = QTimeStretcher(sampleRate: UInt32(Self.sampleRate), maxFrames: 4096)
+        var output: [Float32] = []
+        var scratch = [Float32](repeating: 0, count: Int(block))
+        var position = 0
+        input.withUnsafeBufferPointer { input in
+            while true {
+                let needed = Int(stretcher.inputNeeded(block, rate: rate))
+                guard position + needed <= input.count else { break }
+                position += Int(stretcher.write(input.baseAddress! + position, frames: UInt32(needed)))
+                let produced = scratch.withUnsafeMutableBufferPointer {
+                    stretcher.read($0.baseAddress!, frames: block, rate: rate)
+                }
+                XCTAssertEqual(produced, block)
+                output += scratch
+            }
+        }
+        return (output, position - Int(stretcher.buffered()))
+    }
+
+    /// Signal to noise ratio of `samples` against the best fitting sinusoid at `frequency`, fitted per block
+    /// so that phase may wander.
+    private func snr(_ samples: [Float32], frequency: Double) -> Double {
+        var signal = 0.0
+        var noise = 0.0
+        let length = 2048
+        for start in stride(from: 0, to: samples.count - length, by: length) {
+            var (ss, sc, cc, ys, yc) = (0.0, 0.0, 0.0, 0.0, 0.0)
+            for index in 0..<length {
+                let phase = 2 * .pi * frequency * Double(start + index) / Self.sampleRate
+                let value = Double(samples[start + index])
+                ss += sin(phase) * sin(phase)
+                sc += sin(phase) * cos(phase)
+                cc += cos(phase) * cos(phase)
+                ys += value * sin(phase)
+                yc += value * cos(phase)
+            }
+            let determinant = ss * cc - sc * sc
+            let sine = (ys * cc - yc * sc) / determinant
+            let cosine = (yc * ss - ys * sc) / determinant
+            for index in 0..<length {
+                let phase = 2 * .pi * frequency * Double(start + index) / Self.sampleRate
+                let fit = sine * sin(phase) + cosine * cos(phase)
+                signal += fit * fit
+                noise += pow(Double(samples[start + index]) - fit, 2)
+            }
+        }
+        return 10 * log10(signal / noise)
+    }
+
+    /// Fundamental frequency, from the autocorrelation peak between 80Hz and 400Hz.
+    private func pitch(_ samples: ArraySlice<Float32>) -> Double {
+        let samples = Array(samples)
+        let lags = Int(Self.sampleRate / 400)...Int(Self.sampleRate / 80)
+        let best = lags.max { lhs, rhs in
+            let correlation: (Int) -> Float32 = { lag in
+                zip(samples, samples.dropFirst(lag)).reduce(0) { $0 + $1.0 * $1.1 }
+            }
+            return correlation(lhs) < correlation(rhs)
+        }!
+        return Self.sampleRate / Double(best)
+    }
+
+    // MARK: Tests.
+
+    func testUnitRateIsPassthrough() throws {
+        let input = try Self.wav(Self.speech(seconds: 1), name: "speech")
+        let (output, consumed) = self.stretch(input, rate: 1, block: 512)
+        XCTAssertEqual(consumed, output.count)
+        XCTAssertEqual(output, Array(input.prefix(output.count)))
+    }
+
+    func testRateAccuracy() throws {
+        let input = try Self.wav(Self.speech(seconds: 4), name: "speech")
+        for rate in [0.85, 0.9, 1.05, 1.1, 1.15] {
+            let (output, consumed) = self.stretch(input, rate: rate)
+            let achieved = Double(consumed) / Double(output.count)
+            XCTAssertEqual(achieved, rate, accuracy: 0.01, "\(rate)")
+        }
+    }
+
+    func testToneDistortion() throws {
+        let input = try Self.wav(Self.tone(seconds: 4, frequency: 440), name: "tone")
+        for rate in [0.85, 0.95, 1.05, 1.15] {
+            let output = self.stretch(input, rate: rate).output
+            let snr = self.snr(output, frequency: 440)
+            print("Tone at \(rate)x: \(snr)dB SNR")
+            XCTAssertGreaterThan(snr, 35, "\(rate)")
+        }
+    }
+
+    func testPitchPreserved() throws {
+        let input = try Self.wav(Self.speech(seconds: 2, pitch: 150, glide: 0), name: "voiced")
+        XCTAssertEqual(self.pitch(input[24000..<26400]), 150, accuracy: 3)
+        for rate in [0.85, 1.15] {
+            let output = self.stretch(input, rate: rate).output
+            XCTAssertEqual(self.pitch(output[24000..<26400]), 150, accuracy: 3, "\(rate)")
+        }
+    }
+
+    /// Play a backlog of excess latency in real time, with the controller deciding the rate.
+    func testLatencyReduction() throws {
+        let input = try Self.wav(Self.speech(seconds: 6), name: "speech")
+        let playoutBufferTime: TimeInterval = 0.02
+        var controller = PlayoutRateController(start: playoutBufferTime * 2, stop: playoutBufferTime)
+        let stretcher = QTimeStretcher(sampleRate: UInt32(Self.sampleRate), maxFrames: 4096)
+        // Start 200ms behind: everything up to here has arrived and is due.
+        let backlog = Int(0.2 * Self.sampleRate)
+        var arrived = backlog
+        var written = 0
+        var played = 0
+        var scratch = [Float32](repeating: 0, count: Int(Self.block))
+        var drainedAt: Int?
+        input.withUnsafeBufferPointer { input in
+            while arrived + Int(Self.block) <= input.count {
+                arrived += Int(Self.block)
+                let late = Double(arrived - Int(Self.block) - written + Int(stretcher.buffered())) / Self.sampleRate
+                let available = UInt32(arrived - written) + stretcher.buffered()
+                var rate = controller.rate(late: late,
+                                           available: available,
+                                           frames: Self.block,
+                                           lookahead: stretcher.lookahead())
+                if stretcher.inputNeeded(Self.block, rate: rate) > arrived - written {
+                    rate = 1
+                }
+                let needed = min(Int(stretcher.inputNeeded(Self.block, rate: rate)), arrived - written)
+                written += Int(stretcher.write(input.baseAddress! + written, frames: UInt32(needed)))
+                played += Int(scratch.withUnsafeMutableBufferPointer {
+                    stretcher.read($0.baseAddress!, frames: Self.block, rate: rate)
+                })
+                if drainedAt == nil && !controller.catchingUp && played > 0 {
+                    drainedAt = played
+                }
+            }
+        }
+        let remaining = Double(arrived - written + Int(stretcher.buffered())) / Self.sampleRate
+        print("Drained 200ms of latency to \(remaining * 1000)ms in \(Double(drainedAt ?? 0) / Self.sampleRate)s")
+        XCTAssertLessThan(remaining, playoutBufferTime * 2)
+        XCTAssertNotNil(drainedAt)
+        XCTAssertGreaterThan(stretcher.removed(), UInt64(0.15 * Self.sampleRate))
+    }
+
+    func testControllerHysteresis() {
+        var controller = PlayoutRateController(start: 0.04, stop: 0.02, minRate: 0.85, maxRate: 1.15)
+        let plenty: UInt32 = 10_000
+        XCTAssertEqual(controller.rate(late: 0.03, available: plenty, frames: 480, lookahead: 768), 1)
+        XCTAssertEqual(controller.rate(late: 0.05, available: plenty, frames: 480, lookahead: 768), 1.065, accuracy: 1e-9)
+        // Keeps going until back under the stop threshold.
+        XCTAssertGreaterThan(controller.rate(late: 0.03, available: plenty, frames: 480, lookahead: 768), 1)
+        XCTAssertEqual(controller.rate(late: 1, available: plenty, frames: 480, lookahead: 768), 1.15, accuracy: 1e-9)
+        XCTAssertEqual(controller.rate(late: 0.01, available: plenty, frames: 480, lookahead: 768), 1)
+        XCTAssertFalse(controller.catchingUp)
+    }
+
+    func testControllerStretchesWhenLow() {
+        var controller = PlayoutRateController(start: 0.04, stop: 0.02, minRate: 0.85, maxRate: 1.15)
+        XCTAssertEqual(controller.rate(late: 0, available: 1_000, frames: 480, lookahead: 768), 0.85)
+        // Too little to stretch, so play out what's left.
+        XCTAssertEqual(controller.rate(late: 0, available: 500, frames: 480, lookahead: 768), 1)
+        XCTAssertEqual(controller.rate(late: 0, available: 2_000, frames: 480, lookahead: 768), 1)
+    }
+
+    func testPerformanceCatchUp() {
+        let input = Self.speech(seconds: 4)
+        measure {
+            _ = self.stretch(input, rate: 1.1)
+        }
+    }
+}
@@ -17,47 +17,6 @@ extension DecimusVideoFrame: @retroactive Equatable {
     }
 }
 
-// swiftlint:disable force_cast
-private func getHandler(sort: Bool) -> CMBufferQueue.Handlers {
-    .init { builder in
-        builder.compare {
-            if !sort {
-                return .compareLessThan
-            }
-            let first = $0 as! DecimusVideoFrameJitterItem
-            let second = $1 as! DecimusVideoFrameJitterItem
-            let seq1 = first.sequenceNumber
-            let seq2 = second.sequenceNumber
-            if seq1 < seq2 {
-                return .compareLessThan
-            } else if seq1 > seq2 {
-                return .compareGreaterThan
-            } else if seq1 == seq2 {
-                return .compareEqualTo
-            }
-            assert(false)
-            return .compareLessThan
-        }
-        builder.getDecodeTimeStamp {
-            ($0 as! DecimusVideoFrameJitterItem).frame.samples.first?.decodeTimeStamp ?? .invalid
-        }
-        builder.getDuration {
-            let duration = ($0 as! DecimusVideoFrameJitterItem).frame.samples.first!.duration
-            return duration
-        }
-        builder.getPresentationTimeStamp {
-            ($0 as! DecimusVideoFrameJitterItem).frame.samples.first?.presentationTimeStamp ?? .invalid
-        }
-        builder.getSize {
-            ($0 as! DecimusVideoFrameJitterItem).frame.samples.reduce(0) { $0 + $1.totalSampleSize }
-        }
-        builder.isDataReady {
-            ($0 as! DecimusVideoFrameJitterItem).frame.samples.reduce(true) { $0 && $1.dataReadiness == .ready }
-        }
-    }
-}
-// swiftlint:enable force_cast
-
 private func exampleSample(groupId: UInt64,
                            objectId: UInt64,
                            sequenceNumber: UInt64,
@@ -80,46 +39,35 @@ private func exampleSample(groupId: UInt64,
 
 final class TestVideoJitterBuffer: XCTestCase {
 
-    /// Nothing should be returned until the min depth has been exceeded.
-    func doTestPlayout() throws {
-        try testPlayout(sort: true)
-        try testPlayout(sort: false)
-    }
-
-    func testPlayout(sort: Bool) throws {
+    /// Frames are read in order. Holding playout back until the min depth is reached is up to the reader, through
+    /// the wait time, see `testWaitTimeMinDepth`.
+    func testPlayout() throws {
         let buffer = try JitterBuffer(identifier: "",
                                       metricsSubmitter: nil,
                                       minDepth: 1/30 * 2.5,
-                                      capacity: 4,
-                                      handlers: getHandler(sort: sort))
+                                      capacity: 4)
 
-        // Write 1, no play.
+        // Write 1, and not again.
         let frame1 = try exampleSample(groupId: 0,
                                        objectId: 0,
                                        sequenceNumber: 0,
                                        fps: 30)
         try buffer.write(item: DecimusVideoFrameJitterItem(frame1), from: Date.now)
-        try buffer.write(item: DecimusVideoFrameJitterItem(frame1), from: Date.now)
-        let read: DecimusVideoFrameJitterItem? = buffer.read(from: Date.now)
-        XCTAssertNil(read)
+        XCTAssertThrowsError(try buffer.write(item: DecimusVideoFrameJitterItem(frame1), from: Date.now))
 
-        // Write 2, no play.
+        // Write 2 and 3, get 1.
         let frame2 = try exampleSample(groupId: 0,
                                        objectId: 1,
                                        sequenceNumber: 1,
                                        fps: 30)
         try buffer.write(item: DecimusVideoFrameJitterItem(frame2), from: Date.now)
-        let read2: DecimusVideoFrameJitterItem? = buffer.read(from: Date.now)
-        XCTAssertNil(read2)
-
-        // Write 3, play, get 1.
         let frame3 = try exampleSample(groupId: 0,
                                        objectId: 2,
                                        sequenceNumber: 2,
                                        fps: 30)
         try buffer.write(item: DecimusVideoFrameJitterItem(frame3), from: Date.now)
-        let read3: DecimusVideoFrameJitterItem? = buffer.read(from: Date.now)
-        XCTAssertEqual(frame1, read3?.frame)
+        let read1: DecimusVideoFrameJitterItem? = buffer.read(from: Date.now)
+        XCTAssertEqual(frame1, read1?.frame)
 
         // Write 4, get 2.
         let frame4 = try exampleSample(groupId: 0,
@@ -127,16 +75,16 @@ final class TestVideoJitterBuffer: XCTestCase {
                                        sequenceNumber: 3,
                                        fps: 30)
         try buffer.write(item: DecimusVideoFrameJitterItem(frame4), from: Date.now)
-        let read4: DecimusVideoFrameJitterItem? = buffer.read(from: Date.now)
-        XCTAssertEqual(frame2, read4?.frame)
+        let read2: DecimusVideoFrameJitterItem? = buffer.read(from: Date.now)
+        XCTAssertEqual(frame2, read2?.frame)
 
         // Get 3, 4 and done.
+        let read3: DecimusVideoFrameJitterItem? = buffer.read(from: Date.now)
+        XCTAssertEqual(frame3, read3?.frame)
+        let read4: DecimusVideoFrameJitterItem? = buffer.read(from: Date.now)
+        XCTAssertEqual(frame4, read4?.frame)
         let read5: DecimusVideoFrameJitterItem? = buffer.read(from: Date.now)
-        XCTAssertEqual(frame3, read5?.frame)
-        let read6: DecimusVideoFrameJitterItem? = buffer.read(from: Date.now)
-        XCTAssertEqual(frame4, read6?.frame)
-        let read7: DecimusVideoFrameJitterItem? = buffer.read(from: Date.now)
-        XCTAssertNil(read7)
+        XCTAssertNil(read5)
     }
 
     // Out of orders should go in order.
@@ -144,8 +92,7 @@ final class TestVideoJitterBuffer: XCTestCase {
         let buffer = try JitterBuffer(identifier: "",
                                       metricsSubmitter: nil,
                                       minDepth: 0,
-                                      capacity: 2,
-                                      handlers: getHandler(sort: true))
+                                      capacity: 2)
 
         // Write newer.
         let frame2 = try exampleSample(groupId: 0,
@@ -172,16 +119,10 @@ final class TestVideoJitterBuffer: XCTestCase {
 
     // Out of orders should not be allowed past a read.
     func testOlderFrame() throws {
-        try testOlderFrame(true)
-        try testOlderFrame(false)
-    }
-
-    func testOlderFrame(_ sort: Bool) throws {
         let buffer = try JitterBuffer(identifier: "",
                                       metricsSubmitter: nil,
                                       minDepth: 0,
-                                      capacity: 2,
-                                      handlers: getHandler(sort: sort))
+                                      capacity: 2)
 
         // Write newer.
         let frame2 = try exampleSample(groupId: 0,
@@ -215,8 +156,7 @@ final class TestVideoJitterBuffer: XCTestCase {
         let buffer = try JitterBuffer(identifier: "",
                                       metricsSubmitter: nil,
                                       minDepth: minDepth,
-                                      capacity: 1,
-                                      handlers: getHandler(sort: false))
+                                      capacity: 1)
 
         // No calculation possible with no frame available.
         waitTime = buffer.calculateWaitTime(from: startTime,
@@ -232,8 +172,7 @@ final class TestVideoJitterBuffer: XCTestCase {
         let buffer = try JitterBuffer(identifier: "",
                                       metricsSubmitter: nil,
                                       minDepth: minDepth,
-                                      capacity: 1,
-                                      handlers: getHandler(sort: false))
+                                      capacity: 1)
 
         // At first write, and otherwise on time, we should wait the min depth.
         let presentationTimestamp = startTime.hostDate.timeIntervalSince1970
@@ -271,8 +210,7 @@ final class TestVideoJitterBuffer: XCTestCase {
         let buffer = try JitterBuffer(identifier: "",
                                       metricsSubmitter: nil,
                                       minDepth: minDepth,
-                                      capacity: 2,
-                                      handlers: getHandler(sort: false))
+                                      capacity: 2)
         let presentationTimestamp = startTime.hostDate.timeIntervalSince1970
         let presentation = CMTime(seconds: presentationTimestamp,
                                   preferredTimescale: CMTimeScale(microsecondsPerSecond))
@@ -296,8 +234,8 @@ final class TestVideoJitterBuffer: XCTestCase {
                                             sampleSizes: [0])
             let frame = DecimusVideoFrame(samples: [sample],
                                           groupId: 1,
-                                          objectId: 1,
-                                          sequenceNumber: 1,
+                                          objectId: UInt64(count),
+                                          sequenceNumber: UInt64(count),
                                           fps: 1,
                                           orientation: nil,
                                           verticalMirror: nil)
@@ -341,7 +279,7 @@ final class TestVideoJitterBuffer: XCTestCase {
         // Create jitter buffer.
         let capacity = 1000
         let targetDepth: TimeInterval = 0.2
-        let buffer = try JitterBuffer(identifier: "", metricsSubmitter: nil, minDepth: targetDepth, capacity: capacity, handlers: getHandler(sort: false))
+        let buffer = try JitterBuffer(identifier: "", metricsSubmitter: nil, minDepth: targetDepth, capacity: capacity)
 
         // Frame characteristics.
         let fps = 30
@@ -418,8 +356,7 @@ final class TestVideoJitterBuffer: XCTestCase {
         let buffer = try JitterBuffer(identifier: "",
                                       metricsSubmitter: nil,
                                       minDepth: 0,
-                                      capacity: 2,
-                                      handlers: getHandler(sort: false))
+                                      capacity: 2)
 
         // 0 when empty.
         XCTAssertEqual(buffer.getDepth(), 0)
@@ -445,7 +382,6 @@ struct JitterBufferTests {
                                       metricsSubmitter: nil,
                                       minDepth: 0,
                                       capacity: 2,
-                                      handlers: getHandler(sort: false),
                                       playingFromStart: false)
         let sample = try exampleSample(groupId: 0, objectId: 1, sequenceNumber: 0, fps: 30)
         let item = try DecimusVideoFrameJitterItem(sample)
@@ -463,7 +399,6 @@ struct JitterBufferTests {
                                       metricsSubmitter: nil,
                                       minDepth: 0,
                                       capacity: 2,
-                                      handlers: getHandler(sort: false),
                                       playingFromStart: true)
         let sample = try exampleSample(groupId: 0, objectId: 1, sequenceNumber: 0, fps: 30)
         let item = try DecimusVideoFrameJitterItem(sample)
@@ -480,8 +415,7 @@ struct JitterBufferTests {
         let buffer = try JitterBuffer(identifier: "",
                                       metricsSubmitter: nil,
                                       minDepth: startingDepth,
-                                      capacity: 2,
-                                      handlers: getHandler(sort: false))
+                                      capacity: 2)
 
         // Starting.
         #expect(buffer.getBaseTargetDepth() == startingDepth)
@@ -509,7 +443,6 @@ struct JitterBufferTests {
                                       metricsSubmitter: nil,
                                       minDepth: 0,
                                       capacity: 2,
-                                      handlers: getHandler(sort: false),
                                       playingFromStart: false)
 
         // Write a frame.
@@ -539,8 +472,7 @@ struct JitterBufferTests {
         let buffer = try JitterBuffer(identifier: "",
                                       metricsSubmitter: nil,
                                       minDepth: 0,
-                                      capacity: 4,
-                                      handlers: getHandler(sort: true))
+                                      capacity: 4)
 
         // Write and read a frame with sequence 10.
         let sample10 = try exampleSample(groupId: 0, objectId: 10, sequenceNumber: 10, fps: 30)
@@ -569,7 +501,6 @@ struct JitterBufferTests {
                                       metricsSubmitter: nil,
                                       minDepth: 0,
                                       capacity: 20,
-                                      handlers: getHandler(sort: true),
                                       playingFromStart: false)
 
         // Simulate normal playback: write and read some frames (seq 100-105).
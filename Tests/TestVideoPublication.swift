@@ -18,20 +18,28 @@ private final class MockEncoder: VideoEncoder, @unchecked Sendable {
     func write(sample: CMSampleBuffer, timestamp: Date, forceKeyFrame: Bool) throws {
         self.callback(sample, timestamp, forceKeyFrame)
     }
+
+    func setBitrate(_ bitrate: UInt32) throws {}
 }
 
 /// Test double for ``MoQSink`` — lets tests drive status and observe publish calls.
 final class MockSink: MoQSink, @unchecked Sendable {
     typealias PublishCallback = (_ groupId: UInt64, _ objectId: UInt64) -> Void
+    typealias PublishPartialCallback = (_ groupId: UInt64, _ objectId: UInt64, _ bytes: Int) -> Void
 
     let fullTrackName: FullTrackName
     var mockCanPublish = false
     var onPublish: PublishCallback?
+    var onPublishPartial: PublishPartialCallback?
+    /// Status to return for each piece, given its object's headers and its size. Ok if unset.
+    var partialStatus: ((_ headers: QObjectHeaders, _ bytes: Int) -> QPublishObjectStatus)?
+    var mockSupportsPartialObjects = true
     private var onStatus: (@Sendable (QPublishTrackHandlerStatus) -> Void)?
 
     private var mockStatus: QPublishTrackHandlerStatus = .notConnected
     var status: QPublishTrackHandlerStatus { self.mockStatus }
     var canPublish: Bool { self.mockCanPublish }
+    var supportsPartialObjects: Bool { self.mockSupportsPartialObjects }
 
     init(fullTrackName: FullTrackName) {
         self.fullTrackName = fullTrackName
@@ -57,6 +65,14 @@ final class MockSink: MoQSink, @unchecked Sendable {
         return .ok
     }
 
+    func publishPartialObject(_ headers: QObjectHeaders,
+                              data: Data,
+                              extensions: HeaderExtensions?,
+                              immutableExtensions: HeaderExtensions?) -> QPublishObjectStatus {
+        self.onPublishPartial?(headers.groupId, headers.objectId, data.count)
+        return self.partialStatus?(headers, data.count) ?? .ok
+    }
+
     func endSubgroup(groupId: UInt64, subgroupId: UInt64, completed: Bool) {}
 }
 
@@ -36,7 +36,8 @@ struct TestVideoSubscription {
                                   ngThreshold: UInt64,
                                   callback: ObjectReceivedCallback? = nil,
                                   jitterBufferConfig: JitterBuffer.Config = .init(),
-                                  cleanupTime: TimeInterval = 1.5) async throws -> VideoSubscription {
+                                  cleanupTime: TimeInterval = 1.5,
+                                  objectCache: ObjectCache? = nil) async throws -> VideoSubscription {
         let controller = MoqCallController(endpointUri: "",
                                            client: mockClient,
                                            submitter: nil,
@@ -71,9 +72,11 @@ struct TestVideoSubscription {
                                                                                              newGroupUpperThreshold: ngThreshold),
                                                                            calculateLatency: false,
                                                                            mediaInterop: false,
-                                                                           decodeQueueSize: 2),
+                                                                           decodeQueueSize: 2,
+                                                                           videoDecoder: .videoToolbox),
                                                  sframeContext: nil,
                                                  wifiScanDetector: nil,
+                                                 objectCache: objectCache,
                                                  publisherInitiated: false,
                                                  callback: { callback?($0) },
                                                  statusChanged: ({_ in }))
@@ -458,6 +461,69 @@ struct TestVideoSubscription {
         #expect(subscription.getCurrentState() == .startup)
     }
 
+    @Test("Resuming mid group joins from objects received while paused")
+    @MainActor
+    func testJoinFromCacheAfterPause() async throws {
+        let mockClient = MockClient(publish: {_ in},
+                                    unpublish: {_ in},
+                                    subscribe: {_ in},
+                                    unsubscribe: {_ in},
+                                    fetch: {_ in #expect(Bool(false)) },
+                                    fetchCancel: {_ in})
+        let cache = ObjectCache(budget: 1_000_000, metricsSubmitter: nil)
+        let subscription = try await self.makeSubscription(mockClient,
+                                                           fetchThreshold: fetchThreshold,
+                                                           ngThreshold: ngThreshold,
+                                                           objectCache: cache)
+        var sequence: UInt64 = 0
+        func loc() -> HeaderExtensions {
+            sequence += 1
+            var extensions = HeaderExtensions()
+            try? extensions.setHeader(.sequenceNumber(sequence))
+            try? extensions.setHeader(.captureTimestamp(.now))
+            return extensions
+        }
+
+        // Held paused, as a pre-subscribed set is, while the group starts.
+        subscription.pause()
+        for objectId in UInt64(0)..<5 {
+            subscription.mockObject(groupId: 0, objectId: objectId, extensions: nil, immutableExtensions: loc())
+        }
+        #expect(subscription.getCurrentState() == .startup)
+        #expect(cache.stats.bytes > 0)
+
+        // Resumed mid group: joined from the cache, without fetching or waiting.
+        subscription.resume()
+        subscription.mockObject(groupId: 0, objectId: 5, extensions: nil, immutableExtensions: loc())
+        #expect(subscription.getCurrentState() == .running)
+        #expect(cache.stats.hits == 1)
+        #expect(cache.stats.misses == 0)
+    }
+
+    @Test("Objects played aren't cached")
+    @MainActor
+    func testPlayingNotCached() async throws {
+        let mockClient = MockClient(publish: {_ in},
+                                    unpublish: {_ in},
+                                    subscribe: {_ in},
+                                    unsubscribe: {_ in},
+                                    fetch: {_ in},
+                                    fetchCancel: {_ in})
+        let cache = ObjectCache(budget: 1_000_000, metricsSubmitter: nil)
+        let subscription = try await self.makeSubscription(mockClient,
+                                                           fetchThreshold: fetchThreshold,
+                                                           ngThreshold: ngThreshold,
+                                                           objectCache: cache)
+        for objectId in UInt64(0)..<5 {
+            var extensions = HeaderExtensions()
+            try extensions.setHeader(.sequenceNumber(objectId + 1))
+            try extensions.setHeader(.captureTimestamp(.now))
+            subscription.mockObject(groupId: 0, objectId: objectId, extensions: nil, immutableExtensions: extensions)
+        }
+        #expect(subscription.getCurrentState() == .running)
+        #expect(cache.stats.bytes == 0)
+    }
+
     @Test("Resume after pause allows state transitions")
     @MainActor
     func testResumeAfterPause() async throws {
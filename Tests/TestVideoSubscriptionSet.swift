@@ -7,140 +7,85 @@ import CoreMedia
 import Testing
 
 final class TestVideoSubscriptionSet: XCTestCase {
-    private func testImage(width: Int, height: Int) throws -> CVPixelBuffer {
-        var buffer: CVPixelBuffer?
-        let result = CVPixelBufferCreate(kCFAllocatorDefault,
-                                         width,
-                                         height,
-                                         kCMPixelFormat_24RGB,
-                                         nil,
-                                         &buffer)
-        guard result == .zero,
-              let buffer = buffer else { throw "Failed: \(result)" }
-        return buffer
-    }
-
-    private func getQualities(discontinous: [Bool], timing: [CMTime]? = nil) throws -> [VideoSubscriptionSet.SimulreceiveItem] {
-        let highestBuffer = try testImage(width: 1920, height: 1280)
-        let highestImage = AvailableImage(image: try .init(imageBuffer: highestBuffer,
-                                                           formatDescription: .init(imageBuffer: highestBuffer),
-                                                           sampleTiming: .init(duration: .invalid,
-                                                                               presentationTimeStamp: timing?[0] ?? .init(value: 1, timescale: 1),
-                                                                               decodeTimeStamp: .invalid)),
-                                          fps: 30,
-                                          discontinous: discontinous[0])
-        let highest = VideoSubscriptionSet.SimulreceiveItem(fullTrackName: try .init(namespace: ["1"], name: ""), image: highestImage)
-
-        let mediumBuffer = try testImage(width: 1280, height: 960)
-        let mediumImage = AvailableImage(image: try .init(imageBuffer: mediumBuffer,
-                                                          formatDescription: .init(imageBuffer: mediumBuffer),
-                                                          sampleTiming: .init(duration: .invalid,
-                                                                              presentationTimeStamp: timing?[1] ?? .init(value: 1, timescale: 1),
-                                                                              decodeTimeStamp: .invalid)),
-                                         fps: 30,
-                                         discontinous: discontinous[1])
-        let medium = VideoSubscriptionSet.SimulreceiveItem(fullTrackName: try .init(namespace: ["2"], name: ""), image: mediumImage)
-
-        let lowerBuffer = try testImage(width: 1280, height: 960)
-        let lowerImage = AvailableImage(image: try .init(imageBuffer: lowerBuffer,
-                                                         formatDescription: .init(imageBuffer: lowerBuffer),
-                                                         sampleTiming: .init(duration: .invalid,
-                                                                             presentationTimeStamp: timing?[2] ?? .init(value: 1, timescale: 1),
-                                                                             decodeTimeStamp: .invalid)),
-                                        fps: 30,
-                                        discontinous: discontinous[2])
-        let lower = VideoSubscriptionSet.SimulreceiveItem(fullTrackName: try .init(namespace: ["3"], name: ""), image: lowerImage)
-
-        return [highest, medium, lower]
+    private let widths: [UInt32] = [1920, 1280, 1280]
+
+    private func getQualities(discontinous: [Bool], timing: [Int64]? = nil) throws -> QQualityTable {
+        let table = try XCTUnwrap(QQualityTable(layers: self.widths.count))
+        for layer in self.widths.indices {
+            table.update(layer,
+                         pts: timing?[layer] ?? 1,
+                         width: self.widths[layer],
+                         discontinuous: discontinous[layer])
+        }
+        return table
     }
 
     func testOnlyConsiderOldest() throws {
         // Only the subset of frames matching the oldest timestamp should be considered.
-        let choices = try getQualities(discontinous: .init(repeating: false, count: 3),
-                                       timing: [.init(value: 2, timescale: 1),
-                                                .init(value: 1, timescale: 1),
-                                                .init(value: 1, timescale: 1)])
-        var inOutChoices = choices as any Collection<VideoSubscriptionSet.SimulreceiveItem>
-        let result = VideoSubscriptionSet.makeSimulreceiveDecision(choices: &inOutChoices)
-        XCTAssertNotNil(result)
-        switch result {
-        case .highestRes(let item, _):
-            XCTAssertEqual(item, choices[1])
-        default:
-            XCTFail()
-        }
-
+        let table = try getQualities(discontinous: .init(repeating: false, count: 3), timing: [2, 1, 1])
+        XCTAssert(table.decide(.min))
+        XCTAssertEqual(table.selected(), 1)
+        XCTAssertEqual(table.pts(), 1)
+        XCTAssertEqual(table.shortlist(), 0b110)
+        XCTAssertFalse(table.onlyChoice())
     }
 
-    func testNothingGivesNothing() {
-        let choices: [VideoSubscriptionSet.SimulreceiveItem] = []
-        var inOutChoices = choices as any Collection<VideoSubscriptionSet.SimulreceiveItem>
-        XCTAssertNil(VideoSubscriptionSet.makeSimulreceiveDecision(choices: &inOutChoices))
+    func testNothingGivesNothing() throws {
+        let table = try XCTUnwrap(QQualityTable(layers: 3))
+        XCTAssertFalse(table.decide(.min))
     }
 
     func testOneReturnsItself() throws {
-        let all = try getQualities(discontinous: .init(repeating: false, count: 3))
-        let choices = [all[0]]
-        var inOutChoices = choices as any Collection<VideoSubscriptionSet.SimulreceiveItem>
-        let result = VideoSubscriptionSet.makeSimulreceiveDecision(choices: &inOutChoices)
-        XCTAssertNotNil(result)
-        switch result {
-        case .onlyChoice(let item):
-            XCTAssertEqual(item, choices[0])
-        default:
-            XCTFail()
-        }
+        let table = try XCTUnwrap(QQualityTable(layers: 3))
+        table.update(0, pts: 1, width: 1920, discontinuous: false)
+        XCTAssert(table.decide(.min))
+        XCTAssert(table.onlyChoice())
+        XCTAssertEqual(table.selected(), 0)
     }
 
     func testHighestResolutionWhenAllPristine() throws {
         // When we have all available pristine images, highest quality should be picked.
-        let choices = try getQualities(discontinous: .init(repeating: false, count: 3))
-        var inOutChoices = choices as any Collection<VideoSubscriptionSet.SimulreceiveItem>
-        let result = VideoSubscriptionSet.makeSimulreceiveDecision(choices: &inOutChoices)
-        XCTAssertNotNil(result)
-        switch result {
-        case .highestRes(let item, let pristine):
-            XCTAssertNotEqual(item, choices[1])
-            XCTAssertNotEqual(item, choices[2])
-            XCTAssertEqual(item, choices[0])
-            XCTAssert(pristine)
-        default:
-            XCTFail()
-        }
+        let table = try getQualities(discontinous: .init(repeating: false, count: 3))
+        XCTAssert(table.decide(.min))
+        XCTAssertEqual(table.selected(), 0)
+        XCTAssert(table.pristine())
     }
 
     func testLowerPristineWhenHigherIsNot() throws {
         // When we have all available images, highest pristine should be picked.
-        let choices = try getQualities(discontinous: [true, false, false])
-        var inOutChoices = choices as any Collection<VideoSubscriptionSet.SimulreceiveItem>
-        let result = VideoSubscriptionSet.makeSimulreceiveDecision(choices: &inOutChoices)
-        XCTAssertNotNil(result)
-        switch result {
-        case .highestRes(let item, let pristine):
-            XCTAssertNotEqual(item, choices[0])
-            XCTAssertNotEqual(item, choices[2])
-            XCTAssertEqual(item, choices[1])
-            XCTAssert(pristine)
-        default:
-            XCTFail()
-        }
+        let table = try getQualities(discontinous: [true, false, false])
+        XCTAssert(table.decide(.min))
+        XCTAssertEqual(table.selected(), 1)
+        XCTAssert(table.pristine())
     }
 
     func testAllDiscontinous() throws {
         // When we have all discontinous images, highest resolution should be picked.
-        let choices = try getQualities(discontinous: .init(repeating: true, count: 3))
-        var inOutChoices = choices as any Collection<VideoSubscriptionSet.SimulreceiveItem>
-        let result = VideoSubscriptionSet.makeSimulreceiveDecision(choices: &inOutChoices)
-        XCTAssertNotNil(result)
-        switch result {
-        case .highestRes(let item, let pristine):
-            XCTAssertFalse(pristine)
-            XCTAssertNotEqual(item, choices[1])
-            XCTAssertNotEqual(item, choices[2])
-            XCTAssertEqual(item, choices[0])
-        default:
-            XCTFail()
-        }
+        let table = try getQualities(discontinous: .init(repeating: true, count: 3))
+        XCTAssert(table.decide(.min))
+        XCTAssertFalse(table.pristine())
+        XCTAssertEqual(table.selected(), 0)
+    }
+
+    func testConsumedAndShownAreNotPending() throws {
+        let table = try getQualities(discontinous: .init(repeating: false, count: 3), timing: [2, 1, 1])
+        XCTAssert(table.decide(.min))
+        table.consume()
+        // The shortlist at 1 is used, leaving the newer frame.
+        XCTAssert(table.decide(.min))
+        XCTAssertEqual(table.selected(), 0)
+        XCTAssert(table.onlyChoice())
+        // Nothing is newer than one already shown.
+        XCTAssertFalse(table.decide(2))
+        table.update(2, pts: 3, width: 1280, discontinuous: false)
+        XCTAssert(table.decide(2))
+        XCTAssertEqual(table.selected(), 2)
+        XCTAssertEqual(table.pending(withWidth: 1280), 2)
+        XCTAssertEqual(table.pending(withWidth: 1920), -1)
+    }
+
+    func testTooManyLayers() {
+        XCTAssertNil(QQualityTable(layers: 33))
     }
 }
 
@@ -180,6 +125,7 @@ struct VideoSubscriptionSetTests {
                                            activeSpeakerStats: nil,
                                            cleanupTime: 10,
                                            slidingWindowTime: 10,
+                                           scheduler: .init(label: "test"),
                                            config: .init(calculateLatency: false,
                                                          qualityHitThreshold: 1))
         let details = ObjectReceived(timestamp: timestamp,
@@ -199,9 +145,3 @@ struct VideoSubscriptionSetTests {
                                details: details)
     }
 }
-
-extension AvailableImage: Equatable {
-    public static func == (lhs: AvailableImage, rhs: AvailableImage) -> Bool {
-        lhs.image == rhs.image
-    }
-}